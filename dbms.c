@@ -22,6 +22,8 @@
  * - Generates formatted reports with timing information
  * - Handles currency conversion using exchange rates by date
  * - Provides menu-driven interface for data analysis
+ * - Runs database construction, reports and searches headless from the command line
+ * - Benchmarks the build and reports on synthetic data sets scaled from the CSV files
  */
 
 #include <stdlib.h>        // Standard library functions (system calls, memory management)
@@ -31,7 +33,12 @@
 #include <limits.h>        // Constants for integer limits (INT_MAX, etc.)
 #include <math.h>          // Mathematical functions (abs, etc.)
 #include <windows.h>       // Windows-specific functions (console UTF-8 support)
+#include <psapi.h>         // Process memory counters (benchmark peak working set)
 #include <stdarg.h>        // Variable argument list support for variadic functions
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>     // SSE2 intrinsics for the CSV delimiter scan
+#define CSV_SCAN_SSE2
+#endif
 #include "structures.h"    // Custom data structures for database tables
 
 // Function prototypes for sorting algorithms
@@ -39,6 +46,12 @@ int SortBubble(const char* inputFileName, const char* outputFileName, size_t rec
                int (*compareFunction)(const void*, const void*));
 int SortMerge(const char* inputFileName, const char* outputFileName, size_t recordSize,
               int (*compareFunction)(const void*, const void*));
+int SortRadix(const char* inputFileName, const char* outputFileName, size_t recordSize,
+              int (*compareFunction)(const void*, const void*));
+int SortRecordsByNormalizedKey(const char* inputFileName, const char* outputFileName, size_t recordSize,
+                               const sortKeySpec* keySpec,
+                               int (*sortFunction)(const char*, const char*, size_t,
+                                                   int (*)(const void*, const void*)));
 
 // Function prototypes for binary search algorithms
 int SearchBinary(const char* fileName, const void* searchKey, size_t recordSize,
@@ -48,61 +61,170 @@ int SearchBinaryRange(const char* fileName, const void* searchKey, size_t record
                       long* startPosition, long* endPosition);
 
 // Function prototypes for currency conversion
-double ConvertCurrencyToUSD(double amount, const char* currencyCode, const dateStructure* transactionDate);
-void ConvertDateToExchangeRateFormat(const dateStructure* inputDate, char* outputDateString);
-int CalculateDateDifference(const dateStructure* date1, const dateStructure* date2);
-int ParseExchangeRateDate(const char* dateString, dateStructure* parsedDate);
+double ConvertCurrencyToUSD(double amount, const char* currencyCode, int transactionDay);
 
 // Function prototypes for report generation
-void GenerateReport2ProductTypesAndLocations(const char* sortType);
-void GenerateReport5CustomerSalesListing(const char* sortType);
-void GenerateReport3SeasonalPatterns(const char* sortType);
-void GenerateReport4DeliveryTimeAnalysis(const char* sortType);
+int GenerateReport2ProductTypesAndLocations(const char* sortType);
+int GenerateReport5CustomerSalesListing(const char* sortType);
+int GenerateReport3SeasonalPatterns(const char* sortType);
+int GenerateReport4DeliveryTimeAnalysis(const char* sortType);
 void WriteToReport(FILE* txtFile, const char* format, ...);
+void WriteReportSummary(FILE* txtFile, const char* format, ...);
 void GenerateReportHeader(FILE* txtFile, const char* reportTitle);
 void GenerateReportFooter(FILE* txtFile, time_t startTime);
 
+// Function prototypes for instrumentation
+void CountBytesWritten(long long byteCount);
+
+// Function prototypes for CSV ingestion
+int ParseCurrencyFromCsv(const char* currencyString, double* parsedValue);
+
+// ====================== BATCH MODE ======================
+
+/*
+ * Structure: batchRunOptions
+ * Purpose: Answers to the interactive prompts when the program runs from the command line
+ * Fields: active - 1 when running a command-line pipeline (no prompts, no "cls")
+ *         maxRecords - records to display in Reports 2 and 5 (0 = all)
+ *         ascending - display order (1 = ascending, 0 = descending)
+ *         searchOption - search menu option to run after the report (0 = no search)
+ *         productName - product name for Report 2 searches
+ *         continent - continent for Report 2 searches
+ *         country - country for Report 2 searches
+ *         customerName - customer name for Report 5 searches
+ *         orderDate - order date for Report 5 searches
+ *         orderNumber - order number for Report 5 searches
+ *         productKey - product key for Report 5 searches
+ *         rangeFirstDate - first order date of the date-range summary
+ *         rangeLastDate - last order date of the date-range summary
+ */
+typedef struct {
+    int active;                            // 1 when prompts are answered from here
+    int maxRecords;                        // Records to display (0 = all)
+    int ascending;                         // 1 = ascending, 0 = descending
+    int searchOption;                      // Search menu option (0 = no search)
+    char productName[31];                  // Report 2 search: product name
+    char continent[20];                    // Report 2 search: continent
+    char country[20];                      // Report 2 search: country
+    char customerName[40];                 // Report 5 search: customer name
+    dateStructure orderDate;               // Report 5 search: order date
+    long orderNumber;                      // Report 5 search: order number
+    unsigned short productKey;             // Report 5 search: product key
+    dateStructure rangeFirstDate;          // Date-range summary: first order date
+    dateStructure rangeLastDate;           // Date-range summary: last order date
+} batchRunOptions;
+
+static batchRunOptions batchOptions = {0, 0, 1, 0, "", "", "", "", {0, 0, 0}, 0, 0, {0, 0, 0}, {0, 0, 0}}; // Interactive by default
+
 /*
  * Function: ClearOutput
  * Purpose: Clears the console screen for better user interface presentation
  * Parameters: None
  * Returns: void
- * Note: Uses Windows-specific "cls" command
+ * Note: Uses Windows-specific "cls" command. Does nothing in batch mode so
+ *       command-line output can be redirected and compared.
  */
 void ClearOutput(void) {
-    system("cls");
+    if (batchOptions.active == 0) {
+        system("cls");
+    }
 }//end function definition ClearOutput
 
+// ====================== REPORT OUTPUT ======================
+#define REPORT_ECHO_OFF 0                             // Report lines go to the file only
+#define REPORT_ECHO_SUMMARY 1                         // Console shows header, totals and footer
+#define REPORT_ECHO_FULL 2                            // Console shows every report line
+#define REPORT_BUFFER_SIZE (1024 * 1024)              // stdio buffer for report text files
+
+static int reportEchoMode = REPORT_ECHO_FULL;         // Current console echo mode
+
 /*
- * Function: WriteToReport
- * Purpose: Writes formatted output to both report file and console simultaneously
+ * Function: SetReportEchoMode
+ * Purpose: Selects how much of each report is echoed to the console
+ * Parameters: echoMode - REPORT_ECHO_OFF, REPORT_ECHO_SUMMARY or REPORT_ECHO_FULL
+ * Returns: void
+ * Note: Out-of-range values select REPORT_ECHO_FULL. The report file always
+ *       receives every line.
+ */
+void SetReportEchoMode(int echoMode) {
+    if (echoMode >= REPORT_ECHO_OFF && echoMode <= REPORT_ECHO_FULL) {
+        reportEchoMode = echoMode;
+    } else {
+        reportEchoMode = REPORT_ECHO_FULL;
+    }
+}//end function definition SetReportEchoMode
+
+/*
+ * Function: GetReportEchoMode
+ * Purpose: Returns the current report console echo mode
+ * Parameters: None
+ * Returns: int - REPORT_ECHO_OFF, REPORT_ECHO_SUMMARY or REPORT_ECHO_FULL
+ */
+int GetReportEchoMode(void) {
+    return reportEchoMode;
+}//end function definition GetReportEchoMode
+
+/*
+ * Function: WriteReportLine
+ * Purpose: Writes one formatted piece of a report to the file and, if enabled, the console
  * Parameters: txtFile - FILE pointer to the report text file (if NULL, only writes to console)
+ *            echoLevel - lowest echo mode that shows this text on the console
  *            format - printf-style format string
- *            ... - variable arguments matching the format string
+ *            args - arguments matching the format string
  * Returns: void
- * Note: Uses variadic arguments to support flexible formatting like printf
- *       Ensures report content is displayed to user while being saved to file
+ * Note: The file is not flushed here; GenerateReportFooter flushes it once
  */
-void WriteToReport(FILE* txtFile, const char* format, ...) {
-    va_list args1;                                 // First argument list for file
-    va_list args2;                                 // Second argument list for console
+void WriteReportLine(FILE* txtFile, int echoLevel, const char* format, va_list args) {
+    va_list consoleArgs;                           // Copy of the arguments for the console
     
-    va_start(args1, format);                       // Initialize first va_list
-    va_copy(args2, args1);                         // Copy for second use
+    va_copy(consoleArgs, args);
     
-    // Write to file if valid file pointer provided
     if (txtFile != NULL) {
-        vfprintf(txtFile, format, args1);
-        fflush(txtFile);                           // Ensure immediate write
+        CountBytesWritten(vfprintf(txtFile, format, args));
+    }
+    if (txtFile == NULL || reportEchoMode >= echoLevel) {
+        vprintf(format, consoleArgs);
     }
     
-    // Always write to console for user feedback
-    vprintf(format, args2);
+    va_end(consoleArgs);
+}//end function definition WriteReportLine
+
+/*
+ * Function: WriteToReport
+ * Purpose: Writes formatted output to the report file and echoes it in full echo mode
+ * Parameters: txtFile - FILE pointer to the report text file (if NULL, only writes to console)
+ *            format - printf-style format string
+ *            ... - variable arguments matching the format string
+ * Returns: void
+ * Note: Uses variadic arguments to support flexible formatting like printf.
+ *       Output is buffered; use WriteReportSummary for lines the console should
+ *       show in summary echo mode.
+ */
+void WriteToReport(FILE* txtFile, const char* format, ...) {
+    va_list args;                                  // Arguments matching format
     
-    va_end(args1);                                 // Clean up argument lists
-    va_end(args2);
+    va_start(args, format);
+    WriteReportLine(txtFile, REPORT_ECHO_FULL, format, args);
+    va_end(args);
 }//end function definition WriteToReport
 
+/*
+ * Function: WriteReportSummary
+ * Purpose: Writes a report header, total or footer line
+ * Parameters: txtFile - FILE pointer to the report text file (if NULL, only writes to console)
+ *            format - printf-style format string
+ *            ... - variable arguments matching the format string
+ * Returns: void
+ * Note: Same as WriteToReport but also echoed in summary echo mode
+ */
+void WriteReportSummary(FILE* txtFile, const char* format, ...) {
+    va_list args;                                  // Arguments matching format
+    
+    va_start(args, format);
+    WriteReportLine(txtFile, REPORT_ECHO_SUMMARY, format, args);
+    va_end(args);
+}//end function definition WriteReportSummary
+
 // ====================== HELPER FUNCTIONS ======================
 
 /*
@@ -124,6 +246,71 @@ FILE* OpenFileWithErrorCheck(const char* fileName, const char* mode) {
     return filePointer;                                // Single return point
 }//end function definition OpenFileWithErrorCheck
 
+/*
+ * Function: OpenReportFile
+ * Purpose: Creates a report text file with a large output buffer
+ * Parameters: fileName - name of the report file to create
+ * Returns: FILE* - file pointer if successful, NULL if failed
+ * Note: Report lines accumulate in a REPORT_BUFFER_SIZE buffer and reach the
+ *       disk in large writes instead of one write per line
+ */
+FILE* OpenReportFile(const char* fileName) {
+    FILE* reportFile = NULL;                           // Report file (single return pattern)
+    
+    reportFile = OpenFileWithErrorCheck(fileName, "w");
+    if (reportFile != NULL) {
+        setvbuf(reportFile, NULL, _IOFBF, REPORT_BUFFER_SIZE);
+    }
+    return reportFile;                                 // Single return point
+}//end function definition OpenReportFile
+
+#define CALENDAR_FIRST_YEAR 1900                      // Earliest year a date may have
+#define CALENDAR_LAST_YEAR 2100                       // Latest year a date may have
+#define CALENDAR_MONTH_SLOTS ((CALENDAR_LAST_YEAR - CALENDAR_FIRST_YEAR + 1) * 12) // Calendar months in range
+#define CALENDAR_DAY_COUNT 73414                      // Days from 1900-01-01 to 2100-12-31
+
+/*
+ * Function: StoreCalendarDate
+ * Purpose: Validates a month, day and year and stores them in a dateStructure
+ * Parameters: month - month (1-12)
+ *            day - day of the month
+ *            year - four-digit year (1900-2100)
+ *            parsedDate - pointer to dateStructure to store result (unchanged if invalid)
+ * Returns: int - 1 if the date is valid, 0 otherwise
+ * Note: Validates days per month including leap years
+ */
+int StoreCalendarDate(int month, int day, int year, dateStructure* parsedDate) {
+    int isValid = 0;                                   // Validation flag (single return pattern)
+    int daysInMonth = 0;                               // Days in the parsed month
+    int isLeapYear = 0;                                // Leap year flag
+    
+    // Validate basic ranges
+    if (month >= 1 && month <= 12 && day >= 1 && year >= CALENDAR_FIRST_YEAR && year <= CALENDAR_LAST_YEAR) {
+        // Calculate if leap year: divisible by 4 AND (not divisible by 100 OR divisible by 400)
+        isLeapYear = ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
+        
+        // Determine days in month
+        if (month == 2) {
+            daysInMonth = isLeapYear ? 29 : 28;        // February
+        } else if (month == 4 || month == 6 || month == 9 || month == 11) {
+            daysInMonth = 30;                          // April, June, September, November
+        } else {
+            daysInMonth = 31;                          // January, March, May, July, August, October, December
+        }
+        
+        // Validate day is within month's range
+        if (day <= daysInMonth) {
+            // All validations passed - store values
+            parsedDate->monthOfYear = (unsigned char)month;
+            parsedDate->dayOfMonth = (unsigned char)day;
+            parsedDate->yearValue = (unsigned short)year;
+            isValid = 1;                               // Mark as valid
+        }
+    }
+    
+    return isValid;                                    // Single return point
+}//end function definition StoreCalendarDate
+
 /*
  * Function: ParseDateFromCsv
  * Purpose: Converts CSV date string (M/D/YYYY) to dateStructure
@@ -136,8 +323,6 @@ FILE* OpenFileWithErrorCheck(const char* fileName, const char* mode) {
 int ParseDateFromCsv(const char* dateString, dateStructure* parsedDate) {
     int month = 0, day = 0, year = 0;                  // Initialize parsing variables to zero
     int isValid = 0;                                   // Validation flag (single return pattern)
-    int daysInMonth = 0;                               // Days in the parsed month
-    int isLeapYear = 0;                                // Leap year flag
     int parseSuccess = 0;                              // sscanf result
     
     // Initialize structure fields to zero first
@@ -150,33 +335,116 @@ int ParseDateFromCsv(const char* dateString, dateStructure* parsedDate) {
     
     // Validate parsing success
     if (parseSuccess == 3) {
-        // Validate basic ranges
-        if (month >= 1 && month <= 12 && day >= 1 && year >= 1900 && year <= 2100) {
-            // Calculate if leap year: divisible by 4 AND (not divisible by 100 OR divisible by 400)
-            isLeapYear = ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
-            
-            // Determine days in month
-            if (month == 2) {
-                daysInMonth = isLeapYear ? 29 : 28;    // February
-            } else if (month == 4 || month == 6 || month == 9 || month == 11) {
-                daysInMonth = 30;                      // April, June, September, November
-            } else {
-                daysInMonth = 31;                      // January, March, May, July, August, October, December
+        isValid = StoreCalendarDate(month, day, year, parsedDate);
+    }
+    
+    return isValid;                                    // Single return point
+}//end function definition ParseDateFromCsv
+
+/*
+ * Function: DateToDayNumber
+ * Purpose: Converts a calendar date to a sequential day number
+ * Parameters: inputDate - pointer to dateStructure to convert
+ * Returns: int - days since 1970-01-01 (negative before it)
+ * Note: Exact Gregorian calendar arithmetic, so the difference of two day numbers
+ *       is the true number of days between the dates
+ */
+int DateToDayNumber(const dateStructure* inputDate) {
+    int year = (int)inputDate->yearValue;              // Year, shifted so it starts in March
+    int month = (int)inputDate->monthOfYear;           // Month, 1-12
+    int era = 0;                                       // 400-year era
+    int yearOfEra = 0;                                 // Year within the era [0, 399]
+    int dayOfYear = 0;                                 // Day within the March-based year [0, 365]
+    int dayOfEra = 0;                                  // Day within the era [0, 146096]
+    
+    if (month <= 2) {
+        year--;
+    }
+    era = (year >= 0 ? year : year - 399) / 400;
+    yearOfEra = year - era * 400;
+    dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + (int)inputDate->dayOfMonth - 1;
+    dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    
+    return era * 146097 + dayOfEra - 719468;           // Single return point
+}//end function definition DateToDayNumber
+
+/*
+ * Function: DayNumberToDate
+ * Purpose: Converts a day number back to a calendar date
+ * Parameters: dayNumber - days since 1970-01-01 (DateToDayNumber)
+ *            outputDate - receives the date (all zero for DAY_NUMBER_NONE)
+ * Returns: void
+ * Note: Inverse of DateToDayNumber; only needed where a date is displayed
+ */
+void DayNumberToDate(int dayNumber, dateStructure* outputDate) {
+    int shiftedDay = 0;                                // Days since 0000-03-01
+    int era = 0;                                       // 400-year era
+    int dayOfEra = 0;                                  // Day within the era [0, 146096]
+    int yearOfEra = 0;                                 // Year within the era [0, 399]
+    int dayOfYear = 0;                                 // Day within the March-based year [0, 365]
+    int monthIndex = 0;                                // Month counted from March [0, 11]
+    
+    outputDate->monthOfYear = 0;
+    outputDate->dayOfMonth = 0;
+    outputDate->yearValue = 0;
+    
+    if (dayNumber != DAY_NUMBER_NONE) {
+        shiftedDay = dayNumber + 719468;
+        era = (shiftedDay >= 0 ? shiftedDay : shiftedDay - 146096) / 146097;
+        dayOfEra = shiftedDay - era * 146097;
+        yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        monthIndex = (5 * dayOfYear + 2) / 153;
+        outputDate->dayOfMonth = (unsigned char)(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+        outputDate->monthOfYear = (unsigned char)(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+        outputDate->yearValue = (unsigned short)(yearOfEra + era * 400 + (monthIndex >= 10 ? 1 : 0));
+    }
+}//end function definition DayNumberToDate
+
+static unsigned short calendarMonthOfDay[CALENDAR_DAY_COUNT]; // Calendar month slot of each day in range
+static int calendarFirstDay = 0;                      // Day number of 1900-01-01
+static int calendarMonthsReady = 0;                   // 1 once calendarMonthOfDay is filled
+
+/*
+ * Function: DayNumberToMonthSlot
+ * Purpose: Returns the calendar month of a day number
+ * Parameters: dayNumber - days since 1970-01-01 (DateToDayNumber)
+ * Returns: int - (year - CALENDAR_FIRST_YEAR) * 12 + month - 1, or -1 outside the valid date range
+ * Note: The month of every day from 1900 to 2100 is tabulated on first use, so
+ *       grouping sales by month is one table lookup per row
+ */
+int DayNumberToMonthSlot(int dayNumber) {
+    dateStructure nextMonth;                           // First day of the following month
+    int dayIndex = 0;                                  // Position in calendarMonthOfDay
+    int monthEnd = 0;                                  // First position of the following month
+    int returnValue = -1;                              // Return value (single return pattern)
+    
+    if (calendarMonthsReady == 0) {
+        nextMonth.dayOfMonth = 1;
+        nextMonth.monthOfYear = 1;
+        nextMonth.yearValue = CALENDAR_FIRST_YEAR;
+        calendarFirstDay = DateToDayNumber(&nextMonth);
+        for (int slot = 0; slot < CALENDAR_MONTH_SLOTS; slot++) {
+            monthEnd = CALENDAR_DAY_COUNT;
+            if (slot + 1 < CALENDAR_MONTH_SLOTS) {
+                nextMonth.monthOfYear = (unsigned char)((slot + 1) % 12 + 1);
+                nextMonth.yearValue = (unsigned short)(CALENDAR_FIRST_YEAR + (slot + 1) / 12);
+                monthEnd = DateToDayNumber(&nextMonth) - calendarFirstDay;
             }
-            
-            // Validate day is within month's range
-            if (day <= daysInMonth) {
-                // All validations passed - store values
-                parsedDate->monthOfYear = (unsigned char)month;
-                parsedDate->dayOfMonth = (unsigned char)day;
-                parsedDate->yearValue = (unsigned short)year;
-                isValid = 1;                           // Mark as valid
+            while (dayIndex < monthEnd) {
+                calendarMonthOfDay[dayIndex] = (unsigned short)slot;
+                dayIndex++;
             }
         }
+        calendarMonthsReady = 1;
     }
     
-    return isValid;                                    // Single return point
-}//end function definition ParseDateFromCsv
+    if (dayNumber >= calendarFirstDay && dayNumber < calendarFirstDay + CALENDAR_DAY_COUNT) {
+        returnValue = (int)calendarMonthOfDay[dayNumber - calendarFirstDay];
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition DayNumberToMonthSlot
 
 /*
  * Function: ValidateCurrencyCode
@@ -207,7 +475,7 @@ int ValidateCurrencyCode(const char* currencyCode) {
  * Function: GenerateSortedFileName
  * Purpose: Creates a timestamped filename for sorted data files
  * Parameters: baseFileName - base name (e.g., "SalesTable")
- *            sortType - sorting method ("Bubble" or "Merge")
+ *            sortType - sorting method ("Bubble", "Merge" or "Radix")
  *            outputFileName - buffer to store the generated filename (must be >= 256 bytes)
  * Returns: void
  * Note: Creates names like "MergeSortedSales 2025-10-06 01-45.dat"
@@ -254,3212 +522,6778 @@ void InitializeStructureToZero(void* structurePointer, size_t structureSize) {
     memset(structurePointer, 0, structureSize);        // Set all bytes to zero
 }//end function definition InitializeStructureToZero
 
-// ====================== DOUBLY LINKED LIST FILE-BASED OPERATIONS ======================
+// ====================== INSTRUMENTATION ======================
+#define METRIC_PHASE_JOIN 0                           // Hash joins feeding a report
+#define METRIC_PHASE_SORT 1                           // Sorting the report data
+#define METRIC_PHASE_AGGREGATE 2                      // Sales scan and monthly aggregation
+#define METRIC_PHASE_RENDER 3                         // Writing the report text
+#define METRIC_PHASE_COUNT 4
 
 /*
- * Function: CreateLinkedListFromFile
- * Purpose: Creates a doubly linked list file structure from a binary data file
- * Parameters: inputFileName - source binary file with records
- *            linkedListFileName - output file for linked list structure
- *            recordSize - size of each record in bytes
- * Returns: long - number of nodes created, -1 on error
- * Note: Converts flat file to linked list format for efficient sorting
- *       Single return pattern, no data loaded to RAM
+ * Structure: reportMetrics
+ * Purpose: Phase timers and I/O counters for the report being generated
+ * Fields: reportFileName - report text file (the JSON sidecar is written next to it)
+ *         reportStart - monotonic time when the report started (nanoseconds)
+ *         phaseStart - monotonic start of each running phase (0 = not running)
+ *         phaseNanoseconds - accumulated time of each phase
+ *         recordsRead - records read from binary files and mapped tables
+ *         bytesRead - bytes read from binary files and mapped tables
+ *         bytesWritten - bytes written to binary files and the report text
+ *         seekCalls - fseek calls
+ *         comparisons - comparator invocations by sorts and searches
+ * Note: comparisons is updated from sort worker threads and bytesWritten from the
+ *       table conversion threads, so those two are updated atomically (comparisons
+ *       once per worker, bytesWritten once per write call)
  */
-long CreateLinkedListFromFile(const char* inputFileName, const char* linkedListFileName, size_t recordSize) {
-    FILE* inputFile = NULL;                            // Source data file
-    FILE* listFile = NULL;                             // Linked list file
-    LinkedListFileMetadata metadata;                   // List metadata
-    DoublyLinkedNodeHeader nodeHeader;                 // Current node header
-    void* dataBuffer = NULL;                           // Buffer for record data
-    long currentOffset = 0;                            // Current write position
-    long previousOffset = -1;                          // Previous node offset
-    long nodesCreated = 0;                             // Count of nodes created
-    int errorOccurred = 0;                             // Error flag
-    
-    // Initialize metadata
-    InitializeStructureToZero(&metadata, sizeof(LinkedListFileMetadata));
-    metadata.headOffset = -1;
-    metadata.tailOffset = -1;
-    metadata.nodeCount = 0;
-    metadata.recordSize = recordSize;
+typedef struct {
+    char reportFileName[300];              // Report text file name
+    long long reportStart;                 // Report start (ns)
+    long long phaseStart[METRIC_PHASE_COUNT];        // Running phase start (ns, 0 = stopped)
+    long long phaseNanoseconds[METRIC_PHASE_COUNT];  // Accumulated phase time (ns)
+    long long recordsRead;                 // Records read
+    long long bytesRead;                   // Bytes read
+    volatile LONG64 bytesWritten;          // Bytes written
+    long long seekCalls;                   // fseek calls
+    volatile LONG64 comparisons;           // Comparator invocations
+    long long resultRows;                  // Sales rows the report was built from
+} reportMetrics;
+
+static reportMetrics metrics;                         // Metrics of the current report
+static int metricsSidecarEnabled = 0;                 // 1 = write Report_*.json next to the report
+
+/*
+ * Function: ReadMonotonicNanoseconds
+ * Purpose: Reads a monotonic high-resolution clock
+ * Parameters: None
+ * Returns: long long - nanoseconds since an arbitrary fixed point
+ */
+long long ReadMonotonicNanoseconds(void) {
+    static LARGE_INTEGER frequency = {0};              // Counter ticks per second
+    LARGE_INTEGER counter;                             // Current counter value
     
-    // Allocate data buffer
-    dataBuffer = malloc(recordSize);
-    if (dataBuffer == NULL) {
-        errorOccurred = 1;
-        nodesCreated = -1;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
     }
+    QueryPerformanceCounter(&counter);
     
-    if (errorOccurred == 0) {
-        // Open input file
-        inputFile = OpenFileWithErrorCheck(inputFileName, "rb");
-        if (inputFile == NULL) {
-            errorOccurred = 1;
-            nodesCreated = -1;
-        }
+    // Split to avoid overflowing ticks * 1e9
+    return (counter.QuadPart / frequency.QuadPart) * 1000000000LL +
+           (counter.QuadPart % frequency.QuadPart) * 1000000000LL / frequency.QuadPart;
+}//end function definition ReadMonotonicNanoseconds
+
+/*
+ * Function: SetMetricsSidecar
+ * Purpose: Enables or disables the JSON metrics file written with each report
+ * Parameters: enabled - 1 to write Report_*.json next to each Report_*.txt, 0 not to
+ * Returns: void
+ */
+void SetMetricsSidecar(int enabled) {
+    metricsSidecarEnabled = (enabled != 0) ? 1 : 0;
+}//end function definition SetMetricsSidecar
+
+/*
+ * Function: BeginReportMetrics
+ * Purpose: Clears all timers and counters at the start of a report
+ * Parameters: reportFileName - report text file being produced
+ * Returns: void
+ */
+void BeginReportMetrics(const char* reportFileName) {
+    InitializeStructureToZero(&metrics, sizeof(reportMetrics));
+    strncpy(metrics.reportFileName, reportFileName, sizeof(metrics.reportFileName) - 1);
+    metrics.reportStart = ReadMonotonicNanoseconds();
+}//end function definition BeginReportMetrics
+
+/*
+ * Function: StartMetricPhase
+ * Purpose: Starts timing a report phase
+ * Parameters: phase - METRIC_PHASE_* value
+ * Returns: void
+ */
+void StartMetricPhase(int phase) {
+    metrics.phaseStart[phase] = ReadMonotonicNanoseconds();
+}//end function definition StartMetricPhase
+
+/*
+ * Function: StopMetricPhase
+ * Purpose: Stops timing a report phase and adds the elapsed time to it
+ * Parameters: phase - METRIC_PHASE_* value
+ * Returns: void
+ * Note: Does nothing if the phase is not running
+ */
+void StopMetricPhase(int phase) {
+    if (metrics.phaseStart[phase] != 0) {
+        metrics.phaseNanoseconds[phase] += ReadMonotonicNanoseconds() - metrics.phaseStart[phase];
+        metrics.phaseStart[phase] = 0;
+    }
+}//end function definition StopMetricPhase
+
+/*
+ * Function: GetMetricPhaseSeconds
+ * Purpose: Returns the accumulated time of a report phase
+ * Parameters: phase - METRIC_PHASE_* value
+ * Returns: double - seconds spent in the phase so far
+ */
+double GetMetricPhaseSeconds(int phase) {
+    return (double)metrics.phaseNanoseconds[phase] / 1e9;
+}//end function definition GetMetricPhaseSeconds
+
+/*
+ * Function: CountComparisons
+ * Purpose: Adds comparator invocations to the current report's counter
+ * Parameters: comparisonCount - invocations to add
+ * Returns: void
+ * Note: Safe to call from sort worker threads; callers count locally and add once
+ */
+void CountComparisons(long long comparisonCount) {
+    if (comparisonCount != 0) {
+        InterlockedExchangeAdd64(&metrics.comparisons, comparisonCount);
     }
+}//end function definition CountComparisons
+
+/*
+ * Function: CountBytesWritten
+ * Purpose: Adds output bytes to the current report's counter
+ * Parameters: byteCount - bytes written
+ * Returns: void
+ * Note: Safe to call from table conversion threads
+ */
+void CountBytesWritten(long long byteCount) {
+    InterlockedExchangeAdd64(&metrics.bytesWritten, byteCount);
+}//end function definition CountBytesWritten
+
+/*
+ * Function: CountedRead
+ * Purpose: fread that also counts records and bytes read
+ * Parameters: buffer, elementSize, elementCount, file - as for fread
+ * Returns: size_t - elements read, as fread
+ */
+size_t CountedRead(void* buffer, size_t elementSize, size_t elementCount, FILE* file) {
+    size_t elementsRead = fread(buffer, elementSize, elementCount, file);  // Elements actually read
     
-    if (errorOccurred == 0) {
-        // Create linked list file
-        listFile = OpenFileWithErrorCheck(linkedListFileName, "wb+");
-        if (listFile == NULL) {
-            errorOccurred = 1;
-            nodesCreated = -1;
-        }
+    metrics.recordsRead += (long long)elementsRead;
+    metrics.bytesRead += (long long)(elementsRead * elementSize);
+    return elementsRead;
+}//end function definition CountedRead
+
+/*
+ * Function: CountedWrite
+ * Purpose: fwrite that also counts bytes written
+ * Parameters: buffer, elementSize, elementCount, file - as for fwrite
+ * Returns: size_t - elements written, as fwrite
+ */
+size_t CountedWrite(const void* buffer, size_t elementSize, size_t elementCount, FILE* file) {
+    size_t elementsWritten = fwrite(buffer, elementSize, elementCount, file);  // Elements actually written
+    
+    CountBytesWritten((long long)(elementsWritten * elementSize));
+    return elementsWritten;
+}//end function definition CountedWrite
+
+/*
+ * Function: CountedSeek
+ * Purpose: fseek that also counts seek calls
+ * Parameters: file, offset, origin - as for fseek
+ * Returns: int - 0 on success, as fseek
+ */
+int CountedSeek(FILE* file, long offset, int origin) {
+    metrics.seekCalls++;
+    return fseek(file, offset, origin);
+}//end function definition CountedSeek
+
+/*
+ * Function: CountedSeek64
+ * Purpose: 64-bit fseek that also counts seek calls
+ * Parameters: file, offset, origin - as for _fseeki64
+ * Returns: int - 0 on success, as _fseeki64
+ * Note: long is 32 bits on Windows, so an offset computed from a row count must use
+ *       this seek; with CountedSeek it would wrap once the file passes 2 GB
+ */
+int CountedSeek64(FILE* file, long long offset, int origin) {
+    metrics.seekCalls++;
+    return _fseeki64(file, offset, origin);
+}//end function definition CountedSeek64
+
+/*
+ * Function: WriteMetricsSidecar
+ * Purpose: Writes the current report's timers and counters as JSON
+ * Parameters: totalNanoseconds - time since BeginReportMetrics
+ * Returns: void
+ * Note: The file is the report file name with ".txt" replaced by ".json"
+ */
+void WriteMetricsSidecar(long long totalNanoseconds) {
+    char sidecarFileName[310] = {0};                   // JSON file name
+    char* extension = NULL;                            // ".txt" in sidecarFileName
+    FILE* sidecarFile = NULL;                          // JSON output file
+    
+    strcpy(sidecarFileName, metrics.reportFileName);
+    extension = strrchr(sidecarFileName, '.');
+    if (extension != NULL) {
+        *extension = '\0';
+    }
+    strcat(sidecarFileName, ".json");
+    
+    sidecarFile = OpenFileWithErrorCheck(sidecarFileName, "w");
+    if (sidecarFile != NULL) {
+        fprintf(sidecarFile, "{\n");
+        fprintf(sidecarFile, "  \"report\": \"%s\",\n", metrics.reportFileName);
+        fprintf(sidecarFile, "  \"phases_ns\": {\"join\": %lld, \"sort\": %lld, \"aggregate\": %lld, \"render\": %lld},\n",
+                metrics.phaseNanoseconds[METRIC_PHASE_JOIN], metrics.phaseNanoseconds[METRIC_PHASE_SORT],
+                metrics.phaseNanoseconds[METRIC_PHASE_AGGREGATE], metrics.phaseNanoseconds[METRIC_PHASE_RENDER]);
+        fprintf(sidecarFile, "  \"total_ns\": %lld,\n", totalNanoseconds);
+        fprintf(sidecarFile, "  \"records_read\": %lld,\n", metrics.recordsRead);
+        fprintf(sidecarFile, "  \"bytes_read\": %lld,\n", metrics.bytesRead);
+        fprintf(sidecarFile, "  \"bytes_written\": %lld,\n", (long long)metrics.bytesWritten);
+        fprintf(sidecarFile, "  \"seek_calls\": %lld,\n", metrics.seekCalls);
+        fprintf(sidecarFile, "  \"comparisons\": %lld\n", (long long)metrics.comparisons);
+        fprintf(sidecarFile, "}\n");
+        fclose(sidecarFile);
+    }
+}//end function definition WriteMetricsSidecar
+
+// ====================== MAPPED TABLE ACCESS ======================
+
+/*
+ * Function: CloseMappedTable
+ * Purpose: Unmaps a table and closes its handles
+ * Parameters: table - table to close (safe to call on a zeroed or already closed table)
+ * Returns: void
+ */
+void CloseMappedTable(mappedTable* table) {
+    if (table->view != NULL) {
+        UnmapViewOfFile(table->view);
+    }
+    if (table->mappingHandle != NULL) {
+        CloseHandle((HANDLE)table->mappingHandle);
+    }
+    if (table->fileHandle != NULL) {
+        CloseHandle((HANDLE)table->fileHandle);
     }
+    InitializeStructureToZero(table, sizeof(mappedTable));
+}//end function definition CloseMappedTable
+
+/*
+ * Function: OpenMappedTable
+ * Purpose: Maps a binary table file read-only for in-place record access
+ * Parameters: table - table to open (any previous content is discarded)
+ *            fileName - binary table file
+ *            recordSize - size of each record in bytes
+ *            accessHint - TABLE_ACCESS_SEQUENTIAL or TABLE_ACCESS_RANDOM
+ * Returns: int - 1 if the table is open, 0 on error
+ * Note: accessHint is passed to the operating system as FILE_FLAG_SEQUENTIAL_SCAN or
+ *       FILE_FLAG_RANDOM_ACCESS so read-ahead suits the access pattern. An empty file
+ *       opens successfully with recordCount 0. Trailing partial records are ignored.
+ */
+int OpenMappedTable(mappedTable* table, const char* fileName, size_t recordSize, int accessHint) {
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;          // Open file
+    LARGE_INTEGER fileSize;                            // File size in bytes
+    DWORD accessFlags = 0;                             // Read-ahead hint
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    if (errorOccurred == 0) {
-        // Reserve space for metadata at beginning
-        currentOffset = sizeof(LinkedListFileMetadata);
-        fseek(listFile, currentOffset, SEEK_SET);
-        
-        // Read records and create nodes
-        while (fread(dataBuffer, recordSize, 1, inputFile) == 1 && errorOccurred == 0) {
-            // Set first node as head
-            if (metadata.nodeCount == 0) {
-                metadata.headOffset = currentOffset;
-            }
-            
-            // Initialize node header
-            nodeHeader.prevOffset = previousOffset;
-            nodeHeader.nextOffset = -1;               // Will update previous node's next
-            nodeHeader.dataSize = recordSize;
-            
-            // Write node header
-            if (fwrite(&nodeHeader, sizeof(DoublyLinkedNodeHeader), 1, listFile) != 1) {
-                errorOccurred = 1;
-                nodesCreated = -1;
-            }
-            
-            // Write node data
-            if (errorOccurred == 0) {
-                if (fwrite(dataBuffer, recordSize, 1, listFile) != 1) {
-                    errorOccurred = 1;
-                    nodesCreated = -1;
-                }
-            }
-            
-            // Update previous node's nextOffset
-            if (errorOccurred == 0 && previousOffset != -1) {
-                long tempOffset = ftell(listFile);     // Save current position
-                fseek(listFile, previousOffset + sizeof(long), SEEK_SET); // Seek to prevNode.nextOffset
-                fwrite(&currentOffset, sizeof(long), 1, listFile);
-                fseek(listFile, tempOffset, SEEK_SET); // Restore position
+    InitializeStructureToZero(table, sizeof(mappedTable));
+    table->recordSize = recordSize;
+    
+    accessFlags = (accessHint == TABLE_ACCESS_RANDOM) ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN;
+    fileHandle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | accessFlags, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        printf("Error: %s not found or cannot be opened\n", fileName);
+    } else if (GetFileSizeEx(fileHandle, &fileSize) == 0) {
+        printf("Error: Cannot get size of %s\n", fileName);
+        CloseHandle(fileHandle);
+    } else {
+        table->fileHandle = fileHandle;
+        table->fileSize = fileSize.QuadPart;
+        table->recordCount = (long)(fileSize.QuadPart / (long long)recordSize);
+        returnValue = 1;
+        
+        // Zero-length files cannot be mapped; they simply have no records
+        if (fileSize.QuadPart > 0) {
+            table->mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (table->mappingHandle != NULL) {
+                table->view = (const unsigned char*)MapViewOfFile((HANDLE)table->mappingHandle,
+                                                                  FILE_MAP_READ, 0, 0, 0);
+                table->records = table->view;
             }
-            
-            // Update for next iteration
-            if (errorOccurred == 0) {
-                metadata.tailOffset = currentOffset;
-                previousOffset = currentOffset;
-                currentOffset = ftell(listFile);
-                metadata.nodeCount++;
+            if (table->view == NULL) {
+                printf("Error: Cannot map %s into memory\n", fileName);
+                CloseMappedTable(table);
+                returnValue = 0;
             }
         }
-        
-        // Write metadata at beginning of file
-        if (errorOccurred == 0) {
-            fseek(listFile, 0, SEEK_SET);
-            fwrite(&metadata, sizeof(LinkedListFileMetadata), 1, listFile);
-            nodesCreated = metadata.nodeCount;
-        }
     }
     
-    // Cleanup
-    if (dataBuffer != NULL) {
-        free(dataBuffer);
-    }
-    if (inputFile != NULL) {
-        fclose(inputFile);
-    }
-    if (listFile != NULL) {
-        fclose(listFile);
+    return returnValue;                                // Single return point
+}//end function definition OpenMappedTable
+
+/*
+ * Function: MappedRecordAt
+ * Purpose: Returns a pointer to a record of a mapped table
+ * Parameters: table - open mapped table
+ *            recordIndex - zero-based record number
+ * Returns: const void* - pointer into the mapping, NULL if recordIndex is out of range
+ * Note: The pointer stays valid until the table is closed. Each call counts as one
+ *       record read in the report metrics.
+ */
+const void* MappedRecordAt(const mappedTable* table, long recordIndex) {
+    const void* record = NULL;                         // Requested record (single return pattern)
+    
+    if (recordIndex >= 0 && recordIndex < table->recordCount) {
+        record = table->records + (size_t)recordIndex * table->recordSize;
+        metrics.recordsRead++;
+        metrics.bytesRead += (long long)table->recordSize;
     }
     
-    return nodesCreated;                               // Single return point
-}//end function definition CreateLinkedListFromFile
+    return record;
+}//end function definition MappedRecordAt
+
+// ====================== BINARY TABLE HEADER ======================
+// Every binary table starts with a tableHeader describing its record layout, row count,
+// build time, and the order and range of its key and date columns. Readers open tables
+// through OpenBinaryTable or OpenMappedBinaryTable, which reject files written with a
+// different layout and return the row count without measuring the file.
+#define BINARY_TABLE_SALES 0                          // Table ids of the five binary tables
+#define BINARY_TABLE_CUSTOMERS 1
+#define BINARY_TABLE_STORES 2
+#define BINARY_TABLE_EXCHANGE_RATES 3
+#define BINARY_TABLE_PRODUCTS 4
+#define BINARY_TABLE_COUNT 5
 
 /*
- * Function: ReadNodeFromList
- * Purpose: Reads a node's data from linked list file without loading entire list
- * Parameters: listFile - open linked list file pointer
- *            nodeOffset - file offset to the node
- *            dataBuffer - buffer to store node data (must be pre-allocated)
- *            nodeHeader - pointer to store node header info
- * Returns: int - 1 on success, 0 on failure
- * Note: Single return pattern, reads only one node at a time
+ * Structure: binaryTableSchema
+ * Purpose: File name, record size, statistics columns and dictionary of one binary table
  */
-int ReadNodeFromList(FILE* listFile, long nodeOffset, void* dataBuffer, DoublyLinkedNodeHeader* nodeHeader) {
-    int success = 0;                                   // Success flag (single return pattern)
-    size_t readCount = 0;                              // Read operation count
+typedef struct {
+    const char* fileName;                              // Binary table file
+    size_t recordSize;                                 // Bytes per record
+    int columnCount;                                   // Columns with statistics
+    struct {
+        int columnType;                                // SORT_COLUMN_UNSIGNED, SORT_COLUMN_DATE or SORT_COLUMN_DAY_NUMBER
+        size_t fieldOffset;                            // Field offset in record
+        size_t fieldWidth;                             // Field size in record
+    } columns[TABLE_MAX_STAT_COLUMNS];
+    const char* dictionaryFileName;                    // Dictionary of encoded columns (NULL = none)
+    int dictionaryColumns;                             // Encoded columns
+} binaryTableSchema;
+
+static const binaryTableSchema binaryTableSchemas[BINARY_TABLE_COUNT] = {
+    {"SalesTable.dat", sizeof(salesRecord), 6, {
+        {SORT_COLUMN_UNSIGNED, offsetof(salesRecord, orderNumber), sizeof(long)},
+        {SORT_COLUMN_DAY_NUMBER, offsetof(salesRecord, orderDay), sizeof(int)},
+        {SORT_COLUMN_DAY_NUMBER, offsetof(salesRecord, deliveryDay), sizeof(int)},
+        {SORT_COLUMN_UNSIGNED, offsetof(salesRecord, customerKey), sizeof(unsigned int)},
+        {SORT_COLUMN_UNSIGNED, offsetof(salesRecord, storeKey), sizeof(unsigned short)},
+        {SORT_COLUMN_UNSIGNED, offsetof(salesRecord, productKey), sizeof(unsigned short)}}, NULL, 0},
+    {"CustomersTable.dat", sizeof(customerRecord), 2, {
+        {SORT_COLUMN_UNSIGNED, offsetof(customerRecord, customerKey), sizeof(unsigned int)},
+        {SORT_COLUMN_DATE, offsetof(customerRecord, birthday), sizeof(dateStructure)}},
+        "CustomersTable.dict", CUSTOMER_DICTIONARY_COLUMNS},
+    {"StoresTable.dat", sizeof(storeRecord), 2, {
+        {SORT_COLUMN_UNSIGNED, offsetof(storeRecord, storeKey), sizeof(unsigned short)},
+        {SORT_COLUMN_DATE, offsetof(storeRecord, openDate), sizeof(dateStructure)}}, NULL, 0},
+    {"ExchangeRatesTable.dat", sizeof(exchangeRateRecord), 0, {{0, 0, 0}}, NULL, 0},
+    {"ProductsTable.dat", sizeof(productRecord), 1, {
+        {SORT_COLUMN_UNSIGNED, offsetof(productRecord, productKey), sizeof(unsigned short)}},
+        "ProductsTable.dict", PRODUCT_DICTIONARY_COLUMNS}
+};                                                    // Schema of each table id
+
+/*
+ * Function: InitializeTableHeader
+ * Purpose: Prepares the header of an empty table
+ * Parameters: header - header to initialize
+ *            tableId - BINARY_TABLE_* id
+ * Returns: void
+ * Note: Every column starts out sorted; statistics are filled in by AccumulateTableStatistics
+ */
+void InitializeTableHeader(tableHeader* header, int tableId) {
+    const binaryTableSchema* schema = &binaryTableSchemas[tableId]; // Table layout
+    
+    InitializeStructureToZero(header, sizeof(tableHeader));
+    header->magic = TABLE_HEADER_MAGIC;
+    header->version = TABLE_HEADER_VERSION;
+    header->recordSize = (unsigned int)schema->recordSize;
+    header->columnCount = (unsigned int)schema->columnCount;
+    for (int column = 0; column < schema->columnCount; column++) {
+        header->columns[column].columnType = schema->columns[column].columnType;
+        header->columns[column].fieldOffset = (unsigned int)schema->columns[column].fieldOffset;
+        header->columns[column].fieldWidth = (unsigned int)schema->columns[column].fieldWidth;
+        header->columns[column].isSorted = 1;
+    }
+}//end function definition InitializeTableHeader
+
+/*
+ * Function: ReadStatColumnValue
+ * Purpose: Returns the value of a statistics column in a record
+ * Parameters: column - column layout
+ *            record - record holding the field
+ * Returns: long long - the unsigned value, or the day number of a date
+ */
+long long ReadStatColumnValue(const tableColumnStats* column, const void* record) {
+    const unsigned char* field = (const unsigned char*)record + column->fieldOffset; // Column field
+    unsigned char byteValue = 0;                       // 1-byte integer field
+    unsigned short shortValue = 0;                     // 2-byte integer field
+    unsigned int intValue = 0;                         // 4-byte integer field
+    unsigned long long longValue = 0;                  // 8-byte integer field
+    int dayNumber = 0;                                 // Day number field
+    long long returnValue = 0;                         // Return value (single return pattern)
+    
+    if (column->columnType == SORT_COLUMN_DATE) {
+        returnValue = DateToDayNumber((const dateStructure*)field);
+    } else if (column->columnType == SORT_COLUMN_DAY_NUMBER) {
+        memcpy(&dayNumber, field, sizeof(int));
+        returnValue = dayNumber;
+    } else if (column->fieldWidth == 1) {
+        memcpy(&byteValue, field, 1);
+        returnValue = byteValue;
+    } else if (column->fieldWidth == 2) {
+        memcpy(&shortValue, field, 2);
+        returnValue = shortValue;
+    } else if (column->fieldWidth == 4) {
+        memcpy(&intValue, field, 4);
+        returnValue = intValue;
+    } else {
+        memcpy(&longValue, field, 8);
+        returnValue = (long long)longValue;
+    }
     
-    if (listFile != NULL && nodeOffset >= 0 && nodeHeader != NULL) {
-        // Seek to node position
-        if (fseek(listFile, nodeOffset, SEEK_SET) == 0) {
-            // Read node header
-            readCount = fread(nodeHeader, sizeof(DoublyLinkedNodeHeader), 1, listFile);
-            if (readCount == 1) {
-                // Only read data if dataBuffer is provided
-                if (dataBuffer != NULL) {
-                    readCount = fread(dataBuffer, nodeHeader->dataSize, 1, listFile);
-                    success = (readCount == 1) ? 1 : 0;
-                } else {
-                    // Header-only read is valid (skip data portion)
-                    success = 1;
-                }
+    return returnValue;                                // Single return point
+}//end function definition ReadStatColumnValue
+
+/*
+ * Function: AccumulateTableStatistics
+ * Purpose: Counts one more row of a table and folds it into the column statistics
+ * Parameters: header - header being built
+ *            record - row appended after the rows already counted
+ * Returns: void
+ */
+void AccumulateTableStatistics(tableHeader* header, const void* record) {
+    tableColumnStats* column = NULL;                   // Current column
+    long long value = 0;                               // Column value of the row
+    
+    for (unsigned int c = 0; c < header->columnCount; c++) {
+        column = &header->columns[c];
+        value = ReadStatColumnValue(column, record);
+        if (header->rowCount == 0) {
+            column->minValue = value;
+            column->maxValue = value;
+        } else {
+            if (value < column->lastValue) {
+                column->isSorted = 0;
+            }
+            if (value < column->minValue) {
+                column->minValue = value;
+            }
+            if (value > column->maxValue) {
+                column->maxValue = value;
             }
         }
+        column->lastValue = value;
     }
-    
-    return success;                                    // Single return point
-}//end function definition ReadNodeFromList
+    header->rowCount++;
+}//end function definition AccumulateTableStatistics
 
 /*
- * Function: WriteNodeToList
- * Purpose: Writes/updates a node's data in linked list file
- * Parameters: listFile - open linked list file pointer
- *            nodeOffset - file offset where to write the node
- *            dataBuffer - data to write
- *            nodeHeader - node header information
- * Returns: int - 1 on success, 0 on failure
- * Note: Single return pattern, updates only specified node
+ * Function: OpenBinaryTable
+ * Purpose: Opens a binary table for sequential reading and validates its header
+ * Parameters: fileName - binary table file
+ *            recordSize - record size this build expects
+ *            header - receives the table header
+ * Returns: FILE* - table positioned at its first record, NULL if missing or not a valid table
+ * Note: A table written by a build with another record layout, or before tables had
+ *       headers, is rejected; option 1 rebuilds it
  */
-int WriteNodeToList(FILE* listFile, long nodeOffset, const void* dataBuffer, const DoublyLinkedNodeHeader* nodeHeader) {
-    int success = 0;                                   // Success flag (single return pattern)
-    size_t writeCount = 0;                             // Write operation count
+FILE* OpenBinaryTable(const char* fileName, size_t recordSize, tableHeader* header) {
+    FILE* tableFile = NULL;                            // Table file (single return pattern)
     
-    if (listFile != NULL && nodeOffset >= 0 && nodeHeader != NULL) {
-        // Seek to node position
-        if (fseek(listFile, nodeOffset, SEEK_SET) == 0) {
-            // Write node header
-            writeCount = fwrite(nodeHeader, sizeof(DoublyLinkedNodeHeader), 1, listFile);
-            if (writeCount == 1) {
-                // Only write data if dataBuffer is provided
-                if (dataBuffer != NULL) {
-                    writeCount = fwrite(dataBuffer, nodeHeader->dataSize, 1, listFile);
-                    success = (writeCount == 1) ? 1 : 0;
-                } else {
-                    // Header-only update is valid
-                    success = 1;
-                }
-            }
+    tableFile = OpenFileWithErrorCheck(fileName, "rb");
+    if (tableFile != NULL) {
+        if (CountedRead(header, sizeof(tableHeader), 1, tableFile) != 1 ||
+            header->magic != TABLE_HEADER_MAGIC || header->version != TABLE_HEADER_VERSION ||
+            header->recordSize != (unsigned int)recordSize || header->rowCount < 0 ||
+            header->columnCount > TABLE_MAX_STAT_COLUMNS) {
+            printf("Error: %s is not a table of this version; construct the database again\n", fileName);
+            fclose(tableFile);
+            tableFile = NULL;
         }
     }
     
-    return success;                                    // Single return point
-}//end function definition WriteNodeToList
+    return tableFile;                                  // Single return point
+}//end function definition OpenBinaryTable
 
 /*
- * Function: SwapAdjacentNodesInList
- * Purpose: Swaps data between two adjacent nodes in the linked list
- * Parameters: listFile - open linked list file pointer
- *            node1Offset - offset to first node
- *            node2Offset - offset to second node (must be node1's next)
- *            recordSize - size of record data
- * Returns: int - 1 on success, 0 on failure
- * Note: Swaps ONLY the data payloads, not the node headers (prev/next pointers remain unchanged)
- *       This is the correct and efficient approach for bubble sort in a doubly-linked list
- *       O(1) complexity for the swap operation itself
- *       Complies with file-based operations - no full data loading to RAM
+ * Function: OpenMappedBinaryTable
+ * Purpose: Maps a binary table for in-place record access and validates its header
+ * Parameters: table - table to open (any previous content is discarded)
+ *            fileName - binary table file
+ *            recordSize - record size this build expects
+ *            accessHint - TABLE_ACCESS_SEQUENTIAL or TABLE_ACCESS_RANDOM
+ *            header - receives the table header (NULL if not needed)
+ * Returns: int - 1 if the table is open, 0 on error
+ * Note: MappedRecordAt(table, 0) is the first record after the header, and recordCount
+ *       is the header's row count
  */
-int SwapAdjacentNodesInList(FILE* listFile, long node1Offset, long node2Offset, size_t recordSize) {
-    DoublyLinkedNodeHeader node1Header;                // First node header
-    DoublyLinkedNodeHeader node2Header;                // Second node header
-    void* data1 = NULL;                                // First node data
-    void* data2 = NULL;                                // Second node data
-    int success = 0;                                   // Success flag (single return pattern)
-    int allocationSuccess = 0;                         // Memory allocation flag
-    int readSuccess = 0;                               // Read operations flag
-    
-    // Allocate buffers for data
-    data1 = malloc(recordSize);
-    data2 = malloc(recordSize);
-    
-    if (data1 != NULL && data2 != NULL) {
-        allocationSuccess = 1;
-    }
+int OpenMappedBinaryTable(mappedTable* table, const char* fileName, size_t recordSize, int accessHint,
+                          tableHeader* header) {
+    tableHeader tableInfo;                             // Header of the table
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    if (allocationSuccess == 1) {
-        // Read both nodes
-        readSuccess = ReadNodeFromList(listFile, node1Offset, data1, &node1Header);
-        if (readSuccess == 1) {
-            readSuccess = ReadNodeFromList(listFile, node2Offset, data2, &node2Header);
+    if (OpenMappedTable(table, fileName, recordSize, accessHint) == 1) {
+        if (table->fileSize >= (long long)sizeof(tableHeader)) {
+            memcpy(&tableInfo, table->view, sizeof(tableHeader));
+        } else {
+            InitializeStructureToZero(&tableInfo, sizeof(tableHeader));
         }
-    }
-    
-    if (allocationSuccess == 1 && readSuccess == 1) {
-        // SOLUCIÓN: Solo intercambiar los DATOS, mantener headers intactos
-        // Esto es más simple y correcto para bubble sort
-        // Los punteros prev/next permanecen sin cambios
-        if (WriteNodeToList(listFile, node1Offset, data2, &node1Header) == 1) {
-            if (WriteNodeToList(listFile, node2Offset, data1, &node2Header) == 1) {
-                success = 1;
+        
+        if (tableInfo.magic == TABLE_HEADER_MAGIC && tableInfo.version == TABLE_HEADER_VERSION &&
+            tableInfo.recordSize == (unsigned int)recordSize && tableInfo.rowCount >= 0 &&
+            tableInfo.columnCount <= TABLE_MAX_STAT_COLUMNS &&
+            (long long)sizeof(tableHeader) + tableInfo.rowCount * (long long)recordSize <= table->fileSize) {
+            table->records = table->view + sizeof(tableHeader);
+            table->recordCount = (long)tableInfo.rowCount;
+            if (header != NULL) {
+                *header = tableInfo;
             }
+            returnValue = 1;
+        } else {
+            printf("Error: %s is not a table of this version; construct the database again\n", fileName);
+            CloseMappedTable(table);
         }
     }
     
-    // Cleanup
-    if (data1 != NULL) {
-        free(data1);
+    return returnValue;                                // Single return point
+}//end function definition OpenMappedBinaryTable
+
+/*
+ * Function: CountTableRecords
+ * Purpose: Returns the number of records in a binary table
+ * Parameters: tableFileName - binary table file
+ *            recordSize - size of each record in bytes
+ * Returns: long - row count from the table header, -1 if the table is missing or invalid
+ */
+long CountTableRecords(const char* tableFileName, size_t recordSize) {
+    FILE* tableFile = NULL;                            // Table file
+    tableHeader header;                                // Table header
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    tableFile = OpenBinaryTable(tableFileName, recordSize, &header);
+    if (tableFile != NULL) {
+        returnValue = (long)header.rowCount;
+        fclose(tableFile);
     }
-    if (data2 != NULL) {
-        free(data2);
+    
+    return returnValue;                                // Single return point
+}//end function definition CountTableRecords
+
+/*
+ * Function: WriteTableHeader
+ * Purpose: Writes a table header at the start of an open table file
+ * Parameters: tableFile - table file opened for writing
+ *            header - header to write; its buildTimestamp is set to now
+ * Returns: int - 1 if written, 0 on error
+ * Note: Leaves the file position after the header, where the first record belongs
+ */
+int WriteTableHeader(FILE* tableFile, tableHeader* header) {
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    header->buildTimestamp = (long long)time(NULL);
+    if (CountedSeek(tableFile, 0, SEEK_SET) == 0 &&
+        CountedWrite(header, sizeof(tableHeader), 1, tableFile) == 1) {
+        returnValue = 1;
     }
     
-    return success;                                    // Single return point
-}//end function definition SwapAdjacentNodesInList
+    return returnValue;                                // Single return point
+}//end function definition WriteTableHeader
 
 /*
- * Function: ConvertLinkedListToFile
- * Purpose: Extracts sorted data from linked list file to regular binary file
- * Parameters: linkedListFileName - source linked list file
- *            outputFileName - destination binary file
- * Returns: long - number of records written, -1 on error
- * Note: Traverses list in order and writes data sequentially
- *       Single return pattern, file-based traversal
+ * Function: FinalizeTableHeader
+ * Purpose: Counts rows written after a table's header and updates the header
+ * Parameters: fileName - table file
+ *            tableId - BINARY_TABLE_* id giving the layout
+ *            firstRecord - rows already described by the header (0 = new table)
+ *            rowCount - rows the table holds now
+ * Returns: long - rowCount, -1 on error
+ * Note: Only rows firstRecord to rowCount - 1 are read, so after an append the cost
+ *       follows the appended rows; sort flags continue from each column's lastValue.
+ *       The header is written last.
  */
-long ConvertLinkedListToFile(const char* linkedListFileName, const char* outputFileName) {
-    FILE* listFile = NULL;                             // Linked list file
-    FILE* outputFile = NULL;                           // Output binary file
-    LinkedListFileMetadata metadata;                   // List metadata
-    DoublyLinkedNodeHeader nodeHeader;                 // Current node header
-    void* dataBuffer = NULL;                           // Data buffer
-    long currentOffset = 0;                            // Current node offset
-    long recordsWritten = 0;                           // Count of records written
+long FinalizeTableHeader(const char* fileName, int tableId, long firstRecord, long rowCount) {
+    const binaryTableSchema* schema = &binaryTableSchemas[tableId]; // Table layout
+    mappedTable table;                                 // Rows of the table
+    tableHeader header;                                // Header being rebuilt
+    FILE* tableFile = NULL;                            // Table opened to rewrite its header
     int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
     
-    // Open linked list file
-    listFile = OpenFileWithErrorCheck(linkedListFileName, "rb");
-    if (listFile == NULL) {
+    InitializeStructureToZero(&table, sizeof(mappedTable));
+    InitializeTableHeader(&header, tableId);
+    if (firstRecord > 0) {
+        tableFile = OpenBinaryTable(fileName, schema->recordSize, &header);
+        if (tableFile == NULL || header.rowCount != firstRecord) {
+            errorOccurred = 1;
+        }
+        if (tableFile != NULL) fclose(tableFile);
+        tableFile = NULL;
+    }
+    
+    // Fold the new rows into the statistics, reading them in place
+    if (errorOccurred == 0 && OpenMappedTable(&table, fileName, 1, TABLE_ACCESS_SEQUENTIAL) == 0) {
+        errorOccurred = 1;
+    }
+    if (errorOccurred == 0 &&
+        table.fileSize < (long long)sizeof(tableHeader) + (long long)rowCount * (long long)schema->recordSize) {
+        printf("Error: %s holds fewer than %ld records\n", fileName, rowCount);
         errorOccurred = 1;
-        recordsWritten = -1;
     }
+    for (long i = firstRecord; i < rowCount && errorOccurred == 0; i++) {
+        AccumulateTableStatistics(&header, table.view + sizeof(tableHeader) + (size_t)i * schema->recordSize);
+    }
+    CloseMappedTable(&table);
     
     if (errorOccurred == 0) {
-        // Read metadata
-        if (fread(&metadata, sizeof(LinkedListFileMetadata), 1, listFile) != 1) {
+        tableFile = OpenFileWithErrorCheck(fileName, "rb+");
+        if (tableFile == NULL || WriteTableHeader(tableFile, &header) == 0) {
             errorOccurred = 1;
-            recordsWritten = -1;
         }
-    }
-    
-    if (errorOccurred == 0) {
-        // Allocate data buffer
-        dataBuffer = malloc(metadata.recordSize);
-        if (dataBuffer == NULL) {
+        if (tableFile != NULL && fclose(tableFile) != 0) {
             errorOccurred = 1;
-            recordsWritten = -1;
         }
     }
     
     if (errorOccurred == 0) {
-        // Open output file
-        outputFile = OpenFileWithErrorCheck(outputFileName, "wb");
-        if (outputFile == NULL) {
-            errorOccurred = 1;
-            recordsWritten = -1;
-        }
+        returnValue = rowCount;
+    } else {
+        printf("Error: Cannot write the table header of %s\n", fileName);
     }
     
-    if (errorOccurred == 0) {
-        // Traverse list from head to tail
-        currentOffset = metadata.headOffset;
-        long maxNodes = metadata.nodeCount;            // Maximum expected nodes
-        long nodesProcessed = 0;                       // Nodes actually processed
-        
-        while (currentOffset != -1 && errorOccurred == 0 && nodesProcessed < maxNodes) {
-            // Read node
-            if (ReadNodeFromList(listFile, currentOffset, dataBuffer, &nodeHeader) == 1) {
-                // Write data to output file
-                if (fwrite(dataBuffer, metadata.recordSize, 1, outputFile) == 1) {
-                    recordsWritten++;
-                    currentOffset = nodeHeader.nextOffset; // Move to next node
-                    nodesProcessed++;
-                } else {
-                    errorOccurred = 1;
-                    recordsWritten = -1;
-                }
-            } else {
-                errorOccurred = 1;
-                recordsWritten = -1;
+    return returnValue;                                // Single return point
+}//end function definition FinalizeTableHeader
+
+/*
+ * Function: TableColumnIsSorted
+ * Purpose: Tells whether a table's rows are in ascending order of one column
+ * Parameters: tableId - BINARY_TABLE_* id
+ *            fieldOffset - offset of the column in the record (offsetof)
+ * Returns: int - 1 if the header records the column as sorted, 0 otherwise or on error
+ * Note: Reads only the header, so a caller can decide to skip a sort before reading data
+ */
+int TableColumnIsSorted(int tableId, size_t fieldOffset) {
+    FILE* tableFile = NULL;                            // Table file
+    tableHeader header;                                // Table header
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    tableFile = OpenBinaryTable(binaryTableSchemas[tableId].fileName, binaryTableSchemas[tableId].recordSize, &header);
+    if (tableFile != NULL) {
+        for (unsigned int c = 0; c < header.columnCount; c++) {
+            if (header.columns[c].fieldOffset == (unsigned int)fieldOffset && header.columns[c].isSorted == 1) {
+                returnValue = 1;
             }
         }
-        
-        // Verify we processed the expected count
-        if (errorOccurred == 0 && recordsWritten != metadata.nodeCount) {
-            printf("Warning: Expected %ld records but wrote %ld\n", metadata.nodeCount, recordsWritten);
-        }
-    }
-    
-    // Cleanup
-    if (dataBuffer != NULL) {
-        free(dataBuffer);
-    }
-    if (listFile != NULL) {
-        fclose(listFile);
-    }
-    if (outputFile != NULL) {
-        fclose(outputFile);
+        fclose(tableFile);
     }
     
-    return recordsWritten;                             // Single return point
-}//end function definition ConvertLinkedListToFile
+    return returnValue;                                // Single return point
+}//end function definition TableColumnIsSorted
 
-// ====================== MERGE SORT LINKED LIST OPERATIONS ======================
+// ====================== DICTIONARY ENCODING ======================
+// Low-cardinality text columns of the customer and product tables are stored as
+// dictionaryCode values. Each table keeps the distinct values of its encoded columns in
+// a dictionary file written next to the table; codes are handed out in order of first
+// appearance while the table is converted and are decoded only where a report prints
+// or sorts by name. A table's dictionary is loaded once per process on first use.
+static columnDictionary tableDictionaries[BINARY_TABLE_COUNT][DICTIONARY_MAX_COLUMNS]; // Values of each encoded column
+static int tableDictionaryLoaded[BINARY_TABLE_COUNT] = {0}; // 1 once a table's dictionary is in memory
 
 /*
- * Function: MergeTwoSortedListsWithLimit
- * Purpose: Merges two sorted sublists with node count limits (for iterative merge sort)
- * Parameters: listFile - open linked list file pointer
- *            left1Offset - start of first sorted sublist
- *            left1Count - maximum nodes to take from first sublist
- *            left2Offset - start of second sorted sublist  
- *            left2Count - maximum nodes to take from second sublist
- *            recordSize - size of data records
- *            compareFunction - comparison function for sorting
- *            mergedHeadOffset - pointer to store merged list head
- *            mergedTailOffset - pointer to store merged list tail
- * Returns: int - 1 on success, 0 on failure
- * Note: Optimized version with node count limits for bottom-up merge sort
- */
-int MergeTwoSortedListsWithLimit(FILE* listFile, long left1Offset, long left1Count,
-                                  long left2Offset, long left2Count, size_t recordSize,
-                                  int (*compareFunction)(const void*, const void*),
-                                  long* mergedHeadOffset, long* mergedTailOffset) {
-    DoublyLinkedNodeHeader node1Header, node2Header;   // Node headers
-    void* data1 = NULL;                                // First list node data
-    void* data2 = NULL;                                // Second list node data  
-    long current1 = left1Offset;                       // Current position in list 1
-    long current2 = left2Offset;                       // Current position in list 2
-    long next1 = -1;                                   // Cached next offset for list 1
-    long next2 = -1;                                   // Cached next offset for list 2
-    long count1 = 0;                                   // Nodes processed from list 1
-    long count2 = 0;                                   // Nodes processed from list 2
-    long mergedHead = -1;                              // Head of merged list
-    long mergedTail = -1;                              // Tail of merged list
-    int errorOccurred = 0;                             // Error flag
-    int success = 0;                                   // Success flag
-    int data1Valid = 0;                                // Flag indicating data1 has valid data
-    int data2Valid = 0;                                // Flag indicating data2 has valid data
+ * Function: HashDictionaryValue
+ * Purpose: Hashes a dictionary value (FNV-1a)
+ * Parameters: value - NUL-terminated value
+ * Returns: unsigned long - hash of the value
+ */
+unsigned long HashDictionaryValue(const char* value) {
+    unsigned long hash = 2166136261UL;                 // FNV offset basis
     
-    // Allocate buffers
-    data1 = malloc(recordSize);
-    data2 = malloc(recordSize);
-    if (data1 == NULL || data2 == NULL) {
-        errorOccurred = 1;
+    while (*value != '\0') {
+        hash ^= (unsigned char)*value;
+        hash *= 16777619UL;                            // FNV prime
+        value++;
     }
     
-    // Pre-read first node from each list if available
-    if (errorOccurred == 0 && count1 < left1Count && current1 != -1) {
-        if (ReadNodeFromList(listFile, current1, data1, &node1Header) == 1) {
-            next1 = node1Header.nextOffset;
-            data1Valid = 1;
-        } else {
-            errorOccurred = 1;
+    return hash;
+}//end function definition HashDictionaryValue
+
+/*
+ * Function: InvalidateTableDictionary
+ * Purpose: Releases a table's dictionary so the next use reloads it from its file
+ * Parameters: tableId - BINARY_TABLE_* id
+ * Returns: void
+ * Note: Must be called whenever values were encoded that did not reach the file
+ */
+void InvalidateTableDictionary(int tableId) {
+    for (int column = 0; column < DICTIONARY_MAX_COLUMNS; column++) {
+        free(tableDictionaries[tableId][column].values);
+        free(tableDictionaries[tableId][column].hashSlots);
+        InitializeStructureToZero(&tableDictionaries[tableId][column], sizeof(columnDictionary));
+    }
+    tableDictionaryLoaded[tableId] = 0;
+}//end function definition InvalidateTableDictionary
+
+/*
+ * Function: ResetTableDictionary
+ * Purpose: Starts an empty dictionary for a table that is being rebuilt
+ * Parameters: tableId - BINARY_TABLE_* id
+ * Returns: void
+ */
+void ResetTableDictionary(int tableId) {
+    InvalidateTableDictionary(tableId);
+    tableDictionaryLoaded[tableId] = 1;
+}//end function definition ResetTableDictionary
+
+/*
+ * Function: GrowDictionaryHash
+ * Purpose: Doubles the hash slots of a column dictionary and rehashes its values
+ * Parameters: dictionary - column dictionary to grow
+ * Returns: int - 1 on success, 0 if memory is exhausted
+ */
+int GrowDictionaryHash(columnDictionary* dictionary) {
+    long slotCount = (dictionary->slotCount > 0) ? dictionary->slotCount * 2 : 64; // New slot count
+    unsigned int* hashSlots = NULL;                    // New hash slots
+    unsigned long slot = 0;                            // Slot of the value being placed
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    hashSlots = (unsigned int*)calloc((size_t)slotCount, sizeof(unsigned int));
+    if (hashSlots != NULL) {
+        for (long code = 0; code < dictionary->valueCount; code++) {
+            slot = HashDictionaryValue(dictionary->values[code]) & (unsigned long)(slotCount - 1);
+            while (hashSlots[slot] != 0) {
+                slot = (slot + 1) & (unsigned long)(slotCount - 1);
+            }
+            hashSlots[slot] = (unsigned int)code + 1;
         }
+        free(dictionary->hashSlots);
+        dictionary->hashSlots = hashSlots;
+        dictionary->slotCount = slotCount;
+        returnValue = 1;
     }
     
-    if (errorOccurred == 0 && count2 < left2Count && current2 != -1) {
-        if (ReadNodeFromList(listFile, current2, data2, &node2Header) == 1) {
-            next2 = node2Header.nextOffset;
-            data2Valid = 1;
-        } else {
-            errorOccurred = 1;
-        }
+    return returnValue;                                // Single return point
+}//end function definition GrowDictionaryHash
+
+/*
+ * Function: EncodeDictionaryValue
+ * Purpose: Returns the code of a value, adding the value to the column dictionary if new
+ * Parameters: tableId - BINARY_TABLE_* id
+ *            column - encoded column (CUSTOMER_DICTIONARY_* or PRODUCT_DICTIONARY_*)
+ *            value - NUL-terminated value (at most DICTIONARY_VALUE_LENGTH - 1 characters kept)
+ *            code - receives the code
+ * Returns: int - 1 on success, 0 if the column already holds DICTIONARY_MAX_VALUES values
+ *          or memory is exhausted
+ * Note: Not thread-safe; each table is encoded by a single conversion thread
+ */
+int EncodeDictionaryValue(int tableId, int column, const char* value, dictionaryCode* code) {
+    columnDictionary* dictionary = &tableDictionaries[tableId][column]; // Column dictionary
+    char storedValue[DICTIONARY_VALUE_LENGTH] = {0};   // Value as stored, NUL padded
+    char (*values)[DICTIONARY_VALUE_LENGTH] = NULL;    // Grown value array
+    unsigned long slot = 0;                            // Hash slot being probed
+    long foundCode = -1;                               // Code of the value, -1 if new
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    strncpy(storedValue, value, DICTIONARY_VALUE_LENGTH - 1);
+    
+    if ((dictionary->valueCount + 1) * 2 > dictionary->slotCount && GrowDictionaryHash(dictionary) == 0) {
+        errorOccurred = 1;
     }
     
-    // Merge with limits - no re-reading needed
-    while (errorOccurred == 0 && (count1 < left1Count || count2 < left2Count)) {
-        int takeFrom1 = 0;                             // Flag to take from list 1
-        long selectedOffset = -1;                      // Selected node offset
-        DoublyLinkedNodeHeader selectedHeader;         // Selected node header
-        
-        // Decide which list to take from based on cached data
-        if (count1 >= left1Count || data1Valid == 0) {
-            takeFrom1 = 0;                             // List 1 exhausted
-        } else if (count2 >= left2Count || data2Valid == 0) {
-            takeFrom1 = 1;                             // List 2 exhausted
-        } else {
-            // Compare using already-loaded data
-            takeFrom1 = (compareFunction(data1, data2) <= 0) ? 1 : 0;
-        }
-        
-        // Take node and cache next offset (no re-read)
-        if (errorOccurred == 0) {
-            if (takeFrom1 == 1) {
-                selectedOffset = current1;
-                selectedHeader = node1Header;
-                current1 = next1;                      // Use cached next offset
-                count1++;
-                data1Valid = 0;                        // Mark data1 as consumed
-                
-                // Read next node from list 1 if more remain
-                if (count1 < left1Count && current1 != -1) {
-                    if (ReadNodeFromList(listFile, current1, data1, &node1Header) == 1) {
-                        next1 = node1Header.nextOffset;
-                        data1Valid = 1;
-                    } else {
-                        errorOccurred = 1;
-                    }
-                }
+    if (errorOccurred == 0) {
+        slot = HashDictionaryValue(storedValue) & (unsigned long)(dictionary->slotCount - 1);
+        while (dictionary->hashSlots[slot] != 0 && foundCode < 0) {
+            if (strcmp(dictionary->values[dictionary->hashSlots[slot] - 1], storedValue) == 0) {
+                foundCode = (long)dictionary->hashSlots[slot] - 1;
             } else {
-                selectedOffset = current2;
-                selectedHeader = node2Header;
-                current2 = next2;                      // Use cached next offset
-                count2++;
-                data2Valid = 0;                        // Mark data2 as consumed
-                
-                // Read next node from list 2 if more remain
-                if (count2 < left2Count && current2 != -1) {
-                    if (ReadNodeFromList(listFile, current2, data2, &node2Header) == 1) {
-                        next2 = node2Header.nextOffset;
-                        data2Valid = 1;
-                    } else {
-                        errorOccurred = 1;
-                    }
-                }
-            }
-            
-            // Append selected node to merged list
-            if (errorOccurred == 0 && selectedOffset != -1) {
-                if (mergedHead == -1) {
-                    // First node in merged list
-                    mergedHead = selectedOffset;
-                    mergedTail = selectedOffset;
-                    
-                    // Update selected node's prev to -1 (it's now the head)
-                    selectedHeader.prevOffset = -1;
-                    selectedHeader.nextOffset = -1;    // Will be updated when next node is added
-                    if (WriteNodeToList(listFile, selectedOffset, NULL, &selectedHeader) != 1) {
-                        errorOccurred = 1;
-                    }
-                } else {
-                    // Link to previous tail - batch pointer updates
-                    DoublyLinkedNodeHeader tailHeader;
-                    
-                    // Read current tail header
-                    if (ReadNodeFromList(listFile, mergedTail, NULL, &tailHeader) == 1) {
-                        // Update tail to point to new node
-                        tailHeader.nextOffset = selectedOffset;
-                        
-                        // Update selected node to point back to tail
-                        selectedHeader.prevOffset = mergedTail;
-                        selectedHeader.nextOffset = -1;
-                        
-                        // Write both updates (grouped writes for better I/O)
-                        if (WriteNodeToList(listFile, mergedTail, NULL, &tailHeader) == 1) {
-                            if (WriteNodeToList(listFile, selectedOffset, NULL, &selectedHeader) == 1) {
-                                mergedTail = selectedOffset;
-                            } else {
-                                errorOccurred = 1;
-                            }
-                        } else {
-                            errorOccurred = 1;
-                        }
-                    } else {
-                        errorOccurred = 1;
-                    }
-                }
+                slot = (slot + 1) & (unsigned long)(dictionary->slotCount - 1);
             }
         }
     }
     
-    // Set output
-    if (errorOccurred == 0) {
-        if (mergedHeadOffset != NULL) *mergedHeadOffset = mergedHead;
-        if (mergedTailOffset != NULL) *mergedTailOffset = mergedTail;
-        success = 1;
-    }
-    
-    // Cleanup
-    if (data1 != NULL) free(data1);
-    if (data2 != NULL) free(data2);
-    
-    return success;                                    // Single return point
-}//end function definition MergeTwoSortedListsWithLimit
-
-/*
- * Function: GetMiddleNodeOffset
- * Purpose: Finds the middle node offset in a linked list segment using slow/fast pointer technique
- * Parameters: listFile - open linked list file pointer
- *            headOffset - starting node offset
- *            tailOffset - ending node offset (can be -1 for unknown)
- * Returns: long - offset to middle node, -1 on error
- * Note: Uses tortoise-hare algorithm for O(n) traversal without counting
- */
-long GetMiddleNodeOffset(FILE* listFile, long headOffset, long tailOffset) {
-    DoublyLinkedNodeHeader slowHeader;                 // Slow pointer node header
-    DoublyLinkedNodeHeader fastHeader;                 // Fast pointer node header
-    long slowOffset = headOffset;                      // Slow pointer offset
-    long fastOffset = headOffset;                      // Fast pointer offset
-    int errorOccurred = 0;                             // Error flag
-    long middleOffset = -1;                            // Result middle offset
-    
-    if (listFile == NULL || headOffset == -1) {
-        middleOffset = -1;
-    } else {
-        // Traverse with slow (1 step) and fast (2 steps) pointers
-        while (fastOffset != -1 && fastOffset != tailOffset && errorOccurred == 0) {
-            // Read fast pointer node
-            if (fseek(listFile, fastOffset, SEEK_SET) == 0) {
-                if (fread(&fastHeader, sizeof(DoublyLinkedNodeHeader), 1, listFile) == 1) {
-                    fastOffset = fastHeader.nextOffset;
-                    
-                    // Move fast pointer one more step if possible
-                    if (fastOffset != -1 && fastOffset != tailOffset) {
-                        if (fseek(listFile, fastOffset, SEEK_SET) == 0) {
-                            if (fread(&fastHeader, sizeof(DoublyLinkedNodeHeader), 1, listFile) == 1) {
-                                fastOffset = fastHeader.nextOffset;
-                                
-                                // Move slow pointer one step
-                                if (fseek(listFile, slowOffset, SEEK_SET) == 0) {
-                                    if (fread(&slowHeader, sizeof(DoublyLinkedNodeHeader), 1, listFile) == 1) {
-                                        slowOffset = slowHeader.nextOffset;
-                                    } else {
-                                        errorOccurred = 1;
-                                    }
-                                } else {
-                                    errorOccurred = 1;
-                                }
-                            } else {
-                                errorOccurred = 1;
-                            }
-                        } else {
-                            errorOccurred = 1;
-                        }
-                    }
-                } else {
-                    errorOccurred = 1;
-                }
-            } else {
+    // New value: append it and claim the empty slot the probe stopped at
+    if (errorOccurred == 0 && foundCode < 0) {
+        if (dictionary->valueCount >= DICTIONARY_MAX_VALUES) {
+            errorOccurred = 1;
+        } else if (dictionary->valueCount == dictionary->capacity) {
+            values = realloc(dictionary->values,
+                             (size_t)(dictionary->capacity + 64) * DICTIONARY_VALUE_LENGTH);
+            if (values == NULL) {
                 errorOccurred = 1;
+            } else {
+                dictionary->values = values;
+                dictionary->capacity += 64;
             }
         }
-        
-        middleOffset = (errorOccurred == 0) ? slowOffset : -1;
+        if (errorOccurred == 0) {
+            foundCode = dictionary->valueCount;
+            memcpy(dictionary->values[foundCode], storedValue, DICTIONARY_VALUE_LENGTH);
+            dictionary->hashSlots[slot] = (unsigned int)foundCode + 1;
+            dictionary->valueCount++;
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        *code = (dictionaryCode)foundCode;
+        returnValue = 1;
+    } else {
+        printf("Error: Cannot add '%s' to the dictionary of %s\n", storedValue, binaryTableSchemas[tableId].fileName);
     }
     
-    return middleOffset;                               // Single return point
-}//end function definition GetMiddleNodeOffset
+    return returnValue;                                // Single return point
+}//end function definition EncodeDictionaryValue
 
 /*
- * Function: MergeTwoSortedLists
- * Purpose: Merges two sorted sublists in a linked list file
- * Parameters: listFile - open linked list file pointer
- *            left1Offset - start of first sorted sublist
- *            left2Offset - start of second sorted sublist
- *            recordSize - size of data records
- *            compareFunction - comparison function for sorting
- *            mergedHeadOffset - pointer to store merged list head
- *            mergedTailOffset - pointer to store merged list tail
- * Returns: int - 1 on success, 0 on failure
- * Note: Merges by relinking pointers, not moving data physically
- */
-int MergeTwoSortedLists(FILE* listFile, long left1Offset, long left2Offset, 
-                        size_t recordSize, int (*compareFunction)(const void*, const void*),
-                        long* mergedHeadOffset, long* mergedTailOffset) {
-    DoublyLinkedNodeHeader node1Header;                // First list node header
-    DoublyLinkedNodeHeader node2Header;                // Second list node header
-    void* data1 = NULL;                                // First list node data
-    void* data2 = NULL;                                // Second list node data
-    long current1 = left1Offset;                       // Current position in list 1
-    long current2 = left2Offset;                       // Current position in list 2
-    long mergedHead = -1;                              // Head of merged list
-    long mergedTail = -1;                              // Tail of merged list
-    long lastMergedOffset = -1;                        // Last node added to merged list
-    int comparisonResult = 0;                          // Comparison result
+ * Function: SaveTableDictionary
+ * Purpose: Writes a table's dictionary to its dictionary file
+ * Parameters: tableId - BINARY_TABLE_* id
+ * Returns: int - 1 if written, 0 on error
+ */
+int SaveTableDictionary(int tableId) {
+    const binaryTableSchema* schema = &binaryTableSchemas[tableId]; // Table layout
+    FILE* dictionaryFile = NULL;                       // Dictionary file
+    dictionaryFileHeader header;                       // File header
+    unsigned int valueCount = 0;                       // Values of the current column
     int errorOccurred = 0;                             // Error flag
-    int list1HasData = 0;                              // Flag for list 1 data availability
-    int list2HasData = 0;                              // Flag for list 2 data availability
-    int success = 0;                                   // Success flag (single return pattern)
-    
-    // Initialize output parameters
-    if (mergedHeadOffset != NULL) {
-        *mergedHeadOffset = -1;
-    }
-    if (mergedTailOffset != NULL) {
-        *mergedTailOffset = -1;
-    }
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    // Allocate buffers for data comparison
-    data1 = malloc(recordSize);
-    data2 = malloc(recordSize);
+    InitializeStructureToZero(&header, sizeof(dictionaryFileHeader));
+    header.magic = DICTIONARY_MAGIC;
+    header.version = DICTIONARY_VERSION;
+    header.columnCount = (unsigned int)schema->dictionaryColumns;
+    header.valueLength = DICTIONARY_VALUE_LENGTH;
     
-    if (data1 == NULL || data2 == NULL) {
+    dictionaryFile = OpenFileWithErrorCheck(schema->dictionaryFileName, "wb");
+    if (dictionaryFile == NULL || CountedWrite(&header, sizeof(dictionaryFileHeader), 1, dictionaryFile) != 1) {
         errorOccurred = 1;
     }
-    
-    // Read first nodes from both lists
-    if (errorOccurred == 0 && current1 != -1) {
-        list1HasData = ReadNodeFromList(listFile, current1, data1, &node1Header);
-    }
-    if (errorOccurred == 0 && current2 != -1) {
-        list2HasData = ReadNodeFromList(listFile, current2, data2, &node2Header);
-    }
-    
-    // Merge the two lists by comparing and relinking
-    while ((list1HasData == 1 || list2HasData == 1) && errorOccurred == 0) {
-        long selectedOffset = -1;                      // Offset of node to add to merged list
-        long nextOffset = -1;                          // Next offset to process
-        
-        // Determine which node to take
-        if (list1HasData == 1 && list2HasData == 0) {
-            // Only list 1 has data
-            selectedOffset = current1;
-            nextOffset = node1Header.nextOffset;
-            current1 = nextOffset;
-            list1HasData = (current1 != -1) ? ReadNodeFromList(listFile, current1, data1, &node1Header) : 0;
-        } else if (list1HasData == 0 && list2HasData == 1) {
-            // Only list 2 has data
-            selectedOffset = current2;
-            nextOffset = node2Header.nextOffset;
-            current2 = nextOffset;
-            list2HasData = (current2 != -1) ? ReadNodeFromList(listFile, current2, data2, &node2Header) : 0;
-        } else if (list1HasData == 1 && list2HasData == 1) {
-            // Both have data, compare
-            comparisonResult = compareFunction(data1, data2);
-            
-            if (comparisonResult <= 0) {
-                // Take from list 1
-                selectedOffset = current1;
-                nextOffset = node1Header.nextOffset;
-                current1 = nextOffset;
-                list1HasData = (current1 != -1) ? ReadNodeFromList(listFile, current1, data1, &node1Header) : 0;
-            } else {
-                // Take from list 2
-                selectedOffset = current2;
-                nextOffset = node2Header.nextOffset;
-                current2 = nextOffset;
-                list2HasData = (current2 != -1) ? ReadNodeFromList(listFile, current2, data2, &node2Header) : 0;
-            }
-        }
-        
-        // Add selected node to merged list
-        if (selectedOffset != -1) {
-            if (mergedHead == -1) {
-                // First node in merged list
-                mergedHead = selectedOffset;
-                mergedTail = selectedOffset;
-            } else {
-                // Link to previous node
-                if (fseek(listFile, lastMergedOffset + sizeof(long), SEEK_SET) == 0) {
-                    fwrite(&selectedOffset, sizeof(long), 1, listFile); // Update prev node's next
-                    
-                    // Update current node's prev
-                    if (fseek(listFile, selectedOffset, SEEK_SET) == 0) {
-                        fwrite(&lastMergedOffset, sizeof(long), 1, listFile);
-                    }
-                }
-                mergedTail = selectedOffset;
-            }
-            lastMergedOffset = selectedOffset;
+    for (int column = 0; column < schema->dictionaryColumns && errorOccurred == 0; column++) {
+        valueCount = (unsigned int)tableDictionaries[tableId][column].valueCount;
+        if (CountedWrite(&valueCount, sizeof(unsigned int), 1, dictionaryFile) != 1 ||
+            (valueCount > 0 &&
+             CountedWrite(tableDictionaries[tableId][column].values, DICTIONARY_VALUE_LENGTH, valueCount,
+                          dictionaryFile) != valueCount)) {
+            errorOccurred = 1;
         }
     }
-    
-    // Set output parameters
-    if (errorOccurred == 0) {
-        if (mergedHeadOffset != NULL) {
-            *mergedHeadOffset = mergedHead;
-        }
-        if (mergedTailOffset != NULL) {
-            *mergedTailOffset = mergedTail;
-        }
-        success = 1;
+    if (dictionaryFile != NULL && fclose(dictionaryFile) != 0) {
+        errorOccurred = 1;
     }
     
-    // Cleanup
-    if (data1 != NULL) {
-        free(data1);
-    }
-    if (data2 != NULL) {
-        free(data2);
+    if (errorOccurred == 0) {
+        returnValue = 1;
+    } else {
+        printf("Error: Cannot write %s\n", schema->dictionaryFileName);
     }
     
-    return success;                                    // Single return point
-}//end function definition MergeTwoSortedLists
+    return returnValue;                                // Single return point
+}//end function definition SaveTableDictionary
 
 /*
- * Function: MergeSortLinkedListIterative
- * Purpose: Sorts linked list using ITERATIVE bottom-up merge sort (no recursion)
- * Parameters: listFile - open linked list file pointer
- *            headOffset - start of list segment to sort
- *            nodeCount - total number of nodes in list
- *            recordSize - size of data records
- *            compareFunction - comparison function for sorting
- *            sortedHeadOffset - pointer to store sorted segment head
- *            sortedTailOffset - pointer to store sorted segment tail
- * Returns: int - 1 on success, 0 on failure
- * Note: Bottom-up approach with O(n log n) complexity, no stack overflow risk
- *       Optimized to minimize I/O: avoids repeated traversals, caches offsets
- */
-int MergeSortLinkedListIterative(FILE* listFile, long headOffset, long nodeCount,
-                                  size_t recordSize, int (*compareFunction)(const void*, const void*),
-                                  long* sortedHeadOffset, long* sortedTailOffset) {
-    DoublyLinkedNodeHeader nodeHeader;                 // Node header buffer
-    long currentHead = headOffset;                     // Current list head (cached)
-    long currentTail = -1;                             // Current list tail (cached)
-    long sublistSize = 1;                              // Size of sublists to merge
+ * Function: LoadTableDictionary
+ * Purpose: Reads a table's dictionary file into memory
+ * Parameters: tableId - BINARY_TABLE_* id
+ * Returns: int - 1 if the dictionary is loaded, 0 on error
+ * Note: Does nothing if the dictionary is already loaded. Values keep their file order,
+ *       so each value gets back the code the table records hold.
+ */
+int LoadTableDictionary(int tableId) {
+    const binaryTableSchema* schema = &binaryTableSchemas[tableId]; // Table layout
+    FILE* dictionaryFile = NULL;                       // Dictionary file
+    dictionaryFileHeader header;                       // File header
+    char storedValue[DICTIONARY_VALUE_LENGTH];         // Value being read
+    unsigned int valueCount = 0;                       // Values of the current column
+    dictionaryCode code = 0;                           // Code given to the value read
     int errorOccurred = 0;                             // Error flag
-    int success = 0;                                   // Success flag
-    
-    // Initialize output
-    if (sortedHeadOffset != NULL) {
-        *sortedHeadOffset = headOffset;
-    }
-    if (sortedTailOffset != NULL) {
-        *sortedTailOffset = -1;
-    }
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    // Base case: empty or single node
-    if (nodeCount <= 1) {
-        success = 1;
-        if (sortedTailOffset != NULL && nodeCount == 1) {
-            *sortedTailOffset = headOffset;
-        }
+    if (tableDictionaryLoaded[tableId] == 1) {
+        returnValue = 1;
     } else {
-        int maxIterations = 64;                        // Prevent infinite loops (log2 of huge number)
-        int iteration = 0;                             // Current iteration count
-        
-        // Find tail initially (one-time traversal, then cached)
-        if (errorOccurred == 0) {
-            long tempPos = headOffset;
-            currentTail = headOffset;
-            int foundEnd = 0;
-            
-            while (tempPos != -1 && foundEnd == 0) {
-                if (ReadNodeFromList(listFile, tempPos, NULL, &nodeHeader) == 1) {
-                    currentTail = tempPos;
-                    if (nodeHeader.nextOffset == -1) {
-                        foundEnd = 1;
-                    } else {
-                        tempPos = nodeHeader.nextOffset;
-                    }
-                } else {
-                    errorOccurred = 1;
-                    foundEnd = 1;
-                }
-            }
+        ResetTableDictionary(tableId);
+        dictionaryFile = OpenFileWithErrorCheck(schema->dictionaryFileName, "rb");
+        if (dictionaryFile == NULL ||
+            CountedRead(&header, sizeof(dictionaryFileHeader), 1, dictionaryFile) != 1 ||
+            header.magic != DICTIONARY_MAGIC || header.version != DICTIONARY_VERSION ||
+            header.columnCount != (unsigned int)schema->dictionaryColumns ||
+            header.valueLength != DICTIONARY_VALUE_LENGTH) {
+            errorOccurred = 1;
         }
-        
-        // Bottom-up merge sort: start with sublist size 1, double each iteration
-        while (sublistSize < nodeCount && errorOccurred == 0 && iteration < maxIterations) {
-            long mergedListHead = -1;                  // Head of new merged list
-            long mergedListTail = -1;                  // Tail of new merged list
-            long currentPos = currentHead;             // Current position in old list
-            long numMerges = 0;                        // Number of merges performed
-            iteration++;
-            
-            printf("Merge sort iteration %d: sublist size %ld\n", iteration, sublistSize);
-            
-            // Merge pairs of sublists
-            while (currentPos != -1 && errorOccurred == 0) {
-                long left1Start = currentPos;          // Start of first sublist
-                long left2Start = -1;                  // Start of second sublist
-                long nextPairStart = -1;               // Start of next pair
-                long left1Count = 0;                   // Count of nodes in sublist 1
-                long left2Count = 0;                   // Count of nodes in sublist 2
-                long mergedHead = -1;                  // Head of merged pair
-                long mergedTail = -1;                  // Tail of merged pair
-                
-                // Skip sublistSize nodes to find start of second sublist (optimized counting)
-                left2Start = left1Start;
-                while (left1Count < sublistSize && left2Start != -1 && errorOccurred == 0) {
-                    if (ReadNodeFromList(listFile, left2Start, NULL, &nodeHeader) == 1) {
-                        left2Start = nodeHeader.nextOffset;
-                        left1Count++;
-                    } else {
-                        errorOccurred = 1;
-                    }
-                }
-                
-                // If no second sublist, first sublist goes to end (count actual nodes)
-                if (left2Start == -1) {
-                    // Remaining nodes form a single sublist - append it to merged list
-                    mergedHead = left1Start;
-                    
-                    // Find actual tail of this sublist
-                    long tempPos = left1Start;
-                    mergedTail = left1Start;
-                    int foundEnd = 0;
-                    
-                    while (tempPos != -1 && foundEnd == 0) {
-                        if (ReadNodeFromList(listFile, tempPos, NULL, &nodeHeader) == 1) {
-                            mergedTail = tempPos;
-                            if (nodeHeader.nextOffset == -1) {
-                                foundEnd = 1;
-                            } else {
-                                tempPos = nodeHeader.nextOffset;
-                            }
-                        } else {
-                            errorOccurred = 1;
-                            foundEnd = 1;
-                        }
-                    }
-                    
-                    nextPairStart = -1;                // No more pairs
+        for (int column = 0; column < schema->dictionaryColumns && errorOccurred == 0; column++) {
+            if (CountedRead(&valueCount, sizeof(unsigned int), 1, dictionaryFile) != 1) {
+                errorOccurred = 1;
+            }
+            for (unsigned int i = 0; i < valueCount && errorOccurred == 0; i++) {
+                if (CountedRead(storedValue, DICTIONARY_VALUE_LENGTH, 1, dictionaryFile) != 1) {
+                    errorOccurred = 1;
                 } else {
-                    // Find start of next pair (skip another sublistSize nodes from left2Start)
-                    nextPairStart = left2Start;
-                    while (left2Count < sublistSize && nextPairStart != -1 && errorOccurred == 0) {
-                        if (ReadNodeFromList(listFile, nextPairStart, NULL, &nodeHeader) == 1) {
-                            nextPairStart = nodeHeader.nextOffset;
-                            left2Count++;
-                        } else {
-                            errorOccurred = 1;
-                        }
-                    }
-                    
-                    // Merge the two sublists
-                    if (MergeTwoSortedListsWithLimit(listFile, left1Start, left1Count, left2Start, left2Count,
-                                                     recordSize, compareFunction, &mergedHead, &mergedTail) == 0) {
+                    storedValue[DICTIONARY_VALUE_LENGTH - 1] = '\0';
+                    if (EncodeDictionaryValue(tableId, column, storedValue, &code) == 0 || code != (dictionaryCode)i) {
                         errorOccurred = 1;
                     }
                 }
-                
-                // Append merged pair to result list (avoid traversals - use cached tail)
-                if (errorOccurred == 0 && mergedHead != -1) {
-                    if (mergedListHead == -1) {
-                        // First merged segment
-                        mergedListHead = mergedHead;
-                        mergedListTail = mergedTail;
-                    } else {
-                        // Link previous tail to new head (batched pointer updates)
-                        DoublyLinkedNodeHeader tailHeader, headHeader;
-                        
-                        if (ReadNodeFromList(listFile, mergedListTail, NULL, &tailHeader) == 1 &&
-                            ReadNodeFromList(listFile, mergedHead, NULL, &headHeader) == 1) {
-                            
-                            tailHeader.nextOffset = mergedHead;
-                            headHeader.prevOffset = mergedListTail;
-                            
-                            // Write both updates together
-                            if (WriteNodeToList(listFile, mergedListTail, NULL, &tailHeader) == 1 &&
-                                WriteNodeToList(listFile, mergedHead, NULL, &headHeader) == 1) {
-                                mergedListTail = mergedTail;
-                            } else {
-                                errorOccurred = 1;
-                            }
-                        } else {
-                            errorOccurred = 1;
-                        }
-                    }
-                    numMerges++;
-                }
-                
-                // Move to next pair (no traversal needed - we cached it)
-                currentPos = nextPairStart;
-            }
-            
-            // Update for next iteration (cache head and tail)
-            if (errorOccurred == 0) {
-                currentHead = mergedListHead;
-                currentTail = mergedListTail;
-                sublistSize *= 2;
-                
-                printf("  Completed %ld merges, new sublist size: %ld\n", numMerges, sublistSize);
-                
-                // Safety check: if no merges performed, something is wrong
-                if (numMerges == 0) {
-                    printf("ERROR: No merges performed in iteration %d\n", iteration);
-                    errorOccurred = 1;
-                }
             }
         }
+        if (dictionaryFile != NULL) fclose(dictionaryFile);
         
-        // Check if we exceeded max iterations
-        if (iteration >= maxIterations) {
-            printf("ERROR: Merge sort exceeded maximum iterations\n");
-            errorOccurred = 1;
-        }
-        
-        // Set output (using cached values - no traversal needed)
         if (errorOccurred == 0) {
-            if (sortedHeadOffset != NULL) {
-                *sortedHeadOffset = currentHead;
-            }
-            if (sortedTailOffset != NULL) {
-                *sortedTailOffset = currentTail;
-            }
-            success = 1;
+            returnValue = 1;
+        } else {
+            printf("Error: %s is missing or invalid; construct the database again\n", schema->dictionaryFileName);
+            InvalidateTableDictionary(tableId);
         }
     }
     
-    return success;                                    // Single return point
-}//end function definition MergeSortLinkedListIterative
-
-// ====================== COMPARISON FUNCTIONS ======================
+    return returnValue;                                // Single return point
+}//end function definition LoadTableDictionary
 
 /*
- * Function: CompareDates
- * Purpose: Compares two dateStructure objects for chronological ordering
- * Parameters: date1 - pointer to first date structure
- *            date2 - pointer to second date structure
- * Returns: int - negative if date1 < date2, zero if equal, positive if date1 > date2
- * Note: Used for sorting records by date fields
+ * Function: DecodeDictionaryValue
+ * Purpose: Returns the value of a code of an encoded column
+ * Parameters: tableId - BINARY_TABLE_* id
+ *            column - encoded column (CUSTOMER_DICTIONARY_* or PRODUCT_DICTIONARY_*)
+ *            code - code stored in a record
+ * Returns: const char* - the value, or "" if the code is unknown or the dictionary cannot be loaded
+ * Note: Loads the table's dictionary on first use
  */
-int CompareDates(const dateStructure* date1, const dateStructure* date2) {
-    int result = 0;                                    // Comparison result (single return pattern)
-    
-    // Compare year first
-    result = (int)date1->yearValue - (int)date2->yearValue;
+const char* DecodeDictionaryValue(int tableId, int column, dictionaryCode code) {
+    const char* value = "";                            // Decoded value (single return pattern)
     
-    // If years are equal, compare months
-    if (result == 0) {
-        result = (int)date1->monthOfYear - (int)date2->monthOfYear;
-        
-        // If months are equal, compare days
-        if (result == 0) {
-            result = (int)date1->dayOfMonth - (int)date2->dayOfMonth;
-        }
+    if (LoadTableDictionary(tableId) == 1 && (long)code < tableDictionaries[tableId][column].valueCount) {
+        value = tableDictionaries[tableId][column].values[code];
     }
     
-    return result;                                     // Single return point
-}//end function definition CompareDates
+    return value;
+}//end function definition DecodeDictionaryValue
+
+// ====================== DOUBLY LINKED LIST FILE-BASED OPERATIONS ======================
 
 /*
- * Function: ToLowerCase
- * Purpose: Converts a string to lowercase for case-insensitive comparisons
- * Parameters: dest - destination buffer
- *            src - source string
- *            maxLen - maximum length to copy
- * Returns: void
- * Note: Helper function for flexible searching
+ * Function: CreateLinkedListFromFile
+ * Purpose: Creates a doubly linked list file structure from a binary data file
+ * Parameters: inputFileName - source binary file with records
+ *            linkedListFileName - output file for linked list structure
+ *            recordSize - size of each record in bytes
+ * Returns: long - number of nodes created, -1 on error
+ * Note: Converts flat file to linked list format for efficient sorting
+ *       Single return pattern, no data loaded to RAM
  */
-void ToLowerCase(char* dest, const char* src, size_t maxLen) {
-    size_t i = 0;
-    while (i < maxLen - 1 && src[i] != '\0') {
-        if (src[i] >= 'A' && src[i] <= 'Z') {
-            dest[i] = src[i] + 32;  // Convert to lowercase
-        } else {
-            dest[i] = src[i];
+long CreateLinkedListFromFile(const char* inputFileName, const char* linkedListFileName, size_t recordSize) {
+    FILE* inputFile = NULL;                            // Source data file
+    FILE* listFile = NULL;                             // Linked list file
+    LinkedListFileMetadata metadata;                   // List metadata
+    DoublyLinkedNodeHeader nodeHeader;                 // Current node header
+    void* dataBuffer = NULL;                           // Buffer for record data
+    long currentOffset = 0;                            // Current write position
+    long previousOffset = -1;                          // Previous node offset
+    long nodesCreated = 0;                             // Count of nodes created
+    int errorOccurred = 0;                             // Error flag
+    
+    // Initialize metadata
+    InitializeStructureToZero(&metadata, sizeof(LinkedListFileMetadata));
+    metadata.headOffset = -1;
+    metadata.tailOffset = -1;
+    metadata.nodeCount = 0;
+    metadata.recordSize = recordSize;
+    
+    // Allocate data buffer
+    dataBuffer = malloc(recordSize);
+    if (dataBuffer == NULL) {
+        errorOccurred = 1;
+        nodesCreated = -1;
+    }
+    
+    if (errorOccurred == 0) {
+        // Open input file
+        inputFile = OpenFileWithErrorCheck(inputFileName, "rb");
+        if (inputFile == NULL) {
+            errorOccurred = 1;
+            nodesCreated = -1;
         }
-        i++;
     }
-    dest[i] = '\0';
-}
-
-/*
- * Function: CompareProductNameOnly
- * Purpose: Compares two product records by product name only (for flexible searching)
- * Parameters: record1 - pointer to first product-customer combined record
- *            record2 - pointer to second product-customer combined record
- * Returns: int - comparison result for ProductName only
- * Note: Used for partial searches in Report 2
- */
-int CompareProductNameOnly(const void* record1, const void* record2) {
-    const productCustomerRecord* pc1 = (const productCustomerRecord*)record1;
-    const productCustomerRecord* pc2 = (const productCustomerRecord*)record2;
-    return strcmp(pc1->product.productName, pc2->product.productName);
-}
-
-/*
- * Function: CompareCustomerNameOnly
- * Purpose: Compares two sales records by customer name only (for flexible searching)
- * Parameters: record1 - pointer to first sales-customer combined record
- *            record2 - pointer to second sales-customer combined record
- * Returns: int - comparison result for Customer Name only
- * Note: Used for partial searches in Report 5
- */
-int CompareCustomerNameOnly(const void* record1, const void* record2) {
-    const salesCustomerRecord* sc1 = (const salesCustomerRecord*)record1;
-    const salesCustomerRecord* sc2 = (const salesCustomerRecord*)record2;
-    return strcmp(sc1->customer.name, sc2->customer.name);
-}
-
-/*
- * Function: CompareProductsForReport2
- * Purpose: Compares two product records for Option 2 report sorting
- * Parameters: record1 - pointer to first product-customer combined record
- *            record2 - pointer to second product-customer combined record
- * Returns: int - comparison result for ProductName + Continent + Country + State + City
- * Note: Used for "What types of products does the company sell, and where are customers located?"
- */
-int CompareProductsForReport2(const void* record1, const void* record2) {
-    const productCustomerRecord* pc1 = (const productCustomerRecord*)record1;  // First combined record
-    const productCustomerRecord* pc2 = (const productCustomerRecord*)record2;  // Second combined record
-    int comparisonResult = 0;                          // Result of string comparison (single return pattern)
     
-    // Compare by Product Name first
-    comparisonResult = strcmp(pc1->product.productName, pc2->product.productName);
+    if (errorOccurred == 0) {
+        // Create linked list file
+        listFile = OpenFileWithErrorCheck(linkedListFileName, "wb+");
+        if (listFile == NULL) {
+            errorOccurred = 1;
+            nodesCreated = -1;
+        }
+    }
     
-    // If Product Names are equal, compare by Continent
-    if (comparisonResult == 0) {
-        comparisonResult = strcmp(pc1->customer.continent, pc2->customer.continent);
+    if (errorOccurred == 0) {
+        // Reserve space for metadata at beginning
+        currentOffset = sizeof(LinkedListFileMetadata);
+        CountedSeek(listFile, currentOffset, SEEK_SET);
         
-        // If Continents are equal, compare by Country
-        if (comparisonResult == 0) {
-            comparisonResult = strcmp(pc1->customer.country, pc2->customer.country);
+        // Read records and create nodes
+        while (CountedRead(dataBuffer, recordSize, 1, inputFile) == 1 && errorOccurred == 0) {
+            // Set first node as head
+            if (metadata.nodeCount == 0) {
+                metadata.headOffset = currentOffset;
+            }
             
-            // If Countries are equal, compare by State
-            if (comparisonResult == 0) {
-                comparisonResult = strcmp(pc1->customer.state, pc2->customer.state);
-                
-                // If States are equal, compare by City
-                if (comparisonResult == 0) {
-                    comparisonResult = strcmp(pc1->customer.city, pc2->customer.city);
+            // Initialize node header
+            nodeHeader.prevOffset = previousOffset;
+            nodeHeader.nextOffset = -1;               // Will update previous node's next
+            nodeHeader.dataSize = recordSize;
+            
+            // Write node header
+            if (CountedWrite(&nodeHeader, sizeof(DoublyLinkedNodeHeader), 1, listFile) != 1) {
+                errorOccurred = 1;
+                nodesCreated = -1;
+            }
+            
+            // Write node data
+            if (errorOccurred == 0) {
+                if (CountedWrite(dataBuffer, recordSize, 1, listFile) != 1) {
+                    errorOccurred = 1;
+                    nodesCreated = -1;
                 }
             }
+            
+            // Update previous node's nextOffset
+            if (errorOccurred == 0 && previousOffset != -1) {
+                long tempOffset = ftell(listFile);     // Save current position
+                CountedSeek(listFile, previousOffset + sizeof(long), SEEK_SET); // Seek to prevNode.nextOffset
+                CountedWrite(&currentOffset, sizeof(long), 1, listFile);
+                CountedSeek(listFile, tempOffset, SEEK_SET); // Restore position
+            }
+            
+            // Update for next iteration
+            if (errorOccurred == 0) {
+                metadata.tailOffset = currentOffset;
+                previousOffset = currentOffset;
+                currentOffset = ftell(listFile);
+                metadata.nodeCount++;
+            }
+        }
+        
+        // Write metadata at beginning of file
+        if (errorOccurred == 0) {
+            CountedSeek(listFile, 0, SEEK_SET);
+            CountedWrite(&metadata, sizeof(LinkedListFileMetadata), 1, listFile);
+            nodesCreated = metadata.nodeCount;
         }
     }
     
-    return comparisonResult;                           // Single return point
-}//end function definition CompareProductsForReport2
+    // Cleanup
+    if (dataBuffer != NULL) {
+        free(dataBuffer);
+    }
+    if (inputFile != NULL) {
+        fclose(inputFile);
+    }
+    if (listFile != NULL) {
+        fclose(listFile);
+    }
+    
+    return nodesCreated;                               // Single return point
+}//end function definition CreateLinkedListFromFile
 
 /*
- * Function: CompareSalesForReport5
- * Purpose: Compares two sales records for Option 5 report sorting
- * Parameters: record1 - pointer to first sales-customer combined record
- *            record2 - pointer to second sales-customer combined record
- * Returns: int - comparison result for Customer Name + Order Date + ProductKey
- * Note: Used for "List of sales order by Customer Name + Order Date + ProductKey"
+ * Function: ReadNodeFromList
+ * Purpose: Reads a node's data from linked list file without loading entire list
+ * Parameters: listFile - open linked list file pointer
+ *            nodeOffset - file offset to the node
+ *            dataBuffer - buffer to store node data (must be pre-allocated)
+ *            nodeHeader - pointer to store node header info
+ * Returns: int - 1 on success, 0 on failure
+ * Note: Single return pattern, reads only one node at a time
  */
-int CompareSalesForReport5(const void* record1, const void* record2) {
-    const salesCustomerRecord* sc1 = (const salesCustomerRecord*)record1;     // First combined record
-    const salesCustomerRecord* sc2 = (const salesCustomerRecord*)record2;     // Second combined record
-    int comparisonResult = 0;                          // Result of comparison (single return pattern)
-    
-    // Compare by Customer Name first
-    comparisonResult = strcmp(sc1->customer.name, sc2->customer.name);
+int ReadNodeFromList(FILE* listFile, long nodeOffset, void* dataBuffer, DoublyLinkedNodeHeader* nodeHeader) {
+    int success = 0;                                   // Success flag (single return pattern)
+    size_t readCount = 0;                              // Read operation count
     
-    // If Customer Names are equal, compare by Order Date
-    if (comparisonResult == 0) {
-        comparisonResult = CompareDates(&sc1->sale.orderDate, &sc2->sale.orderDate);
-        
-        // If Order Dates are equal, compare by ProductKey
-        if (comparisonResult == 0) {
-            comparisonResult = (int)sc1->sale.productKey - (int)sc2->sale.productKey;
+    if (listFile != NULL && nodeOffset >= 0 && nodeHeader != NULL) {
+        // Seek to node position
+        if (CountedSeek(listFile, nodeOffset, SEEK_SET) == 0) {
+            // Read node header
+            readCount = CountedRead(nodeHeader, sizeof(DoublyLinkedNodeHeader), 1, listFile);
+            if (readCount == 1) {
+                // Only read data if dataBuffer is provided
+                if (dataBuffer != NULL) {
+                    readCount = CountedRead(dataBuffer, nodeHeader->dataSize, 1, listFile);
+                    success = (readCount == 1) ? 1 : 0;
+                } else {
+                    // Header-only read is valid (skip data portion)
+                    success = 1;
+                }
+            }
         }
     }
     
-    return comparisonResult;                           // Single return point
-}//end function definition CompareSalesForReport5
+    return success;                                    // Single return point
+}//end function definition ReadNodeFromList
 
 /*
- * Function: CompareSalesForSeasonalAnalysis
- * Purpose: Compares two sales records for seasonal pattern analysis (Option 3)
- * Parameters: record1 - pointer to first sales record
- *            record2 - pointer to second sales record
- * Returns: int - comparison result for Order Date (chronological order)
- * Note: Used for "Are there any seasonal patterns or trends for order volume or revenue?"
+ * Function: WriteNodeToList
+ * Purpose: Writes/updates a node's data in linked list file
+ * Parameters: listFile - open linked list file pointer
+ *            nodeOffset - file offset where to write the node
+ *            dataBuffer - data to write
+ *            nodeHeader - node header information
+ * Returns: int - 1 on success, 0 on failure
+ * Note: Single return pattern, updates only specified node
  */
-int CompareSalesForSeasonalAnalysis(const void* record1, const void* record2) {
-    const salesRecord* sale1 = (const salesRecord*)record1;                   // First sales record
-    const salesRecord* sale2 = (const salesRecord*)record2;                   // Second sales record
+int WriteNodeToList(FILE* listFile, long nodeOffset, const void* dataBuffer, const DoublyLinkedNodeHeader* nodeHeader) {
+    int success = 0;                                   // Success flag (single return pattern)
+    size_t writeCount = 0;                             // Write operation count
     
-    // Compare by Order Date for chronological analysis
-    return CompareDates(&sale1->orderDate, &sale2->orderDate);
-}//end function definition CompareSalesForSeasonalAnalysis
-
-/*
- * Function: CompareSalesForDeliveryAnalysis
- * Purpose: Compares two sales records for delivery time analysis (Option 4)
- * Parameters: record1 - pointer to first sales record
- *            record2 - pointer to second sales record
- * Returns: int - comparison result for Order Date (chronological order)
- * Note: Used for "How long is the average delivery time in days? Has that changed over time?"
- */
-int CompareSalesForDeliveryAnalysis(const void* record1, const void* record2) {
-    const salesRecord* sale1 = (const salesRecord*)record1;                   // First sales record
-    const salesRecord* sale2 = (const salesRecord*)record2;                   // Second sales record
+    if (listFile != NULL && nodeOffset >= 0 && nodeHeader != NULL) {
+        // Seek to node position
+        if (CountedSeek(listFile, nodeOffset, SEEK_SET) == 0) {
+            // Write node header
+            writeCount = CountedWrite(nodeHeader, sizeof(DoublyLinkedNodeHeader), 1, listFile);
+            if (writeCount == 1) {
+                // Only write data if dataBuffer is provided
+                if (dataBuffer != NULL) {
+                    writeCount = CountedWrite(dataBuffer, nodeHeader->dataSize, 1, listFile);
+                    success = (writeCount == 1) ? 1 : 0;
+                } else {
+                    // Header-only update is valid
+                    success = 1;
+                }
+            }
+        }
+    }
     
-    // Compare by Order Date for delivery time analysis over time
-    return CompareDates(&sale1->orderDate, &sale2->orderDate);
-}//end function definition CompareSalesForDeliveryAnalysis
+    return success;                                    // Single return point
+}//end function definition WriteNodeToList
 
 /*
- * Function: CompareMonthlySalesData
- * Purpose: Compares two monthlySalesData records for chronological sorting
- * Parameters: record1 - pointer to first monthlySalesData
- *            record2 - pointer to second monthlySalesData
- * Returns: int - comparison result for Year + Month
- * Note: Used for sorting monthly aggregated data chronologically
+ * Function: SwapAdjacentNodesInList
+ * Purpose: Swaps data between two adjacent nodes in the linked list
+ * Parameters: listFile - open linked list file pointer
+ *            node1Offset - offset to first node
+ *            node2Offset - offset to second node (must be node1's next)
+ *            recordSize - size of record data
+ * Returns: int - 1 on success, 0 on failure
+ * Note: Swaps ONLY the data payloads, not the node headers (prev/next pointers remain unchanged)
+ *       This is the correct and efficient approach for bubble sort in a doubly-linked list
+ *       O(1) complexity for the swap operation itself
+ *       Complies with file-based operations - no full data loading to RAM
  */
-int CompareMonthlySalesData(const void* record1, const void* record2) {
-    const monthlySalesData* data1 = (const monthlySalesData*)record1;
-    const monthlySalesData* data2 = (const monthlySalesData*)record2;
-    int result = 0;
+int SwapAdjacentNodesInList(FILE* listFile, long node1Offset, long node2Offset, size_t recordSize) {
+    DoublyLinkedNodeHeader node1Header;                // First node header
+    DoublyLinkedNodeHeader node2Header;                // Second node header
+    void* data1 = NULL;                                // First node data
+    void* data2 = NULL;                                // Second node data
+    int success = 0;                                   // Success flag (single return pattern)
+    int allocationSuccess = 0;                         // Memory allocation flag
+    int readSuccess = 0;                               // Read operations flag
     
-    // Compare by year first
-    result = (int)data1->year - (int)data2->year;
+    // Allocate buffers for data
+    data1 = malloc(recordSize);
+    data2 = malloc(recordSize);
     
-    // If years equal, compare by month
-    if (result == 0) {
-        result = (int)data1->month - (int)data2->month;
+    if (data1 != NULL && data2 != NULL) {
+        allocationSuccess = 1;
     }
     
-    return result;
-}//end function definition CompareMonthlySalesData
-
-/*
- * Function: CompareStoresByCountry
- * Purpose: Compares two store records by country name for sorting
- * Parameters: record1 - pointer to first store record
- *            record2 - pointer to second store record
- * Returns: int - comparison result for country names
- * Note: Used for sorting stores alphabetically by country
- */
-int CompareStoresByCountry(const void* record1, const void* record2) {
-    const storeRecord* store1 = (const storeRecord*)record1;       // First store record
-    const storeRecord* store2 = (const storeRecord*)record2;       // Second store record
+    if (allocationSuccess == 1) {
+        // Read both nodes
+        readSuccess = ReadNodeFromList(listFile, node1Offset, data1, &node1Header);
+        if (readSuccess == 1) {
+            readSuccess = ReadNodeFromList(listFile, node2Offset, data2, &node2Header);
+        }
+    }
     
-    // Compare by country name
-    return strcmp(store1->country, store2->country);
-}//end function definition CompareStoresByCountry
-
-/*
- * Function: CompareSalesByProductKey
- * Purpose: Comparison function for sorting/searching sales by productKey
- * Parameters: record1 - pointer to first sales record (or search key)
- *            record2 - pointer to second sales record
- * Returns: int - negative if key1 < key2, 0 if equal, positive if key1 > key2
- * Note: Used for binary search on sorted sales data by productKey
- */
-int CompareSalesByProductKey(const void* record1, const void* record2) {
-    const salesRecord* sale1 = (const salesRecord*)record1;       // First sales record
-    const salesRecord* sale2 = (const salesRecord*)record2;       // Second sales record
+    if (allocationSuccess == 1 && readSuccess == 1) {
+        // SOLUCIÓN: Solo intercambiar los DATOS, mantener headers intactos
+        // Esto es más simple y correcto para bubble sort
+        // Los punteros prev/next permanecen sin cambios
+        if (WriteNodeToList(listFile, node1Offset, data2, &node1Header) == 1) {
+            if (WriteNodeToList(listFile, node2Offset, data1, &node2Header) == 1) {
+                success = 1;
+            }
+        }
+    }
     
-    if (sale1->productKey < sale2->productKey) {
-        return -1;
-    } else if (sale1->productKey > sale2->productKey) {
-        return 1;
-    } else {
-        return 0;
+    // Cleanup
+    if (data1 != NULL) {
+        free(data1);
+    }
+    if (data2 != NULL) {
+        free(data2);
     }
-}//end function definition CompareSalesByProductKey
-
-// ====================== CURRENCY CONVERSION ======================
-
-/*
- * Function: ConvertDateToExchangeRateFormat
- * Purpose: Converts dateStructure to exchange rate date format for matching
- * Parameters: inputDate - pointer to dateStructure to convert
- *            outputDateString - buffer to store formatted date string
- * Returns: void
- * Note: Converts from dateStructure to DD/MM/YYYY format used in exchange rates
- */
-void ConvertDateToExchangeRateFormat(const dateStructure* inputDate, char* outputDateString) {
-    sprintf(outputDateString, "%02d/%02d/%04d", 
-            inputDate->dayOfMonth, 
-            inputDate->monthOfYear, 
-            inputDate->yearValue);
-}//end function definition ConvertDateToExchangeRateFormat
-
-// ====================== EXCHANGE RATE CACHE ======================
-// Cache structure to avoid repeated file reads for currency conversion
-typedef struct {
-    char currency[4];                                  // Currency code (e.g., "EUR")
-    dateStructure date;                                // Transaction date
-    double rate;                                       // Exchange rate to USD
-} ExchangeRateCache;
-
-static ExchangeRateCache exchangeRateCache[1000];     // Cache array for exchange rates
-static int cacheSize = 0;                             // Number of entries in cache
-
-/*
- * Function: CalculateDateDifference
- * Purpose: Calculates the absolute difference in days between two dates
- * Parameters: date1 - pointer to first dateStructure
- *            date2 - pointer to second dateStructure
- * Returns: int - absolute difference in days (simplified calculation)
- * Note: Simplified calculation for finding closest exchange rate date
- */
-int CalculateDateDifference(const dateStructure* date1, const dateStructure* date2) {
-    // Improved date difference calculation
-    // Converts each date to approximate days since a baseline, then calculates difference
-    // This is more accurate than the previous method
-    int days1 = date1->yearValue * 365 + date1->monthOfYear * 30 + date1->dayOfMonth;
-    int days2 = date2->yearValue * 365 + date2->monthOfYear * 30 + date2->dayOfMonth;
     
-    return abs(days1 - days2);
-}//end function definition CalculateDateDifference
+    return success;                                    // Single return point
+}//end function definition SwapAdjacentNodesInList
 
 /*
- * Function: ParseExchangeRateDate
- * Purpose: Parses exchange rate date string (DD/MM/YYYY) to dateStructure
- * Parameters: dateString - date string from exchange rate record
- *            parsedDate - pointer to dateStructure to store result
- * Returns: int - 1 if successful, 0 if parsing failed
- * Note: Handles the specific DD/MM/YYYY format used in exchange rates table
- *       Validates days per month including leap years
+ * Function: ConvertLinkedListToFile
+ * Purpose: Extracts sorted data from linked list file to regular binary file
+ * Parameters: linkedListFileName - source linked list file
+ *            outputFileName - destination binary file
+ * Returns: long - number of records written, -1 on error
+ * Note: Traverses list in order and writes data sequentially
+ *       Single return pattern, file-based traversal
  */
-int ParseExchangeRateDate(const char* dateString, dateStructure* parsedDate) {
-    int day = 0, month = 0, year = 0;                  // Parsed date components
-    int isValid = 0;                                   // Validation flag (single return pattern)
-    int daysInMonth = 0;                               // Days in the parsed month
-    int isLeapYear = 0;                                // Leap year flag
-    int parseSuccess = 0;                              // sscanf result
+long ConvertLinkedListToFile(const char* linkedListFileName, const char* outputFileName) {
+    FILE* listFile = NULL;                             // Linked list file
+    FILE* outputFile = NULL;                           // Output binary file
+    LinkedListFileMetadata metadata;                   // List metadata
+    DoublyLinkedNodeHeader nodeHeader;                 // Current node header
+    void* dataBuffer = NULL;                           // Data buffer
+    long currentOffset = 0;                            // Current node offset
+    long recordsWritten = 0;                           // Count of records written
+    int errorOccurred = 0;                             // Error flag
     
-    // Initialize structure to zero
-    parsedDate->dayOfMonth = 0;
-    parsedDate->monthOfYear = 0;
-    parsedDate->yearValue = 0;
+    // Open linked list file
+    listFile = OpenFileWithErrorCheck(linkedListFileName, "rb");
+    if (listFile == NULL) {
+        errorOccurred = 1;
+        recordsWritten = -1;
+    }
     
-    // Parse DD/MM/YYYY format
-    parseSuccess = sscanf(dateString, "%d/%d/%d", &day, &month, &year);
+    if (errorOccurred == 0) {
+        // Read metadata
+        if (CountedRead(&metadata, sizeof(LinkedListFileMetadata), 1, listFile) != 1) {
+            errorOccurred = 1;
+            recordsWritten = -1;
+        }
+    }
     
-    // Validate parsing success
-    if (parseSuccess == 3) {
-        // Validate basic ranges
-        if (day >= 1 && month >= 1 && month <= 12 && year >= 1900 && year <= 2100) {
-            // Calculate if leap year
-            isLeapYear = ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
-            
-            // Determine days in month
-            if (month == 2) {
-                daysInMonth = isLeapYear ? 29 : 28;    // February
-            } else if (month == 4 || month == 6 || month == 9 || month == 11) {
-                daysInMonth = 30;                      // April, June, September, November
+    if (errorOccurred == 0) {
+        // Allocate data buffer
+        dataBuffer = malloc(metadata.recordSize);
+        if (dataBuffer == NULL) {
+            errorOccurred = 1;
+            recordsWritten = -1;
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        // Open output file
+        outputFile = OpenFileWithErrorCheck(outputFileName, "wb");
+        if (outputFile == NULL) {
+            errorOccurred = 1;
+            recordsWritten = -1;
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        // Traverse list from head to tail
+        currentOffset = metadata.headOffset;
+        long maxNodes = metadata.nodeCount;            // Maximum expected nodes
+        long nodesProcessed = 0;                       // Nodes actually processed
+        
+        while (currentOffset != -1 && errorOccurred == 0 && nodesProcessed < maxNodes) {
+            // Read node
+            if (ReadNodeFromList(listFile, currentOffset, dataBuffer, &nodeHeader) == 1) {
+                // Write data to output file
+                if (CountedWrite(dataBuffer, metadata.recordSize, 1, outputFile) == 1) {
+                    recordsWritten++;
+                    currentOffset = nodeHeader.nextOffset; // Move to next node
+                    nodesProcessed++;
+                } else {
+                    errorOccurred = 1;
+                    recordsWritten = -1;
+                }
             } else {
-                daysInMonth = 31;                      // January, March, May, July, August, October, December
-            }
-            
-            // Validate day is within month's range
-            if (day <= daysInMonth) {
-                // All validations passed - store values
-                parsedDate->dayOfMonth = (unsigned char)day;
-                parsedDate->monthOfYear = (unsigned char)month;
-                parsedDate->yearValue = (unsigned short)year;
-                isValid = 1;                           // Mark as valid
+                errorOccurred = 1;
+                recordsWritten = -1;
             }
         }
+        
+        // Verify we processed the expected count
+        if (errorOccurred == 0 && recordsWritten != metadata.nodeCount) {
+            printf("Warning: Expected %ld records but wrote %ld\n", metadata.nodeCount, recordsWritten);
+        }
     }
     
-    return isValid;                                    // Single return point
-}//end function definition ParseExchangeRateDate
+    // Cleanup
+    if (dataBuffer != NULL) {
+        free(dataBuffer);
+    }
+    if (listFile != NULL) {
+        fclose(listFile);
+    }
+    if (outputFile != NULL) {
+        fclose(outputFile);
+    }
+    
+    return recordsWritten;                             // Single return point
+}//end function definition ConvertLinkedListToFile
+
+// ====================== EXTERNAL MERGE SORT OPERATIONS ======================
+#define SORT_MEMORY_BUDGET_DEFAULT (64UL * 1024UL * 1024UL)  // Default bytes for run generation
+#define SORT_MEMORY_BUDGET_MINIMUM (64UL * 1024UL)           // Smallest accepted budget
+#define SORT_MEMORY_BUDGET_MAXIMUM_KB 4194304                // Largest budget accepted from the user (4 GB)
+#define SORT_MAX_MERGE_FAN_IN 128                            // Max runs merged at once (open files)
+
+static size_t sortMemoryBudget = SORT_MEMORY_BUDGET_DEFAULT; // Memory budget used by SortMerge
 
 /*
- * Function: ConvertCurrencyToUSD
- * Purpose: Converts amount from specified currency to USD using exchange rates table
- * Parameters: amount - amount to convert
- *            currencyCode - 3-character currency code (e.g., "EUR", "GBP")
- *            transactionDate - date of the transaction for rate lookup
- * Returns: double - converted amount in USD rounded to 3 decimals, -1.0 if conversion failed
- * Note: Finds closest exchange rate by date if exact match not available
- *       Applies 5/4 rounding rule to third decimal place
+ * Function: SetSortMemoryBudget
+ * Purpose: Sets the memory budget SortMerge may use for in-memory run generation
+ * Parameters: budgetBytes - budget in bytes (values below SORT_MEMORY_BUDGET_MINIMUM are raised to it)
+ * Returns: void
+ * Note: A larger budget produces fewer, longer runs. Set by --sort-memory and menu option 6.
  */
-double ConvertCurrencyToUSD(double amount, const char* currencyCode, const dateStructure* transactionDate) {
-    FILE* exchangeRateFile = NULL;                     // Exchange rates file pointer
-    exchangeRateRecord currentRate;                    // Current exchange rate record
-    dateStructure currentRateDate;                     // Parsed date from current rate
-    dateStructure closestRateDate;                     // Date of closest rate found
-    double closestExchangeRate = -1.0;                 // Closest exchange rate value
-    int currentDateDifference = 0;                     // Difference between current and transaction date
-    int closestDateDifference = INT_MAX;               // Smallest date difference found
-    int ratesFound = 0;                                // Number of rates found for currency
-    char targetDateString[20] = {0};                   // Target date as string for debugging
-    double convertedAmount = -1.0;                     // Final converted amount (single return pattern)
-    int exactMatchFound = 0;                           // Flag for exact date match
-    int fileOpenSuccess = 0;                           // Flag for file open success
-    int cacheHit = 0;                                  // Flag for cache hit
-    int i = 0;                                         // Loop counter
-    
-    // Initialize closest rate date to zero
-    InitializeStructureToZero(&closestRateDate, sizeof(dateStructure));
-    
-    // If currency is already USD, return original amount rounded
-    if (strcmp(currencyCode, "USD") == 0) {
-        convertedAmount = RoundToThirdDecimal(amount);
-    } else {
-        // Check cache first
-        for (i = 0; i < cacheSize && cacheHit == 0; i++) {
-            if (strcmp(exchangeRateCache[i].currency, currencyCode) == 0 &&
-                CompareDates(&exchangeRateCache[i].date, transactionDate) == 0) {
-                // Cache hit!
-                convertedAmount = RoundToThirdDecimal(amount * exchangeRateCache[i].rate);
-                cacheHit = 1;
-            }
-        }
-        
-        // If not in cache, search file
-        if (cacheHit == 0) {
-            // Open exchange rates file
-            exchangeRateFile = OpenFileWithErrorCheck("ExchangeRatesTable.dat", "rb");
-            fileOpenSuccess = (exchangeRateFile != NULL) ? 1 : 0;
+void SetSortMemoryBudget(size_t budgetBytes) {
+    if (budgetBytes < SORT_MEMORY_BUDGET_MINIMUM) {
+        budgetBytes = SORT_MEMORY_BUDGET_MINIMUM;
+    }
+    sortMemoryBudget = budgetBytes;
+}//end function definition SetSortMemoryBudget
+
+/*
+ * Function: GetSortMemoryBudget
+ * Purpose: Returns the memory budget currently used by SortMerge
+ * Parameters: None
+ * Returns: size_t - budget in bytes
+ */
+size_t GetSortMemoryBudget(void) {
+    return sortMemoryBudget;
+}//end function definition GetSortMemoryBudget
+
+/*
+ * Function: SortRecordPointers
+ * Purpose: Stable in-memory merge sort of an array of record pointers
+ * Parameters: order - pointers to sort; holds the sorted order on return
+ *            scratch - work array with room for count pointers
+ *            count - number of pointers
+ *            compareFunction - comparison function for the pointed-to records
+ * Returns: void
+ * Note: Bottom-up, so no recursion; records themselves are never moved
+ */
+void SortRecordPointers(const unsigned char** order, const unsigned char** scratch, long count,
+                        int (*compareFunction)(const void*, const void*)) {
+    const unsigned char** source = order;              // Sorted sublists of current width
+    const unsigned char** target = scratch;            // Merged sublists of double width
+    const unsigned char** swapTemp = NULL;             // Temporary for swapping arrays
+    long width = 1;                                    // Current sublist width
+    long leftIndex = 0;                                // Read position in left sublist
+    long rightIndex = 0;                               // Read position in right sublist
+    long leftEnd = 0;                                  // End of left sublist
+    long rightEnd = 0;                                 // End of right sublist
+    long outIndex = 0;                                 // Write position in target
+    long long comparisons = 0;                         // Comparator invocations
+    
+    for (width = 1; width < count; width *= 2) {
+        for (long blockStart = 0; blockStart < count; blockStart += 2 * width) {
+            leftIndex = blockStart;
+            leftEnd = (blockStart + width < count) ? blockStart + width : count;
+            rightIndex = leftEnd;
+            rightEnd = (blockStart + 2 * width < count) ? blockStart + 2 * width : count;
+            outIndex = blockStart;
             
-            if (fileOpenSuccess == 1) {
-                // Convert transaction date to string for debugging
-                ConvertDateToExchangeRateFormat(transactionDate, targetDateString);
-                
-                // Search through all exchange rate records
-                while (fread(&currentRate, sizeof(exchangeRateRecord), 1, exchangeRateFile) == 1 && exactMatchFound == 0) {
-                    // Check if currency matches
-                    if (strcmp(currentRate.currency, currencyCode) == 0) {
-                        ratesFound++;
-                        
-                        // Parse the date from exchange rate record
-                        if (ParseExchangeRateDate(currentRate.date, &currentRateDate) == 1) {
-                            // Calculate date difference
-                            currentDateDifference = CalculateDateDifference(transactionDate, &currentRateDate);
-                            
-                            // If this is the closest date so far, save it
-                            if (currentDateDifference < closestDateDifference) {
-                                closestDateDifference = currentDateDifference;
-                                closestExchangeRate = currentRate.exchange;
-                                closestRateDate = currentRateDate;
-                                
-                                // If exact match found, set flag to exit loop
-                                if (currentDateDifference == 0) {
-                                    exactMatchFound = 1;
-                                }
-                            }
-                        }
-                    }
-                }
-                
-                fclose(exchangeRateFile);
-                
-                // Check if we found any exchange rates for this currency
-                if (ratesFound == 0) {
-                    printf("Warning: No exchange rates found for currency %s\n", currencyCode);
-                    convertedAmount = -1.0;
-                } else if (closestExchangeRate <= 0.0) {
-                    // Check if we found a valid closest rate
-                    printf("Warning: Invalid exchange rate found for currency %s\n", currencyCode);
-                    convertedAmount = -1.0;
+            // Take from the left on ties to keep the sort stable
+            while (leftIndex < leftEnd && rightIndex < rightEnd) {
+                comparisons++;
+                if (compareFunction(source[rightIndex], source[leftIndex]) < 0) {
+                    target[outIndex++] = source[rightIndex++];
                 } else {
-                    // Perform the conversion and apply 5/4 rounding
-                    convertedAmount = RoundToThirdDecimal(amount * closestExchangeRate);
-                    
-                    // Add to cache if there's space
-                    if (cacheSize < 1000) {
-                        strncpy(exchangeRateCache[cacheSize].currency, currencyCode, 3);
-                        exchangeRateCache[cacheSize].currency[3] = '\0';
-                        exchangeRateCache[cacheSize].date = *transactionDate;
-                        exchangeRateCache[cacheSize].rate = closestExchangeRate;
-                        cacheSize++;
-                    }
+                    target[outIndex++] = source[leftIndex++];
                 }
-            } else {
-                printf("Error: Cannot open exchange rates file for currency conversion\n");
-                convertedAmount = -1.0;
+            }
+            while (leftIndex < leftEnd) {
+                target[outIndex++] = source[leftIndex++];
+            }
+            while (rightIndex < rightEnd) {
+                target[outIndex++] = source[rightIndex++];
             }
         }
+        swapTemp = source;
+        source = target;
+        target = swapTemp;
     }
     
-    return convertedAmount;                            // Single return point
-}//end function definition ConvertCurrencyToUSD
+    // Make sure the result ends up in order[]
+    if (source != order) {
+        memcpy(order, source, (size_t)count * sizeof(const unsigned char*));
+    }
+    CountComparisons(comparisons);
+}//end function definition SortRecordPointers
 
 /*
- * Function: AggregateSalesByMonth
- * Purpose: Aggregates sales data by month from SalesTable using file-based processing
- * Parameters: outputFileName - name of file to store monthly aggregated data
- * Returns: int - number of months processed, -1 on error
- * Note: Processes sales file line-by-line without loading all data into memory
- *       Calculates order counts and revenue per month
- *       Uses temporary file for aggregation to comply with memory restrictions
+ * Function: CreateSortedRuns
+ * Purpose: Phase 1 of the external sort - splits the input into sorted runs
+ * Parameters: inputFileName - binary file with unsorted records
+ *            runFileName - file receiving all runs back to back
+ *            recordSize - size of each record in bytes
+ *            compareFunction - comparison function for sorting
+ *            runSorter - in-memory sort applied to each run (e.g. SortRecordPointers)
+ *            runs - receives a malloc'd array describing each run (caller frees)
+ *            runCount - receives the number of runs
+ * Returns: long - number of records read, -1 on error
+ * Note: Each run is as many records as fit in the sort memory budget. The input is
+ *       read sequentially, each run is sorted in RAM and written sequentially.
+ *       runSorter must be stable for the whole sort to be stable.
  */
-int AggregateSalesByMonth(const char* outputFileName) {
-    FILE* salesFile = NULL;                            // Sales table file
-    FILE* productsFile = NULL;                         // Products table file
-    FILE* monthlyFile = NULL;                          // Monthly aggregated data file
-    salesRecord currentSale;                           // Current sales record
-    productRecord currentProduct;                      // Current product record
-    monthlySalesData monthlyData[100];                 // Array for monthly data (max 100 months)
-    int monthCount = 0;                                // Number of unique months
-    int recordsProcessed = 0;                          // Records processed counter
+long CreateSortedRuns(const char* inputFileName, const char* runFileName, size_t recordSize,
+                      int (*compareFunction)(const void*, const void*),
+                      void (*runSorter)(const unsigned char**, const unsigned char**, long,
+                                        int (*)(const void*, const void*)),
+                      sortRunDescriptor** runs, long* runCount) {
+    FILE* inputFile = NULL;                            // Unsorted input
+    FILE* runFile = NULL;                              // Output runs
+    unsigned char* runRecords = NULL;                  // Records of the current run
+    const unsigned char** order = NULL;                // Sorted order of current run
+    const unsigned char** scratch = NULL;              // Work array for SortRecordPointers
+    sortRunDescriptor* runArray = NULL;                // Run descriptors
+    sortRunDescriptor* grownArray = NULL;              // Result of growing runArray
+    long runCapacity = 0;                              // Records per run
+    long runArraySize = 0;                             // Allocated run descriptors
+    long recordsInRun = 0;                             // Records read into current run
+    long totalRecords = 0;                             // Records read so far
+    int continueReading = 1;                           // Loop control flag
     int errorOccurred = 0;                             // Error flag
-    int returnValue = -1;                              // Return value
-    int productFound = 0;                              // Product found flag
-    double lineRevenue = 0.0;                          // Revenue for current line
+    long returnValue = -1;                             // Return value (single return pattern)
     
-    // Initialize monthly data array
-    for (int i = 0; i < 100; i++) {
-        InitializeStructureToZero(&monthlyData[i], sizeof(monthlySalesData));
+    *runs = NULL;
+    *runCount = 0;
+    
+    // Each record costs its bytes plus two pointers in the sort arrays
+    runCapacity = (long)(sortMemoryBudget / (recordSize + 2 * sizeof(const unsigned char*)));
+    if (runCapacity < 2) {
+        runCapacity = 2;
     }
     
-    // Open sales file
-    salesFile = OpenFileWithErrorCheck("SalesTable.dat", "rb");
-    if (salesFile == NULL) {
-        printf("Error: Cannot open SalesTable.dat\n");
+    inputFile = OpenFileWithErrorCheck(inputFileName, "rb");
+    runFile = OpenFileWithErrorCheck(runFileName, "wb");
+    runRecords = (unsigned char*)malloc((size_t)runCapacity * recordSize);
+    order = (const unsigned char**)malloc((size_t)runCapacity * sizeof(const unsigned char*));
+    scratch = (const unsigned char**)malloc((size_t)runCapacity * sizeof(const unsigned char*));
+    if (inputFile == NULL || runFile == NULL || runRecords == NULL || order == NULL || scratch == NULL) {
+        printf("Error: Cannot prepare sorted runs for %s\n", inputFileName);
         errorOccurred = 1;
-        returnValue = -1;
     }
     
-    // Open products file for price lookup
-    if (errorOccurred == 0) {
-        productsFile = OpenFileWithErrorCheck("ProductsTable.dat", "rb");
-        if (productsFile == NULL) {
-            printf("Error: Cannot open ProductsTable.dat\n");
-            errorOccurred = 1;
-            returnValue = -1;
+    while (errorOccurred == 0 && continueReading == 1) {
+        // Fill the buffer with the next block of records
+        recordsInRun = (long)CountedRead(runRecords, recordSize, (size_t)runCapacity, inputFile);
+        if (recordsInRun < runCapacity) {
+            continueReading = 0;
         }
-    }
-    
-    if (errorOccurred == 0) {
-        printf("Aggregating sales data by month...\n");
         
-        // Process each sales record
-        while (fread(&currentSale, sizeof(salesRecord), 1, salesFile) == 1 && errorOccurred == 0) {
-            recordsProcessed++;
-            
-            // Find the month index in our array
-            int monthIndex = -1;
-            int foundMonth = 0;
-            
-            for (int i = 0; i < monthCount && foundMonth == 0; i++) {
-                if (monthlyData[i].year == currentSale.orderDate.yearValue &&
-                    monthlyData[i].month == currentSale.orderDate.monthOfYear) {
-                    monthIndex = i;
-                    foundMonth = 1;
-                }
+        if (recordsInRun > 0) {
+            for (long i = 0; i < recordsInRun; i++) {
+                order[i] = runRecords + (size_t)i * recordSize;
             }
+            runSorter(order, scratch, recordsInRun, compareFunction);
             
-            // If month not found, create new entry
-            if (foundMonth == 0 && monthCount < 100) {
-                monthIndex = monthCount;
-                monthlyData[monthIndex].year = currentSale.orderDate.yearValue;
-                monthlyData[monthIndex].month = currentSale.orderDate.monthOfYear;
-                monthlyData[monthIndex].orderCount = 0;
-                monthlyData[monthIndex].totalRevenue = 0.0;
-                monthCount++;
+            // Write the run sequentially
+            for (long i = 0; i < recordsInRun && errorOccurred == 0; i++) {
+                if (CountedWrite(order[i], recordSize, 1, runFile) != 1) {
+                    errorOccurred = 1;
+                }
             }
             
-            // If we found or created a valid month entry
-            if (monthIndex >= 0 && monthIndex < 100) {
-                // Increment order count (one order = one sale record)
-                monthlyData[monthIndex].orderCount++;
-                
-                // Find product to get price
-                productFound = 0;
-                rewind(productsFile);
-                
-                while (fread(&currentProduct, sizeof(productRecord), 1, productsFile) == 1 && productFound == 0) {
-                    if (currentProduct.productKey == currentSale.productKey) {
-                        // Calculate revenue: price * quantity
-                        lineRevenue = currentProduct.unitPriceUSD * (double)currentSale.quantity;
-                        lineRevenue = RoundToThirdDecimal(lineRevenue);
-                        monthlyData[monthIndex].totalRevenue += lineRevenue;
-                        productFound = 1;
-                    }
+            // Record where the run lives in the run file
+            if (*runCount == runArraySize) {
+                runArraySize = (runArraySize == 0) ? 16 : runArraySize * 2;
+                grownArray = (sortRunDescriptor*)realloc(runArray, (size_t)runArraySize * sizeof(sortRunDescriptor));
+                if (grownArray == NULL) {
+                    errorOccurred = 1;
+                } else {
+                    runArray = grownArray;
                 }
             }
+            if (errorOccurred == 0) {
+                runArray[*runCount].firstRecord = totalRecords;
+                runArray[*runCount].recordCount = recordsInRun;
+                (*runCount)++;
+            }
+            totalRecords += recordsInRun;
         }
-        
-        printf("Processed %d sales records into %d months\n", recordsProcessed, monthCount);
     }
     
-    // Close input files
-    if (salesFile != NULL) fclose(salesFile);
-    if (productsFile != NULL) fclose(productsFile);
+    if (inputFile != NULL) fclose(inputFile);
+    if (runFile != NULL) fclose(runFile);
+    free(runRecords);
+    free(order);
+    free(scratch);
     
-    // Write aggregated data to file
-    if (errorOccurred == 0 && monthCount > 0) {
-        monthlyFile = OpenFileWithErrorCheck(outputFileName, "wb");
-        if (monthlyFile == NULL) {
-            printf("Error: Cannot create monthly data file\n");
-            errorOccurred = 1;
-            returnValue = -1;
-        } else {
-            // Write all monthly records
-            for (int i = 0; i < monthCount; i++) {
-                if (fwrite(&monthlyData[i], sizeof(monthlySalesData), 1, monthlyFile) != 1) {
-                    printf("Error: Failed to write monthly data record %d\n", i);
-                    errorOccurred = 1;
-                    returnValue = -1;
-                }
-            }
-            
-            fclose(monthlyFile);
-            
-            if (errorOccurred == 0) {
-                returnValue = monthCount;
-            }
-        }
+    if (errorOccurred == 0) {
+        *runs = runArray;
+        returnValue = totalRecords;
+    } else {
+        free(runArray);
+        *runCount = 0;
     }
     
     return returnValue;                                // Single return point
-}//end function definition AggregateSalesByMonth
+}//end function definition CreateSortedRuns
 
 /*
- * Function: DrawASCIIBarChart
- * Purpose: Generates ASCII bar chart for visualizing monthly data
- * Parameters: txtFile - output file pointer (NULL to write only to console)
- *            monthlyData - array of monthly sales data
- *            dataCount - number of months in the array
- *            chartType - 'O' for orders, 'R' for revenue
- * Returns: void
- * Note: Creates horizontal bar chart with appropriate scaling
- *       Complies with single return requirement
+ * Function: LoserTreeRunWins
+ * Purpose: Decides which of two runs supplies the next record of a k-way merge
+ * Parameters: runA - first run index
+ *            runB - second run index
+ *            currentRecords - current head record of every run (k * recordSize bytes)
+ *            exhausted - 1 for runs with no records left
+ *            recordSize - size of each record in bytes
+ *            compareFunction - comparison function for sorting
+ *            comparisonCount - incremented when the records are compared
+ * Returns: int - 1 if runA wins over runB, 0 otherwise
+ * Note: Exhausted runs always lose; ties go to the lower run index so the
+ *       merge is stable (runs are numbered in input order)
  */
-void DrawASCIIBarChart(FILE* txtFile, const monthlySalesData* monthlyData, int dataCount, char chartType) {
-    unsigned long maxOrders = 0;                       // Maximum order count
-    double maxRevenue = 0.0;                           // Maximum revenue
-    int maxBarLength = 60;                             // Maximum bar length in characters
-    double scaleFactor = 0.0;                          // Scale factor for bars
-    const char* chartTitle = NULL;                     // Chart title
+int LoserTreeRunWins(int runA, int runB, const unsigned char* currentRecords, const int* exhausted,
+                     size_t recordSize, int (*compareFunction)(const void*, const void*),
+                     long long* comparisonCount) {
+    int comparison = 0;                                // Record comparison result
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    if (dataCount <= 0) {
-        WriteToReport(txtFile, "No data to display\n");
-        return;
+    if (exhausted[runA] == 0) {
+        if (exhausted[runB] == 1) {
+            returnValue = 1;
+        } else {
+            comparison = compareFunction(currentRecords + (size_t)runA * recordSize,
+                                         currentRecords + (size_t)runB * recordSize);
+            (*comparisonCount)++;
+            returnValue = (comparison < 0 || (comparison == 0 && runA < runB)) ? 1 : 0;
+        }
     }
     
-    // Set titles based on chart type
-    if (chartType == 'O') {
-        chartTitle = "Monthly Order Volume";
-    } else {
-        chartTitle = "Monthly Revenue";
+    return returnValue;
+}//end function definition LoserTreeRunWins
+
+/*
+ * Function: MergeSortedRuns
+ * Purpose: Phase 2 of the external sort - merges k sorted runs with a loser tree
+ * Parameters: runFileName - file holding the runs back to back
+ *            runs - run descriptors
+ *            runCount - number of runs (k)
+ *            outputFile - open file receiving the merged records (appended sequentially)
+ *            recordSize - size of each record in bytes
+ *            compareFunction - comparison function for sorting
+ * Returns: long - number of records written, -1 on error
+ * Note: Every run is read sequentially through its own buffered FILE handle.
+ *       The loser tree costs log2(k) comparisons per output record.
+ */
+long MergeSortedRuns(const char* runFileName, const sortRunDescriptor* runs, long runCount,
+                     FILE* outputFile, size_t recordSize,
+                     int (*compareFunction)(const void*, const void*)) {
+    FILE** runFiles = NULL;                            // One read handle per run
+    unsigned char* currentRecords = NULL;              // Head record of each run
+    long* remaining = NULL;                            // Records left in each run
+    int* exhausted = NULL;                             // 1 when a run has no head record
+    int* loserTree = NULL;                             // loserTree[0] = winner, [1..k-1] = losers
+    int* winners = NULL;                               // Winners of each match during construction
+    int runTotal = (int)runCount;                      // k
+    int winnerRun = 0;                                 // Run supplying the next output record
+    int contender = 0;                                 // Winner travelling up the tree
+    int swapTemp = 0;                                  // Temporary for swapping runs
+    size_t runBufferSize = 0;                          // stdio buffer per run
+    long recordsWritten = 0;                           // Output records
+    long long comparisons = 0;                         // Comparator invocations
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    if (runTotal > 0) {
+        runFiles = (FILE**)calloc((size_t)runTotal, sizeof(FILE*));
+        currentRecords = (unsigned char*)malloc((size_t)runTotal * recordSize);
+        remaining = (long*)malloc((size_t)runTotal * sizeof(long));
+        exhausted = (int*)malloc((size_t)runTotal * sizeof(int));
+        loserTree = (int*)malloc((size_t)runTotal * sizeof(int));
+        winners = (int*)malloc((size_t)runTotal * 2 * sizeof(int));
+        if (runFiles == NULL || currentRecords == NULL || remaining == NULL ||
+            exhausted == NULL || loserTree == NULL || winners == NULL) {
+            printf("Error: Cannot allocate merge state for %d runs\n", runTotal);
+            errorOccurred = 1;
+        }
     }
     
-    // Find maximum value for scaling
-    for (int i = 0; i < dataCount; i++) {
-        if (chartType == 'O') {
-            if (monthlyData[i].orderCount > maxOrders) {
-                maxOrders = monthlyData[i].orderCount;
-            }
+    // Open every run at its start and load its first record
+    runBufferSize = sortMemoryBudget / (size_t)(runTotal + 1);
+    if (runBufferSize > 1024UL * 1024UL) runBufferSize = 1024UL * 1024UL;
+    if (runBufferSize < BUFSIZ) runBufferSize = BUFSIZ;
+    for (int run = 0; run < runTotal && errorOccurred == 0; run++) {
+        runFiles[run] = OpenFileWithErrorCheck(runFileName, "rb");
+        if (runFiles[run] == NULL) {
+            errorOccurred = 1;
         } else {
-            if (monthlyData[i].totalRevenue > maxRevenue) {
-                maxRevenue = monthlyData[i].totalRevenue;
+            setvbuf(runFiles[run], NULL, _IOFBF, runBufferSize);
+            if (CountedSeek64(runFiles[run], (long long)runs[run].firstRecord * (long long)recordSize, SEEK_SET) != 0) {
+                printf("Error: Cannot seek to run %d in %s\n", run, runFileName);
+                errorOccurred = 1;
+            }
+            remaining[run] = runs[run].recordCount;
+            exhausted[run] = 1;
+            if (errorOccurred == 0 && remaining[run] > 0 &&
+                CountedRead(currentRecords + (size_t)run * recordSize, recordSize, 1, runFiles[run]) == 1) {
+                remaining[run]--;
+                exhausted[run] = 0;
             }
         }
     }
     
-    // Calculate scale factor
-    if (chartType == 'O') {
-        scaleFactor = (maxOrders > 0) ? (double)maxBarLength / (double)maxOrders : 0.0;
-    } else {
-        scaleFactor = (maxRevenue > 0.0) ? (double)maxBarLength / maxRevenue : 0.0;
-    }
-    
-    // Draw chart header
-    WriteToReport(txtFile, "\n%s\n", chartTitle);
-    WriteToReport(txtFile, "========================================\n");
-    
-    // Draw bars for each month
-    for (int i = 0; i < dataCount; i++) {
-        int barLength = 0;                             // Length of bar for this month
-        
-        // Calculate bar length
-        if (chartType == 'O') {
-            barLength = (int)(monthlyData[i].orderCount * scaleFactor);
-        } else {
-            barLength = (int)(monthlyData[i].totalRevenue * scaleFactor);
+    if (errorOccurred == 0 && runTotal > 0) {
+        // Build the tree bottom-up: leaves live at winners[k..2k-1]
+        for (int run = 0; run < runTotal; run++) {
+            winners[runTotal + run] = run;
         }
-        
-        // Ensure at least 1 character if value > 0
-        if (barLength == 0 && 
-            ((chartType == 'O' && monthlyData[i].orderCount > 0) ||
-             (chartType == 'R' && monthlyData[i].totalRevenue > 0.0))) {
-            barLength = 1;
+        for (int node = runTotal - 1; node >= 1; node--) {
+            if (LoserTreeRunWins(winners[2 * node], winners[2 * node + 1], currentRecords,
+                                 exhausted, recordSize, compareFunction, &comparisons) == 1) {
+                winners[node] = winners[2 * node];
+                loserTree[node] = winners[2 * node + 1];
+            } else {
+                winners[node] = winners[2 * node + 1];
+                loserTree[node] = winners[2 * node];
+            }
         }
+        loserTree[0] = winners[1];
         
-        // Print month label
-        WriteToReport(txtFile, "%04u-%02u | ", 
-               monthlyData[i].year, monthlyData[i].month);
-        
-        // Draw bar
-        for (int j = 0; j < barLength; j++) {
-            WriteToReport(txtFile, "\u2588");          // Unicode block character
+        while (exhausted[loserTree[0]] == 0 && errorOccurred == 0) {
+            winnerRun = loserTree[0];
+            if (CountedWrite(currentRecords + (size_t)winnerRun * recordSize, recordSize, 1, outputFile) != 1) {
+                errorOccurred = 1;
+            }
+            recordsWritten++;
+            
+            // Refill the winner's slot from its run
+            if (remaining[winnerRun] > 0 &&
+                CountedRead(currentRecords + (size_t)winnerRun * recordSize, recordSize, 1, runFiles[winnerRun]) == 1) {
+                remaining[winnerRun]--;
+            } else {
+                exhausted[winnerRun] = 1;
+            }
+            
+            // Replay matches on the path from the winner's leaf to the root
+            contender = winnerRun;
+            for (int node = (runTotal + winnerRun) / 2; node >= 1; node /= 2) {
+                if (LoserTreeRunWins(loserTree[node], contender, currentRecords,
+                                     exhausted, recordSize, compareFunction, &comparisons) == 1) {
+                    swapTemp = loserTree[node];
+                    loserTree[node] = contender;
+                    contender = swapTemp;
+                }
+            }
+            loserTree[0] = contender;
         }
-        
-        // Print value
-        if (chartType == 'O') {
-            WriteToReport(txtFile, " %lu\n", monthlyData[i].orderCount);
-        } else {
-            WriteToReport(txtFile, " $%.2f\n", monthlyData[i].totalRevenue);
+    }
+    
+    if (runFiles != NULL) {
+        for (int run = 0; run < runTotal; run++) {
+            if (runFiles[run] != NULL) fclose(runFiles[run]);
         }
     }
+    free(runFiles);
+    free(currentRecords);
+    free(remaining);
+    free(exhausted);
+    free(loserTree);
+    free(winners);
+    CountComparisons(comparisons);
     
-    WriteToReport(txtFile, "\n");
+    if (errorOccurred == 0) {
+        returnValue = recordsWritten;
+    }
     
-    // No explicit return needed for void function
-}//end function definition DrawASCIIBarChart
+    return returnValue;                                // Single return point
+}//end function definition MergeSortedRuns
+
+// ====================== PARALLEL SORT OPERATIONS ======================
+#define SORT_MAX_THREADS 64                                  // WaitForMultipleObjects handle limit
+#define PARALLEL_SORT_MIN_CHUNK 16384L                       // Fewer records per thread are not split
+
+static int sortThreadCount = 0;                              // Sort worker threads (0 = one per processor)
 
 /*
- * Function: AnalyzeSeasonalPatternsByCategory
- * Purpose: Analyzes seasonal patterns for different product categories
- * Parameters: txtFile - output file pointer
+ * Structure: parallelSortTask
+ * Purpose: Work item handed to one sort worker thread
+ * Note: A chunk task sorts source[rangeStart..rangeEnd) in place using target as scratch.
+ *       A merge task writes target[rangeStart..rangeEnd), the matching slice of the stable
+ *       merge of source[leftStart..leftEnd) and source[leftEnd..rightEnd).
+ */
+typedef struct {
+    const unsigned char** source;                      // Pointers read by the task
+    const unsigned char** target;                      // Scratch (chunk) or merge output
+    long rangeStart;                                   // First position handled
+    long rangeEnd;                                     // One past the last position handled
+    long leftStart;                                    // Merge: start of left sorted block
+    long leftEnd;                                      // Merge: end of left / start of right block
+    long rightEnd;                                     // Merge: end of right sorted block
+    int (*compareFunction)(const void*, const void*);  // Record comparison
+    void (*chunkSorter)(const unsigned char**, const unsigned char**, long,
+                        int (*)(const void*, const void*)); // Chunk: single-threaded sort
+} parallelSortTask;
+
+/*
+ * Function: SetSortThreadCount
+ * Purpose: Sets how many worker threads SortMerge and SortRadix use to sort each run
+ *          and how many Sales.csv chunks the database build parses at a time
+ * Parameters: threadCount - number of threads; 0 uses one per processor.
+ *                           Values above SORT_MAX_THREADS are lowered to it.
  * Returns: void
- * Note: Processes sales data to find category-specific seasonal trends
+ * Note: 1 keeps the sort and the Sales.csv parse on the calling thread
  */
-void AnalyzeSeasonalPatternsByCategory(FILE* txtFile) {
-    FILE* salesFile = NULL;
-    FILE* productsFile = NULL;
-    salesRecord currentSale;
-    productRecord currentProduct;
-    categorySeasonalData categories[20];               // Max 20 categories
-    int categoryCount = 0;
-    int errorOccurred = 0;
+void SetSortThreadCount(int threadCount) {
+    if (threadCount < 0) {
+        threadCount = 0;
+    }
+    if (threadCount > SORT_MAX_THREADS) {
+        threadCount = SORT_MAX_THREADS;
+    }
+    sortThreadCount = threadCount;
+}//end function definition SetSortThreadCount
+
+/*
+ * Function: GetSortThreadCount
+ * Purpose: Returns the number of sort worker threads actually used
+ * Parameters: None
+ * Returns: int - configured count, or the processor count when set to 0
+ */
+int GetSortThreadCount(void) {
+    SYSTEM_INFO systemInfo;                            // Processor information
+    int threadCount = sortThreadCount;                 // Result
     
-    // Initialize categories array
-    for (int i = 0; i < 20; i++) {
-        InitializeStructureToZero(&categories[i], sizeof(categorySeasonalData));
+    if (threadCount == 0) {
+        GetSystemInfo(&systemInfo);
+        threadCount = (int)systemInfo.dwNumberOfProcessors;
+    }
+    if (threadCount < 1) {
+        threadCount = 1;
+    }
+    if (threadCount > SORT_MAX_THREADS) {
+        threadCount = SORT_MAX_THREADS;
     }
     
-    WriteToReport(txtFile, "\n\n=== SEASONAL PATTERNS BY PRODUCT CATEGORY ===\n");
-    WriteToReport(txtFile, "=================================================================\n");
+    return threadCount;                                // Single return point
+}//end function definition GetSortThreadCount
+
+/*
+ * Function: SortChunkWorker
+ * Purpose: Thread entry point sorting one chunk of record pointers
+ * Parameters: parameter - parallelSortTask describing the chunk
+ * Returns: DWORD - always 0
+ */
+DWORD WINAPI SortChunkWorker(LPVOID parameter) {
+    parallelSortTask* task = (parallelSortTask*)parameter; // Chunk to sort
     
-    // Open required files
-    salesFile = OpenFileWithErrorCheck("SalesTable.dat", "rb");
-    productsFile = OpenFileWithErrorCheck("ProductsTable.dat", "rb");
+    task->chunkSorter(task->source + task->rangeStart, task->target + task->rangeStart,
+                      task->rangeEnd - task->rangeStart, task->compareFunction);
     
-    if (salesFile == NULL || productsFile == NULL) {
-        WriteToReport(txtFile, "Error: Cannot open required files for category analysis\n");
-        errorOccurred = 1;
+    return 0;
+}//end function definition SortChunkWorker
+
+/*
+ * Function: FindMergeSplit
+ * Purpose: Finds how many left-block records precede a given merged output position
+ * Parameters: task - merge task (source and block bounds)
+ *            outputPosition - position in the merged output, relative to leftStart
+ *            comparisonCount - incremented once per comparison made
+ * Returns: long - number of left-block records among the first outputPosition merged ones
+ * Note: Binary search consistent with a merge that takes the left record on ties
+ */
+long FindMergeSplit(const parallelSortTask* task, long outputPosition, long long* comparisonCount) {
+    const unsigned char** left = task->source + task->leftStart; // Left sorted block
+    const unsigned char** right = task->source + task->leftEnd;  // Right sorted block
+    long leftCount = task->leftEnd - task->leftStart;  // Records in left block
+    long rightCount = task->rightEnd - task->leftEnd;  // Records in right block
+    long low = 0;                                      // Search lower bound
+    long high = 0;                                     // Search upper bound
+    long middle = 0;                                   // Candidate left count
+    long rightTaken = 0;                               // Right records for the candidate
+    
+    low = (outputPosition > rightCount) ? outputPosition - rightCount : 0;
+    high = (outputPosition < leftCount) ? outputPosition : leftCount;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        rightTaken = outputPosition - middle;
+        (*comparisonCount)++;
+        if (task->compareFunction(right[rightTaken - 1], left[middle]) >= 0) {
+            // left[middle] is merged before right[rightTaken - 1]: more left records needed
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
     }
     
-    if (errorOccurred == 0) {
-        // Process each sale
-        while (fread(&currentSale, sizeof(salesRecord), 1, salesFile) == 1) {
-            // Find product
-            int productFound = 0;
-            rewind(productsFile);
-            
-            while (fread(&currentProduct, sizeof(productRecord), 1, productsFile) == 1 && productFound == 0) {
-                if (currentProduct.productKey == currentSale.productKey) {
-                    productFound = 1;
-                    
-                    // Find or create category entry
-                    int categoryIndex = -1;
-                    int foundCategory = 0;
-                    
-                    for (int i = 0; i < categoryCount && foundCategory == 0; i++) {
-                        if (strcmp(categories[i].category, currentProduct.category) == 0) {
-                            categoryIndex = i;
-                            foundCategory = 1;
-                        }
-                    }
-                    
-                    if (foundCategory == 0 && categoryCount < 20) {
-                        categoryIndex = categoryCount;
-                        strncpy(categories[categoryIndex].category, currentProduct.category, 19);
-                        categories[categoryIndex].category[19] = '\0';
-                        categoryCount++;
-                    }
-                    
-                    if (categoryIndex >= 0) {
-                        double lineRevenue = currentProduct.unitPriceUSD * currentSale.quantity;
-                        lineRevenue = RoundToThirdDecimal(lineRevenue);
-                        
-                        // Assign to quarter
-                        int month = currentSale.orderDate.monthOfYear;
-                        if (month >= 1 && month <= 3) {
-                            categories[categoryIndex].q1Revenue += lineRevenue;
-                            categories[categoryIndex].q1Orders++;
-                        } else if (month >= 4 && month <= 6) {
-                            categories[categoryIndex].q2Revenue += lineRevenue;
-                            categories[categoryIndex].q2Orders++;
-                        } else if (month >= 7 && month <= 9) {
-                            categories[categoryIndex].q3Revenue += lineRevenue;
-                            categories[categoryIndex].q3Orders++;
-                        } else if (month >= 10 && month <= 12) {
-                            categories[categoryIndex].q4Revenue += lineRevenue;
-                            categories[categoryIndex].q4Orders++;
-                        }
-                    }
-                }
-            }
-        }
-        
-        // Display results
-        WriteToReport(txtFile, "\n%-20s %12s %12s %12s %12s\n", 
-               "Category", "Q1 Revenue", "Q2 Revenue", "Q3 Revenue", "Q4 Revenue");
-        WriteToReport(txtFile, "--------------------------------------------------------------------------------\n");
-        
-        for (int i = 0; i < categoryCount; i++) {
-            WriteToReport(txtFile, "%-20s $%11.2f $%11.2f $%11.2f $%11.2f\n",
-                   categories[i].category,
-                   categories[i].q1Revenue,
-                   categories[i].q2Revenue,
-                   categories[i].q3Revenue,
-                   categories[i].q4Revenue);
-            
-            // Find peak quarter
-            double maxRevenue = categories[i].q1Revenue;
-            const char* peakQuarter = "Q1";
-            
-            if (categories[i].q2Revenue > maxRevenue) {
-                maxRevenue = categories[i].q2Revenue;
-                peakQuarter = "Q2";
-            }
-            if (categories[i].q3Revenue > maxRevenue) {
-                maxRevenue = categories[i].q3Revenue;
-                peakQuarter = "Q3";
-            }
-            if (categories[i].q4Revenue > maxRevenue) {
-                maxRevenue = categories[i].q4Revenue;
-                peakQuarter = "Q4";
-            }
-            
-            WriteToReport(txtFile, "  Peak season: %s ($%.2f)\n", peakQuarter, maxRevenue);
+    return low;                                        // Single return point
+}//end function definition FindMergeSplit
+
+/*
+ * Function: MergeSliceWorker
+ * Purpose: Thread entry point producing one slice of a stable two-block merge
+ * Parameters: parameter - parallelSortTask describing the blocks and the output slice
+ * Returns: DWORD - always 0
+ * Note: The slice bounds are mapped back to both input blocks with FindMergeSplit,
+ *       so slices of the same merge can run concurrently without coordination
+ */
+DWORD WINAPI MergeSliceWorker(LPVOID parameter) {
+    parallelSortTask* task = (parallelSortTask*)parameter; // Slice to merge
+    long leftIndex = 0;                                // Read position in left block
+    long leftStop = 0;                                 // End of left records for this slice
+    long rightIndex = 0;                               // Read position in right block
+    long rightStop = 0;                                // End of right records for this slice
+    long outIndex = task->rangeStart;                  // Write position in target
+    long splitCount = 0;                               // Left records before a slice bound
+    long long comparisons = 0;                         // Comparator invocations
+    
+    splitCount = FindMergeSplit(task, task->rangeStart - task->leftStart, &comparisons);
+    leftIndex = task->leftStart + splitCount;
+    rightIndex = task->leftEnd + (task->rangeStart - task->leftStart - splitCount);
+    splitCount = FindMergeSplit(task, task->rangeEnd - task->leftStart, &comparisons);
+    leftStop = task->leftStart + splitCount;
+    rightStop = task->leftEnd + (task->rangeEnd - task->leftStart - splitCount);
+    
+    // Take from the left on ties to keep the sort stable
+    while (leftIndex < leftStop && rightIndex < rightStop) {
+        comparisons++;
+        if (task->compareFunction(task->source[rightIndex], task->source[leftIndex]) < 0) {
+            task->target[outIndex++] = task->source[rightIndex++];
+        } else {
+            task->target[outIndex++] = task->source[leftIndex++];
         }
     }
+    while (leftIndex < leftStop) {
+        task->target[outIndex++] = task->source[leftIndex++];
+    }
+    while (rightIndex < rightStop) {
+        task->target[outIndex++] = task->source[rightIndex++];
+    }
+    CountComparisons(comparisons);
     
-    if (salesFile != NULL) fclose(salesFile);
-    if (productsFile != NULL) fclose(productsFile);
-}//end function definition AnalyzeSeasonalPatternsByCategory
+    return 0;
+}//end function definition MergeSliceWorker
 
 /*
- * Function: AnalyzeSeasonalPatternsByRegion
- * Purpose: Analyzes seasonal patterns for different geographical regions
- * Parameters: txtFile - output file pointer
+ * Function: RunWorkerTasks
+ * Purpose: Runs a batch of tasks on worker threads and waits for all of them
+ * Parameters: worker - thread entry point (e.g. SortChunkWorker or MergeSliceWorker)
+ *            tasks - task array
+ *            taskSize - size of each task in bytes
+ *            taskCount - number of tasks (at most SORT_MAX_THREADS)
  * Returns: void
- * Note: Processes sales data to find region-specific seasonal trends
+ * Note: The first task runs on the calling thread. A task whose thread cannot be
+ *       created is also run on the calling thread, so the result never depends on
+ *       how many threads were obtained.
  */
-void AnalyzeSeasonalPatternsByRegion(FILE* txtFile) {
-    FILE* salesFile = NULL;
-    FILE* productsFile = NULL;
-    FILE* customersFile = NULL;
-    salesRecord currentSale;
-    productRecord currentProduct;
-    customerRecord currentCustomer;
-    regionSeasonalData regions[10];                    // Max 10 regions
-    int regionCount = 0;
-    int errorOccurred = 0;
-    
-    // Initialize regions array
-    for (int i = 0; i < 10; i++) {
-        InitializeStructureToZero(&regions[i], sizeof(regionSeasonalData));
+void RunWorkerTasks(LPTHREAD_START_ROUTINE worker, void* tasks, size_t taskSize, int taskCount) {
+    HANDLE threadHandles[SORT_MAX_THREADS];            // Started worker threads
+    DWORD handleCount = 0;                             // Number of started threads
+    unsigned char* taskBytes = (unsigned char*)tasks;  // Task array addressed by byte offset
+    
+    for (int i = 1; i < taskCount; i++) {
+        threadHandles[handleCount] = CreateThread(NULL, 0, worker, taskBytes + (size_t)i * taskSize, 0, NULL);
+        if (threadHandles[handleCount] != NULL) {
+            handleCount++;
+        } else {
+            worker(taskBytes + (size_t)i * taskSize);
+        }
     }
-    
-    WriteToReport(txtFile, "\n\n=== SEASONAL PATTERNS BY REGION ===\n");
-    WriteToReport(txtFile, "=================================================================\n");
-    
-    // Open required files
-    salesFile = OpenFileWithErrorCheck("SalesTable.dat", "rb");
-    productsFile = OpenFileWithErrorCheck("ProductsTable.dat", "rb");
-    customersFile = OpenFileWithErrorCheck("CustomersTable.dat", "rb");
-    
-    if (salesFile == NULL || productsFile == NULL || customersFile == NULL) {
-        WriteToReport(txtFile, "Error: Cannot open required files for region analysis\n");
-        errorOccurred = 1;
+    if (taskCount > 0) {
+        worker(taskBytes);
     }
     
-    if (errorOccurred == 0) {
-        // Process each sale
-        while (fread(&currentSale, sizeof(salesRecord), 1, salesFile) == 1) {
-            // Find customer
-            int customerFound = 0;
-            rewind(customersFile);
-            
-            while (fread(&currentCustomer, sizeof(customerRecord), 1, customersFile) == 1 && customerFound == 0) {
-                if (currentCustomer.customerKey == currentSale.customerKey) {
-                    customerFound = 1;
-                    
-                    // Find product for price
-                    int productFound = 0;
-                    rewind(productsFile);
-                    
-                    while (fread(&currentProduct, sizeof(productRecord), 1, productsFile) == 1 && productFound == 0) {
-                        if (currentProduct.productKey == currentSale.productKey) {
-                            productFound = 1;
-                            
-                            // Find or create region entry
-                            int regionIndex = -1;
-                            int foundRegion = 0;
-                            
-                            for (int i = 0; i < regionCount && foundRegion == 0; i++) {
-                                if (strcmp(regions[i].continent, currentCustomer.continent) == 0) {
-                                    regionIndex = i;
-                                    foundRegion = 1;
-                                }
-                            }
-                            
-                            if (foundRegion == 0 && regionCount < 10) {
-                                regionIndex = regionCount;
-                                strncpy(regions[regionIndex].continent, currentCustomer.continent, 19);
-                                regions[regionIndex].continent[19] = '\0';
-                                regionCount++;
-                            }
-                            
-                            if (regionIndex >= 0) {
-                                double lineRevenue = currentProduct.unitPriceUSD * currentSale.quantity;
-                                lineRevenue = RoundToThirdDecimal(lineRevenue);
-                                
-                                // Assign to quarter
-                                int month = currentSale.orderDate.monthOfYear;
-                                if (month >= 1 && month <= 3) {
-                                    regions[regionIndex].q1Revenue += lineRevenue;
-                                    regions[regionIndex].q1Orders++;
-                                } else if (month >= 4 && month <= 6) {
-                                    regions[regionIndex].q2Revenue += lineRevenue;
-                                    regions[regionIndex].q2Orders++;
-                                } else if (month >= 7 && month <= 9) {
-                                    regions[regionIndex].q3Revenue += lineRevenue;
-                                    regions[regionIndex].q3Orders++;
-                                } else if (month >= 10 && month <= 12) {
-                                    regions[regionIndex].q4Revenue += lineRevenue;
-                                    regions[regionIndex].q4Orders++;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        
-        // Display results
-        WriteToReport(txtFile, "\n%-20s %12s %12s %12s %12s\n", 
-               "Region", "Q1 Revenue", "Q2 Revenue", "Q3 Revenue", "Q4 Revenue");
-        WriteToReport(txtFile, "--------------------------------------------------------------------------------\n");
-        
-        for (int i = 0; i < regionCount; i++) {
-            WriteToReport(txtFile, "%-20s $%11.2f $%11.2f $%11.2f $%11.2f\n",
-                   regions[i].continent,
-                   regions[i].q1Revenue,
-                   regions[i].q2Revenue,
-                   regions[i].q3Revenue,
-                   regions[i].q4Revenue);
-            
-            // Find peak quarter
-            double maxRevenue = regions[i].q1Revenue;
-            const char* peakQuarter = "Q1";
-            
-            if (regions[i].q2Revenue > maxRevenue) {
-                maxRevenue = regions[i].q2Revenue;
-                peakQuarter = "Q2";
-            }
-            if (regions[i].q3Revenue > maxRevenue) {
-                maxRevenue = regions[i].q3Revenue;
-                peakQuarter = "Q3";
-            }
-            if (regions[i].q4Revenue > maxRevenue) {
-                maxRevenue = regions[i].q4Revenue;
-                peakQuarter = "Q4";
-            }
-            
-            WriteToReport(txtFile, "  Peak season: %s ($%.2f) - Orders: %lu/%lu/%lu/%lu\n", 
-                   peakQuarter, maxRevenue,
-                   regions[i].q1Orders, regions[i].q2Orders, 
-                   regions[i].q3Orders, regions[i].q4Orders);
-        }
+    if (handleCount > 0) {
+        WaitForMultipleObjects(handleCount, threadHandles, TRUE, INFINITE);
     }
-    
-    if (salesFile != NULL) fclose(salesFile);
-    if (productsFile != NULL) fclose(productsFile);
-    if (customersFile != NULL) fclose(customersFile);
-}//end function definition AnalyzeSeasonalPatternsByRegion
+    for (DWORD i = 0; i < handleCount; i++) {
+        CloseHandle(threadHandles[i]);
+    }
+}//end function definition RunWorkerTasks
 
 /*
- * Function: GenerateTrendAnalysis
- * Purpose: Analyzes growth trends and patterns over time
- * Parameters: txtFile - output file pointer
- *            monthlyData - array of monthly data
- *            dataCount - number of months
+ * Function: ParallelSortRecordPointers
+ * Purpose: Stable multithreaded sort of an array of record pointers
+ * Parameters: order - pointers to sort; holds the sorted order on return
+ *            scratch - work array with room for count pointers
+ *            count - number of pointers
+ *            compareFunction - comparison function for the pointed-to records
+ *            chunkSorter - stable single-threaded sort applied to each chunk
  * Returns: void
- * Note: Calculates year-over-year growth and identifies trends
+ * Note: The array is cut into one chunk per thread (see SetSortThreadCount), chunks are
+ *       sorted concurrently, then neighbouring chunks are merged pairwise. Every merge
+ *       round splits its output into one slice per thread, so all threads stay busy up
+ *       to the final merge. Small inputs are sorted directly by chunkSorter.
  */
-void GenerateTrendAnalysis(FILE* txtFile, const monthlySalesData* monthlyData, int dataCount) {
-    WriteToReport(txtFile, "\n\n=== TREND ANALYSIS ===\n");
-    WriteToReport(txtFile, "======================\n");
-    
-    if (dataCount < 2) {
-        WriteToReport(txtFile, "Insufficient data for trend analysis\n");
-        return;
-    }
-    
-    // Calculate month-over-month changes
-    double avgOrderGrowth = 0.0;
-    double avgRevenueGrowth = 0.0;
-    int growthSamples = 0;
-    
-    WriteToReport(txtFile, "\nMonth-over-Month Changes:\n");
-    WriteToReport(txtFile, "%-10s %15s %15s\n", "Period", "Order Change", "Revenue Change");
-    WriteToReport(txtFile, "--------------------------------------------------------\n");
-    
-    for (int i = 1; i < dataCount; i++) {
-        double orderChange = 0.0;
-        double revenueChange = 0.0;
-        
-        if (monthlyData[i-1].orderCount > 0) {
-            orderChange = ((double)monthlyData[i].orderCount - (double)monthlyData[i-1].orderCount) / 
-                         (double)monthlyData[i-1].orderCount * 100.0;
+void ParallelSortRecordPointers(const unsigned char** order, const unsigned char** scratch, long count,
+                                int (*compareFunction)(const void*, const void*),
+                                void (*chunkSorter)(const unsigned char**, const unsigned char**, long,
+                                                    int (*)(const void*, const void*))) {
+    parallelSortTask tasks[SORT_MAX_THREADS];          // Tasks of the current round
+    long chunkBounds[SORT_MAX_THREADS + 1];            // Chunk boundaries in order[]
+    const unsigned char** source = order;              // Sorted blocks of the current round
+    const unsigned char** target = scratch;            // Merged blocks of the current round
+    const unsigned char** swapTemp = NULL;             // Temporary for swapping arrays
+    int threadCount = GetSortThreadCount();            // Threads (= initial chunks)
+    int chunksPerBlock = 1;                            // Sorted block width in chunks
+    int blockPairs = 0;                                // Merges in the current round
+    int slicesPerMerge = 0;                            // Threads per merge
+    int taskCount = 0;                                 // Tasks in the current round
+    long mergeLength = 0;                              // Records in one merge
+    
+    if (threadCount > count / PARALLEL_SORT_MIN_CHUNK) {
+        threadCount = (int)(count / PARALLEL_SORT_MIN_CHUNK);
+    }
+    
+    if (threadCount <= 1) {
+        chunkSorter(order, scratch, count, compareFunction);
+    } else {
+        // Phase 1: sort one chunk per thread
+        for (int t = 0; t <= threadCount; t++) {
+            chunkBounds[t] = (long)((long long)count * t / threadCount);
+        }
+        for (int t = 0; t < threadCount; t++) {
+            InitializeStructureToZero(&tasks[t], sizeof(parallelSortTask));
+            tasks[t].source = order;
+            tasks[t].target = scratch;
+            tasks[t].rangeStart = chunkBounds[t];
+            tasks[t].rangeEnd = chunkBounds[t + 1];
+            tasks[t].compareFunction = compareFunction;
+            tasks[t].chunkSorter = chunkSorter;
+        }
+        RunWorkerTasks(SortChunkWorker, tasks, sizeof(parallelSortTask), threadCount);
+        
+        // Phase 2: merge neighbouring blocks until one block remains
+        for (chunksPerBlock = 1; chunksPerBlock < threadCount; chunksPerBlock *= 2) {
+            blockPairs = (threadCount + 2 * chunksPerBlock - 1) / (2 * chunksPerBlock);
+            slicesPerMerge = threadCount / blockPairs;
+            taskCount = 0;
+            for (int firstChunk = 0; firstChunk < threadCount; firstChunk += 2 * chunksPerBlock) {
+                long leftStart = chunkBounds[firstChunk];
+                long leftEnd = chunkBounds[(firstChunk + chunksPerBlock < threadCount) ?
+                                           firstChunk + chunksPerBlock : threadCount];
+                long rightEnd = chunkBounds[(firstChunk + 2 * chunksPerBlock < threadCount) ?
+                                            firstChunk + 2 * chunksPerBlock : threadCount];
+                
+                mergeLength = rightEnd - leftStart;
+                for (int slice = 0; slice < slicesPerMerge; slice++) {
+                    InitializeStructureToZero(&tasks[taskCount], sizeof(parallelSortTask));
+                    tasks[taskCount].source = source;
+                    tasks[taskCount].target = target;
+                    tasks[taskCount].leftStart = leftStart;
+                    tasks[taskCount].leftEnd = leftEnd;
+                    tasks[taskCount].rightEnd = rightEnd;
+                    tasks[taskCount].rangeStart = leftStart + (long)((long long)mergeLength * slice / slicesPerMerge);
+                    tasks[taskCount].rangeEnd = leftStart + (long)((long long)mergeLength * (slice + 1) / slicesPerMerge);
+                    tasks[taskCount].compareFunction = compareFunction;
+                    taskCount++;
+                }
+            }
+            RunWorkerTasks(MergeSliceWorker, tasks, sizeof(parallelSortTask), taskCount);
+            swapTemp = source;
+            source = target;
+            target = swapTemp;
         }
         
-        if (monthlyData[i-1].totalRevenue > 0.0) {
-            revenueChange = (monthlyData[i].totalRevenue - monthlyData[i-1].totalRevenue) / 
-                           monthlyData[i-1].totalRevenue * 100.0;
+        // Make sure the result ends up in order[]
+        if (source != order) {
+            memcpy(order, source, (size_t)count * sizeof(const unsigned char*));
         }
-        
-        WriteToReport(txtFile, "%04u-%02u %15.2f%% %15.2f%%\n",
-               monthlyData[i].year, monthlyData[i].month,
-               orderChange, revenueChange);
-        
-        avgOrderGrowth += orderChange;
-        avgRevenueGrowth += revenueChange;
-        growthSamples++;
     }
-    
-    if (growthSamples > 0) {
-        avgOrderGrowth /= growthSamples;
-        avgRevenueGrowth /= growthSamples;
-        
-        WriteToReport(txtFile, "\nAverage Growth Rates:\n");
-        WriteToReport(txtFile, "  Orders: %.2f%% per month\n", avgOrderGrowth);
-        WriteToReport(txtFile, "  Revenue: %.2f%% per month\n", avgRevenueGrowth);
-        
-        // Interpret trends
-        WriteToReport(txtFile, "\nTrend Interpretation:\n");
-        if (avgOrderGrowth > 5.0) {
-            WriteToReport(txtFile, "  \u2713 Strong positive order volume trend\n");
-        } else if (avgOrderGrowth > 0.0) {
-            WriteToReport(txtFile, "  \u2713 Modest positive order volume trend\n");
-        } else if (avgOrderGrowth < -5.0) {
-            WriteToReport(txtFile, "  \u26A0 Declining order volume trend\n");
-        } else {
-            WriteToReport(txtFile, "  \u2192 Stable order volume\n");
-        }
-        
-        if (avgRevenueGrowth > 5.0) {
-            WriteToReport(txtFile, "  \u2713 Strong positive revenue trend\n");
-        } else if (avgRevenueGrowth > 0.0) {
-            WriteToReport(txtFile, "  \u2713 Modest positive revenue trend\n");
-        } else if (avgRevenueGrowth < -5.0) {
-            WriteToReport(txtFile, "  \u26A0 Declining revenue trend\n");
+}//end function definition ParallelSortRecordPointers
+
+/*
+ * Function: ParallelMergeSortRecordPointers
+ * Purpose: Run sorter for SortMerge - parallel sort with SortRecordPointers per chunk
+ * Parameters: order - pointers to sort; holds the sorted order on return
+ *            scratch - work array with room for count pointers
+ *            count - number of pointers
+ *            compareFunction - comparison function for the pointed-to records
+ * Returns: void
+ */
+void ParallelMergeSortRecordPointers(const unsigned char** order, const unsigned char** scratch, long count,
+                                     int (*compareFunction)(const void*, const void*)) {
+    ParallelSortRecordPointers(order, scratch, count, compareFunction, SortRecordPointers);
+}//end function definition ParallelMergeSortRecordPointers
+
+// ====================== COMPARISON FUNCTIONS ======================
+
+/*
+ * Function: ToLowerCase
+ * Purpose: Converts a string to lowercase for case-insensitive comparisons
+ * Parameters: dest - destination buffer
+ *            src - source string
+ *            maxLen - maximum length to copy
+ * Returns: void
+ * Note: Helper function for flexible searching
+ */
+void ToLowerCase(char* dest, const char* src, size_t maxLen) {
+    size_t i = 0;
+    while (i < maxLen - 1 && src[i] != '\0') {
+        if (src[i] >= 'A' && src[i] <= 'Z') {
+            dest[i] = src[i] + 32;  // Convert to lowercase
         } else {
-            WriteToReport(txtFile, "  \u2192 Stable revenue\n");
+            dest[i] = src[i];
         }
+        i++;
     }
-}//end function definition GenerateTrendAnalysis
+    dest[i] = '\0';
+}
 
 /*
- * Function: GenerateBusinessRecommendations
- * Purpose: Generates business recommendations based on seasonal patterns
- * Parameters: txtFile - output file pointer
- *            monthlyData - array of monthly data
- *            dataCount - number of months
- * Returns: void
- * Note: Provides actionable insights for business planning
+ * Function: CompareProductNameOnly
+ * Purpose: Compares two product records by product name only (for flexible searching)
+ * Parameters: record1 - pointer to first product-customer combined record
+ *            record2 - pointer to second product-customer combined record
+ * Returns: int - comparison result for ProductName only
+ * Note: Used for partial searches in Report 2
  */
-void GenerateBusinessRecommendations(FILE* txtFile, const monthlySalesData* monthlyData, int dataCount) {
-    WriteToReport(txtFile, "\n\n=== BUSINESS IMPACT & RECOMMENDATIONS ===\n");
-    WriteToReport(txtFile, "=========================================\n");
-    
-    if (dataCount == 0) {
-        return;
-    }
+int CompareProductNameOnly(const void* record1, const void* record2) {
+    const productCustomerRecord* pc1 = (const productCustomerRecord*)record1;
+    const productCustomerRecord* pc2 = (const productCustomerRecord*)record2;
+    return strcmp(pc1->product.productName, pc2->product.productName);
+}
+
+/*
+ * Function: CompareCustomerNameOnly
+ * Purpose: Compares two sales records by customer name only (for flexible searching)
+ * Parameters: record1 - pointer to first sales-customer combined record
+ *            record2 - pointer to second sales-customer combined record
+ * Returns: int - comparison result for Customer Name only
+ * Note: Used for partial searches in Report 5
+ */
+int CompareCustomerNameOnly(const void* record1, const void* record2) {
+    const salesCustomerRecord* sc1 = (const salesCustomerRecord*)record1;
+    const salesCustomerRecord* sc2 = (const salesCustomerRecord*)record2;
+    return strcmp(sc1->customer.name, sc2->customer.name);
+}
+
+/*
+ * Function: CompareProductsForReport2
+ * Purpose: Compares two product records for Option 2 report sorting
+ * Parameters: record1 - pointer to first product-customer combined record
+ *            record2 - pointer to second product-customer combined record
+ * Returns: int - comparison result for ProductName + Continent + Country + State + City
+ * Note: Used for "What types of products does the company sell, and where are customers located?"
+ */
+int CompareProductsForReport2(const void* record1, const void* record2) {
+    const productCustomerRecord* pc1 = (const productCustomerRecord*)record1;  // First combined record
+    const productCustomerRecord* pc2 = (const productCustomerRecord*)record2;  // Second combined record
+    int comparisonResult = 0;                          // Result of string comparison (single return pattern)
     
-    // Find peak and low months
-    unsigned long maxOrders = 0;
-    unsigned long minOrders = ULONG_MAX;
-    int peakMonth = 0;
-    int lowMonth = 0;
+    // Compare by Product Name first
+    comparisonResult = strcmp(pc1->product.productName, pc2->product.productName);
     
-    for (int i = 0; i < dataCount; i++) {
-        if (monthlyData[i].orderCount > maxOrders) {
-            maxOrders = monthlyData[i].orderCount;
-            peakMonth = i;
-        }
-        if (monthlyData[i].orderCount < minOrders) {
-            minOrders = monthlyData[i].orderCount;
-            lowMonth = i;
+    // If Product Names are equal, compare by Continent
+    if (comparisonResult == 0) {
+        comparisonResult = strcmp(pc1->continent, pc2->continent);
+        
+        // If Continents are equal, compare by Country
+        if (comparisonResult == 0) {
+            comparisonResult = strcmp(pc1->country, pc2->country);
+            
+            // If Countries are equal, compare by State
+            if (comparisonResult == 0) {
+                comparisonResult = strcmp(pc1->state, pc2->state);
+                
+                // If States are equal, compare by City
+                if (comparisonResult == 0) {
+                    comparisonResult = strcmp(pc1->customer.city, pc2->customer.city);
+                }
+            }
         }
     }
     
-    double variability = 0.0;
-    if (minOrders > 0) {
-        variability = ((double)maxOrders - (double)minOrders) / (double)minOrders * 100.0;
-    }
+    return comparisonResult;                           // Single return point
+}//end function definition CompareProductsForReport2
+
+/*
+ * Function: CompareSalesForReport5
+ * Purpose: Compares two sales records for Option 5 report sorting
+ * Parameters: record1 - pointer to first sales-customer combined record
+ *            record2 - pointer to second sales-customer combined record
+ * Returns: int - comparison result for Customer Name + Order Date + ProductKey
+ * Note: Used for "List of sales order by Customer Name + Order Date + ProductKey"
+ */
+int CompareSalesForReport5(const void* record1, const void* record2) {
+    const salesCustomerRecord* sc1 = (const salesCustomerRecord*)record1;     // First combined record
+    const salesCustomerRecord* sc2 = (const salesCustomerRecord*)record2;     // Second combined record
+    int comparisonResult = 0;                          // Result of comparison (single return pattern)
     
-    WriteToReport(txtFile, "\n1. PRODUCTION PLANNING:\n");
-    WriteToReport(txtFile, "   Peak Period: %04u-%02u (%lu orders)\n",
-           monthlyData[peakMonth].year, monthlyData[peakMonth].month, maxOrders);
-    WriteToReport(txtFile, "   Low Period: %04u-%02u (%lu orders)\n",
-           monthlyData[lowMonth].year, monthlyData[lowMonth].month, minOrders);
-    WriteToReport(txtFile, "   Seasonality: %.1f%% variance\n", variability);
+    // Compare by Customer Name first
+    comparisonResult = strcmp(sc1->customer.name, sc2->customer.name);
     
-    if (variability > 50.0) {
-        WriteToReport(txtFile, "   \u26A0 HIGH SEASONALITY - Recommendations:\n");
-        WriteToReport(txtFile, "     - Increase production capacity 2-3 months before peak\n");
-        WriteToReport(txtFile, "     - Consider flexible workforce (seasonal hiring)\n");
-        WriteToReport(txtFile, "     - Build inventory buffer during low periods\n");
-    } else if (variability > 20.0) {
-        WriteToReport(txtFile, "   \u2192 MODERATE SEASONALITY - Recommendations:\n");
-        WriteToReport(txtFile, "     - Adjust production schedules for peak periods\n");
-        WriteToReport(txtFile, "     - Maintain stable workforce with overtime capability\n");
-    } else {
-        WriteToReport(txtFile, "   \u2713 LOW SEASONALITY - Recommendations:\n");
-        WriteToReport(txtFile, "     - Maintain steady production levels\n");
-        WriteToReport(txtFile, "     - Focus on just-in-time inventory management\n");
-    }
-    
-    WriteToReport(txtFile, "\n2. INVENTORY MANAGEMENT:\n");
-    if (variability > 50.0) {
-        WriteToReport(txtFile, "   \u26A0 Critical Actions:\n");
-        WriteToReport(txtFile, "     - Stock up 60-90 days before peak season\n");
-        WriteToReport(txtFile, "     - Negotiate flexible supplier agreements\n");
-        WriteToReport(txtFile, "     - Implement demand forecasting system\n");
-        WriteToReport(txtFile, "     - Reserve warehouse space for seasonal buildup\n");
-    } else {
-        WriteToReport(txtFile, "   \u2713 Standard Actions:\n");
-        WriteToReport(txtFile, "     - Maintain 30-day safety stock\n");
-        WriteToReport(txtFile, "     - Regular supplier orders with lead time buffer\n");
-    }
-    
-    WriteToReport(txtFile, "\n3. LOGISTICS & DISTRIBUTION:\n");
-    WriteToReport(txtFile, "   - Pre-negotiate carrier capacity for peak months\n");
-    WriteToReport(txtFile, "   - Consider regional distribution centers\n");
-    WriteToReport(txtFile, "   - Plan delivery schedules to avoid peak congestion\n");
-    if (variability > 30.0) {
-        WriteToReport(txtFile, "   - Arrange backup shipping options for peak periods\n");
-        WriteToReport(txtFile, "   - Hire additional logistics staff seasonally\n");
+    // If Customer Names are equal, compare by Order Date
+    if (comparisonResult == 0) {
+        comparisonResult = sc1->sale.orderDay - sc2->sale.orderDay;
+        
+        // If Order Dates are equal, compare by ProductKey
+        if (comparisonResult == 0) {
+            comparisonResult = (int)sc1->sale.productKey - (int)sc2->sale.productKey;
+        }
     }
     
-    WriteToReport(txtFile, "\n4. MARKETING & SALES:\n");
-    WriteToReport(txtFile, "   - Launch promotional campaigns during low periods\n");
-    WriteToReport(txtFile, "   - Offer pre-order discounts before peak season\n");
-    WriteToReport(txtFile, "   - Create off-season incentives to balance demand\n");
-    WriteToReport(txtFile, "   - Target regional markets based on their peak seasons\n");
+    return comparisonResult;                           // Single return point
+}//end function definition CompareSalesForReport5
+
+/*
+ * Function: CompareSalesForSeasonalAnalysis
+ * Purpose: Compares two sales records for seasonal pattern analysis (Option 3)
+ * Parameters: record1 - pointer to first sales record
+ *            record2 - pointer to second sales record
+ * Returns: int - comparison result for Order Date (chronological order)
+ * Note: Used for "Are there any seasonal patterns or trends for order volume or revenue?"
+ */
+int CompareSalesForSeasonalAnalysis(const void* record1, const void* record2) {
+    const salesRecord* sale1 = (const salesRecord*)record1;                   // First sales record
+    const salesRecord* sale2 = (const salesRecord*)record2;                   // Second sales record
     
-    WriteToReport(txtFile, "\n5. FINANCIAL PLANNING:\n");
-    WriteToReport(txtFile, "   - Budget for seasonal working capital needs\n");
-    WriteToReport(txtFile, "   - Plan cash flow for inventory buildup\n");
-    WriteToReport(txtFile, "   - Negotiate payment terms aligned with seasonal cash flow\n");
-    if (variability > 40.0) {
-        WriteToReport(txtFile, "   - Consider seasonal credit line for peak period\n");
-    }
+    // Compare by Order Date for chronological analysis
+    return sale1->orderDay - sale2->orderDay;
+}//end function definition CompareSalesForSeasonalAnalysis
+
+/*
+ * Function: CompareSalesForDeliveryAnalysis
+ * Purpose: Compares two sales records for delivery time analysis (Option 4)
+ * Parameters: record1 - pointer to first sales record
+ *            record2 - pointer to second sales record
+ * Returns: int - comparison result for Order Date (chronological order)
+ * Note: Used for "How long is the average delivery time in days? Has that changed over time?"
+ */
+int CompareSalesForDeliveryAnalysis(const void* record1, const void* record2) {
+    const salesRecord* sale1 = (const salesRecord*)record1;                   // First sales record
+    const salesRecord* sale2 = (const salesRecord*)record2;                   // Second sales record
     
-    WriteToReport(txtFile, "\n6. STAFFING RECOMMENDATIONS:\n");
-    WriteToReport(txtFile, "   Core Staff: Maintain year-round for %lu orders/month\n", minOrders);
-    if (maxOrders > minOrders * 1.5) {
-        WriteToReport(txtFile, "   Seasonal Staff: Add %.0f%% capacity for peak\n", 
-               ((double)maxOrders / minOrders - 1.0) * 100.0);
-        WriteToReport(txtFile, "   Training: Begin 6-8 weeks before peak season\n");
-    }
-}//end function definition GenerateBusinessRecommendations
+    // Compare by Order Date for delivery time analysis over time
+    return sale1->orderDay - sale2->orderDay;
+}//end function definition CompareSalesForDeliveryAnalysis
 
 /*
- * Function: GenerateReport3SeasonalPatterns
- * Purpose: Generates Report 3 - Seasonal Patterns Analysis
- * Parameters: sortType - "Bubble" or "Merge" to specify sorting algorithm
- * Returns: void
- * Note: Aggregates sales by month, shows trends with ASCII charts
- *       Displays both order volume and revenue patterns
- *       Uses file-based processing throughout
+ * Function: CompareMonthlySalesData
+ * Purpose: Compares two monthlySalesData records for chronological sorting
+ * Parameters: record1 - pointer to first monthlySalesData
+ *            record2 - pointer to second monthlySalesData
+ * Returns: int - comparison result for Year + Month
+ * Note: Used for sorting monthly aggregated data chronologically
  */
-void GenerateReport3SeasonalPatterns(const char* sortType) {
-    FILE* sortedFile = NULL;                           // Sorted monthly data file
-    FILE* txtFile = NULL;                              // Output text report file
-    char tempFileName[300] = {0};                      // Temporary aggregated data file
-    char sortedFileName[300] = {0};                    // Sorted data file
-    char txtFileName[300] = {0};                       // Text report file name
-    char reportTitle[150] = {0};                       // Report title
-    monthlySalesData currentMonth;                     // Current month data
-    monthlySalesData allMonthsData[100];               // Array to store all months for charts
-    int monthsAggregated = 0;                          // Number of months aggregated
-    int monthsSorted = 0;                              // Number of months sorted
-    int monthsRead = 0;                                // Number of months read for display
-    unsigned long totalOrders = 0;                     // Total orders across all months
-    double totalRevenue = 0.0;                         // Total revenue across all months
-    double avgOrdersPerMonth = 0.0;                    // Average orders per month
-    double avgRevenuePerMonth = 0.0;                   // Average revenue per month
-    time_t startTime = 0;                              // Report generation start time
-    time_t sortStartTime = 0;                          // Sorting start time
-    time_t sortEndTime = 0;                            // Sorting end time
-    int errorOccurred = 0;                             // Error flag
-    int sortTypeValid = 0;                             // Sort type validation flag
+int CompareMonthlySalesData(const void* record1, const void* record2) {
+    const monthlySalesData* data1 = (const monthlySalesData*)record1;
+    const monthlySalesData* data2 = (const monthlySalesData*)record2;
+    int result = 0;
     
-    printf("\nGenerating Report 3: Seasonal Patterns and Trends\n");
-    printf("Using %s sort algorithm...\n", sortType);
+    // Compare by year first
+    result = (int)data1->year - (int)data2->year;
     
-    time(&startTime);
+    // If years equal, compare by month
+    if (result == 0) {
+        result = (int)data1->month - (int)data2->month;
+    }
     
-    // Generate filenames
-    sprintf(tempFileName, "temp_monthly_%ld.dat", (long)time(NULL));
-    sprintf(txtFileName, "Report_3_Seasonal_%s_%ld.txt", sortType, (long)time(NULL));
+    return result;
+}//end function definition CompareMonthlySalesData
+
+/*
+ * Function: CompareStoresByCountry
+ * Purpose: Compares two store records by country name for sorting
+ * Parameters: record1 - pointer to first store record
+ *            record2 - pointer to second store record
+ * Returns: int - comparison result for country names
+ * Note: Used for sorting stores alphabetically by country
+ */
+int CompareStoresByCountry(const void* record1, const void* record2) {
+    const storeRecord* store1 = (const storeRecord*)record1;       // First store record
+    const storeRecord* store2 = (const storeRecord*)record2;       // Second store record
     
-    // Open text file for report output
-    txtFile = OpenFileWithErrorCheck(txtFileName, "w");
-    if (txtFile == NULL) {
-        printf("Error: Cannot create report text file\n");
-        return;
-    }
+    // Compare by country name
+    return strcmp(store1->country, store2->country);
+}//end function definition CompareStoresByCountry
+
+/*
+ * Function: CompareSalesByProductKey
+ * Purpose: Comparison function for sorting/searching sales by productKey
+ * Parameters: record1 - pointer to first sales record (or search key)
+ *            record2 - pointer to second sales record
+ * Returns: int - negative if key1 < key2, 0 if equal, positive if key1 > key2
+ * Note: Used for binary search on sorted sales data by productKey
+ */
+int CompareSalesByProductKey(const void* record1, const void* record2) {
+    const salesRecord* sale1 = (const salesRecord*)record1;       // First sales record
+    const salesRecord* sale2 = (const salesRecord*)record2;       // Second sales record
     
-    // Aggregate sales by month
-    monthsAggregated = AggregateSalesByMonth(tempFileName);
-    if (monthsAggregated <= 0) {
-        printf("Error: Failed to aggregate sales data\n");
-        errorOccurred = 1;
+    if (sale1->productKey < sale2->productKey) {
+        return -1;
+    } else if (sale1->productKey > sale2->productKey) {
+        return 1;
+    } else {
+        return 0;
     }
+}//end function definition CompareSalesByProductKey
+
+// ====================== SORT KEY NORMALIZATION ======================
+#define RADIX_SORT_SMALL_BUCKET 32                      // Buckets this small use insertion sort
+
+static size_t activeNormalizedKeySize = 0;            // Key length compared by CompareNormalizedKeys
+
+/*
+ * Function: InitializeSortKeySpec
+ * Purpose: Resets a sort specification to zero columns
+ * Parameters: spec - specification to reset
+ * Returns: void
+ */
+void InitializeSortKeySpec(sortKeySpec* spec) {
+    InitializeStructureToZero(spec, sizeof(sortKeySpec));
+}//end function definition InitializeSortKeySpec
+
+/*
+ * Function: AddSortKeyColumn
+ * Purpose: Appends a column to a sort specification
+ * Parameters: spec - specification to extend
+ *            columnType - SORT_COLUMN_STRING, SORT_COLUMN_DATE, SORT_COLUMN_UNSIGNED or SORT_COLUMN_DAY_NUMBER
+ *            fieldOffset - offset of the field in the record (offsetof)
+ *            fieldWidth - size of the field in the record (sizeof)
+ *            descending - 1 for descending order, 0 for ascending
+ * Returns: int - 1 if added, 0 if the spec is full or the column is invalid
+ * Note: Strings keep their full width; dates and day numbers take 4 bytes; integers keep their width
+ */
+int AddSortKeyColumn(sortKeySpec* spec, int columnType, size_t fieldOffset, size_t fieldWidth, int descending) {
+    sortKeyColumn* column = NULL;                      // Column being added
+    size_t encodedWidth = 0;                           // Width in normalized key
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    if (errorOccurred == 0) {
-        // Generate sorted filename
-        GenerateSortedFileName("Seasonal", sortType, sortedFileName);
-        
-        printf("Sorting monthly data using %s sort...\n", sortType);
-        time(&sortStartTime);
-        
-        // Sort monthly data chronologically
-        if (strcmp(sortType, "Bubble") == 0) {
-            sortTypeValid = 1;
-            monthsSorted = SortBubble(tempFileName, sortedFileName,
-                                     sizeof(monthlySalesData), CompareMonthlySalesData);
-        } else if (strcmp(sortType, "Merge") == 0) {
-            sortTypeValid = 1;
-            monthsSorted = SortMerge(tempFileName, sortedFileName,
-                                    sizeof(monthlySalesData), CompareMonthlySalesData);
+    if (columnType == SORT_COLUMN_STRING) {
+        encodedWidth = fieldWidth;
+    } else if (columnType == SORT_COLUMN_DATE && fieldWidth == sizeof(dateStructure)) {
+        encodedWidth = 4;
+    } else if (columnType == SORT_COLUMN_DAY_NUMBER && fieldWidth == sizeof(int)) {
+        encodedWidth = 4;
+    } else if (columnType == SORT_COLUMN_UNSIGNED &&
+               (fieldWidth == 1 || fieldWidth == 2 || fieldWidth == 4 || fieldWidth == 8)) {
+        encodedWidth = fieldWidth;
+    }
+    
+    if (encodedWidth > 0 && spec->columnCount < SORT_KEY_MAX_COLUMNS) {
+        column = &spec->columns[spec->columnCount];
+        column->columnType = columnType;
+        column->fieldOffset = fieldOffset;
+        column->fieldWidth = fieldWidth;
+        column->encodedWidth = encodedWidth;
+        column->descending = descending;
+        spec->columnCount++;
+        spec->keySize += encodedWidth;
+        returnValue = 1;
+    }
+    
+    return returnValue;
+}//end function definition AddSortKeyColumn
+
+/*
+ * Function: NormalizeSortKey
+ * Purpose: Encodes the sort columns of a record into one byte-comparable key
+ * Parameters: spec - sort specification
+ *            record - record to encode
+ *            key - output buffer of spec->keySize bytes
+ * Returns: void
+ * Note: Strings are copied up to their terminator and zero padded, which makes memcmp
+ *       order them exactly like strcmp. Dates become year (2 bytes) month day, day
+ *       numbers have their sign bit flipped so negative days sort first, and
+ *       integers are written most significant byte first. Descending columns have
+ *       every byte inverted.
+ */
+void NormalizeSortKey(const sortKeySpec* spec, const void* record, unsigned char* key) {
+    const unsigned char* field = NULL;                 // Current field in record
+    const sortKeyColumn* column = NULL;                // Current column
+    const dateStructure* date = NULL;                  // Date field
+    unsigned long long integerValue = 0;               // Integer field value
+    unsigned char byteValue = 0;                       // 1-byte integer field
+    unsigned short shortValue = 0;                     // 2-byte integer field
+    unsigned int intValue = 0;                         // 4-byte integer field
+    int dayNumber = 0;                                 // Day number field
+    size_t position = 0;                               // Write position in key
+    size_t length = 0;                                 // String length inside field
+    
+    for (int c = 0; c < spec->columnCount; c++) {
+        column = &spec->columns[c];
+        field = (const unsigned char*)record + column->fieldOffset;
+        
+        if (column->columnType == SORT_COLUMN_STRING) {
+            length = 0;
+            while (length < column->fieldWidth && field[length] != '\0') {
+                length++;
+            }
+            memcpy(key + position, field, length);
+            memset(key + position + length, 0, column->fieldWidth - length);
+        } else if (column->columnType == SORT_COLUMN_DATE) {
+            date = (const dateStructure*)field;
+            key[position] = (unsigned char)(date->yearValue >> 8);
+            key[position + 1] = (unsigned char)(date->yearValue & 0xFF);
+            key[position + 2] = date->monthOfYear;
+            key[position + 3] = date->dayOfMonth;
+        } else if (column->columnType == SORT_COLUMN_DAY_NUMBER) {
+            memcpy(&dayNumber, field, sizeof(int));
+            intValue = (unsigned int)dayNumber ^ 0x80000000u;
+            key[position] = (unsigned char)(intValue >> 24);
+            key[position + 1] = (unsigned char)(intValue >> 16);
+            key[position + 2] = (unsigned char)(intValue >> 8);
+            key[position + 3] = (unsigned char)(intValue & 0xFF);
         } else {
-            printf("Error: Invalid sort type '%s'\n", sortType);
-            sortTypeValid = 0;
-            errorOccurred = 1;
+            if (column->fieldWidth == 1) {
+                memcpy(&byteValue, field, 1);
+                integerValue = byteValue;
+            } else if (column->fieldWidth == 2) {
+                memcpy(&shortValue, field, 2);
+                integerValue = shortValue;
+            } else if (column->fieldWidth == 4) {
+                memcpy(&intValue, field, 4);
+                integerValue = intValue;
+            } else {
+                memcpy(&integerValue, field, 8);
+            }
+            for (size_t b = 0; b < column->encodedWidth; b++) {
+                key[position + b] = (unsigned char)(integerValue >> (8 * (column->encodedWidth - 1 - b)));
+            }
         }
         
-        if (sortTypeValid == 1 && monthsSorted <= 0) {
-            printf("Error: Sorting failed\n");
-            errorOccurred = 1;
+        if (column->descending == 1) {
+            for (size_t b = 0; b < column->encodedWidth; b++) {
+                key[position + b] = (unsigned char)~key[position + b];
+            }
+        }
+        position += column->encodedWidth;
+    }
+}//end function definition NormalizeSortKey
+
+/*
+ * Function: CompareNormalizedKeys
+ * Purpose: Compares two normalized keys (or tags that start with one)
+ * Parameters: key1 - pointer to first key
+ *            key2 - pointer to second key
+ * Returns: int - memcmp result over the active key length
+ * Note: The key length is set by SortRecordsByNormalizedKey before sorting, since the
+ *       comparison function signature carries no context
+ */
+int CompareNormalizedKeys(const void* key1, const void* key2) {
+    return memcmp(key1, key2, activeNormalizedKeySize);
+}//end function definition CompareNormalizedKeys
+
+/*
+ * Function: RadixSortPointersAtDepth
+ * Purpose: Sorts record pointers by their normalized key bytes from a given depth on
+ * Parameters: order - pointers to sort (sorted in place)
+ *            scratch - work array with room for count pointers
+ *            count - number of pointers
+ *            depth - key byte examined at this level
+ *            compareFunction - comparison used for small buckets
+ * Returns: void
+ * Note: One counting pass distributes the pointers into 256 buckets by key[depth],
+ *       keeping their relative order, then each bucket is sorted on the next byte.
+ *       Buckets of RADIX_SORT_SMALL_BUCKET or fewer records use insertion sort.
+ *       Recursion depth is bounded by the key length.
+ */
+void RadixSortPointersAtDepth(const unsigned char** order, const unsigned char** scratch, long count,
+                              size_t depth, int (*compareFunction)(const void*, const void*)) {
+    long bucketStart[257];                             // Start of each bucket (prefix sums)
+    long bucketFill[256];                              // Next free slot of each bucket
+    const unsigned char* current = NULL;               // Pointer being inserted
+    long insertAt = 0;                                 // Insertion sort position
+    long long comparisons = 0;                         // Comparator invocations
+    
+    if (count <= RADIX_SORT_SMALL_BUCKET) {
+        // Small bucket: stable insertion sort on the full key
+        for (long i = 1; i < count; i++) {
+            current = order[i];
+            insertAt = i;
+            while (insertAt > 0 && compareFunction(current, order[insertAt - 1]) < 0) {
+                order[insertAt] = order[insertAt - 1];
+                insertAt--;
+            }
+            order[insertAt] = current;
+            comparisons += (i - insertAt) + (insertAt > 0);
+        }
+        CountComparisons(comparisons);
+    } else if (depth < activeNormalizedKeySize) {
+        memset(bucketStart, 0, sizeof(bucketStart));
+        for (long i = 0; i < count; i++) {
+            bucketStart[order[i][depth] + 1]++;
+        }
+        for (int b = 0; b < 256; b++) {
+            bucketStart[b + 1] += bucketStart[b];
+            bucketFill[b] = bucketStart[b];
+        }
+        for (long i = 0; i < count; i++) {
+            scratch[bucketFill[order[i][depth]]++] = order[i];
         }
+        memcpy(order, scratch, (size_t)count * sizeof(const unsigned char*));
         
-        if (sortTypeValid == 1 && monthsSorted > 0) {
-            time(&sortEndTime);
-            printf("Sorting completed: %d months sorted in %.0f seconds\n",
-                   monthsSorted, difftime(sortEndTime, sortStartTime));
+        for (int b = 0; b < 256; b++) {
+            if (bucketStart[b + 1] - bucketStart[b] > 1) {
+                RadixSortPointersAtDepth(order + bucketStart[b], scratch + bucketStart[b],
+                                         bucketStart[b + 1] - bucketStart[b], depth + 1, compareFunction);
+            }
         }
     }
+}//end function definition RadixSortPointersAtDepth
+
+/*
+ * Function: RadixSortRecordPointers
+ * Purpose: Stable MSD radix sort of record pointers by their leading normalized key
+ * Parameters: order - pointers to sort; holds the sorted order on return
+ *            scratch - work array with room for count pointers
+ *            count - number of pointers
+ *            compareFunction - comparison used for small buckets (CompareNormalizedKeys)
+ * Returns: void
+ * Note: Same signature as SortRecordPointers so it can sort the runs of ExternalMergeSort
+ */
+void RadixSortRecordPointers(const unsigned char** order, const unsigned char** scratch, long count,
+                             int (*compareFunction)(const void*, const void*)) {
+    RadixSortPointersAtDepth(order, scratch, count, 0, compareFunction);
+}//end function definition RadixSortRecordPointers
+
+/*
+ * Function: ParallelRadixSortRecordPointers
+ * Purpose: Run sorter for SortRadix - parallel sort with RadixSortRecordPointers per chunk
+ * Parameters: order - pointers to sort; holds the sorted order on return
+ *            scratch - work array with room for count pointers
+ *            count - number of pointers
+ *            compareFunction - comparison used for small buckets and the merge rounds
+ * Returns: void
+ */
+void ParallelRadixSortRecordPointers(const unsigned char** order, const unsigned char** scratch, long count,
+                                     int (*compareFunction)(const void*, const void*)) {
+    ParallelSortRecordPointers(order, scratch, count, compareFunction, RadixSortRecordPointers);
+}//end function definition ParallelRadixSortRecordPointers
+
+/*
+ * Function: BuildReport2SortKeySpec
+ * Purpose: Sort specification for Report 2 (ProductName + Continent + Country + State + City)
+ * Parameters: spec - specification to fill
+ * Returns: void
+ * Note: Same ordering as CompareProductsForReport2
+ */
+void BuildReport2SortKeySpec(sortKeySpec* spec) {
+    InitializeSortKeySpec(spec);
+    AddSortKeyColumn(spec, SORT_COLUMN_STRING, offsetof(productCustomerRecord, product.productName),
+                     sizeof(((productCustomerRecord*)0)->product.productName), 0);
+    AddSortKeyColumn(spec, SORT_COLUMN_STRING, offsetof(productCustomerRecord, continent),
+                     sizeof(((productCustomerRecord*)0)->continent), 0);
+    AddSortKeyColumn(spec, SORT_COLUMN_STRING, offsetof(productCustomerRecord, country),
+                     sizeof(((productCustomerRecord*)0)->country), 0);
+    AddSortKeyColumn(spec, SORT_COLUMN_STRING, offsetof(productCustomerRecord, state),
+                     sizeof(((productCustomerRecord*)0)->state), 0);
+    AddSortKeyColumn(spec, SORT_COLUMN_STRING, offsetof(productCustomerRecord, customer.city),
+                     sizeof(((productCustomerRecord*)0)->customer.city), 0);
+}//end function definition BuildReport2SortKeySpec
+
+/*
+ * Function: BuildReport5SortKeySpec
+ * Purpose: Sort specification for Report 5 (Customer Name + Order Date + ProductKey)
+ * Parameters: spec - specification to fill
+ * Returns: void
+ * Note: Same ordering as CompareSalesForReport5
+ */
+void BuildReport5SortKeySpec(sortKeySpec* spec) {
+    InitializeSortKeySpec(spec);
+    AddSortKeyColumn(spec, SORT_COLUMN_STRING, offsetof(salesCustomerRecord, customer.name),
+                     sizeof(((salesCustomerRecord*)0)->customer.name), 0);
+    AddSortKeyColumn(spec, SORT_COLUMN_DAY_NUMBER, offsetof(salesCustomerRecord, sale.orderDay),
+                     sizeof(int), 0);
+    AddSortKeyColumn(spec, SORT_COLUMN_UNSIGNED, offsetof(salesCustomerRecord, sale.productKey),
+                     sizeof(((salesCustomerRecord*)0)->sale.productKey), 0);
+}//end function definition BuildReport5SortKeySpec
+
+/*
+ * Function: BuildMonthlySalesSortKeySpec
+ * Purpose: Sort specification for Report 3 monthly data (Year + Month)
+ * Parameters: spec - specification to fill
+ * Returns: void
+ * Note: Same ordering as CompareMonthlySalesData
+ */
+void BuildMonthlySalesSortKeySpec(sortKeySpec* spec) {
+    InitializeSortKeySpec(spec);
+    AddSortKeyColumn(spec, SORT_COLUMN_UNSIGNED, offsetof(monthlySalesData, year),
+                     sizeof(((monthlySalesData*)0)->year), 0);
+    AddSortKeyColumn(spec, SORT_COLUMN_UNSIGNED, offsetof(monthlySalesData, month),
+                     sizeof(((monthlySalesData*)0)->month), 0);
+}//end function definition BuildMonthlySalesSortKeySpec
+
+/*
+ * Function: BuildMonthlyDeliverySortKeySpec
+ * Purpose: Sort specification for Report 4 monthly data (Year + Month)
+ * Parameters: spec - specification to fill
+ * Returns: void
+ * Note: Same ordering as CompareMonthlyDeliveryData
+ */
+void BuildMonthlyDeliverySortKeySpec(sortKeySpec* spec) {
+    InitializeSortKeySpec(spec);
+    AddSortKeyColumn(spec, SORT_COLUMN_UNSIGNED, offsetof(monthlyDeliveryData, year),
+                     sizeof(((monthlyDeliveryData*)0)->year), 0);
+    AddSortKeyColumn(spec, SORT_COLUMN_UNSIGNED, offsetof(monthlyDeliveryData, month),
+                     sizeof(((monthlyDeliveryData*)0)->month), 0);
+}//end function definition BuildMonthlyDeliverySortKeySpec
+
+/*
+ * Function: MonthlyDataInDateOrder
+ * Purpose: Tells whether the monthly aggregates already come out in chronological order
+ * Parameters: none
+ * Returns: int - 1 if the month sort of Reports 3 and 4 can be skipped, 0 otherwise
+ * Note: The shared sales scan adds months in the order it first meets them, so when the
+ *       SalesTable.dat header records orderDay as ascending the months are already
+ *       sorted by year and month
+ */
+int MonthlyDataInDateOrder(void) {
+    return TableColumnIsSorted(BINARY_TABLE_SALES, offsetof(salesRecord, orderDay));
+}//end function definition MonthlyDataInDateOrder
+
+/*
+ * Function: KeepMonthlyDataOrder
+ * Purpose: Uses an aggregated monthly data file as its sorted file without sorting it
+ * Parameters: inputFileName - monthly data in scan order (renamed)
+ *            outputFileName - sorted file name the report reads
+ *            monthCount - months in the file
+ * Returns: int - monthCount, -1 on error
+ */
+int KeepMonthlyDataOrder(const char* inputFileName, const char* outputFileName, int monthCount) {
+    int returnValue = -1;                              // Return value (single return pattern)
     
-    // Clean up temporary file
-    remove(tempFileName);
+    remove(outputFileName);
+    if (rename(inputFileName, outputFileName) == 0) {
+        printf("SalesTable.dat is in order date order, months already chronological; sort skipped\n");
+        returnValue = monthCount;
+    }
     
-    if (errorOccurred == 0) {
-        // Generate report header
-        sprintf(reportTitle, "Report 3: Seasonal Patterns and Trends for Order Volume and Revenue");
-        GenerateReportHeader(txtFile, reportTitle);
-        
-        // Open sorted file and read data
-        sortedFile = OpenFileWithErrorCheck(sortedFileName, "rb");
-        if (sortedFile == NULL) {
-            printf("Error: Cannot open sorted monthly data file\n");
-            errorOccurred = 1;
-        }
-    }
+    return returnValue;                                // Single return point
+}//end function definition KeepMonthlyDataOrder
+
+// ====================== B+TREE INDEX OPERATIONS ======================
+
+/*
+ * Function: CompareIndexEntries
+ * Purpose: Comparison function ordering bPlusTreeEntry records by key, then by record offset
+ * Parameters: record1 - pointer to first bPlusTreeEntry
+ *            record2 - pointer to second bPlusTreeEntry
+ * Returns: int - negative if record1 < record2, 0 if equal, positive if record1 > record2
+ * Note: Ordering by offset within a key keeps the first record in file order first
+ */
+int CompareIndexEntries(const void* record1, const void* record2) {
+    const bPlusTreeEntry* entry1 = (const bPlusTreeEntry*)record1;  // First entry
+    const bPlusTreeEntry* entry2 = (const bPlusTreeEntry*)record2;  // Second entry
+    int result = 0;                                                 // Comparison result
     
-    if (errorOccurred == 0) {
-        // Read all months and calculate totals
-        WriteToReport(txtFile, "\nMonthly Sales Summary\n");
-        WriteToReport(txtFile, "=====================================================\n");
-        WriteToReport(txtFile, "%-10s %15s %20s\n", "Month", "Orders", "Revenue (USD)");
-        WriteToReport(txtFile, "-----------------------------------------------------\n");
-        
-        monthsRead = 0;
-        while (fread(&currentMonth, sizeof(monthlySalesData), 1, sortedFile) == 1 && monthsRead < 100) {
-            // Display month data
-            WriteToReport(txtFile, "%04u-%02u %15lu %20.2f\n",
-                   currentMonth.year,
-                   currentMonth.month,
-                   currentMonth.orderCount,
-                   currentMonth.totalRevenue);
-            
-            // Store in array for charts
-            allMonthsData[monthsRead] = currentMonth;
-            
-            // Accumulate totals
-            totalOrders += currentMonth.orderCount;
-            totalRevenue += currentMonth.totalRevenue;
-            monthsRead++;
-        }
-        
-        WriteToReport(txtFile, "=====================================================\n");
-        WriteToReport(txtFile, "%-10s %15lu %20.2f\n", "TOTAL", totalOrders, totalRevenue);
-        
-        // Calculate averages
-        if (monthsRead > 0) {
-            avgOrdersPerMonth = (double)totalOrders / (double)monthsRead;
-            avgRevenuePerMonth = totalRevenue / (double)monthsRead;
-            
-            WriteToReport(txtFile, "%-10s %15.2f %20.2f\n", "AVERAGE", avgOrdersPerMonth, avgRevenuePerMonth);
-        }
-        
-        WriteToReport(txtFile, "\nTotal months analyzed: %d\n", monthsRead);
-        
-        // Generate ASCII charts
-        DrawASCIIBarChart(txtFile, allMonthsData, monthsRead, 'O');
-        DrawASCIIBarChart(txtFile, allMonthsData, monthsRead, 'R');
-        
-        // Seasonal analysis
-        WriteToReport(txtFile, "\nSeasonal Analysis\n");
-        WriteToReport(txtFile, "=================\n");
-        
-        // Analyze patterns by grouping months into quarters
-        unsigned long q1Orders = 0, q2Orders = 0, q3Orders = 0, q4Orders = 0;
-        double q1Revenue = 0.0, q2Revenue = 0.0, q3Revenue = 0.0, q4Revenue = 0.0;
-        int q1Count = 0, q2Count = 0, q3Count = 0, q4Count = 0;
-        
-        for (int i = 0; i < monthsRead; i++) {
-            if (allMonthsData[i].month >= 1 && allMonthsData[i].month <= 3) {
-                q1Orders += allMonthsData[i].orderCount;
-                q1Revenue += allMonthsData[i].totalRevenue;
-                q1Count++;
-            } else if (allMonthsData[i].month >= 4 && allMonthsData[i].month <= 6) {
-                q2Orders += allMonthsData[i].orderCount;
-                q2Revenue += allMonthsData[i].totalRevenue;
-                q2Count++;
-            } else if (allMonthsData[i].month >= 7 && allMonthsData[i].month <= 9) {
-                q3Orders += allMonthsData[i].orderCount;
-                q3Revenue += allMonthsData[i].totalRevenue;
-                q3Count++;
-            } else if (allMonthsData[i].month >= 10 && allMonthsData[i].month <= 12) {
-                q4Orders += allMonthsData[i].orderCount;
-                q4Revenue += allMonthsData[i].totalRevenue;
-                q4Count++;
-            }
-        }
-        
-        WriteToReport(txtFile, "\nQuarterly Averages:\n");
-        if (q1Count > 0) {
-            WriteToReport(txtFile, "Q1 (Jan-Mar): %.2f orders/month, $%.2f revenue/month\n",
-                   (double)q1Orders / q1Count, q1Revenue / q1Count);
-        }
-        if (q2Count > 0) {
-            WriteToReport(txtFile, "Q2 (Apr-Jun): %.2f orders/month, $%.2f revenue/month\n",
-                   (double)q2Orders / q2Count, q2Revenue / q2Count);
-        }
-        if (q3Count > 0) {
-            WriteToReport(txtFile, "Q3 (Jul-Sep): %.2f orders/month, $%.2f revenue/month\n",
-                   (double)q3Orders / q3Count, q3Revenue / q3Count);
-        }
-        if (q4Count > 0) {
-            WriteToReport(txtFile, "Q4 (Oct-Dec): %.2f orders/month, $%.2f revenue/month\n",
-                   (double)q4Orders / q4Count, q4Revenue / q4Count);
-        }
-        
-        // Identify peak quarter
-        double maxQuarterRevenue = q1Revenue;
-        const char* peakQuarter = "Q1 (Winter)";
-        if (q2Revenue > maxQuarterRevenue) {
-            maxQuarterRevenue = q2Revenue;
-            peakQuarter = "Q2 (Spring)";
-        }
-        if (q3Revenue > maxQuarterRevenue) {
-            maxQuarterRevenue = q3Revenue;
-            peakQuarter = "Q3 (Summer)";
-        }
-        if (q4Revenue > maxQuarterRevenue) {
-            maxQuarterRevenue = q4Revenue;
-            peakQuarter = "Q4 (Fall)";
-        }
-        
-        WriteToReport(txtFile, "\nPEAK SEASON: %s with total revenue of $%.2f\n", 
-               peakQuarter, maxQuarterRevenue);
-        
-        // Perform advanced analyses
-        GenerateTrendAnalysis(txtFile, allMonthsData, monthsRead);
-        AnalyzeSeasonalPatternsByCategory(txtFile);
-        AnalyzeSeasonalPatternsByRegion(txtFile);
-        GenerateBusinessRecommendations(txtFile, allMonthsData, monthsRead);
-        
-        fclose(sortedFile);
-        
-        GenerateReportFooter(txtFile, startTime);
-        
-        if (txtFile != NULL) {
-            fclose(txtFile);
-            txtFile = NULL;
-        }
-        
-        printf("\nReport saved successfully in: %s\n", txtFileName);
-        
-        // Clean up sorted file
-        remove(sortedFileName);
-    } else {
-        // Error occurred - clean up
-        if (txtFile != NULL) {
-            fclose(txtFile);
-            remove(txtFileName);
-        }
+    if (entry1->key < entry2->key) {
+        result = -1;
+    } else if (entry1->key > entry2->key) {
+        result = 1;
+    } else if (entry1->recordOffset < entry2->recordOffset) {
+        result = -1;
+    } else if (entry1->recordOffset > entry2->recordOffset) {
+        result = 1;
     }
     
-    // No explicit return needed for void function
-}//end function definition GenerateReport3SeasonalPatterns
-
-// ====================== REPORT 4: DELIVERY TIME ANALYSIS ======================
+    return result;
+}//end function definition CompareIndexEntries
 
 /*
- * Function: CalculateDeliveryDays
- * Purpose: Calculates the number of days between order and delivery dates
- * Parameters: orderDate - pointer to order date structure
- *            deliveryDate - pointer to delivery date structure
- * Returns: int - number of days between dates (0 if same day, -1 if invalid)
- * Note: Simple calculation assuming all months have 30 days for consistency
+ * Function: ReadBPlusTreeNode
+ * Purpose: Reads one node page from a B+tree index file
+ * Parameters: indexFile - open index file
+ *            pageNumber - page to read
+ *            node - buffer receiving the node
+ * Returns: int - 1 if successful, 0 on error
  */
-int CalculateDeliveryDays(const dateStructure* orderDate, const dateStructure* deliveryDate) {
-    int orderDays = 0;                                 // Order date in days
-    int deliveryDays = 0;                              // Delivery date in days
-    int difference = 0;                                // Day difference
-    int result = -1;                                   // Return value
+int ReadBPlusTreeNode(FILE* indexFile, long pageNumber, bPlusTreeNode* node) {
+    long pageOffset = (long)sizeof(bPlusTreeHeader) + pageNumber * (long)sizeof(bPlusTreeNode); // Page position
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    if (orderDate != NULL && deliveryDate != NULL) {
-        // Convert dates to days (simplified: year*365 + month*30 + day)
-        orderDays = orderDate->yearValue * 365 + orderDate->monthOfYear * 30 + orderDate->dayOfMonth;
-        deliveryDays = deliveryDate->yearValue * 365 + deliveryDate->monthOfYear * 30 + deliveryDate->dayOfMonth;
-        
-        difference = deliveryDays - orderDays;
-        
-        // Ensure non-negative result
-        if (difference >= 0) {
-            result = difference;
-        } else {
-            result = -1;                               // Invalid (delivery before order)
-        }
+    if (CountedSeek(indexFile, pageOffset, SEEK_SET) == 0 &&
+        CountedRead(node, sizeof(bPlusTreeNode), 1, indexFile) == 1) {
+        returnValue = 1;
     }
     
-    return result;                                     // Single return point
-}//end function definition CalculateDeliveryDays
+    return returnValue;
+}//end function definition ReadBPlusTreeNode
 
 /*
- * Function: CompareMonthlyDeliveryData
- * Purpose: Compares two monthlyDeliveryData records for chronological sorting
- * Parameters: record1 - pointer to first monthlyDeliveryData
- *            record2 - pointer to second monthlyDeliveryData
- * Returns: int - comparison result for Year + Month
- * Note: Used for sorting monthly delivery data chronologically
+ * Function: WriteBPlusTreeNode
+ * Purpose: Writes one node page to a B+tree index file
+ * Parameters: indexFile - open index file
+ *            pageNumber - page to write
+ *            node - node to store
+ * Returns: int - 1 if successful, 0 on error
  */
-int CompareMonthlyDeliveryData(const void* record1, const void* record2) {
-    const monthlyDeliveryData* data1 = (const monthlyDeliveryData*)record1;
-    const monthlyDeliveryData* data2 = (const monthlyDeliveryData*)record2;
-    int result = 0;
-    
-    // Compare by year first
-    result = (int)data1->year - (int)data2->year;
+int WriteBPlusTreeNode(FILE* indexFile, long pageNumber, const bPlusTreeNode* node) {
+    long pageOffset = (long)sizeof(bPlusTreeHeader) + pageNumber * (long)sizeof(bPlusTreeNode); // Page position
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    // If years equal, compare by month
-    if (result == 0) {
-        result = (int)data1->month - (int)data2->month;
+    if (CountedSeek(indexFile, pageOffset, SEEK_SET) == 0 &&
+        CountedWrite(node, sizeof(bPlusTreeNode), 1, indexFile) == 1) {
+        returnValue = 1;
     }
     
-    return result;
-}//end function definition CompareMonthlyDeliveryData
+    return returnValue;
+}//end function definition WriteBPlusTreeNode
 
 /*
- * Function: AggregateDeliveryTimesByMonth
- * Purpose: Aggregates delivery times by month from SalesTable
- * Parameters: outputFileName - name of file to store monthly aggregated data
- * Returns: int - number of months processed, -1 on error
- * Note: Processes sales file line-by-line without loading all data into memory
- *       Calculates delivery time statistics per month
+ * Function: BuildBPlusTreeIndex
+ * Purpose: Builds a persistent B+tree index mapping a key to the record offset in a table file
+ * Parameters: tableFileName - binary table to index (e.g. "CustomersTable.dat")
+ *            indexFileName - index file to create (e.g. "CustomersTable.idx")
+ *            recordSize - size of each table record in bytes
+ *            extractKey - function returning the key of a record
+ * Returns: long - number of distinct keys indexed, -1 on error
+ * Note: Bulk-loads bottom-up: (key, offset) pairs are written to a temporary file,
+ *       sorted with SortMerge, packed into full leaves, then internal levels are
+ *       built from the first key of each page until a single root remains.
+ *       Only one page per level plus the page list of the level being built is in memory.
+ *       For duplicate keys the first record in file order is indexed. When the table
+ *       already holds its keys in ascending order the pairs are used as extracted and
+ *       the sort is skipped. Record offsets count from the first record, after the
+ *       table header.
  */
-int AggregateDeliveryTimesByMonth(const char* outputFileName) {
-    FILE* salesFile = NULL;                            // Sales table file
-    FILE* monthlyFile = NULL;                          // Monthly aggregated data file
-    salesRecord currentSale;                           // Current sales record
-    monthlyDeliveryData monthlyData[100];              // Array for monthly data (max 100 months)
-    int monthCount = 0;                                // Number of unique months
-    int recordsProcessed = 0;                          // Records processed counter
+long BuildBPlusTreeIndex(const char* tableFileName, const char* indexFileName, size_t recordSize,
+                         unsigned int (*extractKey)(const void*)) {
+    FILE* tableFile = NULL;                            // Table being indexed
+    FILE* entriesFile = NULL;                          // Unsorted (key, offset) pairs / sorted pairs
+    FILE* indexFile = NULL;                            // Index file being written
+    char entriesFileName[300] = {0};                   // Temporary unsorted pairs file
+    char sortedFileName[300] = {0};                    // Temporary sorted pairs file
+    unsigned char* recordBuffer = NULL;                // Current table record
+    tableHeader tableInfo;                             // Header of the table being indexed
+    bPlusTreeHeader header;                            // Index file header
+    bPlusTreeNode node;                                // Node page being filled
+    bPlusTreeEntry entry;                              // Current (key, offset) pair
+    unsigned int* levelKeys = NULL;                    // First key of each page in current level
+    long* levelPages = NULL;                           // Page number of each page in current level
+    long levelCount = 0;                               // Pages in current level
+    long nextLevelCount = 0;                           // Pages in level being built
+    long recordCount = 0;                              // Records in table
+    long long recordOffset = 0;                        // Offset of current record
+    unsigned int lastKey = 0;                          // Last key placed in a leaf
+    int haveLastKey = 0;                               // 1 once a key has been placed
+    int keysInOrder = 1;                               // 1 while extracted keys never decrease
+    int childCount = 0;                                // Children of internal node being built
     int errorOccurred = 0;                             // Error flag
-    int returnValue = -1;                              // Return value
-    int deliveryDays = 0;                              // Delivery time in days
+    long returnValue = -1;                             // Return value (single return pattern)
     
-    // Initialize monthly data array
-    for (int i = 0; i < 100; i++) {
-        InitializeStructureToZero(&monthlyData[i], sizeof(monthlyDeliveryData));
-        monthlyData[i].minDeliveryDays = USHRT_MAX;    // Initialize to max value
-    }
+    InitializeStructureToZero(&header, sizeof(bPlusTreeHeader));
+    sprintf(entriesFileName, "temp_index_entries_%ld.dat", (long)time(NULL));
+    sprintf(sortedFileName, "temp_index_sorted_%ld.dat", (long)time(NULL));
     
-    // Open sales file
-    salesFile = OpenFileWithErrorCheck("SalesTable.dat", "rb");
-    if (salesFile == NULL) {
-        printf("Error: Cannot open SalesTable.dat\n");
+    tableFile = OpenBinaryTable(tableFileName, recordSize, &tableInfo);
+    entriesFile = OpenFileWithErrorCheck(entriesFileName, "wb");
+    recordBuffer = (unsigned char*)malloc(recordSize);
+    if (tableFile == NULL || entriesFile == NULL || recordBuffer == NULL) {
         errorOccurred = 1;
-        returnValue = -1;
     }
     
+    // Step 1: Extract (key, offset) pairs in one sequential pass
     if (errorOccurred == 0) {
-        printf("Aggregating delivery times by month...\n");
-        
-        // Process each sales record
-        while (fread(&currentSale, sizeof(salesRecord), 1, salesFile) == 1 && errorOccurred == 0) {
-            recordsProcessed++;
-            
-            // Calculate delivery time
-            deliveryDays = CalculateDeliveryDays(&currentSale.orderDate, &currentSale.deliveryDate);
-            
-            // Only process valid delivery times
-            if (deliveryDays >= 0) {
-                // Find the month index in our array
-                int monthIndex = -1;
-                int foundMonth = 0;
-                
-                for (int i = 0; i < monthCount && foundMonth == 0; i++) {
-                    if (monthlyData[i].year == currentSale.orderDate.yearValue &&
-                        monthlyData[i].month == currentSale.orderDate.monthOfYear) {
-                        monthIndex = i;
-                        foundMonth = 1;
-                    }
-                }
-                
-                // If month not found, create new entry
-                if (foundMonth == 0 && monthCount < 100) {
-                    monthIndex = monthCount;
-                    monthlyData[monthIndex].year = currentSale.orderDate.yearValue;
-                    monthlyData[monthIndex].month = currentSale.orderDate.monthOfYear;
-                    monthlyData[monthIndex].orderCount = 0;
-                    monthlyData[monthIndex].totalDeliveryDays = 0;
-                    monthlyData[monthIndex].minDeliveryDays = USHRT_MAX;
-                    monthlyData[monthIndex].maxDeliveryDays = 0;
-                    monthCount++;
-                }
-                
-                // If we found or created a valid month entry
-                if (monthIndex >= 0 && monthIndex < 100) {
-                    monthlyData[monthIndex].orderCount++;
-                    monthlyData[monthIndex].totalDeliveryDays += deliveryDays;
-                    
-                    // Update min
-                    if (deliveryDays < monthlyData[monthIndex].minDeliveryDays) {
-                        monthlyData[monthIndex].minDeliveryDays = deliveryDays;
-                    }
-                    
-                    // Update max
-                    if (deliveryDays > monthlyData[monthIndex].maxDeliveryDays) {
-                        monthlyData[monthIndex].maxDeliveryDays = deliveryDays;
-                    }
-                }
+        while (recordCount < tableInfo.rowCount && errorOccurred == 0 &&
+               CountedRead(recordBuffer, recordSize, 1, tableFile) == 1) {
+            entry.key = extractKey(recordBuffer);
+            entry.recordOffset = (long)recordOffset;
+            if (recordOffset > LONG_MAX) {
+                printf("Error: %s is too large for a B+tree index (record offsets past 2 GB)\n", tableFileName);
+                errorOccurred = 1;
             }
-        }
-        
-        // Calculate averages
-        for (int i = 0; i < monthCount; i++) {
-            if (monthlyData[i].orderCount > 0) {
-                monthlyData[i].avgDeliveryDays = (double)monthlyData[i].totalDeliveryDays / 
-                                                 (double)monthlyData[i].orderCount;
-                monthlyData[i].avgDeliveryDays = RoundToThirdDecimal(monthlyData[i].avgDeliveryDays);
+            if (recordCount > 0 && entry.key < lastKey) {
+                keysInOrder = 0;
+            }
+            lastKey = entry.key;
+            if (errorOccurred == 0 && CountedWrite(&entry, sizeof(bPlusTreeEntry), 1, entriesFile) != 1) {
+                errorOccurred = 1;
             }
+            recordOffset += (long long)recordSize;
+            recordCount++;
         }
-        
-        printf("Processed %d sales records into %d months\n", recordsProcessed, monthCount);
     }
+    if (tableFile != NULL) fclose(tableFile);
+    if (entriesFile != NULL) fclose(entriesFile);
+    entriesFile = NULL;
+    free(recordBuffer);
     
-    // Close input file
-    if (salesFile != NULL) fclose(salesFile);
-    
-    // Write aggregated data to file
-    if (errorOccurred == 0 && monthCount > 0) {
-        monthlyFile = OpenFileWithErrorCheck(outputFileName, "wb");
-        if (monthlyFile == NULL) {
-            printf("Error: Cannot create monthly delivery data file\n");
+    // Step 2: Sort the pairs by key, unless they were extracted in key order
+    if (errorOccurred == 0 && recordCount > 0 && keysInOrder == 1) {
+        entriesFile = OpenFileWithErrorCheck(entriesFileName, "rb");
+        if (entriesFile == NULL) {
+            errorOccurred = 1;
+        }
+    } else if (errorOccurred == 0 && recordCount > 0) {
+        if (SortMerge(entriesFileName, sortedFileName, sizeof(bPlusTreeEntry), CompareIndexEntries) != recordCount) {
+            printf("Error: Cannot sort index entries for %s\n", indexFileName);
             errorOccurred = 1;
-            returnValue = -1;
         } else {
-            // Write all monthly records
-            for (int i = 0; i < monthCount; i++) {
-                if (fwrite(&monthlyData[i], sizeof(monthlyDeliveryData), 1, monthlyFile) != 1) {
-                    printf("Error: Failed to write monthly delivery record %d\n", i);
-                    errorOccurred = 1;
-                    returnValue = -1;
+            entriesFile = OpenFileWithErrorCheck(sortedFileName, "rb");
+            if (entriesFile == NULL) {
+                errorOccurred = 1;
+            }
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        levelKeys = (unsigned int*)malloc(((size_t)recordCount / BPLUS_TREE_ORDER + 1) * sizeof(unsigned int));
+        levelPages = (long*)malloc(((size_t)recordCount / BPLUS_TREE_ORDER + 1) * sizeof(long));
+        indexFile = OpenFileWithErrorCheck(indexFileName, "wb+");
+        if (levelKeys == NULL || levelPages == NULL || indexFile == NULL) {
+            errorOccurred = 1;
+        } else if (CountedWrite(&header, sizeof(bPlusTreeHeader), 1, indexFile) != 1) {
+            errorOccurred = 1;                         // Placeholder, rewritten at the end
+        }
+    }
+    
+    // Step 3: Pack sorted pairs into full leaves, chained in key order
+    if (errorOccurred == 0) {
+        InitializeStructureToZero(&node, sizeof(bPlusTreeNode));
+        node.isLeaf = 1;
+        node.nextLeaf = -1;
+        
+        while (entriesFile != NULL && errorOccurred == 0 &&
+               CountedRead(&entry, sizeof(bPlusTreeEntry), 1, entriesFile) == 1) {
+            if (haveLastKey == 0 || entry.key != lastKey) {
+                if (node.keyCount == BPLUS_TREE_ORDER) {
+                    node.nextLeaf = header.pageCount + 1;
+                    levelKeys[levelCount] = node.keys[0];
+                    levelPages[levelCount] = header.pageCount;
+                    levelCount++;
+                    if (WriteBPlusTreeNode(indexFile, header.pageCount, &node) == 0) {
+                        errorOccurred = 1;
+                    }
+                    header.pageCount++;
+                    InitializeStructureToZero(&node, sizeof(bPlusTreeNode));
+                    node.isLeaf = 1;
+                    node.nextLeaf = -1;
                 }
+                node.keys[node.keyCount] = entry.key;
+                node.pointers[node.keyCount] = entry.recordOffset;
+                node.keyCount++;
+                header.keyCount++;
+                lastKey = entry.key;
+                haveLastKey = 1;
             }
+        }
+        
+        // Last (possibly empty) leaf
+        levelKeys[levelCount] = node.keys[0];
+        levelPages[levelCount] = header.pageCount;
+        levelCount++;
+        if (WriteBPlusTreeNode(indexFile, header.pageCount, &node) == 0) {
+            errorOccurred = 1;
+        }
+        header.pageCount++;
+        header.treeHeight = 1;
+    }
+    
+    // Step 4: Build internal levels until a single root remains
+    while (errorOccurred == 0 && levelCount > 1) {
+        nextLevelCount = 0;
+        for (long firstChild = 0; firstChild < levelCount && errorOccurred == 0; firstChild += BPLUS_TREE_ORDER + 1) {
+            InitializeStructureToZero(&node, sizeof(bPlusTreeNode));
+            node.isLeaf = 0;
+            node.nextLeaf = -1;
+            childCount = 0;
             
-            fclose(monthlyFile);
+            while (childCount <= BPLUS_TREE_ORDER && firstChild + childCount < levelCount) {
+                node.pointers[childCount] = levelPages[firstChild + childCount];
+                if (childCount > 0) {
+                    node.keys[childCount - 1] = levelKeys[firstChild + childCount];
+                }
+                childCount++;
+            }
+            node.keyCount = childCount - 1;
             
-            if (errorOccurred == 0) {
-                returnValue = monthCount;
+            // Overwrite in place: nextLevelCount never passes firstChild
+            levelKeys[nextLevelCount] = levelKeys[firstChild];
+            levelPages[nextLevelCount] = header.pageCount;
+            nextLevelCount++;
+            if (WriteBPlusTreeNode(indexFile, header.pageCount, &node) == 0) {
+                errorOccurred = 1;
             }
+            header.pageCount++;
         }
+        levelCount = nextLevelCount;
+        header.treeHeight++;
     }
     
-    return returnValue;                                // Single return point
-}//end function definition AggregateDeliveryTimesByMonth
+    // Step 5: Write the final header
+    if (errorOccurred == 0) {
+        header.magic = BPLUS_TREE_MAGIC;
+        header.version = BPLUS_TREE_VERSION;
+        header.order = BPLUS_TREE_ORDER;
+        header.rootPage = levelPages[0];
+        CountedSeek(indexFile, 0, SEEK_SET);
+        if (CountedWrite(&header, sizeof(bPlusTreeHeader), 1, indexFile) == 1) {
+            returnValue = header.keyCount;
+        } else {
+            errorOccurred = 1;
+        }
+    }
+    
+    if (entriesFile != NULL) fclose(entriesFile);
+    if (indexFile != NULL) fclose(indexFile);
+    free(levelKeys);
+    free(levelPages);
+    remove(entriesFileName);
+    remove(sortedFileName);
+    if (errorOccurred == 1) {
+        printf("Error: Cannot build index %s\n", indexFileName);
+        remove(indexFileName);
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition BuildBPlusTreeIndex
 
 /*
- * Function: DrawDeliveryTimeChart
- * Purpose: Generates ASCII bar chart for visualizing delivery times
- * Parameters: txtFile - output file pointer (NULL to write only to console)
- *            monthlyData - array of monthly delivery data
- *            dataCount - number of months in the array
- * Returns: void
- * Note: Creates horizontal bar chart showing average delivery times
+ * Function: OpenBPlusTreeIndex
+ * Purpose: Opens a B+tree index file and validates its header
+ * Parameters: indexFileName - index file to open
+ *            header - receives the index header
+ * Returns: FILE* - open index file, NULL if missing or not a valid index
  */
-void DrawDeliveryTimeChart(FILE* txtFile, const monthlyDeliveryData* monthlyData, int dataCount) {
-    double maxAvg = 0.0;                               // Maximum average delivery time
-    int maxBarLength = 60;                             // Maximum bar length in characters
-    double scaleFactor = 0.0;                          // Scale factor for bars
+FILE* OpenBPlusTreeIndex(const char* indexFileName, bPlusTreeHeader* header) {
+    FILE* indexFile = NULL;                            // Index file (single return pattern)
     
-    if (dataCount <= 0) {
-        WriteToReport(txtFile, "No data to display\n");
-        return;
+    indexFile = OpenFileWithErrorCheck(indexFileName, "rb");
+    if (indexFile != NULL) {
+        if (CountedRead(header, sizeof(bPlusTreeHeader), 1, indexFile) != 1 ||
+            header->magic != BPLUS_TREE_MAGIC || header->version != BPLUS_TREE_VERSION ||
+            header->order != BPLUS_TREE_ORDER) {
+            printf("Error: %s is not a valid index file\n", indexFileName);
+            fclose(indexFile);
+            indexFile = NULL;
+        }
     }
     
-    // Find maximum value for scaling
-    for (int i = 0; i < dataCount; i++) {
-        if (monthlyData[i].avgDeliveryDays > maxAvg) {
-            maxAvg = monthlyData[i].avgDeliveryDays;
+    return indexFile;
+}//end function definition OpenBPlusTreeIndex
+
+/*
+ * Function: SearchBPlusTreeIndex
+ * Purpose: Looks up a key in a B+tree index
+ * Parameters: indexFile - index opened with OpenBPlusTreeIndex
+ *            header - header returned by OpenBPlusTreeIndex
+ *            searchKey - key to find
+ * Returns: long - byte offset of the record after the table header, -1 if not found or on error
+ * Note: Reads exactly treeHeight pages (O(log n)); binary search within each page
+ */
+long SearchBPlusTreeIndex(FILE* indexFile, const bPlusTreeHeader* header, unsigned int searchKey) {
+    bPlusTreeNode node;                                // Current node page
+    long pageNumber = header->rootPage;                // Page being visited
+    int low = 0;                                       // Binary search lower bound
+    int high = 0;                                      // Binary search upper bound
+    int middle = 0;                                    // Binary search midpoint
+    int continueDescending = 1;                        // Loop control flag
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    while (continueDescending == 1) {
+        if (ReadBPlusTreeNode(indexFile, pageNumber, &node) == 0) {
+            continueDescending = 0;
+        } else if (node.isLeaf == 0) {
+            // Child index = number of separator keys <= searchKey
+            low = 0;
+            high = node.keyCount;
+            while (low < high) {
+                middle = (low + high) / 2;
+                if (node.keys[middle] <= searchKey) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            pageNumber = node.pointers[low];
+        } else {
+            // Exact match within the leaf
+            low = 0;
+            high = node.keyCount - 1;
+            while (low <= high && returnValue == -1) {
+                middle = (low + high) / 2;
+                if (node.keys[middle] == searchKey) {
+                    returnValue = node.pointers[middle];
+                } else if (node.keys[middle] < searchKey) {
+                    low = middle + 1;
+                } else {
+                    high = middle - 1;
+                }
+            }
+            continueDescending = 0;
         }
     }
     
-    // Calculate scale factor
-    scaleFactor = (maxAvg > 0.0) ? (double)maxBarLength / maxAvg : 0.0;
+    return returnValue;                                // Single return point
+}//end function definition SearchBPlusTreeIndex
+
+/*
+ * Function: InsertBPlusTreeKey
+ * Purpose: Adds one key to an existing B+tree index
+ * Parameters: indexFile - index file opened for update ("rb+")
+ *            header - header of the index, updated in memory (caller writes it back)
+ *            key - key to insert
+ *            recordOffset - byte offset of the record after the table header
+ * Returns: int - 1 if the key was inserted, 0 if it was already indexed, -1 on error
+ * Note: Descends once from the root, remembering the path. A full node is split in two
+ *       halves; the new right page is appended after the last page and its first key is
+ *       inserted into the parent, which may split in turn. A root split adds a level.
+ *       As in BuildBPlusTreeIndex the first record with a key keeps the index entry.
+ */
+int InsertBPlusTreeKey(FILE* indexFile, bPlusTreeHeader* header, unsigned int key, long recordOffset) {
+    bPlusTreeNode node;                                // Node being updated
+    bPlusTreeNode sibling;                             // Right half of a split node
+    long pathPages[BPLUS_TREE_MAX_HEIGHT];             // Page visited at each level, root first
+    unsigned int mergedKeys[BPLUS_TREE_ORDER + 1];     // Keys of the node with the new entry
+    long mergedPointers[BPLUS_TREE_ORDER + 2];         // Pointers of the node with the new entry
+    long pageNumber = header->rootPage;                // Page being visited
+    long newChildPage = -1;                            // Right page created by the split one level down
+    unsigned int separatorKey = 0;                     // Lowest key reachable through newChildPage
+    long nextLeaf = -1;                                // Leaf chain link of the split leaf
+    int mergedCount = 0;                               // Keys in mergedKeys
+    int leftCount = 0;                                 // Keys kept in the left half of a split
+    int position = 0;                                  // Insert position within a node
+    int level = 0;                                     // Current tree level (0 = root)
+    int low = 0;                                       // Binary search lower bound
+    int high = 0;                                      // Binary search upper bound
+    int middle = 0;                                    // Binary search midpoint
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = -1;                              // Return value (single return pattern)
     
-    // Draw chart header
-    WriteToReport(txtFile, "\n=== AVERAGE DELIVERY TIME BY MONTH ===\n");
-    WriteToReport(txtFile, "======================================\n");
+    if (header->treeHeight < 1 || header->treeHeight >= BPLUS_TREE_MAX_HEIGHT) {
+        errorOccurred = 1;
+    }
     
-    // Draw bars for each month
-    for (int i = 0; i < dataCount; i++) {
-        int barLength = 0;                             // Length of bar for this month
-        
-        // Calculate bar length
-        barLength = (int)(monthlyData[i].avgDeliveryDays * scaleFactor);
-        
-        // Ensure at least 1 character if value > 0
-        if (barLength == 0 && monthlyData[i].avgDeliveryDays > 0.0) {
-            barLength = 1;
+    // Descend to the leaf; internal nodes follow the child holding keys <= key
+    for (level = 0; level < header->treeHeight && errorOccurred == 0; level++) {
+        pathPages[level] = pageNumber;
+        if (ReadBPlusTreeNode(indexFile, pageNumber, &node) == 0 || (node.isLeaf == 1) != (level == header->treeHeight - 1)) {
+            errorOccurred = 1;
+        } else if (node.isLeaf == 0) {
+            low = 0;
+            high = node.keyCount;
+            while (low < high) {
+                middle = (low + high) / 2;
+                if (node.keys[middle] <= key) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            pageNumber = node.pointers[low];
         }
-        
-        // Print month label
-        WriteToReport(txtFile, "%04u-%02u | ", 
-               monthlyData[i].year, monthlyData[i].month);
-        
-        // Draw bar
-        for (int j = 0; j < barLength; j++) {
-            WriteToReport(txtFile, "█");
+    }
+    
+    // Leaf: find the first key >= key
+    if (errorOccurred == 0) {
+        low = 0;
+        high = node.keyCount;
+        while (low < high) {
+            middle = (low + high) / 2;
+            if (node.keys[middle] < key) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        position = low;
+    
+        if (position < node.keyCount && node.keys[position] == key) {
+            returnValue = 0;                           // Already indexed
+        } else {
+            for (int i = 0; i < node.keyCount; i++) {
+                mergedKeys[i + (i >= position)] = node.keys[i];
+                mergedPointers[i + (i >= position)] = node.pointers[i];
+            }
+            mergedKeys[position] = key;
+            mergedPointers[position] = recordOffset;
+            mergedCount = node.keyCount + 1;
+            nextLeaf = node.nextLeaf;
+    
+            InitializeStructureToZero(&node, sizeof(bPlusTreeNode));
+            node.isLeaf = 1;
+            node.nextLeaf = nextLeaf;
+            leftCount = (mergedCount <= BPLUS_TREE_ORDER) ? mergedCount : mergedCount / 2;
+            for (int i = 0; i < leftCount; i++) {
+                node.keys[i] = mergedKeys[i];
+                node.pointers[i] = mergedPointers[i];
+            }
+            node.keyCount = leftCount;
+    
+            if (leftCount < mergedCount) {
+                // Split: the right half becomes a new leaf chained after this one
+                InitializeStructureToZero(&sibling, sizeof(bPlusTreeNode));
+                sibling.isLeaf = 1;
+                sibling.nextLeaf = nextLeaf;
+                for (int i = leftCount; i < mergedCount; i++) {
+                    sibling.keys[i - leftCount] = mergedKeys[i];
+                    sibling.pointers[i - leftCount] = mergedPointers[i];
+                }
+                sibling.keyCount = mergedCount - leftCount;
+                newChildPage = header->pageCount;
+                separatorKey = sibling.keys[0];
+                node.nextLeaf = newChildPage;
+                if (WriteBPlusTreeNode(indexFile, newChildPage, &sibling) == 0) {
+                    errorOccurred = 1;
+                }
+                header->pageCount++;
+            }
+            if (WriteBPlusTreeNode(indexFile, pathPages[header->treeHeight - 1], &node) == 0) {
+                errorOccurred = 1;
+            }
+            header->keyCount++;
+            returnValue = 1;
         }
-        
-        // Print value
-        WriteToReport(txtFile, " %.2f days\n", monthlyData[i].avgDeliveryDays);
     }
     
-    WriteToReport(txtFile, "\n");
-}//end function definition DrawDeliveryTimeChart
+    // Insert each split's right page into its parent, splitting parents as needed
+    for (level = header->treeHeight - 2; level >= 0 && newChildPage != -1 && errorOccurred == 0; level--) {
+        if (ReadBPlusTreeNode(indexFile, pathPages[level], &node) == 0) {
+            errorOccurred = 1;
+        } else {
+            // The split child is the one whose range holds separatorKey
+            low = 0;
+            high = node.keyCount;
+            while (low < high) {
+                middle = (low + high) / 2;
+                if (node.keys[middle] <= separatorKey) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            position = low;
+    
+            for (int i = 0; i < node.keyCount; i++) {
+                mergedKeys[i + (i >= position)] = node.keys[i];
+            }
+            for (int i = 0; i <= node.keyCount; i++) {
+                mergedPointers[i + (i > position)] = node.pointers[i];
+            }
+            mergedKeys[position] = separatorKey;
+            mergedPointers[position + 1] = newChildPage;
+            mergedCount = node.keyCount + 1;
+    
+            InitializeStructureToZero(&node, sizeof(bPlusTreeNode));
+            node.nextLeaf = -1;
+            leftCount = (mergedCount <= BPLUS_TREE_ORDER) ? mergedCount : mergedCount / 2;
+            for (int i = 0; i < leftCount; i++) {
+                node.keys[i] = mergedKeys[i];
+                node.pointers[i] = mergedPointers[i];
+            }
+            node.pointers[leftCount] = mergedPointers[leftCount];
+            node.keyCount = leftCount;
+            newChildPage = -1;
+    
+            if (leftCount < mergedCount) {
+                // Split: mergedKeys[leftCount] moves up, the keys after it form the new page
+                InitializeStructureToZero(&sibling, sizeof(bPlusTreeNode));
+                sibling.nextLeaf = -1;
+                for (int i = leftCount + 1; i < mergedCount; i++) {
+                    sibling.keys[i - leftCount - 1] = mergedKeys[i];
+                    sibling.pointers[i - leftCount - 1] = mergedPointers[i];
+                }
+                sibling.pointers[mergedCount - leftCount - 1] = mergedPointers[mergedCount];
+                sibling.keyCount = mergedCount - leftCount - 1;
+                newChildPage = header->pageCount;
+                separatorKey = mergedKeys[leftCount];
+                if (WriteBPlusTreeNode(indexFile, newChildPage, &sibling) == 0) {
+                    errorOccurred = 1;
+                }
+                header->pageCount++;
+            }
+            if (WriteBPlusTreeNode(indexFile, pathPages[level], &node) == 0) {
+                errorOccurred = 1;
+            }
+        }
+    }
+    
+    // The root split: a new root holds the two halves
+    if (errorOccurred == 0 && newChildPage != -1) {
+        InitializeStructureToZero(&node, sizeof(bPlusTreeNode));
+        node.nextLeaf = -1;
+        node.keyCount = 1;
+        node.keys[0] = separatorKey;
+        node.pointers[0] = header->rootPage;
+        node.pointers[1] = newChildPage;
+        if (WriteBPlusTreeNode(indexFile, header->pageCount, &node) == 0) {
+            errorOccurred = 1;
+        }
+        header->rootPage = header->pageCount;
+        header->pageCount++;
+        header->treeHeight++;
+    }
+    
+    if (errorOccurred == 1) {
+        returnValue = -1;
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition InsertBPlusTreeKey
 
 /*
- * Function: AnalyzeDeliveryTrends
- * Purpose: Analyzes delivery time trends and changes over time
- * Parameters: txtFile - output file pointer
- *            monthlyData - array of monthly data
- *            dataCount - number of months
- * Returns: void
- * Note: Calculates improvements/deteriorations in delivery times
+ * Function: AppendBPlusTreeIndex
+ * Purpose: Adds the records appended to a table file to its B+tree index
+ * Parameters: tableFileName - indexed table (e.g. "CustomersTable.dat")
+ *            indexFileName - index file to update (e.g. "CustomersTable.idx")
+ *            recordSize - size of each table record in bytes
+ *            extractKey - function returning the key of a record
+ *            firstRecord - number of records the index already covers
+ * Returns: long - number of distinct keys indexed, -1 on error
+ * Note: Cost is one root-to-leaf descent per appended record. If the index is missing,
+ *       invalid, or an insert fails, the whole index is rebuilt with BuildBPlusTreeIndex.
+ *       The header is written after the last insert.
  */
-void AnalyzeDeliveryTrends(FILE* txtFile, const monthlyDeliveryData* monthlyData, int dataCount) {
-    WriteToReport(txtFile, "\n=== DELIVERY TIME TREND ANALYSIS ===\n");
-    WriteToReport(txtFile, "====================================\n");
+long AppendBPlusTreeIndex(const char* tableFileName, const char* indexFileName, size_t recordSize,
+                          unsigned int (*extractKey)(const void*), long firstRecord) {
+    FILE* tableFile = NULL;                            // Table being indexed
+    FILE* indexFile = NULL;                            // Index file being updated
+    unsigned char* recordBuffer = NULL;                // Current table record
+    tableHeader tableInfo;                             // Header of the table being indexed
+    bPlusTreeHeader header;                            // Index file header
+    long long recordOffset = (long long)firstRecord * (long long)recordSize; // Offset of current record
+    long keysAdded = 0;                                // New keys inserted
+    int insertResult = 0;                              // Result of the current insert
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
     
-    if (dataCount < 2) {
-        WriteToReport(txtFile, "Insufficient data for trend analysis\n");
-        return;
+    indexFile = OpenBPlusTreeIndex(indexFileName, &header);
+    if (indexFile != NULL) {
+        fclose(indexFile);
+        indexFile = OpenFileWithErrorCheck(indexFileName, "rb+");
+    }
+    tableFile = OpenBinaryTable(tableFileName, recordSize, &tableInfo);
+    recordBuffer = (unsigned char*)malloc(recordSize);
+    if (indexFile == NULL || tableFile == NULL || recordBuffer == NULL ||
+        CountedSeek64(tableFile, (long long)sizeof(tableHeader) + recordOffset, SEEK_SET) != 0) {
+        errorOccurred = 1;
     }
     
-    // Calculate month-over-month changes
-    double avgChange = 0.0;
-    int changeCount = 0;
-    int improvementMonths = 0;
-    int deteriorationMonths = 0;
-    
-    WriteToReport(txtFile, "\nMonth-over-Month Changes:\n");
-    WriteToReport(txtFile, "%-10s %15s %15s\n", "Period", "Avg Days", "Change");
-    WriteToReport(txtFile, "----------------------------------------------------\n");
-    
-    for (int i = 1; i < dataCount; i++) {
-        double change = monthlyData[i].avgDeliveryDays - monthlyData[i-1].avgDeliveryDays;
-        double percentChange = 0.0;
-        
-        if (monthlyData[i-1].avgDeliveryDays > 0.0) {
-            percentChange = (change / monthlyData[i-1].avgDeliveryDays) * 100.0;
-        }
-        
-        WriteToReport(txtFile, "%04u-%02u %15.2f %+14.2f (%.1f%%)\n",
-               monthlyData[i].year, monthlyData[i].month,
-               monthlyData[i].avgDeliveryDays, change, percentChange);
-        
-        avgChange += change;
-        changeCount++;
-        
-        if (change < 0) {
-            improvementMonths++;
-        } else if (change > 0) {
-            deteriorationMonths++;
+    while (errorOccurred == 0 && recordOffset < tableInfo.rowCount * (long long)recordSize &&
+           CountedRead(recordBuffer, recordSize, 1, tableFile) == 1) {
+        if (recordOffset > LONG_MAX) {
+            printf("Error: %s is too large for a B+tree index (record offsets past 2 GB)\n", tableFileName);
+            errorOccurred = 1;
+        } else {
+            insertResult = InsertBPlusTreeKey(indexFile, &header, extractKey(recordBuffer), (long)recordOffset);
+            if (insertResult < 0) {
+                errorOccurred = 1;
+            }
+            keysAdded += insertResult;
         }
+        recordOffset += (long long)recordSize;
     }
     
-    if (changeCount > 0) {
-        avgChange /= changeCount;
-        
-        WriteToReport(txtFile, "\nTrend Summary:\n");
-        WriteToReport(txtFile, "  Average change per month: %+.2f days\n", avgChange);
-        WriteToReport(txtFile, "  Months with improvement: %d\n", improvementMonths);
-        WriteToReport(txtFile, "  Months with deterioration: %d\n", deteriorationMonths);
-        
-        // Interpret trend
-        WriteToReport(txtFile, "\nInterpretation:\n");
-        if (avgChange < -0.5) {
-            WriteToReport(txtFile, "  ✓ Positive trend - Delivery times are improving\n");
-        } else if (avgChange > 0.5) {
-            WriteToReport(txtFile, "  ⚠ Negative trend - Delivery times are increasing\n");
+    if (errorOccurred == 0) {
+        CountedSeek(indexFile, 0, SEEK_SET);
+        if (CountedWrite(&header, sizeof(bPlusTreeHeader), 1, indexFile) == 1) {
+            returnValue = header.keyCount;
+            printf("Index %s updated: %ld new keys, %ld keys in total\n", indexFileName, keysAdded, header.keyCount);
         } else {
-            WriteToReport(txtFile, "  → Stable - Delivery times remain consistent\n");
+            errorOccurred = 1;
         }
     }
-}//end function definition AnalyzeDeliveryTrends
+    
+    if (tableFile != NULL) fclose(tableFile);
+    if (indexFile != NULL) fclose(indexFile);
+    free(recordBuffer);
+    if (errorOccurred == 1) {
+        printf("Rebuilding index %s...\n", indexFileName);
+        returnValue = BuildBPlusTreeIndex(tableFileName, indexFileName, recordSize, extractKey);
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition AppendBPlusTreeIndex
+
+// ====================== HASH JOIN OPERATIONS ======================
+#define HASH_JOIN_MEMORY_BUDGET (64L * 1024L * 1024L)  // Max build-side bytes kept in memory
 
 /*
- * Function: GenerateDeliveryRecommendations
- * Purpose: Generates business recommendations based on delivery performance
- * Parameters: txtFile - output file pointer
- *            monthlyData - array of monthly data
- *            dataCount - number of months
- *            overallAvg - overall average delivery time
- * Returns: void
- * Note: Provides actionable insights for logistics improvement
+ * Function: ExtractProductJoinKey
+ * Purpose: Extracts the join key (productKey) from a product record
+ * Parameters: record - pointer to a productRecord
+ * Returns: unsigned int - productKey of the record
+ * Note: Used as key extractor when building a hash table over ProductsTable.dat
  */
-void GenerateDeliveryRecommendations(FILE* txtFile, const monthlyDeliveryData* monthlyData, 
-                                     int dataCount, double overallAvg) {
-    WriteToReport(txtFile, "\n\n=== BUSINESS RECOMMENDATIONS ===\n");
-    WriteToReport(txtFile, "================================\n");
+unsigned int ExtractProductJoinKey(const void* record) {
+    const productRecord* product = (const productRecord*)record;  // Product record
+    return (unsigned int)product->productKey;
+}//end function definition ExtractProductJoinKey
+
+/*
+ * Function: ExtractCustomerJoinKey
+ * Purpose: Extracts the join key (customerKey) from a customer record
+ * Parameters: record - pointer to a customerRecord
+ * Returns: unsigned int - customerKey of the record
+ * Note: Used as key extractor when building a hash table over CustomersTable.dat
+ */
+unsigned int ExtractCustomerJoinKey(const void* record) {
+    const customerRecord* customer = (const customerRecord*)record;  // Customer record
+    return customer->customerKey;
+}//end function definition ExtractCustomerJoinKey
+
+/*
+ * Function: ExtractStoreJoinKey
+ * Purpose: Extracts the join key (storeKey) from a store record
+ * Parameters: record - pointer to a storeRecord
+ * Returns: unsigned int - storeKey of the record
+ * Note: Used as key extractor when building a hash table over StoresTable.dat
+ */
+unsigned int ExtractStoreJoinKey(const void* record) {
+    const storeRecord* store = (const storeRecord*)record;  // Store record
+    return (unsigned int)store->storeKey;
+}//end function definition ExtractStoreJoinKey
+
+/*
+ * Function: HashJoinBucketOf
+ * Purpose: Maps a join key to its bucket index
+ * Parameters: table - hash table being accessed
+ *            joinKey - key to hash
+ * Returns: unsigned long - bucket index in [0, bucketMask]
+ * Note: Multiplicative (Fibonacci) hashing spreads consecutive keys across buckets
+ */
+unsigned long HashJoinBucketOf(const HashJoinTable* table, unsigned int joinKey) {
+    unsigned long hashValue = (unsigned long)(joinKey * 2654435761u); // Knuth multiplicative hash
     
-    if (dataCount == 0) {
-        return;
+    hashValue ^= hashValue >> 16;                      // Fold high bits into low bits
+    return hashValue & table->bucketMask;
+}//end function definition HashJoinBucketOf
+
+/*
+ * Function: FreeHashJoinTable
+ * Purpose: Releases all memory held by a hash join table
+ * Parameters: table - hash table to release
+ * Returns: void
+ * Note: Safe to call on a zero-initialized or partially built table
+ */
+void FreeHashJoinTable(HashJoinTable* table) {
+    if (table != NULL) {
+        if (table->indexFile != NULL) fclose(table->indexFile);
+        CloseMappedTable(&table->tableMap);
+        free(table->bucketHeads);
+        free(table->nextEntries);
+        free(table->entryKeys);
+        free(table->entryRecords);
+        InitializeStructureToZero(table, sizeof(HashJoinTable));
+    }
+}//end function definition FreeHashJoinTable
+
+/*
+ * Function: ProbeHashJoinTable
+ * Purpose: Looks up the build-side record matching a join key
+ * Parameters: table - hash table built with BuildHashJoinTable
+ *            joinKey - key to look up
+ * Returns: const void* - pointer to the matching record, NULL if not found
+ * Note: O(1) expected time; the returned pointer stays valid until the table is freed.
+ *       Index-backed tables cost O(log n) page reads and point into the mapped table file.
+ */
+const void* ProbeHashJoinTable(const HashJoinTable* table, unsigned int joinKey) {
+    const void* matchedRecord = NULL;                  // Matching record (single return pattern)
+    long entryIndex = -1;                              // Current entry in bucket chain
+    long recordOffset = -1;                            // Record offset from the index
+    
+    if (table != NULL && table->indexFile != NULL) {
+        recordOffset = SearchBPlusTreeIndex(table->indexFile, &table->indexHeader, joinKey);
+        if (recordOffset >= 0) {
+            matchedRecord = MappedRecordAt(&table->tableMap, recordOffset / (long)table->recordSize);
+        }
+    } else if (table != NULL && table->entryCount > 0) {
+        entryIndex = table->bucketHeads[HashJoinBucketOf(table, joinKey)];
+        
+        while (entryIndex != -1 && matchedRecord == NULL) {
+            if (table->entryKeys[entryIndex] == joinKey) {
+                matchedRecord = table->entryRecords + (size_t)entryIndex * table->recordSize;
+            } else {
+                entryIndex = table->nextEntries[entryIndex];
+            }
+        }
     }
     
-    // Find best and worst months
-    double bestAvg = 999999.0;
-    double worstAvg = 0.0;
-    int bestMonth = 0;
-    int worstMonth = 0;
+    return matchedRecord;                              // Single return point
+}//end function definition ProbeHashJoinTable
+
+/*
+ * Function: BuildHashJoinTable
+ * Purpose: Builds an in-memory hash table over a dimension table file
+ * Parameters: table - hash table to build (any previous content is discarded)
+ *            buildFileName - binary table file for the build side
+ *            recordSize - size of each record in bytes
+ *            extractKey - function returning the join key of a record
+ * Returns: long - number of records loaded, -1 on error
+ * Note: Maps the build file and copies it once sequentially. If a key appears more than once,
+ *       the first record in file order wins, matching the linear-scan lookups
+ *       this operator replaces.
+ */
+long BuildHashJoinTable(HashJoinTable* table, const char* buildFileName, size_t recordSize,
+                        unsigned int (*extractKey)(const void*)) {
+    mappedTable buildTable;                            // Mapped build-side table file
+    long recordCount = 0;                              // Records in build file
+    unsigned long bucketCount = 16;                    // Number of buckets (power of two)
+    unsigned char* currentRecord = NULL;               // Slot for the record being loaded
+    unsigned int joinKey = 0;                          // Key of the record being loaded
+    unsigned long bucketIndex = 0;                     // Bucket of the record being loaded
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
     
-    for (int i = 0; i < dataCount; i++) {
-        if (monthlyData[i].avgDeliveryDays < bestAvg) {
-            bestAvg = monthlyData[i].avgDeliveryDays;
-            bestMonth = i;
+    FreeHashJoinTable(table);
+    table->recordSize = recordSize;
+    
+    if (OpenMappedBinaryTable(&buildTable, buildFileName, recordSize, TABLE_ACCESS_SEQUENTIAL, NULL) == 0) {
+        errorOccurred = 1;
+    }
+    
+    if (errorOccurred == 0) {
+        recordCount = buildTable.recordCount;
+        
+        // Keep load factor at or below 0.5
+        while (bucketCount < (unsigned long)recordCount * 2) {
+            bucketCount *= 2;
         }
-        if (monthlyData[i].avgDeliveryDays > worstAvg) {
-            worstAvg = monthlyData[i].avgDeliveryDays;
-            worstMonth = i;
+        table->bucketMask = bucketCount - 1;
+        
+        table->bucketHeads = (long*)malloc(bucketCount * sizeof(long));
+        table->nextEntries = (long*)malloc(((size_t)recordCount + 1) * sizeof(long));
+        table->entryKeys = (unsigned int*)malloc(((size_t)recordCount + 1) * sizeof(unsigned int));
+        table->entryRecords = (unsigned char*)malloc(((size_t)recordCount + 1) * recordSize);
+        
+        if (table->bucketHeads == NULL || table->nextEntries == NULL ||
+            table->entryKeys == NULL || table->entryRecords == NULL) {
+            printf("Error: Cannot allocate hash table for %s\n", buildFileName);
+            errorOccurred = 1;
+        } else {
+            memset(table->bucketHeads, 0xFF, bucketCount * sizeof(long)); // All buckets = -1
         }
     }
     
-    double performanceVariation = worstAvg - bestAvg;
-    
-    WriteToReport(txtFile, "\n1. LOGISTICS PERFORMANCE:\n");
-    WriteToReport(txtFile, "   Overall average delivery time: %.2f days\n", overallAvg);
-    WriteToReport(txtFile, "   Best performance: %.2f days (%04u-%02u)\n",
-           bestAvg, monthlyData[bestMonth].year, monthlyData[bestMonth].month);
-    WriteToReport(txtFile, "   Worst performance: %.2f days (%04u-%02u)\n",
-           worstAvg, monthlyData[worstMonth].year, monthlyData[worstMonth].month);
-    WriteToReport(txtFile, "   Performance variation: %.2f days\n", performanceVariation);
+    if (errorOccurred == 0) {
+        // Copy each record into its final slot, then link it if the key is new
+        currentRecord = table->entryRecords;
+        for (long i = 0; i < recordCount; i++) {
+            memcpy(currentRecord, MappedRecordAt(&buildTable, i), recordSize);
+            joinKey = extractKey(currentRecord);
+            
+            if (ProbeHashJoinTable(table, joinKey) == NULL) {
+                bucketIndex = HashJoinBucketOf(table, joinKey);
+                table->entryKeys[table->entryCount] = joinKey;
+                table->nextEntries[table->entryCount] = table->bucketHeads[bucketIndex];
+                table->bucketHeads[bucketIndex] = table->entryCount;
+                table->entryCount++;
+                currentRecord += recordSize;
+            }
+        }
+        returnValue = table->entryCount;
+    }
     
-    WriteToReport(txtFile, "\n2. TARGET SETTING:\n");
-    if (overallAvg <= 5.0) {
-        WriteToReport(txtFile, "   ✓ EXCELLENT - Current performance is very competitive\n");
-        WriteToReport(txtFile, "   Target: Maintain average below 5 days\n");
-        WriteToReport(txtFile, "   Focus: Consistency and quality\n");
-    } else if (overallAvg <= 10.0) {
-        WriteToReport(txtFile, "   ✓ GOOD - Performance meets industry standards\n");
-        WriteToReport(txtFile, "   Target: Reduce to %.2f days (10%% improvement)\n", overallAvg * 0.9);
-        WriteToReport(txtFile, "   Focus: Optimize high-volume routes\n");
-    } else if (overallAvg <= 15.0) {
-        WriteToReport(txtFile, "   ⚠ MODERATE - Room for significant improvement\n");
-        WriteToReport(txtFile, "   Target: Reduce to %.2f days (20%% improvement)\n", overallAvg * 0.8);
-        WriteToReport(txtFile, "   Focus: Process optimization and carrier performance\n");
-    } else {
-        WriteToReport(txtFile, "   ⚠ NEEDS IMPROVEMENT - Delivery times are concerning\n");
-        WriteToReport(txtFile, "   Target: Reduce to %.2f days (30%% improvement)\n", overallAvg * 0.7);
-        WriteToReport(txtFile, "   Focus: Complete logistics overhaul needed\n");
+    if (errorOccurred == 1) {
+        FreeHashJoinTable(table);
     }
+    CloseMappedTable(&buildTable);
     
-    WriteToReport(txtFile, "\n3. RECOMMENDED ACTIONS:\n");
-    if (performanceVariation > 5.0) {
-        WriteToReport(txtFile, "   ⚠ HIGH VARIATION DETECTED:\n");
-        WriteToReport(txtFile, "   - Investigate causes of delays in worst months\n");
-        WriteToReport(txtFile, "   - Standardize processes across all periods\n");
-        WriteToReport(txtFile, "   - Implement seasonal capacity planning\n");
+    return returnValue;                                // Single return point
+}//end function definition BuildHashJoinTable
+
+/*
+ * Function: OpenIndexedJoinTable
+ * Purpose: Prepares a join table that probes a B+tree index instead of holding records in memory
+ * Parameters: table - join table to prepare (any previous content is discarded)
+ *            tableFileName - build-side table file
+ *            indexFileName - B+tree index over tableFileName
+ *            recordSize - size of each build-side record in bytes
+ * Returns: long - number of keys in the index, -1 on error
+ * Note: The table file is mapped for random access instead of being loaded
+ */
+long OpenIndexedJoinTable(HashJoinTable* table, const char* tableFileName, const char* indexFileName,
+                          size_t recordSize) {
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    FreeHashJoinTable(table);
+    table->recordSize = recordSize;
+    table->indexFile = OpenBPlusTreeIndex(indexFileName, &table->indexHeader);
+    
+    if (table->indexFile != NULL &&
+        OpenMappedBinaryTable(&table->tableMap, tableFileName, recordSize, TABLE_ACCESS_RANDOM, NULL) == 1) {
+        table->entryCount = table->indexHeader.keyCount;
+        returnValue = table->entryCount;
+    } else {
+        FreeHashJoinTable(table);
     }
     
-    WriteToReport(txtFile, "\n   General Improvements:\n");
-    WriteToReport(txtFile, "   - Negotiate service level agreements with carriers\n");
-    WriteToReport(txtFile, "   - Implement real-time tracking systems\n");
-    WriteToReport(txtFile, "   - Optimize warehouse locations for faster delivery\n");
-    WriteToReport(txtFile, "   - Review and streamline order processing workflow\n");
-    WriteToReport(txtFile, "   - Consider regional distribution centers\n");
+    return returnValue;                                // Single return point
+}//end function definition OpenIndexedJoinTable
+
+/*
+ * Function: PrepareCustomerJoinTable
+ * Purpose: Prepares the customers side of a sales join
+ * Parameters: table - join table to prepare
+ * Returns: long - number of customers available to the join, -1 on error
+ * Note: Builds an in-memory hash table when CustomersTable.dat fits in
+ *       HASH_JOIN_MEMORY_BUDGET; otherwise, or if the build fails, probes
+ *       CustomersTable.idx so the customer table never has to be loaded whole.
+ */
+long PrepareCustomerJoinTable(HashJoinTable* table) {
+    long customerCount = 0;                            // Rows in customers table
+    long returnValue = -1;                             // Return value (single return pattern)
     
-    if (overallAvg > 10.0) {
-        WriteToReport(txtFile, "\n   Priority Actions:\n");
-        WriteToReport(txtFile, "   - Evaluate alternative shipping carriers\n");
-        WriteToReport(txtFile, "   - Implement expedited shipping options\n");
-        WriteToReport(txtFile, "   - Review inventory positioning strategy\n");
+    customerCount = CountTableRecords("CustomersTable.dat", sizeof(customerRecord));
+    if (customerCount >= 0) {
+        if ((long long)customerCount * (long long)sizeof(customerRecord) <= HASH_JOIN_MEMORY_BUDGET) {
+            returnValue = BuildHashJoinTable(table, "CustomersTable.dat", sizeof(customerRecord), ExtractCustomerJoinKey);
+        }
+        if (returnValue < 0) {
+            printf("Using CustomersTable.idx for customer lookups...\n");
+            returnValue = OpenIndexedJoinTable(table, "CustomersTable.dat", "CustomersTable.idx", sizeof(customerRecord));
+        }
     }
     
-    WriteToReport(txtFile, "\n4. MONITORING STRATEGY:\n");
-    WriteToReport(txtFile, "   - Track delivery times daily\n");
-    WriteToReport(txtFile, "   - Set alerts for orders exceeding %.0f days\n", overallAvg * 1.5);
-    WriteToReport(txtFile, "   - Monthly review of carrier performance\n");
-    WriteToReport(txtFile, "   - Customer feedback on delivery satisfaction\n");
-}//end function definition GenerateDeliveryRecommendations
+    return returnValue;                                // Single return point
+}//end function definition PrepareCustomerJoinTable
 
 /*
- * Function: GenerateReport4DeliveryTimeAnalysis
- * Purpose: Generates Report 4 - Average Delivery Time Analysis
- * Parameters: sortType - "Bubble" or "Merge" to specify sorting algorithm
+ * Function: ExecuteSalesHashJoin
+ * Purpose: Streams SalesTable.dat through prebuilt product and/or customer hash tables
+ * Parameters: productsTable - hash table over ProductsTable.dat (NULL = do not join products)
+ *            customersTable - hash table over CustomersTable.dat (NULL = do not join customers)
+ *            emitFunction - called once per sale whose requested dimensions were all found
+ *            context - caller state passed unchanged to emitFunction
+ * Returns: long - number of joined rows emitted, -1 on error
+ * Note: Inner join semantics: a sale is skipped if a requested dimension has no match.
+ *       Dimensions that were not requested are passed to emitFunction as NULL.
+ *       The sales file is mapped and walked once, sequentially.
+ */
+long ExecuteSalesHashJoin(const HashJoinTable* productsTable, const HashJoinTable* customersTable,
+                          void (*emitFunction)(const salesRecord*, const productRecord*,
+                                               const customerRecord*, void*),
+                          void* context) {
+    mappedTable salesTable;                            // Mapped sales table (probe side)
+    const salesRecord* currentSale = NULL;             // Current sales record
+    const productRecord* matchedProduct = NULL;        // Product matching current sale
+    const customerRecord* matchedCustomer = NULL;      // Customer matching current sale
+    long rowsEmitted = 0;                              // Joined rows emitted
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    if (OpenMappedBinaryTable(&salesTable, "SalesTable.dat", sizeof(salesRecord), TABLE_ACCESS_SEQUENTIAL, NULL) == 1) {
+        for (long i = 0; i < salesTable.recordCount; i++) {
+            currentSale = (const salesRecord*)MappedRecordAt(&salesTable, i);
+            matchedProduct = NULL;
+            matchedCustomer = NULL;
+            
+            if (productsTable != NULL) {
+                matchedProduct = (const productRecord*)ProbeHashJoinTable(productsTable, currentSale->productKey);
+            }
+            if (customersTable != NULL) {
+                matchedCustomer = (const customerRecord*)ProbeHashJoinTable(customersTable, currentSale->customerKey);
+            }
+            
+            if ((productsTable == NULL || matchedProduct != NULL) &&
+                (customersTable == NULL || matchedCustomer != NULL)) {
+                emitFunction(currentSale, matchedProduct, matchedCustomer, context);
+                rowsEmitted++;
+            }
+        }
+        
+        CloseMappedTable(&salesTable);
+        returnValue = rowsEmitted;
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition ExecuteSalesHashJoin
+
+// ====================== PRODUCT DIMENSION CACHE ======================
+// Dense array indexed directly by productKey, loaded once per process from ProductsTable.dat
+static productRecord* productDimension = NULL;        // Product records indexed by productKey
+static unsigned char* productDimensionPresent = NULL; // 1 if productDimension[key] holds a product
+static long productDimensionSize = 0;                 // Number of slots (highest productKey + 1)
+static int productDimensionLoaded = 0;                // 1 once ProductsTable.dat has been loaded
+
+/*
+ * Function: InvalidateProductDimension
+ * Purpose: Releases the product dimension cache so the next lookup reloads it
+ * Parameters: none
  * Returns: void
- * Note: Analyzes delivery performance and trends over time
- *       Similar structure to Report 3 with charts and recommendations
+ * Note: Must be called whenever ProductsTable.dat is rebuilt
  */
-void GenerateReport4DeliveryTimeAnalysis(const char* sortType) {
-    FILE* sortedFile = NULL;                           // Sorted monthly data file
-    FILE* txtFile = NULL;                              // Output text report file
-    char tempFileName[300] = {0};                      // Temporary aggregated data file
-    char sortedFileName[300] = {0};                    // Sorted data file
-    char txtFileName[300] = {0};                       // Text report file name
-    char reportTitle[150] = {0};                       // Report title
-    monthlyDeliveryData currentMonth;                  // Current month data
-    monthlyDeliveryData allMonthsData[100];            // Array to store all months
-    int monthsAggregated = 0;                          // Number of months aggregated
-    int monthsSorted = 0;                              // Number of months sorted
-    int monthsRead = 0;                                // Number of months read
-    unsigned long totalOrders = 0;                     // Total orders
-    double overallAvg = 0.0;                           // Overall average delivery time
-    unsigned short globalMin = USHRT_MAX;              // Global minimum
-    unsigned short globalMax = 0;                      // Global maximum
-    time_t startTime = 0;                              // Report generation start time
-    time_t sortStartTime = 0;                          // Sorting start time
-    time_t sortEndTime = 0;                            // Sorting end time
-    int errorOccurred = 0;                             // Error flag
-    int sortTypeValid = 0;                             // Sort type validation flag
+void InvalidateProductDimension(void) {
+    free(productDimension);
+    free(productDimensionPresent);
+    productDimension = NULL;
+    productDimensionPresent = NULL;
+    productDimensionSize = 0;
+    productDimensionLoaded = 0;
+}//end function definition InvalidateProductDimension
+
+/*
+ * Function: LoadProductDimension
+ * Purpose: Loads ProductsTable.dat into the dense productKey-indexed array
+ * Parameters: none
+ * Returns: int - 1 if the cache is loaded, 0 on error
+ * Note: Does nothing if the cache is already loaded
+ *       The array is sized from the productKey range in the table header, so the
+ *       table is read in one sequential pass
+ *       For duplicate keys the first record in file order wins
+ */
+int LoadProductDimension(void) {
+    FILE* productsFile = NULL;                         // Products table file
+    tableHeader productsHeader;                        // Header of the products table
+    productRecord currentProduct;                      // Current product record
+    long highestKey = -1;                              // Highest productKey in the table
+    long productsRead = 0;                             // Records read so far
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    printf("\nGenerating Report 4: Delivery Time Analysis\n");
-    printf("Using %s sort algorithm...\n", sortType);
+    if (productDimensionLoaded == 1) {
+        returnValue = 1;
+    } else {
+        productsFile = OpenBinaryTable("ProductsTable.dat", sizeof(productRecord), &productsHeader);
+        if (productsFile == NULL) {
+            printf("Error: Cannot open ProductsTable.dat\n");
+        } else {
+            // Size the array by the highest key (column 0 holds the productKey statistics)
+            if (productsHeader.rowCount > 0) {
+                highestKey = (long)productsHeader.columns[0].maxValue;
+            }
+            
+            productDimensionSize = highestKey + 1;
+            if (productDimensionSize > 0) {
+                productDimension = (productRecord*)calloc((size_t)productDimensionSize, sizeof(productRecord));
+                productDimensionPresent = (unsigned char*)calloc((size_t)productDimensionSize, sizeof(unsigned char));
+            }
+            
+            if (productDimensionSize > 0 && (productDimension == NULL || productDimensionPresent == NULL)) {
+                printf("Error: Memory allocation failed for product dimension\n");
+                InvalidateProductDimension();
+            } else {
+                // Place each product in its slot
+                while (productsRead < productsHeader.rowCount &&
+                       CountedRead(&currentProduct, sizeof(productRecord), 1, productsFile) == 1) {
+                    productsRead++;
+                    if (productDimensionPresent[currentProduct.productKey] == 0) {
+                        productDimension[currentProduct.productKey] = currentProduct;
+                        productDimensionPresent[currentProduct.productKey] = 1;
+                    }
+                }
+                productDimensionLoaded = 1;
+                returnValue = 1;
+            }
+            
+            fclose(productsFile);
+        }
+    }
     
-    time(&startTime);
+    return returnValue;
+}//end function definition LoadProductDimension
+
+/*
+ * Function: LookupProductByKey
+ * Purpose: Returns the product with the given key from the product dimension cache
+ * Parameters: productKey - key of the product to find
+ * Returns: const productRecord* - matching product, or NULL if absent or the table cannot be loaded
+ * Note: Loads the cache on first use; each lookup afterwards is a single array index
+ */
+const productRecord* LookupProductByKey(unsigned short productKey) {
+    const productRecord* result = NULL;                // Matching product
     
-    // Generate filenames
-    sprintf(tempFileName, "temp_delivery_%ld.dat", (long)time(NULL));
-    sprintf(txtFileName, "Report_4_Delivery_%s_%ld.txt", sortType, (long)time(NULL));
+    if (LoadProductDimension() == 1 && (long)productKey < productDimensionSize &&
+        productDimensionPresent[productKey] == 1) {
+        result = &productDimension[productKey];
+    }
     
-    // Open text file for report output
-    txtFile = OpenFileWithErrorCheck(txtFileName, "w");
-    if (txtFile == NULL) {
-        printf("Error: Cannot create report text file\n");
-        return;
+    return result;
+}//end function definition LookupProductByKey
+
+// ====================== EXCHANGE RATE MATRIX ======================
+// Dense matrix of rates indexed by [currency][day number - first day], loaded once per process
+// from ExchangeRatesTable.dat. Days without a rate hold the rate of the nearest dated day.
+#define EXCHANGE_RATE_MAX_CURRENCIES 16                // Distinct currency codes kept in the matrix
+
+static char exchangeRateCurrencies[EXCHANGE_RATE_MAX_CURRENCIES][4]; // Currency code of each matrix row
+static int exchangeRateCurrencyCount = 0;              // Rows in use
+static int exchangeRateFirstDay = 0;                   // Day number of column 0
+static int exchangeRateDayCount = 0;                   // Columns (days covered by the table)
+static double* exchangeRateMatrix = NULL;              // Rates, -1.0 where a currency has no rates
+static int exchangeRateMatrixLoaded = 0;               // 1 once ExchangeRatesTable.dat has been loaded
+
+/*
+ * Function: InvalidateExchangeRateMatrix
+ * Purpose: Releases the exchange rate matrix so the next conversion reloads it
+ * Parameters: none
+ * Returns: void
+ * Note: Must be called whenever ExchangeRatesTable.dat is rebuilt
+ */
+void InvalidateExchangeRateMatrix(void) {
+    free(exchangeRateMatrix);
+    exchangeRateMatrix = NULL;
+    exchangeRateCurrencyCount = 0;
+    exchangeRateFirstDay = 0;
+    exchangeRateDayCount = 0;
+    exchangeRateMatrixLoaded = 0;
+}//end function definition InvalidateExchangeRateMatrix
+
+/*
+ * Function: FindExchangeRateCurrency
+ * Purpose: Returns the matrix row of a currency code
+ * Parameters: currencyCode - 3-character currency code
+ * Returns: int - row index, -1 if the currency is not in the matrix
+ */
+int FindExchangeRateCurrency(const char* currencyCode) {
+    int rowIndex = -1;                                 // Matching row (single return pattern)
+    
+    for (int i = 0; i < exchangeRateCurrencyCount && rowIndex == -1; i++) {
+        if (strncmp(exchangeRateCurrencies[i], currencyCode, 3) == 0) {
+            rowIndex = i;
+        }
     }
     
-    // Aggregate delivery times by month
-    monthsAggregated = AggregateDeliveryTimesByMonth(tempFileName);
-    if (monthsAggregated <= 0) {
-        printf("Error: Failed to aggregate delivery data\n");
-        errorOccurred = 1;
+    return rowIndex;
+}//end function definition FindExchangeRateCurrency
+
+/*
+ * Function: FillNearestExchangeRates
+ * Purpose: Fills the days without a rate in one matrix row with the nearest dated rate
+ * Parameters: row - first cell of the row (exchangeRateDayCount cells, -1.0 = no rate)
+ * Returns: void
+ * Note: A forward pass records the previous dated day, a backward pass picks the closer
+ *       of previous and next; on equal distance the earlier date wins
+ */
+void FillNearestExchangeRates(double* row) {
+    int* previousDated = NULL;                         // Previous day with a rate (-1 = none)
+    int lastDated = -1;                                // Last dated day seen
+    int nextDated = -1;                                // Next day with a rate (-1 = none)
+    
+    previousDated = (int*)malloc((size_t)exchangeRateDayCount * sizeof(int));
+    if (previousDated == NULL) {
+        printf("Error: Memory allocation failed for exchange rate matrix\n");
+    } else {
+        for (int day = 0; day < exchangeRateDayCount; day++) {
+            if (row[day] > 0.0) {
+                lastDated = day;
+            }
+            previousDated[day] = lastDated;
+        }
+        for (int day = exchangeRateDayCount - 1; day >= 0; day--) {
+            if (row[day] > 0.0) {
+                nextDated = day;
+            } else if (previousDated[day] >= 0 &&
+                       (nextDated < 0 || day - previousDated[day] <= nextDated - day)) {
+                row[day] = row[previousDated[day]];
+            } else if (nextDated >= 0) {
+                row[day] = row[nextDated];
+            }
+        }
+        free(previousDated);
     }
+}//end function definition FillNearestExchangeRates
+
+/*
+ * Function: LoadExchangeRateMatrix
+ * Purpose: Loads ExchangeRatesTable.dat into the dense exchange rate matrix
+ * Parameters: none
+ * Returns: int - 1 if the matrix is loaded, 0 on error
+ * Note: Does nothing if the matrix is already loaded
+ *       Two sequential passes: the first finds the currencies and the date range,
+ *       the second places each rate; for a repeated (currency, date) the first record wins.
+ *       Gaps are then filled with FillNearestExchangeRates.
+ */
+int LoadExchangeRateMatrix(void) {
+    FILE* exchangeRateFile = NULL;                     // Exchange rates table file
+    tableHeader ratesHeader;                           // Header of the exchange rates table
+    exchangeRateRecord currentRate;                    // Current exchange rate record
+    int lastDay = 0;                                   // Highest day number in the table
+    int rowIndex = 0;                                  // Matrix row of the current currency
+    int datedRecords = 0;                              // Records with a valid date
+    double* cell = NULL;                               // Matrix cell of the current rate
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    if (errorOccurred == 0) {
-        // Generate sorted filename
-        GenerateSortedFileName("Delivery", sortType, sortedFileName);
-        
-        printf("Sorting monthly data using %s sort...\n", sortType);
-        time(&sortStartTime);
-        
-        // Sort monthly data chronologically
-        if (strcmp(sortType, "Bubble") == 0) {
-            sortTypeValid = 1;
-            monthsSorted = SortBubble(tempFileName, sortedFileName,
-                                     sizeof(monthlyDeliveryData), CompareMonthlyDeliveryData);
-        } else if (strcmp(sortType, "Merge") == 0) {
-            sortTypeValid = 1;
-            monthsSorted = SortMerge(tempFileName, sortedFileName,
-                                    sizeof(monthlyDeliveryData), CompareMonthlyDeliveryData);
+    if (exchangeRateMatrixLoaded == 1) {
+        returnValue = 1;
+    } else {
+        exchangeRateFile = OpenBinaryTable("ExchangeRatesTable.dat", sizeof(exchangeRateRecord), &ratesHeader);
+        if (exchangeRateFile == NULL) {
+            printf("Error: Cannot open exchange rates file for currency conversion\n");
         } else {
-            printf("Error: Invalid sort type '%s'\n", sortType);
-            sortTypeValid = 0;
-            errorOccurred = 1;
+            // First pass: currencies and date range
+            for (long i = 0; i < ratesHeader.rowCount &&
+                             CountedRead(&currentRate, sizeof(exchangeRateRecord), 1, exchangeRateFile) == 1; i++) {
+                if (currentRate.rateDay != DAY_NUMBER_NONE) {
+                    if (datedRecords == 0 || currentRate.rateDay < exchangeRateFirstDay) {
+                        exchangeRateFirstDay = currentRate.rateDay;
+                    }
+                    if (datedRecords == 0 || currentRate.rateDay > lastDay) {
+                        lastDay = currentRate.rateDay;
+                    }
+                    datedRecords++;
+                    if (FindExchangeRateCurrency(currentRate.currency) == -1) {
+                        if (exchangeRateCurrencyCount < EXCHANGE_RATE_MAX_CURRENCIES) {
+                            strncpy(exchangeRateCurrencies[exchangeRateCurrencyCount], currentRate.currency, 3);
+                            exchangeRateCurrencies[exchangeRateCurrencyCount][3] = '\0';
+                            exchangeRateCurrencyCount++;
+                        } else {
+                            printf("Warning: Too many currencies in exchange rates table, ignoring %s\n",
+                                   currentRate.currency);
+                        }
+                    }
+                }
+            }
+            
+            exchangeRateDayCount = (datedRecords > 0) ? lastDay - exchangeRateFirstDay + 1 : 0;
+            if (exchangeRateDayCount > 0 && exchangeRateCurrencyCount > 0) {
+                exchangeRateMatrix = (double*)malloc((size_t)exchangeRateCurrencyCount *
+                                                     (size_t)exchangeRateDayCount * sizeof(double));
+            }
+            
+            if (exchangeRateDayCount > 0 && exchangeRateCurrencyCount > 0 && exchangeRateMatrix == NULL) {
+                printf("Error: Memory allocation failed for exchange rate matrix\n");
+                InvalidateExchangeRateMatrix();
+            } else {
+                for (long i = 0; i < (long)exchangeRateCurrencyCount * exchangeRateDayCount; i++) {
+                    exchangeRateMatrix[i] = -1.0;
+                }
+                
+                // Second pass: place each dated rate in its cell
+                CountedSeek(exchangeRateFile, (long)sizeof(tableHeader), SEEK_SET);
+                for (long i = 0; i < ratesHeader.rowCount &&
+                                 CountedRead(&currentRate, sizeof(exchangeRateRecord), 1, exchangeRateFile) == 1; i++) {
+                    rowIndex = FindExchangeRateCurrency(currentRate.currency);
+                    if (rowIndex >= 0 && currentRate.exchange > 0.0 && currentRate.rateDay != DAY_NUMBER_NONE) {
+                        cell = &exchangeRateMatrix[(long)rowIndex * exchangeRateDayCount +
+                                                   (currentRate.rateDay - exchangeRateFirstDay)];
+                        if (*cell <= 0.0) {
+                            *cell = currentRate.exchange;
+                        }
+                    }
+                }
+                
+                for (int i = 0; i < exchangeRateCurrencyCount; i++) {
+                    FillNearestExchangeRates(&exchangeRateMatrix[(long)i * exchangeRateDayCount]);
+                }
+                exchangeRateMatrixLoaded = 1;
+                returnValue = 1;
+            }
+            
+            fclose(exchangeRateFile);
         }
-        
-        if (sortTypeValid == 1 && monthsSorted <= 0) {
-            printf("Error: Sorting failed\n");
-            errorOccurred = 1;
+    }
+    
+    return returnValue;
+}//end function definition LoadExchangeRateMatrix
+
+// ====================== CURRENCY CONVERSION ======================
+
+/*
+ * Function: ConvertCurrencyToUSD
+ * Purpose: Converts amount from specified currency to USD using exchange rates table
+ * Parameters: amount - amount to convert
+ *            currencyCode - 3-character currency code (e.g., "EUR", "GBP")
+ *            transactionDate - date of the transaction for rate lookup
+ * Returns: double - converted amount in USD rounded to 3 decimals, -1.0 if conversion failed
+ * Note: Uses the rate of the closest date if there is none for the exact date
+ *       (precomputed in the exchange rate matrix; dates outside the table use its
+ *       first or last day). Applies 5/4 rounding rule to third decimal place
+ */
+double ConvertCurrencyToUSD(double amount, const char* currencyCode, int transactionDay) {
+    double exchangeRate = -1.0;                        // Rate for the transaction date
+    int rowIndex = -1;                                 // Matrix row of the currency
+    int dayIndex = 0;                                  // Matrix column of the transaction date
+    double convertedAmount = -1.0;                     // Final converted amount (single return pattern)
+    
+    // If currency is already USD, return original amount rounded
+    if (strcmp(currencyCode, "USD") == 0) {
+        convertedAmount = RoundToThirdDecimal(amount);
+    } else if (LoadExchangeRateMatrix() == 1) {
+        rowIndex = FindExchangeRateCurrency(currencyCode);
+        if (rowIndex >= 0) {
+            dayIndex = transactionDay - exchangeRateFirstDay;
+            if (dayIndex < 0) {
+                dayIndex = 0;
+            } else if (dayIndex >= exchangeRateDayCount) {
+                dayIndex = exchangeRateDayCount - 1;
+            }
+            exchangeRate = exchangeRateMatrix[(long)rowIndex * exchangeRateDayCount + dayIndex];
         }
         
-        if (sortTypeValid == 1 && monthsSorted > 0) {
-            time(&sortEndTime);
-            printf("Sorting completed: %d months sorted in %.0f seconds\n",
-                   monthsSorted, difftime(sortEndTime, sortStartTime));
+        if (rowIndex < 0 || exchangeRate <= 0.0) {
+            printf("Warning: No exchange rates found for currency %s\n", currencyCode);
+        } else {
+            // Perform the conversion and apply 5/4 rounding
+            convertedAmount = RoundToThirdDecimal(amount * exchangeRate);
         }
     }
     
-    // Clean up temporary file
-    remove(tempFileName);
+    return convertedAmount;                            // Single return point
+}//end function definition ConvertCurrencyToUSD
+
+// ====================== COLUMNAR SALES TABLE ======================
+// Optional column-per-file copy of SalesTable.dat, written by ConstructDatabaseTables.
+// Scans that need a few fields read only those column files; everything else keeps using
+// the row file, which stays the primary copy.
+
+/*
+ * Function: GetSalesColumnLayout
+ * Purpose: Returns where a column lives inside salesRecord
+ * Parameters: column - SALES_COLUMN_* id
+ *            fieldOffset - receives the field offset in salesRecord
+ *            fieldWidth - receives the field width in bytes
+ *            fileName - receives the column file name (at least 40 bytes)
+ * Returns: void
+ */
+void GetSalesColumnLayout(int column, size_t* fieldOffset, size_t* fieldWidth, char* fileName) {
+    static const char* columnNames[SALES_COLUMN_COUNT] = {
+        "orderNumber", "lineItem", "orderDay", "deliveryDay", "customerKey",
+        "storeKey", "productKey", "quantity", "currencyCode"
+    };                                                 // Field name of each column
+    static const size_t columnOffsets[SALES_COLUMN_COUNT] = {
+        offsetof(salesRecord, orderNumber), offsetof(salesRecord, lineItem),
+        offsetof(salesRecord, orderDay), offsetof(salesRecord, deliveryDay),
+        offsetof(salesRecord, customerKey), offsetof(salesRecord, storeKey),
+        offsetof(salesRecord, productKey), offsetof(salesRecord, quantity),
+        offsetof(salesRecord, currencyCode)
+    };                                                 // Field offset of each column
+    static const size_t columnWidths[SALES_COLUMN_COUNT] = {
+        sizeof(long), sizeof(unsigned char), sizeof(int), sizeof(int),
+        sizeof(unsigned int), sizeof(unsigned short), sizeof(unsigned short),
+        sizeof(unsigned short), sizeof(char[4])
+    };                                                 // Field width of each column
+    
+    *fieldOffset = columnOffsets[column];
+    *fieldWidth = columnWidths[column];
+    sprintf(fileName, "SalesTable.%s.col", columnNames[column]);
+}//end function definition GetSalesColumnLayout
+
+/*
+ * Function: WriteSalesColumnarTable
+ * Purpose: Copies SalesTable.dat rows from firstRow onwards into the column files and
+ *          writes the manifest
+ * Parameters: firstRow - first row to copy; 0 rewrites every column file, a later row
+ *                        keeps the column values before it (they must already be current)
+ * Returns: long - number of rows in the columnar copy, -1 on error
+ * Note: One sequential pass over the copied rows; each field is appended to its column file.
+ *       The manifest is removed first and written last, so an interrupted write leaves no
+ *       usable manifest.
+ */
+long WriteSalesColumnarTable(long firstRow) {
+    FILE* salesFile = NULL;                            // Row-oriented sales table
+    FILE* columnFiles[SALES_COLUMN_COUNT] = {NULL};    // Column files being written
+    FILE* manifestFile = NULL;                         // Manifest file
+    tableHeader salesHeader;                           // Header of the row-oriented table
+    salesColumnarManifest manifest;                    // Manifest contents
+    salesRecord currentSale;                           // Current sales record
+    size_t fieldOffsets[SALES_COLUMN_COUNT];           // Field offset of each column
+    size_t fieldWidths[SALES_COLUMN_COUNT];            // Field width of each column
+    long rowsWritten = firstRow;                       // Rows in the columnar copy
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
     
-    if (errorOccurred == 0) {
-        // Generate report header
-        sprintf(reportTitle, "Report 4: Average Delivery Time Analysis and Trends Over Time");
-        GenerateReportHeader(txtFile, reportTitle);
-        
-        // Open sorted file and read data
-        sortedFile = OpenFileWithErrorCheck(sortedFileName, "rb");
-        if (sortedFile == NULL) {
-            printf("Error: Cannot open sorted delivery data file\n");
+    InitializeStructureToZero(&manifest, sizeof(salesColumnarManifest));
+    remove("SalesTable.manifest");
+    
+    salesFile = OpenBinaryTable("SalesTable.dat", sizeof(salesRecord), &salesHeader);
+    if (salesFile == NULL ||
+        CountedSeek64(salesFile, (long long)sizeof(tableHeader) + (long long)firstRow * (long long)sizeof(salesRecord),
+                      SEEK_SET) != 0) {
+        errorOccurred = 1;
+    }
+    for (int column = 0; column < SALES_COLUMN_COUNT && errorOccurred == 0; column++) {
+        GetSalesColumnLayout(column, &fieldOffsets[column], &fieldWidths[column], manifest.columnFiles[column]);
+        manifest.columnWidths[column] = (unsigned int)fieldWidths[column];
+        columnFiles[column] = OpenFileWithErrorCheck(manifest.columnFiles[column], (firstRow == 0) ? "wb" : "rb+");
+        if (columnFiles[column] == NULL ||
+            CountedSeek64(columnFiles[column], (long long)firstRow * (long long)fieldWidths[column], SEEK_SET) != 0) {
             errorOccurred = 1;
         }
     }
     
-    if (errorOccurred == 0) {
-        // Read all months and calculate statistics
-        WriteToReport(txtFile, "\n=== MONTHLY DELIVERY TIME SUMMARY ===\n");
-        WriteToReport(txtFile, "=====================================\n");
-        WriteToReport(txtFile, "%-10s %10s %12s %10s %10s\n", 
-               "Month", "Orders", "Avg Days", "Min Days", "Max Days");
-        WriteToReport(txtFile, "-----------------------------------------------------------\n");
-        
-        monthsRead = 0;
-        unsigned long totalDeliveryDays = 0;
-        
-        while (fread(&currentMonth, sizeof(monthlyDeliveryData), 1, sortedFile) == 1 && monthsRead < 100) {
-            // Display month data
-            WriteToReport(txtFile, "%04u-%02u %10lu %12.2f %10u %10u\n",
-                   currentMonth.year,
-                   currentMonth.month,
-                   currentMonth.orderCount,
-                   currentMonth.avgDeliveryDays,
-                   currentMonth.minDeliveryDays,
-                   currentMonth.maxDeliveryDays);
-            
-            // Store in array for analysis
-            allMonthsData[monthsRead] = currentMonth;
-            
-            // Accumulate totals
-            totalOrders += currentMonth.orderCount;
-            totalDeliveryDays += currentMonth.totalDeliveryDays;
-            
-            // Update global min/max
-            if (currentMonth.minDeliveryDays < globalMin) {
-                globalMin = currentMonth.minDeliveryDays;
-            }
-            if (currentMonth.maxDeliveryDays > globalMax) {
-                globalMax = currentMonth.maxDeliveryDays;
+    while (errorOccurred == 0 && rowsWritten < salesHeader.rowCount &&
+           CountedRead(&currentSale, sizeof(salesRecord), 1, salesFile) == 1) {
+        for (int column = 0; column < SALES_COLUMN_COUNT && errorOccurred == 0; column++) {
+            if (CountedWrite((const unsigned char*)&currentSale + fieldOffsets[column],
+                       fieldWidths[column], 1, columnFiles[column]) != 1) {
+                printf("Error: Failed to write column file %s\n", manifest.columnFiles[column]);
+                errorOccurred = 1;
             }
-            
-            monthsRead++;
         }
-        
-        // Calculate overall average
-        if (totalOrders > 0) {
-            overallAvg = (double)totalDeliveryDays / (double)totalOrders;
-            overallAvg = RoundToThirdDecimal(overallAvg);
+        rowsWritten++;
+    }
+    
+    for (int column = 0; column < SALES_COLUMN_COUNT; column++) {
+        if (columnFiles[column] != NULL && fclose(columnFiles[column]) != 0) {
+            errorOccurred = 1;
         }
-        
-        WriteToReport(txtFile, "=====================================\n");
-        WriteToReport(txtFile, "%-10s %10lu %12.2f %10u %10u\n", 
-               "OVERALL", totalOrders, overallAvg, globalMin, globalMax);
-        WriteToReport(txtFile, "\nTotal months analyzed: %d\n", monthsRead);
-        
-        // Generate ASCII chart
-        DrawDeliveryTimeChart(txtFile, allMonthsData, monthsRead);
-        
-        // Perform trend analysis
-        AnalyzeDeliveryTrends(txtFile, allMonthsData, monthsRead);
-        
-        // Generate recommendations
-        GenerateDeliveryRecommendations(txtFile, allMonthsData, monthsRead, overallAvg);
-        
-        fclose(sortedFile);
-        
-        GenerateReportFooter(txtFile, startTime);
-        
-        if (txtFile != NULL) {
-            fclose(txtFile);
-            txtFile = NULL;
+    }
+    if (salesFile != NULL) fclose(salesFile);
+    
+    if (errorOccurred == 0) {
+        manifest.magic = SALES_COLUMNAR_MAGIC;
+        manifest.version = SALES_COLUMNAR_VERSION;
+        manifest.rowCount = rowsWritten;
+        manifest.columnCount = SALES_COLUMN_COUNT;
+        manifestFile = OpenFileWithErrorCheck("SalesTable.manifest", "wb");
+        if (manifestFile == NULL ||
+            CountedWrite(&manifest, sizeof(salesColumnarManifest), 1, manifestFile) != 1) {
+            printf("Error: Cannot write SalesTable.manifest\n");
+            errorOccurred = 1;
         }
-        
-        printf("\nReport saved successfully in: %s\n", txtFileName);
-        
-        // Clean up sorted file
-        remove(sortedFileName);
+        if (manifestFile != NULL) fclose(manifestFile);
+    }
+    
+    if (errorOccurred == 0) {
+        returnValue = rowsWritten;
+        printf("Sales columnar copy completed: %ld rows, %d columns\n", rowsWritten, SALES_COLUMN_COUNT);
     } else {
-        // Error occurred - clean up
-        if (txtFile != NULL) {
-            fclose(txtFile);
-            remove(txtFileName);
+        remove("SalesTable.manifest");
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition WriteSalesColumnarTable
+
+/*
+ * Function: BuildSalesColumnarTable
+ * Purpose: Writes the columnar copy of SalesTable.dat and its manifest
+ * Parameters: none
+ * Returns: long - number of rows written, -1 on error
+ */
+long BuildSalesColumnarTable(void) {
+    return WriteSalesColumnarTable(0);
+}//end function definition BuildSalesColumnarTable
+
+/*
+ * Function: AppendSalesColumnarTable
+ * Purpose: Brings the columnar copy up to date after rows were appended to SalesTable.dat
+ * Parameters: none
+ * Returns: long - number of rows in the columnar copy, -1 on error
+ * Note: Only the rows past the manifest's rowCount are copied. A missing or malformed
+ *       manifest, or one describing more rows than the row file, rebuilds the whole copy.
+ */
+long AppendSalesColumnarTable(void) {
+    FILE* manifestFile = NULL;                         // Manifest file
+    salesColumnarManifest manifest;                    // Manifest contents
+    long salesRows = 0;                                // Rows in SalesTable.dat
+    long firstRow = 0;                                 // Rows the copy already holds
+    char fileName[40] = {0};                           // Column file name
+    size_t fieldOffset = 0;                            // Field offset of a column
+    size_t fieldWidth = 0;                             // Field width of a column
+    
+    manifestFile = fopen("SalesTable.manifest", "rb");
+    salesRows = CountTableRecords("SalesTable.dat", sizeof(salesRecord));
+    if (manifestFile != NULL && salesRows >= 0 &&
+        CountedRead(&manifest, sizeof(salesColumnarManifest), 1, manifestFile) == 1 &&
+        manifest.magic == SALES_COLUMNAR_MAGIC && manifest.version == SALES_COLUMNAR_VERSION &&
+        manifest.columnCount == SALES_COLUMN_COUNT && manifest.rowCount <= salesRows) {
+        firstRow = manifest.rowCount;
+        for (int column = 0; column < SALES_COLUMN_COUNT; column++) {
+            GetSalesColumnLayout(column, &fieldOffset, &fieldWidth, fileName);
+            if (manifest.columnWidths[column] != (unsigned int)fieldWidth) {
+                firstRow = 0;
+            }
         }
     }
-}//end function definition GenerateReport4DeliveryTimeAnalysis
+    if (manifestFile != NULL) fclose(manifestFile);
+    
+    return WriteSalesColumnarTable(firstRow);
+}//end function definition AppendSalesColumnarTable
 
-// ====================== REPORT GENERATORS ======================
+/*
+ * Function: CloseSalesColumnReader
+ * Purpose: Closes the column files and frees the buffers of a column reader
+ * Parameters: reader - reader to close (safe to call on a zeroed or failed reader)
+ * Returns: void
+ */
+void CloseSalesColumnReader(salesColumnReader* reader) {
+    for (int column = 0; column < SALES_COLUMN_COUNT; column++) {
+        if (reader->columnFiles[column] != NULL) {
+            fclose(reader->columnFiles[column]);
+            reader->columnFiles[column] = NULL;
+        }
+        free(reader->columnBuffers[column]);
+        reader->columnBuffers[column] = NULL;
+    }
+}//end function definition CloseSalesColumnReader
 
 /*
- * Function: GetReportPreferences
- * Purpose: Asks user for report display preferences (limit, order)
- * Parameters: maxRecords - pointer to store max records to display (0 = all)
- *            ascending - pointer to store sort order (1 = ascending, 0 = descending)
- * Returns: int - 1 if successful, 0 if user cancelled
- * Note: Interactive function to configure report output
+ * Function: OpenSalesColumnReader
+ * Purpose: Opens a projection reader over the columns selected in columnMask
+ * Parameters: reader - reader to initialize
+ *            columnMask - columns to read (combination of SALES_COLUMN_BIT)
+ * Returns: int - 1 if the reader is open, 0 if there is no current columnar copy
+ * Note: The columnar copy is rejected if the manifest is missing or malformed, if a
+ *       column width differs from this build's salesRecord, or if its row count does not
+ *       match SalesTable.dat. Callers then scan the row file instead. Only the projected
+ *       column files are opened.
  */
-int GetReportPreferences(int* maxRecords, int* ascending) {
-    int limitChoice = 0;
-    int orderChoice = 0;
-    int returnValue = 1;  // Default success value
-    int errorOccurred = 0;  // Error flag for single return pattern
+int OpenSalesColumnReader(salesColumnReader* reader, unsigned int columnMask) {
+    FILE* manifestFile = NULL;                         // Manifest file
+    salesColumnarManifest manifest;                    // Manifest contents
+    char fileName[40] = {0};                           // Column file name
+    long salesRows = -1;                               // Rows in SalesTable.dat
+    int isValid = 0;                                   // Manifest usable flag
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    printf("\n=== Report Configuration ===\n");
+    InitializeStructureToZero(reader, sizeof(salesColumnReader));
+    reader->columnMask = columnMask;
+    
+    manifestFile = fopen("SalesTable.manifest", "rb");
+    if (manifestFile != NULL &&
+        CountedRead(&manifest, sizeof(salesColumnarManifest), 1, manifestFile) == 1) {
+        salesRows = CountTableRecords("SalesTable.dat", sizeof(salesRecord));
+        isValid = (manifest.magic == SALES_COLUMNAR_MAGIC && manifest.version == SALES_COLUMNAR_VERSION &&
+                   manifest.columnCount == SALES_COLUMN_COUNT && manifest.rowCount == salesRows) ? 1 : 0;
+        for (int column = 0; column < SALES_COLUMN_COUNT && isValid == 1; column++) {
+            GetSalesColumnLayout(column, &reader->fieldOffsets[column], &reader->fieldWidths[column], fileName);
+            if (manifest.columnWidths[column] != (unsigned int)reader->fieldWidths[column]) {
+                isValid = 0;
+            }
+        }
+    }
+    if (manifestFile != NULL) fclose(manifestFile);
     
-    // Ask about record limit
-    printf("How many records do you want to display?\n");
-    printf("1. All records\n");
-    printf("2. Specific number of records\n");
-    printf("Your choice: ");
-    
-    if (scanf("%d", &limitChoice) != 1) {
-        printf("Invalid input.\n");
-        while (getchar() != '\n');
-        errorOccurred = 1;
-        returnValue = 0;
+    if (isValid == 1) {
+        reader->rowCount = manifest.rowCount;
+        for (int column = 0; column < SALES_COLUMN_COUNT && isValid == 1; column++) {
+            if ((columnMask & SALES_COLUMN_BIT(column)) != 0) {
+                manifest.columnFiles[column][sizeof(manifest.columnFiles[column]) - 1] = '\0';
+                reader->columnFiles[column] = fopen(manifest.columnFiles[column], "rb");
+                reader->columnBuffers[column] = (unsigned char*)malloc((size_t)SALES_COLUMN_READ_BATCH *
+                                                                       manifest.columnWidths[column]);
+                if (reader->columnFiles[column] == NULL || reader->columnBuffers[column] == NULL) {
+                    isValid = 0;
+                }
+            }
+        }
+        if (isValid == 0) {
+            CloseSalesColumnReader(reader);
+        }
     }
     
-    if (errorOccurred == 0) {
-        if (limitChoice == 1) {
-            *maxRecords = 0;  // 0 means all records
-        } else if (limitChoice == 2) {
-            printf("Enter the number of records to display: ");
-            if (scanf("%d", maxRecords) != 1 || *maxRecords < 1) {
-                printf("Invalid number.\n");
-                while (getchar() != '\n');
-                errorOccurred = 1;
+    returnValue = isValid;
+    return returnValue;                                // Single return point
+}//end function definition OpenSalesColumnReader
+
+/*
+ * Function: ReadSalesColumnRow
+ * Purpose: Returns the next row of a column reader
+ * Parameters: reader - open column reader
+ *            row - receives the projected fields; other fields are left zero
+ * Returns: int - 1 if a row was returned, 0 at end of table or on a short read
+ * Note: Columns are read in batches of SALES_COLUMN_READ_BATCH values
+ */
+int ReadSalesColumnRow(salesColumnReader* reader, salesRecord* row) {
+    long rowsLeft = 0;                                 // Rows not yet buffered
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    if (reader->batchPosition == reader->batchRows && reader->rowsDelivered < reader->rowCount) {
+        // Refill every projected column with the next batch
+        rowsLeft = reader->rowCount - reader->rowsDelivered;
+        reader->batchRows = (rowsLeft < SALES_COLUMN_READ_BATCH) ? rowsLeft : SALES_COLUMN_READ_BATCH;
+        reader->batchPosition = 0;
+        for (int column = 0; column < SALES_COLUMN_COUNT; column++) {
+            if (reader->columnFiles[column] != NULL) {
+                if (CountedRead(reader->columnBuffers[column], reader->fieldWidths[column], (size_t)reader->batchRows,
+                          reader->columnFiles[column]) != (size_t)reader->batchRows) {
+                    printf("Error: Short read in sales column %d\n", column);
+                    reader->batchRows = 0;
+                    reader->rowCount = reader->rowsDelivered;
+                }
+            }
+        }
+    }
+    
+    if (reader->batchPosition < reader->batchRows) {
+        InitializeStructureToZero(row, sizeof(salesRecord));
+        for (int column = 0; column < SALES_COLUMN_COUNT; column++) {
+            if (reader->columnBuffers[column] != NULL) {
+                memcpy((unsigned char*)row + reader->fieldOffsets[column],
+                       reader->columnBuffers[column] + (size_t)reader->batchPosition * reader->fieldWidths[column],
+                       reader->fieldWidths[column]);
+            }
+        }
+        reader->batchPosition++;
+        reader->rowsDelivered++;
+        returnValue = 1;
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition ReadSalesColumnRow
+
+/*
+ * Function: SkipSalesColumnRows
+ * Purpose: Moves a column reader past rows without returning them
+ * Parameters: reader - open column reader
+ *            rowCount - rows to skip (at most the rows left)
+ * Returns: int - 1 if the rows were skipped, 0 on a seek error
+ * Note: Rows still in the current batch are dropped from it; the rest are skipped by
+ *       seeking each projected column file, so their values are never read
+ */
+int SkipSalesColumnRows(salesColumnReader* reader, long rowCount) {
+    long bufferedRows = reader->batchRows - reader->batchPosition; // Rows left in the batch
+    long seekRows = 0;                                 // Rows past the batch
+    int returnValue = 1;                               // Return value (single return pattern)
+    
+    if (rowCount <= bufferedRows) {
+        reader->batchPosition += rowCount;
+    } else {
+        seekRows = rowCount - bufferedRows;
+        reader->batchPosition = reader->batchRows;
+        for (int column = 0; column < SALES_COLUMN_COUNT; column++) {
+            if (reader->columnFiles[column] != NULL &&
+                CountedSeek64(reader->columnFiles[column], (long long)seekRows * (long long)reader->fieldWidths[column],
+                              SEEK_CUR) != 0) {
+                printf("Error: Cannot seek in sales column %d\n", column);
                 returnValue = 0;
             }
-        } else {
-            printf("Invalid choice.\n");
-            errorOccurred = 1;
-            returnValue = 0;
         }
     }
+    reader->rowsDelivered += rowCount;
     
-    // Ask about sort order only if no errors occurred
+    return returnValue;                                // Single return point
+}//end function definition SkipSalesColumnRows
+
+// ====================== SALES ZONE MAP ======================
+// SalesTable.zonemap records the order date, delivery date, customer key and product key
+// range of every SALES_ZONE_BLOCK_ROWS rows of SalesTable.dat. A filtered scan skips
+// each block whose ranges cannot hold a matching sale without reading its rows.
+
+/*
+ * Function: InitializeSalesScanFilter
+ * Purpose: Prepares a filter that every sale passes
+ * Parameters: filter - filter to initialize
+ * Returns: void
+ */
+void InitializeSalesScanFilter(salesScanFilter* filter) {
+    filter->firstOrderDay = INT_MIN;
+    filter->lastOrderDay = INT_MAX;
+    filter->firstDeliveryDay = INT_MIN;
+    filter->lastDeliveryDay = INT_MAX;
+    filter->firstCustomerKey = 0;
+    filter->lastCustomerKey = UINT_MAX;
+    filter->firstProductKey = 0;
+    filter->lastProductKey = USHRT_MAX;
+}//end function definition InitializeSalesScanFilter
+
+/*
+ * Function: SaleMatchesScanFilter
+ * Purpose: Tells whether a sale falls inside every range of a filter
+ * Parameters: sale - sales record (order date, delivery date and both keys filled in)
+ *            filter - ranges to test
+ * Returns: int - 1 if the sale matches, 0 otherwise
+ */
+int SaleMatchesScanFilter(const salesRecord* sale, const salesScanFilter* filter) {
+    return (sale->orderDay >= filter->firstOrderDay && sale->orderDay <= filter->lastOrderDay &&
+            sale->deliveryDay >= filter->firstDeliveryDay && sale->deliveryDay <= filter->lastDeliveryDay &&
+            sale->customerKey >= filter->firstCustomerKey && sale->customerKey <= filter->lastCustomerKey &&
+            sale->productKey >= filter->firstProductKey && sale->productKey <= filter->lastProductKey) ? 1 : 0;
+}//end function definition SaleMatchesScanFilter
+
+/*
+ * Function: SalesZoneMayMatch
+ * Purpose: Tells whether a block can hold a sale that passes a filter
+ * Parameters: entry - value ranges of the block
+ *            filter - ranges to test
+ * Returns: int - 1 if every filter range overlaps the block's range, 0 if the block can be skipped
+ */
+int SalesZoneMayMatch(const salesZoneEntry* entry, const salesScanFilter* filter) {
+    return (entry->maxOrderDay >= filter->firstOrderDay && entry->minOrderDay <= filter->lastOrderDay &&
+            entry->maxDeliveryDay >= filter->firstDeliveryDay && entry->minDeliveryDay <= filter->lastDeliveryDay &&
+            entry->maxCustomerKey >= filter->firstCustomerKey && entry->minCustomerKey <= filter->lastCustomerKey &&
+            entry->maxProductKey >= filter->firstProductKey && entry->minProductKey <= filter->lastProductKey) ? 1 : 0;
+}//end function definition SalesZoneMayMatch
+
+/*
+ * Function: WriteSalesZoneMap
+ * Purpose: Computes the block ranges of SalesTable.dat from firstRow onwards and writes
+ *          them to SalesTable.zonemap
+ * Parameters: firstRow - first row to summarize, a multiple of SALES_ZONE_BLOCK_ROWS;
+ *                        0 rewrites the whole map, a later row keeps the entries before it
+ * Returns: long - number of blocks in the map, -1 on error
+ * Note: Rows are read in place from the mapped table. The header is written last, so an
+ *       interrupted write never leaves a map that matches the table.
+ */
+long WriteSalesZoneMap(long firstRow) {
+    mappedTable salesTable;                            // Mapped sales table
+    FILE* zoneFile = NULL;                             // Zone map file
+    salesZoneMapHeader zoneHeader;                     // Zone map header
+    salesZoneEntry entry;                              // Ranges of the current block
+    const salesRecord* sale = NULL;                    // Current sale
+    long blockCount = firstRow / SALES_ZONE_BLOCK_ROWS; // Blocks written
+    long row = firstRow;                               // Current row
+    int orderDay = 0;                                  // Order date of the current sale
+    int deliveryDay = 0;                               // Delivery date of the current sale
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    InitializeStructureToZero(&salesTable, sizeof(mappedTable));
+    InitializeStructureToZero(&zoneHeader, sizeof(salesZoneMapHeader));
+    InitializeStructureToZero(&entry, sizeof(salesZoneEntry));
+    
+    if (OpenMappedBinaryTable(&salesTable, "SalesTable.dat", sizeof(salesRecord), TABLE_ACCESS_SEQUENTIAL, NULL) == 0) {
+        errorOccurred = 1;
+    }
     if (errorOccurred == 0) {
-        printf("\nSort order:\n");
-        printf("1. Ascending (A-Z, 0-9)\n");
-        printf("2. Descending (Z-A, 9-0)\n");
-        printf("Your choice: ");
-        
-        if (scanf("%d", &orderChoice) != 1) {
-            printf("Invalid input.\n");
-            while (getchar() != '\n');
+        // A new map starts with a zeroed header, which no reader accepts until it is replaced
+        zoneFile = OpenFileWithErrorCheck("SalesTable.zonemap", (firstRow == 0) ? "wb" : "rb+");
+        if (zoneFile == NULL ||
+            (firstRow == 0 && CountedWrite(&zoneHeader, sizeof(salesZoneMapHeader), 1, zoneFile) != 1) ||
+            CountedSeek(zoneFile, (long)sizeof(salesZoneMapHeader) + blockCount * (long)sizeof(salesZoneEntry),
+                        SEEK_SET) != 0) {
             errorOccurred = 1;
-            returnValue = 0;
         }
     }
     
-    if (errorOccurred == 0) {
-        if (orderChoice == 1) {
-            *ascending = 1;
-        } else if (orderChoice == 2) {
-            *ascending = 0;
+    while (errorOccurred == 0 && row < salesTable.recordCount) {
+        sale = (const salesRecord*)MappedRecordAt(&salesTable, row);
+        orderDay = sale->orderDay;
+        deliveryDay = sale->deliveryDay;
+        if (row % SALES_ZONE_BLOCK_ROWS == 0) {
+            entry.minOrderDay = orderDay;
+            entry.maxOrderDay = orderDay;
+            entry.minDeliveryDay = deliveryDay;
+            entry.maxDeliveryDay = deliveryDay;
+            entry.minCustomerKey = sale->customerKey;
+            entry.maxCustomerKey = sale->customerKey;
+            entry.minProductKey = sale->productKey;
+            entry.maxProductKey = sale->productKey;
         } else {
-            printf("Invalid choice.\n");
+            if (orderDay < entry.minOrderDay) entry.minOrderDay = orderDay;
+            if (orderDay > entry.maxOrderDay) entry.maxOrderDay = orderDay;
+            if (deliveryDay < entry.minDeliveryDay) entry.minDeliveryDay = deliveryDay;
+            if (deliveryDay > entry.maxDeliveryDay) entry.maxDeliveryDay = deliveryDay;
+            if (sale->customerKey < entry.minCustomerKey) entry.minCustomerKey = sale->customerKey;
+            if (sale->customerKey > entry.maxCustomerKey) entry.maxCustomerKey = sale->customerKey;
+            if (sale->productKey < entry.minProductKey) entry.minProductKey = sale->productKey;
+            if (sale->productKey > entry.maxProductKey) entry.maxProductKey = sale->productKey;
+        }
+        row++;
+    
+        // A block is complete at its last row or at the end of the table
+        if (row % SALES_ZONE_BLOCK_ROWS == 0 || row == salesTable.recordCount) {
+            if (CountedWrite(&entry, sizeof(salesZoneEntry), 1, zoneFile) != 1) {
+                errorOccurred = 1;
+            }
+            blockCount++;
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        zoneHeader.magic = SALES_ZONE_MAP_MAGIC;
+        zoneHeader.version = SALES_ZONE_MAP_VERSION;
+        zoneHeader.blockRows = SALES_ZONE_BLOCK_ROWS;
+        zoneHeader.rowCount = salesTable.recordCount;
+        zoneHeader.blockCount = blockCount;
+        if (CountedSeek(zoneFile, 0, SEEK_SET) != 0 ||
+            CountedWrite(&zoneHeader, sizeof(salesZoneMapHeader), 1, zoneFile) != 1) {
             errorOccurred = 1;
-            returnValue = 0;
         }
     }
+    if (zoneFile != NULL && fclose(zoneFile) != 0) {
+        errorOccurred = 1;
+    }
+    CloseMappedTable(&salesTable);
     
-    return returnValue;  // Single return point
-}//end function definition GetReportPreferences
+    if (errorOccurred == 0) {
+        returnValue = blockCount;
+        printf("Sales zone map completed: %ld blocks of %d rows\n", blockCount, SALES_ZONE_BLOCK_ROWS);
+    } else {
+        printf("Error: Cannot write SalesTable.zonemap\n");
+        remove("SalesTable.zonemap");
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition WriteSalesZoneMap
 
 /*
- * Function: SearchInReport2
- * Purpose: Allows user to search for specific products in Report 2 sorted data
- * Parameters: sortedFileName - name of the sorted report file
- * Returns: void
- * Note: Interactive binary search with multiple search criteria options
+ * Function: ReadSalesZoneMapHeader
+ * Purpose: Reads the header of SalesTable.zonemap and checks it against this build
+ * Parameters: zoneHeader - receives the header
+ * Returns: int - 1 if the file exists and has this build's format and block size, 0 otherwise
  */
-void SearchInReport2(const char* sortedFileName) {
-    char searchProductName[31] = {0};
-    char searchContinent[20] = {0};
-    char searchCountry[20] = {0};
-    productCustomerRecord searchKey;
-    productCustomerRecord foundRecord;
-    long startPos = -1;
-    long endPos = -1;
-    FILE* sortedFile = NULL;
-    int searchResult = 0;
-    int continueSearching = 1;
-    char choice = 'n';
-    int searchOption = 0;
+int ReadSalesZoneMapHeader(salesZoneMapHeader* zoneHeader) {
+    FILE* zoneFile = NULL;                             // Zone map file
+    int returnValue = 0;                               // Return value (single return pattern)
     
-    printf("\n=== Search in Report 2 ===\n");
+    zoneFile = fopen("SalesTable.zonemap", "rb");
+    if (zoneFile != NULL &&
+        CountedRead(zoneHeader, sizeof(salesZoneMapHeader), 1, zoneFile) == 1 &&
+        zoneHeader->magic == SALES_ZONE_MAP_MAGIC && zoneHeader->version == SALES_ZONE_MAP_VERSION &&
+        zoneHeader->blockRows == SALES_ZONE_BLOCK_ROWS && zoneHeader->rowCount >= 0 &&
+        zoneHeader->blockCount == (zoneHeader->rowCount + SALES_ZONE_BLOCK_ROWS - 1) / SALES_ZONE_BLOCK_ROWS) {
+        returnValue = 1;
+    }
+    if (zoneFile != NULL) fclose(zoneFile);
     
-    while (continueSearching == 1) {
-        printf("\nSearch options:\n");
-        printf("1. Search by Product Name\n");
-        printf("2. Search by Product Name + Continent\n");
-        printf("3. Search by Product Name + Continent + Country\n");
-        printf("4. Browse all records\n");
-        printf("0. Exit search\n");
-        printf("Your choice: ");
-        
-        if (scanf("%d", &searchOption) != 1) {
-            printf("Invalid input.\n");
-            while (getchar() != '\n');
-            searchOption = 0;
+    return returnValue;                                // Single return point
+}//end function definition ReadSalesZoneMapHeader
+
+/*
+ * Function: BuildSalesZoneMap
+ * Purpose: Writes the zone map of the whole SalesTable.dat
+ * Parameters: none
+ * Returns: long - number of blocks written, -1 on error
+ */
+long BuildSalesZoneMap(void) {
+    return WriteSalesZoneMap(0);
+}//end function definition BuildSalesZoneMap
+
+/*
+ * Function: AppendSalesZoneMap
+ * Purpose: Brings the zone map up to date after rows were appended to SalesTable.dat
+ * Parameters: none
+ * Returns: long - number of blocks in the map, -1 on error
+ * Note: Complete blocks keep their entries; the last partial block is summarized again
+ *       together with the appended rows. A missing or foreign map, or one describing
+ *       more rows than the table, is rebuilt.
+ */
+long AppendSalesZoneMap(void) {
+    salesZoneMapHeader zoneHeader;                     // Header of the current map
+    long salesRows = 0;                                // Rows in SalesTable.dat
+    long firstRow = 0;                                 // First row to summarize
+    
+    salesRows = CountTableRecords("SalesTable.dat", sizeof(salesRecord));
+    if (ReadSalesZoneMapHeader(&zoneHeader) == 1 && zoneHeader.rowCount <= salesRows) {
+        firstRow = (long)(zoneHeader.rowCount / SALES_ZONE_BLOCK_ROWS) * SALES_ZONE_BLOCK_ROWS;
+    }
+    
+    return WriteSalesZoneMap(firstRow);
+}//end function definition AppendSalesZoneMap
+
+/*
+ * Function: FreeSalesZoneMap
+ * Purpose: Releases the entries of a loaded zone map
+ * Parameters: zoneMap - map to free (safe to call on a zeroed map)
+ * Returns: void
+ */
+void FreeSalesZoneMap(salesZoneMap* zoneMap) {
+    free(zoneMap->entries);
+    InitializeStructureToZero(zoneMap, sizeof(salesZoneMap));
+}//end function definition FreeSalesZoneMap
+
+/*
+ * Function: LoadSalesZoneMap
+ * Purpose: Reads the zone map of SalesTable.dat into memory
+ * Parameters: zoneMap - receives the map (zeroed when none is usable)
+ *            salesRows - rows SalesTable.dat holds now
+ * Returns: int - 1 if a current map was loaded, 0 if there is none
+ * Note: A map describing another row count is stale and ignored; the scan then reads
+ *       every block
+ */
+int LoadSalesZoneMap(salesZoneMap* zoneMap, long salesRows) {
+    FILE* zoneFile = NULL;                             // Zone map file
+    salesZoneMapHeader zoneHeader;                     // Zone map header
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    InitializeStructureToZero(zoneMap, sizeof(salesZoneMap));
+    if (ReadSalesZoneMapHeader(&zoneHeader) == 1 && zoneHeader.rowCount == salesRows) {
+        zoneMap->entries = (salesZoneEntry*)malloc(((size_t)zoneHeader.blockCount + 1) * sizeof(salesZoneEntry));
+        zoneFile = fopen("SalesTable.zonemap", "rb");
+        if (zoneMap->entries != NULL && zoneFile != NULL &&
+            CountedSeek(zoneFile, (long)sizeof(salesZoneMapHeader), SEEK_SET) == 0 &&
+            CountedRead(zoneMap->entries, sizeof(salesZoneEntry), (size_t)zoneHeader.blockCount, zoneFile) ==
+                (size_t)zoneHeader.blockCount) {
+            zoneMap->blockRows = (long)zoneHeader.blockRows;
+            zoneMap->blockCount = (long)zoneHeader.blockCount;
+            returnValue = 1;
         }
-        
-        if (searchOption == 0) {
-            continueSearching = 0;
-        } else if (searchOption >= 1 && searchOption <= 4) {
-            // Initialize search key
-            InitializeStructureToZero(&searchKey, sizeof(productCustomerRecord));
-            
-            if (searchOption >= 1) {
-                printf("Enter product name to search: ");
-                scanf(" %30[^\n]", searchProductName);
-                strncpy(searchKey.product.productName, searchProductName, 29);
-                searchKey.product.productName[29] = '\0';
-            }
-            
-            if (searchOption >= 2) {
-                printf("Enter continent: ");
-                scanf(" %19[^\n]", searchContinent);
-                strncpy(searchKey.customer.continent, searchContinent, 19);
-                searchKey.customer.continent[19] = '\0';
+        if (zoneFile != NULL) fclose(zoneFile);
+    }
+    if (returnValue == 0) {
+        FreeSalesZoneMap(zoneMap);
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition LoadSalesZoneMap
+
+// ====================== SHARED SALES SCAN ======================
+// Reports 3 and 4 aggregate the same fact table. All their aggregates are registered on one
+// scan of SalesTable.dat and kept for the process, so generating both reads the table once.
+// The scan can be limited to an order date window, which then applies to both reports.
+
+/*
+ * Structure: MonthlySalesAggregate
+ * Purpose: Orders and revenue per (year, month) of order date, in order of first appearance
+ * Note: months grows with the history; monthSlots finds a month's entry without a search
+ */
+typedef struct {
+    monthlySalesData* months;                          // Monthly totals
+    int monthCount;                                    // Months in use
+    int monthCapacity;                                 // Months allocated
+    int monthSlots[CALENDAR_MONTH_SLOTS];              // Month index + 1 of each calendar month, 0 = not seen
+} MonthlySalesAggregate;
+
+/*
+ * Structure: CategoryQuarterAggregate
+ * Purpose: Orders and revenue per product category and quarter
+ * Note: Sales find their category by indexing categorySlots with the category code
+ */
+typedef struct {
+    categorySeasonalData categories[20];               // Category totals (max 20 categories)
+    int categoryCount;                                 // Categories in use
+    unsigned char categorySlots[DICTIONARY_MAX_VALUES]; // Category index + 1 of each code, 0 = not seen
+} CategoryQuarterAggregate;
+
+/*
+ * Structure: RegionQuarterAggregate
+ * Purpose: Orders and revenue per customer continent and quarter
+ * Note: Sales find their region by indexing regionSlots with the continent code
+ */
+typedef struct {
+    regionSeasonalData regions[10];                    // Region totals (max 10 regions)
+    int regionCount;                                   // Regions in use
+    unsigned char regionSlots[DICTIONARY_MAX_VALUES];  // Region index + 1 of each code, 0 = not seen
+} RegionQuarterAggregate;
+
+/*
+ * Structure: MonthlyDeliveryAggregate
+ * Purpose: Delivery time count/sum/min/max per (year, month) of order date
+ * Note: months grows with the history; monthSlots finds a month's entry without a search
+ */
+typedef struct {
+    monthlyDeliveryData* months;                       // Monthly delivery statistics
+    int monthCount;                                    // Months in use
+    int monthCapacity;                                 // Months allocated
+    int monthSlots[CALENDAR_MONTH_SLOTS];              // Month index + 1 of each calendar month, 0 = not seen
+} MonthlyDeliveryAggregate;
+
+/*
+ * Structure: SalesScanAggregator
+ * Purpose: One aggregate registered on the shared sales scan
+ * Note: accumulate receives every sale with its product and customer, either of which
+ *       is NULL when the dimension has no matching row. Customers are only looked up
+ *       when some aggregate names SALES_COLUMN_CUSTOMER_KEY in its columnMask. Only the
+ *       fields named in columnMask are guaranteed to be filled in the sale.
+ */
+typedef struct {
+    void (*accumulate)(const salesRecord*, const productRecord*, const customerRecord*, void*);
+    void* state;                                       // Aggregate state passed to accumulate
+    unsigned int columnMask;                           // Sales columns read by accumulate (SALES_COLUMN_BIT)
+} SalesScanAggregator;
+
+static MonthlySalesAggregate scanMonthlySales;        // Report 3 monthly totals
+static CategoryQuarterAggregate scanCategoryQuarters; // Report 3 category quarters
+static RegionQuarterAggregate scanRegionQuarters;     // Report 3 region quarters
+static MonthlyDeliveryAggregate scanMonthlyDelivery;  // Report 4 monthly delivery statistics
+static long scanSalesRecords = 0;                     // Sales records read by the scan
+static int salesScanLoaded = 0;                       // 1 once the shared scan has run
+static int reportWindowActive = 0;                    // 1 when Reports 3 and 4 use an order date window
+static dateStructure reportWindowFirstDate;           // First order date of the window (year 0 = open)
+static dateStructure reportWindowLastDate;            // Last order date of the window (year 0 = open)
+static salesScanFilter reportWindowFilter;            // Scan filter of the window
+
+/*
+ * Function: SetReportDateWindow
+ * Purpose: Limits Reports 3 and 4 to sales ordered inside a date window
+ * Parameters: firstDate - first order date (NULL = from the earliest sale)
+ *            lastDate - last order date (NULL = up to the latest sale)
+ * Returns: void
+ * Note: Both NULL removes the window. The shared scan results are discarded, so the
+ *       next report scans again with the new window.
+ */
+void SetReportDateWindow(const dateStructure* firstDate, const dateStructure* lastDate) {
+    InitializeSalesScanFilter(&reportWindowFilter);
+    InitializeStructureToZero(&reportWindowFirstDate, sizeof(dateStructure));
+    InitializeStructureToZero(&reportWindowLastDate, sizeof(dateStructure));
+    if (firstDate != NULL) {
+        reportWindowFirstDate = *firstDate;
+        reportWindowFilter.firstOrderDay = DateToDayNumber(firstDate);
+    }
+    if (lastDate != NULL) {
+        reportWindowLastDate = *lastDate;
+        reportWindowFilter.lastOrderDay = DateToDayNumber(lastDate);
+    }
+    reportWindowActive = (firstDate != NULL || lastDate != NULL) ? 1 : 0;
+    salesScanLoaded = 0;
+}//end function definition SetReportDateWindow
+
+/*
+ * Function: WriteReportDateWindow
+ * Purpose: Writes the order date window of Reports 3 and 4 under a report header
+ * Parameters: txtFile - output file pointer (NULL to write only to console)
+ * Returns: void
+ * Note: Writes nothing when the reports cover the whole history
+ */
+void WriteReportDateWindow(FILE* txtFile) {
+    char firstText[16] = "earliest sale";         // First order date as text
+    char lastText[16] = "latest sale";            // Last order date as text
+    
+    if (reportWindowActive == 1) {
+        if (reportWindowFirstDate.yearValue != 0) {
+            sprintf(firstText, "%d/%d/%d", reportWindowFirstDate.monthOfYear,
+                    reportWindowFirstDate.dayOfMonth, reportWindowFirstDate.yearValue);
+        }
+        if (reportWindowLastDate.yearValue != 0) {
+            sprintf(lastText, "%d/%d/%d", reportWindowLastDate.monthOfYear,
+                    reportWindowLastDate.dayOfMonth, reportWindowLastDate.yearValue);
+        }
+        WriteReportSummary(txtFile, "Order dates from %s to %s\n", firstText, lastText);
+    }
+}//end function definition WriteReportDateWindow
+
+/*
+ * Function: FindAggregateMonth
+ * Purpose: Returns the entry of a calendar month in a monthly aggregate, adding it if new
+ * Parameters: monthSlots - month index + 1 of each calendar month (CALENDAR_MONTH_SLOTS entries)
+ *            months - entry array, grown when full
+ *            monthCount - entries in use
+ *            monthCapacity - entries allocated
+ *            recordSize - size of one entry
+ *            slot - calendar month wanted (DayNumberToMonthSlot)
+ * Returns: int - entry index, -1 if the slot is invalid or memory is exhausted
+ * Note: A new entry is zeroed (month 0) for the caller to fill in. Entries stay in
+ *       order of first appearance.
+ */
+int FindAggregateMonth(int* monthSlots, void** months, int* monthCount, int* monthCapacity,
+                       size_t recordSize, int slot) {
+    int newCapacity = 0;                               // Grown entry count
+    void* grownMonths = NULL;                          // Grown entry array
+    int returnValue = -1;                              // Return value (single return pattern)
+    
+    if (slot >= 0 && slot < CALENDAR_MONTH_SLOTS) {
+        returnValue = monthSlots[slot] - 1;
+        if (returnValue < 0) {
+            if (*monthCount == *monthCapacity) {
+                newCapacity = (*monthCapacity > 0) ? *monthCapacity * 2 : 64;
+                grownMonths = realloc(*months, (size_t)newCapacity * recordSize);
+                if (grownMonths != NULL) {
+                    *months = grownMonths;
+                    *monthCapacity = newCapacity;
+                }
             }
+            if (*monthCount < *monthCapacity) {
+                returnValue = *monthCount;
+                memset((unsigned char*)*months + (size_t)returnValue * recordSize, 0, recordSize);
+                monthSlots[slot] = returnValue + 1;
+                (*monthCount)++;
+            }
+        }
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition FindAggregateMonth
+
+/*
+ * Function: CalculateDeliveryDays
+ * Purpose: Calculates the number of days between order and delivery dates
+ * Parameters: orderDay - order date as a day number
+ *            deliveryDay - delivery date as a day number (DAY_NUMBER_NONE if not delivered)
+ * Returns: int - number of days between dates (0 if same day, -1 if invalid)
+ * Note: Day numbers are exact, so the result is the true calendar difference
+ */
+int CalculateDeliveryDays(int orderDay, int deliveryDay) {
+    int result = -1;                                   // Return value
+    
+    if (orderDay != DAY_NUMBER_NONE && deliveryDay != DAY_NUMBER_NONE && deliveryDay >= orderDay) {
+        result = deliveryDay - orderDay;
+    }
+    
+    return result;                                     // Single return point
+}//end function definition CalculateDeliveryDays
+
+/*
+ * Function: AccumulateMonthlySale
+ * Purpose: Shared scan aggregate adding one sale to its order month
+ * Parameters: sale - current sales record
+ *            product - matching product (NULL if none; the order still counts)
+ *            customer - unused
+ *            state - MonthlySalesAggregate
+ * Returns: void
+ */
+void AccumulateMonthlySale(const salesRecord* sale, const productRecord* product,
+                           const customerRecord* customer, void* state) {
+    MonthlySalesAggregate* aggregate = (MonthlySalesAggregate*)state; // Monthly totals
+    monthlySalesData* months = NULL;                                  // Month array
+    int monthSlot = DayNumberToMonthSlot(sale->orderDay);             // Calendar month of this sale
+    int monthIndex = -1;                                              // Month of this sale
+    double lineRevenue = 0.0;                                         // Revenue for current line
+    
+    (void)customer;
+    
+    // Find the month's entry, creating it for a new month
+    monthIndex = FindAggregateMonth(aggregate->monthSlots, (void**)&aggregate->months, &aggregate->monthCount,
+                                    &aggregate->monthCapacity, sizeof(monthlySalesData), monthSlot);
+    months = aggregate->months;
+    if (monthIndex >= 0 && months[monthIndex].month == 0) {
+        months[monthIndex].year = (unsigned short)(CALENDAR_FIRST_YEAR + monthSlot / 12);
+        months[monthIndex].month = (unsigned char)(monthSlot % 12 + 1);
+    }
+    
+    if (monthIndex >= 0) {
+        // Increment order count (one order = one sale record)
+        months[monthIndex].orderCount++;
+        
+        if (product != NULL) {
+            // Calculate revenue: price * quantity
+            lineRevenue = product->unitPriceUSD * (double)sale->quantity;
+            lineRevenue = RoundToThirdDecimal(lineRevenue);
+            months[monthIndex].totalRevenue += lineRevenue;
+        }
+    }
+}//end function definition AccumulateMonthlySale
+
+/*
+ * Function: AccumulateCategorySale
+ * Purpose: Shared scan aggregate adding one sale to its product category's quarter
+ * Parameters: sale - current sales record
+ *            product - matching product (sales without one are skipped)
+ *            customer - unused
+ *            state - CategoryQuarterAggregate
+ * Returns: void
+ */
+void AccumulateCategorySale(const salesRecord* sale, const productRecord* product,
+                            const customerRecord* customer, void* state) {
+    CategoryQuarterAggregate* aggregate = (CategoryQuarterAggregate*)state; // Category totals
+    categorySeasonalData* categories = aggregate->categories;               // Category array
+    int categoryIndex = -1;                                                 // Category of this sale
+    
+    (void)customer;
+    
+    if (product != NULL) {
+        // Find or create category entry
+        categoryIndex = (int)aggregate->categorySlots[product->category] - 1;
+        if (categoryIndex < 0 && aggregate->categoryCount < 20) {
+            categoryIndex = aggregate->categoryCount;
+            strncpy(categories[categoryIndex].category,
+                    DecodeDictionaryValue(BINARY_TABLE_PRODUCTS, PRODUCT_DICTIONARY_CATEGORY, product->category), 19);
+            categories[categoryIndex].category[19] = '\0';
+            aggregate->categorySlots[product->category] = (unsigned char)(categoryIndex + 1);
+            aggregate->categoryCount++;
+        }
+        
+        if (categoryIndex >= 0) {
+            double lineRevenue = product->unitPriceUSD * sale->quantity;
+            lineRevenue = RoundToThirdDecimal(lineRevenue);
             
-            if (searchOption >= 3) {
-                printf("Enter country: ");
-                scanf(" %19[^\n]", searchCountry);
-                strncpy(searchKey.customer.country, searchCountry, 19);
-                searchKey.customer.country[19] = '\0';
+            // Assign to quarter
+            int month = DayNumberToMonthSlot(sale->orderDay) % 12 + 1;
+            if (month >= 1 && month <= 3) {
+                categories[categoryIndex].q1Revenue += lineRevenue;
+                categories[categoryIndex].q1Orders++;
+            } else if (month >= 4 && month <= 6) {
+                categories[categoryIndex].q2Revenue += lineRevenue;
+                categories[categoryIndex].q2Orders++;
+            } else if (month >= 7 && month <= 9) {
+                categories[categoryIndex].q3Revenue += lineRevenue;
+                categories[categoryIndex].q3Orders++;
+            } else if (month >= 10 && month <= 12) {
+                categories[categoryIndex].q4Revenue += lineRevenue;
+                categories[categoryIndex].q4Orders++;
             }
+        }
+    }
+}//end function definition AccumulateCategorySale
+
+/*
+ * Function: AccumulateRegionSale
+ * Purpose: Shared scan aggregate adding one sale to its customer region's quarter
+ * Parameters: sale - current sales record
+ *            product - matching product (provides unit price)
+ *            customer - matching customer (provides continent)
+ *            state - RegionQuarterAggregate
+ * Returns: void
+ * Note: Sales missing either the product or the customer are skipped
+ */
+void AccumulateRegionSale(const salesRecord* sale, const productRecord* product,
+                          const customerRecord* customer, void* state) {
+    RegionQuarterAggregate* aggregate = (RegionQuarterAggregate*)state; // Region totals
+    regionSeasonalData* regions = aggregate->regions;                   // Region array
+    int regionIndex = -1;                                               // Region of this sale
+    
+    if (product != NULL && customer != NULL) {
+        // Find or create region entry
+        regionIndex = (int)aggregate->regionSlots[customer->continent] - 1;
+        if (regionIndex < 0 && aggregate->regionCount < 10) {
+            regionIndex = aggregate->regionCount;
+            strncpy(regions[regionIndex].continent,
+                    DecodeDictionaryValue(BINARY_TABLE_CUSTOMERS, CUSTOMER_DICTIONARY_CONTINENT, customer->continent), 19);
+            regions[regionIndex].continent[19] = '\0';
+            aggregate->regionSlots[customer->continent] = (unsigned char)(regionIndex + 1);
+            aggregate->regionCount++;
+        }
+        
+        if (regionIndex >= 0) {
+            double lineRevenue = product->unitPriceUSD * sale->quantity;
+            lineRevenue = RoundToThirdDecimal(lineRevenue);
             
-            // Try binary search first for exact match
-            searchResult = SearchBinaryRange(sortedFileName, &searchKey, 
-                                            sizeof(productCustomerRecord),
-                                            CompareProductNameOnly, &startPos, &endPos);
+            // Assign to quarter
+            int month = DayNumberToMonthSlot(sale->orderDay) % 12 + 1;
+            if (month >= 1 && month <= 3) {
+                regions[regionIndex].q1Revenue += lineRevenue;
+                regions[regionIndex].q1Orders++;
+            } else if (month >= 4 && month <= 6) {
+                regions[regionIndex].q2Revenue += lineRevenue;
+                regions[regionIndex].q2Orders++;
+            } else if (month >= 7 && month <= 9) {
+                regions[regionIndex].q3Revenue += lineRevenue;
+                regions[regionIndex].q3Orders++;
+            } else if (month >= 10 && month <= 12) {
+                regions[regionIndex].q4Revenue += lineRevenue;
+                regions[regionIndex].q4Orders++;
+            }
+        }
+    }
+}//end function definition AccumulateRegionSale
+
+/*
+ * Function: AccumulateDeliverySale
+ * Purpose: Shared scan aggregate adding one sale's delivery time to its order month
+ * Parameters: sale - current sales record
+ *            product - unused
+ *            customer - unused
+ *            state - MonthlyDeliveryAggregate
+ * Returns: void
+ * Note: Sales without a valid delivery time are skipped
+ */
+void AccumulateDeliverySale(const salesRecord* sale, const productRecord* product,
+                            const customerRecord* customer, void* state) {
+    MonthlyDeliveryAggregate* aggregate = (MonthlyDeliveryAggregate*)state; // Monthly statistics
+    monthlyDeliveryData* months = NULL;                                     // Month array
+    int deliveryDays = 0;                                                   // Delivery time in days
+    int monthSlot = -1;                                                     // Calendar month of this sale
+    int monthIndex = -1;                                                    // Month of this sale
+    
+    (void)product;
+    (void)customer;
+    
+    // Calculate delivery time
+    deliveryDays = CalculateDeliveryDays(sale->orderDay, sale->deliveryDay);
+    
+    // Only process valid delivery times
+    if (deliveryDays >= 0) {
+        // Find the month's entry, creating it for a new month
+        monthSlot = DayNumberToMonthSlot(sale->orderDay);
+        monthIndex = FindAggregateMonth(aggregate->monthSlots, (void**)&aggregate->months, &aggregate->monthCount,
+                                        &aggregate->monthCapacity, sizeof(monthlyDeliveryData), monthSlot);
+        months = aggregate->months;
+        if (monthIndex >= 0 && months[monthIndex].month == 0) {
+            months[monthIndex].year = (unsigned short)(CALENDAR_FIRST_YEAR + monthSlot / 12);
+            months[monthIndex].month = (unsigned char)(monthSlot % 12 + 1);
+            months[monthIndex].minDeliveryDays = USHRT_MAX;
+        }
+        
+        if (monthIndex >= 0) {
+            months[monthIndex].orderCount++;
+            months[monthIndex].totalDeliveryDays += deliveryDays;
             
-            // If exact match not found, do sequential search for partial matches
-            if (searchResult <= 0 || startPos < 0) {
-                printf("\nExact match not found. Searching for partial matches...\n");
-                
-                sortedFile = fopen(sortedFileName, "rb");
-                if (sortedFile != NULL) {
-                    char lowerSearch[31] = {0};
-                    char lowerProduct[31] = {0};
-                    ToLowerCase(lowerSearch, searchProductName, 31);
-                    
-                    printf("\n*** FOUND (Partial Matches) ***\n");
-                    printf("Products containing '%s':\n\n", searchProductName);
-                    printf("Locations:\n");
-                    printf("--------------------------------------------------------------------------------------\n");
-                    printf("%-30s %-15s %-15s %-20s %-20s\n", "Product", "Continent", "Country", "State", "City");
-                    printf("--------------------------------------------------------------------------------------\n");
-                    
-                    int matchCount = 0;
-                    char lastShownProduct[30] = {0};
-                    char lastShownContinent[20] = {0};
-                    char lastShownCountry[20] = {0};
-                    char lastShownState[30] = {0};
-                    char lastShownCity[40] = {0};
-                    
-                    while (fread(&foundRecord, sizeof(productCustomerRecord), 1, sortedFile) == 1) {
-                        // Convert product name to lowercase for comparison
-                        ToLowerCase(lowerProduct, foundRecord.product.productName, 31);
-                        
-                        // Check if search term is substring of product name (case-insensitive)
-                        if (strstr(lowerProduct, lowerSearch) != NULL) {
-                            int matches = 1;
-                            
-                            // Apply additional filters
-                            if (searchOption >= 2 && strcmp(foundRecord.customer.continent, searchContinent) != 0) {
-                                matches = 0;
-                            }
-                            if (searchOption >= 3 && strcmp(foundRecord.customer.country, searchCountry) != 0) {
-                                matches = 0;
-                            }
-                            
-                            // Check for duplicate location
-                            if (matches == 1) {
-                                if (strcmp(lastShownProduct, foundRecord.product.productName) == 0 &&
-                                    strcmp(lastShownContinent, foundRecord.customer.continent) == 0 &&
-                                    strcmp(lastShownCountry, foundRecord.customer.country) == 0 &&
-                                    strcmp(lastShownState, foundRecord.customer.state) == 0 &&
-                                    strcmp(lastShownCity, foundRecord.customer.city) == 0) {
-                                    matches = 0;
-                                }
-                            }
-                            
-                            if (matches == 1) {
-                                printf("%-30s %-15s %-15s %-20s %-20s\n",
-                                       foundRecord.product.productName,
-                                       foundRecord.customer.continent,
-                                       foundRecord.customer.country,
-                                       foundRecord.customer.state,
-                                       foundRecord.customer.city);
-                                matchCount++;
-                                
-                                // Remember this location
-                                strncpy(lastShownProduct, foundRecord.product.productName, 29);
-                                lastShownProduct[29] = '\0';
-                                strncpy(lastShownContinent, foundRecord.customer.continent, 19);
-                                lastShownContinent[19] = '\0';
-                                strncpy(lastShownCountry, foundRecord.customer.country, 19);
-                                lastShownCountry[19] = '\0';
-                                strncpy(lastShownState, foundRecord.customer.state, 29);
-                                lastShownState[29] = '\0';
-                                strncpy(lastShownCity, foundRecord.customer.city, 39);
-                                lastShownCity[39] = '\0';
-                            }
-                        }
-                    }
-                    
-                    printf("--------------------------------------------------------------------------------------\n");
-                    if (matchCount > 0) {
-                        printf("Total matching locations: %d\n", matchCount);
-                    } else {
-                        printf("\n*** NOT FOUND ***\n");
-                        printf("No products containing '%s' were found.\n", searchProductName);
-                    }
-                    
-                    fclose(sortedFile);
-                    sortedFile = NULL;
+            // Update min
+            if (deliveryDays < months[monthIndex].minDeliveryDays) {
+                months[monthIndex].minDeliveryDays = deliveryDays;
+            }
+            
+            // Update max
+            if (deliveryDays > months[monthIndex].maxDeliveryDays) {
+                months[monthIndex].maxDeliveryDays = deliveryDays;
+            }
+        }
+    }
+}//end function definition AccumulateDeliverySale
+
+/*
+ * Function: FindOrderDateRowBounds
+ * Purpose: Finds the rows of a filter's order date range when SalesTable.dat is in
+ *          order date order
+ * Parameters: filter - scan filter
+ *            firstRow - receives the first row ordered on or after the range start
+ *            endRow - receives one past the last row ordered on or before the range end
+ * Returns: int - 1 if the header marks the table sorted by order date and the bounds
+ *          were found, 0 otherwise
+ * Note: Two binary searches over the mapped table touch about 2 * log2(rows) records
+ */
+int FindOrderDateRowBounds(const salesScanFilter* filter, long* firstRow, long* endRow) {
+    mappedTable salesTable;                            // Mapped sales table
+    tableHeader salesHeader;                           // Header of the sales table
+    const salesRecord* sale = NULL;                    // Probed sale
+    long low = 0;                                      // Binary search lower bound
+    long high = 0;                                     // Binary search upper bound
+    long middle = 0;                                   // Probed row
+    int isSorted = 0;                                  // 1 if sorted by order date
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    InitializeStructureToZero(&salesTable, sizeof(mappedTable));
+    if (OpenMappedBinaryTable(&salesTable, "SalesTable.dat", sizeof(salesRecord), TABLE_ACCESS_RANDOM,
+                              &salesHeader) == 1) {
+        for (unsigned int c = 0; c < salesHeader.columnCount; c++) {
+            if (salesHeader.columns[c].fieldOffset == (unsigned int)offsetof(salesRecord, orderDay) &&
+                salesHeader.columns[c].isSorted == 1) {
+                isSorted = 1;
+            }
+        }
+    }
+    
+    if (isSorted == 1) {
+        // First row not before the range start
+        low = 0;
+        high = salesTable.recordCount;
+        while (low < high) {
+            middle = low + (high - low) / 2;
+            sale = (const salesRecord*)MappedRecordAt(&salesTable, middle);
+            if (sale->orderDay < filter->firstOrderDay) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        *firstRow = low;
+        
+        // First row after the range end
+        high = salesTable.recordCount;
+        while (low < high) {
+            middle = low + (high - low) / 2;
+            sale = (const salesRecord*)MappedRecordAt(&salesTable, middle);
+            if (sale->orderDay <= filter->lastOrderDay) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        *endRow = low;
+        returnValue = 1;
+    }
+    CloseMappedTable(&salesTable);
+    
+    return returnValue;                                // Single return point
+}//end function definition FindOrderDateRowBounds
+
+/*
+ * Function: ExecuteSalesScan
+ * Purpose: Reads SalesTable.dat once and feeds every sale to all registered aggregates
+ * Parameters: aggregators - registered aggregates
+ *            aggregatorCount - number of aggregates
+ *            firstRecord - first sale to read (0 = whole table)
+ *            filter - ranges a sale must fall in (NULL = every sale)
+ * Returns: long - number of sales passed to the aggregates, -1 on error
+ * Note: Products come from the product dimension cache and customers from the customer
+ *       join table (in memory or through CustomersTable.idx); a missing product or
+ *       customer is passed as NULL so each aggregate applies its own rule. The customer
+ *       join is only prepared when an aggregate reads SALES_COLUMN_CUSTOMER_KEY.
+ *       When the columnar copy is current only the union of the aggregates' columns
+ *       (plus the join keys) is read; otherwise whole rows are copied from the mapped
+ *       SalesTable.dat. A scan starting past the first record always uses the mapped
+ *       row file, which can be entered at any record.
+ *       With a filter, only the rows of its order date range are visited when the table
+ *       is sorted by order date, and blocks whose zone map ranges miss it are skipped
+ *       unread.
+ */
+long ExecuteSalesScan(const SalesScanAggregator* aggregators, int aggregatorCount, long firstRecord,
+                      const salesScanFilter* filter) {
+    mappedTable salesTable;                            // Mapped sales table (row layout)
+    salesColumnReader columnReader;                    // Sales table reader (columnar layout)
+    HashJoinTable customersTable;                      // Customers lookup side
+    salesZoneMap zoneMap;                              // Block ranges for the filter
+    salesRecord currentSale;                           // Current sales record
+    unsigned int columnMask = 0;                       // Columns needed by the scan
+    int useColumns = 0;                                // 1 if reading the columnar copy
+    int joinCustomers = 0;                             // 1 if an aggregate needs the customer
+    const productRecord* saleProduct = NULL;           // Product of the current sale
+    const customerRecord* saleCustomer = NULL;         // Customer of the current sale
+    long tableRows = 0;                                // Rows in the table
+    long rowCount = 0;                                 // One past the last row to visit
+    long currentRow = firstRecord;                     // Next row to read
+    long boundFirstRow = 0;                            // First row of the order date range
+    long boundEndRow = 0;                              // One past the last row of the range
+    long skipRows = 0;                                 // Rows of a skipped block
+    long blocksSkipped = 0;                            // Blocks pruned by the zone map
+    long rowsRead = 0;                                 // Rows read from the table
+    long recordsPassed = 0;                            // Sales passed to the aggregates
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    InitializeStructureToZero(&customersTable, sizeof(HashJoinTable));
+    InitializeStructureToZero(&salesTable, sizeof(mappedTable));
+    InitializeStructureToZero(&zoneMap, sizeof(salesZoneMap));
+    
+    for (int i = 0; i < aggregatorCount; i++) {
+        columnMask |= aggregators[i].columnMask;
+    }
+    joinCustomers = ((columnMask & SALES_COLUMN_BIT(SALES_COLUMN_CUSTOMER_KEY)) != 0) ? 1 : 0;
+    columnMask |= SALES_COLUMN_BIT(SALES_COLUMN_PRODUCT_KEY);
+    if (filter != NULL) {
+        columnMask |= SALES_COLUMN_BIT(SALES_COLUMN_ORDER_DATE) | SALES_COLUMN_BIT(SALES_COLUMN_DELIVERY_DATE) |
+                      SALES_COLUMN_BIT(SALES_COLUMN_CUSTOMER_KEY);
+    }
+    if (firstRecord == 0) {
+        useColumns = OpenSalesColumnReader(&columnReader, columnMask);
+    }
+    
+    if (useColumns == 0 &&
+        OpenMappedBinaryTable(&salesTable, "SalesTable.dat", sizeof(salesRecord), TABLE_ACCESS_SEQUENTIAL, NULL) == 0) {
+        printf("Error: Cannot open SalesTable.dat\n");
+    } else if (LoadProductDimension() == 0 || LoadTableDictionary(BINARY_TABLE_PRODUCTS) == 0 ||
+               (joinCustomers == 1 && (PrepareCustomerJoinTable(&customersTable) < 0 ||
+                                       LoadTableDictionary(BINARY_TABLE_CUSTOMERS) == 0))) {
+        printf("Error: Cannot open required files for sales aggregation\n");
+    } else {
+        tableRows = (useColumns == 1) ? columnReader.rowCount : salesTable.recordCount;
+        rowCount = tableRows;
+        if (filter != NULL && FindOrderDateRowBounds(filter, &boundFirstRow, &boundEndRow) == 1 &&
+            boundEndRow <= tableRows) {
+            // Sorted by order date: the range is one run of rows
+            if (boundFirstRow > currentRow) {
+                if (useColumns == 1 && SkipSalesColumnRows(&columnReader, boundFirstRow - currentRow) == 0) {
+                    boundEndRow = currentRow;
                 }
-            } else if (searchResult == 1 && startPos >= 0) {
-                printf("\n*** FOUND ***\n");
-                
-                if (searchOption == 1) {
-                    printf("Product '%s' found! Showing all locations:\n\n", searchProductName);
-                } else if (searchOption == 2) {
-                    printf("Product '%s' in '%s' found!\n\n", searchProductName, searchContinent);
-                } else if (searchOption == 3) {
-                    printf("Product '%s' in '%s, %s' found!\n\n", searchProductName, searchCountry, searchContinent);
+                currentRow = boundFirstRow;
+            }
+            rowCount = boundEndRow;
+        }
+        if (filter != NULL && LoadSalesZoneMap(&zoneMap, tableRows) == 0) {
+            printf("No current SalesTable.zonemap; no block is skipped\n");
+        }
+        
+        while (currentRow < rowCount) {
+            if (zoneMap.entries != NULL && currentRow % zoneMap.blockRows == 0 &&
+                SalesZoneMayMatch(&zoneMap.entries[currentRow / zoneMap.blockRows], filter) == 0) {
+                // No sale of this block can pass the filter
+                skipRows = (rowCount - currentRow < zoneMap.blockRows) ? rowCount - currentRow : zoneMap.blockRows;
+                if (useColumns == 1 && SkipSalesColumnRows(&columnReader, skipRows) == 0) {
+                    rowCount = currentRow;
                 }
-                
-                // Open file and read matching records
-                sortedFile = fopen(sortedFileName, "rb");
-                if (sortedFile != NULL) {
-                    fseek(sortedFile, startPos * sizeof(productCustomerRecord), SEEK_SET);
-                    
-                    printf("Locations:\n");
-                    printf("--------------------------------------------------------------------------------------\n");
-                    printf("%-30s %-15s %-15s %-20s %-20s\n", "Product", "Continent", "Country", "State", "City");
-                    printf("--------------------------------------------------------------------------------------\n");
-                    
-                    long currentPos = startPos;
-                    int matchCount = 0;
-                    char lastShownContinent[20] = {0};
-                    char lastShownCountry[20] = {0};
-                    char lastShownState[30] = {0};
-                    char lastShownCity[40] = {0};
-                    
-                    while (currentPos <= endPos && 
-                           fread(&foundRecord, sizeof(productCustomerRecord), 1, sortedFile) == 1) {
-                        
-                        // Apply additional filters based on search option
-                        int matches = 1;
-                        
-                        if (searchOption >= 1 && strcmp(foundRecord.product.productName, searchProductName) != 0) {
-                            matches = 0;
-                        }
-                        if (searchOption >= 2 && strcmp(foundRecord.customer.continent, searchContinent) != 0) {
-                            matches = 0;
-                        }
-                        if (searchOption >= 3 && strcmp(foundRecord.customer.country, searchCountry) != 0) {
-                            matches = 0;
-                        }
-                        
-                        // Check for duplicate location (avoid showing same location twice)
-                        if (matches == 1) {
-                            if (strcmp(lastShownContinent, foundRecord.customer.continent) == 0 &&
-                                strcmp(lastShownCountry, foundRecord.customer.country) == 0 &&
-                                strcmp(lastShownState, foundRecord.customer.state) == 0 &&
-                                strcmp(lastShownCity, foundRecord.customer.city) == 0) {
-                                matches = 0;  // Skip duplicate
-                            }
-                        }
-                        
-                        if (matches == 1) {
-                            printf("%-30s %-15s %-15s %-20s %-20s\n",
-                                   foundRecord.product.productName,
-                                   foundRecord.customer.continent,
-                                   foundRecord.customer.country,
-                                   foundRecord.customer.state,
-                                   foundRecord.customer.city);
-                            matchCount++;
-                            
-                            // Remember this location to avoid duplicates
-                            strncpy(lastShownContinent, foundRecord.customer.continent, 19);
-                            lastShownContinent[19] = '\0';
-                            strncpy(lastShownCountry, foundRecord.customer.country, 19);
+                currentRow += skipRows;
+                blocksSkipped++;
+            } else if (useColumns == 1 && ReadSalesColumnRow(&columnReader, &currentSale) == 0) {
+                rowCount = currentRow;                 // Short read, already reported
+            } else {
+                if (useColumns == 0) {
+                    currentSale = *(const salesRecord*)MappedRecordAt(&salesTable, currentRow);
+                }
+                currentRow++;
+                rowsRead++;
+                if (filter == NULL || SaleMatchesScanFilter(&currentSale, filter) == 1) {
+                    recordsPassed++;
+                    saleProduct = LookupProductByKey(currentSale.productKey);
+                    saleCustomer = (joinCustomers == 1) ?
+                        (const customerRecord*)ProbeHashJoinTable(&customersTable, currentSale.customerKey) : NULL;
+                    for (int i = 0; i < aggregatorCount; i++) {
+                        aggregators[i].accumulate(&currentSale, saleProduct, saleCustomer, aggregators[i].state);
+                    }
+                }
+            }
+        }
+        if (filter != NULL) {
+            printf("Filtered scan: %ld of %ld rows read, %ld blocks skipped by the zone map\n",
+                   rowsRead, tableRows, blocksSkipped);
+        }
+        returnValue = recordsPassed;
+    }
+    
+    CloseMappedTable(&salesTable);
+    if (useColumns == 1) CloseSalesColumnReader(&columnReader);
+    FreeHashJoinTable(&customersTable);
+    FreeSalesZoneMap(&zoneMap);
+    
+    return returnValue;                                // Single return point
+}//end function definition ExecuteSalesScan
+
+/*
+ * Function: InvalidateSalesScanAggregates
+ * Purpose: Discards the shared scan results so the next report rescans SalesTable.dat
+ * Parameters: none
+ * Returns: void
+ * Note: Must be called whenever SalesTable.dat or a dimension table is rebuilt
+ */
+void InvalidateSalesScanAggregates(void) {
+    salesScanLoaded = 0;
+    scanSalesRecords = 0;
+}//end function definition InvalidateSalesScanAggregates
+
+/*
+ * Function: ResetSalesScanAggregates
+ * Purpose: Empties the Report 3 and Report 4 aggregates before a full scan
+ * Parameters: none
+ * Returns: void
+ */
+void ResetSalesScanAggregates(void) {
+    free(scanMonthlySales.months);
+    free(scanMonthlyDelivery.months);
+    InitializeStructureToZero(&scanMonthlySales, sizeof(MonthlySalesAggregate));
+    InitializeStructureToZero(&scanCategoryQuarters, sizeof(CategoryQuarterAggregate));
+    InitializeStructureToZero(&scanRegionQuarters, sizeof(RegionQuarterAggregate));
+    InitializeStructureToZero(&scanMonthlyDelivery, sizeof(MonthlyDeliveryAggregate));
+    scanSalesRecords = 0;
+}//end function definition ResetSalesScanAggregates
+
+/*
+ * Function: RunSalesScanAggregates
+ * Purpose: Adds sales from firstRecord onwards to the Report 3 and Report 4 aggregates
+ * Parameters: firstRecord - first sale to add (0 = whole table, aggregates must be zeroed)
+ * Returns: int - 1 if the sales were added, 0 on error
+ * Note: Order counts, revenue and delivery day totals are sums, so a later call for the
+ *       rows appended since the last one extends them; the averages are recomputed
+ *       from the totals each time. Only sales inside the report date window are added.
+ */
+int RunSalesScanAggregates(long firstRecord) {
+    SalesScanAggregator aggregators[4];                // Registered aggregates
+    long recordsRead = 0;                              // Sales read by this scan
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    aggregators[0].accumulate = AccumulateMonthlySale;
+    aggregators[0].state = &scanMonthlySales;
+    aggregators[0].columnMask = SALES_COLUMN_BIT(SALES_COLUMN_ORDER_DATE) |
+                                SALES_COLUMN_BIT(SALES_COLUMN_PRODUCT_KEY) | SALES_COLUMN_BIT(SALES_COLUMN_QUANTITY);
+    aggregators[1].accumulate = AccumulateCategorySale;
+    aggregators[1].state = &scanCategoryQuarters;
+    aggregators[1].columnMask = aggregators[0].columnMask;
+    aggregators[2].accumulate = AccumulateRegionSale;
+    aggregators[2].state = &scanRegionQuarters;
+    aggregators[2].columnMask = aggregators[0].columnMask | SALES_COLUMN_BIT(SALES_COLUMN_CUSTOMER_KEY);
+    aggregators[3].accumulate = AccumulateDeliverySale;
+    aggregators[3].state = &scanMonthlyDelivery;
+    aggregators[3].columnMask = SALES_COLUMN_BIT(SALES_COLUMN_ORDER_DATE) |
+                                SALES_COLUMN_BIT(SALES_COLUMN_DELIVERY_DATE);
+    
+    recordsRead = ExecuteSalesScan(aggregators, 4, firstRecord, (reportWindowActive == 1) ? &reportWindowFilter : NULL);
+    if (recordsRead >= 0) {
+        scanSalesRecords += recordsRead;
+        // Calculate delivery averages
+        for (int i = 0; i < scanMonthlyDelivery.monthCount; i++) {
+            if (scanMonthlyDelivery.months[i].orderCount > 0) {
+                scanMonthlyDelivery.months[i].avgDeliveryDays =
+                    (double)scanMonthlyDelivery.months[i].totalDeliveryDays /
+                    (double)scanMonthlyDelivery.months[i].orderCount;
+                scanMonthlyDelivery.months[i].avgDeliveryDays =
+                    RoundToThirdDecimal(scanMonthlyDelivery.months[i].avgDeliveryDays);
+            }
+        }
+        returnValue = 1;
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition RunSalesScanAggregates
+
+/*
+ * Function: LoadSalesScanAggregates
+ * Purpose: Runs the shared sales scan for the Report 3 and Report 4 aggregates
+ * Parameters: none
+ * Returns: int - 1 if the aggregates are available, 0 on error
+ * Note: Does nothing if the scan has already run in this process for the current
+ *       report date window
+ */
+int LoadSalesScanAggregates(void) {
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    if (salesScanLoaded == 1) {
+        returnValue = 1;
+    } else {
+        ResetSalesScanAggregates();
+        
+        printf("Scanning sales table for report aggregates...\n");
+        if (RunSalesScanAggregates(0) == 1) {
+            salesScanLoaded = 1;
+            returnValue = 1;
+        }
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition LoadSalesScanAggregates
+
+/*
+ * Function: ExtendSalesScanAggregates
+ * Purpose: Adds sales appended to SalesTable.dat to the shared scan results
+ * Parameters: firstRecord - first appended sale (the table's record count before the append)
+ * Returns: void
+ * Note: Only the appended rows are read. If the scan has not run yet there is nothing
+ *       to extend; if the delta scan fails the results are discarded and the next report
+ *       rescans the whole table.
+ */
+void ExtendSalesScanAggregates(long firstRecord) {
+    if (salesScanLoaded == 1 && RunSalesScanAggregates(firstRecord) == 0) {
+        InvalidateSalesScanAggregates();
+    }
+}//end function definition ExtendSalesScanAggregates
+
+/*
+ * Structure: DateRangeSalesAggregate
+ * Purpose: Sales lines, units and revenue of the sales passing a date-range filter
+ */
+typedef struct {
+    long salesLines;                                   // Sales records in the range
+    unsigned long unitsSold;                           // Quantity summed over the range
+    double totalRevenue;                               // Revenue in USD over the range
+} DateRangeSalesAggregate;
+
+/*
+ * Function: AccumulateDateRangeSale
+ * Purpose: Scan aggregate adding one sale of the requested date range
+ * Parameters: sale - current sales record
+ *            product - matching product (NULL if none; the sale adds no revenue)
+ *            customer - unused
+ *            state - DateRangeSalesAggregate
+ * Returns: void
+ */
+void AccumulateDateRangeSale(const salesRecord* sale, const productRecord* product,
+                             const customerRecord* customer, void* state) {
+    DateRangeSalesAggregate* aggregate = (DateRangeSalesAggregate*)state; // Range totals
+    
+    (void)customer;
+    
+    aggregate->salesLines++;
+    aggregate->unitsSold += sale->quantity;
+    if (product != NULL) {
+        aggregate->totalRevenue += RoundToThirdDecimal(product->unitPriceUSD * (double)sale->quantity);
+    }
+}//end function definition AccumulateDateRangeSale
+
+/*
+ * Function: SummarizeSalesInDateRange
+ * Purpose: Totals the sales whose order date lies in a window
+ * Parameters: none
+ * Returns: int - 1 if the totals were produced, 0 on invalid dates or error
+ * Note: The window comes from batchOptions in batch mode and is asked for otherwise.
+ *       Only the zone map blocks that overlap the window are read.
+ */
+int SummarizeSalesInDateRange(void) {
+    SalesScanAggregator aggregator;                    // Range totals aggregate
+    DateRangeSalesAggregate totals;                    // Totals of the window
+    salesScanFilter filter;                            // Order date window
+    dateStructure firstDate;                           // First order date of the window
+    dateStructure lastDate;                            // Last order date of the window
+    int month = 0, day = 0, year = 0;                  // Entered date parts
+    int datesValid = 0;                                // 1 if both dates are valid
+    long long startNanoseconds = 0;                    // Scan start time
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    InitializeStructureToZero(&totals, sizeof(DateRangeSalesAggregate));
+    InitializeStructureToZero(&firstDate, sizeof(dateStructure));
+    InitializeStructureToZero(&lastDate, sizeof(dateStructure));
+    
+    if (batchOptions.active == 1) {
+        firstDate = batchOptions.rangeFirstDate;
+        lastDate = batchOptions.rangeLastDate;
+        datesValid = (firstDate.yearValue != 0 && lastDate.yearValue != 0) ? 1 : 0;
+    } else {
+        printf("Enter first order date (MM/DD/YYYY): ");
+        if (scanf("%d/%d/%d", &month, &day, &year) == 3 && StoreCalendarDate(month, day, year, &firstDate) == 1) {
+            printf("Enter last order date (MM/DD/YYYY): ");
+            if (scanf("%d/%d/%d", &month, &day, &year) == 3 && StoreCalendarDate(month, day, year, &lastDate) == 1) {
+                datesValid = 1;
+            }
+        }
+        if (datesValid == 0) {
+            while (getchar() != '\n');                 // Clean input buffer
+        }
+    }
+    
+    if (datesValid == 0 || DateToDayNumber(&firstDate) > DateToDayNumber(&lastDate)) {
+        printf("Error: Invalid order date range\n");
+    } else {
+        InitializeSalesScanFilter(&filter);
+        filter.firstOrderDay = DateToDayNumber(&firstDate);
+        filter.lastOrderDay = DateToDayNumber(&lastDate);
+        aggregator.accumulate = AccumulateDateRangeSale;
+        aggregator.state = &totals;
+        aggregator.columnMask = SALES_COLUMN_BIT(SALES_COLUMN_ORDER_DATE) |
+                                SALES_COLUMN_BIT(SALES_COLUMN_PRODUCT_KEY) | SALES_COLUMN_BIT(SALES_COLUMN_QUANTITY);
+    
+        startNanoseconds = ReadMonotonicNanoseconds();
+        if (ExecuteSalesScan(&aggregator, 1, 0, &filter) >= 0) {
+            printf("Sales with order date from %d/%d/%d to %d/%d/%d\n",
+                   firstDate.monthOfYear, firstDate.dayOfMonth, firstDate.yearValue,
+                   lastDate.monthOfYear, lastDate.dayOfMonth, lastDate.yearValue);
+            printf("  Sales lines: %ld\n", totals.salesLines);
+            printf("  Units sold: %lu\n", totals.unitsSold);
+            printf("  Revenue (USD): %.2f\n", totals.totalRevenue);
+            printf("  Scan time (ms): %.3f\n", (double)(ReadMonotonicNanoseconds() - startNanoseconds) / 1e6);
+            returnValue = 1;
+        }
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition SummarizeSalesInDateRange
+
+/*
+ * Function: ReadWindowDate
+ * Purpose: Reads one bound of the report date window from the console
+ * Parameters: prompt - text asking for the date
+ *            date - receives the date
+ *            hasDate - receives 1 for a date, 0 for "0" (no bound)
+ * Returns: int - 1 if the answer was a valid date or 0, 0 otherwise
+ */
+int ReadWindowDate(const char* prompt, dateStructure* date, int* hasDate) {
+    char dateText[20] = {0};                           // Entered text
+    int month = 0, day = 0, year = 0;                  // Entered date parts
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    printf("%s", prompt);
+    *hasDate = 0;
+    if (scanf("%19s", dateText) == 1) {
+        if (strcmp(dateText, "0") == 0) {
+            returnValue = 1;
+        } else if (sscanf(dateText, "%d/%d/%d", &month, &day, &year) == 3 &&
+                   StoreCalendarDate(month, day, year, date) == 1) {
+            *hasDate = 1;
+            returnValue = 1;
+        }
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition ReadWindowDate
+
+/*
+ * Function: SelectReportDateWindow
+ * Purpose: Asks for the order date window of Reports 3 and 4
+ * Parameters: none
+ * Returns: int - 1 if the window was set, 0 on invalid input
+ * Note: Answering 0 for both dates returns the reports to the whole history
+ */
+int SelectReportDateWindow(void) {
+    dateStructure firstDate;                           // First order date
+    dateStructure lastDate;                            // Last order date
+    int hasFirstDate = 0;                              // 1 if a first date was given
+    int hasLastDate = 0;                               // 1 if a last date was given
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    InitializeStructureToZero(&firstDate, sizeof(dateStructure));
+    InitializeStructureToZero(&lastDate, sizeof(dateStructure));
+    
+    if (ReadWindowDate("Enter first order date (MM/DD/YYYY, 0 = from the earliest sale): ", &firstDate, &hasFirstDate) == 1 &&
+        ReadWindowDate("Enter last order date (MM/DD/YYYY, 0 = up to the latest sale): ", &lastDate, &hasLastDate) == 1 &&
+        (hasFirstDate == 0 || hasLastDate == 0 || DateToDayNumber(&firstDate) <= DateToDayNumber(&lastDate))) {
+        SetReportDateWindow((hasFirstDate == 1) ? &firstDate : NULL, (hasLastDate == 1) ? &lastDate : NULL);
+        if (reportWindowActive == 1) {
+            printf("Reports 3 and 4 will cover the selected order dates\n");
+        } else {
+            printf("Reports 3 and 4 will cover the whole history\n");
+        }
+        returnValue = 1;
+    } else {
+        printf("Invalid order date window.\n");
+        while (getchar() != '\n');                     // Clean input buffer
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition SelectReportDateWindow
+
+/*
+ * Function: AggregateSalesByMonth
+ * Purpose: Writes the monthly sales aggregates of the shared sales scan to a file
+ * Parameters: outputFileName - name of file to store monthly aggregated data
+ * Returns: int - number of months processed, -1 on error
+ * Note: Order counts and revenue per month come from LoadSalesScanAggregates, so the
+ *       sales table is only read if no report has scanned it yet
+ */
+int AggregateSalesByMonth(const char* outputFileName) {
+    FILE* monthlyFile = NULL;                          // Monthly aggregated data file
+    int monthCount = 0;                                // Number of unique months
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = -1;                              // Return value
+    
+    if (LoadSalesScanAggregates() == 0) {
+        errorOccurred = 1;
+        returnValue = -1;
+    }
+    
+    if (errorOccurred == 0) {
+        monthCount = scanMonthlySales.monthCount;
+        printf("Processed %ld sales records into %d months\n", scanSalesRecords, monthCount);
+        metrics.resultRows = scanSalesRecords;
+        returnValue = monthCount;                      // 0 when no sale falls in the date window
+    }
+    
+    // Write aggregated data to file
+    if (errorOccurred == 0 && monthCount > 0) {
+        monthlyFile = OpenFileWithErrorCheck(outputFileName, "wb");
+        if (monthlyFile == NULL) {
+            printf("Error: Cannot create monthly data file\n");
+            errorOccurred = 1;
+            returnValue = -1;
+        } else {
+            // Write all monthly records
+            for (int i = 0; i < monthCount; i++) {
+                if (CountedWrite(&scanMonthlySales.months[i], sizeof(monthlySalesData), 1, monthlyFile) != 1) {
+                    printf("Error: Failed to write monthly data record %d\n", i);
+                    errorOccurred = 1;
+                    returnValue = -1;
+                }
+            }
+            
+            fclose(monthlyFile);
+            
+            if (errorOccurred == 0) {
+                returnValue = monthCount;
+            }
+        }
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition AggregateSalesByMonth
+
+/*
+ * Function: DrawASCIIBarChart
+ * Purpose: Generates ASCII bar chart for visualizing monthly data
+ * Parameters: txtFile - output file pointer (NULL to write only to console)
+ *            monthlyData - array of monthly sales data
+ *            dataCount - number of months in the array
+ *            chartType - 'O' for orders, 'R' for revenue
+ * Returns: void
+ * Note: Creates horizontal bar chart with appropriate scaling
+ *       Complies with single return requirement
+ */
+void DrawASCIIBarChart(FILE* txtFile, const monthlySalesData* monthlyData, int dataCount, char chartType) {
+    unsigned long maxOrders = 0;                       // Maximum order count
+    double maxRevenue = 0.0;                           // Maximum revenue
+    int maxBarLength = 60;                             // Maximum bar length in characters
+    double scaleFactor = 0.0;                          // Scale factor for bars
+    const char* chartTitle = NULL;                     // Chart title
+    
+    if (dataCount <= 0) {
+        WriteToReport(txtFile, "No data to display\n");
+        return;
+    }
+    
+    // Set titles based on chart type
+    if (chartType == 'O') {
+        chartTitle = "Monthly Order Volume";
+    } else {
+        chartTitle = "Monthly Revenue";
+    }
+    
+    // Find maximum value for scaling
+    for (int i = 0; i < dataCount; i++) {
+        if (chartType == 'O') {
+            if (monthlyData[i].orderCount > maxOrders) {
+                maxOrders = monthlyData[i].orderCount;
+            }
+        } else {
+            if (monthlyData[i].totalRevenue > maxRevenue) {
+                maxRevenue = monthlyData[i].totalRevenue;
+            }
+        }
+    }
+    
+    // Calculate scale factor
+    if (chartType == 'O') {
+        scaleFactor = (maxOrders > 0) ? (double)maxBarLength / (double)maxOrders : 0.0;
+    } else {
+        scaleFactor = (maxRevenue > 0.0) ? (double)maxBarLength / maxRevenue : 0.0;
+    }
+    
+    // Draw chart header
+    WriteToReport(txtFile, "\n%s\n", chartTitle);
+    WriteToReport(txtFile, "========================================\n");
+    
+    // Draw bars for each month
+    for (int i = 0; i < dataCount; i++) {
+        int barLength = 0;                             // Length of bar for this month
+        
+        // Calculate bar length
+        if (chartType == 'O') {
+            barLength = (int)(monthlyData[i].orderCount * scaleFactor);
+        } else {
+            barLength = (int)(monthlyData[i].totalRevenue * scaleFactor);
+        }
+        
+        // Ensure at least 1 character if value > 0
+        if (barLength == 0 && 
+            ((chartType == 'O' && monthlyData[i].orderCount > 0) ||
+             (chartType == 'R' && monthlyData[i].totalRevenue > 0.0))) {
+            barLength = 1;
+        }
+        
+        // Print month label
+        WriteToReport(txtFile, "%04u-%02u | ", 
+               monthlyData[i].year, monthlyData[i].month);
+        
+        // Draw bar
+        for (int j = 0; j < barLength; j++) {
+            WriteToReport(txtFile, "\u2588");          // Unicode block character
+        }
+        
+        // Print value
+        if (chartType == 'O') {
+            WriteToReport(txtFile, " %lu\n", monthlyData[i].orderCount);
+        } else {
+            WriteToReport(txtFile, " $%.2f\n", monthlyData[i].totalRevenue);
+        }
+    }
+    
+    WriteToReport(txtFile, "\n");
+    
+    // No explicit return needed for void function
+}//end function definition DrawASCIIBarChart
+
+/*
+ * Function: AnalyzeSeasonalPatternsByCategory
+ * Purpose: Analyzes seasonal patterns for different product categories
+ * Parameters: txtFile - output file pointer
+ * Returns: void
+ * Note: Uses the category quarter totals of the shared sales scan
+ */
+void AnalyzeSeasonalPatternsByCategory(FILE* txtFile) {
+    const categorySeasonalData* categories = scanCategoryQuarters.categories; // Category totals
+    int categoryCount = 0;
+    int errorOccurred = 0;
+    
+    WriteToReport(txtFile, "\n\n=== SEASONAL PATTERNS BY PRODUCT CATEGORY ===\n");
+    WriteToReport(txtFile, "=================================================================\n");
+    
+    if (LoadSalesScanAggregates() == 0) {
+        WriteToReport(txtFile, "Error: Cannot open required files for category analysis\n");
+        errorOccurred = 1;
+    }
+    
+    if (errorOccurred == 0) {
+        categoryCount = scanCategoryQuarters.categoryCount;
+        
+        // Display results
+        WriteToReport(txtFile, "\n%-20s %12s %12s %12s %12s\n", 
+               "Category", "Q1 Revenue", "Q2 Revenue", "Q3 Revenue", "Q4 Revenue");
+        WriteToReport(txtFile, "--------------------------------------------------------------------------------\n");
+        
+        for (int i = 0; i < categoryCount; i++) {
+            WriteToReport(txtFile, "%-20s $%11.2f $%11.2f $%11.2f $%11.2f\n",
+                   categories[i].category,
+                   categories[i].q1Revenue,
+                   categories[i].q2Revenue,
+                   categories[i].q3Revenue,
+                   categories[i].q4Revenue);
+            
+            // Find peak quarter
+            double maxRevenue = categories[i].q1Revenue;
+            const char* peakQuarter = "Q1";
+            
+            if (categories[i].q2Revenue > maxRevenue) {
+                maxRevenue = categories[i].q2Revenue;
+                peakQuarter = "Q2";
+            }
+            if (categories[i].q3Revenue > maxRevenue) {
+                maxRevenue = categories[i].q3Revenue;
+                peakQuarter = "Q3";
+            }
+            if (categories[i].q4Revenue > maxRevenue) {
+                maxRevenue = categories[i].q4Revenue;
+                peakQuarter = "Q4";
+            }
+            
+            WriteToReport(txtFile, "  Peak season: %s ($%.2f)\n", peakQuarter, maxRevenue);
+        }
+    }
+}//end function definition AnalyzeSeasonalPatternsByCategory
+
+/*
+ * Function: AnalyzeSeasonalPatternsByRegion
+ * Purpose: Analyzes seasonal patterns for different geographical regions
+ * Parameters: txtFile - output file pointer
+ * Returns: void
+ * Note: Uses the region quarter totals of the shared sales scan
+ */
+void AnalyzeSeasonalPatternsByRegion(FILE* txtFile) {
+    const regionSeasonalData* regions = scanRegionQuarters.regions; // Region totals
+    int regionCount = 0;
+    int errorOccurred = 0;
+    
+    WriteToReport(txtFile, "\n\n=== SEASONAL PATTERNS BY REGION ===\n");
+    WriteToReport(txtFile, "=================================================================\n");
+    
+    if (LoadSalesScanAggregates() == 0) {
+        WriteToReport(txtFile, "Error: Cannot open required files for region analysis\n");
+        errorOccurred = 1;
+    }
+    
+    if (errorOccurred == 0) {
+        regionCount = scanRegionQuarters.regionCount;
+        
+        // Display results
+        WriteToReport(txtFile, "\n%-20s %12s %12s %12s %12s\n", 
+               "Region", "Q1 Revenue", "Q2 Revenue", "Q3 Revenue", "Q4 Revenue");
+        WriteToReport(txtFile, "--------------------------------------------------------------------------------\n");
+        
+        for (int i = 0; i < regionCount; i++) {
+            WriteToReport(txtFile, "%-20s $%11.2f $%11.2f $%11.2f $%11.2f\n",
+                   regions[i].continent,
+                   regions[i].q1Revenue,
+                   regions[i].q2Revenue,
+                   regions[i].q3Revenue,
+                   regions[i].q4Revenue);
+            
+            // Find peak quarter
+            double maxRevenue = regions[i].q1Revenue;
+            const char* peakQuarter = "Q1";
+            
+            if (regions[i].q2Revenue > maxRevenue) {
+                maxRevenue = regions[i].q2Revenue;
+                peakQuarter = "Q2";
+            }
+            if (regions[i].q3Revenue > maxRevenue) {
+                maxRevenue = regions[i].q3Revenue;
+                peakQuarter = "Q3";
+            }
+            if (regions[i].q4Revenue > maxRevenue) {
+                maxRevenue = regions[i].q4Revenue;
+                peakQuarter = "Q4";
+            }
+            
+            WriteToReport(txtFile, "  Peak season: %s ($%.2f) - Orders: %lu/%lu/%lu/%lu\n", 
+                   peakQuarter, maxRevenue,
+                   regions[i].q1Orders, regions[i].q2Orders, 
+                   regions[i].q3Orders, regions[i].q4Orders);
+        }
+    }
+}//end function definition AnalyzeSeasonalPatternsByRegion
+
+/*
+ * Function: GenerateTrendAnalysis
+ * Purpose: Analyzes growth trends and patterns over time
+ * Parameters: txtFile - output file pointer
+ *            monthlyData - array of monthly data
+ *            dataCount - number of months
+ * Returns: void
+ * Note: Calculates year-over-year growth and identifies trends
+ */
+void GenerateTrendAnalysis(FILE* txtFile, const monthlySalesData* monthlyData, int dataCount) {
+    WriteToReport(txtFile, "\n\n=== TREND ANALYSIS ===\n");
+    WriteToReport(txtFile, "======================\n");
+    
+    if (dataCount < 2) {
+        WriteToReport(txtFile, "Insufficient data for trend analysis\n");
+        return;
+    }
+    
+    // Calculate month-over-month changes
+    double avgOrderGrowth = 0.0;
+    double avgRevenueGrowth = 0.0;
+    int growthSamples = 0;
+    
+    WriteToReport(txtFile, "\nMonth-over-Month Changes:\n");
+    WriteToReport(txtFile, "%-10s %15s %15s\n", "Period", "Order Change", "Revenue Change");
+    WriteToReport(txtFile, "--------------------------------------------------------\n");
+    
+    for (int i = 1; i < dataCount; i++) {
+        double orderChange = 0.0;
+        double revenueChange = 0.0;
+        
+        if (monthlyData[i-1].orderCount > 0) {
+            orderChange = ((double)monthlyData[i].orderCount - (double)monthlyData[i-1].orderCount) / 
+                         (double)monthlyData[i-1].orderCount * 100.0;
+        }
+        
+        if (monthlyData[i-1].totalRevenue > 0.0) {
+            revenueChange = (monthlyData[i].totalRevenue - monthlyData[i-1].totalRevenue) / 
+                           monthlyData[i-1].totalRevenue * 100.0;
+        }
+        
+        WriteToReport(txtFile, "%04u-%02u %15.2f%% %15.2f%%\n",
+               monthlyData[i].year, monthlyData[i].month,
+               orderChange, revenueChange);
+        
+        avgOrderGrowth += orderChange;
+        avgRevenueGrowth += revenueChange;
+        growthSamples++;
+    }
+    
+    if (growthSamples > 0) {
+        avgOrderGrowth /= growthSamples;
+        avgRevenueGrowth /= growthSamples;
+        
+        WriteToReport(txtFile, "\nAverage Growth Rates:\n");
+        WriteToReport(txtFile, "  Orders: %.2f%% per month\n", avgOrderGrowth);
+        WriteToReport(txtFile, "  Revenue: %.2f%% per month\n", avgRevenueGrowth);
+        
+        // Interpret trends
+        WriteToReport(txtFile, "\nTrend Interpretation:\n");
+        if (avgOrderGrowth > 5.0) {
+            WriteToReport(txtFile, "  \u2713 Strong positive order volume trend\n");
+        } else if (avgOrderGrowth > 0.0) {
+            WriteToReport(txtFile, "  \u2713 Modest positive order volume trend\n");
+        } else if (avgOrderGrowth < -5.0) {
+            WriteToReport(txtFile, "  \u26A0 Declining order volume trend\n");
+        } else {
+            WriteToReport(txtFile, "  \u2192 Stable order volume\n");
+        }
+        
+        if (avgRevenueGrowth > 5.0) {
+            WriteToReport(txtFile, "  \u2713 Strong positive revenue trend\n");
+        } else if (avgRevenueGrowth > 0.0) {
+            WriteToReport(txtFile, "  \u2713 Modest positive revenue trend\n");
+        } else if (avgRevenueGrowth < -5.0) {
+            WriteToReport(txtFile, "  \u26A0 Declining revenue trend\n");
+        } else {
+            WriteToReport(txtFile, "  \u2192 Stable revenue\n");
+        }
+    }
+}//end function definition GenerateTrendAnalysis
+
+/*
+ * Function: GenerateBusinessRecommendations
+ * Purpose: Generates business recommendations based on seasonal patterns
+ * Parameters: txtFile - output file pointer
+ *            monthlyData - array of monthly data
+ *            dataCount - number of months
+ * Returns: void
+ * Note: Provides actionable insights for business planning
+ */
+void GenerateBusinessRecommendations(FILE* txtFile, const monthlySalesData* monthlyData, int dataCount) {
+    WriteToReport(txtFile, "\n\n=== BUSINESS IMPACT & RECOMMENDATIONS ===\n");
+    WriteToReport(txtFile, "=========================================\n");
+    
+    if (dataCount == 0) {
+        return;
+    }
+    
+    // Find peak and low months
+    unsigned long maxOrders = 0;
+    unsigned long minOrders = ULONG_MAX;
+    int peakMonth = 0;
+    int lowMonth = 0;
+    
+    for (int i = 0; i < dataCount; i++) {
+        if (monthlyData[i].orderCount > maxOrders) {
+            maxOrders = monthlyData[i].orderCount;
+            peakMonth = i;
+        }
+        if (monthlyData[i].orderCount < minOrders) {
+            minOrders = monthlyData[i].orderCount;
+            lowMonth = i;
+        }
+    }
+    
+    double variability = 0.0;
+    if (minOrders > 0) {
+        variability = ((double)maxOrders - (double)minOrders) / (double)minOrders * 100.0;
+    }
+    
+    WriteToReport(txtFile, "\n1. PRODUCTION PLANNING:\n");
+    WriteToReport(txtFile, "   Peak Period: %04u-%02u (%lu orders)\n",
+           monthlyData[peakMonth].year, monthlyData[peakMonth].month, maxOrders);
+    WriteToReport(txtFile, "   Low Period: %04u-%02u (%lu orders)\n",
+           monthlyData[lowMonth].year, monthlyData[lowMonth].month, minOrders);
+    WriteToReport(txtFile, "   Seasonality: %.1f%% variance\n", variability);
+    
+    if (variability > 50.0) {
+        WriteToReport(txtFile, "   \u26A0 HIGH SEASONALITY - Recommendations:\n");
+        WriteToReport(txtFile, "     - Increase production capacity 2-3 months before peak\n");
+        WriteToReport(txtFile, "     - Consider flexible workforce (seasonal hiring)\n");
+        WriteToReport(txtFile, "     - Build inventory buffer during low periods\n");
+    } else if (variability > 20.0) {
+        WriteToReport(txtFile, "   \u2192 MODERATE SEASONALITY - Recommendations:\n");
+        WriteToReport(txtFile, "     - Adjust production schedules for peak periods\n");
+        WriteToReport(txtFile, "     - Maintain stable workforce with overtime capability\n");
+    } else {
+        WriteToReport(txtFile, "   \u2713 LOW SEASONALITY - Recommendations:\n");
+        WriteToReport(txtFile, "     - Maintain steady production levels\n");
+        WriteToReport(txtFile, "     - Focus on just-in-time inventory management\n");
+    }
+    
+    WriteToReport(txtFile, "\n2. INVENTORY MANAGEMENT:\n");
+    if (variability > 50.0) {
+        WriteToReport(txtFile, "   \u26A0 Critical Actions:\n");
+        WriteToReport(txtFile, "     - Stock up 60-90 days before peak season\n");
+        WriteToReport(txtFile, "     - Negotiate flexible supplier agreements\n");
+        WriteToReport(txtFile, "     - Implement demand forecasting system\n");
+        WriteToReport(txtFile, "     - Reserve warehouse space for seasonal buildup\n");
+    } else {
+        WriteToReport(txtFile, "   \u2713 Standard Actions:\n");
+        WriteToReport(txtFile, "     - Maintain 30-day safety stock\n");
+        WriteToReport(txtFile, "     - Regular supplier orders with lead time buffer\n");
+    }
+    
+    WriteToReport(txtFile, "\n3. LOGISTICS & DISTRIBUTION:\n");
+    WriteToReport(txtFile, "   - Pre-negotiate carrier capacity for peak months\n");
+    WriteToReport(txtFile, "   - Consider regional distribution centers\n");
+    WriteToReport(txtFile, "   - Plan delivery schedules to avoid peak congestion\n");
+    if (variability > 30.0) {
+        WriteToReport(txtFile, "   - Arrange backup shipping options for peak periods\n");
+        WriteToReport(txtFile, "   - Hire additional logistics staff seasonally\n");
+    }
+    
+    WriteToReport(txtFile, "\n4. MARKETING & SALES:\n");
+    WriteToReport(txtFile, "   - Launch promotional campaigns during low periods\n");
+    WriteToReport(txtFile, "   - Offer pre-order discounts before peak season\n");
+    WriteToReport(txtFile, "   - Create off-season incentives to balance demand\n");
+    WriteToReport(txtFile, "   - Target regional markets based on their peak seasons\n");
+    
+    WriteToReport(txtFile, "\n5. FINANCIAL PLANNING:\n");
+    WriteToReport(txtFile, "   - Budget for seasonal working capital needs\n");
+    WriteToReport(txtFile, "   - Plan cash flow for inventory buildup\n");
+    WriteToReport(txtFile, "   - Negotiate payment terms aligned with seasonal cash flow\n");
+    if (variability > 40.0) {
+        WriteToReport(txtFile, "   - Consider seasonal credit line for peak period\n");
+    }
+    
+    WriteToReport(txtFile, "\n6. STAFFING RECOMMENDATIONS:\n");
+    WriteToReport(txtFile, "   Core Staff: Maintain year-round for %lu orders/month\n", minOrders);
+    if (maxOrders > minOrders * 1.5) {
+        WriteToReport(txtFile, "   Seasonal Staff: Add %.0f%% capacity for peak\n", 
+               ((double)maxOrders / minOrders - 1.0) * 100.0);
+        WriteToReport(txtFile, "   Training: Begin 6-8 weeks before peak season\n");
+    }
+}//end function definition GenerateBusinessRecommendations
+
+/*
+ * Function: GenerateReport3SeasonalPatterns
+ * Purpose: Generates Report 3 - Seasonal Patterns Analysis
+ * Parameters: sortType - "Bubble", "Merge" or "Radix" to specify sorting algorithm
+ * Returns: int - 1 if the report was written, 0 on error
+ * Note: Aggregates sales by month, shows trends with ASCII charts
+ *       Displays both order volume and revenue patterns
+ *       Uses file-based processing throughout
+ */
+int GenerateReport3SeasonalPatterns(const char* sortType) {
+    FILE* sortedFile = NULL;                           // Sorted monthly data file
+    FILE* txtFile = NULL;                              // Output text report file
+    char tempFileName[300] = {0};                      // Temporary aggregated data file
+    char sortedFileName[300] = {0};                    // Sorted data file
+    char txtFileName[300] = {0};                       // Text report file name
+    char reportTitle[150] = {0};                       // Report title
+    monthlySalesData currentMonth;                     // Current month data
+    monthlySalesData* allMonthsData = NULL;            // All months for charts (monthsSorted entries)
+    int monthsAggregated = 0;                          // Number of months aggregated
+    int monthsSorted = 0;                              // Number of months sorted
+    int monthsRead = 0;                                // Number of months read for display
+    unsigned long totalOrders = 0;                     // Total orders across all months
+    double totalRevenue = 0.0;                         // Total revenue across all months
+    double avgOrdersPerMonth = 0.0;                    // Average orders per month
+    double avgRevenuePerMonth = 0.0;                   // Average revenue per month
+    time_t startTime = 0;                              // Report generation start time
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = 0;                               // Return value (single return pattern)
+    int sortTypeValid = 0;                             // Sort type validation flag
+    sortKeySpec sortKey;                               // Normalized sort key specification
+    
+    printf("\nGenerating Report 3: Seasonal Patterns and Trends\n");
+    printf("Using %s sort algorithm...\n", sortType);
+    
+    time(&startTime);
+    
+    // Generate filenames
+    sprintf(tempFileName, "temp_monthly_%ld.dat", (long)time(NULL));
+    sprintf(txtFileName, "Report_3_Seasonal_%s_%ld.txt", sortType, (long)time(NULL));
+    BeginReportMetrics(txtFileName);
+    
+    // Open text file for report output
+    txtFile = OpenReportFile(txtFileName);
+    if (txtFile == NULL) {
+        printf("Error: Cannot create report text file\n");
+        return returnValue;
+    }
+    
+    // Aggregate sales by month
+    StartMetricPhase(METRIC_PHASE_AGGREGATE);
+    monthsAggregated = AggregateSalesByMonth(tempFileName);
+    StopMetricPhase(METRIC_PHASE_AGGREGATE);
+    if (monthsAggregated == 0) {
+        printf("Error: No sales in the selected order dates\n");
+        errorOccurred = 1;
+    } else if (monthsAggregated < 0) {
+        printf("Error: Failed to aggregate sales data\n");
+        errorOccurred = 1;
+    }
+    
+    if (errorOccurred == 0) {
+        // Generate sorted filename
+        GenerateSortedFileName("Seasonal", sortType, sortedFileName);
+        
+        printf("Sorting monthly data using %s sort...\n", sortType);
+        StartMetricPhase(METRIC_PHASE_SORT);
+        
+        // Sort monthly data chronologically
+        BuildMonthlySalesSortKeySpec(&sortKey);
+        if ((strcmp(sortType, "Bubble") == 0 || strcmp(sortType, "Merge") == 0 || strcmp(sortType, "Radix") == 0) &&
+            MonthlyDataInDateOrder() == 1) {
+            sortTypeValid = 1;
+            monthsSorted = KeepMonthlyDataOrder(tempFileName, sortedFileName, monthsAggregated);
+        } else if (strcmp(sortType, "Bubble") == 0) {
+            sortTypeValid = 1;
+            monthsSorted = SortRecordsByNormalizedKey(tempFileName, sortedFileName,
+                                                      sizeof(monthlySalesData), &sortKey, SortBubble);
+        } else if (strcmp(sortType, "Merge") == 0) {
+            sortTypeValid = 1;
+            monthsSorted = SortRecordsByNormalizedKey(tempFileName, sortedFileName,
+                                                      sizeof(monthlySalesData), &sortKey, SortMerge);
+        } else if (strcmp(sortType, "Radix") == 0) {
+            sortTypeValid = 1;
+            monthsSorted = SortRecordsByNormalizedKey(tempFileName, sortedFileName,
+                                                      sizeof(monthlySalesData), &sortKey, SortRadix);
+        } else {
+            printf("Error: Invalid sort type '%s'\n", sortType);
+            sortTypeValid = 0;
+            errorOccurred = 1;
+        }
+        
+        StopMetricPhase(METRIC_PHASE_SORT);
+        
+        if (sortTypeValid == 1 && monthsSorted <= 0) {
+            printf("Error: Sorting failed\n");
+            errorOccurred = 1;
+        }
+        
+        if (sortTypeValid == 1 && monthsSorted > 0) {
+            printf("Sorting completed: %d months sorted in %.3f seconds\n",
+                   monthsSorted, GetMetricPhaseSeconds(METRIC_PHASE_SORT));
+        }
+    }
+    
+    // Clean up temporary file
+    remove(tempFileName);
+    
+    if (errorOccurred == 0) {
+        // Generate report header
+        sprintf(reportTitle, "Report 3: Seasonal Patterns and Trends for Order Volume and Revenue");
+        StartMetricPhase(METRIC_PHASE_RENDER);
+        GenerateReportHeader(txtFile, reportTitle);
+        WriteReportDateWindow(txtFile);
+        
+        // Open sorted file and read data
+        sortedFile = OpenFileWithErrorCheck(sortedFileName, "rb");
+        allMonthsData = (monthlySalesData*)calloc((size_t)monthsSorted, sizeof(monthlySalesData));
+        if (sortedFile == NULL || allMonthsData == NULL) {
+            printf("Error: Cannot open sorted monthly data file\n");
+            if (sortedFile != NULL) fclose(sortedFile);
+            errorOccurred = 1;
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        // Read all months and calculate totals
+        WriteToReport(txtFile, "\nMonthly Sales Summary\n");
+        WriteToReport(txtFile, "=====================================================\n");
+        WriteToReport(txtFile, "%-10s %15s %20s\n", "Month", "Orders", "Revenue (USD)");
+        WriteToReport(txtFile, "-----------------------------------------------------\n");
+        
+        monthsRead = 0;
+        while (monthsRead < monthsSorted && CountedRead(&currentMonth, sizeof(monthlySalesData), 1, sortedFile) == 1) {
+            // Display month data
+            WriteToReport(txtFile, "%04u-%02u %15lu %20.2f\n",
+                   currentMonth.year,
+                   currentMonth.month,
+                   currentMonth.orderCount,
+                   currentMonth.totalRevenue);
+            
+            // Store in array for charts
+            allMonthsData[monthsRead] = currentMonth;
+            
+            // Accumulate totals
+            totalOrders += currentMonth.orderCount;
+            totalRevenue += currentMonth.totalRevenue;
+            monthsRead++;
+        }
+        
+        WriteToReport(txtFile, "=====================================================\n");
+        WriteToReport(txtFile, "%-10s %15lu %20.2f\n", "TOTAL", totalOrders, totalRevenue);
+        
+        // Calculate averages
+        if (monthsRead > 0) {
+            avgOrdersPerMonth = (double)totalOrders / (double)monthsRead;
+            avgRevenuePerMonth = totalRevenue / (double)monthsRead;
+            
+            WriteToReport(txtFile, "%-10s %15.2f %20.2f\n", "AVERAGE", avgOrdersPerMonth, avgRevenuePerMonth);
+        }
+        
+        WriteReportSummary(txtFile, "\nTotal months analyzed: %d\n", monthsRead);
+        
+        // Generate ASCII charts
+        DrawASCIIBarChart(txtFile, allMonthsData, monthsRead, 'O');
+        DrawASCIIBarChart(txtFile, allMonthsData, monthsRead, 'R');
+        
+        // Seasonal analysis
+        WriteToReport(txtFile, "\nSeasonal Analysis\n");
+        WriteToReport(txtFile, "=================\n");
+        
+        // Analyze patterns by grouping months into quarters
+        unsigned long q1Orders = 0, q2Orders = 0, q3Orders = 0, q4Orders = 0;
+        double q1Revenue = 0.0, q2Revenue = 0.0, q3Revenue = 0.0, q4Revenue = 0.0;
+        int q1Count = 0, q2Count = 0, q3Count = 0, q4Count = 0;
+        
+        for (int i = 0; i < monthsRead; i++) {
+            if (allMonthsData[i].month >= 1 && allMonthsData[i].month <= 3) {
+                q1Orders += allMonthsData[i].orderCount;
+                q1Revenue += allMonthsData[i].totalRevenue;
+                q1Count++;
+            } else if (allMonthsData[i].month >= 4 && allMonthsData[i].month <= 6) {
+                q2Orders += allMonthsData[i].orderCount;
+                q2Revenue += allMonthsData[i].totalRevenue;
+                q2Count++;
+            } else if (allMonthsData[i].month >= 7 && allMonthsData[i].month <= 9) {
+                q3Orders += allMonthsData[i].orderCount;
+                q3Revenue += allMonthsData[i].totalRevenue;
+                q3Count++;
+            } else if (allMonthsData[i].month >= 10 && allMonthsData[i].month <= 12) {
+                q4Orders += allMonthsData[i].orderCount;
+                q4Revenue += allMonthsData[i].totalRevenue;
+                q4Count++;
+            }
+        }
+        
+        WriteToReport(txtFile, "\nQuarterly Averages:\n");
+        if (q1Count > 0) {
+            WriteToReport(txtFile, "Q1 (Jan-Mar): %.2f orders/month, $%.2f revenue/month\n",
+                   (double)q1Orders / q1Count, q1Revenue / q1Count);
+        }
+        if (q2Count > 0) {
+            WriteToReport(txtFile, "Q2 (Apr-Jun): %.2f orders/month, $%.2f revenue/month\n",
+                   (double)q2Orders / q2Count, q2Revenue / q2Count);
+        }
+        if (q3Count > 0) {
+            WriteToReport(txtFile, "Q3 (Jul-Sep): %.2f orders/month, $%.2f revenue/month\n",
+                   (double)q3Orders / q3Count, q3Revenue / q3Count);
+        }
+        if (q4Count > 0) {
+            WriteToReport(txtFile, "Q4 (Oct-Dec): %.2f orders/month, $%.2f revenue/month\n",
+                   (double)q4Orders / q4Count, q4Revenue / q4Count);
+        }
+        
+        // Identify peak quarter
+        double maxQuarterRevenue = q1Revenue;
+        const char* peakQuarter = "Q1 (Winter)";
+        if (q2Revenue > maxQuarterRevenue) {
+            maxQuarterRevenue = q2Revenue;
+            peakQuarter = "Q2 (Spring)";
+        }
+        if (q3Revenue > maxQuarterRevenue) {
+            maxQuarterRevenue = q3Revenue;
+            peakQuarter = "Q3 (Summer)";
+        }
+        if (q4Revenue > maxQuarterRevenue) {
+            maxQuarterRevenue = q4Revenue;
+            peakQuarter = "Q4 (Fall)";
+        }
+        
+        WriteReportSummary(txtFile, "\nPEAK SEASON: %s with total revenue of $%.2f\n", 
+               peakQuarter, maxQuarterRevenue);
+        
+        // Perform advanced analyses
+        GenerateTrendAnalysis(txtFile, allMonthsData, monthsRead);
+        AnalyzeSeasonalPatternsByCategory(txtFile);
+        AnalyzeSeasonalPatternsByRegion(txtFile);
+        GenerateBusinessRecommendations(txtFile, allMonthsData, monthsRead);
+        
+        fclose(sortedFile);
+        
+        GenerateReportFooter(txtFile, startTime);
+        
+        if (txtFile != NULL) {
+            fclose(txtFile);
+            txtFile = NULL;
+        }
+        
+        printf("\nReport saved successfully in: %s\n", txtFileName);
+        returnValue = 1;
+        
+        // Clean up sorted file
+        remove(sortedFileName);
+    } else {
+        // Error occurred - clean up
+        if (txtFile != NULL) {
+            fclose(txtFile);
+            remove(txtFileName);
+        }
+    }
+    free(allMonthsData);
+    
+    return returnValue;                                // Single return point
+}//end function definition GenerateReport3SeasonalPatterns
+
+// ====================== REPORT 4: DELIVERY TIME ANALYSIS ======================
+
+/*
+ * Function: CompareMonthlyDeliveryData
+ * Purpose: Compares two monthlyDeliveryData records for chronological sorting
+ * Parameters: record1 - pointer to first monthlyDeliveryData
+ *            record2 - pointer to second monthlyDeliveryData
+ * Returns: int - comparison result for Year + Month
+ * Note: Used for sorting monthly delivery data chronologically
+ */
+int CompareMonthlyDeliveryData(const void* record1, const void* record2) {
+    const monthlyDeliveryData* data1 = (const monthlyDeliveryData*)record1;
+    const monthlyDeliveryData* data2 = (const monthlyDeliveryData*)record2;
+    int result = 0;
+    
+    // Compare by year first
+    result = (int)data1->year - (int)data2->year;
+    
+    // If years equal, compare by month
+    if (result == 0) {
+        result = (int)data1->month - (int)data2->month;
+    }
+    
+    return result;
+}//end function definition CompareMonthlyDeliveryData
+
+/*
+ * Function: AggregateDeliveryTimesByMonth
+ * Purpose: Writes the monthly delivery aggregates of the shared sales scan to a file
+ * Parameters: outputFileName - name of file to store monthly aggregated data
+ * Returns: int - number of months processed, -1 on error
+ * Note: Delivery time statistics per month come from LoadSalesScanAggregates, so the
+ *       sales table is only read if no report has scanned it yet
+ */
+int AggregateDeliveryTimesByMonth(const char* outputFileName) {
+    FILE* monthlyFile = NULL;                          // Monthly aggregated data file
+    int monthCount = 0;                                // Number of unique months
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = -1;                              // Return value
+    
+    if (LoadSalesScanAggregates() == 0) {
+        errorOccurred = 1;
+        returnValue = -1;
+    }
+    
+    if (errorOccurred == 0) {
+        monthCount = scanMonthlyDelivery.monthCount;
+        printf("Processed %ld sales records into %d months\n", scanSalesRecords, monthCount);
+        metrics.resultRows = scanSalesRecords;
+        returnValue = monthCount;                      // 0 when no sale falls in the date window
+    }
+    
+    // Write aggregated data to file
+    if (errorOccurred == 0 && monthCount > 0) {
+        monthlyFile = OpenFileWithErrorCheck(outputFileName, "wb");
+        if (monthlyFile == NULL) {
+            printf("Error: Cannot create monthly delivery data file\n");
+            errorOccurred = 1;
+            returnValue = -1;
+        } else {
+            // Write all monthly records
+            for (int i = 0; i < monthCount; i++) {
+                if (CountedWrite(&scanMonthlyDelivery.months[i], sizeof(monthlyDeliveryData), 1, monthlyFile) != 1) {
+                    printf("Error: Failed to write monthly delivery record %d\n", i);
+                    errorOccurred = 1;
+                    returnValue = -1;
+                }
+            }
+            
+            fclose(monthlyFile);
+            
+            if (errorOccurred == 0) {
+                returnValue = monthCount;
+            }
+        }
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition AggregateDeliveryTimesByMonth
+
+/*
+ * Function: DrawDeliveryTimeChart
+ * Purpose: Generates ASCII bar chart for visualizing delivery times
+ * Parameters: txtFile - output file pointer (NULL to write only to console)
+ *            monthlyData - array of monthly delivery data
+ *            dataCount - number of months in the array
+ * Returns: void
+ * Note: Creates horizontal bar chart showing average delivery times
+ */
+void DrawDeliveryTimeChart(FILE* txtFile, const monthlyDeliveryData* monthlyData, int dataCount) {
+    double maxAvg = 0.0;                               // Maximum average delivery time
+    int maxBarLength = 60;                             // Maximum bar length in characters
+    double scaleFactor = 0.0;                          // Scale factor for bars
+    
+    if (dataCount <= 0) {
+        WriteToReport(txtFile, "No data to display\n");
+        return;
+    }
+    
+    // Find maximum value for scaling
+    for (int i = 0; i < dataCount; i++) {
+        if (monthlyData[i].avgDeliveryDays > maxAvg) {
+            maxAvg = monthlyData[i].avgDeliveryDays;
+        }
+    }
+    
+    // Calculate scale factor
+    scaleFactor = (maxAvg > 0.0) ? (double)maxBarLength / maxAvg : 0.0;
+    
+    // Draw chart header
+    WriteToReport(txtFile, "\n=== AVERAGE DELIVERY TIME BY MONTH ===\n");
+    WriteToReport(txtFile, "======================================\n");
+    
+    // Draw bars for each month
+    for (int i = 0; i < dataCount; i++) {
+        int barLength = 0;                             // Length of bar for this month
+        
+        // Calculate bar length
+        barLength = (int)(monthlyData[i].avgDeliveryDays * scaleFactor);
+        
+        // Ensure at least 1 character if value > 0
+        if (barLength == 0 && monthlyData[i].avgDeliveryDays > 0.0) {
+            barLength = 1;
+        }
+        
+        // Print month label
+        WriteToReport(txtFile, "%04u-%02u | ", 
+               monthlyData[i].year, monthlyData[i].month);
+        
+        // Draw bar
+        for (int j = 0; j < barLength; j++) {
+            WriteToReport(txtFile, "█");
+        }
+        
+        // Print value
+        WriteToReport(txtFile, " %.2f days\n", monthlyData[i].avgDeliveryDays);
+    }
+    
+    WriteToReport(txtFile, "\n");
+}//end function definition DrawDeliveryTimeChart
+
+/*
+ * Function: AnalyzeDeliveryTrends
+ * Purpose: Analyzes delivery time trends and changes over time
+ * Parameters: txtFile - output file pointer
+ *            monthlyData - array of monthly data
+ *            dataCount - number of months
+ * Returns: void
+ * Note: Calculates improvements/deteriorations in delivery times
+ */
+void AnalyzeDeliveryTrends(FILE* txtFile, const monthlyDeliveryData* monthlyData, int dataCount) {
+    WriteToReport(txtFile, "\n=== DELIVERY TIME TREND ANALYSIS ===\n");
+    WriteToReport(txtFile, "====================================\n");
+    
+    if (dataCount < 2) {
+        WriteToReport(txtFile, "Insufficient data for trend analysis\n");
+        return;
+    }
+    
+    // Calculate month-over-month changes
+    double avgChange = 0.0;
+    int changeCount = 0;
+    int improvementMonths = 0;
+    int deteriorationMonths = 0;
+    
+    WriteToReport(txtFile, "\nMonth-over-Month Changes:\n");
+    WriteToReport(txtFile, "%-10s %15s %15s\n", "Period", "Avg Days", "Change");
+    WriteToReport(txtFile, "----------------------------------------------------\n");
+    
+    for (int i = 1; i < dataCount; i++) {
+        double change = monthlyData[i].avgDeliveryDays - monthlyData[i-1].avgDeliveryDays;
+        double percentChange = 0.0;
+        
+        if (monthlyData[i-1].avgDeliveryDays > 0.0) {
+            percentChange = (change / monthlyData[i-1].avgDeliveryDays) * 100.0;
+        }
+        
+        WriteToReport(txtFile, "%04u-%02u %15.2f %+14.2f (%.1f%%)\n",
+               monthlyData[i].year, monthlyData[i].month,
+               monthlyData[i].avgDeliveryDays, change, percentChange);
+        
+        avgChange += change;
+        changeCount++;
+        
+        if (change < 0) {
+            improvementMonths++;
+        } else if (change > 0) {
+            deteriorationMonths++;
+        }
+    }
+    
+    if (changeCount > 0) {
+        avgChange /= changeCount;
+        
+        WriteToReport(txtFile, "\nTrend Summary:\n");
+        WriteToReport(txtFile, "  Average change per month: %+.2f days\n", avgChange);
+        WriteToReport(txtFile, "  Months with improvement: %d\n", improvementMonths);
+        WriteToReport(txtFile, "  Months with deterioration: %d\n", deteriorationMonths);
+        
+        // Interpret trend
+        WriteToReport(txtFile, "\nInterpretation:\n");
+        if (avgChange < -0.5) {
+            WriteToReport(txtFile, "  ✓ Positive trend - Delivery times are improving\n");
+        } else if (avgChange > 0.5) {
+            WriteToReport(txtFile, "  ⚠ Negative trend - Delivery times are increasing\n");
+        } else {
+            WriteToReport(txtFile, "  → Stable - Delivery times remain consistent\n");
+        }
+    }
+}//end function definition AnalyzeDeliveryTrends
+
+/*
+ * Function: GenerateDeliveryRecommendations
+ * Purpose: Generates business recommendations based on delivery performance
+ * Parameters: txtFile - output file pointer
+ *            monthlyData - array of monthly data
+ *            dataCount - number of months
+ *            overallAvg - overall average delivery time
+ * Returns: void
+ * Note: Provides actionable insights for logistics improvement
+ */
+void GenerateDeliveryRecommendations(FILE* txtFile, const monthlyDeliveryData* monthlyData, 
+                                     int dataCount, double overallAvg) {
+    WriteToReport(txtFile, "\n\n=== BUSINESS RECOMMENDATIONS ===\n");
+    WriteToReport(txtFile, "================================\n");
+    
+    if (dataCount == 0) {
+        return;
+    }
+    
+    // Find best and worst months
+    double bestAvg = 999999.0;
+    double worstAvg = 0.0;
+    int bestMonth = 0;
+    int worstMonth = 0;
+    
+    for (int i = 0; i < dataCount; i++) {
+        if (monthlyData[i].avgDeliveryDays < bestAvg) {
+            bestAvg = monthlyData[i].avgDeliveryDays;
+            bestMonth = i;
+        }
+        if (monthlyData[i].avgDeliveryDays > worstAvg) {
+            worstAvg = monthlyData[i].avgDeliveryDays;
+            worstMonth = i;
+        }
+    }
+    
+    double performanceVariation = worstAvg - bestAvg;
+    
+    WriteToReport(txtFile, "\n1. LOGISTICS PERFORMANCE:\n");
+    WriteToReport(txtFile, "   Overall average delivery time: %.2f days\n", overallAvg);
+    WriteToReport(txtFile, "   Best performance: %.2f days (%04u-%02u)\n",
+           bestAvg, monthlyData[bestMonth].year, monthlyData[bestMonth].month);
+    WriteToReport(txtFile, "   Worst performance: %.2f days (%04u-%02u)\n",
+           worstAvg, monthlyData[worstMonth].year, monthlyData[worstMonth].month);
+    WriteToReport(txtFile, "   Performance variation: %.2f days\n", performanceVariation);
+    
+    WriteToReport(txtFile, "\n2. TARGET SETTING:\n");
+    if (overallAvg <= 5.0) {
+        WriteToReport(txtFile, "   ✓ EXCELLENT - Current performance is very competitive\n");
+        WriteToReport(txtFile, "   Target: Maintain average below 5 days\n");
+        WriteToReport(txtFile, "   Focus: Consistency and quality\n");
+    } else if (overallAvg <= 10.0) {
+        WriteToReport(txtFile, "   ✓ GOOD - Performance meets industry standards\n");
+        WriteToReport(txtFile, "   Target: Reduce to %.2f days (10%% improvement)\n", overallAvg * 0.9);
+        WriteToReport(txtFile, "   Focus: Optimize high-volume routes\n");
+    } else if (overallAvg <= 15.0) {
+        WriteToReport(txtFile, "   ⚠ MODERATE - Room for significant improvement\n");
+        WriteToReport(txtFile, "   Target: Reduce to %.2f days (20%% improvement)\n", overallAvg * 0.8);
+        WriteToReport(txtFile, "   Focus: Process optimization and carrier performance\n");
+    } else {
+        WriteToReport(txtFile, "   ⚠ NEEDS IMPROVEMENT - Delivery times are concerning\n");
+        WriteToReport(txtFile, "   Target: Reduce to %.2f days (30%% improvement)\n", overallAvg * 0.7);
+        WriteToReport(txtFile, "   Focus: Complete logistics overhaul needed\n");
+    }
+    
+    WriteToReport(txtFile, "\n3. RECOMMENDED ACTIONS:\n");
+    if (performanceVariation > 5.0) {
+        WriteToReport(txtFile, "   ⚠ HIGH VARIATION DETECTED:\n");
+        WriteToReport(txtFile, "   - Investigate causes of delays in worst months\n");
+        WriteToReport(txtFile, "   - Standardize processes across all periods\n");
+        WriteToReport(txtFile, "   - Implement seasonal capacity planning\n");
+    }
+    
+    WriteToReport(txtFile, "\n   General Improvements:\n");
+    WriteToReport(txtFile, "   - Negotiate service level agreements with carriers\n");
+    WriteToReport(txtFile, "   - Implement real-time tracking systems\n");
+    WriteToReport(txtFile, "   - Optimize warehouse locations for faster delivery\n");
+    WriteToReport(txtFile, "   - Review and streamline order processing workflow\n");
+    WriteToReport(txtFile, "   - Consider regional distribution centers\n");
+    
+    if (overallAvg > 10.0) {
+        WriteToReport(txtFile, "\n   Priority Actions:\n");
+        WriteToReport(txtFile, "   - Evaluate alternative shipping carriers\n");
+        WriteToReport(txtFile, "   - Implement expedited shipping options\n");
+        WriteToReport(txtFile, "   - Review inventory positioning strategy\n");
+    }
+    
+    WriteToReport(txtFile, "\n4. MONITORING STRATEGY:\n");
+    WriteToReport(txtFile, "   - Track delivery times daily\n");
+    WriteToReport(txtFile, "   - Set alerts for orders exceeding %.0f days\n", overallAvg * 1.5);
+    WriteToReport(txtFile, "   - Monthly review of carrier performance\n");
+    WriteToReport(txtFile, "   - Customer feedback on delivery satisfaction\n");
+}//end function definition GenerateDeliveryRecommendations
+
+/*
+ * Function: GenerateReport4DeliveryTimeAnalysis
+ * Purpose: Generates Report 4 - Average Delivery Time Analysis
+ * Parameters: sortType - "Bubble", "Merge" or "Radix" to specify sorting algorithm
+ * Returns: int - 1 if the report was written, 0 on error
+ * Note: Analyzes delivery performance and trends over time
+ *       Similar structure to Report 3 with charts and recommendations
+ */
+int GenerateReport4DeliveryTimeAnalysis(const char* sortType) {
+    FILE* sortedFile = NULL;                           // Sorted monthly data file
+    FILE* txtFile = NULL;                              // Output text report file
+    char tempFileName[300] = {0};                      // Temporary aggregated data file
+    char sortedFileName[300] = {0};                    // Sorted data file
+    char txtFileName[300] = {0};                       // Text report file name
+    char reportTitle[150] = {0};                       // Report title
+    monthlyDeliveryData currentMonth;                  // Current month data
+    monthlyDeliveryData* allMonthsData = NULL;         // All months (monthsSorted entries)
+    int monthsAggregated = 0;                          // Number of months aggregated
+    int monthsSorted = 0;                              // Number of months sorted
+    int monthsRead = 0;                                // Number of months read
+    unsigned long totalOrders = 0;                     // Total orders
+    double overallAvg = 0.0;                           // Overall average delivery time
+    unsigned short globalMin = USHRT_MAX;              // Global minimum
+    unsigned short globalMax = 0;                      // Global maximum
+    time_t startTime = 0;                              // Report generation start time
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = 0;                               // Return value (single return pattern)
+    int sortTypeValid = 0;                             // Sort type validation flag
+    sortKeySpec sortKey;                               // Normalized sort key specification
+    
+    printf("\nGenerating Report 4: Delivery Time Analysis\n");
+    printf("Using %s sort algorithm...\n", sortType);
+    
+    time(&startTime);
+    
+    // Generate filenames
+    sprintf(tempFileName, "temp_delivery_%ld.dat", (long)time(NULL));
+    sprintf(txtFileName, "Report_4_Delivery_%s_%ld.txt", sortType, (long)time(NULL));
+    BeginReportMetrics(txtFileName);
+    
+    // Open text file for report output
+    txtFile = OpenReportFile(txtFileName);
+    if (txtFile == NULL) {
+        printf("Error: Cannot create report text file\n");
+        return returnValue;
+    }
+    
+    // Aggregate delivery times by month
+    StartMetricPhase(METRIC_PHASE_AGGREGATE);
+    monthsAggregated = AggregateDeliveryTimesByMonth(tempFileName);
+    StopMetricPhase(METRIC_PHASE_AGGREGATE);
+    if (monthsAggregated == 0) {
+        printf("Error: No delivered sales in the selected order dates\n");
+        errorOccurred = 1;
+    } else if (monthsAggregated < 0) {
+        printf("Error: Failed to aggregate delivery data\n");
+        errorOccurred = 1;
+    }
+    
+    if (errorOccurred == 0) {
+        // Generate sorted filename
+        GenerateSortedFileName("Delivery", sortType, sortedFileName);
+        
+        printf("Sorting monthly data using %s sort...\n", sortType);
+        StartMetricPhase(METRIC_PHASE_SORT);
+        
+        // Sort monthly data chronologically
+        BuildMonthlyDeliverySortKeySpec(&sortKey);
+        if ((strcmp(sortType, "Bubble") == 0 || strcmp(sortType, "Merge") == 0 || strcmp(sortType, "Radix") == 0) &&
+            MonthlyDataInDateOrder() == 1) {
+            sortTypeValid = 1;
+            monthsSorted = KeepMonthlyDataOrder(tempFileName, sortedFileName, monthsAggregated);
+        } else if (strcmp(sortType, "Bubble") == 0) {
+            sortTypeValid = 1;
+            monthsSorted = SortRecordsByNormalizedKey(tempFileName, sortedFileName,
+                                                      sizeof(monthlyDeliveryData), &sortKey, SortBubble);
+        } else if (strcmp(sortType, "Merge") == 0) {
+            sortTypeValid = 1;
+            monthsSorted = SortRecordsByNormalizedKey(tempFileName, sortedFileName,
+                                                      sizeof(monthlyDeliveryData), &sortKey, SortMerge);
+        } else if (strcmp(sortType, "Radix") == 0) {
+            sortTypeValid = 1;
+            monthsSorted = SortRecordsByNormalizedKey(tempFileName, sortedFileName,
+                                                      sizeof(monthlyDeliveryData), &sortKey, SortRadix);
+        } else {
+            printf("Error: Invalid sort type '%s'\n", sortType);
+            sortTypeValid = 0;
+            errorOccurred = 1;
+        }
+        
+        StopMetricPhase(METRIC_PHASE_SORT);
+        
+        if (sortTypeValid == 1 && monthsSorted <= 0) {
+            printf("Error: Sorting failed\n");
+            errorOccurred = 1;
+        }
+        
+        if (sortTypeValid == 1 && monthsSorted > 0) {
+            printf("Sorting completed: %d months sorted in %.3f seconds\n",
+                   monthsSorted, GetMetricPhaseSeconds(METRIC_PHASE_SORT));
+        }
+    }
+    
+    // Clean up temporary file
+    remove(tempFileName);
+    
+    if (errorOccurred == 0) {
+        // Generate report header
+        sprintf(reportTitle, "Report 4: Average Delivery Time Analysis and Trends Over Time");
+        StartMetricPhase(METRIC_PHASE_RENDER);
+        GenerateReportHeader(txtFile, reportTitle);
+        WriteReportDateWindow(txtFile);
+        
+        // Open sorted file and read data
+        sortedFile = OpenFileWithErrorCheck(sortedFileName, "rb");
+        allMonthsData = (monthlyDeliveryData*)calloc((size_t)monthsSorted, sizeof(monthlyDeliveryData));
+        if (sortedFile == NULL || allMonthsData == NULL) {
+            printf("Error: Cannot open sorted delivery data file\n");
+            if (sortedFile != NULL) fclose(sortedFile);
+            errorOccurred = 1;
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        // Read all months and calculate statistics
+        WriteToReport(txtFile, "\n=== MONTHLY DELIVERY TIME SUMMARY ===\n");
+        WriteToReport(txtFile, "=====================================\n");
+        WriteToReport(txtFile, "%-10s %10s %12s %10s %10s\n", 
+               "Month", "Orders", "Avg Days", "Min Days", "Max Days");
+        WriteToReport(txtFile, "-----------------------------------------------------------\n");
+        
+        monthsRead = 0;
+        unsigned long totalDeliveryDays = 0;
+        
+        while (monthsRead < monthsSorted && CountedRead(&currentMonth, sizeof(monthlyDeliveryData), 1, sortedFile) == 1) {
+            // Display month data
+            WriteToReport(txtFile, "%04u-%02u %10lu %12.2f %10u %10u\n",
+                   currentMonth.year,
+                   currentMonth.month,
+                   currentMonth.orderCount,
+                   currentMonth.avgDeliveryDays,
+                   currentMonth.minDeliveryDays,
+                   currentMonth.maxDeliveryDays);
+            
+            // Store in array for analysis
+            allMonthsData[monthsRead] = currentMonth;
+            
+            // Accumulate totals
+            totalOrders += currentMonth.orderCount;
+            totalDeliveryDays += currentMonth.totalDeliveryDays;
+            
+            // Update global min/max
+            if (currentMonth.minDeliveryDays < globalMin) {
+                globalMin = currentMonth.minDeliveryDays;
+            }
+            if (currentMonth.maxDeliveryDays > globalMax) {
+                globalMax = currentMonth.maxDeliveryDays;
+            }
+            
+            monthsRead++;
+        }
+        
+        // Calculate overall average
+        if (totalOrders > 0) {
+            overallAvg = (double)totalDeliveryDays / (double)totalOrders;
+            overallAvg = RoundToThirdDecimal(overallAvg);
+        }
+        
+        WriteToReport(txtFile, "=====================================\n");
+        WriteToReport(txtFile, "%-10s %10lu %12.2f %10u %10u\n", 
+               "OVERALL", totalOrders, overallAvg, globalMin, globalMax);
+        WriteReportSummary(txtFile, "\nTotal months analyzed: %d\n", monthsRead);
+        
+        // Generate ASCII chart
+        DrawDeliveryTimeChart(txtFile, allMonthsData, monthsRead);
+        
+        // Perform trend analysis
+        AnalyzeDeliveryTrends(txtFile, allMonthsData, monthsRead);
+        
+        // Generate recommendations
+        GenerateDeliveryRecommendations(txtFile, allMonthsData, monthsRead, overallAvg);
+        
+        fclose(sortedFile);
+        
+        GenerateReportFooter(txtFile, startTime);
+        
+        if (txtFile != NULL) {
+            fclose(txtFile);
+            txtFile = NULL;
+        }
+        
+        printf("\nReport saved successfully in: %s\n", txtFileName);
+        returnValue = 1;
+        
+        // Clean up sorted file
+        remove(sortedFileName);
+    } else {
+        // Error occurred - clean up
+        if (txtFile != NULL) {
+            fclose(txtFile);
+            remove(txtFileName);
+        }
+    }
+    free(allMonthsData);
+    
+    return returnValue;                                // Single return point
+}//end function definition GenerateReport4DeliveryTimeAnalysis
+
+// ====================== REPORT GENERATORS ======================
+
+/*
+ * Function: GetReportPreferences
+ * Purpose: Asks user for report display preferences (limit, order)
+ * Parameters: maxRecords - pointer to store max records to display (0 = all)
+ *            ascending - pointer to store sort order (1 = ascending, 0 = descending)
+ * Returns: int - 1 if successful, 0 if user cancelled
+ * Note: Interactive function to configure report output. In batch mode the
+ *       preferences come from the command line instead.
+ */
+int GetReportPreferences(int* maxRecords, int* ascending) {
+    int limitChoice = 0;
+    int orderChoice = 0;
+    int returnValue = 1;  // Default success value
+    int errorOccurred = 0;  // Error flag for single return pattern
+    int askUser = 1;  // 0 when the preferences come from the command line
+    
+    if (batchOptions.active == 1) {
+        *maxRecords = batchOptions.maxRecords;
+        *ascending = batchOptions.ascending;
+        askUser = 0;
+    } else {
+        printf("\n=== Report Configuration ===\n");
+    }
+    
+    // Ask about record limit
+    if (askUser == 1) {
+        printf("How many records do you want to display?\n");
+        printf("1. All records\n");
+        printf("2. Specific number of records\n");
+        printf("Your choice: ");
+        
+        if (scanf("%d", &limitChoice) != 1) {
+            printf("Invalid input.\n");
+            while (getchar() != '\n');
+            errorOccurred = 1;
+            returnValue = 0;
+        }
+    }
+    
+    if (errorOccurred == 0 && askUser == 1) {
+        if (limitChoice == 1) {
+            *maxRecords = 0;  // 0 means all records
+        } else if (limitChoice == 2) {
+            printf("Enter the number of records to display: ");
+            if (scanf("%d", maxRecords) != 1 || *maxRecords < 1) {
+                printf("Invalid number.\n");
+                while (getchar() != '\n');
+                errorOccurred = 1;
+                returnValue = 0;
+            }
+        } else {
+            printf("Invalid choice.\n");
+            errorOccurred = 1;
+            returnValue = 0;
+        }
+    }
+    
+    // Ask about sort order only if no errors occurred
+    if (errorOccurred == 0 && askUser == 1) {
+        printf("\nSort order:\n");
+        printf("1. Ascending (A-Z, 0-9)\n");
+        printf("2. Descending (Z-A, 9-0)\n");
+        printf("Your choice: ");
+        
+        if (scanf("%d", &orderChoice) != 1) {
+            printf("Invalid input.\n");
+            while (getchar() != '\n');
+            errorOccurred = 1;
+            returnValue = 0;
+        }
+    }
+    
+    if (errorOccurred == 0 && askUser == 1) {
+        if (orderChoice == 1) {
+            *ascending = 1;
+        } else if (orderChoice == 2) {
+            *ascending = 0;
+        } else {
+            printf("Invalid choice.\n");
+            errorOccurred = 1;
+            returnValue = 0;
+        }
+    }
+    
+    return returnValue;  // Single return point
+}//end function definition GetReportPreferences
+
+/*
+ * Function: SearchInReport2
+ * Purpose: Allows user to search for specific products in Report 2 sorted data
+ * Parameters: sortedFileName - name of the sorted report file
+ * Returns: void
+ * Note: Interactive binary search with multiple search criteria options
+ */
+void SearchInReport2(const char* sortedFileName) {
+    char searchProductName[31] = {0};
+    char searchContinent[20] = {0};
+    char searchCountry[20] = {0};
+    productCustomerRecord searchKey;
+    productCustomerRecord foundRecord;
+    long startPos = -1;
+    long endPos = -1;
+    FILE* sortedFile = NULL;
+    int searchResult = 0;
+    int continueSearching = 1;
+    char choice = 'n';
+    int searchOption = 0;
+    
+    printf("\n=== Search in Report 2 ===\n");
+    
+    while (continueSearching == 1) {
+        if (batchOptions.active == 1) {
+            searchOption = batchOptions.searchOption;
+        } else {
+            printf("\nSearch options:\n");
+            printf("1. Search by Product Name\n");
+            printf("2. Search by Product Name + Continent\n");
+            printf("3. Search by Product Name + Continent + Country\n");
+            printf("4. Browse all records\n");
+            printf("0. Exit search\n");
+            printf("Your choice: ");
+        }
+        
+        if (batchOptions.active == 0 && scanf("%d", &searchOption) != 1) {
+            printf("Invalid input.\n");
+            while (getchar() != '\n');
+            searchOption = 0;
+        }
+        
+        if (searchOption == 0) {
+            continueSearching = 0;
+        } else if (searchOption >= 1 && searchOption <= 4) {
+            // Initialize search key
+            InitializeStructureToZero(&searchKey, sizeof(productCustomerRecord));
+            
+            if (searchOption >= 1 && batchOptions.active == 1) {
+                strncpy(searchProductName, batchOptions.productName, 30);
+                strncpy(searchContinent, batchOptions.continent, 19);
+                strncpy(searchCountry, batchOptions.country, 19);
+            }
+            
+            if (searchOption >= 1) {
+                if (batchOptions.active == 0) {
+                    printf("Enter product name to search: ");
+                    scanf(" %30[^\n]", searchProductName);
+                }
+                strncpy(searchKey.product.productName, searchProductName, 29);
+                searchKey.product.productName[29] = '\0';
+            }
+            
+            if (searchOption >= 2) {
+                if (batchOptions.active == 0) {
+                    printf("Enter continent: ");
+                    scanf(" %19[^\n]", searchContinent);
+                }
+                strncpy(searchKey.continent, searchContinent, 19);
+                searchKey.continent[19] = '\0';
+            }
+            
+            if (searchOption >= 3) {
+                if (batchOptions.active == 0) {
+                    printf("Enter country: ");
+                    scanf(" %19[^\n]", searchCountry);
+                }
+                strncpy(searchKey.country, searchCountry, 19);
+                searchKey.country[19] = '\0';
+            }
+            
+            // Try binary search first for exact match
+            searchResult = SearchBinaryRange(sortedFileName, &searchKey, 
+                                            sizeof(productCustomerRecord),
+                                            CompareProductNameOnly, &startPos, &endPos);
+            
+            // If exact match not found, do sequential search for partial matches
+            if (searchResult <= 0 || startPos < 0) {
+                printf("\nExact match not found. Searching for partial matches...\n");
+                
+                sortedFile = fopen(sortedFileName, "rb");
+                if (sortedFile != NULL) {
+                    char lowerSearch[31] = {0};
+                    char lowerProduct[31] = {0};
+                    ToLowerCase(lowerSearch, searchProductName, 31);
+                    
+                    printf("\n*** FOUND (Partial Matches) ***\n");
+                    printf("Products containing '%s':\n\n", searchProductName);
+                    printf("Locations:\n");
+                    printf("--------------------------------------------------------------------------------------\n");
+                    printf("%-30s %-15s %-15s %-20s %-20s\n", "Product", "Continent", "Country", "State", "City");
+                    printf("--------------------------------------------------------------------------------------\n");
+                    
+                    int matchCount = 0;
+                    char lastShownProduct[30] = {0};
+                    char lastShownContinent[20] = {0};
+                    char lastShownCountry[20] = {0};
+                    char lastShownState[30] = {0};
+                    char lastShownCity[40] = {0};
+                    
+                    while (CountedRead(&foundRecord, sizeof(productCustomerRecord), 1, sortedFile) == 1) {
+                        // Convert product name to lowercase for comparison
+                        ToLowerCase(lowerProduct, foundRecord.product.productName, 31);
+                        
+                        // Check if search term is substring of product name (case-insensitive)
+                        if (strstr(lowerProduct, lowerSearch) != NULL) {
+                            int matches = 1;
+                            
+                            // Apply additional filters
+                            if (searchOption >= 2 && strcmp(foundRecord.continent, searchContinent) != 0) {
+                                matches = 0;
+                            }
+                            if (searchOption >= 3 && strcmp(foundRecord.country, searchCountry) != 0) {
+                                matches = 0;
+                            }
+                            
+                            // Check for duplicate location
+                            if (matches == 1) {
+                                if (strcmp(lastShownProduct, foundRecord.product.productName) == 0 &&
+                                    strcmp(lastShownContinent, foundRecord.continent) == 0 &&
+                                    strcmp(lastShownCountry, foundRecord.country) == 0 &&
+                                    strcmp(lastShownState, foundRecord.state) == 0 &&
+                                    strcmp(lastShownCity, foundRecord.customer.city) == 0) {
+                                    matches = 0;
+                                }
+                            }
+                            
+                            if (matches == 1) {
+                                printf("%-30s %-15s %-15s %-20s %-20s\n",
+                                       foundRecord.product.productName,
+                                       foundRecord.continent,
+                                       foundRecord.country,
+                                       foundRecord.state,
+                                       foundRecord.customer.city);
+                                matchCount++;
+                                
+                                // Remember this location
+                                strncpy(lastShownProduct, foundRecord.product.productName, 29);
+                                lastShownProduct[29] = '\0';
+                                strncpy(lastShownContinent, foundRecord.continent, 19);
+                                lastShownContinent[19] = '\0';
+                                strncpy(lastShownCountry, foundRecord.country, 19);
+                                lastShownCountry[19] = '\0';
+                                strncpy(lastShownState, foundRecord.state, 29);
+                                lastShownState[29] = '\0';
+                                strncpy(lastShownCity, foundRecord.customer.city, 39);
+                                lastShownCity[39] = '\0';
+                            }
+                        }
+                    }
+                    
+                    printf("--------------------------------------------------------------------------------------\n");
+                    if (matchCount > 0) {
+                        printf("Total matching locations: %d\n", matchCount);
+                    } else {
+                        printf("\n*** NOT FOUND ***\n");
+                        printf("No products containing '%s' were found.\n", searchProductName);
+                    }
+                    
+                    fclose(sortedFile);
+                    sortedFile = NULL;
+                }
+            } else if (searchResult >= 1 && startPos >= 0) {
+                printf("\n*** FOUND ***\n");
+                
+                if (searchOption == 1) {
+                    printf("Product '%s' found! Showing all locations:\n\n", searchProductName);
+                } else if (searchOption == 2) {
+                    printf("Product '%s' in '%s' found!\n\n", searchProductName, searchContinent);
+                } else if (searchOption == 3) {
+                    printf("Product '%s' in '%s, %s' found!\n\n", searchProductName, searchCountry, searchContinent);
+                }
+                
+                // Open file and read matching records
+                sortedFile = fopen(sortedFileName, "rb");
+                if (sortedFile != NULL &&
+                    CountedSeek64(sortedFile, (long long)startPos * (long long)sizeof(productCustomerRecord), SEEK_SET) != 0) {
+                    printf("Error: Cannot seek in %s\n", sortedFileName);
+                    fclose(sortedFile);
+                    sortedFile = NULL;
+                }
+                if (sortedFile != NULL) {
+                    
+                    printf("Locations:\n");
+                    printf("--------------------------------------------------------------------------------------\n");
+                    printf("%-30s %-15s %-15s %-20s %-20s\n", "Product", "Continent", "Country", "State", "City");
+                    printf("--------------------------------------------------------------------------------------\n");
+                    
+                    long currentPos = startPos;
+                    int matchCount = 0;
+                    char lastShownContinent[20] = {0};
+                    char lastShownCountry[20] = {0};
+                    char lastShownState[30] = {0};
+                    char lastShownCity[40] = {0};
+                    
+                    while (currentPos <= endPos && 
+                           CountedRead(&foundRecord, sizeof(productCustomerRecord), 1, sortedFile) == 1) {
+                        
+                        // Apply additional filters based on search option
+                        int matches = 1;
+                        
+                        if (searchOption >= 1 && strcmp(foundRecord.product.productName, searchProductName) != 0) {
+                            matches = 0;
+                        }
+                        if (searchOption >= 2 && strcmp(foundRecord.continent, searchContinent) != 0) {
+                            matches = 0;
+                        }
+                        if (searchOption >= 3 && strcmp(foundRecord.country, searchCountry) != 0) {
+                            matches = 0;
+                        }
+                        
+                        // Check for duplicate location (avoid showing same location twice)
+                        if (matches == 1) {
+                            if (strcmp(lastShownContinent, foundRecord.continent) == 0 &&
+                                strcmp(lastShownCountry, foundRecord.country) == 0 &&
+                                strcmp(lastShownState, foundRecord.state) == 0 &&
+                                strcmp(lastShownCity, foundRecord.customer.city) == 0) {
+                                matches = 0;  // Skip duplicate
+                            }
+                        }
+                        
+                        if (matches == 1) {
+                            printf("%-30s %-15s %-15s %-20s %-20s\n",
+                                   foundRecord.product.productName,
+                                   foundRecord.continent,
+                                   foundRecord.country,
+                                   foundRecord.state,
+                                   foundRecord.customer.city);
+                            matchCount++;
+                            
+                            // Remember this location to avoid duplicates
+                            strncpy(lastShownContinent, foundRecord.continent, 19);
+                            lastShownContinent[19] = '\0';
+                            strncpy(lastShownCountry, foundRecord.country, 19);
                             lastShownCountry[19] = '\0';
-                            strncpy(lastShownState, foundRecord.customer.state, 29);
+                            strncpy(lastShownState, foundRecord.state, 29);
                             lastShownState[29] = '\0';
                             strncpy(lastShownCity, foundRecord.customer.city, 39);
                             lastShownCity[39] = '\0';
@@ -3469,501 +7303,1833 @@ void SearchInReport2(const char* sortedFileName) {
                     }
                     
                     printf("--------------------------------------------------------------------------------------\n");
-                    printf("Total matching locations: %d\n", matchCount);
+                    printf("Total matching locations: %d\n", matchCount);
+                    fclose(sortedFile);
+                    sortedFile = NULL;
+                }
+            } else if (searchOption == 4) {
+                // Browse all records
+                printf("\n=== All Products and Locations ===\n");
+                sortedFile = fopen(sortedFileName, "rb");
+                if (sortedFile != NULL) {
+                    printf("%-30s %-15s %-15s %-20s %-20s\n", "Product", "Continent", "Country", "State", "City");
+                    printf("--------------------------------------------------------------------------------------\n");
+                    
+                    int count = 0;
+                    int maxShow = 50;
+                    
+                    printf("Show how many records? (0 = all): ");
+                    scanf("%d", &maxShow);
+                    
+                    int continueReading = 1;
+                    while (CountedRead(&foundRecord, sizeof(productCustomerRecord), 1, sortedFile) == 1 && continueReading == 1) {
+                        if (maxShow > 0 && count >= maxShow) {
+                            printf("... (showing first %d records)\n", maxShow);
+                            continueReading = 0;  // Stop loop instead of break
+                        }
+                        
+                        if (continueReading == 1) {
+                            printf("%-30s %-15s %-15s %-20s %-20s\n",
+                                   foundRecord.product.productName,
+                                   foundRecord.continent,
+                                   foundRecord.country,
+                                   foundRecord.state,
+                                   foundRecord.customer.city);
+                            count++;
+                        }
+                    }
+                    
+                    printf("--------------------------------------------------------------------------------------\n");
+                    printf("Total records shown: %d\n", count);
+                    fclose(sortedFile);
+                }
+            }
+            
+            if (batchOptions.active == 1) {
+                continueSearching = 0;                 // One search per command line
+            } else {
+                printf("\nPerform another search? (y/n): ");
+                scanf(" %c", &choice);
+                if (choice != 'y' && choice != 'Y') {
+                    continueSearching = 0;
+                }
+            }
+        } else {
+            printf("Invalid option.\n");
+        }
+    }
+}//end function definition SearchInReport2
+
+/*
+ * Function: SearchInReport5
+ * Purpose: Allows user to search for specific customers or orders in Report 5 sorted data
+ * Parameters: sortedFileName - name of the sorted report file
+ * Returns: void
+ * Note: Interactive binary search with multiple search criteria options
+ */
+void SearchInReport5(const char* sortedFileName) {
+    char searchCustomerName[40] = {0};
+    salesCustomerRecord searchKey;
+    salesCustomerRecord foundRecord;
+    dateStructure orderDate;
+    const productRecord* saleProduct = NULL;
+    long startPos = -1;
+    long endPos = -1;
+    FILE* sortedFile = NULL;
+    int searchResult = 0;
+    int continueSearching = 1;
+    char choice = 'n';
+    double customerTotal = 0.0;
+    int searchOption = 0;
+    long searchOrderNumber = 0;
+    unsigned short searchProductKey = 0;
+    
+    printf("\n=== Search in Report 5 ===\n");
+    
+    while (continueSearching == 1) {
+        if (batchOptions.active == 1) {
+            searchOption = batchOptions.searchOption;
+        } else {
+            printf("\nSearch options:\n");
+            printf("1. Search by Customer Name\n");
+            printf("2. Search by Customer Name + Order Date\n");
+            printf("3. Search by Customer Name + Order Number\n");
+            printf("4. Search by Customer Name + Product Key\n");
+            printf("5. Browse all customers\n");
+            printf("0. Exit search\n");
+            printf("Your choice: ");
+        }
+        
+        if (batchOptions.active == 0 && scanf("%d", &searchOption) != 1) {
+            printf("Invalid input.\n");
+            while (getchar() != '\n');
+            searchOption = 0;
+        }
+        
+        if (searchOption == 0) {
+            continueSearching = 0;
+        } else if (searchOption >= 1 && searchOption <= 5) {
+            // Initialize search key
+            InitializeStructureToZero(&searchKey, sizeof(salesCustomerRecord));
+            
+            if (searchOption >= 1 && searchOption <= 4 && batchOptions.active == 1) {
+                strncpy(searchCustomerName, batchOptions.customerName, 39);
+                searchKey.sale.orderDay = DateToDayNumber(&batchOptions.orderDate);
+                searchOrderNumber = batchOptions.orderNumber;
+                searchProductKey = batchOptions.productKey;
+                searchKey.sale.productKey = searchProductKey;
+            }
+            
+            if (searchOption >= 1 && searchOption <= 4 && batchOptions.active == 0) {
+                printf("Enter customer name to search: ");
+                scanf(" %39[^\n]", searchCustomerName);
+            }
+            if (searchOption >= 1 && searchOption <= 4) {
+                strncpy(searchKey.customer.name, searchCustomerName, 39);
+                searchKey.customer.name[39] = '\0';
+            }
+            
+            if (searchOption == 2 && batchOptions.active == 0) {
+                printf("Enter order date (MM/DD/YYYY): ");
+                int month, day, year;
+                dateStructure enteredDate;
+                if (scanf("%d/%d/%d", &month, &day, &year) == 3 &&
+                    StoreCalendarDate(month, day, year, &enteredDate) == 1) {
+                    searchKey.sale.orderDay = DateToDayNumber(&enteredDate);
+                } else {
+                    printf("Invalid date format.\n");
+                    while (getchar() != '\n');
+                    continue;
+                }
+            }
+            
+            if (searchOption == 3 && batchOptions.active == 0) {
+                printf("Enter order number: ");
+                if (scanf("%ld", &searchOrderNumber) != 1) {
+                    printf("Invalid order number.\n");
+                    while (getchar() != '\n');
+                    continue;
+                }
+            }
+            
+            if (searchOption == 4 && batchOptions.active == 0) {
+                printf("Enter product key: ");
+                if (scanf("%hu", &searchProductKey) != 1) {
+                    printf("Invalid product key.\n");
+                    while (getchar() != '\n');
+                    continue;
+                }
+                searchKey.sale.productKey = searchProductKey;
+            }
+            
+            // Try binary search first for exact match
+            searchResult = SearchBinaryRange(sortedFileName, &searchKey, 
+                                            sizeof(salesCustomerRecord),
+                                            CompareCustomerNameOnly, &startPos, &endPos);
+            
+            // If exact match not found, do sequential search for partial matches
+            if ((searchResult <= 0 || startPos < 0) && searchOption >= 1 && searchOption <= 4) {
+                printf("\nExact match not found. Searching for partial matches...\n");
+                
+                sortedFile = fopen(sortedFileName, "rb");
+                
+                if (sortedFile != NULL && LoadProductDimension() == 1) {
+                    char lowerSearch[40] = {0};
+                    char lowerCustomer[40] = {0};
+                    ToLowerCase(lowerSearch, searchCustomerName, 40);
+                    
+                    printf("\n*** FOUND (Partial Matches) ***\n");
+                    printf("Customers containing '%s':\n", searchCustomerName);
+                    printf("=================================================================\n");
+                    
+                    long currentOrder = -1;
+                    customerTotal = 0.0;
+                    int matchCount = 0;
+                    char lastShownCustomer[40] = {0};
+                    
+                    while (CountedRead(&foundRecord, sizeof(salesCustomerRecord), 1, sortedFile) == 1) {
+                        // Convert customer name to lowercase
+                        ToLowerCase(lowerCustomer, foundRecord.customer.name, 40);
+                        
+                        // Check if search term is substring
+                        if (strstr(lowerCustomer, lowerSearch) != NULL) {
+                            int matches = 1;
+                            
+                            // Apply additional filters
+                            if (searchOption == 2) {
+                                if (foundRecord.sale.orderDay != searchKey.sale.orderDay) {
+                                    matches = 0;
+                                }
+                            }
+                            if (searchOption == 3 && foundRecord.sale.orderNumber != searchOrderNumber) {
+                                matches = 0;
+                            }
+                            if (searchOption == 4 && foundRecord.sale.productKey != searchProductKey) {
+                                matches = 0;
+                            }
+                            
+                            if (matches == 1) {
+                                // Check if new customer or new order
+                                if (strcmp(lastShownCustomer, foundRecord.customer.name) != 0) {
+                                    if (strlen(lastShownCustomer) > 0) {
+                                        printf("--------------------------------------------------------------------------------------\n");
+                                    }
+                                    strncpy(lastShownCustomer, foundRecord.customer.name, 39);
+                                    lastShownCustomer[39] = '\0';
+                                    currentOrder = -1;
+                                }
+                                
+                                if (currentOrder != foundRecord.sale.orderNumber) {
+                                    if (currentOrder != -1) {
+                                        printf("--------------------------------------------------------------------------------------\n");
+                                    }
+                                    currentOrder = foundRecord.sale.orderNumber;
+                                    DayNumberToDate(foundRecord.sale.orderDay, &orderDate);
+                                    printf("\nCustomer: %s\n", foundRecord.customer.name);
+                                    printf("Order #%ld - Date: %04u/%02u/%02u\n",
+                                           currentOrder,
+                                           orderDate.yearValue,
+                                           orderDate.monthOfYear,
+                                           orderDate.dayOfMonth);
+                                }
+                                
+                                // Look up product
+                                saleProduct = LookupProductByKey(foundRecord.sale.productKey);
+                                
+                                if (saleProduct != NULL) {
+                                    // Calculate price with currency conversion
+                                    double unitPrice = saleProduct->unitPriceUSD;
+                                    const char* currency = foundRecord.sale.currencyCode;
+                                    double priceInUSD = ConvertCurrencyToUSD(unitPrice, currency, foundRecord.sale.orderDay);
+                                    double lineValue = RoundToThirdDecimal(priceInUSD * foundRecord.sale.quantity);
+                                    
+                                    printf("  ProductKey: %u - %s\n", 
+                                           foundRecord.sale.productKey,
+                                           saleProduct->productName);
+                                    printf("    Quantity: %u  Price: $%.2f  Total: $%.2f\n",
+                                           foundRecord.sale.quantity,
+                                           priceInUSD,
+                                           lineValue);
+                                    
+                                    customerTotal += lineValue;
+                                    matchCount++;
+                                }
+                            }
+                        }
+                    }
+                    
+                    printf("=================================================================\n");
+                    if (matchCount > 0) {
+                        printf("TOTAL: $%.2f\n", customerTotal);
+                        printf("Total matching records: %d\n", matchCount);
+                    } else {
+                        printf("\n*** NOT FOUND ***\n");
+                        printf("No customers containing '%s' were found.\n", searchCustomerName);
+                    }
+                    
+                }
+                
+                if (sortedFile != NULL) {
+                    fclose(sortedFile);
+                    sortedFile = NULL;
+                }
+            } else if (searchResult >= 1 && startPos >= 0) {
+                printf("\n*** FOUND ***\n");
+                printf("Showing results for '%s':\n\n", searchCustomerName);
+                
+                // Open sorted file
+                sortedFile = fopen(sortedFileName, "rb");
+                
+                if (sortedFile != NULL &&
+                    CountedSeek64(sortedFile, (long long)startPos * (long long)sizeof(salesCustomerRecord), SEEK_SET) != 0) {
+                    printf("Error: Cannot seek in %s\n", sortedFileName);
+                    fclose(sortedFile);
+                    sortedFile = NULL;
+                }
+                if (sortedFile != NULL && LoadProductDimension() == 1) {
+                    
+                    printf("=================================================================\n");
+                    
+                    long currentPos = startPos;
+                    long currentOrder = -1;
+                    customerTotal = 0.0;
+                    int matchCount = 0;
+                    
+                    while (currentPos <= endPos && 
+                           CountedRead(&foundRecord, sizeof(salesCustomerRecord), 1, sortedFile) == 1) {
+                        
+                        // Apply additional filters based on search option
+                        int matches = 1;
+                        
+                        if (searchOption == 2) {
+                            if (foundRecord.sale.orderDay != searchKey.sale.orderDay) {
+                                matches = 0;
+                            }
+                        }
+                        
+                        if (searchOption == 3 && foundRecord.sale.orderNumber != searchOrderNumber) {
+                            matches = 0;
+                        }
+                        
+                        if (searchOption == 4 && foundRecord.sale.productKey != searchProductKey) {
+                            matches = 0;
+                        }
+                        
+                        if (matches == 1) {
+                            // Check if new order
+                            if (currentOrder != foundRecord.sale.orderNumber) {
+                                if (currentOrder != -1) {
+                                    printf("--------------------------------------------------------------------------------------\n");
+                                }
+                                currentOrder = foundRecord.sale.orderNumber;
+                                DayNumberToDate(foundRecord.sale.orderDay, &orderDate);
+                                printf("\nOrder #%ld - Date: %04u/%02u/%02u\n",
+                                       currentOrder,
+                                       orderDate.yearValue,
+                                       orderDate.monthOfYear,
+                                       orderDate.dayOfMonth);
+                            }
+                            
+                            // Look up product
+                            saleProduct = LookupProductByKey(foundRecord.sale.productKey);
+                            
+                            if (saleProduct != NULL) {
+                                // Calculate price with currency conversion
+                                double unitPrice = saleProduct->unitPriceUSD;
+                                const char* currency = foundRecord.sale.currencyCode;
+                                double priceInUSD = ConvertCurrencyToUSD(unitPrice, currency, foundRecord.sale.orderDay);
+                                double lineValue = RoundToThirdDecimal(priceInUSD * foundRecord.sale.quantity);
+                                
+                                printf("  ProductKey: %u - %s\n", 
+                                       foundRecord.sale.productKey,
+                                       saleProduct->productName);
+                                printf("    Quantity: %u  Price: $%.2f  Total: $%.2f\n",
+                                       foundRecord.sale.quantity,
+                                       saleProduct->unitPriceUSD,
+                                       lineValue);
+                                
+                                customerTotal += lineValue;
+                                matchCount++;
+                            }
+                        }
+                        
+                        currentPos++;
+                    }
+                    
+                    printf("=================================================================\n");
+                    if (searchOption <= 4) {
+                        printf("TOTAL: $%.2f\n", customerTotal);
+                        printf("Total matching records: %d\n", matchCount);
+                    }
+                    
+                }
+                
+                if (sortedFile != NULL) {
+                    fclose(sortedFile);
+                    sortedFile = NULL;
+                }
+            } else if (searchOption == 5) {
+                // Browse all customers
+                printf("\n=== All Customers ===\n");
+                sortedFile = fopen(sortedFileName, "rb");
+                if (sortedFile != NULL) {
+                    char lastCustomer[40] = {0};
+                    int customerCount = 0;
+                    int maxShow = 20;
+                    
+                    printf("Show how many customers? (0 = all): ");
+                    scanf("%d", &maxShow);
+                    
+                    printf("\n%-40s %-15s %-15s\n", "Customer Name", "Orders", "Total Sales");
+                    printf("--------------------------------------------------------------------------------------\n");
+                    
+                    double currentCustomerTotal = 0.0;
+                    int currentCustomerOrders = 0;
+                    long lastOrder = -1;
+                    
+                    while (CountedRead(&foundRecord, sizeof(salesCustomerRecord), 1, sortedFile) == 1) {
+                        if (strcmp(lastCustomer, foundRecord.customer.name) != 0) {
+                            // New customer
+                            if (strlen(lastCustomer) > 0) {
+                                printf("%-40s %-15d $%.2f\n", lastCustomer, currentCustomerOrders, currentCustomerTotal);
+                                customerCount++;
+                                
+                                if (maxShow > 0 && customerCount >= maxShow) {
+                                    printf("... (showing first %d customers)\n", maxShow);
+                                    CountedSeek(sortedFile, 0, SEEK_END);  // Jump to end to exit loop naturally
+                                }
+                            }
+                            
+                            strncpy(lastCustomer, foundRecord.customer.name, 39);
+                            currentCustomerTotal = 0.0;
+                            currentCustomerOrders = 0;
+                            lastOrder = -1;
+                        }
+                        
+                        // Count order
+                        if (lastOrder != foundRecord.sale.orderNumber) {
+                            currentCustomerOrders++;
+                            lastOrder = foundRecord.sale.orderNumber;
+                        }
+                        
+                        // Calculate total
+                        saleProduct = LookupProductByKey(foundRecord.sale.productKey);
+                        if (saleProduct != NULL) {
+                            // Calculate with proper currency conversion
+                            double unitPrice = saleProduct->unitPriceUSD;
+                            const char* currency = foundRecord.sale.currencyCode;
+                            double priceInUSD = ConvertCurrencyToUSD(unitPrice, currency, foundRecord.sale.orderDay);
+                            double lineValue = RoundToThirdDecimal(priceInUSD * foundRecord.sale.quantity);
+                            currentCustomerTotal += lineValue;
+                        }
+                    }
+                    
+                    // Print last customer
+                    if (strlen(lastCustomer) > 0) {
+                        printf("%-40s %-15d $%.2f\n", lastCustomer, currentCustomerOrders, currentCustomerTotal);
+                        customerCount++;
+                    }
+                    
+                    printf("--------------------------------------------------------------------------------------\n");
+                    printf("Total customers shown: %d\n", customerCount);
+                    
                     fclose(sortedFile);
-                    sortedFile = NULL;
                 }
-            } else if (searchOption == 4) {
-                // Browse all records
-                printf("\n=== All Products and Locations ===\n");
-                sortedFile = fopen(sortedFileName, "rb");
-                if (sortedFile != NULL) {
-                    printf("%-30s %-15s %-15s %-20s %-20s\n", "Product", "Continent", "Country", "State", "City");
-                    printf("--------------------------------------------------------------------------------------\n");
-                    
-                    int count = 0;
-                    int maxShow = 50;
-                    
-                    printf("Show how many records? (0 = all): ");
-                    scanf("%d", &maxShow);
-                    
-                    int continueReading = 1;
-                    while (fread(&foundRecord, sizeof(productCustomerRecord), 1, sortedFile) == 1 && continueReading == 1) {
-                        if (maxShow > 0 && count >= maxShow) {
-                            printf("... (showing first %d records)\n", maxShow);
-                            continueReading = 0;  // Stop loop instead of break
-                        }
-                        
-                        if (continueReading == 1) {
-                            printf("%-30s %-15s %-15s %-20s %-20s\n",
-                                   foundRecord.product.productName,
-                                   foundRecord.customer.continent,
-                                   foundRecord.customer.country,
-                                   foundRecord.customer.state,
-                                   foundRecord.customer.city);
-                            count++;
+            }
+            
+            if (batchOptions.active == 1) {
+                continueSearching = 0;                 // One search per command line
+            } else {
+                printf("\nPerform another search? (y/n): ");
+                scanf(" %c", &choice);
+                if (choice != 'y' && choice != 'Y') {
+                    continueSearching = 0;
+                }
+            }
+        } else {
+            printf("Invalid option.\n");
+        }
+    }
+}//end function definition SearchInReport5
+
+// ====================== CUSTOMER NAME INDEX ======================
+// Persistent index from customer name to customerKey and to the SalesTable.dat rows of
+// that customer (CustomersTable.names and CustomersTable.postings). One customer's sales
+// are listed by reading a few index pages and fetching the listed rows, without the
+// Report 5 join and sort. Appends add entries and posting chunks for the new rows only.
+
+/*
+ * Function: CompareNameIndexEntries
+ * Purpose: Orders name index entries by folded name, exact name and customerKey
+ * Parameters: record1 - pointer to first customerNameIndexEntry
+ *            record2 - pointer to second customerNameIndexEntry
+ * Returns: int - negative, zero or positive like strcmp
+ */
+int CompareNameIndexEntries(const void* record1, const void* record2) {
+    const customerNameIndexEntry* entry1 = (const customerNameIndexEntry*)record1; // First entry
+    const customerNameIndexEntry* entry2 = (const customerNameIndexEntry*)record2; // Second entry
+    int comparisonResult = 0;                          // Result of comparison (single return pattern)
+    
+    comparisonResult = strcmp(entry1->foldedName, entry2->foldedName);
+    if (comparisonResult == 0) {
+        comparisonResult = strcmp(entry1->name, entry2->name);
+    }
+    if (comparisonResult == 0) {
+        comparisonResult = (entry1->customerKey > entry2->customerKey) - (entry1->customerKey < entry2->customerKey);
+    }
+    
+    return comparisonResult;                           // Single return point
+}//end function definition CompareNameIndexEntries
+
+/*
+ * Function: CompareNameIndexCustomerKeys
+ * Purpose: Orders name index entries by customerKey
+ * Parameters: record1 - pointer to first customerNameIndexEntry
+ *            record2 - pointer to second customerNameIndexEntry
+ * Returns: int - negative, zero or positive
+ */
+int CompareNameIndexCustomerKeys(const void* record1, const void* record2) {
+    const customerNameIndexEntry* entry1 = (const customerNameIndexEntry*)record1; // First entry
+    const customerNameIndexEntry* entry2 = (const customerNameIndexEntry*)record2; // Second entry
+    
+    return (entry1->customerKey > entry2->customerKey) - (entry1->customerKey < entry2->customerKey);
+}//end function definition CompareNameIndexCustomerKeys
+
+/*
+ * Function: CompareSalesByCustomerKey
+ * Purpose: Orders sales records by customerKey
+ * Parameters: record1 - pointer to first salesRecord
+ *            record2 - pointer to second salesRecord
+ * Returns: int - negative, zero or positive
+ */
+int CompareSalesByCustomerKey(const void* record1, const void* record2) {
+    const salesRecord* sale1 = (const salesRecord*)record1;       // First sales record
+    const salesRecord* sale2 = (const salesRecord*)record2;       // Second sales record
+    
+    return (sale1->customerKey > sale2->customerKey) - (sale1->customerKey < sale2->customerKey);
+}//end function definition CompareSalesByCustomerKey
+
+/*
+ * Function: FillNameIndexEntry
+ * Purpose: Sets up the name index entry of one customer, without sales
+ * Parameters: entry - entry to fill
+ *            customer - customer record
+ * Returns: void
+ */
+void FillNameIndexEntry(customerNameIndexEntry* entry, const customerRecord* customer) {
+    InitializeStructureToZero(entry, sizeof(customerNameIndexEntry));
+    memcpy(entry->name, customer->name, sizeof(entry->name));
+    entry->name[sizeof(entry->name) - 1] = '\0';
+    ToLowerCase(entry->foldedName, entry->name, sizeof(entry->foldedName));
+    entry->customerKey = customer->customerKey;
+    entry->lastChunk = CUSTOMER_NAME_NO_CHUNK;
+    return;
+}//end function definition FillNameIndexEntry
+
+/*
+ * Function: NameIndexEntryOffset
+ * Purpose: Returns where an entry is stored in CustomersTable.names
+ * Parameters: header - index header
+ *            entryId - entry number (CustomersTable.dat row)
+ * Returns: long long - byte offset of the entry
+ */
+long long NameIndexEntryOffset(const customerNameIndexHeader* header, long entryId) {
+    return (long long)sizeof(customerNameIndexHeader) + header->sortedEntries * (long long)sizeof(unsigned int) +
+           (long long)entryId * (long long)sizeof(customerNameIndexEntry);
+}//end function definition NameIndexEntryOffset
+
+/*
+ * Function: BuildCustomerNameIndex
+ * Purpose: Writes CustomersTable.names and CustomersTable.postings from the tables
+ * Parameters: none
+ * Returns: long - customers indexed, -1 on error
+ * Note: The customers are sorted in memory twice, by customerKey to attribute each sale
+ *       with a binary search and by name for the name order. Each customer with sales
+ *       gets one posting chunk. Sales of a customerKey that is not in CustomersTable.dat
+ *       are left out, as Report 5 leaves them out.
+ */
+long BuildCustomerNameIndex(void) {
+    mappedTable customersTable;                        // Mapped customers table
+    mappedTable salesTable;                            // Mapped sales table
+    FILE* indexFile = NULL;                            // Name index being written
+    FILE* postingFile = NULL;                          // Posting chunks being written
+    customerNameIndexHeader header;                    // Index file header
+    customerPostingChunk chunk;                        // Header of a customer's chunk
+    customerNameIndexEntry* entries = NULL;            // One entry per customer, table order
+    const unsigned char** keyOrder = NULL;             // Entries by customerKey
+    const unsigned char** nameOrder = NULL;            // Entries by name
+    const unsigned char** scratch = NULL;              // Sort work array
+    const salesRecord* sale = NULL;                    // Current sale
+    const customerNameIndexEntry* probe = NULL;        // Entry probed by the binary search
+    int* saleEntries = NULL;                           // Entry of each sales row, -1 = no customer
+    long long* fillPositions = NULL;                   // Next posting slot of each entry
+    unsigned int* postings = NULL;                     // Sales row ids grouped by entry
+    unsigned int entryId = 0;                          // Entry number written to the name order
+    long customerCount = 0;                            // Rows in CustomersTable.dat
+    long salesCount = 0;                               // Rows in SalesTable.dat
+    long low = 0;                                      // Binary search lower bound
+    long high = 0;                                     // Binary search upper bound
+    long middle = 0;                                   // Probed position
+    long long postingCount = 0;                        // Sales with a customer
+    long long postingBytes = 0;                        // Size of the posting file
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    InitializeStructureToZero(&customersTable, sizeof(mappedTable));
+    InitializeStructureToZero(&salesTable, sizeof(mappedTable));
+    InitializeStructureToZero(&header, sizeof(customerNameIndexHeader));
+    
+    if (OpenMappedBinaryTable(&customersTable, "CustomersTable.dat", sizeof(customerRecord),
+                              TABLE_ACCESS_SEQUENTIAL, NULL) == 0 ||
+        OpenMappedBinaryTable(&salesTable, "SalesTable.dat", sizeof(salesRecord),
+                              TABLE_ACCESS_SEQUENTIAL, NULL) == 0) {
+        errorOccurred = 1;
+    } else {
+        customerCount = customersTable.recordCount;
+        salesCount = salesTable.recordCount;
+        entries = (customerNameIndexEntry*)calloc((size_t)customerCount + 1, sizeof(customerNameIndexEntry));
+        keyOrder = (const unsigned char**)malloc(((size_t)customerCount + 1) * sizeof(const unsigned char*));
+        nameOrder = (const unsigned char**)malloc(((size_t)customerCount + 1) * sizeof(const unsigned char*));
+        scratch = (const unsigned char**)malloc(((size_t)customerCount + 1) * sizeof(const unsigned char*));
+        fillPositions = (long long*)malloc(((size_t)customerCount + 1) * sizeof(long long));
+        saleEntries = (int*)malloc(((size_t)salesCount + 1) * sizeof(int));
+        if (entries == NULL || keyOrder == NULL || nameOrder == NULL || scratch == NULL ||
+            fillPositions == NULL || saleEntries == NULL) {
+            printf("Error: Memory allocation failed for customer name index\n");
+            errorOccurred = 1;
+        }
+    }
+    
+    // One entry per customer, sorted by key for the sales pass
+    if (errorOccurred == 0) {
+        for (long row = 0; row < customerCount; row++) {
+            FillNameIndexEntry(&entries[row], (const customerRecord*)MappedRecordAt(&customersTable, row));
+            keyOrder[row] = (const unsigned char*)&entries[row];
+            nameOrder[row] = (const unsigned char*)&entries[row];
+        }
+        SortRecordPointers(keyOrder, scratch, customerCount, CompareNameIndexCustomerKeys);
+        
+        // Count each customer's sales and remember which entry every row belongs to
+        for (long row = 0; row < salesCount; row++) {
+            sale = (const salesRecord*)MappedRecordAt(&salesTable, row);
+            low = 0;
+            high = customerCount;
+            while (low < high) {
+                middle = low + (high - low) / 2;
+                probe = (const customerNameIndexEntry*)keyOrder[middle];
+                if (probe->customerKey < sale->customerKey) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            saleEntries[row] = -1;
+            if (low < customerCount &&
+                ((const customerNameIndexEntry*)keyOrder[low])->customerKey == sale->customerKey) {
+                saleEntries[row] = (int)((const customerNameIndexEntry*)keyOrder[low] - entries);
+                entries[saleEntries[row]].postingCount++;
+                postingCount++;
+            }
+        }
+        
+        // Chunks follow the table order of the entries
+        postingCount = 0;
+        for (long row = 0; row < customerCount; row++) {
+            fillPositions[row] = postingCount;
+            if (entries[row].postingCount > 0) {
+                entries[row].lastChunk = postingBytes;
+                postingBytes += (long long)sizeof(customerPostingChunk) +
+                                (long long)entries[row].postingCount * (long long)sizeof(unsigned int);
+            }
+            postingCount += entries[row].postingCount;
+        }
+        SortRecordPointers(nameOrder, scratch, customerCount, CompareNameIndexEntries);
+        
+        postings = (unsigned int*)malloc(((size_t)postingCount + 1) * sizeof(unsigned int));
+        if (postings == NULL) {
+            printf("Error: Memory allocation failed for customer name index\n");
+            errorOccurred = 1;
+        } else {
+            for (long row = 0; row < salesCount; row++) {
+                if (saleEntries[row] >= 0) {
+                    postings[fillPositions[saleEntries[row]]++] = (unsigned int)row;
+                }
+            }
+        }
+    }
+    
+    // One chunk per customer with sales
+    if (errorOccurred == 0) {
+        postingFile = OpenFileWithErrorCheck("CustomersTable.postings", "wb");
+        if (postingFile == NULL) {
+            errorOccurred = 1;
+        }
+        for (long row = 0; errorOccurred == 0 && row < customerCount; row++) {
+            if (entries[row].postingCount > 0) {
+                chunk.previousChunk = CUSTOMER_NAME_NO_CHUNK;
+                chunk.rowCount = entries[row].postingCount;
+                if (CountedWrite(&chunk, sizeof(customerPostingChunk), 1, postingFile) != 1 ||
+                    CountedWrite(&postings[fillPositions[row] - entries[row].postingCount], sizeof(unsigned int),
+                                 entries[row].postingCount, postingFile) != entries[row].postingCount) {
+                    errorOccurred = 1;
+                }
+            }
+        }
+        if (postingFile != NULL && fclose(postingFile) != 0) {
+            errorOccurred = 1;
+        }
+    }
+    
+    // Header, name order, then the entries in table order
+    if (errorOccurred == 0) {
+        header.magic = CUSTOMER_NAME_INDEX_MAGIC;
+        header.version = CUSTOMER_NAME_INDEX_VERSION;
+        header.customerRows = customerCount;
+        header.salesRows = salesCount;
+        header.sortedEntries = customerCount;
+        header.entryCount = customerCount;
+        header.postingCount = postingCount;
+        header.postingBytes = postingBytes;
+        indexFile = OpenFileWithErrorCheck("CustomersTable.names", "wb");
+        if (indexFile == NULL || CountedWrite(&header, sizeof(customerNameIndexHeader), 1, indexFile) != 1) {
+            errorOccurred = 1;
+        }
+        for (long position = 0; errorOccurred == 0 && position < customerCount; position++) {
+            entryId = (unsigned int)((const customerNameIndexEntry*)nameOrder[position] - entries);
+            if (CountedWrite(&entryId, sizeof(unsigned int), 1, indexFile) != 1) {
+                errorOccurred = 1;
+            }
+        }
+        if (errorOccurred == 0 && customerCount > 0 &&
+            CountedWrite(entries, sizeof(customerNameIndexEntry), (size_t)customerCount, indexFile) != (size_t)customerCount) {
+            errorOccurred = 1;
+        }
+        if (indexFile != NULL && fclose(indexFile) != 0) {
+            errorOccurred = 1;
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        printf("Customer name index completed: %ld customers, %lld sales\n", customerCount, postingCount);
+        returnValue = customerCount;
+    } else {
+        remove("CustomersTable.names");                // Never leave a header over partial data
+    }
+    
+    free(entries);
+    free(keyOrder);
+    free(nameOrder);
+    free(scratch);
+    free(fillPositions);
+    free(saleEntries);
+    free(postings);
+    CloseMappedTable(&customersTable);
+    CloseMappedTable(&salesTable);
+    
+    return returnValue;                                // Single return point
+}//end function definition BuildCustomerNameIndex
+
+/*
+ * Function: AppendCustomerNameIndex
+ * Purpose: Brings the customer name index up to date after rows were appended to
+ *          CustomersTable.dat or SalesTable.dat
+ * Parameters: none
+ * Returns: long - customers indexed, -1 on error
+ * Note: New customers are added after the last entry; they stay outside the name order
+ *       until the next build. New sales are sorted by customerKey, each customer is found
+ *       through CustomersTable.idx (which must already hold the new customers) and gets
+ *       one chunk with its new row ids, linked to its previous chunk. Nothing written
+ *       before counts until the header is rewritten last. A missing or foreign index, or
+ *       one describing more rows than the tables, is rebuilt. New sales of a customer
+ *       that is still unknown are left out, and stay out when the customer arrives in a
+ *       later append, until the index is built again.
+ */
+long AppendCustomerNameIndex(void) {
+    FILE* indexFile = NULL;                            // Name index being updated
+    FILE* postingFile = NULL;                          // Posting chunks being extended
+    FILE* customerIndexFile = NULL;                    // CustomersTable.idx
+    bPlusTreeHeader customerIndexHeader;               // Header of CustomersTable.idx
+    customerNameIndexHeader header;                    // Header of the name index
+    customerNameIndexEntry entry;                      // Entry being added or updated
+    customerPostingChunk chunk;                        // Chunk being appended
+    mappedTable customersTable;                        // Mapped customers table
+    mappedTable salesTable;                            // Mapped sales table
+    const unsigned char** order = NULL;                // New sales by customerKey
+    const unsigned char** scratch = NULL;              // Sort work array
+    unsigned int* runRows = NULL;                      // Row ids of one customer's new sales
+    long customerRows = 0;                             // Rows in CustomersTable.dat
+    long salesRows = 0;                                // Rows in SalesTable.dat
+    long previousCustomers = 0;                        // Customers indexed before the append
+    long newSales = 0;                                 // Sales rows after the indexed ones
+    long runStart = 0;                                 // First new sale of the current customer
+    long runEnd = 0;                                   // End of the current customer's new sales
+    long recordOffset = 0;                             // Customer offset from CustomersTable.idx
+    long entryId = 0;                                  // Entry of the current customer
+    long long salesIndexed = 0;                        // New sales added to posting lists
+    int usable = 0;                                    // 1 if the index can be extended
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    InitializeStructureToZero(&customersTable, sizeof(mappedTable));
+    InitializeStructureToZero(&salesTable, sizeof(mappedTable));
+    
+    customerRows = CountTableRecords("CustomersTable.dat", sizeof(customerRecord));
+    salesRows = CountTableRecords("SalesTable.dat", sizeof(salesRecord));
+    indexFile = fopen("CustomersTable.names", "rb+");
+    postingFile = fopen("CustomersTable.postings", "rb+");
+    if (indexFile != NULL && postingFile != NULL &&
+        CountedRead(&header, sizeof(customerNameIndexHeader), 1, indexFile) == 1 &&
+        header.magic == CUSTOMER_NAME_INDEX_MAGIC && header.version == CUSTOMER_NAME_INDEX_VERSION &&
+        header.entryCount == header.customerRows && header.customerRows <= customerRows &&
+        header.salesRows <= salesRows) {
+        usable = 1;
+    }
+    
+    if (usable == 0) {
+        if (indexFile != NULL) fclose(indexFile);
+        if (postingFile != NULL) fclose(postingFile);
+        returnValue = BuildCustomerNameIndex();
+    } else {
+        if (OpenMappedBinaryTable(&customersTable, "CustomersTable.dat", sizeof(customerRecord),
+                                  TABLE_ACCESS_RANDOM, NULL) == 0 ||
+            OpenMappedBinaryTable(&salesTable, "SalesTable.dat", sizeof(salesRecord),
+                                  TABLE_ACCESS_SEQUENTIAL, NULL) == 0) {
+            errorOccurred = 1;
+        }
+        
+        // New customers go after the last entry
+        previousCustomers = (long)header.customerRows;
+        if (errorOccurred == 0 && header.customerRows < customerRows &&
+            CountedSeek64(indexFile, NameIndexEntryOffset(&header, (long)header.entryCount), SEEK_SET) != 0) {
+            errorOccurred = 1;
+        }
+        for (long row = (long)header.customerRows; errorOccurred == 0 && row < customerRows; row++) {
+            FillNameIndexEntry(&entry, (const customerRecord*)MappedRecordAt(&customersTable, row));
+            if (CountedWrite(&entry, sizeof(customerNameIndexEntry), 1, indexFile) != 1) {
+                errorOccurred = 1;
+            }
+        }
+        
+        // New sales grouped by customer, in row order within each customer
+        newSales = salesRows - (long)header.salesRows;
+        if (errorOccurred == 0 && newSales > 0) {
+            order = (const unsigned char**)malloc((size_t)newSales * sizeof(const unsigned char*));
+            scratch = (const unsigned char**)malloc((size_t)newSales * sizeof(const unsigned char*));
+            runRows = (unsigned int*)malloc((size_t)newSales * sizeof(unsigned int));
+            customerIndexFile = OpenBPlusTreeIndex("CustomersTable.idx", &customerIndexHeader);
+            if (order == NULL || scratch == NULL || runRows == NULL || customerIndexFile == NULL) {
+                errorOccurred = 1;
+            } else {
+                for (long i = 0; i < newSales; i++) {
+                    order[i] = (const unsigned char*)MappedRecordAt(&salesTable, (long)header.salesRows + i);
+                }
+                SortRecordPointers(order, scratch, newSales, CompareSalesByCustomerKey);
+            }
+        }
+        runStart = 0;
+        while (errorOccurred == 0 && runStart < newSales) {
+            runEnd = runStart;
+            while (runEnd < newSales &&
+                   CompareSalesByCustomerKey(order[runStart], order[runEnd]) == 0) {
+                runRows[runEnd - runStart] = (unsigned int)((order[runEnd] - salesTable.records) / (long)sizeof(salesRecord));
+                runEnd++;
+            }
+            recordOffset = SearchBPlusTreeIndex(customerIndexFile, &customerIndexHeader,
+                                                ((const salesRecord*)order[runStart])->customerKey);
+            if (recordOffset >= 0) {
+                entryId = recordOffset / (long)sizeof(customerRecord);
+                chunk.rowCount = runEnd - runStart;
+                if (entryId >= customerRows ||
+                    CountedSeek64(indexFile, NameIndexEntryOffset(&header, entryId), SEEK_SET) != 0 ||
+                    CountedRead(&entry, sizeof(customerNameIndexEntry), 1, indexFile) != 1) {
+                    errorOccurred = 1;
+                } else {
+                    chunk.previousChunk = entry.lastChunk;
+                    if (CountedSeek64(postingFile, header.postingBytes, SEEK_SET) != 0 ||
+                        CountedWrite(&chunk, sizeof(customerPostingChunk), 1, postingFile) != 1 ||
+                        CountedWrite(runRows, sizeof(unsigned int), (size_t)chunk.rowCount, postingFile) !=
+                            (size_t)chunk.rowCount) {
+                        errorOccurred = 1;
+                    }
+                }
+                if (errorOccurred == 0) {
+                    entry.lastChunk = header.postingBytes;
+                    entry.postingCount += (unsigned int)chunk.rowCount;
+                    header.postingBytes += (long long)sizeof(customerPostingChunk) +
+                                           chunk.rowCount * (long long)sizeof(unsigned int);
+                    header.postingCount += chunk.rowCount;
+                    salesIndexed += chunk.rowCount;
+                    if (CountedSeek64(indexFile, NameIndexEntryOffset(&header, entryId), SEEK_SET) != 0 ||
+                        CountedWrite(&entry, sizeof(customerNameIndexEntry), 1, indexFile) != 1) {
+                        errorOccurred = 1;
+                    }
+                }
+            }
+            runStart = runEnd;
+        }
+        
+        // The header makes the new entries and chunks part of the index
+        if (errorOccurred == 0) {
+            header.customerRows = customerRows;
+            header.entryCount = customerRows;
+            header.salesRows = salesRows;
+            if (fflush(postingFile) != 0 || CountedSeek(indexFile, 0, SEEK_SET) != 0 ||
+                CountedWrite(&header, sizeof(customerNameIndexHeader), 1, indexFile) != 1) {
+                errorOccurred = 1;
+            }
+        }
+        if (fclose(indexFile) != 0 || fclose(postingFile) != 0) {
+            errorOccurred = 1;
+        }
+        if (customerIndexFile != NULL) {
+            fclose(customerIndexFile);
+        }
+        
+        if (errorOccurred == 0) {
+            printf("Customer name index updated: %ld new customers, %lld new sales\n",
+                   customerRows - previousCustomers, salesIndexed);
+            returnValue = customerRows;
+        }
+    }
+    
+    free(order);
+    free(scratch);
+    free(runRows);
+    CloseMappedTable(&customersTable);
+    CloseMappedTable(&salesTable);
+    
+    return returnValue;                                // Single return point
+}//end function definition AppendCustomerNameIndex
+
+/*
+ * Function: OpenCustomerNameIndex
+ * Purpose: Opens CustomersTable.names if it describes the current tables
+ * Parameters: header - receives the index header
+ * Returns: FILE* - index positioned after its header, NULL if missing or out of date
+ */
+FILE* OpenCustomerNameIndex(customerNameIndexHeader* header) {
+    FILE* indexFile = NULL;                            // Index file (single return pattern)
+    
+    indexFile = fopen("CustomersTable.names", "rb");
+    if (indexFile != NULL &&
+        (CountedRead(header, sizeof(customerNameIndexHeader), 1, indexFile) != 1 ||
+         header->magic != CUSTOMER_NAME_INDEX_MAGIC || header->version != CUSTOMER_NAME_INDEX_VERSION ||
+         header->entryCount != header->customerRows ||
+         header->customerRows != CountTableRecords("CustomersTable.dat", sizeof(customerRecord)) ||
+         header->salesRows != CountTableRecords("SalesTable.dat", sizeof(salesRecord)))) {
+        fclose(indexFile);
+        indexFile = NULL;
+    }
+    
+    return indexFile;                                  // Single return point
+}//end function definition OpenCustomerNameIndex
+
+/*
+ * Function: ReadNameIndexEntry
+ * Purpose: Reads one entry of the customer name index
+ * Parameters: indexFile - open name index
+ *            header - its header
+ *            entryId - entry number
+ *            entry - receives the entry
+ * Returns: int - 1 on success, 0 on error
+ */
+int ReadNameIndexEntry(FILE* indexFile, const customerNameIndexHeader* header, long entryId,
+                       customerNameIndexEntry* entry) {
+    return (CountedSeek64(indexFile, NameIndexEntryOffset(header, entryId), SEEK_SET) == 0 &&
+            CountedRead(entry, sizeof(customerNameIndexEntry), 1, indexFile) == 1) ? 1 : 0;
+}//end function definition ReadNameIndexEntry
+
+/*
+ * Function: ReadNameOrderEntry
+ * Purpose: Reads the entry at one position of the name order
+ * Parameters: indexFile - open name index
+ *            header - its header
+ *            position - position in the name order
+ *            entry - receives the entry
+ * Returns: int - 1 on success, 0 on error
+ */
+int ReadNameOrderEntry(FILE* indexFile, const customerNameIndexHeader* header, long position,
+                       customerNameIndexEntry* entry) {
+    unsigned int entryId = 0;                          // Entry at the position
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    if (CountedSeek64(indexFile,
+                      (long long)sizeof(customerNameIndexHeader) + (long long)position * (long long)sizeof(unsigned int),
+                      SEEK_SET) == 0 &&
+        CountedRead(&entryId, sizeof(unsigned int), 1, indexFile) == 1 &&
+        (long long)entryId < header->entryCount) {
+        returnValue = ReadNameIndexEntry(indexFile, header, (long)entryId, entry);
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition ReadNameOrderEntry
+
+/*
+ * Function: AddNameIndexMatch
+ * Purpose: Appends an entry to a growing array of matches
+ * Parameters: matches - match array (grown with realloc)
+ *            matchCount - entries in the array
+ *            matchCapacity - entries allocated
+ *            entry - entry to add
+ * Returns: int - 1 on success, 0 if memory ran out
+ */
+int AddNameIndexMatch(customerNameIndexEntry** matches, long* matchCount, long* matchCapacity,
+                      const customerNameIndexEntry* entry) {
+    customerNameIndexEntry* grown = NULL;              // Grown match array
+    int returnValue = 1;                               // Return value (single return pattern)
+    
+    if (*matchCount == *matchCapacity) {
+        grown = (customerNameIndexEntry*)realloc(*matches, (size_t)(*matchCapacity) * 2 * sizeof(customerNameIndexEntry));
+        if (grown == NULL) {
+            returnValue = 0;
+        } else {
+            *matches = grown;
+            *matchCapacity *= 2;
+        }
+    }
+    if (returnValue == 1) {
+        (*matches)[*matchCount] = *entry;
+        (*matchCount)++;
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition AddNameIndexMatch
+
+/*
+ * Function: FindCustomerNameEntries
+ * Purpose: Finds the name index entries of a customer name
+ * Parameters: indexFile - open name index
+ *            header - its header
+ *            customerName - name to look up
+ *            matches - receives a malloc'd array of matching entries (caller frees)
+ *            matchKind - receives "exact", "case-insensitive" or "partial"
+ * Returns: long - entries found, 0 if none, -1 on error
+ * Note: A binary search over the name order finds the names equal apart from case, and
+ *       the customers appended since the last build are compared one by one; the names
+ *       equal byte for byte win. Only without any such name are all entries scanned for
+ *       names containing the search text.
+ */
+long FindCustomerNameEntries(FILE* indexFile, const customerNameIndexHeader* header, const char* customerName,
+                             customerNameIndexEntry** matches, const char** matchKind) {
+    customerNameIndexEntry entry;                      // Entry read from the index
+    customerNameIndexEntry* found = NULL;              // Matching entries
+    char foldedSearch[40] = {0};                       // Lower-case search text
+    long foundCount = 0;                               // Entries in found
+    long foundCapacity = 16;                           // Entries allocated
+    long exactCount = 0;                               // Entries equal byte for byte
+    long low = 0;                                      // Binary search lower bound
+    long high = (long)header->sortedEntries;           // Binary search upper bound
+    long middle = 0;                                   // Probed position
+    long position = 0;                                 // Position being read
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    ToLowerCase(foldedSearch, customerName, sizeof(foldedSearch));
+    *matchKind = "case-insensitive";
+    found = (customerNameIndexEntry*)malloc((size_t)foundCapacity * sizeof(customerNameIndexEntry));
+    if (found == NULL) {
+        errorOccurred = 1;
+    }
+    
+    // First position of the name order whose folded name is not below the search text
+    while (errorOccurred == 0 && low < high) {
+        middle = low + (high - low) / 2;
+        if (ReadNameOrderEntry(indexFile, header, middle, &entry) == 0) {
+            errorOccurred = 1;
+        } else if (strcmp(entry.foldedName, foldedSearch) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    
+    // Equal folded names are adjacent in the name order; appended customers follow it
+    for (position = low; errorOccurred == 0 && position < (long)header->sortedEntries; position++) {
+        if (ReadNameOrderEntry(indexFile, header, position, &entry) == 0) {
+            errorOccurred = 1;
+        } else if (strcmp(entry.foldedName, foldedSearch) != 0) {
+            position = (long)header->sortedEntries;    // Past the equal names
+        } else if (AddNameIndexMatch(&found, &foundCount, &foundCapacity, &entry) == 0) {
+            errorOccurred = 1;
+        }
+    }
+    for (position = (long)header->sortedEntries; errorOccurred == 0 && position < (long)header->entryCount; position++) {
+        if (ReadNameIndexEntry(indexFile, header, position, &entry) == 0) {
+            errorOccurred = 1;
+        } else if (strcmp(entry.foldedName, foldedSearch) == 0 &&
+                   AddNameIndexMatch(&found, &foundCount, &foundCapacity, &entry) == 0) {
+            errorOccurred = 1;
+        }
+    }
+    
+    // Without such a name, every entry containing the text (entries are contiguous)
+    if (errorOccurred == 0 && foundCount == 0) {
+        *matchKind = "partial";
+        if (header->entryCount > 0 && CountedSeek64(indexFile, NameIndexEntryOffset(header, 0), SEEK_SET) != 0) {
+            errorOccurred = 1;
+        }
+        for (position = 0; errorOccurred == 0 && position < (long)header->entryCount; position++) {
+            if (CountedRead(&entry, sizeof(customerNameIndexEntry), 1, indexFile) != 1) {
+                errorOccurred = 1;
+            } else if (strstr(entry.foldedName, foldedSearch) != NULL &&
+                       AddNameIndexMatch(&found, &foundCount, &foundCapacity, &entry) == 0) {
+                errorOccurred = 1;
+            }
+        }
+    }
+    
+    // Keep only the byte-for-byte matches when there are any
+    if (errorOccurred == 0 && strcmp(*matchKind, "partial") != 0) {
+        for (long i = 0; i < foundCount; i++) {
+            if (strcmp(found[i].name, customerName) == 0) {
+                found[exactCount] = found[i];
+                exactCount++;
+            }
+        }
+        if (exactCount > 0) {
+            foundCount = exactCount;
+            *matchKind = "exact";
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        *matches = found;
+        returnValue = foundCount;
+    } else {
+        free(found);
+        *matches = NULL;
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition FindCustomerNameEntries
+
+/*
+ * Function: ReadCustomerPostings
+ * Purpose: Reads all sales row ids of one name index entry
+ * Parameters: postingFile - CustomersTable.postings
+ *            entry - entry whose chunks are read
+ *            rowIds - receives entry->postingCount row ids, ascending
+ * Returns: int - 1 on success, 0 if the chunks do not add up
+ * Note: The chain starts at the newest chunk, so chunks are placed from the end of rowIds
+ */
+int ReadCustomerPostings(FILE* postingFile, const customerNameIndexEntry* entry, unsigned int* rowIds) {
+    customerPostingChunk chunk;                        // Chunk being read
+    long long chunkOffset = entry->lastChunk;          // Chunk to read next
+    long long remaining = entry->postingCount;         // Row ids not placed yet
+    int errorOccurred = 0;                             // Error flag
+    
+    while (errorOccurred == 0 && chunkOffset != CUSTOMER_NAME_NO_CHUNK) {
+        if (CountedSeek64(postingFile, chunkOffset, SEEK_SET) != 0 ||
+            CountedRead(&chunk, sizeof(customerPostingChunk), 1, postingFile) != 1 ||
+            chunk.rowCount <= 0 || chunk.rowCount > remaining ||
+            CountedRead(rowIds + (remaining - chunk.rowCount), sizeof(unsigned int), (size_t)chunk.rowCount,
+                        postingFile) != (size_t)chunk.rowCount) {
+            errorOccurred = 1;
+        } else {
+            remaining -= chunk.rowCount;
+            chunkOffset = chunk.previousChunk;
+        }
+    }
+    
+    return (errorOccurred == 0 && remaining == 0) ? 1 : 0;
+}//end function definition ReadCustomerPostings
+
+/*
+ * Function: ListCustomerSalesFromIndex
+ * Purpose: Prints the sales of one customer name from the customer name index
+ * Parameters: customerName - name to look up (exact, then any case, then partial)
+ *            searchOption - 1 all sales, 2 one order date, 3 one order number, 4 one product key
+ *            orderDay - order date for option 2 (day number)
+ *            orderNumber - order number for option 3
+ *            productKey - product key for option 4
+ * Returns: int - 1 if the lookup ran (even with no match), 0 if the index or tables are unusable
+ * Note: Rows come from the posting lists and are fetched from the mapped SalesTable.dat,
+ *       then put in Report 5 order (name, order date, product key). A missing or out of
+ *       date index is rebuilt first.
+ */
+int ListCustomerSalesFromIndex(const char* customerName, int searchOption, int orderDay,
+                               long orderNumber, unsigned short productKey) {
+    FILE* indexFile = NULL;                            // Customer name index
+    customerNameIndexHeader header;                    // Index header
+    customerNameIndexEntry* matches = NULL;            // Entries of the name
+    const char* matchKind = "exact";                   // How the name matched
+    mappedTable salesTable;                            // Mapped sales table
+    salesCustomerRecord* rows = NULL;                  // Matching sales with their customer name
+    salesCustomerRecord* grownRows = NULL;             // Grown row array
+    const unsigned char** order = NULL;                // Rows in Report 5 order
+    const unsigned char** scratch = NULL;              // Sort work array
+    const salesCustomerRecord* row = NULL;             // Row being printed
+    const productRecord* saleProduct = NULL;           // Product of the row
+    dateStructure orderDate;                           // Order date of the row
+    FILE* postingFile = NULL;                          // Posting chunks of the index
+    unsigned int* rowIds = NULL;                       // Sales row ids of one customer
+    long matchCount = 0;                               // Entries of the name
+    long rowCount = 0;                                 // Rows in rows
+    long rowCapacity = 0;                              // Rows allocated
+    long currentOrder = -1;                            // Order being printed
+    char lastShownCustomer[40] = {0};                  // Customer being printed
+    double customerTotal = 0.0;                        // Total of the printed lines
+    int linesShown = 0;                                // Lines with a product
+    long long startNanoseconds = ReadMonotonicNanoseconds(); // Lookup start time
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    InitializeStructureToZero(&salesTable, sizeof(mappedTable));
+    
+    indexFile = OpenCustomerNameIndex(&header);
+    if (indexFile == NULL) {
+        printf("Rebuilding index CustomersTable.names...\n");
+        if (BuildCustomerNameIndex() >= 0) {
+            indexFile = OpenCustomerNameIndex(&header);
+        }
+    }
+    if (indexFile == NULL) {
+        printf("Error: Customer name index is not available\n");
+        errorOccurred = 1;
+    }
+    
+    if (errorOccurred == 0) {
+        matchCount = FindCustomerNameEntries(indexFile, &header, customerName, &matches, &matchKind);
+        postingFile = OpenFileWithErrorCheck("CustomersTable.postings", "rb");
+        if (matchCount < 0 || postingFile == NULL || LoadProductDimension() == 0 ||
+            OpenMappedBinaryTable(&salesTable, "SalesTable.dat", sizeof(salesRecord), TABLE_ACCESS_RANDOM, NULL) == 0) {
+            errorOccurred = 1;
+        }
+    }
+    
+    // Fetch the listed rows that pass the extra criterion
+    for (long m = 0; errorOccurred == 0 && m < matchCount; m++) {
+        free(rowIds);
+        rowIds = (unsigned int*)malloc(((size_t)matches[m].postingCount + 1) * sizeof(unsigned int));
+        if (rowIds == NULL || ReadCustomerPostings(postingFile, &matches[m], rowIds) == 0) {
+            printf("Error: Cannot read the sales of %s from CustomersTable.postings\n", matches[m].name);
+            errorOccurred = 1;
+        }
+        for (unsigned int p = 0; errorOccurred == 0 && p < matches[m].postingCount; p++) {
+            if ((long)rowIds[p] >= salesTable.recordCount) {
+                errorOccurred = 1;
+            } else {
+                const salesRecord* sale = (const salesRecord*)MappedRecordAt(&salesTable, (long)rowIds[p]);
+                if ((searchOption != 2 || sale->orderDay == orderDay) &&
+                    (searchOption != 3 || sale->orderNumber == orderNumber) &&
+                    (searchOption != 4 || sale->productKey == productKey)) {
+                    if (rowCount == rowCapacity) {
+                        rowCapacity = (rowCapacity > 0) ? rowCapacity * 2 : 64;
+                        grownRows = (salesCustomerRecord*)realloc(rows, (size_t)rowCapacity * sizeof(salesCustomerRecord));
+                        if (grownRows == NULL) {
+                            errorOccurred = 1;
+                        } else {
+                            rows = grownRows;
                         }
                     }
-                    
+                    if (errorOccurred == 0) {
+                        InitializeStructureToZero(&rows[rowCount], sizeof(salesCustomerRecord));
+                        rows[rowCount].sale = *sale;
+                        rows[rowCount].customer.customerKey = matches[m].customerKey;
+                        memcpy(rows[rowCount].customer.name, matches[m].name, sizeof(rows[rowCount].customer.name));
+                        rowCount++;
+                    }
+                }
+            }
+        }
+    }
+    
+    if (errorOccurred == 0 && rowCount > 0) {
+        order = (const unsigned char**)malloc((size_t)rowCount * sizeof(const unsigned char*));
+        scratch = (const unsigned char**)malloc((size_t)rowCount * sizeof(const unsigned char*));
+        if (order == NULL || scratch == NULL) {
+            errorOccurred = 1;
+        } else {
+            for (long r = 0; r < rowCount; r++) {
+                order[r] = (const unsigned char*)&rows[r];
+            }
+            SortRecordPointers(order, scratch, rowCount, CompareSalesForReport5);
+        }
+    }
+    
+    if (errorOccurred == 0 && rowCount == 0) {
+        printf("\n*** NOT FOUND ***\n");
+        printf("No sales of a customer named '%s' were found.\n", customerName);
+        returnValue = 1;
+    } else if (errorOccurred == 0) {
+        printf("\n*** FOUND (%s name match, %ld customer%s) ***\n", matchKind, matchCount, (matchCount == 1) ? "" : "s");
+        printf("Showing results for '%s':\n", customerName);
+        printf("=================================================================\n");
+        for (long r = 0; r < rowCount; r++) {
+            row = (const salesCustomerRecord*)order[r];
+            if (strcmp(lastShownCustomer, row->customer.name) != 0) {
+                if (lastShownCustomer[0] != '\0') {
                     printf("--------------------------------------------------------------------------------------\n");
-                    printf("Total records shown: %d\n", count);
-                    fclose(sortedFile);
                 }
+                strncpy(lastShownCustomer, row->customer.name, 39);
+                lastShownCustomer[39] = '\0';
+                printf("\nCustomer: %s\n", row->customer.name);
+                currentOrder = -1;
+            }
+            if (currentOrder != row->sale.orderNumber) {
+                currentOrder = row->sale.orderNumber;
+                DayNumberToDate(row->sale.orderDay, &orderDate);
+                printf("\nOrder #%ld - Date: %04u/%02u/%02u\n",
+                       currentOrder, orderDate.yearValue, orderDate.monthOfYear, orderDate.dayOfMonth);
             }
             
-            printf("\nPerform another search? (y/n): ");
-            scanf(" %c", &choice);
-            if (choice != 'y' && choice != 'Y') {
-                continueSearching = 0;
+            saleProduct = LookupProductByKey(row->sale.productKey);
+            if (saleProduct != NULL) {
+                double priceInUSD = ConvertCurrencyToUSD(saleProduct->unitPriceUSD, row->sale.currencyCode,
+                                                         row->sale.orderDay);
+                double lineValue = RoundToThirdDecimal(priceInUSD * row->sale.quantity);
+                
+                printf("  ProductKey: %u - %s\n", row->sale.productKey, saleProduct->productName);
+                printf("    Quantity: %u  Price: $%.2f  Total: $%.2f\n", row->sale.quantity, priceInUSD, lineValue);
+                customerTotal += lineValue;
+                linesShown++;
             }
+        }
+        printf("=================================================================\n");
+        printf("TOTAL: $%.2f\n", customerTotal);
+        printf("Total matching records: %d\n", linesShown);
+        returnValue = 1;
+    }
+    
+    if (errorOccurred == 0) {
+        printf("Lookup time (ms): %.3f\n", (double)(ReadMonotonicNanoseconds() - startNanoseconds) / 1e6);
+    }
+    
+    if (indexFile != NULL) {
+        fclose(indexFile);
+    }
+    if (postingFile != NULL) {
+        fclose(postingFile);
+    }
+    CloseMappedTable(&salesTable);
+    free(matches);
+    free(rowIds);
+    free(rows);
+    free(order);
+    free(scratch);
+    
+    return returnValue;                                // Single return point
+}//end function definition ListCustomerSalesFromIndex
+
+/*
+ * Function: LookUpCustomerSales
+ * Purpose: Lists one customer's sales through the customer name index
+ * Parameters: none
+ * Returns: int - 1 if the lookup ran, 0 on error
+ * Note: The command line passes the name and criterion in batchOptions; the menu asks
+ *       for the name and lists all of that customer's sales
+ */
+int LookUpCustomerSales(void) {
+    char customerName[40] = {0};                       // Name to look up
+    int searchOption = 1;                              // Criterion (see ListCustomerSalesFromIndex)
+    int orderDay = 0;                                  // Order date of option 2
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    if (batchOptions.active == 1) {
+        strncpy(customerName, batchOptions.customerName, 39);
+        searchOption = (batchOptions.searchOption > 0) ? batchOptions.searchOption : 1;
+        if (searchOption == 2) {
+            orderDay = DateToDayNumber(&batchOptions.orderDate);
+        }
+        returnValue = ListCustomerSalesFromIndex(customerName, searchOption, orderDay,
+                                                 batchOptions.orderNumber, batchOptions.productKey);
+    } else {
+        printf("Enter customer name to search: ");
+        if (scanf(" %39[^\n]", customerName) == 1) {
+            returnValue = ListCustomerSalesFromIndex(customerName, 1, 0, 0, 0);
         } else {
-            printf("Invalid option.\n");
+            printf("Invalid customer name.\n");
+            while (getchar() != '\n');                 // Clean input buffer
         }
     }
-}//end function definition SearchInReport2
+    
+    return returnValue;                                // Single return point
+}//end function definition LookUpCustomerSales
 
 /*
- * Function: SearchInReport5
- * Purpose: Allows user to search for specific customers or orders in Report 5 sorted data
- * Parameters: sortedFileName - name of the sorted report file
+ * Structure: Report2JoinContext
+ * Purpose: State for the Report 2 hash join emit function
+ * Note: productHasSales is indexed directly by productKey (USHRT_MAX + 1 entries)
+ */
+typedef struct {
+    FILE* reportFile;                                  // Temporary combined-record file
+    int recordsWritten;                                // Combined records written
+    unsigned char* productHasSales;                    // 1 if productKey joined at least once
+} Report2JoinContext;
+
+/*
+ * Function: EmitReport2JoinedRecord
+ * Purpose: Hash join emit function writing one product-customer record for Report 2
+ * Parameters: sale - joined sales record (unused beyond the join itself)
+ *            product - matching product
+ *            customer - matching customer
+ *            context - Report2JoinContext state
  * Returns: void
- * Note: Interactive binary search with multiple search criteria options
  */
-void SearchInReport5(const char* sortedFileName) {
-    char searchCustomerName[40] = {0};
-    salesCustomerRecord searchKey;
-    salesCustomerRecord foundRecord;
-    productRecord currentProduct;
-    long startPos = -1;
-    long endPos = -1;
-    FILE* sortedFile = NULL;
-    FILE* productsFile = NULL;
-    int searchResult = 0;
-    int continueSearching = 1;
-    char choice = 'n';
-    double customerTotal = 0.0;
-    int searchOption = 0;
-    long searchOrderNumber = 0;
-    unsigned short searchProductKey = 0;
+void EmitReport2JoinedRecord(const salesRecord* sale, const productRecord* product,
+                             const customerRecord* customer, void* context) {
+    Report2JoinContext* joinContext = (Report2JoinContext*)context;  // Join state
+    productCustomerRecord combinedRecord;                            // Combined output record
+    
+    (void)sale;
+    InitializeStructureToZero(&combinedRecord, sizeof(productCustomerRecord));
+    combinedRecord.product = *product;
+    combinedRecord.customer = *customer;
+    strncpy(combinedRecord.continent,
+            DecodeDictionaryValue(BINARY_TABLE_CUSTOMERS, CUSTOMER_DICTIONARY_CONTINENT, customer->continent), 19);
+    strncpy(combinedRecord.country,
+            DecodeDictionaryValue(BINARY_TABLE_CUSTOMERS, CUSTOMER_DICTIONARY_COUNTRY, customer->country), 19);
+    strncpy(combinedRecord.state,
+            DecodeDictionaryValue(BINARY_TABLE_CUSTOMERS, CUSTOMER_DICTIONARY_STATE, customer->state), 29);
+    
+    // Write combined record to temporary file
+    if (CountedWrite(&combinedRecord, sizeof(productCustomerRecord), 1, joinContext->reportFile) == 1) {
+        joinContext->recordsWritten++;
+        joinContext->productHasSales[product->productKey] = 1;
+    }
+}//end function definition EmitReport2JoinedRecord
+
+/*
+ * Function: GenerateReport2ProductTypesAndLocations
+ * Purpose: Generates Report 2 - Product Types and Customer Locations
+ * Parameters: sortType - "Bubble", "Merge" or "Radix" to specify sorting algorithm
+ * Returns: int - 1 if the report was written, 0 on error
+ * Note: Sorts by ProductName + Continent + Country + State + City
+ *       Generates timestamped .txt file with formatted report
+ *       Cleans up all temporary files after completion
+ */
+int GenerateReport2ProductTypesAndLocations(const char* sortType) {
+    FILE* productsFile = NULL;                         // Products table file
+    FILE* reportFile = NULL;                           // Combined report data file
+    mappedTable sortedTable;                           // Mapped sorted report file
+    FILE* txtFile = NULL;                              // Output text report file
+    HashJoinTable productsTable;                       // Products hash join build side
+    HashJoinTable customersTable;                      // Customers hash join build side
+    Report2JoinContext joinContext;                    // Hash join emit state
+    productRecord currentProduct;                      // Current product record
+    productCustomerRecord displayRecord;               // Record for display
+    char reportFileName[300] = {0};                    // Generated report file name
+    char sortedFileName[300] = {0};                    // Sorted report file name
+    char txtFileName[300] = {0};                       // Text report file name
+    char currentProductName[50] = {0};                 // Current product name for display (increased size)
+    char reportTitle[100] = {0};                       // Report title
+    int recordsProcessed = 0;                          // Number of records processed
+    int recordsSorted = 0;                             // Number of records sorted
+    int recordCount = 0;                               // Total records in sorted file
+    int displayCount = 0;                              // Number of records displayed
+    int maxDisplayRecords = 0;                         // Maximum records to display (0 = all)
+    int ascending = 1;                                 // Sort order (1 = ascending, 0 = descending)
+    time_t startTime = 0;                              // Report generation start time
+    int errorOccurred = 0;                             // Error flag (single return pattern)
+    int returnValue = 0;                               // Return value (single return pattern)
+    int filesOpenSuccess = 0;                          // Flag for file opening success
+    int sortTypeValid = 0;                             // Flag for sort type validation
+    sortKeySpec sortKey;                               // Normalized sort key specification
     
-    printf("\n=== Search in Report 5 ===\n");
+    InitializeStructureToZero(&productsTable, sizeof(HashJoinTable));
+    InitializeStructureToZero(&customersTable, sizeof(HashJoinTable));
+    InitializeStructureToZero(&sortedTable, sizeof(mappedTable));
+    InitializeStructureToZero(&joinContext, sizeof(Report2JoinContext));
     
-    while (continueSearching == 1) {
-        printf("\nSearch options:\n");
-        printf("1. Search by Customer Name\n");
-        printf("2. Search by Customer Name + Order Date\n");
-        printf("3. Search by Customer Name + Order Number\n");
-        printf("4. Search by Customer Name + Product Key\n");
-        printf("5. Browse all customers\n");
-        printf("0. Exit search\n");
-        printf("Your choice: ");
+    printf("\nGenerating Report 2: Product Types and Customer Locations\n");
+    
+    // Get user preferences
+    if (GetReportPreferences(&maxDisplayRecords, &ascending) == 0) {
+        printf("Report generation cancelled.\n");
+        return returnValue;
+    }
+    
+    printf("Using %s sort algorithm...\n", sortType);
+    
+    time(&startTime);
+    
+    // Generate text report filename with timestamp
+    sprintf(txtFileName, "Report_2_Products_%s_%ld.txt", sortType, (long)time(NULL));
+    BeginReportMetrics(txtFileName);
+    
+    // Open text file for report output
+    txtFile = OpenReportFile(txtFileName);
+    if (txtFile == NULL) {
+        printf("Error: Cannot create report text file\n");
+        return returnValue;                            // Early return on file creation failure
+    }
+    
+    // Create temporary file for combined data
+    sprintf(reportFileName, "temp_report2_%ld.dat", (long)time(NULL));
+    reportFile = OpenFileWithErrorCheck(reportFileName, "wb+");
+    if (reportFile == NULL) {
+        printf("Error: Cannot create temporary report file\n");
+        errorOccurred = 1;
+    }
+    
+    StartMetricPhase(METRIC_PHASE_JOIN);
+    if (errorOccurred == 0) {
+        // Build hash tables over both dimension tables once
+        joinContext.reportFile = reportFile;
+        joinContext.recordsWritten = 0;
+        joinContext.productHasSales = (unsigned char*)calloc(USHRT_MAX + 1, sizeof(unsigned char));
+        
+        if (joinContext.productHasSales != NULL &&
+            BuildHashJoinTable(&productsTable, "ProductsTable.dat", sizeof(productRecord), ExtractProductJoinKey) >= 0 &&
+            PrepareCustomerJoinTable(&customersTable) >= 0 && LoadTableDictionary(BINARY_TABLE_CUSTOMERS) == 1) {
+            filesOpenSuccess = 1;
+        } else {
+            printf("Error: Cannot open all required table files\n");
+            errorOccurred = 1;
+        }
+    }
+    
+    if (errorOccurred == 0 && filesOpenSuccess == 1) {
+        printf("Joining sales, products, and customers data...\n");
         
-        if (scanf("%d", &searchOption) != 1) {
-            printf("Invalid input.\n");
-            while (getchar() != '\n');
-            searchOption = 0;
+        // Stream sales through both hash tables, writing combined records
+        if (ExecuteSalesHashJoin(&productsTable, &customersTable, EmitReport2JoinedRecord, &joinContext) < 0) {
+            printf("Error: Cannot open all required table files\n");
+            errorOccurred = 1;
         }
+        recordsProcessed = joinContext.recordsWritten;
         
-        if (searchOption == 0) {
-            continueSearching = 0;
-        } else if (searchOption >= 1 && searchOption <= 5) {
-            // Initialize search key
-            InitializeStructureToZero(&searchKey, sizeof(salesCustomerRecord));
-            
-            if (searchOption >= 1 && searchOption <= 4) {
-                printf("Enter customer name to search: ");
-                scanf(" %39[^\n]", searchCustomerName);
-                strncpy(searchKey.customer.name, searchCustomerName, 39);
-                searchKey.customer.name[39] = '\0';
-            }
-            
-            if (searchOption == 2) {
-                printf("Enter order date (MM/DD/YYYY): ");
-                int month, day, year;
-                if (scanf("%d/%d/%d", &month, &day, &year) == 3) {
-                    searchKey.sale.orderDate.monthOfYear = month;
-                    searchKey.sale.orderDate.dayOfMonth = day;
-                    searchKey.sale.orderDate.yearValue = year;
-                } else {
-                    printf("Invalid date format.\n");
-                    while (getchar() != '\n');
-                    continue;
-                }
-            }
+        printf("Data joining completed. %d combined records created.\n", recordsProcessed);
+        
+        if (errorOccurred == 0 && recordsProcessed == 0) {
+            printf("No data to sort. Report generation cancelled.\n");
+            errorOccurred = 1;
+        }
+    }
+    
+    // Release join state
+    FreeHashJoinTable(&productsTable);
+    FreeHashJoinTable(&customersTable);
+    if (reportFile != NULL) fclose(reportFile);
+    StopMetricPhase(METRIC_PHASE_JOIN);
+    
+    if (errorOccurred == 0) {
+        // Generate sorted filename
+        GenerateSortedFileName("Report2", sortType, sortedFileName);
+        
+        printf("Sorting data using %s sort...\n", sortType);
+        StartMetricPhase(METRIC_PHASE_SORT);
+        
+        // Validate sort type and perform sorting on compact tags
+        BuildReport2SortKeySpec(&sortKey);
+        if (strcmp(sortType, "Bubble") == 0) {
+            sortTypeValid = 1;
+            recordsSorted = SortRecordsByNormalizedKey(reportFileName, sortedFileName, sizeof(productCustomerRecord),
+                                                       &sortKey, SortBubble);
+        } else if (strcmp(sortType, "Merge") == 0) {
+            sortTypeValid = 1;
+            recordsSorted = SortRecordsByNormalizedKey(reportFileName, sortedFileName, sizeof(productCustomerRecord),
+                                                       &sortKey, SortMerge);
+        } else if (strcmp(sortType, "Radix") == 0) {
+            sortTypeValid = 1;
+            recordsSorted = SortRecordsByNormalizedKey(reportFileName, sortedFileName, sizeof(productCustomerRecord),
+                                                       &sortKey, SortRadix);
+        } else {
+            printf("Error: Invalid sort type '%s'\n", sortType);
+            sortTypeValid = 0;
+            errorOccurred = 1;
+        }
+        
+        StopMetricPhase(METRIC_PHASE_SORT);
+        
+        if (sortTypeValid == 1 && recordsSorted <= 0) {
+            printf("Error: Sorting failed\n");
+            errorOccurred = 1;
+        }
+        
+        if (sortTypeValid == 1 && recordsSorted > 0) {
+            printf("Sorting completed: %d records sorted in %.3f seconds\n",
+                   recordsSorted, GetMetricPhaseSeconds(METRIC_PHASE_SORT));
+            metrics.resultRows = recordsSorted;
+        }
+    }
+    
+    // Clean up temporary .dat file
+    remove(reportFileName);
+    
+    if (errorOccurred == 0) {
+        // Generate the report to both file and console
+        sprintf(reportTitle, "Report 2: Products list ordered by ProductName + Continent + Country + State + City");
+        StartMetricPhase(METRIC_PHASE_RENDER);
+        GenerateReportHeader(txtFile, reportTitle);
+        
+        // Read and display sorted data with duplicate elimination
+        if (OpenMappedTable(&sortedTable, sortedFileName, sizeof(productCustomerRecord), TABLE_ACCESS_SEQUENTIAL) == 1) {
+            char previousContinent[20] = {0};          // Previous continent for duplicate check
+            char previousCountry[20] = {0};            // Previous country for duplicate check
+            char previousState[30] = {0};              // Previous state for duplicate check
+            char previousCity[40] = {0};               // Previous city for duplicate check
+            int locationCount = 0;                     // Count of unique locations for current product
+            long totalRecordsInFile = 0;               // Total records in sorted file
+            long startPosition = 0;                    // Starting position for reading
+            int actualLimit = 0;                       // Actual limit considering max display
             
-            if (searchOption == 3) {
-                printf("Enter order number: ");
-                if (scanf("%ld", &searchOrderNumber) != 1) {
-                    printf("Invalid order number.\n");
-                    while (getchar() != '\n');
-                    continue;
-                }
-            }
+            // Count total records in file
+            totalRecordsInFile = sortedTable.recordCount;
             
-            if (searchOption == 4) {
-                printf("Enter product key: ");
-                if (scanf("%hu", &searchProductKey) != 1) {
-                    printf("Invalid product key.\n");
-                    while (getchar() != '\n');
-                    continue;
-                }
-                searchKey.sale.productKey = searchProductKey;
+            // Determine actual limit
+            if (maxDisplayRecords == 0 || maxDisplayRecords > totalRecordsInFile) {
+                actualLimit = totalRecordsInFile;
+            } else {
+                actualLimit = maxDisplayRecords;
             }
             
-            // Try binary search first for exact match
-            searchResult = SearchBinaryRange(sortedFileName, &searchKey, 
-                                            sizeof(salesCustomerRecord),
-                                            CompareCustomerNameOnly, &startPos, &endPos);
+            // For descending order, we need to read records in reverse
+            // Store the direction and adjust reading logic
+            int readDirection = ascending;  // 1 for forward, 0 for backward
             
-            // If exact match not found, do sequential search for partial matches
-            if ((searchResult <= 0 || startPos < 0) && searchOption >= 1 && searchOption <= 4) {
-                printf("\nExact match not found. Searching for partial matches...\n");
+            // Determine starting position based on sort order
+            if (ascending == 1) {
+                startPosition = 0;  // Start from beginning for ascending
+            } else {
+                startPosition = totalRecordsInFile - 1;  // Start from last record for descending
+            }
+            int continueReading = 1;
+            while (displayCount < actualLimit && continueReading == 1) {
+                long currentPosition = 0;
                 
-                sortedFile = fopen(sortedFileName, "rb");
-                productsFile = OpenFileWithErrorCheck("ProductsTable.dat", "rb");
+                // Calculate position based on read direction
+                if (readDirection == 1) {
+                    // Ascending: read forward from startPosition
+                    currentPosition = startPosition + displayCount;
+                } else {
+                    // Descending: read backward from startPosition
+                    currentPosition = startPosition - displayCount;
+                }
                 
-                if (sortedFile != NULL && productsFile != NULL) {
-                    char lowerSearch[40] = {0};
-                    char lowerCustomer[40] = {0};
-                    ToLowerCase(lowerSearch, searchCustomerName, 40);
-                    
-                    printf("\n*** FOUND (Partial Matches) ***\n");
-                    printf("Customers containing '%s':\n", searchCustomerName);
-                    printf("=================================================================\n");
-                    
-                    long currentOrder = -1;
-                    customerTotal = 0.0;
-                    int matchCount = 0;
-                    char lastShownCustomer[40] = {0};
-                    
-                    while (fread(&foundRecord, sizeof(salesCustomerRecord), 1, sortedFile) == 1) {
-                        // Convert customer name to lowercase
-                        ToLowerCase(lowerCustomer, foundRecord.customer.name, 40);
-                        
-                        // Check if search term is substring
-                        if (strstr(lowerCustomer, lowerSearch) != NULL) {
-                            int matches = 1;
-                            
-                            // Apply additional filters
-                            if (searchOption == 2) {
-                                if (foundRecord.sale.orderDate.monthOfYear != searchKey.sale.orderDate.monthOfYear ||
-                                    foundRecord.sale.orderDate.dayOfMonth != searchKey.sale.orderDate.dayOfMonth ||
-                                    foundRecord.sale.orderDate.yearValue != searchKey.sale.orderDate.yearValue) {
-                                    matches = 0;
-                                }
-                            }
-                            if (searchOption == 3 && foundRecord.sale.orderNumber != searchOrderNumber) {
-                                matches = 0;
-                            }
-                            if (searchOption == 4 && foundRecord.sale.productKey != searchProductKey) {
-                                matches = 0;
-                            }
-                            
-                            if (matches == 1) {
-                                // Check if new customer or new order
-                                if (strcmp(lastShownCustomer, foundRecord.customer.name) != 0) {
-                                    if (strlen(lastShownCustomer) > 0) {
-                                        printf("--------------------------------------------------------------------------------------\n");
-                                    }
-                                    strncpy(lastShownCustomer, foundRecord.customer.name, 39);
-                                    lastShownCustomer[39] = '\0';
-                                    currentOrder = -1;
-                                }
-                                
-                                if (currentOrder != foundRecord.sale.orderNumber) {
-                                    if (currentOrder != -1) {
-                                        printf("--------------------------------------------------------------------------------------\n");
-                                    }
-                                    currentOrder = foundRecord.sale.orderNumber;
-                                    printf("\nCustomer: %s\n", foundRecord.customer.name);
-                                    printf("Order #%ld - Date: %04u/%02u/%02u\n",
-                                           currentOrder,
-                                           foundRecord.sale.orderDate.yearValue,
-                                           foundRecord.sale.orderDate.monthOfYear,
-                                           foundRecord.sale.orderDate.dayOfMonth);
-                                }
-                                
-                                // Find product
-                                int productFound = 0;
-                                rewind(productsFile);
-                                while (fread(&currentProduct, sizeof(productRecord), 1, productsFile) == 1 && productFound == 0) {
-                                    if (currentProduct.productKey == foundRecord.sale.productKey) {
-                                        productFound = 1;
-                                    }
-                                }
-                                
-                                if (productFound == 1) {
-                                    // Calculate price with currency conversion
-                                    double unitPrice = currentProduct.unitPriceUSD;
-                                    const char* currency = foundRecord.sale.currencyCode;
-                                    const dateStructure* date = &foundRecord.sale.orderDate;
-                                    double priceInUSD = ConvertCurrencyToUSD(unitPrice, currency, date);
-                                    double lineValue = RoundToThirdDecimal(priceInUSD * foundRecord.sale.quantity);
-                                    
-                                    printf("  ProductKey: %u - %s\n", 
-                                           foundRecord.sale.productKey,
-                                           currentProduct.productName);
-                                    printf("    Quantity: %u  Price: $%.2f  Total: $%.2f\n",
-                                           foundRecord.sale.quantity,
-                                           priceInUSD,
-                                           lineValue);
-                                    
-                                    customerTotal += lineValue;
-                                    matchCount++;
-                                }
-                            }
-                        }
-                    }
-                    
-                    printf("=================================================================\n");
-                    if (matchCount > 0) {
-                        printf("TOTAL: $%.2f\n", customerTotal);
-                        printf("Total matching records: %d\n", matchCount);
-                    } else {
-                        printf("\n*** NOT FOUND ***\n");
-                        printf("No customers containing '%s' were found.\n", searchCustomerName);
-                    }
-                    
-                    fclose(sortedFile);
-                    fclose(productsFile);
-                    sortedFile = NULL;
-                    productsFile = NULL;
+                // Check if position is valid
+                if (currentPosition < 0 || currentPosition >= totalRecordsInFile) {
+                    continueReading = 0;  // Exit if we've gone beyond file bounds
                 }
-            } else if (searchResult == 1 && startPos >= 0) {
-                printf("\n*** FOUND ***\n");
-                printf("Showing results for '%s':\n\n", searchCustomerName);
                 
-                // Open files
-                sortedFile = fopen(sortedFileName, "rb");
-                productsFile = OpenFileWithErrorCheck("ProductsTable.dat", "rb");
+                // Copy record at calculated position out of the mapping
+                if (continueReading == 1) {
+                    displayRecord = *(const productCustomerRecord*)MappedRecordAt(&sortedTable, currentPosition);
+                }
                 
-                if (sortedFile != NULL && productsFile != NULL) {
-                    fseek(sortedFile, startPos * sizeof(salesCustomerRecord), SEEK_SET);
-                    
-                    printf("=================================================================\n");
-                    
-                    long currentPos = startPos;
-                    long currentOrder = -1;
-                    customerTotal = 0.0;
-                    int matchCount = 0;
+                // Only process record if read was successful
+                if (continueReading == 1) {
+                    recordCount++;
                     
-                    while (currentPos <= endPos && 
-                           fread(&foundRecord, sizeof(salesCustomerRecord), 1, sortedFile) == 1) {
-                        
-                        // Apply additional filters based on search option
-                        int matches = 1;
-                        
-                        if (searchOption == 2) {
-                            if (foundRecord.sale.orderDate.monthOfYear != searchKey.sale.orderDate.monthOfYear ||
-                                foundRecord.sale.orderDate.dayOfMonth != searchKey.sale.orderDate.dayOfMonth ||
-                                foundRecord.sale.orderDate.yearValue != searchKey.sale.orderDate.yearValue) {
-                                matches = 0;
-                            }
-                        }
-                        
-                        if (searchOption == 3 && foundRecord.sale.orderNumber != searchOrderNumber) {
-                            matches = 0;
-                        }
-                        
-                        if (searchOption == 4 && foundRecord.sale.productKey != searchProductKey) {
-                            matches = 0;
+                    // Check if this is a new product
+                    if (strcmp(currentProductName, displayRecord.product.productName) != 0) {
+                        if (strlen(currentProductName) > 0) {
+                            WriteToReport(txtFile, "\n");  // Add blank line between products
                         }
-                        
-                        if (matches == 1) {
-                            // Check if new order
-                            if (currentOrder != foundRecord.sale.orderNumber) {
-                                if (currentOrder != -1) {
-                                    printf("--------------------------------------------------------------------------------------\n");
-                                }
-                                currentOrder = foundRecord.sale.orderNumber;
-                                printf("\nOrder #%ld - Date: %04u/%02u/%02u\n",
-                                       currentOrder,
-                                       foundRecord.sale.orderDate.yearValue,
-                                       foundRecord.sale.orderDate.monthOfYear,
-                                       foundRecord.sale.orderDate.dayOfMonth);
-                            }
-                            
-                            // Find product
-                            int productFound = 0;
-                            rewind(productsFile);
-                            while (fread(&currentProduct, sizeof(productRecord), 1, productsFile) == 1 && productFound == 0) {
-                                if (currentProduct.productKey == foundRecord.sale.productKey) {
-                                    productFound = 1;
-                                }
-                            }
+                        // Copy full product name safely
+                        strncpy(currentProductName, displayRecord.product.productName, 29);
+                        currentProductName[29] = '\0';
+                        // Display the full product name from the record itself
+                        char fullProductName[31] = {0};
+                        strncpy(fullProductName, displayRecord.product.productName, 30);
+                        fullProductName[30] = '\0';
+                        WriteToReport(txtFile, "ProductName: %s\n", fullProductName);
                             
-                            if (productFound == 1) {
-                                // Calculate price with currency conversion
-                                double unitPrice = currentProduct.unitPriceUSD;
-                                const char* currency = foundRecord.sale.currencyCode;
-                                const dateStructure* date = &foundRecord.sale.orderDate;
-                                double priceInUSD = ConvertCurrencyToUSD(unitPrice, currency, date);
-                                double lineValue = RoundToThirdDecimal(priceInUSD * foundRecord.sale.quantity);
-                                
-                                printf("  ProductKey: %u - %s\n", 
-                                       foundRecord.sale.productKey,
-                                       currentProduct.productName);
-                                printf("    Quantity: %u  Price: $%.2f  Total: $%.2f\n",
-                                       foundRecord.sale.quantity,
-                                       currentProduct.unitPriceUSD,
-                                       lineValue);
-                                
-                                customerTotal += lineValue;
-                                matchCount++;
-                            }
-                        }
-                        
-                        currentPos++;
+                        // Reset duplicate tracking for new product
+                        previousContinent[0] = '\0';
+                        previousCountry[0] = '\0';
+                        previousState[0] = '\0';
+                        previousCity[0] = '\0';
+                        locationCount = 0;
                     }
                     
-                    printf("=================================================================\n");
-                    if (searchOption <= 4) {
-                        printf("TOTAL: $%.2f\n", customerTotal);
-                        printf("Total matching records: %d\n", matchCount);
+                    // Check if this location is a duplicate
+                    int isDuplicate = 0;
+                    if (strcmp(previousContinent, displayRecord.continent) == 0 &&
+                        strcmp(previousCountry, displayRecord.country) == 0 &&
+                        strcmp(previousState, displayRecord.state) == 0 &&
+                        strcmp(previousCity, displayRecord.customer.city) == 0) {
+                        isDuplicate = 1;
                     }
                     
-                    fclose(sortedFile);
-                    fclose(productsFile);
-                }
-            } else if (searchOption == 5) {
-                // Browse all customers
-                printf("\n=== All Customers ===\n");
-                sortedFile = fopen(sortedFileName, "rb");
-                if (sortedFile != NULL) {
-                    char lastCustomer[40] = {0};
-                    int customerCount = 0;
-                    int maxShow = 20;
-                    
-                    printf("Show how many customers? (0 = all): ");
-                    scanf("%d", &maxShow);
-                    
-                    printf("\n%-40s %-15s %-15s\n", "Customer Name", "Orders", "Total Sales");
-                    printf("--------------------------------------------------------------------------------------\n");
-                    
-                    double currentCustomerTotal = 0.0;
-                    int currentCustomerOrders = 0;
-                    long lastOrder = -1;
-                    
-                    productsFile = OpenFileWithErrorCheck("ProductsTable.dat", "rb");
-                    
-                    while (fread(&foundRecord, sizeof(salesCustomerRecord), 1, sortedFile) == 1) {
-                        if (strcmp(lastCustomer, foundRecord.customer.name) != 0) {
-                            // New customer
-                            if (strlen(lastCustomer) > 0) {
-                                printf("%-40s %-15d $%.2f\n", lastCustomer, currentCustomerOrders, currentCustomerTotal);
-                                customerCount++;
-                                
-                                if (maxShow > 0 && customerCount >= maxShow) {
-                                    printf("... (showing first %d customers)\n", maxShow);
-                                    fseek(sortedFile, 0, SEEK_END);  // Jump to end to exit loop naturally
-                                }
-                            }
-                            
-                            strncpy(lastCustomer, foundRecord.customer.name, 39);
-                            currentCustomerTotal = 0.0;
-                            currentCustomerOrders = 0;
-                            lastOrder = -1;
-                        }
-                        
-                        // Count order
-                        if (lastOrder != foundRecord.sale.orderNumber) {
-                            currentCustomerOrders++;
-                            lastOrder = foundRecord.sale.orderNumber;
-                        }
+                    // Only print if not duplicate
+                    if (isDuplicate == 0) {
+                        WriteToReport(txtFile, "    %s %s %s %s\n", 
+                               displayRecord.continent,
+                               displayRecord.country,
+                               displayRecord.state,
+                               displayRecord.customer.city);
                         
-                        // Calculate total
-                        if (productsFile != NULL) {
-                            rewind(productsFile);
-                            int productFoundInLoop = 0;
-                            while (fread(&currentProduct, sizeof(productRecord), 1, productsFile) == 1 && productFoundInLoop == 0) {
-                                if (currentProduct.productKey == foundRecord.sale.productKey) {
-                                    // Calculate with proper currency conversion
-                                    double unitPrice = currentProduct.unitPriceUSD;
-                                    const char* currency = foundRecord.sale.currencyCode;
-                                    const dateStructure* date = &foundRecord.sale.orderDate;
-                                    double priceInUSD = ConvertCurrencyToUSD(unitPrice, currency, date);
-                                    double lineValue = RoundToThirdDecimal(priceInUSD * foundRecord.sale.quantity);
-                                    currentCustomerTotal += lineValue;
-                                    productFoundInLoop = 1;  // Exit loop condition instead of break
-                                }
-                            }
-                        }
+                        // Save current location for next comparison
+                        strncpy(previousContinent, displayRecord.continent, 19);
+                        previousContinent[19] = '\0';
+                        strncpy(previousCountry, displayRecord.country, 19);
+                        previousCountry[19] = '\0';
+                        strncpy(previousState, displayRecord.state, 29);
+                        previousState[29] = '\0';
+                        strncpy(previousCity, displayRecord.customer.city, 39);
+                        previousCity[39] = '\0';
+                        locationCount++;
                     }
-                    
-                    // Print last customer
-                    if (strlen(lastCustomer) > 0) {
-                        printf("%-40s %-15d $%.2f\n", lastCustomer, currentCustomerOrders, currentCustomerTotal);
-                        customerCount++;
+                
+                    displayCount++;
+                }
+            }
+            
+            CloseMappedTable(&sortedTable);
+            
+            if (maxDisplayRecords > 0 && recordCount > maxDisplayRecords) {
+                WriteReportSummary(txtFile, "\n... Total records: %d (showing %d)\n", 
+                       (int)totalRecordsInFile, actualLimit);
+            }
+            
+            // Now check for products with no sales
+            WriteToReport(txtFile, "\n");
+            tableHeader productsHeader;
+            productsFile = OpenBinaryTable("ProductsTable.dat", sizeof(productRecord), &productsHeader);
+            if (productsFile != NULL) {
+                int productsWithoutSales = 0;
+                
+                // Anti-join: products never marked during the hash join have no sales
+                for (long i = 0; i < productsHeader.rowCount &&
+                                 CountedRead(&currentProduct, sizeof(productRecord), 1, productsFile) == 1; i++) {
+                    if (joinContext.productHasSales[currentProduct.productKey] == 0) {
+                        WriteToReport(txtFile, "ProductName: %s\n", currentProduct.productName);
+                        WriteToReport(txtFile, "    - No sales reported\n\n");
+                        productsWithoutSales++;
                     }
-                    
-                    printf("--------------------------------------------------------------------------------------\n");
-                    printf("Total customers shown: %d\n", customerCount);
-                    
-                    if (productsFile != NULL) fclose(productsFile);
-                    fclose(sortedFile);
                 }
+                
+                fclose(productsFile);
+                
+                if (productsWithoutSales > 0) {
+                    WriteReportSummary(txtFile, "Products without sales: %d\n", productsWithoutSales);
+                }
+            }
+            
+            WriteReportSummary(txtFile, "\nTotal records in report: %d\n", recordCount);
+            
+            GenerateReportFooter(txtFile, startTime);
+            
+            // Close text report file
+            if (txtFile != NULL) {
+                fclose(txtFile);
+                txtFile = NULL;
+            }
+            
+            // Success message
+            printf("\nReport saved successfully in: %s\n", txtFileName);
+            returnValue = 1;
+            
+            // Ask user if they want to search for specific products
+            char searchChoice = 'n';
+            if (batchOptions.active == 1) {
+                searchChoice = (batchOptions.searchOption > 0) ? 'y' : 'n';
+            } else {
+                printf("\nDo you want to search for specific products in this report? (y/n): ");
+                scanf(" %c", &searchChoice);
             }
             
-            printf("\nPerform another search? (y/n): ");
-            scanf(" %c", &choice);
-            if (choice != 'y' && choice != 'Y') {
-                continueSearching = 0;
+            if (searchChoice == 'y' || searchChoice == 'Y') {
+                SearchInReport2(sortedFileName);
             }
+            
+            // Clean up sorted .dat file after search is done
+            remove(sortedFileName);
         } else {
-            printf("Invalid option.\n");
+            printf("Error: Cannot open sorted report file\n");
+            if (txtFile != NULL) {
+                fclose(txtFile);
+            }
+            remove(txtFileName);  // Remove incomplete report
+        }
+    } else {
+        // Error occurred - clean up text file if opened
+        if (txtFile != NULL) {
+            fclose(txtFile);
+            remove(txtFileName);  // Remove incomplete report
         }
     }
-}//end function definition SearchInReport5
+    
+    free(joinContext.productHasSales);
+    
+    return returnValue;                                // Single return point
+}//end function definition GenerateReport2ProductTypesAndLocations
 
 /*
- * Function: GenerateReport2ProductTypesAndLocations
- * Purpose: Generates Report 2 - Product Types and Customer Locations
- * Parameters: sortType - "Bubble" or "Merge" to specify sorting algorithm
+ * Structure: Report5JoinContext
+ * Purpose: State for the Report 5 hash join emit function
+ */
+typedef struct {
+    FILE* reportFile;                                  // Temporary combined-record file
+    int recordsWritten;                                // Combined records written
+} Report5JoinContext;
+
+/*
+ * Function: EmitReport5JoinedRecord
+ * Purpose: Hash join emit function writing one sales-customer record for Report 5
+ * Parameters: sale - sales record being joined
+ *            product - unused (products are not joined for Report 5)
+ *            customer - matching customer
+ *            context - Report5JoinContext state
  * Returns: void
- * Note: Sorts by ProductName + Continent + Country + State + City
+ */
+void EmitReport5JoinedRecord(const salesRecord* sale, const productRecord* product,
+                             const customerRecord* customer, void* context) {
+    Report5JoinContext* joinContext = (Report5JoinContext*)context;  // Join state
+    salesCustomerRecord combinedRecord;                              // Combined output record
+    
+    (void)product;
+    InitializeStructureToZero(&combinedRecord, sizeof(salesCustomerRecord));
+    combinedRecord.sale = *sale;
+    combinedRecord.customer = *customer;
+    
+    // Write combined record to temporary file
+    if (CountedWrite(&combinedRecord, sizeof(salesCustomerRecord), 1, joinContext->reportFile) == 1) {
+        joinContext->recordsWritten++;
+    }
+}//end function definition EmitReport5JoinedRecord
+
+/*
+ * Function: GenerateReport5CustomerSalesListing
+ * Purpose: Generates Report 5 - Customer Sales Listing ordered by Customer Name + Order Date + ProductKey
+ * Parameters: sortType - "Bubble", "Merge" or "Radix" to specify sorting algorithm
+ * Returns: int - 1 if the report was written, 0 on error
+ * Note: Includes currency conversion, grouping by customer and order, with subtotals and grand total
  *       Generates timestamped .txt file with formatted report
  *       Cleans up all temporary files after completion
  */
-void GenerateReport2ProductTypesAndLocations(const char* sortType) {
-    FILE* salesFile = NULL;                            // Sales table file
-    FILE* productsFile = NULL;                         // Products table file
-    FILE* customersFile = NULL;                        // Customers table file
+int GenerateReport5CustomerSalesListing(const char* sortType) {
     FILE* reportFile = NULL;                           // Combined report data file
-    FILE* sortedFile = NULL;                           // Sorted report file
+    mappedTable sortedTable;                           // Mapped sorted report file
     FILE* txtFile = NULL;                              // Output text report file
-    salesRecord currentSale;                           // Current sales record
-    productRecord currentProduct;                      // Current product record
-    customerRecord currentCustomer;                    // Current customer record
-    productCustomerRecord combinedRecord;              // Combined product-customer record
-    productCustomerRecord displayRecord;               // Record for display
+    HashJoinTable customersTable;                      // Customers hash join build side
+    Report5JoinContext joinContext;                    // Hash join emit state
+    const productRecord* saleProduct = NULL;           // Product of the displayed sale
+    salesCustomerRecord displayRecord;                 // Record for display
+    dateStructure orderDate;                           // Order date of the displayed sale
     char reportFileName[300] = {0};                    // Generated report file name
     char sortedFileName[300] = {0};                    // Sorted report file name
     char txtFileName[300] = {0};                       // Text report file name
-    char currentProductName[50] = {0};                 // Current product name for display (increased size)
-    char reportTitle[100] = {0};                       // Report title
+    char reportTitle[150] = {0};                       // Report title
+    char currentCustomerName[40] = {0};                // Current customer name for grouping
+    long currentOrderNumber = -1;                      // Current order number for grouping
+    double orderSubtotal = 0.0;                        // Subtotal for current order
+    double customerTotal = 0.0;                        // Total for current customer
+    double grandTotal = 0.0;                           // Grand total for all sales
     int recordsProcessed = 0;                          // Number of records processed
     int recordsSorted = 0;                             // Number of records sorted
     int recordCount = 0;                               // Total records in sorted file
-    int displayCount = 0;                              // Number of records displayed
     int maxDisplayRecords = 0;                         // Maximum records to display (0 = all)
     int ascending = 1;                                 // Sort order (1 = ascending, 0 = descending)
     time_t startTime = 0;                              // Report generation start time
-    time_t sortStartTime = 0;                          // Sorting start time
-    time_t sortEndTime = 0;                            // Sorting end time
     int errorOccurred = 0;                             // Error flag (single return pattern)
+    int returnValue = 0;                               // Return value (single return pattern)
     int filesOpenSuccess = 0;                          // Flag for file opening success
-    int productFound = 0;                              // Flag for product match
-    int customerFound = 0;                             // Flag for customer match
-    int continueProductSearch = 1;                     // Control flag for product search
-    int continueCustomerSearch = 1;                    // Control flag for customer search
     int sortTypeValid = 0;                             // Flag for sort type validation
+    sortKeySpec sortKey;                               // Normalized sort key specification
+    int firstRecord = 1;                               // Flag for first record
     
-    printf("\nGenerating Report 2: Product Types and Customer Locations\n");
+    InitializeStructureToZero(&customersTable, sizeof(HashJoinTable));
+    InitializeStructureToZero(&sortedTable, sizeof(mappedTable));
+    InitializeStructureToZero(&joinContext, sizeof(Report5JoinContext));
+    
+    printf("\nGenerating Report 5: Customer Sales Listing\n");
     
     // Get user preferences
     if (GetReportPreferences(&maxDisplayRecords, &ascending) == 0) {
         printf("Report generation cancelled.\n");
-        return;
+        return returnValue;
     }
     
     printf("Using %s sort algorithm...\n", sortType);
@@ -3971,30 +9137,33 @@ void GenerateReport2ProductTypesAndLocations(const char* sortType) {
     time(&startTime);
     
     // Generate text report filename with timestamp
-    sprintf(txtFileName, "Report_2_Products_%s_%ld.txt", sortType, (long)time(NULL));
+    sprintf(txtFileName, "Report_5_Sales_%s_%ld.txt", sortType, (long)time(NULL));
+    BeginReportMetrics(txtFileName);
     
     // Open text file for report output
-    txtFile = OpenFileWithErrorCheck(txtFileName, "w");
+    txtFile = OpenReportFile(txtFileName);
     if (txtFile == NULL) {
         printf("Error: Cannot create report text file\n");
-        return;                                        // Early return on file creation failure
+        return returnValue;                            // Early return on file creation failure
     }
     
     // Create temporary file for combined data
-    sprintf(reportFileName, "temp_report2_%ld.dat", (long)time(NULL));
+    sprintf(reportFileName, "temp_report5_%ld.dat", (long)time(NULL));
     reportFile = OpenFileWithErrorCheck(reportFileName, "wb+");
     if (reportFile == NULL) {
         printf("Error: Cannot create temporary report file\n");
+        fclose(txtFile);
+        remove(txtFileName);
         errorOccurred = 1;
     }
     
+    StartMetricPhase(METRIC_PHASE_JOIN);
     if (errorOccurred == 0) {
-        // Open all required tables
-        salesFile = OpenFileWithErrorCheck("SalesTable.dat", "rb");
-        productsFile = OpenFileWithErrorCheck("ProductsTable.dat", "rb");
-        customersFile = OpenFileWithErrorCheck("CustomersTable.dat", "rb");
+        // Build hash table over the customers dimension once
+        joinContext.reportFile = reportFile;
+        joinContext.recordsWritten = 0;
         
-        if (salesFile != NULL && productsFile != NULL && customersFile != NULL) {
+        if (PrepareCustomerJoinTable(&customersTable) >= 0) {
             filesOpenSuccess = 1;
         } else {
             printf("Error: Cannot open all required table files\n");
@@ -4003,91 +9172,66 @@ void GenerateReport2ProductTypesAndLocations(const char* sortType) {
     }
     
     if (errorOccurred == 0 && filesOpenSuccess == 1) {
-        printf("Joining sales, products, and customers data...\n");
+        printf("Joining sales and customers data...\n");
         
-        // Process each sales record
-        while (fread(&currentSale, sizeof(salesRecord), 1, salesFile) == 1 && errorOccurred == 0) {
-            productFound = 0;
-            customerFound = 0;
-            continueProductSearch = 1;
-            continueCustomerSearch = 1;
-            
-            // Find matching product
-            rewind(productsFile);
-            while (fread(&currentProduct, sizeof(productRecord), 1, productsFile) == 1 && continueProductSearch == 1) {
-                if (currentProduct.productKey == currentSale.productKey) {
-                    productFound = 1;
-                    continueProductSearch = 0;         // Exit loop condition
-                }
-            }
-            
-            // Find matching customer
-            rewind(customersFile);
-            while (fread(&currentCustomer, sizeof(customerRecord), 1, customersFile) == 1 && continueCustomerSearch == 1) {
-                if (currentCustomer.customerKey == currentSale.customerKey) {
-                    customerFound = 1;
-                    continueCustomerSearch = 0;        // Exit loop condition
-                }
-            }
-            
-            // If both product and customer found, create combined record
-            if (productFound == 1 && customerFound == 1) {
-                InitializeStructureToZero(&combinedRecord, sizeof(productCustomerRecord));
-                combinedRecord.product = currentProduct;
-                combinedRecord.customer = currentCustomer;
-                
-                // Write combined record to temporary file
-                if (fwrite(&combinedRecord, sizeof(productCustomerRecord), 1, reportFile) == 1) {
-                    recordsProcessed++;
-                }
-            }
+        // Stream sales through the customers hash table, writing combined records
+        if (ExecuteSalesHashJoin(NULL, &customersTable, EmitReport5JoinedRecord, &joinContext) < 0) {
+            printf("Error: Cannot open all required table files\n");
+            errorOccurred = 1;
         }
+        recordsProcessed = joinContext.recordsWritten;
         
         printf("Data joining completed. %d combined records created.\n", recordsProcessed);
         
-        if (recordsProcessed == 0) {
+        if (errorOccurred == 0 && recordsProcessed == 0) {
             printf("No data to sort. Report generation cancelled.\n");
             errorOccurred = 1;
         }
     }
     
-    // Close table files
-    if (salesFile != NULL) fclose(salesFile);
-    if (productsFile != NULL) fclose(productsFile);
-    if (customersFile != NULL) fclose(customersFile);
+    // Release join state
+    FreeHashJoinTable(&customersTable);
     if (reportFile != NULL) fclose(reportFile);
+    StopMetricPhase(METRIC_PHASE_JOIN);
     
     if (errorOccurred == 0) {
         // Generate sorted filename
-        GenerateSortedFileName("Report2", sortType, sortedFileName);
+        GenerateSortedFileName("Report5", sortType, sortedFileName);
         
         printf("Sorting data using %s sort...\n", sortType);
-        time(&sortStartTime);
+        StartMetricPhase(METRIC_PHASE_SORT);
         
-        // Validate sort type and perform sorting
+        // Validate sort type and perform sorting on compact tags
+        BuildReport5SortKeySpec(&sortKey);
         if (strcmp(sortType, "Bubble") == 0) {
             sortTypeValid = 1;
-            recordsSorted = SortBubble(reportFileName, sortedFileName, 
-                                       sizeof(productCustomerRecord), CompareProductsForReport2);
+            recordsSorted = SortRecordsByNormalizedKey(reportFileName, sortedFileName, sizeof(salesCustomerRecord),
+                                                       &sortKey, SortBubble);
         } else if (strcmp(sortType, "Merge") == 0) {
             sortTypeValid = 1;
-            recordsSorted = SortMerge(reportFileName, sortedFileName, 
-                                      sizeof(productCustomerRecord), CompareProductsForReport2);
+            recordsSorted = SortRecordsByNormalizedKey(reportFileName, sortedFileName, sizeof(salesCustomerRecord),
+                                                       &sortKey, SortMerge);
+        } else if (strcmp(sortType, "Radix") == 0) {
+            sortTypeValid = 1;
+            recordsSorted = SortRecordsByNormalizedKey(reportFileName, sortedFileName, sizeof(salesCustomerRecord),
+                                                       &sortKey, SortRadix);
         } else {
             printf("Error: Invalid sort type '%s'\n", sortType);
             sortTypeValid = 0;
             errorOccurred = 1;
         }
         
+        StopMetricPhase(METRIC_PHASE_SORT);
+        
         if (sortTypeValid == 1 && recordsSorted <= 0) {
             printf("Error: Sorting failed\n");
             errorOccurred = 1;
         }
         
         if (sortTypeValid == 1 && recordsSorted > 0) {
-            time(&sortEndTime);
-            printf("Sorting completed: %d records sorted in %.0f seconds\n", 
-                   recordsSorted, difftime(sortEndTime, sortStartTime));
+            printf("Sorting completed: %d records sorted in %.3f seconds\n",
+                   recordsSorted, GetMetricPhaseSeconds(METRIC_PHASE_SORT));
+            metrics.resultRows = recordsSorted;
         }
     }
     
@@ -4096,24 +9240,20 @@ void GenerateReport2ProductTypesAndLocations(const char* sortType) {
     
     if (errorOccurred == 0) {
         // Generate the report to both file and console
-        sprintf(reportTitle, "Report 2: Products list ordered by ProductName + Continent + Country + State + City");
+        sprintf(reportTitle, "Report 5: Customer list ordered by Customer name + order date for sale + Product Key");
+        StartMetricPhase(METRIC_PHASE_RENDER);
         GenerateReportHeader(txtFile, reportTitle);
         
-        // Read and display sorted data with duplicate elimination
-        sortedFile = OpenFileWithErrorCheck(sortedFileName, "rb");
-        if (sortedFile != NULL) {
-            char previousContinent[20] = {0};          // Previous continent for duplicate check
-            char previousCountry[20] = {0};            // Previous country for duplicate check
-            char previousState[30] = {0};              // Previous state for duplicate check
-            char previousCity[40] = {0};               // Previous city for duplicate check
-            int locationCount = 0;                     // Count of unique locations for current product
+        // Read and display sorted data with grouping
+        if (OpenMappedTable(&sortedTable, sortedFileName, sizeof(salesCustomerRecord), TABLE_ACCESS_SEQUENTIAL) == 1 &&
+            LoadProductDimension() == 1) {
             long totalRecordsInFile = 0;               // Total records in sorted file
             long startPosition = 0;                    // Starting position for reading
             int actualLimit = 0;                       // Actual limit considering max display
+            int displayedRecords = 0;                  // Counter for displayed records
             
             // Count total records in file
-            fseek(sortedFile, 0, SEEK_END);
-            totalRecordsInFile = ftell(sortedFile) / sizeof(productCustomerRecord);
+            totalRecordsInFile = sortedTable.recordCount;
             
             // Determine actual limit
             if (maxDisplayRecords == 0 || maxDisplayRecords > totalRecordsInFile) {
@@ -4123,7 +9263,6 @@ void GenerateReport2ProductTypesAndLocations(const char* sortType) {
             }
             
             // For descending order, we need to read records in reverse
-            // Store the direction and adjust reading logic
             int readDirection = ascending;  // 1 for forward, 0 for backward
             
             // Determine starting position based on sort order
@@ -4132,17 +9271,16 @@ void GenerateReport2ProductTypesAndLocations(const char* sortType) {
             } else {
                 startPosition = totalRecordsInFile - 1;  // Start from last record for descending
             }
+            
             int continueReading = 1;
-            while (displayCount < actualLimit && continueReading == 1) {
+            while (displayedRecords < actualLimit && continueReading == 1) {
                 long currentPosition = 0;
                 
                 // Calculate position based on read direction
                 if (readDirection == 1) {
-                    // Ascending: read forward from startPosition
-                    currentPosition = startPosition + displayCount;
+                    currentPosition = startPosition + displayedRecords;
                 } else {
-                    // Descending: read backward from startPosition
-                    currentPosition = startPosition - displayCount;
+                    currentPosition = startPosition - displayedRecords;
                 }
                 
                 // Check if position is valid
@@ -4150,123 +9288,117 @@ void GenerateReport2ProductTypesAndLocations(const char* sortType) {
                     continueReading = 0;  // Exit if we've gone beyond file bounds
                 }
                 
-                // Seek to calculated position and read record
+                // Copy record at calculated position out of the mapping
                 if (continueReading == 1) {
-                    fseek(sortedFile, currentPosition * sizeof(productCustomerRecord), SEEK_SET);
-                    if (fread(&displayRecord, sizeof(productCustomerRecord), 1, sortedFile) != 1) {
-                        continueReading = 0;  // Exit if read fails
-                    }
+                    displayRecord = *(const salesCustomerRecord*)MappedRecordAt(&sortedTable, currentPosition);
                 }
                 
                 // Only process record if read was successful
                 if (continueReading == 1) {
                     recordCount++;
+                    double lineValue = 0.0;
                     
-                    // Check if this is a new product
-                    if (strcmp(currentProductName, displayRecord.product.productName) != 0) {
-                        if (strlen(currentProductName) > 0) {
-                            WriteToReport(txtFile, "\n");  // Add blank line between products
+                    // Find product information
+                    saleProduct = LookupProductByKey(displayRecord.sale.productKey);
+                    
+                    // Check if we're starting a new customer
+                    if (strcmp(currentCustomerName, displayRecord.customer.name) != 0) {
+                        // Print previous customer total if not first record
+                        if (firstRecord == 0) {
+                            WriteToReport(txtFile, "%90s%12s\n", "TOTAL", "");
+                            WriteToReport(txtFile, "%102.2f\n", customerTotal);
+                            WriteToReport(txtFile, "----------------------------------------------------------------------------------------------------------------------\n");
                         }
-                        // Copy full product name safely
-                        strncpy(currentProductName, displayRecord.product.productName, 29);
-                        currentProductName[29] = '\0';
-                        // Display the full product name from the record itself
-                        char fullProductName[31] = {0};
-                        strncpy(fullProductName, displayRecord.product.productName, 30);
-                        fullProductName[30] = '\0';
-                        WriteToReport(txtFile, "ProductName: %s\n", fullProductName);
-                            
-                        // Reset duplicate tracking for new product
-                        previousContinent[0] = '\0';
-                        previousCountry[0] = '\0';
-                        previousState[0] = '\0';
-                        previousCity[0] = '\0';
-                        locationCount = 0;
+                        
+                        // New customer - print header
+                        strncpy(currentCustomerName, displayRecord.customer.name, 39);
+                        currentCustomerName[39] = '\0';
+                        customerTotal = 0.0;
+                        currentOrderNumber = -1;
+                        firstRecord = 0;
+                        
+                        WriteToReport(txtFile, "Costumer name: %s\n", currentCustomerName);
                     }
                     
-                    // Check if this location is a duplicate
-                    int isDuplicate = 0;
-                    if (strcmp(previousContinent, displayRecord.customer.continent) == 0 &&
-                        strcmp(previousCountry, displayRecord.customer.country) == 0 &&
-                        strcmp(previousState, displayRecord.customer.state) == 0 &&
-                        strcmp(previousCity, displayRecord.customer.city) == 0) {
-                        isDuplicate = 1;
+                    // Check if we're starting a new order
+                    if (currentOrderNumber != displayRecord.sale.orderNumber) {
+                        // Print previous order subtotal if not first order for this customer
+                        if (currentOrderNumber != -1) {
+                            WriteToReport(txtFile, "%90s%12.2f\n", "Subtotal", orderSubtotal);
+                        }
+                        
+                        // New order
+                        currentOrderNumber = displayRecord.sale.orderNumber;
+                        orderSubtotal = 0.0;
+                        
+                        DayNumberToDate(displayRecord.sale.orderDay, &orderDate);
+                        WriteToReport(txtFile, "Order date:  %04u/%02u/%02u   Order Number: %ld\n", 
+                               orderDate.yearValue,
+                               orderDate.monthOfYear,
+                               orderDate.dayOfMonth,
+                               currentOrderNumber);
+                        WriteToReport(txtFile, "  ProductKey       ProductName%52sQuantity%8sValue USD\n", "", "");
                     }
                     
-                    // Only print if not duplicate
-                    if (isDuplicate == 0) {
-                        WriteToReport(txtFile, "    %s %s %s %s\n", 
-                               displayRecord.customer.continent,
-                               displayRecord.customer.country,
-                               displayRecord.customer.state,
-                               displayRecord.customer.city);
+                    // Calculate line value
+                    if (saleProduct != NULL) {
+                        // Get unit price from product
+                        double unitPrice = saleProduct->unitPriceUSD;
                         
-                        // Save current location for next comparison
-                        strncpy(previousContinent, displayRecord.customer.continent, 19);
-                        previousContinent[19] = '\0';
-                        strncpy(previousCountry, displayRecord.customer.country, 19);
-                        previousCountry[19] = '\0';
-                        strncpy(previousState, displayRecord.customer.state, 29);
-                        previousState[29] = '\0';
-                        strncpy(previousCity, displayRecord.customer.city, 39);
-                        previousCity[39] = '\0';
-                        locationCount++;
+                        // Get currency code from sale transaction
+                        const char* currency = displayRecord.sale.currencyCode;
+                        
+                        // Convert to USD using exchange rate for the transaction date
+                        double priceInUSD = ConvertCurrencyToUSD(unitPrice, currency, displayRecord.sale.orderDay);
+                        
+                        // Calculate line value with quantity and apply rounding
+                        lineValue = RoundToThirdDecimal(priceInUSD * displayRecord.sale.quantity);
+                        
+                        // Print line item
+                        WriteToReport(txtFile, "%11u%18s%-51s%8u%15.2f\n",
+                               displayRecord.sale.productKey,
+                               "",
+                               saleProduct->productName,
+                               displayRecord.sale.quantity,
+                               lineValue);
+                        
+                        // Accumulate totals
+                        orderSubtotal += lineValue;
+                        customerTotal += lineValue;
+                        grandTotal += lineValue;
+                    } else {
+                        WriteToReport(txtFile, "%11u%18s%-51s%8u%15s\n",
+                               displayRecord.sale.productKey,
+                               "",
+                               "[Product Not Found]",
+                               displayRecord.sale.quantity,
+                               "N/A");
                     }
-                
-                    displayCount++;
+                    
+                    displayedRecords++;  // Increment displayed records counter
                 }
             }
             
-            fclose(sortedFile);
-            sortedFile = NULL;
+            // Print last order subtotal and customer total
+            if (currentOrderNumber != -1) {
+                WriteToReport(txtFile, "%90s%12.2f\n", "Subtotal", orderSubtotal);
+            }
             
-            if (maxDisplayRecords > 0 && recordCount > maxDisplayRecords) {
-                WriteToReport(txtFile, "\n... Total records: %d (showing %d)\n", 
-                       (int)totalRecordsInFile, actualLimit);
+            if (firstRecord == 0) {
+                WriteToReport(txtFile, "%90s%12s\n", "TOTAL", "");
+                WriteToReport(txtFile, "%102.2f\n", customerTotal);
+                WriteToReport(txtFile, "----------------------------------------------------------------------------------------------------------------------\n");
             }
             
-            // Now check for products with no sales
+            // Print grand total
             WriteToReport(txtFile, "\n");
-            productsFile = OpenFileWithErrorCheck("ProductsTable.dat", "rb");
-            if (productsFile != NULL) {
-                int productsWithoutSales = 0;
-                
-                // Reopen sorted file for searching
-                sortedFile = OpenFileWithErrorCheck(sortedFileName, "rb");
-                
-                while (fread(&currentProduct, sizeof(productRecord), 1, productsFile) == 1) {
-                    int productHasSales = 0;
-                    
-                    // Search for this product in the sorted results
-                    if (sortedFile != NULL) {
-                        rewind(sortedFile);
-                        while (fread(&displayRecord, sizeof(productCustomerRecord), 1, sortedFile) == 1 && productHasSales == 0) {
-                            if (displayRecord.product.productKey == currentProduct.productKey) {
-                                productHasSales = 1;
-                            }
-                        }
-                    }
-                    
-                    // If product has no sales, display it
-                    if (productHasSales == 0) {
-                        WriteToReport(txtFile, "ProductName: %s\n", currentProduct.productName);
-                        WriteToReport(txtFile, "    - No sales reported\n\n");
-                        productsWithoutSales++;
-                    }
-                }
-                
-                fclose(productsFile);
-                if (sortedFile != NULL) {
-                    fclose(sortedFile);
-                    sortedFile = NULL;
-                }
-                
-                if (productsWithoutSales > 0) {
-                    WriteToReport(txtFile, "Products without sales: %d\n", productsWithoutSales);
-                }
+            WriteReportSummary(txtFile, "\nTotal records in report: %d\n", recordCount);
+            
+            if (maxDisplayRecords > 0 && totalRecordsInFile > maxDisplayRecords) {
+                WriteReportSummary(txtFile, "(Showing %d of %ld total records)\n", actualLimit, totalRecordsInFile);
             }
             
-            WriteToReport(txtFile, "\nTotal records in report: %d\n", recordCount);
+            CloseMappedTable(&sortedTable);
             
             GenerateReportFooter(txtFile, startTime);
             
@@ -4277,24 +9409,30 @@ void GenerateReport2ProductTypesAndLocations(const char* sortType) {
             }
             
             // Success message
-            printf("\nReport saved successfully in: %s\n", txtFileName);
+            printf("\nReporte guardado exitosamente en: %s\n", txtFileName);
+            returnValue = 1;
             
-            // Ask user if they want to search for specific products
-            printf("\nDo you want to search for specific products in this report? (y/n): ");
+            // Ask user if they want to search for specific customers
             char searchChoice = 'n';
-            scanf(" %c", &searchChoice);
+            if (batchOptions.active == 1) {
+                searchChoice = (batchOptions.searchOption > 0) ? 'y' : 'n';
+            } else {
+                printf("\nDo you want to search for specific customers in this report? (y/n): ");
+                scanf(" %c", &searchChoice);
+            }
             
             if (searchChoice == 'y' || searchChoice == 'Y') {
-                SearchInReport2(sortedFileName);
+                SearchInReport5(sortedFileName);
             }
             
             // Clean up sorted .dat file after search is done
             remove(sortedFileName);
         } else {
-            printf("Error: Cannot open sorted report file\n");
+            printf("Error: Cannot open sorted report file or products file\n");
             if (txtFile != NULL) {
                 fclose(txtFile);
             }
+            CloseMappedTable(&sortedTable);
             remove(txtFileName);  // Remove incomplete report
         }
     } else {
@@ -4305,1193 +9443,1366 @@ void GenerateReport2ProductTypesAndLocations(const char* sortType) {
         }
     }
     
-    // No explicit return needed for void function - single implicit return point
-}//end function definition GenerateReport2ProductTypesAndLocations
+    return returnValue;                                // Single return point
+}//end function definition GenerateReport5CustomerSalesListing
+
+// ====================== MAIN ALGORITHMS ======================
 
 /*
- * Function: GenerateReport5CustomerSalesListing
- * Purpose: Generates Report 5 - Customer Sales Listing ordered by Customer Name + Order Date + ProductKey
- * Parameters: sortType - "Bubble" or "Merge" to specify sorting algorithm
- * Returns: void
- * Note: Includes currency conversion, grouping by customer and order, with subtotals and grand total
- *       Generates timestamped .txt file with formatted report
- *       Cleans up all temporary files after completion
+ * Function: SearchMappedTable
+ * Purpose: Performs binary search over the records of a mapped sorted table
+ * Parameters: table - open mapped table, sorted by compareFunction
+ *            searchKey - pointer to the record to search for
+ *            compareFunction - pointer to comparison function
+ *            resultPosition - pointer to store the position if found
+ * Returns: int - 1 if found, 0 if not found
+ * Note: Records are compared in place, so each probe costs no read or copy
  */
-void GenerateReport5CustomerSalesListing(const char* sortType) {
-    FILE* salesFile = NULL;                            // Sales table file
-    FILE* customersFile = NULL;                        // Customers table file
-    FILE* productsFile = NULL;                         // Products table file
-    FILE* reportFile = NULL;                           // Combined report data file
-    FILE* sortedFile = NULL;                           // Sorted report file
-    FILE* txtFile = NULL;                              // Output text report file
-    salesRecord currentSale;                           // Current sales record
-    customerRecord currentCustomer;                    // Current customer record
-    productRecord currentProduct;                      // Current product record
-    salesCustomerRecord combinedRecord;                // Combined sales-customer record
-    salesCustomerRecord displayRecord;                 // Record for display
-    char reportFileName[300] = {0};                    // Generated report file name
-    char sortedFileName[300] = {0};                    // Sorted report file name
-    char txtFileName[300] = {0};                       // Text report file name
-    char reportTitle[150] = {0};                       // Report title
-    char currentCustomerName[40] = {0};                // Current customer name for grouping
-    long currentOrderNumber = -1;                      // Current order number for grouping
-    double orderSubtotal = 0.0;                        // Subtotal for current order
-    double customerTotal = 0.0;                        // Total for current customer
-    double grandTotal = 0.0;                           // Grand total for all sales
-    int recordsProcessed = 0;                          // Number of records processed
-    int recordsSorted = 0;                             // Number of records sorted
-    int recordCount = 0;                               // Total records in sorted file
-    int maxDisplayRecords = 0;                         // Maximum records to display (0 = all)
-    int ascending = 1;                                 // Sort order (1 = ascending, 0 = descending)
-    time_t startTime = 0;                              // Report generation start time
-    time_t sortStartTime = 0;                          // Sorting start time
-    time_t sortEndTime = 0;                            // Sorting end time
-    int errorOccurred = 0;                             // Error flag (single return pattern)
-    int filesOpenSuccess = 0;                          // Flag for file opening success
-    int customerFound = 0;                             // Flag for customer match
-    int continueCustomerSearch = 1;                    // Control flag for customer search
-    int sortTypeValid = 0;                             // Flag for sort type validation
-    int firstRecord = 1;                               // Flag for first record
+int SearchMappedTable(const mappedTable* table, const void* searchKey,
+                      int (*compareFunction)(const void*, const void*), long* resultPosition) {
+    long leftBound = 0;                                // Left boundary for binary search
+    long rightBound = table->recordCount - 1;          // Right boundary for binary search
+    long middlePosition = 0;                           // Middle position for binary search
+    int comparisonResult = 0;                          // Result of record comparison
+    long long comparisons = 0;                         // Comparator invocations
+    int found = 0;                                     // Found flag (single return pattern)
     
-    printf("\nGenerating Report 5: Customer Sales Listing\n");
+    if (resultPosition != NULL) {
+        *resultPosition = -1;
+    }
     
-    // Get user preferences
-    if (GetReportPreferences(&maxDisplayRecords, &ascending) == 0) {
-        printf("Report generation cancelled.\n");
-        return;
+    while (found == 0 && leftBound <= rightBound) {
+        middlePosition = leftBound + (rightBound - leftBound) / 2;
+        comparisonResult = compareFunction(searchKey, MappedRecordAt(table, middlePosition));
+        comparisons++;
+        
+        if (comparisonResult == 0) {
+            // Found exact match
+            if (resultPosition != NULL) {
+                *resultPosition = middlePosition;
+            }
+            found = 1;
+        } else if (comparisonResult < 0) {
+            // Search key is smaller, search left half
+            rightBound = middlePosition - 1;
+        } else {
+            // Search key is larger, search right half
+            leftBound = middlePosition + 1;
+        }
     }
     
-    printf("Using %s sort algorithm...\n", sortType);
+    CountComparisons(comparisons);
     
-    time(&startTime);
+    return found;                                      // Single return point
+}//end function definition SearchMappedTable
+
+/*
+ * Function: SearchBinary
+ * Purpose: Performs binary search on sorted file-based data without loading into memory
+ * Parameters: fileName - name of sorted binary file to search
+ *            searchKey - pointer to the record to search for
+ *            recordSize - size of each record in bytes
+ *            compareFunction - pointer to comparison function
+ *            resultPosition - pointer to store the position if found
+ * Returns: int - 1 if found, 0 if not found, -1 if error
+ * Note: Requires data to be sorted first. The file is mapped with a random-access
+ *       hint, so only the pages touched by the search are read.
+ *       Complies with restrictions: no break, single return, file-based operations
+ */
+int SearchBinary(const char* fileName, const void* searchKey, size_t recordSize,
+                 int (*compareFunction)(const void*, const void*), long* resultPosition) {
+    mappedTable sortedTable;                           // Mapped sorted file
+    int returnValue = -1;                              // Return value (single return pattern)
     
-    // Generate text report filename with timestamp
-    sprintf(txtFileName, "Report_5_Sales_%s_%ld.txt", sortType, (long)time(NULL));
+    // Initialize result position to -1 (not found)
+    if (resultPosition != NULL) {
+        *resultPosition = -1;
+    }
     
-    // Open text file for report output
-    txtFile = OpenFileWithErrorCheck(txtFileName, "w");
-    if (txtFile == NULL) {
-        printf("Error: Cannot create report text file\n");
-        return;                                        // Early return on file creation failure
+    if (OpenMappedTable(&sortedTable, fileName, recordSize, TABLE_ACCESS_RANDOM) == 0) {
+        printf("Error: Cannot open file %s for binary search\n", fileName);
+    } else {
+        if (sortedTable.recordCount == 0) {
+            printf("Warning: File %s is empty\n", fileName);
+            returnValue = 0;                           // Not found (empty file)
+        } else {
+            returnValue = SearchMappedTable(&sortedTable, searchKey, compareFunction, resultPosition);
+        }
+        CloseMappedTable(&sortedTable);
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition SearchBinary
+
+/*
+ * Function: SearchBinaryRange
+ * Purpose: Finds all records matching a search criteria in a sorted file
+ * Parameters: fileName - name of sorted binary file to search
+ *            searchKey - pointer to the record to search for
+ *            recordSize - size of each record in bytes
+ *            compareFunction - pointer to comparison function
+ *            startPosition - pointer to store the first matching position
+ *            endPosition - pointer to store the last matching position
+ * Returns: int - number of matching records found, -1 if error
+ * Note: Useful for finding all records with the same key value. The file is mapped
+ *       once for both the search and the range expansion.
+ *       Complies with restrictions: no break, single return, file-based operations
+ */
+int SearchBinaryRange(const char* fileName, const void* searchKey, size_t recordSize,
+                      int (*compareFunction)(const void*, const void*), 
+                      long* startPosition, long* endPosition) {
+    mappedTable sortedTable;                           // Mapped sorted file
+    long firstMatch = -1;                              // Position of first match
+    long rangeStart = 0;                               // Start of matching range
+    long rangeEnd = 0;                                 // End of matching range
+    int returnValue = -1;                              // Return value (single return pattern)
+    
+    // Initialize result positions
+    if (startPosition != NULL) {
+        *startPosition = -1;
+    }
+    if (endPosition != NULL) {
+        *endPosition = -1;
+    }
+    
+    if (OpenMappedTable(&sortedTable, fileName, recordSize, TABLE_ACCESS_RANDOM) == 0) {
+        printf("Error: Cannot open file %s for binary search\n", fileName);
+    } else if (sortedTable.recordCount == 0) {
+        printf("Warning: File %s is empty\n", fileName);
+        returnValue = 0;                               // Not found (empty file)
+    } else if (SearchMappedTable(&sortedTable, searchKey, compareFunction, &firstMatch) == 0) {
+        returnValue = 0;                               // Not found
+    } else {
+        // Expand left and right from the match while records still compare equal
+        rangeStart = firstMatch;
+        while (rangeStart > 0 &&
+               compareFunction(searchKey, MappedRecordAt(&sortedTable, rangeStart - 1)) == 0) {
+            rangeStart--;
+        }
+        rangeEnd = firstMatch;
+        while (rangeEnd + 1 < sortedTable.recordCount &&
+               compareFunction(searchKey, MappedRecordAt(&sortedTable, rangeEnd + 1)) == 0) {
+            rangeEnd++;
+        }
+        
+        // Each step compared once, plus the failed comparison at either end that stopped it
+        CountComparisons((firstMatch - rangeStart) + (rangeEnd - firstMatch) +
+                         (rangeStart > 0) + (rangeEnd + 1 < sortedTable.recordCount));
+        
+        if (startPosition != NULL) {
+            *startPosition = rangeStart;
+        }
+        if (endPosition != NULL) {
+            *endPosition = rangeEnd;
+        }
+        returnValue = (int)(rangeEnd - rangeStart + 1);
+    }
+    
+    CloseMappedTable(&sortedTable);
+    
+    return returnValue;                                // Single return point
+}//end function definition SearchBinaryRange
+
+/*
+ * Function: ExternalMergeSort
+ * Purpose: Sorts a record file with an external merge sort
+ * Parameters: inputFileName - source binary file with unsorted records
+ *            outputFileName - destination file for sorted records
+ *            recordSize - size of each record in bytes
+ *            compareFunction - function pointer for comparing two records
+ *            runSorter - in-memory sort used for each run
+ * Returns: long - number of records sorted, -1 on error
+ * Note: Phase 1 sorts memory-budget-sized runs in RAM with runSorter and writes them
+ *       sequentially (see SetSortMemoryBudget). Phase 2 merges all runs in a single pass with a
+ *       loser tree. Only if there are more than SORT_MAX_MERGE_FAN_IN runs are
+ *       intermediate passes used to reduce the number of open files.
+ *       Stable: equal records keep their input order. O(n log n) comparisons,
+ *       all I/O sequential within each run.
+ */
+long ExternalMergeSort(const char* inputFileName, const char* outputFileName, size_t recordSize,
+                       int (*compareFunction)(const void*, const void*),
+                       void (*runSorter)(const unsigned char**, const unsigned char**, long,
+                                         int (*)(const void*, const void*))) {
+    char runFileName[300] = {0};                       // Temp file holding current runs
+    char mergeFileName[300] = {0};                     // Temp file for intermediate passes
+    char swapName[300] = {0};                          // Temporary for swapping file names
+    FILE* outputFile = NULL;                           // Destination (final or intermediate)
+    sortRunDescriptor* runs = NULL;                    // Current run descriptors
+    long runCount = 0;                                 // Number of current runs
+    long recordsRead = 0;                              // Records in input file
+    long recordsMerged = 0;                            // Records written by a merge
+    long groupRecords = 0;                             // Records produced for one merged group
+    long groupCount = 0;                               // Runs produced by an intermediate pass
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    // Generate temp file names
+    sprintf(runFileName, "temp_sort_runs_%ld.dat", (long)time(NULL));
+    sprintf(mergeFileName, "temp_sort_merge_%ld.dat", (long)time(NULL));
+    
+    // Step 1: Generate sorted runs
+    printf("Generating sorted runs (memory budget %lu KB, %d threads)...\n",
+           (unsigned long)(sortMemoryBudget / 1024), GetSortThreadCount());
+    recordsRead = CreateSortedRuns(inputFileName, runFileName, recordSize, compareFunction, runSorter,
+                                   &runs, &runCount);
+    if (recordsRead < 0) {
+        errorOccurred = 1;
+    } else {
+        printf("Created %ld sorted runs from %ld records\n", runCount, recordsRead);
+    }
+    
+    // Step 2: Intermediate passes, only when there are too many runs to open at once
+    while (errorOccurred == 0 && runCount > SORT_MAX_MERGE_FAN_IN) {
+        outputFile = OpenFileWithErrorCheck(mergeFileName, "wb");
+        groupCount = 0;
+        groupRecords = 0;
+        if (outputFile == NULL) {
+            errorOccurred = 1;
+        }
+        
+        for (long firstRun = 0; firstRun < runCount && errorOccurred == 0; firstRun += SORT_MAX_MERGE_FAN_IN) {
+            recordsMerged = MergeSortedRuns(runFileName, runs + firstRun,
+                                            (runCount - firstRun < SORT_MAX_MERGE_FAN_IN) ? runCount - firstRun : SORT_MAX_MERGE_FAN_IN,
+                                            outputFile, recordSize, compareFunction);
+            if (recordsMerged < 0) {
+                errorOccurred = 1;
+            } else {
+                // Merged groups become the runs of the next pass (in place, groupCount <= firstRun)
+                runs[groupCount].firstRecord = groupRecords;
+                runs[groupCount].recordCount = recordsMerged;
+                groupRecords += recordsMerged;
+                groupCount++;
+            }
+        }
+        
+        if (outputFile != NULL) fclose(outputFile);
+        outputFile = NULL;
+        runCount = groupCount;
+        printf("Intermediate merge pass reduced data to %ld runs\n", runCount);
+        
+        strcpy(swapName, runFileName);
+        strcpy(runFileName, mergeFileName);
+        strcpy(mergeFileName, swapName);
+    }
+    
+    // Step 3: Single k-way merge into the output file
+    if (errorOccurred == 0) {
+        outputFile = OpenFileWithErrorCheck(outputFileName, "wb");
+        if (outputFile == NULL) {
+            errorOccurred = 1;
+        } else {
+            setvbuf(outputFile, NULL, _IOFBF, 1024 * 1024);
+            recordsMerged = MergeSortedRuns(runFileName, runs, runCount, outputFile, recordSize, compareFunction);
+            if (fclose(outputFile) != 0 || recordsMerged != recordsRead) {
+                errorOccurred = 1;
+            }
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        returnValue = recordsMerged;
+    }
+    
+    // Cleanup
+    free(runs);
+    remove(runFileName);                               // Delete temporary files
+    remove(mergeFileName);
+    
+    return returnValue;                                // Single return point
+}//end function definition ExternalMergeSort
+
+/*
+ * Function: SortMerge
+ * Purpose: Sorts records using an external merge sort
+ * Parameters: inputFileName - source binary file with unsorted records
+ *            outputFileName - destination file for sorted records
+ *            recordSize - size of each record in bytes
+ *            compareFunction - function pointer for comparing two records
+ * Returns: int - number of records sorted, -1 on error
+ * Note: Runs are sorted in RAM with a stable merge sort, split across the sort worker
+ *       threads (see SetSortThreadCount)
+ */
+int SortMerge(const char* inputFileName, const char* outputFileName, size_t recordSize,
+              int (*compareFunction)(const void*, const void*)) {
+    long recordsSorted = 0;                            // Result of the external sort
+    
+    recordsSorted = ExternalMergeSort(inputFileName, outputFileName, recordSize,
+                                      compareFunction, ParallelMergeSortRecordPointers);
+    if (recordsSorted >= 0) {
+        printf("Merge sort completed: %ld records sorted\n", recordsSorted);
+    }
+    
+    return (int)recordsSorted;                         // Single return point
+}//end function definition SortMerge
+
+/*
+ * Function: SortRadix
+ * Purpose: Sorts records that start with a normalized key using MSD radix sort
+ * Parameters: inputFileName - source binary file with unsorted records
+ *            outputFileName - destination file for sorted records
+ *            recordSize - size of each record in bytes
+ *            compareFunction - must be CompareNormalizedKeys; any other comparison
+ *                              falls back to SortMerge
+ * Returns: int - number of records sorted, -1 on error
+ * Note: Meant for the tags of SortRecordsByNormalizedKey. Runs are sorted in RAM with
+ *       RadixSortRecordPointers on the sort worker threads and merged like SortMerge, so inputs larger than the
+ *       sort memory budget are still handled. Stable, same output as SortMerge.
+ */
+int SortRadix(const char* inputFileName, const char* outputFileName, size_t recordSize,
+              int (*compareFunction)(const void*, const void*)) {
+    long recordsSorted = 0;                            // Result of the external sort
+    
+    if (compareFunction != CompareNormalizedKeys || activeNormalizedKeySize > recordSize) {
+        // Radix needs byte-comparable keys; anything else is sorted by comparison
+        recordsSorted = SortMerge(inputFileName, outputFileName, recordSize, compareFunction);
+    } else {
+        recordsSorted = ExternalMergeSort(inputFileName, outputFileName, recordSize,
+                                          compareFunction, ParallelRadixSortRecordPointers);
+        if (recordsSorted >= 0) {
+            printf("Radix sort completed: %ld records sorted\n", recordsSorted);
+        }
     }
     
-    // Create temporary file for combined data
-    sprintf(reportFileName, "temp_report5_%ld.dat", (long)time(NULL));
-    reportFile = OpenFileWithErrorCheck(reportFileName, "wb+");
-    if (reportFile == NULL) {
-        printf("Error: Cannot create temporary report file\n");
-        fclose(txtFile);
-        remove(txtFileName);
+    return (int)recordsSorted;                         // Single return point
+}//end function definition SortRadix
+
+/*
+ * Function: SortRecordsByNormalizedKey
+ * Purpose: Sorts large records by sorting compact (normalized key, rowId) tags and gathering the records after
+ * Parameters: inputFileName - source binary file with unsorted records
+ *            outputFileName - destination file for sorted records
+ *            recordSize - size of each record in bytes
+ *            keySpec - sort specification used to normalize each record's key
+ *            sortFunction - algorithm used on the tags (SortBubble, SortMerge or SortRadix)
+ * Returns: int - number of records sorted, -1 on error
+ * Note: Each tag is the normalized key followed by the record's row number
+ *       (keySize + sizeof(long) bytes), and tags are compared with one memcmp.
+ *       Only tags go through the sort; the full records are read once to build the
+ *       tags and once more in the gather pass. The gather pass reads from memory when
+ *       the input fits in the sort memory budget, otherwise by seeking per row.
+ *       Stable if sortFunction is stable, since the row number is never compared.
+ */
+int SortRecordsByNormalizedKey(const char* inputFileName, const char* outputFileName, size_t recordSize,
+                               const sortKeySpec* keySpec,
+                               int (*sortFunction)(const char*, const char*, size_t,
+                                                   int (*)(const void*, const void*))) {
+    char tagFileName[300] = {0};                       // Unsorted tags
+    char sortedTagFileName[300] = {0};                 // Sorted tags
+    FILE* inputFile = NULL;                            // Source records
+    FILE* tagFile = NULL;                              // Tag file being written / read
+    FILE* outputFile = NULL;                           // Gathered output
+    unsigned char* recordBuffer = NULL;                // Current record
+    unsigned char* tagBuffer = NULL;                   // Current tag
+    unsigned char* inputImage = NULL;                  // Whole input when it fits the budget
+    size_t keySize = keySpec->keySize;                 // Bytes per normalized key
+    size_t tagSize = keySize + sizeof(long);           // Bytes per tag
+    long long fileSize = 0;                            // Size of input in bytes
+    long rowId = 0;                                    // Row number of current record
+    long tagsSorted = 0;                               // Tags returned by the sort
+    long recordsGathered = 0;                          // Records written by the gather pass
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = -1;                              // Return value (single return pattern)
+    
+    sprintf(tagFileName, "temp_tags_%ld.dat", (long)time(NULL));
+    sprintf(sortedTagFileName, "temp_tags_sorted_%ld.dat", (long)time(NULL));
+    
+    inputFile = OpenFileWithErrorCheck(inputFileName, "rb");
+    tagFile = OpenFileWithErrorCheck(tagFileName, "wb");
+    recordBuffer = (unsigned char*)malloc(recordSize);
+    tagBuffer = (unsigned char*)malloc(tagSize);
+    if (inputFile == NULL || tagFile == NULL || recordBuffer == NULL || tagBuffer == NULL) {
         errorOccurred = 1;
     }
     
+    // Step 1: Extract one tag per record
     if (errorOccurred == 0) {
-        // Open all required tables
-        salesFile = OpenFileWithErrorCheck("SalesTable.dat", "rb");
-        customersFile = OpenFileWithErrorCheck("CustomersTable.dat", "rb");
-        
-        if (salesFile != NULL && customersFile != NULL) {
-            filesOpenSuccess = 1;
-        } else {
-            printf("Error: Cannot open all required table files\n");
+        printf("Extracting %lu-byte sort tags from %lu-byte records...\n",
+               (unsigned long)tagSize, (unsigned long)recordSize);
+        while (errorOccurred == 0 && CountedRead(recordBuffer, recordSize, 1, inputFile) == 1) {
+            NormalizeSortKey(keySpec, recordBuffer, tagBuffer);
+            memcpy(tagBuffer + keySize, &rowId, sizeof(long));
+            if (CountedWrite(tagBuffer, tagSize, 1, tagFile) != 1) {
+                errorOccurred = 1;
+            }
+            rowId++;
+        }
+        fileSize = (long long)rowId * (long long)recordSize;
+    }
+    if (tagFile != NULL) fclose(tagFile);
+    tagFile = NULL;
+    
+    // Step 2: Sort the tags (key is at offset 0, so a memcmp over keySize orders tags)
+    if (errorOccurred == 0) {
+        activeNormalizedKeySize = keySize;
+        tagsSorted = sortFunction(tagFileName, sortedTagFileName, tagSize, CompareNormalizedKeys);
+        if (tagsSorted != rowId) {
             errorOccurred = 1;
         }
     }
     
-    if (errorOccurred == 0 && filesOpenSuccess == 1) {
-        printf("Joining sales and customers data...\n");
-        
-        // Process each sales record
-        while (fread(&currentSale, sizeof(salesRecord), 1, salesFile) == 1 && errorOccurred == 0) {
-            customerFound = 0;
-            continueCustomerSearch = 1;
-            
-            // Find matching customer
-            rewind(customersFile);
-            while (fread(&currentCustomer, sizeof(customerRecord), 1, customersFile) == 1 && continueCustomerSearch == 1) {
-                if (currentCustomer.customerKey == currentSale.customerKey) {
-                    customerFound = 1;
-                    continueCustomerSearch = 0;        // Exit loop condition
-                }
-            }
-            
-            // If customer found, create combined record
-            if (customerFound == 1) {
-                InitializeStructureToZero(&combinedRecord, sizeof(salesCustomerRecord));
-                combinedRecord.sale = currentSale;
-                combinedRecord.customer = currentCustomer;
-                
-                // Write combined record to temporary file
-                if (fwrite(&combinedRecord, sizeof(salesCustomerRecord), 1, reportFile) == 1) {
-                    recordsProcessed++;
-                }
+    // Step 3: Gather full records in tag order
+    if (errorOccurred == 0) {
+        if ((size_t)fileSize <= sortMemoryBudget) {
+            inputImage = (unsigned char*)malloc((size_t)fileSize + 1);
+            rewind(inputFile);
+            if (inputImage != NULL && CountedRead(inputImage, recordSize, (size_t)rowId, inputFile) != (size_t)rowId) {
+                free(inputImage);
+                inputImage = NULL;
             }
         }
         
-        printf("Data joining completed. %d combined records created.\n", recordsProcessed);
-        
-        if (recordsProcessed == 0) {
-            printf("No data to sort. Report generation cancelled.\n");
+        tagFile = OpenFileWithErrorCheck(sortedTagFileName, "rb");
+        outputFile = OpenFileWithErrorCheck(outputFileName, "wb");
+        if (tagFile == NULL || outputFile == NULL) {
             errorOccurred = 1;
+        } else {
+            setvbuf(outputFile, NULL, _IOFBF, 1024 * 1024);
+        }
+        
+        while (errorOccurred == 0 && CountedRead(tagBuffer, tagSize, 1, tagFile) == 1) {
+            memcpy(&rowId, tagBuffer + keySize, sizeof(long));
+            if (inputImage != NULL) {
+                memcpy(recordBuffer, inputImage + (size_t)rowId * recordSize, recordSize);
+            } else if (CountedSeek64(inputFile, (long long)rowId * (long long)recordSize, SEEK_SET) != 0 ||
+                       CountedRead(recordBuffer, recordSize, 1, inputFile) != 1) {
+                errorOccurred = 1;
+            }
+            if (errorOccurred == 0 && CountedWrite(recordBuffer, recordSize, 1, outputFile) == 1) {
+                recordsGathered++;
+            } else {
+                errorOccurred = 1;
+            }
         }
     }
     
-    // Close table files
-    if (salesFile != NULL) fclose(salesFile);
-    if (customersFile != NULL) fclose(customersFile);
-    if (reportFile != NULL) fclose(reportFile);
+    if (inputFile != NULL) fclose(inputFile);
+    if (tagFile != NULL) fclose(tagFile);
+    if (outputFile != NULL && fclose(outputFile) != 0) {
+        errorOccurred = 1;
+    }
+    free(recordBuffer);
+    free(tagBuffer);
+    free(inputImage);
+    remove(tagFileName);
+    remove(sortedTagFileName);
     
-    if (errorOccurred == 0) {
-        // Generate sorted filename
-        GenerateSortedFileName("Report5", sortType, sortedFileName);
-        
-        printf("Sorting data using %s sort...\n", sortType);
-        time(&sortStartTime);
+    if (errorOccurred == 0 && recordsGathered == tagsSorted) {
+        returnValue = (int)recordsGathered;
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition SortRecordsByNormalizedKey
+
+/*
+ * Function: SortBubble
+ * Purpose: Sorts file-based records using bubble sort algorithm (O(n²))
+ * Parameters: inputFileName - name of input binary file to sort
+ *            outputFileName - name of output file for sorted data
+ *            recordSize - size of each record in bytes
+ *            compareFunction - pointer to comparison function
+ * Returns: int - number of records sorted, -1 if error
+ * Note: Simple but less efficient algorithm, works entirely with files
+ */
+/*
+ * Function: SortBubble
+ * Purpose: Sorts records using bubble sort algorithm with file-based doubly linked list
+ * Parameters: inputFileName - source binary file with unsorted records
+ *            outputFileName - destination file for sorted records
+ *            recordSize - size of each record in bytes
+ *            compareFunction - function pointer for comparing two records
+ * Returns: int - number of records sorted, -1 on error
+ * Note: Uses doubly linked list structure stored in file to minimize I/O operations
+ *       Complies with restrictions: no break, single return, file-based (no RAM loading)
+ *       Time complexity: O(n²) comparisons but O(n) I/O operations
+ */
+int SortBubble(const char* inputFileName, const char* outputFileName, size_t recordSize, 
+               int (*compareFunction)(const void*, const void*)) {
+    char linkedListFileName[300] = {0};                // Temp linked list file name
+    FILE* listFile = NULL;                             // Linked list file pointer
+    LinkedListFileMetadata metadata;                   // List metadata
+    DoublyLinkedNodeHeader node1Header;                // First node header
+    DoublyLinkedNodeHeader node2Header;                // Second node header
+    void* data1 = NULL;                                // First node data buffer
+    void* data2 = NULL;                                // Second node data buffer
+    long nodesCreated = 0;                             // Result of list creation
+    long outerIndex = 0;                               // Outer loop counter
+    long innerIndex = 0;                               // Inner loop counter
+    long currentOffset = 0;                            // Current node offset
+    long nextOffset = 0;                               // Next node offset
+    int swapOccurred = 0;                              // Flag for swaps in pass
+    int comparisonResult = 0;                          // Result of comparison
+    int errorOccurred = 0;                             // Error flag
+    int sortComplete = 0;                              // Flag for early termination
+    long recordsConverted = 0;                         // Final conversion result
+    int returnValue = -1;                              // Return value (single return pattern)
+    
+    // Generate temp linked list file name
+    sprintf(linkedListFileName, "temp_bubble_list_%ld.dat", (long)time(NULL));
+    
+    // Step 1: Convert input file to linked list structure
+    nodesCreated = CreateLinkedListFromFile(inputFileName, linkedListFileName, recordSize);
+    
+    if (nodesCreated <= 0) {
+        errorOccurred = 1;
+        returnValue = -1;
+    } else if (nodesCreated == 1) {
+        // Single record, already sorted - just convert back
+        recordsConverted = ConvertLinkedListToFile(linkedListFileName, outputFileName);
+        remove(linkedListFileName);
+        returnValue = (int)recordsConverted;
+    }
+    
+    // Step 2: Perform bubble sort on linked list
+    if (errorOccurred == 0 && nodesCreated > 1) {
+        // Allocate data buffers
+        data1 = malloc(recordSize);
+        data2 = malloc(recordSize);
         
-        // Validate sort type and perform sorting
-        if (strcmp(sortType, "Bubble") == 0) {
-            sortTypeValid = 1;
-            recordsSorted = SortBubble(reportFileName, sortedFileName, 
-                                       sizeof(salesCustomerRecord), CompareSalesForReport5);
-        } else if (strcmp(sortType, "Merge") == 0) {
-            sortTypeValid = 1;
-            recordsSorted = SortMerge(reportFileName, sortedFileName, 
-                                      sizeof(salesCustomerRecord), CompareSalesForReport5);
-        } else {
-            printf("Error: Invalid sort type '%s'\n", sortType);
-            sortTypeValid = 0;
+        if (data1 == NULL || data2 == NULL) {
             errorOccurred = 1;
+            returnValue = -1;
         }
-        
-        if (sortTypeValid == 1 && recordsSorted <= 0) {
-            printf("Error: Sorting failed\n");
+    }
+    
+    if (errorOccurred == 0 && nodesCreated > 1) {
+        // Open linked list file for sorting
+        listFile = OpenFileWithErrorCheck(linkedListFileName, "rb+");
+        if (listFile == NULL) {
             errorOccurred = 1;
-        }
-        
-        if (sortTypeValid == 1 && recordsSorted > 0) {
-            time(&sortEndTime);
-            printf("Sorting completed: %d records sorted in %.0f seconds\n", 
-                   recordsSorted, difftime(sortEndTime, sortStartTime));
+            returnValue = -1;
         }
     }
     
-    // Clean up temporary .dat file
-    remove(reportFileName);
+    if (errorOccurred == 0 && nodesCreated > 1) {
+        // Read metadata
+        if (CountedRead(&metadata, sizeof(LinkedListFileMetadata), 1, listFile) != 1) {
+            errorOccurred = 1;
+            returnValue = -1;
+        }
+    }
     
-    if (errorOccurred == 0) {
-        // Generate the report to both file and console
-        sprintf(reportTitle, "Report 5: Customer list ordered by Customer name + order date for sale + Product Key");
-        GenerateReportHeader(txtFile, reportTitle);
-        
-        // Read and display sorted data with grouping
-        sortedFile = OpenFileWithErrorCheck(sortedFileName, "rb");
-        productsFile = OpenFileWithErrorCheck("ProductsTable.dat", "rb");
-        
-        if (sortedFile != NULL && productsFile != NULL) {
-            long totalRecordsInFile = 0;               // Total records in sorted file
-            long startPosition = 0;                    // Starting position for reading
-            int actualLimit = 0;                       // Actual limit considering max display
-            int displayedRecords = 0;                  // Counter for displayed records
-            
-            // Count total records in file
-            fseek(sortedFile, 0, SEEK_END);
-            totalRecordsInFile = ftell(sortedFile) / sizeof(salesCustomerRecord);
-            
-            // Determine actual limit
-            if (maxDisplayRecords == 0 || maxDisplayRecords > totalRecordsInFile) {
-                actualLimit = totalRecordsInFile;
-            } else {
-                actualLimit = maxDisplayRecords;
-            }
-            
-            // For descending order, we need to read records in reverse
-            int readDirection = ascending;  // 1 for forward, 0 for backward
+    if (errorOccurred == 0 && nodesCreated > 1) {
+        // Bubble sort: outer loop
+        printf("Starting bubble sort on %ld nodes...\n", nodesCreated);
+        for (outerIndex = 0; outerIndex < metadata.nodeCount - 1 && sortComplete == 0 && errorOccurred == 0; outerIndex++) {
+            swapOccurred = 0;                          // Reset swap flag for this pass
+            currentOffset = metadata.headOffset;       // Start from head
             
-            // Determine starting position based on sort order
-            if (ascending == 1) {
-                startPosition = 0;  // Start from beginning for ascending
-            } else {
-                startPosition = totalRecordsInFile - 1;  // Start from last record for descending
+            // Print progress every 100 passes
+            if (outerIndex % 100 == 0 && outerIndex > 0) {
+                printf("Bubble sort progress: pass %ld/%ld (%.1f%%)\n", 
+                       outerIndex, metadata.nodeCount - 1, 
+                       (double)outerIndex * 100.0 / (metadata.nodeCount - 1));
             }
             
-            int continueReading = 1;
-            while (displayedRecords < actualLimit && continueReading == 1) {
-                long currentPosition = 0;
-                
-                // Calculate position based on read direction
-                if (readDirection == 1) {
-                    currentPosition = startPosition + displayedRecords;
-                } else {
-                    currentPosition = startPosition - displayedRecords;
-                }
-                
-                // Check if position is valid
-                if (currentPosition < 0 || currentPosition >= totalRecordsInFile) {
-                    continueReading = 0;  // Exit if we've gone beyond file bounds
-                }
-                
-                // Seek to calculated position and read record
-                if (continueReading == 1) {
-                    fseek(sortedFile, currentPosition * sizeof(salesCustomerRecord), SEEK_SET);
-                    if (fread(&displayRecord, sizeof(salesCustomerRecord), 1, sortedFile) != 1) {
-                        continueReading = 0;  // Exit if read fails
-                    }
-                }
-                
-                // Only process record if read was successful
-                if (continueReading == 1) {
-                    recordCount++;
-                    int productFound = 0;
-                    int continueProductSearch = 1;
-                    double lineValue = 0.0;
-                    
-                    // Find product information
-                    rewind(productsFile);
-                    while (fread(&currentProduct, sizeof(productRecord), 1, productsFile) == 1 && continueProductSearch == 1) {
-                        if (currentProduct.productKey == displayRecord.sale.productKey) {
-                            productFound = 1;
-                            continueProductSearch = 0;
-                        }
-                    }
-                    
-                    // Check if we're starting a new customer
-                    if (strcmp(currentCustomerName, displayRecord.customer.name) != 0) {
-                        // Print previous customer total if not first record
-                        if (firstRecord == 0) {
-                            WriteToReport(txtFile, "%90s%12s\n", "TOTAL", "");
-                            WriteToReport(txtFile, "%102.2f\n", customerTotal);
-                            WriteToReport(txtFile, "----------------------------------------------------------------------------------------------------------------------\n");
-                        }
-                        
-                        // New customer - print header
-                        strncpy(currentCustomerName, displayRecord.customer.name, 39);
-                        currentCustomerName[39] = '\0';
-                        customerTotal = 0.0;
-                        currentOrderNumber = -1;
-                        firstRecord = 0;
-                        
-                        WriteToReport(txtFile, "Costumer name: %s\n", currentCustomerName);
-                    }
-                    
-                    // Check if we're starting a new order
-                    if (currentOrderNumber != displayRecord.sale.orderNumber) {
-                        // Print previous order subtotal if not first order for this customer
-                        if (currentOrderNumber != -1) {
-                            WriteToReport(txtFile, "%90s%12.2f\n", "Subtotal", orderSubtotal);
+            // Inner loop: traverse list and compare adjacent nodes
+            for (innerIndex = 0; innerIndex < metadata.nodeCount - outerIndex - 1 && errorOccurred == 0; innerIndex++) {
+                // Read current node header and data
+                if (CountedSeek(listFile, currentOffset, SEEK_SET) == 0) {
+                    if (CountedRead(&node1Header, sizeof(DoublyLinkedNodeHeader), 1, listFile) == 1) {
+                        if (CountedRead(data1, recordSize, 1, listFile) == 1) {
+                            nextOffset = node1Header.nextOffset;
+                            
+                            // Read next node header and data (if exists)
+                            if (nextOffset != -1) {
+                                if (CountedSeek(listFile, nextOffset, SEEK_SET) == 0) {
+                                    if (CountedRead(&node2Header, sizeof(DoublyLinkedNodeHeader), 1, listFile) == 1) {
+                                        if (CountedRead(data2, recordSize, 1, listFile) == 1) {
+                                            // Compare the two nodes
+                                            comparisonResult = compareFunction(data1, data2);
+                                            CountComparisons(1);
+                                            
+                                            // If out of order, swap ONLY DATA (keep pointers unchanged)
+                                            // This is simpler, more efficient, and correct for bubble sort
+                                            if (comparisonResult > 0) {
+                                                // Write data2 to currentOffset (node1's position)
+                                                if (CountedSeek(listFile, currentOffset + sizeof(DoublyLinkedNodeHeader), SEEK_SET) == 0) {
+                                                    if (CountedWrite(data2, recordSize, 1, listFile) == 1) {
+                                                        // Write data1 to nextOffset (node2's position)
+                                                        if (CountedSeek(listFile, nextOffset + sizeof(DoublyLinkedNodeHeader), SEEK_SET) == 0) {
+                                                            if (CountedWrite(data1, recordSize, 1, listFile) == 1) {
+                                                                swapOccurred = 1;  // Mark that swap occurred
+                                                            } else {
+                                                                errorOccurred = 1;
+                                                            }
+                                                        } else {
+                                                            errorOccurred = 1;
+                                                        }
+                                                    } else {
+                                                        errorOccurred = 1;
+                                                    }
+                                                } else {
+                                                    errorOccurred = 1;
+                                                }
+                                            }
+                                            
+                                            // Move to next node (simply advance, no re-read needed)
+                                            currentOffset = nextOffset;
+                                        } else {
+                                            errorOccurred = 1;
+                                        }
+                                    } else {
+                                        errorOccurred = 1;
+                                    }
+                                } else {
+                                    errorOccurred = 1;
+                                }
+                            }
+                        } else {
+                            errorOccurred = 1;
                         }
-                        
-                        // New order
-                        currentOrderNumber = displayRecord.sale.orderNumber;
-                        orderSubtotal = 0.0;
-                        
-                        WriteToReport(txtFile, "Order date:  %04u/%02u/%02u   Order Number: %ld\n", 
-                               displayRecord.sale.orderDate.yearValue,
-                               displayRecord.sale.orderDate.monthOfYear,
-                               displayRecord.sale.orderDate.dayOfMonth,
-                               currentOrderNumber);
-                        WriteToReport(txtFile, "  ProductKey       ProductName%52sQuantity%8sValue USD\n", "", "");
-                    }
-                    
-                    // Calculate line value
-                    if (productFound == 1) {
-                        // Get unit price from product
-                        double unitPrice = currentProduct.unitPriceUSD;
-                        
-                        // Get currency code from sale transaction
-                        const char* currency = displayRecord.sale.currencyCode;
-                        
-                        // Get transaction date
-                        const dateStructure* date = &displayRecord.sale.orderDate;
-                        
-                        // Convert to USD using exchange rate for the transaction date
-                        double priceInUSD = ConvertCurrencyToUSD(unitPrice, currency, date);
-                        
-                        // Calculate line value with quantity and apply rounding
-                        lineValue = RoundToThirdDecimal(priceInUSD * displayRecord.sale.quantity);
-                        
-                        // Print line item
-                        WriteToReport(txtFile, "%11u%18s%-51s%8u%15.2f\n",
-                               displayRecord.sale.productKey,
-                               "",
-                               currentProduct.productName,
-                               displayRecord.sale.quantity,
-                               lineValue);
-                        
-                        // Accumulate totals
-                        orderSubtotal += lineValue;
-                        customerTotal += lineValue;
-                        grandTotal += lineValue;
                     } else {
-                        WriteToReport(txtFile, "%11u%18s%-51s%8u%15s\n",
-                               displayRecord.sale.productKey,
-                               "",
-                               "[Product Not Found]",
-                               displayRecord.sale.quantity,
-                               "N/A");
+                        errorOccurred = 1;
                     }
-                    
-                    displayedRecords++;  // Increment displayed records counter
+                } else {
+                    errorOccurred = 1;
                 }
             }
             
-            // Print last order subtotal and customer total
-            if (currentOrderNumber != -1) {
-                WriteToReport(txtFile, "%90s%12.2f\n", "Subtotal", orderSubtotal);
-            }
-            
-            if (firstRecord == 0) {
-                WriteToReport(txtFile, "%90s%12s\n", "TOTAL", "");
-                WriteToReport(txtFile, "%102.2f\n", customerTotal);
-                WriteToReport(txtFile, "----------------------------------------------------------------------------------------------------------------------\n");
-            }
-            
-            // Print grand total
-            WriteToReport(txtFile, "\n");
-            WriteToReport(txtFile, "\nTotal records in report: %d\n", recordCount);
-            
-            if (maxDisplayRecords > 0 && totalRecordsInFile > maxDisplayRecords) {
-                WriteToReport(txtFile, "(Showing %d of %ld total records)\n", actualLimit, totalRecordsInFile);
-            }
-            
-            fclose(sortedFile);
-            fclose(productsFile);
-            
-            GenerateReportFooter(txtFile, startTime);
-            
-            // Close text report file
-            if (txtFile != NULL) {
-                fclose(txtFile);
-                txtFile = NULL;
-            }
-            
-            // Success message
-            printf("\nReporte guardado exitosamente en: %s\n", txtFileName);
-            
-            // Ask user if they want to search for specific customers
-            printf("\nDo you want to search for specific customers in this report? (y/n): ");
-            char searchChoice = 'n';
-            scanf(" %c", &searchChoice);
-            
-            if (searchChoice == 'y' || searchChoice == 'Y') {
-                SearchInReport5(sortedFileName);
-            }
-            
-            // Clean up sorted .dat file after search is done
-            remove(sortedFileName);
-        } else {
-            printf("Error: Cannot open sorted report file or products file\n");
-            if (txtFile != NULL) {
-                fclose(txtFile);
-            }
-            if (sortedFile != NULL) {
-                fclose(sortedFile);
-            }
-            if (productsFile != NULL) {
-                fclose(productsFile);
+            // If no swaps occurred, list is sorted (early termination without break)
+            if (swapOccurred == 0) {
+                sortComplete = 1;
             }
-            remove(txtFileName);  // Remove incomplete report
         }
-    } else {
-        // Error occurred - clean up text file if opened
-        if (txtFile != NULL) {
-            fclose(txtFile);
-            remove(txtFileName);  // Remove incomplete report
+    }
+    
+    // Cleanup list file
+    if (listFile != NULL) {
+        fclose(listFile);
+    }
+    
+    // Step 3: Convert sorted linked list back to regular file
+    if (errorOccurred == 0 && nodesCreated > 1) {
+        recordsConverted = ConvertLinkedListToFile(linkedListFileName, outputFileName);
+        if (recordsConverted > 0) {
+            returnValue = (int)recordsConverted;
+            printf("Bubble sort completed: %ld records sorted\n", recordsConverted);
+        } else {
+            returnValue = -1;
         }
     }
     
-    // No explicit return needed for void function - single implicit return point
-}//end function definition GenerateReport5CustomerSalesListing
+    // Cleanup
+    if (data1 != NULL) {
+        free(data1);
+    }
+    if (data2 != NULL) {
+        free(data2);
+    }
+    remove(linkedListFileName);                        // Delete temporary file
+    
+    return returnValue;                                // Single return point
+}//end function definition SortBubble
 
-// ====================== MAIN ALGORITHMS ======================
+//opcion 2
+/*
+ * Function: GenerateReportHeader
+ * Purpose: Generates standardized header for all reports with company info and timestamp
+ * Parameters: txtFile - FILE pointer to report text file (can be NULL for console-only)
+ *            reportTitle - specific title for this report
+ * Returns: void
+ * Note: Echoed to the console in summary and full echo modes
+ */
+void GenerateReportHeader(FILE* txtFile, const char* reportTitle) {
+    ClearOutput();
+    time_t currentTime;                    // Current system time for timestamp
+    struct tm *localTime;                  // Local time structure for formatting
+    char timeBuffer[40];                   // Buffer to store formatted time string
+    
+    time(&currentTime);
+    localTime = localtime(&currentTime);
+    strftime(timeBuffer, sizeof(timeBuffer), "Valid to %Y-%m-%d at %H:%M hours\n", localTime);
+    
+    WriteReportSummary(txtFile, "------------------------------------------------------------------------------------------------------------------------\n");
+    WriteReportSummary(txtFile, "Company Global Electronics Retailer\n");
+    WriteReportSummary(txtFile, "%s", timeBuffer);
+    WriteReportSummary(txtFile, "%s\n", reportTitle);
+    WriteReportSummary(txtFile, "------------------------------------------------------------------------------------------------------------------------\n");
+}//end function definition GenerateReportHeader
 
 /*
- * Function: SearchBinary
- * Purpose: Performs binary search on sorted file-based data without loading into memory
- * Parameters: fileName - name of sorted binary file to search
- *            searchKey - pointer to the record to search for
- *            recordSize - size of each record in bytes
- *            compareFunction - pointer to comparison function
- *            resultPosition - pointer to store the position if found
- * Returns: int - 1 if found, 0 if not found, -1 if error
- * Note: Requires data to be sorted first, uses file-based approach for large datasets
- *       Complies with restrictions: no break, single return, file-based operations
+ * Function: GenerateReportFooter
+ * Purpose: Generates standardized footer for all reports with execution time
+ * Parameters: txtFile - FILE pointer to report text file (can be NULL for console-only)
+ *            startTime - time_t when report processing started
+ * Returns: void
+ * Note: Calculates and displays execution time in minutes and seconds, followed
+ *       by the per-phase times and I/O counters of the report.
+ *       Flushes the buffered report file and console output, then writes the
+ *       JSON metrics sidecar when enabled.
  */
-int SearchBinary(const char* fileName, const void* searchKey, size_t recordSize,
-                 int (*compareFunction)(const void*, const void*), long* resultPosition) {
-    FILE* binaryFile = NULL;                           // File pointer for binary search
-    void* currentRecord = NULL;                        // Buffer for current record being compared
-    long totalRecords = 0;                             // Total number of records in file
-    long leftBound = 0;                                // Left boundary for binary search
-    long rightBound = 0;                               // Right boundary for binary search
-    long middlePosition = 0;                           // Middle position for binary search
-    int comparisonResult = 0;                          // Result of record comparison
-    long fileSize = 0;                                 // Size of the file in bytes
-    int errorOccurred = 0;                             // Error flag
-    int found = 0;                                     // Found flag
-    int searchComplete = 0;                            // Search completion flag
-    int returnValue = -1;                              // Return value (single return pattern)
+void GenerateReportFooter(FILE* txtFile, time_t startTime) {
+    time_t endTime;                        // End time for execution time calculation
+    double elapsedTime;                    // Total elapsed time in seconds
+    int executionMinutes;                  // Minutes portion of execution time
+    int executionSeconds;                  // Seconds portion of execution time
+    long long totalNanoseconds;            // Monotonic time since the report started
     
-    // Initialize result position to -1 (not found)
-    if (resultPosition != NULL) {
-        *resultPosition = -1;
+    StopMetricPhase(METRIC_PHASE_RENDER);
+    totalNanoseconds = ReadMonotonicNanoseconds() - metrics.reportStart;
+    
+    time(&endTime);
+    elapsedTime = difftime(endTime, startTime);
+    executionMinutes = (int)(elapsedTime / 60);
+    executionSeconds = (int)(elapsedTime) % 60;
+    
+    WriteReportSummary(txtFile, "------------------------------------------------------------------------------------------------------------------------\n");
+    WriteReportSummary(txtFile, "Time used to produce this listing: %d'%d\"\n", executionMinutes, executionSeconds);
+    WriteReportSummary(txtFile, "Phase times (ms): join %.3f, sort %.3f, aggregate %.3f, render %.3f, total %.3f\n",
+                       metrics.phaseNanoseconds[METRIC_PHASE_JOIN] / 1e6, metrics.phaseNanoseconds[METRIC_PHASE_SORT] / 1e6,
+                       metrics.phaseNanoseconds[METRIC_PHASE_AGGREGATE] / 1e6, metrics.phaseNanoseconds[METRIC_PHASE_RENDER] / 1e6,
+                       totalNanoseconds / 1e6);
+    WriteReportSummary(txtFile, "I/O counters: %lld records read, %lld bytes read, %lld bytes written, %lld seeks, %lld comparisons\n",
+                       metrics.recordsRead, metrics.bytesRead, (long long)metrics.bytesWritten, metrics.seekCalls,
+                       (long long)metrics.comparisons);
+    WriteReportSummary(txtFile, "***************************LAST LINE OF THE REPORT***************************\n");
+    WriteReportSummary(txtFile, "------------------------------------------------------------------------------------------------------------------------\n");
+    
+    // Single flush for the whole report
+    if (txtFile != NULL) {
+        fflush(txtFile);
     }
+    fflush(stdout);
     
-    // Open binary file for reading
-    binaryFile = OpenFileWithErrorCheck(fileName, "rb");
-    if (binaryFile == NULL) {
-        printf("Error: Cannot open file %s for binary search\n", fileName);
-        errorOccurred = 1;
-        returnValue = -1;
+    if (metricsSidecarEnabled == 1) {
+        WriteMetricsSidecar(totalNanoseconds);
     }
+    return;
+}//end function definition GenerateReportFooter
+
+// ====================== CSV INGESTION ======================
+#define CSV_WRITE_BATCH_RECORDS 4096                  // Records buffered per binary table write
+#define SALES_CSV_CHUNK_BYTES (16L * 1024L * 1024L)   // Sales.csv bytes per parallel parse task
+
+/*
+ * Structure: salesChunkTask
+ * Purpose: Work item parsing one line-aligned byte range of Sales.csv
+ * Note: reader covers only the chunk; its lineNumber is set to the line before
+ *       the chunk so warnings report file line numbers
+ */
+typedef struct {
+    csvReader reader;                                  // Rows of the chunk
+    salesRecord* records;                              // Parsed records, in file order
+    int recordCapacity;                                // Room in records
+    int recordCount;                                   // Valid records parsed
+    int rowCount;                                      // Rows in the chunk
+} salesChunkTask;
+
+/*
+ * Structure: tableConversionTask
+ * Purpose: Work item converting one CSV file to its binary table
+ */
+typedef struct {
+    int (*converter)(csvReader*, FILE*);               // ConvertSalesCsvToBinary, ConvertCustomersCsvToBinary, ...
+    csvReader* csvFile;                                // Source CSV file
+    FILE* binaryFile;                                  // Binary table being written
+    int recordCount;                                   // Converter result (-1 on error)
+} tableConversionTask;
+
+/*
+ * Function: ConvertTableWorker
+ * Purpose: Thread entry point running one table conversion
+ * Parameters: parameter - tableConversionTask to run
+ * Returns: DWORD - always 0
+ */
+DWORD WINAPI ConvertTableWorker(LPVOID parameter) {
+    tableConversionTask* task = (tableConversionTask*)parameter;  // Conversion to run
     
-    // Calculate total number of records
-    if (errorOccurred == 0) {
-        fseek(binaryFile, 0, SEEK_END);
-        fileSize = ftell(binaryFile);
-        totalRecords = fileSize / recordSize;
-        fseek(binaryFile, 0, SEEK_SET);
-        
-        // Check if file has any records
-        if (totalRecords == 0) {
-            printf("Warning: File %s is empty\n", fileName);
-            returnValue = 0;                           // Not found (empty file)
-            searchComplete = 1;
-        }
+    task->recordCount = task->converter(task->csvFile, task->binaryFile);
+    
+    return 0;
+}//end function definition ConvertTableWorker
+
+
+/*
+ * Function: OpenCsvReader
+ * Purpose: Maps a CSV file for row-by-row reading
+ * Parameters: reader - reader to open
+ *            fileName - CSV file
+ * Returns: int - 1 if the file is open, 0 on error
+ * Note: An empty file opens successfully and has no rows
+ */
+int OpenCsvReader(csvReader* reader, const char* fileName) {
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    InitializeStructureToZero(reader, sizeof(csvReader));
+    if (OpenMappedTable(&reader->file, fileName, 1, TABLE_ACCESS_SEQUENTIAL) == 1) {
+        reader->position = (const char*)reader->file.records;
+        reader->end = reader->position + reader->file.fileSize;
+        metrics.bytesRead += reader->file.fileSize;
+        returnValue = 1;
     }
     
-    // Allocate memory for record buffer
-    if (errorOccurred == 0 && searchComplete == 0) {
-        currentRecord = malloc(recordSize);
-        if (currentRecord == NULL) {
-            printf("Error: Cannot allocate memory for binary search\n");
-            errorOccurred = 1;
-            returnValue = -1;
+    return returnValue;                                // Single return point
+}//end function definition OpenCsvReader
+
+/*
+ * Function: CloseCsvReader
+ * Purpose: Unmaps a CSV file
+ * Parameters: reader - reader to close (safe to call on a zeroed reader)
+ * Returns: void
+ */
+void CloseCsvReader(csvReader* reader) {
+    CloseMappedTable(&reader->file);
+    InitializeStructureToZero(reader, sizeof(csvReader));
+}//end function definition CloseCsvReader
+
+/*
+ * Function: FindCsvDelimiter
+ * Purpose: Finds the next ',', '\r' or '\n'
+ * Parameters: position - first character to examine
+ *            end - one past the last character
+ * Returns: const char* - the delimiter, or end if there is none
+ * Note: Compares 16 characters at a time with SSE2 where available; the tail
+ *       and other targets use a scalar loop
+ */
+const char* FindCsvDelimiter(const char* position, const char* end) {
+    const char* found = NULL;                          // Delimiter position (single return pattern)
+    
+#ifdef CSV_SCAN_SSE2
+    const __m128i commas = _mm_set1_epi8(',');         // Field separators
+    const __m128i newlines = _mm_set1_epi8('\n');      // Row separators
+    const __m128i returns = _mm_set1_epi8('\r');       // Row separators of CRLF files
+    __m128i block;                                     // 16 characters being examined
+    int delimiterMask = 0;                             // Bit i set if position[i] is a delimiter
+    int bitOffset = 0;                                 // Lowest set bit of delimiterMask
+    
+    while (found == NULL && end - position >= 16) {
+        block = _mm_loadu_si128((const __m128i*)position);
+        delimiterMask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, commas),
+                                                       _mm_or_si128(_mm_cmpeq_epi8(block, newlines),
+                                                                    _mm_cmpeq_epi8(block, returns))));
+        if (delimiterMask != 0) {
+            bitOffset = 0;
+            while (((delimiterMask >> bitOffset) & 1) == 0) {
+                bitOffset++;
+            }
+            found = position + bitOffset;
+        } else {
+            position += 16;
         }
     }
+#endif
     
-    // Initialize binary search bounds
-    if (errorOccurred == 0 && searchComplete == 0) {
-        leftBound = 0;
-        rightBound = totalRecords - 1;
+    while (found == NULL && position < end) {
+        if (*position == ',' || *position == '\n' || *position == '\r') {
+            found = position;
+        } else {
+            position++;
+        }
     }
     
-    // Perform binary search
-    while (errorOccurred == 0 && searchComplete == 0 && found == 0 && leftBound <= rightBound) {
-        // Calculate middle position
-        middlePosition = leftBound + (rightBound - leftBound) / 2;
-        
-        // Read record at middle position
-        fseek(binaryFile, middlePosition * recordSize, SEEK_SET);
-        if (fread(currentRecord, recordSize, 1, binaryFile) != 1) {
-            printf("Error: Cannot read record at position %ld\n", middlePosition);
-            errorOccurred = 1;
-            returnValue = -1;
-        } else {
-            // Compare current record with search key
-            comparisonResult = compareFunction(searchKey, currentRecord);
-            
-            if (comparisonResult == 0) {
-                // Found exact match
-                if (resultPosition != NULL) {
-                    *resultPosition = middlePosition;
-                }
-                found = 1;
-                returnValue = 1;                       // Found
-            } else if (comparisonResult < 0) {
-                // Search key is smaller, search left half
-                rightBound = middlePosition - 1;
+    return (found != NULL) ? found : end;              // Single return point
+}//end function definition FindCsvDelimiter
+
+/*
+ * Function: ReadCsvRow
+ * Purpose: Splits the next row of a CSV file into fields
+ * Parameters: reader - open CSV reader
+ *            fields - receives up to maxFields fields
+ *            maxFields - number of columns expected
+ * Returns: int - number of fields found (at most maxFields), -1 at end of file
+ * Note: Fields end at ',' and the row at '\r' or '\n'. Quotes are not special.
+ *       Columns after the first maxFields are ignored, as in the original
+ *       line parser.
+ */
+int ReadCsvRow(csvReader* reader, csvField* fields, int maxFields) {
+    const char* fieldStart = reader->position;         // Start of the current field
+    const char* delimiter = NULL;                      // Delimiter ending the current field
+    const char* rowEnd = NULL;                         // '\n' ending the row
+    int rowFinished = 0;                               // 1 once '\r', '\n' or end of file is reached
+    int fieldCount = -1;                               // Return value (single return pattern)
+    
+    if (reader->position < reader->end) {
+        reader->lineNumber++;
+        fieldCount = 0;
+        while (rowFinished == 0 && fieldCount < maxFields) {
+            delimiter = FindCsvDelimiter(fieldStart, reader->end);
+            fields[fieldCount].start = fieldStart;
+            fields[fieldCount].length = (int)(delimiter - fieldStart);
+            fieldCount++;
+            if (delimiter < reader->end && *delimiter == ',') {
+                fieldStart = delimiter + 1;
             } else {
-                // Search key is larger, search right half
-                leftBound = middlePosition + 1;
+                rowFinished = 1;
             }
         }
+        
+        // Skip the rest of the row, including any ignored columns
+        rowEnd = (const char*)memchr(fieldStart, '\n', (size_t)(reader->end - fieldStart));
+        reader->position = (rowEnd != NULL) ? rowEnd + 1 : reader->end;
     }
     
-    // If search completed without finding or error, set not found
-    if (errorOccurred == 0 && found == 0 && searchComplete == 0) {
-        returnValue = 0;                               // Not found
-    }
+    return fieldCount;                                 // Single return point
+}//end function definition ReadCsvRow
+
+/*
+ * Function: CopyCsvField
+ * Purpose: Copies a field into a fixed-size record string
+ * Parameters: destination - zero-initialized record field
+ *            maxLength - most characters to copy (the field size minus one)
+ *            field - field to copy
+ * Returns: void
+ */
+void CopyCsvField(char* destination, int maxLength, const csvField* field) {
+    memcpy(destination, field->start, (size_t)((field->length < maxLength) ? field->length : maxLength));
+}//end function definition CopyCsvField
+
+/*
+ * Function: EncodeCsvField
+ * Purpose: Stores a field of a dictionary-encoded column as its code
+ * Parameters: code - record field receiving the code
+ *            maxLength - most characters kept (as CopyCsvField)
+ *            tableId - BINARY_TABLE_* id of the table being converted
+ *            column - encoded column (CUSTOMER_DICTIONARY_* or PRODUCT_DICTIONARY_*)
+ *            field - field to encode
+ * Returns: int - 1 on success, 0 if the value cannot be added to the dictionary
+ */
+int EncodeCsvField(dictionaryCode* code, int maxLength, int tableId, int column, const csvField* field) {
+    char fieldText[DICTIONARY_VALUE_LENGTH] = {0};     // Terminated copy of the field
     
-    // Cleanup
-    if (currentRecord != NULL) {
-        free(currentRecord);
-    }
-    if (binaryFile != NULL) {
-        fclose(binaryFile);
-    }
+    CopyCsvField(fieldText, (maxLength < DICTIONARY_VALUE_LENGTH - 1) ? maxLength : DICTIONARY_VALUE_LENGTH - 1, field);
     
-    return returnValue;                                // Single return point
-}//end function definition SearchBinary
+    return EncodeDictionaryValue(tableId, column, fieldText, code);
+}//end function definition EncodeCsvField
 
 /*
- * Function: SearchBinaryRange
- * Purpose: Finds all records matching a search criteria in a sorted file
- * Parameters: fileName - name of sorted binary file to search
- *            searchKey - pointer to the record to search for
- *            recordSize - size of each record in bytes
- *            compareFunction - pointer to comparison function
- *            startPosition - pointer to store the first matching position
- *            endPosition - pointer to store the last matching position
- * Returns: int - number of matching records found, -1 if error
- * Note: Useful for finding all records with the same key value
- *       Complies with restrictions: no break, single return, file-based operations
+ * Function: ParseCsvUnsigned
+ * Purpose: Parses a decimal integer field without sscanf
+ * Parameters: field - field to parse
+ *            parsedValue - receives the value
+ * Returns: int - 1 if the field starts with a number, 0 otherwise
+ * Note: Leading spaces are skipped and parsing stops at the first non-digit,
+ *       like sscanf "%u"
  */
-int SearchBinaryRange(const char* fileName, const void* searchKey, size_t recordSize,
-                      int (*compareFunction)(const void*, const void*), 
-                      long* startPosition, long* endPosition) {
-    long firstMatch = -1;                              // Position of first match
-    int searchResult = 0;                              // Result of initial search
-    FILE* binaryFile = NULL;                           // File pointer for range search
-    void* currentRecord = NULL;                        // Buffer for current record
-    long totalRecords = 0;                             // Total number of records in file
-    long fileSize = 0;                                 // Size of the file in bytes
-    long checkPosition = 0;                            // Position to check for range expansion
-    int comparisonResult = 0;                          // Result of record comparison
-    int matchCount = 0;                                // Number of matching records found
-    long rangeStart = 0;                               // Start of matching range
-    long rangeEnd = 0;                                 // End of matching range
-    int errorOccurred = 0;                             // Error flag
-    int continueSearchLeft = 1;                        // Continue left expansion flag
-    int continueSearchRight = 1;                       // Continue right expansion flag
-    int readSuccess = 0;                               // Read operation success flag
-    int returnValue = -1;                              // Return value (single return pattern)
+int ParseCsvUnsigned(const csvField* field, unsigned long* parsedValue) {
+    const char* position = field->start;               // Current character
+    const char* fieldEnd = field->start + field->length;  // End of the field
+    unsigned long value = 0;                           // Accumulated value
+    int digitCount = 0;                                // Digits parsed
     
-    // Initialize result positions
-    if (startPosition != NULL) {
-        *startPosition = -1;
+    while (position < fieldEnd && *position == ' ') {
+        position++;
     }
-    if (endPosition != NULL) {
-        *endPosition = -1;
+    while (position < fieldEnd && *position >= '0' && *position <= '9') {
+        value = value * 10 + (unsigned long)(*position - '0');
+        digitCount++;
+        position++;
     }
+    *parsedValue = value;
     
-    // First, find any occurrence of the search key
-    searchResult = SearchBinary(fileName, searchKey, recordSize, compareFunction, &firstMatch);
+    return (digitCount > 0) ? 1 : 0;                   // Single return point
+}//end function definition ParseCsvUnsigned
+
+/*
+ * Function: ParseCsvDate
+ * Purpose: Parses an M/D/YYYY field without sscanf
+ * Parameters: field - field to parse
+ *            parsedDate - receives the date (zeroed if the field is invalid)
+ * Returns: int - 1 if the field is a valid date, 0 otherwise
+ * Note: Applies the same range checks as ParseDateFromCsv
+ */
+int ParseCsvDate(const csvField* field, dateStructure* parsedDate) {
+    const char* position = field->start;               // Current character
+    const char* fieldEnd = field->start + field->length;  // End of the field
+    int dateParts[3] = {0, 0, 0};                      // Month, day and year
+    int digitCount = 0;                                // Digits in the current part
+    int partIndex = 0;                                 // Part being parsed
+    int isValid = 1;                                   // Syntax flag
     
-    if (searchResult != 1) {
-        returnValue = searchResult;                    // Return 0 if not found, -1 if error
-    } else {
-        // Open file for range expansion
-        binaryFile = OpenFileWithErrorCheck(fileName, "rb");
-        if (binaryFile == NULL) {
-            errorOccurred = 1;
-            returnValue = -1;
-        }
-    }
+    parsedDate->monthOfYear = 0;
+    parsedDate->dayOfMonth = 0;
+    parsedDate->yearValue = 0;
     
-    // Calculate total records
-    if (errorOccurred == 0 && searchResult == 1) {
-        fseek(binaryFile, 0, SEEK_END);
-        fileSize = ftell(binaryFile);
-        totalRecords = fileSize / recordSize;
-        
-        // Allocate memory for record buffer
-        currentRecord = malloc(recordSize);
-        if (currentRecord == NULL) {
-            errorOccurred = 1;
-            returnValue = -1;
-        }
+    while (position < fieldEnd && *position == ' ') {
+        position++;
     }
-    
-    // Find the start of the range (first matching record)
-    if (errorOccurred == 0 && searchResult == 1) {
-        rangeStart = firstMatch;
-        checkPosition = firstMatch - 1;
-        
-        while (checkPosition >= 0 && continueSearchLeft == 1 && errorOccurred == 0) {
-            fseek(binaryFile, checkPosition * recordSize, SEEK_SET);
-            readSuccess = (fread(currentRecord, recordSize, 1, binaryFile) == 1);
-            
-            if (readSuccess == 0) {
-                continueSearchLeft = 0;                // Stop left expansion on read error
-            } else {
-                comparisonResult = compareFunction(searchKey, currentRecord);
-                if (comparisonResult == 0) {
-                    rangeStart = checkPosition;
-                    checkPosition--;
-                } else {
-                    continueSearchLeft = 0;            // Stop when no longer matching
-                }
-            }
+    for (partIndex = 0; partIndex < 3 && isValid == 1; partIndex++) {
+        digitCount = 0;
+        while (position < fieldEnd && *position >= '0' && *position <= '9' && digitCount < 9) {
+            dateParts[partIndex] = dateParts[partIndex] * 10 + (*position - '0');
+            digitCount++;
+            position++;
         }
-    }
-    
-    // Find the end of the range (last matching record)
-    if (errorOccurred == 0 && searchResult == 1) {
-        rangeEnd = firstMatch;
-        checkPosition = firstMatch + 1;
-        
-        while (checkPosition < totalRecords && continueSearchRight == 1 && errorOccurred == 0) {
-            fseek(binaryFile, checkPosition * recordSize, SEEK_SET);
-            readSuccess = (fread(currentRecord, recordSize, 1, binaryFile) == 1);
-            
-            if (readSuccess == 0) {
-                continueSearchRight = 0;               // Stop right expansion on read error
+        if (digitCount == 0) {
+            isValid = 0;
+        } else if (partIndex < 2) {
+            if (position < fieldEnd && *position == '/') {
+                position++;
             } else {
-                comparisonResult = compareFunction(searchKey, currentRecord);
-                if (comparisonResult == 0) {
-                    rangeEnd = checkPosition;
-                    checkPosition++;
-                } else {
-                    continueSearchRight = 0;           // Stop when no longer matching
-                }
+                isValid = 0;
             }
         }
     }
     
-    // Set result positions and calculate match count
-    if (errorOccurred == 0 && searchResult == 1) {
-        if (startPosition != NULL) {
-            *startPosition = rangeStart;
-        }
-        if (endPosition != NULL) {
-            *endPosition = rangeEnd;
-        }
-        
-        matchCount = (int)(rangeEnd - rangeStart + 1);
-        returnValue = matchCount;
-    }
-    
-    // Cleanup
-    if (currentRecord != NULL) {
-        free(currentRecord);
-    }
-    if (binaryFile != NULL) {
-        fclose(binaryFile);
+    if (isValid == 1) {
+        isValid = StoreCalendarDate(dateParts[0], dateParts[1], dateParts[2], parsedDate);
     }
     
-    return returnValue;                                // Single return point
-}//end function definition SearchBinaryRange
+    return isValid;                                    // Single return point
+}//end function definition ParseCsvDate
 
 /*
- * Function: SortMerge
- * Purpose: Sorts records using merge sort algorithm with file-based doubly linked list
- * Parameters: inputFileName - source binary file with unsorted records
- *            outputFileName - destination file for sorted records
- *            recordSize - size of each record in bytes
- *            compareFunction - function pointer for comparing two records
- * Returns: int - number of records sorted, -1 on error
- * Note: Uses doubly linked list structure with O(n log n) complexity
- *       Complies with restrictions: no break, single return, file-based (no RAM loading)
- *       More efficient than bubble sort for large datasets
+ * Function: ParseCsvDayNumber
+ * Purpose: Parses a M/D/YYYY CSV field straight to a day number
+ * Parameters: field - field to parse
+ *            dayNumber - receives the day number (DAY_NUMBER_NONE if the field is invalid)
+ * Returns: int - 1 if the field is a valid date, 0 otherwise
+ * Note: Dates are converted once here so scans compare and subtract plain integers
  */
-int SortMerge(const char* inputFileName, const char* outputFileName, size_t recordSize,
-              int (*compareFunction)(const void*, const void*)) {
-    char linkedListFileName[300] = {0};                // Temp linked list file name
-    FILE* listFile = NULL;                             // Linked list file pointer
-    LinkedListFileMetadata metadata;                   // List metadata
-    long nodesCreated = 0;                             // Result of list creation
-    long sortedHeadOffset = -1;                        // Sorted list head offset
-    long sortedTailOffset = -1;                        // Sorted list tail offset
-    int sortSuccess = 0;                               // Sort operation success flag
-    long recordsConverted = 0;                         // Final conversion result
-    int errorOccurred = 0;                             // Error flag
-    int returnValue = -1;                              // Return value (single return pattern)
-    
-    // Generate temp linked list file name
-    sprintf(linkedListFileName, "temp_merge_list_%ld.dat", (long)time(NULL));
-    
-    // Step 1: Convert input file to linked list structure
-    printf("Converting file to linked list structure...\n");
-    nodesCreated = CreateLinkedListFromFile(inputFileName, linkedListFileName, recordSize);
-    printf("Created %ld nodes in linked list\n", nodesCreated);
-    
-    if (nodesCreated <= 0) {
-        errorOccurred = 1;
-        returnValue = -1;
-    } else if (nodesCreated == 1) {
-        // Single record, already sorted - just convert back
-        recordsConverted = ConvertLinkedListToFile(linkedListFileName, outputFileName);
-        remove(linkedListFileName);
-        returnValue = (int)recordsConverted;
-    }
+int ParseCsvDayNumber(const csvField* field, int* dayNumber) {
+    dateStructure parsedDate;                          // Calendar date of the field
+    int isValid = 0;                                   // Return value (single return pattern)
     
-    // Step 2: Perform merge sort on linked list
-    if (errorOccurred == 0 && nodesCreated > 1) {
-        // Open linked list file for sorting
-        listFile = OpenFileWithErrorCheck(linkedListFileName, "rb+");
-        if (listFile == NULL) {
-            errorOccurred = 1;
-            returnValue = -1;
-        }
+    *dayNumber = DAY_NUMBER_NONE;
+    if (ParseCsvDate(field, &parsedDate) == 1) {
+        *dayNumber = DateToDayNumber(&parsedDate);
+        isValid = 1;
     }
     
-    if (errorOccurred == 0 && nodesCreated > 1) {
-        // Read metadata
-        if (fread(&metadata, sizeof(LinkedListFileMetadata), 1, listFile) != 1) {
-            errorOccurred = 1;
-            returnValue = -1;
-        }
+    return isValid;                                    // Single return point
+}//end function definition ParseCsvDayNumber
+
+/*
+ * Function: ParseCsvDecimal
+ * Purpose: Parses a decimal number or "$6.62 "-style currency field without sscanf
+ * Parameters: field - field to parse
+ *            isCurrency - 1 to accept a leading '$' as in the product prices
+ *            parsedValue - receives the value
+ * Returns: int - 1 if successful, 0 if parsing failed
+ * Note: Plain numbers of up to 15 digits are computed as digits / 10^fraction
+ *       digits, which rounds exactly as strtod does. Anything else (exponents,
+ *       thousands separators, more digits) falls back to sscanf "%lf" or
+ *       ParseCurrencyFromCsv, so results always match the original parsers.
+ */
+int ParseCsvDecimal(const csvField* field, int isCurrency, double* parsedValue) {
+    static const double powersOfTen[16] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                           1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+    const char* position = field->start;               // Current character
+    const char* fieldEnd = field->start + field->length;  // End of the field
+    char fieldCopy[100] = {0};                         // NUL-terminated copy for the fallback parsers
+    unsigned long long digits = 0;                     // Value without the decimal point
+    int digitCount = 0;                                // Digits parsed
+    int fractionDigits = 0;                            // Digits after the decimal point
+    int pointSeen = 0;                                 // 1 after the decimal point
+    int fastPath = 1;                                  // 0 once the field needs the fallback parser
+    int isValid = 0;                                   // Return value (single return pattern)
+    
+    while (position < fieldEnd && (*position == ' ' || (isCurrency == 1 && *position == '$'))) {
+        position++;
     }
-    
-    if (errorOccurred == 0 && nodesCreated > 1) {
-        // Perform ITERATIVE merge sort on the linked list (no stack overflow risk)
-        printf("Starting iterative merge sort on %ld nodes...\n", nodesCreated);
-        sortSuccess = MergeSortLinkedListIterative(listFile, metadata.headOffset, metadata.nodeCount,
-                                                   recordSize, compareFunction, 
-                                                   &sortedHeadOffset, &sortedTailOffset);
-        printf("Merge sort iterative completed with status: %d\n", sortSuccess);
-        
-        if (sortSuccess == 1 && sortedHeadOffset != -1) {
-            // Update metadata with sorted list pointers
-            metadata.headOffset = sortedHeadOffset;
-            metadata.tailOffset = sortedTailOffset;
-            
-            // Write updated metadata back to file
-            fseek(listFile, 0, SEEK_SET);
-            fwrite(&metadata, sizeof(LinkedListFileMetadata), 1, listFile);
+    while (position < fieldEnd && fastPath == 1 &&
+           *position != ' ' && *position != '\t' && *position != '\r' && *position != '\n') {
+        if (*position >= '0' && *position <= '9' && digitCount < 15) {
+            digits = digits * 10 + (unsigned long long)(*position - '0');
+            digitCount++;
+            fractionDigits += pointSeen;
+        } else if (*position == '.' && pointSeen == 0) {
+            pointSeen = 1;
         } else {
-            errorOccurred = 1;
-            returnValue = -1;
+            fastPath = 0;
         }
+        position++;
     }
     
-    // Cleanup list file
-    if (listFile != NULL) {
-        fclose(listFile);
-    }
-    
-    // Step 3: Convert sorted linked list back to regular file
-    if (errorOccurred == 0 && nodesCreated > 1) {
-        recordsConverted = ConvertLinkedListToFile(linkedListFileName, outputFileName);
-        if (recordsConverted > 0) {
-            returnValue = (int)recordsConverted;
-            printf("Merge sort completed: %ld records sorted\n", recordsConverted);
+    if (fastPath == 1 && digitCount > 0) {
+        *parsedValue = (double)digits / powersOfTen[fractionDigits];
+        isValid = 1;
+    } else {
+        CopyCsvField(fieldCopy, (int)sizeof(fieldCopy) - 1, field);
+        if (isCurrency == 1) {
+            isValid = ParseCurrencyFromCsv(fieldCopy, parsedValue);
         } else {
-            returnValue = -1;
+            isValid = (sscanf(fieldCopy, "%lf", parsedValue) == 1) ? 1 : 0;
         }
     }
     
-    // Cleanup
-    remove(linkedListFileName);                        // Delete temporary file
-    
-    return returnValue;                                // Single return point
-}//end function definition SortMerge
+    return isValid;                                    // Single return point
+}//end function definition ParseCsvDecimal
 
 /*
- * Function: SortBubble
- * Purpose: Sorts file-based records using bubble sort algorithm (O(n²))
- * Parameters: inputFileName - name of input binary file to sort
- *            outputFileName - name of output file for sorted data
+ * Function: FlushRecordBatch
+ * Purpose: Writes the buffered records of a table conversion in one call
+ * Parameters: binaryFilePointer - binary table file
+ *            records - buffered records
  *            recordSize - size of each record in bytes
- *            compareFunction - pointer to comparison function
- * Returns: int - number of records sorted, -1 if error
- * Note: Simple but less efficient algorithm, works entirely with files
+ *            batchCount - pointer to the number of buffered records (reset to 0)
+ * Returns: int - 1 if every record was written, 0 on error
  */
+int FlushRecordBatch(FILE* binaryFilePointer, const void* records, size_t recordSize, int* batchCount) {
+    int returnValue = 1;                               // Return value (single return pattern)
+    
+    if (*batchCount > 0 &&
+        CountedWrite(records, recordSize, (size_t)*batchCount, binaryFilePointer) != (size_t)*batchCount) {
+        returnValue = 0;
+    }
+    *batchCount = 0;
+    
+    return returnValue;                                // Single return point
+}//end function definition FlushRecordBatch
+
 /*
- * Function: SortBubble
- * Purpose: Sorts records using bubble sort algorithm with file-based doubly linked list
- * Parameters: inputFileName - source binary file with unsorted records
- *            outputFileName - destination file for sorted records
- *            recordSize - size of each record in bytes
- *            compareFunction - function pointer for comparing two records
- * Returns: int - number of records sorted, -1 on error
- * Note: Uses doubly linked list structure stored in file to minimize I/O operations
- *       Complies with restrictions: no break, single return, file-based (no RAM loading)
- *       Time complexity: O(n²) comparisons but O(n) I/O operations
+ * Function: ParseSalesCsvRow
+ * Purpose: Validates one Sales.csv row and converts it to a salesRecord
+ * Parameters: csvFields - fields of the row
+ *            fieldCount - number of fields found
+ *            lineNumber - line number for warnings
+ *            currentRecord - record to fill (zeroed first)
+ * Returns: int - 1 if the row is valid, 0 if it must be skipped
+ * Note: Prints the same warnings as the original line-by-line converter
  */
-int SortBubble(const char* inputFileName, const char* outputFileName, size_t recordSize, 
-               int (*compareFunction)(const void*, const void*)) {
-    char linkedListFileName[300] = {0};                // Temp linked list file name
-    FILE* listFile = NULL;                             // Linked list file pointer
-    LinkedListFileMetadata metadata;                   // List metadata
-    DoublyLinkedNodeHeader node1Header;                // First node header
-    DoublyLinkedNodeHeader node2Header;                // Second node header
-    void* data1 = NULL;                                // First node data buffer
-    void* data2 = NULL;                                // Second node data buffer
-    long nodesCreated = 0;                             // Result of list creation
-    long outerIndex = 0;                               // Outer loop counter
-    long innerIndex = 0;                               // Inner loop counter
-    long currentOffset = 0;                            // Current node offset
-    long nextOffset = 0;                               // Next node offset
-    int swapOccurred = 0;                              // Flag for swaps in pass
-    int comparisonResult = 0;                          // Result of comparison
-    int errorOccurred = 0;                             // Error flag
-    int sortComplete = 0;                              // Flag for early termination
-    long recordsConverted = 0;                         // Final conversion result
-    int returnValue = -1;                              // Return value (single return pattern)
+int ParseSalesCsvRow(const csvField* csvFields, int fieldCount, int lineNumber, salesRecord* currentRecord) {
+    unsigned long parsedNumber = 0;                    // Parsed numeric field
+    char tempCurrencyCode[4] = {0};                    // Currency code being validated
+    int currencyLength = 0;                            // Length of tempCurrencyCode
+    int isValid = 1;                                   // Return value (single return pattern)
     
-    // Generate temp linked list file name
-    sprintf(linkedListFileName, "temp_bubble_list_%ld.dat", (long)time(NULL));
+    // Initialize record to zero to prevent garbage data
+    InitializeStructureToZero(currentRecord, sizeof(salesRecord));
     
-    // Step 1: Convert input file to linked list structure
-    nodesCreated = CreateLinkedListFromFile(inputFileName, linkedListFileName, recordSize);
+    // Validate that we got exactly 9 fields
+    if (fieldCount != 9) {
+        printf("Warning: Line %d in Sales.csv has invalid format (got %d fields), skipping\n", lineNumber, fieldCount);
+        isValid = 0;
+    }
     
-    if (nodesCreated <= 0) {
-        errorOccurred = 1;
-        returnValue = -1;
-    } else if (nodesCreated == 1) {
-        // Single record, already sorted - just convert back
-        recordsConverted = ConvertLinkedListToFile(linkedListFileName, outputFileName);
-        remove(linkedListFileName);
-        returnValue = (int)recordsConverted;
+    // Field 0: Order Number
+    if (isValid == 1) {
+        if (ParseCsvUnsigned(&csvFields[0], &parsedNumber) == 1) {
+            currentRecord->orderNumber = (long)parsedNumber;
+        } else {
+            printf("Warning: Line %d has invalid order number '%.*s', skipping\n", lineNumber, csvFields[0].length, csvFields[0].start);
+            isValid = 0;
+        }
     }
     
-    // Step 2: Perform bubble sort on linked list
-    if (errorOccurred == 0 && nodesCreated > 1) {
-        // Allocate data buffers
-        data1 = malloc(recordSize);
-        data2 = malloc(recordSize);
-        
-        if (data1 == NULL || data2 == NULL) {
-            errorOccurred = 1;
-            returnValue = -1;
+    // Field 1: Line Item
+    if (isValid == 1) {
+        if (ParseCsvUnsigned(&csvFields[1], &parsedNumber) == 1) {
+            currentRecord->lineItem = (unsigned char)parsedNumber;
+        } else {
+            printf("Warning: Line %d has invalid line item '%.*s', skipping\n", lineNumber, csvFields[1].length, csvFields[1].start);
+            isValid = 0;
         }
     }
     
-    if (errorOccurred == 0 && nodesCreated > 1) {
-        // Open linked list file for sorting
-        listFile = OpenFileWithErrorCheck(linkedListFileName, "rb+");
-        if (listFile == NULL) {
-            errorOccurred = 1;
-            returnValue = -1;
+    // Field 4: CustomerKey
+    if (isValid == 1) {
+        if (ParseCsvUnsigned(&csvFields[4], &parsedNumber) == 1) {
+            currentRecord->customerKey = (unsigned int)parsedNumber;
+        } else {
+            printf("Warning: Line %d has invalid customer key '%.*s', skipping\n", lineNumber, csvFields[4].length, csvFields[4].start);
+            isValid = 0;
+        }
+    }
+    
+    // Field 5: StoreKey
+    if (isValid == 1) {
+        if (ParseCsvUnsigned(&csvFields[5], &parsedNumber) == 1) {
+            currentRecord->storeKey = (unsigned short)parsedNumber;
+        } else {
+            printf("Warning: Line %d has invalid store key '%.*s', skipping\n", lineNumber, csvFields[5].length, csvFields[5].start);
+            isValid = 0;
         }
     }
     
-    if (errorOccurred == 0 && nodesCreated > 1) {
-        // Read metadata
-        if (fread(&metadata, sizeof(LinkedListFileMetadata), 1, listFile) != 1) {
-            errorOccurred = 1;
-            returnValue = -1;
+    // Field 6: ProductKey
+    if (isValid == 1) {
+        if (ParseCsvUnsigned(&csvFields[6], &parsedNumber) == 1) {
+            currentRecord->productKey = (unsigned short)parsedNumber;
+        } else {
+            printf("Warning: Line %d has invalid product key '%.*s', skipping\n", lineNumber, csvFields[6].length, csvFields[6].start);
+            isValid = 0;
         }
     }
     
-    if (errorOccurred == 0 && nodesCreated > 1) {
-        // Bubble sort: outer loop
-        printf("Starting bubble sort on %ld nodes...\n", nodesCreated);
-        for (outerIndex = 0; outerIndex < metadata.nodeCount - 1 && sortComplete == 0 && errorOccurred == 0; outerIndex++) {
-            swapOccurred = 0;                          // Reset swap flag for this pass
-            currentOffset = metadata.headOffset;       // Start from head
-            
-            // Print progress every 100 passes
-            if (outerIndex % 100 == 0 && outerIndex > 0) {
-                printf("Bubble sort progress: pass %ld/%ld (%.1f%%)\n", 
-                       outerIndex, metadata.nodeCount - 1, 
-                       (double)outerIndex * 100.0 / (metadata.nodeCount - 1));
-            }
-            
-            // Inner loop: traverse list and compare adjacent nodes
-            for (innerIndex = 0; innerIndex < metadata.nodeCount - outerIndex - 1 && errorOccurred == 0; innerIndex++) {
-                // Read current node header and data
-                if (fseek(listFile, currentOffset, SEEK_SET) == 0) {
-                    if (fread(&node1Header, sizeof(DoublyLinkedNodeHeader), 1, listFile) == 1) {
-                        if (fread(data1, recordSize, 1, listFile) == 1) {
-                            nextOffset = node1Header.nextOffset;
-                            
-                            // Read next node header and data (if exists)
-                            if (nextOffset != -1) {
-                                if (fseek(listFile, nextOffset, SEEK_SET) == 0) {
-                                    if (fread(&node2Header, sizeof(DoublyLinkedNodeHeader), 1, listFile) == 1) {
-                                        if (fread(data2, recordSize, 1, listFile) == 1) {
-                                            // Compare the two nodes
-                                            comparisonResult = compareFunction(data1, data2);
-                                            
-                                            // If out of order, swap ONLY DATA (keep pointers unchanged)
-                                            // This is simpler, more efficient, and correct for bubble sort
-                                            if (comparisonResult > 0) {
-                                                // Write data2 to currentOffset (node1's position)
-                                                if (fseek(listFile, currentOffset + sizeof(DoublyLinkedNodeHeader), SEEK_SET) == 0) {
-                                                    if (fwrite(data2, recordSize, 1, listFile) == 1) {
-                                                        // Write data1 to nextOffset (node2's position)
-                                                        if (fseek(listFile, nextOffset + sizeof(DoublyLinkedNodeHeader), SEEK_SET) == 0) {
-                                                            if (fwrite(data1, recordSize, 1, listFile) == 1) {
-                                                                swapOccurred = 1;  // Mark that swap occurred
-                                                            } else {
-                                                                errorOccurred = 1;
-                                                            }
-                                                        } else {
-                                                            errorOccurred = 1;
-                                                        }
-                                                    } else {
-                                                        errorOccurred = 1;
-                                                    }
-                                                } else {
-                                                    errorOccurred = 1;
-                                                }
-                                            }
-                                            
-                                            // Move to next node (simply advance, no re-read needed)
-                                            currentOffset = nextOffset;
-                                        } else {
-                                            errorOccurred = 1;
-                                        }
-                                    } else {
-                                        errorOccurred = 1;
-                                    }
-                                } else {
-                                    errorOccurred = 1;
-                                }
-                            }
-                        } else {
-                            errorOccurred = 1;
-                        }
-                    } else {
-                        errorOccurred = 1;
-                    }
-                } else {
-                    errorOccurred = 1;
-                }
-            }
-            
-            // If no swaps occurred, list is sorted (early termination without break)
-            if (swapOccurred == 0) {
-                sortComplete = 1;
-            }
+    // Field 7: Quantity
+    if (isValid == 1) {
+        if (ParseCsvUnsigned(&csvFields[7], &parsedNumber) == 1) {
+            currentRecord->quantity = (unsigned short)parsedNumber;
+        } else {
+            printf("Warning: Line %d has invalid quantity '%.*s', skipping\n", lineNumber, csvFields[7].length, csvFields[7].start);
+            isValid = 0;
         }
     }
     
-    // Cleanup list file
-    if (listFile != NULL) {
-        fclose(listFile);
+    if (isValid == 1) {
+        // Field 8: Currency Code
+        CopyCsvField(tempCurrencyCode, 3, &csvFields[8]);
+        
+        // Remove any trailing whitespace from currency code
+        currencyLength = (int)strlen(tempCurrencyCode);
+        while (currencyLength > 0 && (tempCurrencyCode[currencyLength - 1] == ' ' || 
+               tempCurrencyCode[currencyLength - 1] == '\t')) {
+            tempCurrencyCode[currencyLength - 1] = '\0';
+            currencyLength--;
+        }
+        
+        // Field 2: Order Date
+        if (ParseCsvDayNumber(&csvFields[2], &currentRecord->orderDay) == 0) {
+            printf("Warning: Line %d has invalid order date '%.*s', skipping\n", lineNumber, csvFields[2].length, csvFields[2].start);
+            isValid = 0;
+        }
     }
     
-    // Step 3: Convert sorted linked list back to regular file
-    if (errorOccurred == 0 && nodesCreated > 1) {
-        recordsConverted = ConvertLinkedListToFile(linkedListFileName, outputFileName);
-        if (recordsConverted > 0) {
-            returnValue = (int)recordsConverted;
-            printf("Bubble sort completed: %ld records sorted\n", recordsConverted);
-        } else {
-            returnValue = -1;
+    // Field 3: Delivery Date (might be empty)
+    currentRecord->deliveryDay = DAY_NUMBER_NONE;
+    if (isValid == 1 && csvFields[3].length > 0) {
+        if (ParseCsvDayNumber(&csvFields[3], &currentRecord->deliveryDay) == 0) {
+            // If delivery date parsing fails, the order counts as not delivered
+            printf("Warning: Line %d has invalid delivery date '%.*s', setting to none\n", lineNumber, csvFields[3].length, csvFields[3].start);
         }
     }
+    // If delivery date is empty, it remains DAY_NUMBER_NONE
     
-    // Cleanup
-    if (data1 != NULL) {
-        free(data1);
-    }
-    if (data2 != NULL) {
-        free(data2);
+    // Validate and copy currency code
+    if (isValid == 1) {
+        if (ValidateCurrencyCode(tempCurrencyCode) == 1) {
+            strncpy(currentRecord->currencyCode, tempCurrencyCode, 3);
+        } else {
+            printf("Warning: Line %d has invalid currency code '%s', skipping\n", lineNumber, tempCurrencyCode);
+            isValid = 0;
+        }
     }
-    remove(linkedListFileName);                        // Delete temporary file
     
-    return returnValue;                                // Single return point
-}//end function definition SortBubble
+    return isValid;                                    // Single return point
+}//end function definition ParseSalesCsvRow
 
-//opcion 2
 /*
- * Function: GenerateReportHeader
- * Purpose: Generates standardized header for all reports with company info and timestamp
- * Parameters: txtFile - FILE pointer to report text file (can be NULL for console-only)
- *            reportTitle - specific title for this report
- * Returns: void
- * Note: Writes to both file and console using WriteToReport helper
+ * Function: CountSalesChunkRowsWorker
+ * Purpose: Thread entry point counting the rows of one Sales.csv chunk
+ * Parameters: parameter - salesChunkTask describing the chunk
+ * Returns: DWORD - always 0
+ * Note: Gives the next chunk its first line number, so warnings keep the
+ *       line numbers of a sequential read
  */
-void GenerateReportHeader(FILE* txtFile, const char* reportTitle) {
-    ClearOutput();
-    time_t currentTime;                    // Current system time for timestamp
-    struct tm *localTime;                  // Local time structure for formatting
-    char timeBuffer[40];                   // Buffer to store formatted time string
+DWORD WINAPI CountSalesChunkRowsWorker(LPVOID parameter) {
+    salesChunkTask* task = (salesChunkTask*)parameter;  // Chunk to count
+    const char* position = task->reader.position;      // Next character to examine
+    const char* newline = NULL;                        // Next '\n'
     
-    time(&currentTime);
-    localTime = localtime(&currentTime);
-    strftime(timeBuffer, sizeof(timeBuffer), "Valid to %Y-%m-%d at %H:%M hours\n", localTime);
+    task->rowCount = 0;
+    while (position < task->reader.end) {
+        newline = (const char*)memchr(position, '\n', (size_t)(task->reader.end - position));
+        position = (newline != NULL) ? newline + 1 : task->reader.end;
+        task->rowCount++;
+    }
     
-    WriteToReport(txtFile, "------------------------------------------------------------------------------------------------------------------------\n");
-    WriteToReport(txtFile, "Company Global Electronics Retailer\n");
-    WriteToReport(txtFile, "%s", timeBuffer);
-    WriteToReport(txtFile, "%s\n", reportTitle);
-    WriteToReport(txtFile, "------------------------------------------------------------------------------------------------------------------------\n");
-}//end function definition GenerateReportHeader
+    return 0;
+}//end function definition CountSalesChunkRowsWorker
 
 /*
- * Function: GenerateReportFooter
- * Purpose: Generates standardized footer for all reports with execution time
- * Parameters: txtFile - FILE pointer to report text file (can be NULL for console-only)
- *            startTime - time_t when report processing started
- * Returns: void
- * Note: Calculates and displays execution time in minutes and seconds
- *       Writes to both file and console using WriteToReport helper
+ * Function: ParseSalesChunkWorker
+ * Purpose: Thread entry point converting the rows of one Sales.csv chunk
+ * Parameters: parameter - salesChunkTask describing the chunk
+ * Returns: DWORD - always 0
  */
-void GenerateReportFooter(FILE* txtFile, time_t startTime) {
-    time_t endTime;                        // End time for execution time calculation
-    double elapsedTime;                    // Total elapsed time in seconds
-    int executionMinutes;                  // Minutes portion of execution time
-    int executionSeconds;                  // Seconds portion of execution time
+DWORD WINAPI ParseSalesChunkWorker(LPVOID parameter) {
+    salesChunkTask* task = (salesChunkTask*)parameter;  // Chunk to convert
+    csvField csvFields[9];                             // Fields of the current row
+    int fieldCount = 0;                                // Number of fields found
     
-    time(&endTime);
-    elapsedTime = difftime(endTime, startTime);
-    executionMinutes = (int)(elapsedTime / 60);
-    executionSeconds = (int)(elapsedTime) % 60;
+    task->recordCount = 0;
+    while (task->recordCount < task->recordCapacity &&
+           (fieldCount = ReadCsvRow(&task->reader, csvFields, 9)) >= 0) {
+        if (ParseSalesCsvRow(csvFields, fieldCount, task->reader.lineNumber, &task->records[task->recordCount]) == 1) {
+            task->recordCount++;
+        }
+    }
     
-    WriteToReport(txtFile, "------------------------------------------------------------------------------------------------------------------------\n");
-    WriteToReport(txtFile, "Time used to produce this listing: %d'%d\"\n", executionMinutes, executionSeconds);
-    WriteToReport(txtFile, "***************************LAST LINE OF THE REPORT***************************\n");
-    WriteToReport(txtFile, "------------------------------------------------------------------------------------------------------------------------\n");
-    return;
-}//end function definition GenerateReportFooter
+    return 0;
+}//end function definition ParseSalesChunkWorker
 
 /*
  * Function: ConvertSalesCsvToBinary
  * Purpose: Reads Sales.csv and converts it to binary format
- * Parameters: csvFilePointer - pointer to opened Sales.csv file
+ * Parameters: csvFile - open reader over Sales.csv
  *            binaryFilePointer - pointer to opened binary .dat file for writing
  * Returns: int - number of records converted, -1 if error
- * Note: Skips header line and validates each record
+ * Note: Skips header line and validates each record. The rows are cut into
+ *       SALES_CSV_CHUNK_BYTES chunks ending on line boundaries, up to one chunk
+ *       per worker thread (see SetSortThreadCount) is parsed at a time, and the
+ *       parsed chunks are written in file order, so the table is identical to a
+ *       sequential conversion.
  */
-int ConvertSalesCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
-    char csvLineBuffer[1024] = {0};                    // Buffer for reading CSV lines
-    salesRecord currentRecord;                         // Current record being processed
+int ConvertSalesCsvToBinary(csvReader* csvFile, FILE* binaryFilePointer) {
+    csvField csvFields[9];                             // Fields of the header row
+    salesChunkTask* tasks = NULL;                      // Chunks of the current wave
+    const char* chunkEnd = NULL;                       // End of the chunk being cut
+    const char* newline = NULL;                        // Line end after the nominal chunk size
+    int threadCount = GetSortThreadCount();            // Chunks parsed at the same time
+    int taskCount = 0;                                 // Chunks in the current wave
     int recordCount = 0;                               // Number of successfully processed records
-    int lineNumber = 0;                                // Current line number for error reporting
     int errorOccurred = 0;                             // Error flag (single return pattern)
     int returnValue = 0;                               // Return value (single return pattern)
-    int headerRead = 0;                                // Flag for header reading success
     
-    // Skip header line
-    headerRead = (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL) ? 1 : 0;
-    if (headerRead == 0) {
+    tasks = (salesChunkTask*)calloc((size_t)threadCount, sizeof(salesChunkTask));
+    if (tasks == NULL) {
+        printf("Error: Cannot allocate sales conversion tasks\n");
+        errorOccurred = 1;
+        returnValue = -1;
+    } else if (ReadCsvRow(csvFile, csvFields, 9) < 0) {
+        // Header line missing
         printf("Error: Sales.csv is empty or cannot be read\n");
         errorOccurred = 1;
         returnValue = -1;
-    } else {
-        lineNumber++;
     }
     
-    // Process each data line
-    while (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL && errorOccurred == 0) {
-        lineNumber++;
-        
-        // Initialize record to zero to prevent garbage data
-        InitializeStructureToZero(&currentRecord, sizeof(salesRecord));
-        
-        // Parse CSV line into temporary variables
-        char orderDateString[20] = {0};
-        char deliveryDateString[20] = {0};
-        char tempCurrencyCode[4] = {0};
-        
-        // Parse CSV line with proper handling of empty fields
-        char csvFields[9][50];                         // Array to store extracted fields
-        int fieldCount = 0;                            // Number of fields found
-        
-        // Initialize all fields to empty strings
-        for (int i = 0; i < 9; i++) {
-            csvFields[i][0] = '\0';
-        }
-        
-        // Parse CSV line character by character to handle empty fields
-        char* linePosition = csvLineBuffer;            // Current position in line
-        int fieldPosition = 0;                         // Position within current field
-        
-        while (*linePosition != '\0' && *linePosition != '\n' && *linePosition != '\r' && fieldCount < 9) {
-            if (*linePosition == ',') {
-                // End of field - null terminate and move to next field
-                csvFields[fieldCount][fieldPosition] = '\0';
-                fieldCount++;
-                fieldPosition = 0;
-            } else {
-                // Add character to current field if there's space
-                if (fieldPosition < 49) {
-                    csvFields[fieldCount][fieldPosition] = *linePosition;
-                    fieldPosition++;
+    while (errorOccurred == 0 && csvFile->position < csvFile->end) {
+        // Cut the next wave of chunks at line boundaries
+        for (taskCount = 0; taskCount < threadCount && csvFile->position < csvFile->end; taskCount++) {
+            chunkEnd = csvFile->end;
+            if (csvFile->end - csvFile->position > SALES_CSV_CHUNK_BYTES) {
+                newline = (const char*)memchr(csvFile->position + SALES_CSV_CHUNK_BYTES, '\n',
+                                              (size_t)(csvFile->end - csvFile->position - SALES_CSV_CHUNK_BYTES));
+                if (newline != NULL) {
+                    chunkEnd = newline + 1;
+                }
+            }
+            tasks[taskCount].reader = *csvFile;
+            tasks[taskCount].reader.end = chunkEnd;
+            csvFile->position = chunkEnd;
+        }
+        
+        // Number the lines of each chunk and size its record buffer
+        RunWorkerTasks(CountSalesChunkRowsWorker, tasks, sizeof(salesChunkTask), taskCount);
+        for (int taskIndex = 0; taskIndex < taskCount && errorOccurred == 0; taskIndex++) {
+            tasks[taskIndex].reader.lineNumber = csvFile->lineNumber;
+            csvFile->lineNumber += tasks[taskIndex].rowCount;
+            if (tasks[taskIndex].recordCapacity < tasks[taskIndex].rowCount) {
+                free(tasks[taskIndex].records);
+                tasks[taskIndex].records = (salesRecord*)malloc((size_t)tasks[taskIndex].rowCount * sizeof(salesRecord));
+                tasks[taskIndex].recordCapacity = (tasks[taskIndex].records != NULL) ? tasks[taskIndex].rowCount : 0;
+                if (tasks[taskIndex].records == NULL) {
+                    printf("Error: Cannot allocate sales write buffer\n");
+                    errorOccurred = 1;
+                    returnValue = -1;
                 }
             }
-            linePosition++;
-        }
-        
-        // Don't forget the last field (after the last comma)
-        if (fieldCount < 9) {
-            csvFields[fieldCount][fieldPosition] = '\0';
-            fieldCount++;
-        }
-        
-        // Validate that we got exactly 9 fields
-        if (fieldCount != 9) {
-            printf("Warning: Line %d in Sales.csv has invalid format (got %d fields), skipping\n", lineNumber, fieldCount);
-            continue;
-        }
-        
-        // Parse each field with proper validation
-        // Field 0: Order Number
-        if (sscanf(csvFields[0], "%ld", &currentRecord.orderNumber) != 1) {
-            printf("Warning: Line %d has invalid order number '%s', skipping\n", lineNumber, csvFields[0]);
-            continue;
-        }
-        
-        // Field 1: Line Item
-        if (sscanf(csvFields[1], "%hhu", &currentRecord.lineItem) != 1) {
-            printf("Warning: Line %d has invalid line item '%s', skipping\n", lineNumber, csvFields[1]);
-            continue;
-        }
-        
-        // Field 2: Order Date
-        strncpy(orderDateString, csvFields[2], 19);
-        orderDateString[19] = '\0';
-        
-        // Field 3: Delivery Date (might be empty)
-        if (strlen(csvFields[3]) > 0) {
-            strncpy(deliveryDateString, csvFields[3], 19);
-            deliveryDateString[19] = '\0';
-        } else {
-            deliveryDateString[0] = '\0'; // Empty delivery date
-        }
-        
-        // Field 4: CustomerKey
-        if (sscanf(csvFields[4], "%u", &currentRecord.customerKey) != 1) {
-            printf("Warning: Line %d has invalid customer key '%s', skipping\n", lineNumber, csvFields[4]);
-            continue;
-        }
-        
-        // Field 5: StoreKey
-        if (sscanf(csvFields[5], "%hu", &currentRecord.storeKey) != 1) {
-            printf("Warning: Line %d has invalid store key '%s', skipping\n", lineNumber, csvFields[5]);
-            continue;
-        }
-        
-        // Field 6: ProductKey
-        if (sscanf(csvFields[6], "%hu", &currentRecord.productKey) != 1) {
-            printf("Warning: Line %d has invalid product key '%s', skipping\n", lineNumber, csvFields[6]);
-            continue;
-        }
-        
-        // Field 7: Quantity
-        if (sscanf(csvFields[7], "%hu", &currentRecord.quantity) != 1) {
-            printf("Warning: Line %d has invalid quantity '%s', skipping\n", lineNumber, csvFields[7]);
-            continue;
-        }
-        
-        // Field 8: Currency Code
-        strncpy(tempCurrencyCode, csvFields[8], 3);
-        tempCurrencyCode[3] = '\0';
-        
-        // Remove any trailing whitespace from currency code
-        int currencyLength = strlen(tempCurrencyCode);
-        while (currencyLength > 0 && (tempCurrencyCode[currencyLength - 1] == ' ' || 
-               tempCurrencyCode[currencyLength - 1] == '\t' || tempCurrencyCode[currencyLength - 1] == '\r' || 
-               tempCurrencyCode[currencyLength - 1] == '\n')) {
-            tempCurrencyCode[currencyLength - 1] = '\0';
-            currencyLength--;
         }
         
-        // Parse and validate order date
-        if (ParseDateFromCsv(orderDateString, &currentRecord.orderDate) == 0) {
-            printf("Warning: Line %d has invalid order date '%s', skipping\n", lineNumber, orderDateString);
-            continue;
+        if (errorOccurred == 0) {
+            RunWorkerTasks(ParseSalesChunkWorker, tasks, sizeof(salesChunkTask), taskCount);
         }
         
-        // Parse delivery date (might be empty)
-        if (strlen(deliveryDateString) > 0) {
-            if (ParseDateFromCsv(deliveryDateString, &currentRecord.deliveryDate) == 0) {
-                // If delivery date parsing fails, leave it as zero-initialized
-                printf("Warning: Line %d has invalid delivery date '%s', setting to 0\n", lineNumber, deliveryDateString);
+        // Concatenate the chunks in file order
+        for (int taskIndex = 0; taskIndex < taskCount && errorOccurred == 0; taskIndex++) {
+            if (CountedWrite(tasks[taskIndex].records, sizeof(salesRecord), (size_t)tasks[taskIndex].recordCount,
+                             binaryFilePointer) != (size_t)tasks[taskIndex].recordCount) {
+                printf("Error: Failed to write sales records to binary file\n");
+                errorOccurred = 1;
+                returnValue = -1;
+            } else {
+                recordCount += tasks[taskIndex].recordCount;
             }
         }
-        // If delivery date is empty, it remains zero-initialized
-        
-        // Validate and copy currency code
-        if (ValidateCurrencyCode(tempCurrencyCode) == 0) {
-            printf("Warning: Line %d has invalid currency code '%s', skipping\n", lineNumber, tempCurrencyCode);
-            continue;
-        }
-        strncpy(currentRecord.currencyCode, tempCurrencyCode, 3);
-        
-        // Write the record to binary file
-        if (fwrite(&currentRecord, sizeof(salesRecord), 1, binaryFilePointer) != 1) {
-            printf("Error: Failed to write record %d to binary file\n", recordCount + 1);
-            errorOccurred = 1;
-            returnValue = -1;
-        } else {
-            recordCount++;
+    }
+    
+    if (tasks != NULL) {
+        for (int taskIndex = 0; taskIndex < threadCount; taskIndex++) {
+            free(tasks[taskIndex].records);
         }
+        free(tasks);
     }
     
     if (errorOccurred == 0) {
@@ -5505,71 +10816,43 @@ int ConvertSalesCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
 /*
  * Function: ConvertCustomersCsvToBinary
  * Purpose: Reads Customers.csv and converts it to binary format
- * Parameters: csvFilePointer - pointer to opened Customers.csv file
+ * Parameters: csvFile - open reader over Customers.csv
  *            binaryFilePointer - pointer to opened binary .dat file for writing
  * Returns: int - number of records converted, -1 if error
- * Note: Skips header line and validates each record
+ * Note: Skips header line and validates each record. Records are written in
+ *       batches of CSV_WRITE_BATCH_RECORDS.
  */
-int ConvertCustomersCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
-    char csvLineBuffer[1024] = {0};                    // Buffer for reading CSV lines
-    customerRecord currentRecord;                      // Current record being processed
+int ConvertCustomersCsvToBinary(csvReader* csvFile, FILE* binaryFilePointer) {
+    csvField csvFields[10];                            // Fields of the current row
+    customerRecord* batchRecords = NULL;               // Records waiting to be written
+    customerRecord* currentRecord = NULL;              // Current record being processed
+    unsigned long parsedNumber = 0;                    // Parsed numeric field
+    int batchCount = 0;                                // Records in batchRecords
+    int fieldCount = 0;                                // Number of fields found
     int recordCount = 0;                               // Number of successfully processed records
     int lineNumber = 0;                                // Current line number for error reporting
     int errorOccurred = 0;                             // Error flag (single return pattern)
     int returnValue = 0;                               // Return value (single return pattern)
-    int headerRead = 0;                                // Flag for header reading success
     
-    // Skip header line
-    headerRead = (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL) ? 1 : 0;
-    if (headerRead == 0) {
+    batchRecords = (customerRecord*)malloc(CSV_WRITE_BATCH_RECORDS * sizeof(customerRecord));
+    if (batchRecords == NULL) {
+        printf("Error: Cannot allocate customers write buffer\n");
+        errorOccurred = 1;
+        returnValue = -1;
+    } else if (ReadCsvRow(csvFile, csvFields, 10) < 0) {
+        // Header line missing
         printf("Error: Customers.csv is empty or cannot be read\n");
         errorOccurred = 1;
         returnValue = -1;
-    } else {
-        lineNumber++;
     }
     
     // Process each data line
-    while (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL && errorOccurred == 0) {
-        lineNumber++;
+    while (errorOccurred == 0 && (fieldCount = ReadCsvRow(csvFile, csvFields, 10)) >= 0) {
+        lineNumber = csvFile->lineNumber;
         
         // Initialize record to zero to prevent garbage data
-        InitializeStructureToZero(&currentRecord, sizeof(customerRecord));
-        
-        // Parse CSV line into fields
-        char csvFields[10][50];                        // Array to store extracted fields
-        int fieldCount = 0;                            // Number of fields found
-        
-        // Initialize all fields to empty strings
-        for (int i = 0; i < 10; i++) {
-            csvFields[i][0] = '\0';
-        }
-        
-        // Parse CSV line character by character to handle empty fields
-        char* linePosition = csvLineBuffer;            // Current position in line
-        int fieldPosition = 0;                         // Position within current field
-        
-        while (*linePosition != '\0' && *linePosition != '\n' && *linePosition != '\r' && fieldCount < 10) {
-            if (*linePosition == ',') {
-                // End of field - null terminate and move to next field
-                csvFields[fieldCount][fieldPosition] = '\0';
-                fieldCount++;
-                fieldPosition = 0;
-            } else {
-                // Add character to current field if there's space
-                if (fieldPosition < 49) {
-                    csvFields[fieldCount][fieldPosition] = *linePosition;
-                    fieldPosition++;
-                }
-            }
-            linePosition++;
-        }
-        
-        // Don't forget the last field (after the last comma)
-        if (fieldCount < 10) {
-            csvFields[fieldCount][fieldPosition] = '\0';
-            fieldCount++;
-        }
+        currentRecord = &batchRecords[batchCount];
+        InitializeStructureToZero(currentRecord, sizeof(customerRecord));
         
         // Validate that we got exactly 10 fields
         if (fieldCount != 10) {
@@ -5579,40 +10862,34 @@ int ConvertCustomersCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
         
         // Parse each field with proper validation
         // Field 0: CustomerKey
-        if (sscanf(csvFields[0], "%u", &currentRecord.customerKey) != 1) {
-            printf("Warning: Line %d has invalid customer key '%s', skipping\n", lineNumber, csvFields[0]);
+        if (ParseCsvUnsigned(&csvFields[0], &parsedNumber) == 0) {
+            printf("Warning: Line %d has invalid customer key '%.*s', skipping\n", lineNumber, csvFields[0].length, csvFields[0].start);
             continue;
         }
+        currentRecord->customerKey = (unsigned int)parsedNumber;
         
-        // Field 1: Gender
-        strncpy(currentRecord.gender, csvFields[1], 7);
-        currentRecord.gender[7] = '\0';
-        
-        // Field 2: Name
-        strncpy(currentRecord.name, csvFields[2], 39);
-        currentRecord.name[39] = '\0';
-        
-        // Field 3: City
-        strncpy(currentRecord.city, csvFields[3], 39);
-        currentRecord.city[39] = '\0';
-        
-        // Field 4: State Code
-        strncpy(currentRecord.stateCode, csvFields[4], 19);
-        currentRecord.stateCode[19] = '\0';
-        
-        // Field 5: State
-        strncpy(currentRecord.state, csvFields[5], 29);
-        currentRecord.state[29] = '\0';
+        // Fields 1-5: Gender, Name, City, State Code, State
+        CopyCsvField(currentRecord->name, 39, &csvFields[2]);
+        CopyCsvField(currentRecord->city, 39, &csvFields[3]);
+        if (EncodeCsvField(&currentRecord->gender, 7, BINARY_TABLE_CUSTOMERS, CUSTOMER_DICTIONARY_GENDER, &csvFields[1]) == 0 ||
+            EncodeCsvField(&currentRecord->stateCode, 19, BINARY_TABLE_CUSTOMERS, CUSTOMER_DICTIONARY_STATE_CODE, &csvFields[4]) == 0 ||
+            EncodeCsvField(&currentRecord->state, 29, BINARY_TABLE_CUSTOMERS, CUSTOMER_DICTIONARY_STATE, &csvFields[5]) == 0) {
+            errorOccurred = 1;
+            returnValue = -1;
+            continue;
+        }
         
         // Field 6: Zip Code (handle both numeric US zip codes and alphanumeric Canadian postal codes)
         // For Canadian postal codes, we'll store 0 as a placeholder since the field is unsigned int
-        if (sscanf(csvFields[6], "%u", &currentRecord.zipCode) != 1) {
+        if (ParseCsvUnsigned(&csvFields[6], &parsedNumber) == 1) {
+            currentRecord->zipCode = (unsigned int)parsedNumber;
+        } else {
             // Check if it's a Canadian postal code (contains letters)
             int hasLetters = 0;
             int i = 0;
-            while (csvFields[6][i] != '\0' && hasLetters == 0) {
-                if ((csvFields[6][i] >= 'A' && csvFields[6][i] <= 'Z') || 
-                    (csvFields[6][i] >= 'a' && csvFields[6][i] <= 'z')) {
+            while (i < csvFields[6].length && hasLetters == 0) {
+                if ((csvFields[6].start[i] >= 'A' && csvFields[6].start[i] <= 'Z') || 
+                    (csvFields[6].start[i] >= 'a' && csvFields[6].start[i] <= 'z')) {
                     hasLetters = 1;                    // Found letter, exit loop condition (no break)
                 }
                 i++;
@@ -5620,37 +10897,46 @@ int ConvertCustomersCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
             
             if (hasLetters == 1) {
                 // Canadian postal code - store as 0 (could be enhanced later)
-                currentRecord.zipCode = 0;
+                currentRecord->zipCode = 0;
             } else {
-                printf("Warning: Line %d has invalid zip code '%s', skipping\n", lineNumber, csvFields[6]);
+                printf("Warning: Line %d has invalid zip code '%.*s', skipping\n", lineNumber, csvFields[6].length, csvFields[6].start);
                 continue;
             }
         }
         
-        // Field 7: Country
-        strncpy(currentRecord.country, csvFields[7], 19);
-        currentRecord.country[19] = '\0';
-        
-        // Field 8: Continent
-        strncpy(currentRecord.continent, csvFields[8], 19);
-        currentRecord.continent[19] = '\0';
+        // Fields 7-8: Country, Continent
+        if (EncodeCsvField(&currentRecord->country, 19, BINARY_TABLE_CUSTOMERS, CUSTOMER_DICTIONARY_COUNTRY, &csvFields[7]) == 0 ||
+            EncodeCsvField(&currentRecord->continent, 19, BINARY_TABLE_CUSTOMERS, CUSTOMER_DICTIONARY_CONTINENT, &csvFields[8]) == 0) {
+            errorOccurred = 1;
+            returnValue = -1;
+            continue;
+        }
         
         // Field 9: Birthday
-        if (ParseDateFromCsv(csvFields[9], &currentRecord.birthday) == 0) {
-            printf("Warning: Line %d has invalid birthday '%s', skipping\n", lineNumber, csvFields[9]);
+        if (ParseCsvDate(&csvFields[9], &currentRecord->birthday) == 0) {
+            printf("Warning: Line %d has invalid birthday '%.*s', skipping\n", lineNumber, csvFields[9].length, csvFields[9].start);
             continue;
         }
         
-        // Write the record to binary file
-        if (fwrite(&currentRecord, sizeof(customerRecord), 1, binaryFilePointer) != 1) {
-            printf("Error: Failed to write customer record %d to binary file\n", recordCount + 1);
+        // Keep the record and write a full batch
+        batchCount++;
+        recordCount++;
+        if (batchCount == CSV_WRITE_BATCH_RECORDS &&
+            FlushRecordBatch(binaryFilePointer, batchRecords, sizeof(customerRecord), &batchCount) == 0) {
+            printf("Error: Failed to write customer records to binary file\n");
             errorOccurred = 1;
-            returnValue = -1;
-        } else {
-            recordCount++;
+            returnValue = -1;
         }
     }
     
+    if (errorOccurred == 0 &&
+        FlushRecordBatch(binaryFilePointer, batchRecords, sizeof(customerRecord), &batchCount) == 0) {
+        printf("Error: Failed to write customer records to binary file\n");
+        errorOccurred = 1;
+        returnValue = -1;
+    }
+    free(batchRecords);
+    
     if (errorOccurred == 0) {
         printf("Customers conversion completed: %d records processed\n", recordCount);
         returnValue = recordCount;
@@ -5662,71 +10948,43 @@ int ConvertCustomersCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
 /*
  * Function: ConvertStoresCsvToBinary
  * Purpose: Reads Stores.csv and converts it to binary format
- * Parameters: csvFilePointer - pointer to opened Stores.csv file
+ * Parameters: csvFile - open reader over Stores.csv
  *            binaryFilePointer - pointer to opened binary .dat file for writing
  * Returns: int - number of records converted, -1 if error
- * Note: Skips header line and validates each record
+ * Note: Skips header line and validates each record. Records are written in
+ *       batches of CSV_WRITE_BATCH_RECORDS.
  */
-int ConvertStoresCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
-    char csvLineBuffer[1024] = {0};                    // Buffer for reading CSV lines
-    storeRecord currentRecord;                         // Current record being processed
+int ConvertStoresCsvToBinary(csvReader* csvFile, FILE* binaryFilePointer) {
+    csvField csvFields[5];                             // Fields of the current row
+    storeRecord* batchRecords = NULL;                  // Records waiting to be written
+    storeRecord* currentRecord = NULL;                 // Current record being processed
+    unsigned long parsedNumber = 0;                    // Parsed numeric field
+    int batchCount = 0;                                // Records in batchRecords
+    int fieldCount = 0;                                // Number of fields found
     int recordCount = 0;                               // Number of successfully processed records
     int lineNumber = 0;                                // Current line number for error reporting
     int errorOccurred = 0;                             // Error flag (single return pattern)
     int returnValue = 0;                               // Return value (single return pattern)
-    int headerRead = 0;                                // Flag for header reading success
     
-    // Skip header line
-    headerRead = (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL) ? 1 : 0;
-    if (headerRead == 0) {
+    batchRecords = (storeRecord*)malloc(CSV_WRITE_BATCH_RECORDS * sizeof(storeRecord));
+    if (batchRecords == NULL) {
+        printf("Error: Cannot allocate stores write buffer\n");
+        errorOccurred = 1;
+        returnValue = -1;
+    } else if (ReadCsvRow(csvFile, csvFields, 5) < 0) {
+        // Header line missing
         printf("Error: Stores.csv is empty or cannot be read\n");
         errorOccurred = 1;
         returnValue = -1;
-    } else {
-        lineNumber++;
     }
     
     // Process each data line
-    while (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL && errorOccurred == 0) {
-        lineNumber++;
+    while (errorOccurred == 0 && (fieldCount = ReadCsvRow(csvFile, csvFields, 5)) >= 0) {
+        lineNumber = csvFile->lineNumber;
         
         // Initialize record to zero to prevent garbage data
-        InitializeStructureToZero(&currentRecord, sizeof(storeRecord));
-        
-        // Parse CSV line into fields
-        char csvFields[5][50];                         // Array to store extracted fields
-        int fieldCount = 0;                            // Number of fields found
-        
-        // Initialize all fields to empty strings
-        for (int i = 0; i < 5; i++) {
-            csvFields[i][0] = '\0';
-        }
-        
-        // Parse CSV line character by character to handle empty fields
-        char* linePosition = csvLineBuffer;            // Current position in line
-        int fieldPosition = 0;                         // Position within current field
-        
-        while (*linePosition != '\0' && *linePosition != '\n' && *linePosition != '\r' && fieldCount < 5) {
-            if (*linePosition == ',') {
-                // End of field - null terminate and move to next field
-                csvFields[fieldCount][fieldPosition] = '\0';
-                fieldCount++;
-                fieldPosition = 0;
-            } else {
-                // Add character to current field if there's space
-                if (fieldPosition < 49) {
-                    csvFields[fieldCount][fieldPosition] = *linePosition;
-                    fieldPosition++;
-                }
-            }
-            linePosition++;
-        }
-        
-        // Don't forget the last field (after the last comma)
-        if (fieldCount < 5) {
-            csvFields[fieldCount][fieldPosition] = '\0';
-            fieldCount++;
-        }
+        currentRecord = &batchRecords[batchCount];
+        InitializeStructureToZero(currentRecord, sizeof(storeRecord));
         
         // Validate that we got exactly 5 fields
         if (fieldCount != 5) {
@@ -5736,41 +10994,48 @@ int ConvertStoresCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
         
         // Parse each field with proper validation
         // Field 0: StoreKey
-        if (sscanf(csvFields[0], "%hu", &currentRecord.storeKey) != 1) {
-            printf("Warning: Line %d has invalid store key '%s', skipping\n", lineNumber, csvFields[0]);
+        if (ParseCsvUnsigned(&csvFields[0], &parsedNumber) == 0) {
+            printf("Warning: Line %d has invalid store key '%.*s', skipping\n", lineNumber, csvFields[0].length, csvFields[0].start);
             continue;
         }
+        currentRecord->storeKey = (unsigned short)parsedNumber;
         
-        // Field 1: Country
-        strncpy(currentRecord.country, csvFields[1], 34);
-        currentRecord.country[34] = '\0';
-        
-        // Field 2: State
-        strncpy(currentRecord.state, csvFields[2], 34);
-        currentRecord.state[34] = '\0';
+        // Fields 1-2: Country, State
+        CopyCsvField(currentRecord->country, 34, &csvFields[1]);
+        CopyCsvField(currentRecord->state, 34, &csvFields[2]);
         
         // Field 3: Square Meters
-        if (sscanf(csvFields[3], "%hu", &currentRecord.squareMeters) != 1) {
-            printf("Warning: Line %d has invalid square meters '%s', skipping\n", lineNumber, csvFields[3]);
+        if (ParseCsvUnsigned(&csvFields[3], &parsedNumber) == 0) {
+            printf("Warning: Line %d has invalid square meters '%.*s', skipping\n", lineNumber, csvFields[3].length, csvFields[3].start);
             continue;
         }
+        currentRecord->squareMeters = (unsigned short)parsedNumber;
         
         // Field 4: Open Date
-        if (ParseDateFromCsv(csvFields[4], &currentRecord.openDate) == 0) {
-            printf("Warning: Line %d has invalid open date '%s', skipping\n", lineNumber, csvFields[4]);
+        if (ParseCsvDate(&csvFields[4], &currentRecord->openDate) == 0) {
+            printf("Warning: Line %d has invalid open date '%.*s', skipping\n", lineNumber, csvFields[4].length, csvFields[4].start);
             continue;
         }
         
-        // Write the record to binary file
-        if (fwrite(&currentRecord, sizeof(storeRecord), 1, binaryFilePointer) != 1) {
-            printf("Error: Failed to write store record %d to binary file\n", recordCount + 1);
+        // Keep the record and write a full batch
+        batchCount++;
+        recordCount++;
+        if (batchCount == CSV_WRITE_BATCH_RECORDS &&
+            FlushRecordBatch(binaryFilePointer, batchRecords, sizeof(storeRecord), &batchCount) == 0) {
+            printf("Error: Failed to write store records to binary file\n");
             errorOccurred = 1;
             returnValue = -1;
-        } else {
-            recordCount++;
         }
     }
     
+    if (errorOccurred == 0 &&
+        FlushRecordBatch(binaryFilePointer, batchRecords, sizeof(storeRecord), &batchCount) == 0) {
+        printf("Error: Failed to write store records to binary file\n");
+        errorOccurred = 1;
+        returnValue = -1;
+    }
+    free(batchRecords);
+    
     if (errorOccurred == 0) {
         printf("Stores conversion completed: %d records processed\n", recordCount);
         returnValue = recordCount;
@@ -5782,71 +11047,43 @@ int ConvertStoresCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
 /*
  * Function: ConvertExchangeRatesCsvToBinary
  * Purpose: Reads Exchange_Rates.csv and converts it to binary format
- * Parameters: csvFilePointer - pointer to opened Exchange_Rates.csv file
+ * Parameters: csvFile - open reader over Exchange_Rates.csv
  *            binaryFilePointer - pointer to opened binary .dat file for writing
  * Returns: int - number of records converted, -1 if error
- * Note: Skips header line and validates each record
+ * Note: Skips header line and validates each record. Records are written in
+ *       batches of CSV_WRITE_BATCH_RECORDS.
  */
-int ConvertExchangeRatesCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
-    char csvLineBuffer[1024] = {0};                    // Buffer for reading CSV lines
-    exchangeRateRecord currentRecord;                  // Current record being processed
+int ConvertExchangeRatesCsvToBinary(csvReader* csvFile, FILE* binaryFilePointer) {
+    csvField csvFields[3];                             // Fields of the current row
+    exchangeRateRecord* batchRecords = NULL;           // Records waiting to be written
+    exchangeRateRecord* currentRecord = NULL;          // Current record being processed
+    int batchCount = 0;                                // Records in batchRecords
+    int fieldCount = 0;                                // Number of fields found
     int recordCount = 0;                               // Number of successfully processed records
     int lineNumber = 0;                                // Current line number for error reporting
     int errorOccurred = 0;                             // Error flag (single return pattern)
     int returnValue = 0;                               // Return value (single return pattern)
-    int headerRead = 0;                                // Flag for header reading success
+    int currencyLength = 0;                            // Length of the currency code
     
-    // Skip header line
-    headerRead = (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL) ? 1 : 0;
-    if (headerRead == 0) {
+    batchRecords = (exchangeRateRecord*)malloc(CSV_WRITE_BATCH_RECORDS * sizeof(exchangeRateRecord));
+    if (batchRecords == NULL) {
+        printf("Error: Cannot allocate exchange rates write buffer\n");
+        errorOccurred = 1;
+        returnValue = -1;
+    } else if (ReadCsvRow(csvFile, csvFields, 3) < 0) {
+        // Header line missing
         printf("Error: Exchange_Rates.csv is empty or cannot be read\n");
         errorOccurred = 1;
         returnValue = -1;
-    } else {
-        lineNumber++;
     }
     
     // Process each data line
-    while (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL && errorOccurred == 0) {
-        lineNumber++;
+    while (errorOccurred == 0 && (fieldCount = ReadCsvRow(csvFile, csvFields, 3)) >= 0) {
+        lineNumber = csvFile->lineNumber;
         
         // Initialize record to zero to prevent garbage data
-        InitializeStructureToZero(&currentRecord, sizeof(exchangeRateRecord));
-        
-        // Parse CSV line into fields
-        char csvFields[3][50];                         // Array to store extracted fields
-        int fieldCount = 0;                            // Number of fields found
-        
-        // Initialize all fields to empty strings
-        for (int i = 0; i < 3; i++) {
-            csvFields[i][0] = '\0';
-        }
-        
-        // Parse CSV line character by character to handle empty fields
-        char* linePosition = csvLineBuffer;            // Current position in line
-        int fieldPosition = 0;                         // Position within current field
-        
-        while (*linePosition != '\0' && *linePosition != '\n' && *linePosition != '\r' && fieldCount < 3) {
-            if (*linePosition == ',') {
-                // End of field - null terminate and move to next field
-                csvFields[fieldCount][fieldPosition] = '\0';
-                fieldCount++;
-                fieldPosition = 0;
-            } else {
-                // Add character to current field if there's space
-                if (fieldPosition < 49) {
-                    csvFields[fieldCount][fieldPosition] = *linePosition;
-                    fieldPosition++;
-                }
-            }
-            linePosition++;
-        }
-        
-        // Don't forget the last field (after the last comma)
-        if (fieldCount < 3) {
-            csvFields[fieldCount][fieldPosition] = '\0';
-            fieldCount++;
-        }
+        currentRecord = &batchRecords[batchCount];
+        InitializeStructureToZero(currentRecord, sizeof(exchangeRateRecord));
         
         // Validate that we got exactly 3 fields
         if (fieldCount != 3) {
@@ -5856,59 +11093,63 @@ int ConvertExchangeRatesCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointe
         
         // Parse each field with proper validation
         // Field 0: Date
-        strncpy(currentRecord.date, csvFields[0], 9);
-        currentRecord.date[9] = '\0';
-        
         // Remove any trailing whitespace from date
-        int dateLength = strlen(currentRecord.date);
-        while (dateLength > 0 && (currentRecord.date[dateLength - 1] == ' ' || 
-               currentRecord.date[dateLength - 1] == '\t' || currentRecord.date[dateLength - 1] == '\r' || 
-               currentRecord.date[dateLength - 1] == '\n')) {
-            currentRecord.date[dateLength - 1] = '\0';
-            dateLength--;
+        while (csvFields[0].length > 0 && (csvFields[0].start[csvFields[0].length - 1] == ' ' || 
+               csvFields[0].start[csvFields[0].length - 1] == '\t')) {
+            csvFields[0].length--;
         }
         
+        // Invalid dates are kept as DAY_NUMBER_NONE and ignored by the exchange rate matrix
+        ParseCsvDayNumber(&csvFields[0], &currentRecord->rateDay);
+        
         // Field 1: Currency
-        strncpy(currentRecord.currency, csvFields[1], 3);
-        currentRecord.currency[3] = '\0';
+        CopyCsvField(currentRecord->currency, 3, &csvFields[1]);
         
         // Remove any trailing whitespace from currency
-        int currencyLength = strlen(currentRecord.currency);
-        while (currencyLength > 0 && (currentRecord.currency[currencyLength - 1] == ' ' || 
-               currentRecord.currency[currencyLength - 1] == '\t' || currentRecord.currency[currencyLength - 1] == '\r' || 
-               currentRecord.currency[currencyLength - 1] == '\n')) {
-            currentRecord.currency[currencyLength - 1] = '\0';
+        currencyLength = (int)strlen(currentRecord->currency);
+        while (currencyLength > 0 && (currentRecord->currency[currencyLength - 1] == ' ' || 
+               currentRecord->currency[currencyLength - 1] == '\t')) {
+            currentRecord->currency[currencyLength - 1] = '\0';
             currencyLength--;
         }
         
         // Validate currency code
-        if (ValidateCurrencyCode(currentRecord.currency) == 0) {
-            printf("Warning: Line %d has invalid currency code '%s', skipping\n", lineNumber, currentRecord.currency);
+        if (ValidateCurrencyCode(currentRecord->currency) == 0) {
+            printf("Warning: Line %d has invalid currency code '%s', skipping\n", lineNumber, currentRecord->currency);
             continue;
         }
         
         // Field 2: Exchange Rate
-        if (sscanf(csvFields[2], "%lf", &currentRecord.exchange) != 1) {
-            printf("Warning: Line %d has invalid exchange rate '%s', skipping\n", lineNumber, csvFields[2]);
+        if (ParseCsvDecimal(&csvFields[2], 0, &currentRecord->exchange) == 0) {
+            printf("Warning: Line %d has invalid exchange rate '%.*s', skipping\n", lineNumber, csvFields[2].length, csvFields[2].start);
             continue;
         }
         
         // Validate exchange rate is positive
-        if (currentRecord.exchange <= 0.0) {
-            printf("Warning: Line %d has invalid exchange rate '%lf' (must be positive), skipping\n", lineNumber, currentRecord.exchange);
+        if (currentRecord->exchange <= 0.0) {
+            printf("Warning: Line %d has invalid exchange rate '%lf' (must be positive), skipping\n", lineNumber, currentRecord->exchange);
             continue;
         }
         
-        // Write the record to binary file
-        if (fwrite(&currentRecord, sizeof(exchangeRateRecord), 1, binaryFilePointer) != 1) {
-            printf("Error: Failed to write exchange rate record %d to binary file\n", recordCount + 1);
+        // Keep the record and write a full batch
+        batchCount++;
+        recordCount++;
+        if (batchCount == CSV_WRITE_BATCH_RECORDS &&
+            FlushRecordBatch(binaryFilePointer, batchRecords, sizeof(exchangeRateRecord), &batchCount) == 0) {
+            printf("Error: Failed to write exchange rate records to binary file\n");
             errorOccurred = 1;
             returnValue = -1;
-        } else {
-            recordCount++;
         }
     }
     
+    if (errorOccurred == 0 &&
+        FlushRecordBatch(binaryFilePointer, batchRecords, sizeof(exchangeRateRecord), &batchCount) == 0) {
+        printf("Error: Failed to write exchange rate records to binary file\n");
+        errorOccurred = 1;
+        returnValue = -1;
+    }
+    free(batchRecords);
+    
     if (errorOccurred == 0) {
         printf("Exchange Rates conversion completed: %d records processed\n", recordCount);
         returnValue = recordCount;
@@ -5980,71 +11221,45 @@ int ParseCurrencyFromCsv(const char* currencyString, double* parsedValue) {
 /*
  * Function: ConvertProductsCsvToBinary
  * Purpose: Reads Products.csv and converts it to binary format
- * Parameters: csvFilePointer - pointer to opened Products.csv file
+ * Parameters: csvFile - open reader over Products.csv
  *            binaryFilePointer - pointer to opened binary .dat file for writing
  * Returns: int - number of records converted, -1 if error
- * Note: Skips header line and validates each record, handles currency parsing
+ * Note: Skips header line and validates each record, handles currency parsing.
+ *       Records are written in batches of CSV_WRITE_BATCH_RECORDS.
  */
-int ConvertProductsCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
-    char csvLineBuffer[1024] = {0};                    // Buffer for reading CSV lines
-    productRecord currentRecord;                       // Current record being processed
+int ConvertProductsCsvToBinary(csvReader* csvFile, FILE* binaryFilePointer) {
+    csvField csvFields[10];                            // Fields of the current row
+    productRecord* batchRecords = NULL;                // Records waiting to be written
+    productRecord* currentRecord = NULL;               // Current record being processed
+    unsigned long parsedNumber = 0;                    // Parsed numeric field
+    int batchCount = 0;                                // Records in batchRecords
+    int fieldCount = 0;                                // Number of fields found
     int recordCount = 0;                               // Number of successfully processed records
     int lineNumber = 0;                                // Current line number for error reporting
     int errorOccurred = 0;                             // Error flag (single return pattern)
     int returnValue = 0;                               // Return value (single return pattern)
-    int headerRead = 0;                                // Flag for header reading success
+    int categoryLength = 0;                            // Length of the category name
+    char categoryText[20];                             // Category name before encoding
     
-    // Skip header line
-    headerRead = (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL) ? 1 : 0;
-    if (headerRead == 0) {
+    batchRecords = (productRecord*)malloc(CSV_WRITE_BATCH_RECORDS * sizeof(productRecord));
+    if (batchRecords == NULL) {
+        printf("Error: Cannot allocate products write buffer\n");
+        errorOccurred = 1;
+        returnValue = -1;
+    } else if (ReadCsvRow(csvFile, csvFields, 10) < 0) {
+        // Header line missing
         printf("Error: Products.csv is empty or cannot be read\n");
         errorOccurred = 1;
         returnValue = -1;
-    } else {
-        lineNumber++;
     }
     
     // Process each data line
-    while (fgets(csvLineBuffer, sizeof(csvLineBuffer), csvFilePointer) != NULL && errorOccurred == 0) {
-        lineNumber++;
+    while (errorOccurred == 0 && (fieldCount = ReadCsvRow(csvFile, csvFields, 10)) >= 0) {
+        lineNumber = csvFile->lineNumber;
         
         // Initialize record to zero to prevent garbage data
-        InitializeStructureToZero(&currentRecord, sizeof(productRecord));
-        
-        // Parse CSV line into fields
-        char csvFields[10][100];                       // Array to store extracted fields (larger for product names)
-        int fieldCount = 0;                            // Number of fields found
-        
-        // Initialize all fields to empty strings
-        for (int i = 0; i < 10; i++) {
-            csvFields[i][0] = '\0';
-        }
-        
-        // Parse CSV line character by character to handle empty fields
-        char* linePosition = csvLineBuffer;            // Current position in line
-        int fieldPosition = 0;                         // Position within current field
-        
-        while (*linePosition != '\0' && *linePosition != '\n' && *linePosition != '\r' && fieldCount < 10) {
-            if (*linePosition == ',') {
-                // End of field - null terminate and move to next field
-                csvFields[fieldCount][fieldPosition] = '\0';
-                fieldCount++;
-                fieldPosition = 0;
-            } else {
-                // Add character to current field if there's space
-                if (fieldPosition < 99) {
-                    csvFields[fieldCount][fieldPosition] = *linePosition;
-                    fieldPosition++;
-                }
-            }
-            linePosition++;
-        }
-        
-        // Don't forget the last field (after the last comma)
-        if (fieldCount < 10) {
-            csvFields[fieldCount][fieldPosition] = '\0';
-            fieldCount++;
-        }
+        currentRecord = &batchRecords[batchCount];
+        InitializeStructureToZero(currentRecord, sizeof(productRecord));
         
         // Validate that we got exactly 10 fields
         if (fieldCount != 10) {
@@ -6054,70 +11269,73 @@ int ConvertProductsCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
         
         // Parse each field with proper validation
         // Field 0: ProductKey
-        if (sscanf(csvFields[0], "%hu", &currentRecord.productKey) != 1) {
-            printf("Warning: Line %d has invalid product key '%s', skipping\n", lineNumber, csvFields[0]);
+        if (ParseCsvUnsigned(&csvFields[0], &parsedNumber) == 0) {
+            printf("Warning: Line %d has invalid product key '%.*s', skipping\n", lineNumber, csvFields[0].length, csvFields[0].start);
             continue;
         }
+        currentRecord->productKey = (unsigned short)parsedNumber;
         
-        // Field 1: Product Name
-        strncpy(currentRecord.productName, csvFields[1], 29);
-        currentRecord.productName[29] = '\0';
-        
-        // Field 2: Brand
-        strncpy(currentRecord.brand, csvFields[2], 29);
-        currentRecord.brand[29] = '\0';
-        
-        // Field 3: Color
-        strncpy(currentRecord.color, csvFields[3], 14);
-        currentRecord.color[14] = '\0';
+        // Fields 1-3: Product Name, Brand, Color
+        CopyCsvField(currentRecord->productName, 29, &csvFields[1]);
+        CopyCsvField(currentRecord->color, 14, &csvFields[3]);
+        if (EncodeCsvField(&currentRecord->brand, 29, BINARY_TABLE_PRODUCTS, PRODUCT_DICTIONARY_BRAND, &csvFields[2]) == 0) {
+            errorOccurred = 1;
+            returnValue = -1;
+            continue;
+        }
         
         // Field 4: Unit Cost USD
-        if (ParseCurrencyFromCsv(csvFields[4], &currentRecord.unitCostUSD) == 0) {
-            printf("Warning: Line %d has invalid unit cost '%s', skipping\n", lineNumber, csvFields[4]);
+        if (ParseCsvDecimal(&csvFields[4], 1, &currentRecord->unitCostUSD) == 0) {
+            printf("Warning: Line %d has invalid unit cost '%.*s', skipping\n", lineNumber, csvFields[4].length, csvFields[4].start);
             continue;
         }
         
         // Field 5: Unit Price USD
-        if (ParseCurrencyFromCsv(csvFields[5], &currentRecord.unitPriceUSD) == 0) {
-            printf("Warning: Line %d has invalid unit price '%s', skipping\n", lineNumber, csvFields[5]);
+        if (ParseCsvDecimal(&csvFields[5], 1, &currentRecord->unitPriceUSD) == 0) {
+            printf("Warning: Line %d has invalid unit price '%.*s', skipping\n", lineNumber, csvFields[5].length, csvFields[5].start);
             continue;
         }
         
-        // Field 6: SubcategoryKey
-        strncpy(currentRecord.subcategoryKey, csvFields[6], 3);
-        currentRecord.subcategoryKey[3] = '\0';
-        
-        // Field 7: Subcategory
-        strncpy(currentRecord.subcategory, csvFields[7], 9);
-        currentRecord.subcategory[9] = '\0';
-        
-        // Field 8: CategoryKey
-        strncpy(currentRecord.categoryKey, csvFields[8], 1);
-        currentRecord.categoryKey[1] = '\0';
-        
-        // Field 9: Category
-        strncpy(currentRecord.category, csvFields[9], 19);
-        currentRecord.category[19] = '\0';
+        // Fields 6-9: SubcategoryKey, Subcategory, CategoryKey, Category
+        CopyCsvField(currentRecord->subcategoryKey, 3, &csvFields[6]);
+        CopyCsvField(currentRecord->categoryKey, 1, &csvFields[8]);
+        InitializeStructureToZero(categoryText, sizeof(categoryText));
+        CopyCsvField(categoryText, 19, &csvFields[9]);
         
         // Remove trailing whitespace from category
-        int categoryLength = strlen(currentRecord.category);
-        while (categoryLength > 0 && (currentRecord.category[categoryLength - 1] == ' ' || 
-               currentRecord.category[categoryLength - 1] == '\t' || currentRecord.category[categoryLength - 1] == '\r' || 
-               currentRecord.category[categoryLength - 1] == '\n')) {
-            currentRecord.category[categoryLength - 1] = '\0';
+        categoryLength = (int)strlen(categoryText);
+        while (categoryLength > 0 && (categoryText[categoryLength - 1] == ' ' || 
+               categoryText[categoryLength - 1] == '\t')) {
+            categoryText[categoryLength - 1] = '\0';
             categoryLength--;
         }
         
-        // Write the record to binary file
-        if (fwrite(&currentRecord, sizeof(productRecord), 1, binaryFilePointer) != 1) {
-            printf("Error: Failed to write product record %d to binary file\n", recordCount + 1);
+        if (EncodeCsvField(&currentRecord->subcategory, 9, BINARY_TABLE_PRODUCTS, PRODUCT_DICTIONARY_SUBCATEGORY, &csvFields[7]) == 0 ||
+            EncodeDictionaryValue(BINARY_TABLE_PRODUCTS, PRODUCT_DICTIONARY_CATEGORY, categoryText, &currentRecord->category) == 0) {
+            errorOccurred = 1;
+            returnValue = -1;
+            continue;
+        }
+        
+        // Keep the record and write a full batch
+        batchCount++;
+        recordCount++;
+        if (batchCount == CSV_WRITE_BATCH_RECORDS &&
+            FlushRecordBatch(binaryFilePointer, batchRecords, sizeof(productRecord), &batchCount) == 0) {
+            printf("Error: Failed to write product records to binary file\n");
             errorOccurred = 1;
             returnValue = -1;
-        } else {
-            recordCount++;
         }
     }
     
+    if (errorOccurred == 0 &&
+        FlushRecordBatch(binaryFilePointer, batchRecords, sizeof(productRecord), &batchCount) == 0) {
+        printf("Error: Failed to write product records to binary file\n");
+        errorOccurred = 1;
+        returnValue = -1;
+    }
+    free(batchRecords);
+    
     if (errorOccurred == 0) {
         printf("Products conversion completed: %d records processed\n", recordCount);
         returnValue = recordCount;
@@ -6129,21 +11347,23 @@ int ConvertProductsCsvToBinary(FILE* csvFilePointer, FILE* binaryFilePointer) {
 /*
  * Function: ConstructDatabaseTables
  * Purpose: Converts CSV files to binary format and sets up database tables
- * Parameters: salesFilePointer - pointer to sales CSV file
- *            customersFilePointer - pointer to customers CSV file
- *            exchangeRatesFilePointer - pointer to exchange rates CSV file
- *            productsFilePointer - pointer to products CSV file
- *            storesFilePointer - pointer to stores CSV file
- * Returns: void
- * Note: Main coordination function for database construction
- */
-void ConstructDatabaseTables(
-    FILE *salesFilePointer,
-    FILE *customersFilePointer,
-    FILE *exchangeRatesFilePointer,
-    FILE *productsFilePointer,
-    FILE *storesFilePointer
+ * Parameters: salesCsvFile - reader over the sales CSV file
+ *            customersCsvFile - reader over the customers CSV file
+ *            exchangeRatesCsvFile - reader over the exchange rates CSV file
+ *            productsCsvFile - reader over the products CSV file
+ *            storesCsvFile - reader over the stores CSV file
+ * Returns: int - 1 if every table was built, 0 if any step failed
+ * Note: Main coordination function for database construction. Closes the readers.
+ */
+int ConstructDatabaseTables(
+    csvReader *salesCsvFile,
+    csvReader *customersCsvFile,
+    csvReader *exchangeRatesCsvFile,
+    csvReader *productsCsvFile,
+    csvReader *storesCsvFile
 ) {
+    int returnValue = 1;                               // Return value (0 once any step fails)
+    
     printf("Starting database construction from CSV files...\n");
     
     // Open binary files for writing
@@ -6164,56 +11384,631 @@ void ConstructDatabaseTables(
         if (exchangeRatesBinaryFile != NULL) fclose(exchangeRatesBinaryFile);
         if (productsBinaryFile != NULL) fclose(productsBinaryFile);
         if (storesBinaryFile != NULL) fclose(storesBinaryFile);
-        return;
+        CloseCsvReader(storesCsvFile);
+        CloseCsvReader(productsCsvFile);
+        CloseCsvReader(exchangeRatesCsvFile);
+        CloseCsvReader(customersCsvFile);
+        CloseCsvReader(salesCsvFile);
+        return 0;
+    }
+    
+    // Convert all five tables concurrently; Sales runs on this thread and splits itself into chunks
+    tableConversionTask conversions[5];
+    conversions[0].converter = ConvertSalesCsvToBinary;
+    conversions[0].csvFile = salesCsvFile;
+    conversions[0].binaryFile = salesBinaryFile;
+    conversions[1].converter = ConvertCustomersCsvToBinary;
+    conversions[1].csvFile = customersCsvFile;
+    conversions[1].binaryFile = customersBinaryFile;
+    conversions[2].converter = ConvertStoresCsvToBinary;
+    conversions[2].csvFile = storesCsvFile;
+    conversions[2].binaryFile = storesBinaryFile;
+    conversions[3].converter = ConvertExchangeRatesCsvToBinary;
+    conversions[3].csvFile = exchangeRatesCsvFile;
+    conversions[3].binaryFile = exchangeRatesBinaryFile;
+    conversions[4].converter = ConvertProductsCsvToBinary;
+    conversions[4].csvFile = productsCsvFile;
+    conversions[4].binaryFile = productsBinaryFile;
+    
+    // Reserve each table's header (conversions are in BINARY_TABLE_* order); the rows follow it
+    tableHeader placeholderHeader;
+    for (int tableId = 0; tableId < BINARY_TABLE_COUNT; tableId++) {
+        if (binaryTableSchemas[tableId].dictionaryFileName != NULL) {
+            ResetTableDictionary(tableId);
+        }
+        InitializeTableHeader(&placeholderHeader, tableId);
+        if (WriteTableHeader(conversions[tableId].binaryFile, &placeholderHeader) == 0) {
+            printf("Error: Cannot write the table header of %s\n", binaryTableSchemas[tableId].fileName);
+            returnValue = 0;
+        }
+    }
+    RunWorkerTasks(ConvertTableWorker, conversions, sizeof(tableConversionTask), 5);
+    
+    int salesRecordCount = conversions[0].recordCount;
+    if (salesRecordCount < 0) {
+        printf("Error: Sales conversion failed\n");
+        returnValue = 0;
+    }
+    if (conversions[1].recordCount < 0) {
+        printf("Error: Customers conversion failed\n");
+        returnValue = 0;
+    }
+    if (conversions[2].recordCount < 0) {
+        printf("Error: Stores conversion failed\n");
+        returnValue = 0;
+    }
+    if (conversions[3].recordCount < 0) {
+        printf("Error: Exchange Rates conversion failed\n");
+        returnValue = 0;
+    }
+    if (conversions[4].recordCount < 0) {
+        printf("Error: Products conversion failed\n");
+        returnValue = 0;
+    }
+    
+    // Close all binary files
+    fclose(salesBinaryFile);
+    fclose(customersBinaryFile);
+    fclose(exchangeRatesBinaryFile);
+    fclose(productsBinaryFile);
+    fclose(storesBinaryFile);
+    
+    // Record row counts, sort order and column ranges in each header, and save the dictionaries
+    for (int tableId = 0; tableId < BINARY_TABLE_COUNT; tableId++) {
+        if (conversions[tableId].recordCount >= 0 &&
+            FinalizeTableHeader(binaryTableSchemas[tableId].fileName, tableId, 0, conversions[tableId].recordCount) < 0) {
+            returnValue = 0;
+        }
+        if (binaryTableSchemas[tableId].dictionaryFileName != NULL &&
+            (conversions[tableId].recordCount < 0 || SaveTableDictionary(tableId) == 0)) {
+            InvalidateTableDictionary(tableId);
+            returnValue = 0;
+        }
+    }
+    
+    // Tables were rebuilt - drop cached dimension data
+    InvalidateProductDimension();
+    InvalidateExchangeRateMatrix();
+    InvalidateSalesScanAggregates();
+    
+    // Write the column-per-file copy of the sales table used by projected scans
+    if (salesRecordCount >= 0 && BuildSalesColumnarTable() < 0) {
+        printf("Error: Sales columnar copy failed\n");
+        returnValue = 0;
+    }
+    
+    // Record the value ranges of each sales block for filtered scans
+    if (salesRecordCount >= 0 && BuildSalesZoneMap() < 0) {
+        printf("Error: Sales zone map construction failed\n");
+        returnValue = 0;
+    }
+    
+    // Build customerKey index for joins that cannot hold the customer table in memory
+    long customersIndexed = BuildBPlusTreeIndex("CustomersTable.dat", "CustomersTable.idx",
+                                                sizeof(customerRecord), ExtractCustomerJoinKey);
+    if (customersIndexed < 0) {
+        printf("Error: Customers index construction failed\n");
+        returnValue = 0;
+    }
+    
+    // Map customer names to their customerKey and sales rows for single-customer listings
+    if (salesRecordCount >= 0 && BuildCustomerNameIndex() < 0) {
+        printf("Error: Customer name index construction failed\n");
+        returnValue = 0;
+    }
+    
+    // Close CSV files
+    CloseCsvReader(storesCsvFile);
+    CloseCsvReader(productsCsvFile);
+    CloseCsvReader(exchangeRatesCsvFile);
+    CloseCsvReader(customersCsvFile);
+    CloseCsvReader(salesCsvFile);
+    
+    printf("Database construction completed.\n");
+    return returnValue;
+} // end function definition ConstructDatabaseTables
+
+/*
+ * Function: BuildDatabaseFromCsvFiles
+ * Purpose: Opens the five dataset CSV files and builds the binary tables from them
+ * Parameters: None
+ * Returns: int - 1 if the database was built, 0 on error
+ * Note: Shared by menu option 1 and the "build" command line
+ */
+int BuildDatabaseFromCsvFiles(void) {
+    csvReader salesCsvFile;                            // Sales transaction data
+    csvReader customersCsvFile;                        // Customer information data
+    csvReader exchangeRatesCsvFile;                    // Currency exchange rates data
+    csvReader productsCsvFile;                         // Product catalog data
+    csvReader storesCsvFile;                           // Store location data
+    int filesOpened = 0;                               // Number of CSV files mapped
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    // Map source CSV files for reading with error checking
+    filesOpened += OpenCsvReader(&salesCsvFile, "Sales.csv");
+    filesOpened += OpenCsvReader(&customersCsvFile, "Customers.csv");
+    filesOpened += OpenCsvReader(&exchangeRatesCsvFile, "Exchange_Rates.csv");
+    filesOpened += OpenCsvReader(&productsCsvFile, "Products.csv");
+    filesOpened += OpenCsvReader(&storesCsvFile, "Stores.csv");
+    
+    // Check if all CSV files opened successfully
+    if (filesOpened == 5) {
+        // All files opened successfully, proceed with conversion
+        returnValue = ConstructDatabaseTables(&salesCsvFile, &customersCsvFile, &exchangeRatesCsvFile,
+                                              &productsCsvFile, &storesCsvFile);
+    } else {
+        printf("Error: Could not open all required CSV files\n");
+        // Close any files that did open
+        CloseCsvReader(&salesCsvFile);
+        CloseCsvReader(&customersCsvFile);
+        CloseCsvReader(&exchangeRatesCsvFile);
+        CloseCsvReader(&productsCsvFile);
+        CloseCsvReader(&storesCsvFile);
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition BuildDatabaseFromCsvFiles
+
+// ====================== INCREMENTAL APPEND ======================
+// Daily loads append delta CSV files (same header and columns as the full files) to the
+// existing tables instead of rebuilding them. Each delta is converted into a staging file
+// and checked against the tables it references; only a fully valid load is appended, so a
+// rejected load leaves every table unchanged. Derived files and caches are then extended
+// with the new rows only.
+#define APPEND_COPY_BUFFER_BYTES (64 * 1024)          // Staging file bytes copied per write
+#define APPEND_MAX_REPORTED_PROBLEMS 10               // Rejected rows listed individually
+
+static const char* appendDeltaFiles[BINARY_TABLE_COUNT] = {
+    "Sales_delta.csv", "Customers_delta.csv", "Stores_delta.csv", "Exchange_Rates_delta.csv", "Products_delta.csv"
+};                                                    // Delta CSV file of each table
+
+/*
+ * Function: SetAppendDeltaFile
+ * Purpose: Selects the delta CSV file appended to one table
+ * Parameters: tableId - BINARY_TABLE_* id
+ *            fileName - delta CSV file (must stay valid until the append runs)
+ * Returns: void
+ */
+void SetAppendDeltaFile(int tableId, const char* fileName) {
+    appendDeltaFiles[tableId] = fileName;
+}//end function definition SetAppendDeltaFile
+
+/*
+ * Function: AppendStagingFile
+ * Purpose: Appends the records of a staging file after the last record of a table
+ * Parameters: stagingFileName - converted delta records
+ *            tableId - BINARY_TABLE_* id of the table to extend
+ *            existingRecords - rows in the table before the append
+ * Returns: int - 1 if every record was appended and the header updated, 0 on error
+ * Note: The records are written first and the table header last, so a failed copy
+ *       leaves the header describing only the original rows
+ */
+int AppendStagingFile(const char* stagingFileName, int tableId, long existingRecords) {
+    const binaryTableSchema* schema = &binaryTableSchemas[tableId]; // Table layout
+    FILE* stagingFile = NULL;                          // Converted delta records
+    FILE* tableFile = NULL;                            // Table being extended
+    tableHeader stagingHeader;                         // Header of the staging file
+    unsigned char* copyBuffer = NULL;                  // Bytes in transit
+    long long appendOffset = 0;                        // Byte offset after the last existing row
+    long long bytesLeft = 0;                           // Record bytes still to copy
+    size_t bytesRead = 0;                              // Bytes in copyBuffer
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    stagingFile = OpenBinaryTable(stagingFileName, schema->recordSize, &stagingHeader);
+    tableFile = OpenFileWithErrorCheck(schema->fileName, "rb+");
+    copyBuffer = (unsigned char*)malloc(APPEND_COPY_BUFFER_BYTES);
+    appendOffset = (long long)sizeof(tableHeader) + (long long)existingRecords * (long long)schema->recordSize;
+    if (stagingFile == NULL || tableFile == NULL || copyBuffer == NULL ||
+        CountedSeek64(tableFile, appendOffset, SEEK_SET) != 0) {
+        errorOccurred = 1;
+    } else {
+        bytesLeft = stagingHeader.rowCount * (long long)schema->recordSize;
+    }
+    
+    while (errorOccurred == 0 && bytesLeft > 0) {
+        bytesRead = CountedRead(copyBuffer, 1,
+                                bytesLeft < APPEND_COPY_BUFFER_BYTES ? (size_t)bytesLeft : APPEND_COPY_BUFFER_BYTES,
+                                stagingFile);
+        if (bytesRead == 0 || CountedWrite(copyBuffer, 1, bytesRead, tableFile) != bytesRead) {
+            errorOccurred = 1;
+        }
+        bytesLeft -= (long long)bytesRead;
+    }
+    
+    if (stagingFile != NULL) fclose(stagingFile);
+    if (tableFile != NULL && fclose(tableFile) != 0) {
+        errorOccurred = 1;
+    }
+    free(copyBuffer);
+    
+    if (errorOccurred == 0 &&
+        FinalizeTableHeader(schema->fileName, tableId, existingRecords, existingRecords + (long)stagingHeader.rowCount) < 0) {
+        errorOccurred = 1;
+    }
+    
+    if (errorOccurred == 0) {
+        returnValue = 1;
+    } else {
+        printf("Error: Cannot append %s to %s\n", stagingFileName, schema->fileName);
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition AppendStagingFile
+
+/*
+ * Function: ValidateAppendDelta
+ * Purpose: Checks converted delta records against the existing tables and each other
+ * Parameters: stagingFileNames - staging file of each table id
+ *            deltaRecords - records in each staging file (0 = no delta for that table)
+ * Returns: long - number of problems found (0 = the delta can be appended), -1 on error
+ * Note: New customers, stores and products must not reuse a key of the table or of the
+ *       delta; such a key would be shadowed by the first row in every lookup. New sales
+ *       whose customer, store or product is neither in the table nor in the delta are
+ *       listed as warnings only: the build keeps such sales too (rows it cannot parse,
+ *       like the online store, never reach the dimension tables) and the reports treat
+ *       them as unmatched. Existing customers are probed through CustomersTable.idx and
+ *       products through the product dimension cache, so the cost grows with the delta,
+ *       not with the tables. Exchange rates have no keys to check.
+ */
+long ValidateAppendDelta(char stagingFileNames[BINARY_TABLE_COUNT][40], const long deltaRecords[BINARY_TABLE_COUNT]) {
+    HashJoinTable existingCustomers;                   // CustomersTable.dat through its index
+    HashJoinTable existingStores;                      // StoresTable.dat
+    HashJoinTable newCustomers;                        // Customers of the delta
+    HashJoinTable newStores;                           // Stores of the delta
+    HashJoinTable newProducts;                         // Products of the delta
+    mappedTable stagedRecords;                         // Staging file being checked
+    const salesRecord* sale = NULL;                    // Current staged sale
+    const customerRecord* customer = NULL;             // Current staged customer
+    const storeRecord* store = NULL;                   // Current staged store
+    const productRecord* product = NULL;               // Current staged product
+    long problemCount = 0;                             // Problems found
+    long referenceCount = 0;                           // Unknown dimension references of new sales
+    int errorOccurred = 0;                             // Error flag
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    InitializeStructureToZero(&existingCustomers, sizeof(HashJoinTable));
+    InitializeStructureToZero(&existingStores, sizeof(HashJoinTable));
+    InitializeStructureToZero(&newCustomers, sizeof(HashJoinTable));
+    InitializeStructureToZero(&newStores, sizeof(HashJoinTable));
+    InitializeStructureToZero(&newProducts, sizeof(HashJoinTable));
+    InitializeStructureToZero(&stagedRecords, sizeof(mappedTable));
+    
+    // Lookup sides: existing keys, then the keys arriving with the delta
+    if (OpenIndexedJoinTable(&existingCustomers, "CustomersTable.dat", "CustomersTable.idx", sizeof(customerRecord)) < 0) {
+        printf("Rebuilding index CustomersTable.idx...\n");
+        if (BuildBPlusTreeIndex("CustomersTable.dat", "CustomersTable.idx", sizeof(customerRecord), ExtractCustomerJoinKey) < 0 ||
+            OpenIndexedJoinTable(&existingCustomers, "CustomersTable.dat", "CustomersTable.idx", sizeof(customerRecord)) < 0) {
+            errorOccurred = 1;
+        }
+    }
+    if (errorOccurred == 0 &&
+        (BuildHashJoinTable(&existingStores, "StoresTable.dat", sizeof(storeRecord), ExtractStoreJoinKey) < 0 ||
+         LoadProductDimension() == 0)) {
+        errorOccurred = 1;
+    }
+    if (errorOccurred == 0 && deltaRecords[BINARY_TABLE_CUSTOMERS] > 0 &&
+        BuildHashJoinTable(&newCustomers, stagingFileNames[BINARY_TABLE_CUSTOMERS], sizeof(customerRecord),
+                           ExtractCustomerJoinKey) < 0) {
+        errorOccurred = 1;
+    }
+    if (errorOccurred == 0 && deltaRecords[BINARY_TABLE_STORES] > 0 &&
+        BuildHashJoinTable(&newStores, stagingFileNames[BINARY_TABLE_STORES], sizeof(storeRecord),
+                           ExtractStoreJoinKey) < 0) {
+        errorOccurred = 1;
+    }
+    if (errorOccurred == 0 && deltaRecords[BINARY_TABLE_PRODUCTS] > 0 &&
+        BuildHashJoinTable(&newProducts, stagingFileNames[BINARY_TABLE_PRODUCTS], sizeof(productRecord),
+                           ExtractProductJoinKey) < 0) {
+        errorOccurred = 1;
+    }
+    
+    // Keys repeated inside the delta collapse into one hash table entry
+    if (errorOccurred == 0) {
+        problemCount += deltaRecords[BINARY_TABLE_CUSTOMERS] - newCustomers.entryCount;
+        problemCount += deltaRecords[BINARY_TABLE_STORES] - newStores.entryCount;
+        problemCount += deltaRecords[BINARY_TABLE_PRODUCTS] - newProducts.entryCount;
+        if (problemCount > 0) {
+            printf("Error: The delta repeats %ld customer, store or product keys\n", problemCount);
+        }
+    }
+    
+    // New dimension rows must not reuse an existing key
+    if (errorOccurred == 0 && deltaRecords[BINARY_TABLE_CUSTOMERS] > 0) {
+        if (OpenMappedBinaryTable(&stagedRecords, stagingFileNames[BINARY_TABLE_CUSTOMERS], sizeof(customerRecord),
+                                  TABLE_ACCESS_SEQUENTIAL, NULL) == 0) {
+            errorOccurred = 1;
+        }
+        for (long i = 0; i < stagedRecords.recordCount && errorOccurred == 0; i++) {
+            customer = (const customerRecord*)MappedRecordAt(&stagedRecords, i);
+            if (ProbeHashJoinTable(&existingCustomers, customer->customerKey) != NULL) {
+                if (problemCount < APPEND_MAX_REPORTED_PROBLEMS) {
+                    printf("Error: Delta customer %u already exists\n", customer->customerKey);
+                }
+                problemCount++;
+            }
+        }
+        CloseMappedTable(&stagedRecords);
+    }
+    if (errorOccurred == 0 && deltaRecords[BINARY_TABLE_STORES] > 0) {
+        if (OpenMappedBinaryTable(&stagedRecords, stagingFileNames[BINARY_TABLE_STORES], sizeof(storeRecord),
+                                  TABLE_ACCESS_SEQUENTIAL, NULL) == 0) {
+            errorOccurred = 1;
+        }
+        for (long i = 0; i < stagedRecords.recordCount && errorOccurred == 0; i++) {
+            store = (const storeRecord*)MappedRecordAt(&stagedRecords, i);
+            if (ProbeHashJoinTable(&existingStores, store->storeKey) != NULL) {
+                if (problemCount < APPEND_MAX_REPORTED_PROBLEMS) {
+                    printf("Error: Delta store %u already exists\n", (unsigned int)store->storeKey);
+                }
+                problemCount++;
+            }
+        }
+        CloseMappedTable(&stagedRecords);
+    }
+    if (errorOccurred == 0 && deltaRecords[BINARY_TABLE_PRODUCTS] > 0) {
+        if (OpenMappedBinaryTable(&stagedRecords, stagingFileNames[BINARY_TABLE_PRODUCTS], sizeof(productRecord),
+                                  TABLE_ACCESS_SEQUENTIAL, NULL) == 0) {
+            errorOccurred = 1;
+        }
+        for (long i = 0; i < stagedRecords.recordCount && errorOccurred == 0; i++) {
+            product = (const productRecord*)MappedRecordAt(&stagedRecords, i);
+            if (LookupProductByKey(product->productKey) != NULL) {
+                if (problemCount < APPEND_MAX_REPORTED_PROBLEMS) {
+                    printf("Error: Delta product %u already exists\n", (unsigned int)product->productKey);
+                }
+                problemCount++;
+            }
+        }
+        CloseMappedTable(&stagedRecords);
+    }
+    
+    // New sales referencing unknown dimension rows are reported; the build accepts them too
+    if (errorOccurred == 0 && deltaRecords[BINARY_TABLE_SALES] > 0) {
+        if (OpenMappedBinaryTable(&stagedRecords, stagingFileNames[BINARY_TABLE_SALES], sizeof(salesRecord),
+                                  TABLE_ACCESS_SEQUENTIAL, NULL) == 0) {
+            errorOccurred = 1;
+        }
+        for (long i = 0; i < stagedRecords.recordCount && errorOccurred == 0; i++) {
+            sale = (const salesRecord*)MappedRecordAt(&stagedRecords, i);
+            if (ProbeHashJoinTable(&newCustomers, sale->customerKey) == NULL &&
+                ProbeHashJoinTable(&existingCustomers, sale->customerKey) == NULL) {
+                if (referenceCount < APPEND_MAX_REPORTED_PROBLEMS) {
+                    printf("Warning: Delta order %ld line %u references unknown customer %u\n",
+                           sale->orderNumber, (unsigned int)sale->lineItem, sale->customerKey);
+                }
+                referenceCount++;
+            }
+            if (ProbeHashJoinTable(&newStores, sale->storeKey) == NULL &&
+                ProbeHashJoinTable(&existingStores, sale->storeKey) == NULL) {
+                if (referenceCount < APPEND_MAX_REPORTED_PROBLEMS) {
+                    printf("Warning: Delta order %ld line %u references unknown store %u\n",
+                           sale->orderNumber, (unsigned int)sale->lineItem, (unsigned int)sale->storeKey);
+                }
+                referenceCount++;
+            }
+            if (ProbeHashJoinTable(&newProducts, sale->productKey) == NULL &&
+                LookupProductByKey(sale->productKey) == NULL) {
+                if (referenceCount < APPEND_MAX_REPORTED_PROBLEMS) {
+                    printf("Warning: Delta order %ld line %u references unknown product %u\n",
+                           sale->orderNumber, (unsigned int)sale->lineItem, (unsigned int)sale->productKey);
+                }
+                referenceCount++;
+            }
+        }
+        CloseMappedTable(&stagedRecords);
+        if (referenceCount > 0) {
+            printf("Warning: %ld references of new sales have no customer, store or product row\n", referenceCount);
+        }
+    }
+    
+    FreeHashJoinTable(&existingCustomers);
+    FreeHashJoinTable(&existingStores);
+    FreeHashJoinTable(&newCustomers);
+    FreeHashJoinTable(&newStores);
+    FreeHashJoinTable(&newProducts);
+    
+    if (errorOccurred == 0) {
+        returnValue = problemCount;
+    } else {
+        printf("Error: Cannot open the tables needed to validate the delta\n");
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition ValidateAppendDelta
+
+/*
+ * Function: AppendDeltaCsvFiles
+ * Purpose: Appends the delta CSV files that exist to the binary tables
+ * Parameters: None
+ * Returns: int - 1 if the delta was appended, 0 if it was rejected or on error
+ * Note: Shared by menu option 8 and the "append" command line. Tables whose delta file
+ *       does not exist are left alone. The deltas are converted concurrently into staging
+ *       files with the build's converters and validated with ValidateAppendDelta before
+ *       any table is touched. After appending, CustomersTable.idx gets the new customers
+ *       inserted, the sales columnar copy gets the new rows, and the cached Report 3/4
+ *       aggregates are extended with the new sales; only caches of dimensions that grew
+ *       are dropped. Dimension tables are appended before SalesTable.dat.
+ */
+int AppendDeltaCsvFiles(void) {
+    csvReader deltaCsvFiles[BINARY_TABLE_COUNT];       // Delta CSV files
+    FILE* stagingFiles[BINARY_TABLE_COUNT] = {NULL};   // Converted delta records
+    char stagingFileNames[BINARY_TABLE_COUNT][40];     // Staging file of each table
+    tableConversionTask conversions[BINARY_TABLE_COUNT]; // Conversions of the deltas found
+    int conversionTables[BINARY_TABLE_COUNT] = {0};    // Table id of each conversion
+    static int (* const converters[BINARY_TABLE_COUNT])(csvReader*, FILE*) = {
+        ConvertSalesCsvToBinary, ConvertCustomersCsvToBinary, ConvertStoresCsvToBinary,
+        ConvertExchangeRatesCsvToBinary, ConvertProductsCsvToBinary
+    };                                                 // Converter of each table
+    static const int appendOrder[BINARY_TABLE_COUNT] = {
+        BINARY_TABLE_CUSTOMERS, BINARY_TABLE_STORES, BINARY_TABLE_EXCHANGE_RATES,
+        BINARY_TABLE_PRODUCTS, BINARY_TABLE_SALES
+    };                                                 // Dimensions first, facts last
+    long existingRecords[BINARY_TABLE_COUNT] = {0};    // Records in each table before the append
+    long deltaRecords[BINARY_TABLE_COUNT] = {0};       // Records converted from each delta
+    tableHeader stagingHeader;                         // Placeholder header of a staging file
+    long problemCount = 0;                             // Validation problems
+    int conversionCount = 0;                           // Deltas found
+    int tablesAppended = 0;                            // Tables already extended
+    int tableId = 0;                                   // Table being appended
+    FILE* probeFile = NULL;                            // Existence check of a delta file
+    int errorOccurred = 0;                             // Error flag
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    for (tableId = 0; tableId < BINARY_TABLE_COUNT; tableId++) {
+        InitializeStructureToZero(&deltaCsvFiles[tableId], sizeof(csvReader));
+        sprintf(stagingFileNames[tableId], "temp_append_%d.dat", tableId);
+    }
+    
+    // The tables must exist; their record counts mark where the new rows start
+    for (tableId = 0; tableId < BINARY_TABLE_COUNT && errorOccurred == 0; tableId++) {
+        existingRecords[tableId] = CountTableRecords(binaryTableSchemas[tableId].fileName, binaryTableSchemas[tableId].recordSize);
+        if (existingRecords[tableId] < 0) {
+            printf("Error: Construct the database (option 1) before appending to it\n");
+            errorOccurred = 1;
+        }
+    }
+    
+    // Convert every delta that exists into its staging file
+    for (tableId = 0; tableId < BINARY_TABLE_COUNT && errorOccurred == 0; tableId++) {
+        probeFile = fopen(appendDeltaFiles[tableId], "rb");
+        if (probeFile == NULL) {
+            printf("No %s, %s unchanged\n", appendDeltaFiles[tableId], binaryTableSchemas[tableId].fileName);
+        } else if (binaryTableSchemas[tableId].dictionaryFileName != NULL && LoadTableDictionary(tableId) == 0) {
+            fclose(probeFile);
+            errorOccurred = 1;
+        } else {
+            fclose(probeFile);
+            stagingFiles[tableId] = OpenFileWithErrorCheck(stagingFileNames[tableId], "wb");
+            InitializeTableHeader(&stagingHeader, tableId);
+            if (OpenCsvReader(&deltaCsvFiles[tableId], appendDeltaFiles[tableId]) == 0 || stagingFiles[tableId] == NULL ||
+                WriteTableHeader(stagingFiles[tableId], &stagingHeader) == 0) {
+                errorOccurred = 1;
+            } else {
+                conversions[conversionCount].converter = converters[tableId];
+                conversions[conversionCount].csvFile = &deltaCsvFiles[tableId];
+                conversions[conversionCount].binaryFile = stagingFiles[tableId];
+                conversionTables[conversionCount] = tableId;
+                conversionCount++;
+            }
+        }
+    }
+    if (errorOccurred == 0 && conversionCount == 0) {
+        printf("Error: No delta CSV files found\n");
+        errorOccurred = 1;
     }
     
-    // Convert Sales CSV to binary
-    int salesRecordCount = ConvertSalesCsvToBinary(salesFilePointer, salesBinaryFile);
-    if (salesRecordCount < 0) {
-        printf("Error: Sales conversion failed\n");
+    if (errorOccurred == 0) {
+        RunWorkerTasks(ConvertTableWorker, conversions, sizeof(tableConversionTask), conversionCount);
+        for (int i = 0; i < conversionCount; i++) {
+            deltaRecords[conversionTables[i]] = conversions[i].recordCount;
+            if (conversions[i].recordCount < 0) {
+                printf("Error: Conversion of %s failed\n", appendDeltaFiles[conversionTables[i]]);
+                errorOccurred = 1;
+            }
+        }
+    }
+    for (tableId = 0; tableId < BINARY_TABLE_COUNT; tableId++) {
+        if (stagingFiles[tableId] != NULL && fclose(stagingFiles[tableId]) != 0) {
+            errorOccurred = 1;
+        }
+        CloseCsvReader(&deltaCsvFiles[tableId]);
+    }
+    for (tableId = 0; tableId < BINARY_TABLE_COUNT && errorOccurred == 0; tableId++) {
+        if (deltaRecords[tableId] > 0 &&
+            FinalizeTableHeader(stagingFileNames[tableId], tableId, 0, deltaRecords[tableId]) < 0) {
+            errorOccurred = 1;
+        }
     }
     
-    // Convert Customers CSV to binary
-    int customersCount = ConvertCustomersCsvToBinary(customersFilePointer, customersBinaryFile);
-    if (customersCount < 0) {
-        printf("Error: Customers conversion failed\n");
+    // Reject the whole load if any new key conflicts
+    if (errorOccurred == 0) {
+        problemCount = ValidateAppendDelta(stagingFileNames, deltaRecords);
+        if (problemCount != 0) {
+            if (problemCount > 0) {
+                printf("Error: Delta rejected, %ld problems found; no table was changed\n", problemCount);
+            }
+            errorOccurred = 1;
+        }
     }
     
-    // Convert Stores CSV to binary
-    int storesCount = ConvertStoresCsvToBinary(storesFilePointer, storesBinaryFile);
-    if (storesCount < 0) {
-        printf("Error: Stores conversion failed\n");
+    // New dictionary values must be on disk before any record that uses them
+    for (tableId = 0; tableId < BINARY_TABLE_COUNT && errorOccurred == 0; tableId++) {
+        if (deltaRecords[tableId] > 0 && binaryTableSchemas[tableId].dictionaryFileName != NULL &&
+            SaveTableDictionary(tableId) == 0) {
+            errorOccurred = 1;
+        }
     }
     
-    // Convert Exchange Rates CSV to binary
-    int exchangeRatesCount = ConvertExchangeRatesCsvToBinary(exchangeRatesFilePointer, exchangeRatesBinaryFile);
-    if (exchangeRatesCount < 0) {
-        printf("Error: Exchange Rates conversion failed\n");
+    for (int i = 0; i < BINARY_TABLE_COUNT && errorOccurred == 0; i++) {
+        tableId = appendOrder[i];
+        if (deltaRecords[tableId] > 0) {
+            if (AppendStagingFile(stagingFileNames[tableId], tableId, existingRecords[tableId]) == 0) {
+                errorOccurred = 1;
+            } else {
+                tablesAppended++;
+            }
+        }
     }
     
-    // Convert Products CSV to binary
-    int productsCount = ConvertProductsCsvToBinary(productsFilePointer, productsBinaryFile);
-    if (productsCount < 0) {
-        printf("Error: Products conversion failed\n");
+    // Extend derived files and caches with the new rows only
+    if (errorOccurred == 0) {
+        if (deltaRecords[BINARY_TABLE_CUSTOMERS] > 0 &&
+            AppendBPlusTreeIndex("CustomersTable.dat", "CustomersTable.idx", sizeof(customerRecord),
+                                 ExtractCustomerJoinKey, existingRecords[BINARY_TABLE_CUSTOMERS]) < 0) {
+            printf("Error: Customers index update failed\n");
+            errorOccurred = 1;
+        }
+        if (deltaRecords[BINARY_TABLE_PRODUCTS] > 0) {
+            InvalidateProductDimension();
+        }
+        if (deltaRecords[BINARY_TABLE_EXCHANGE_RATES] > 0) {
+            InvalidateExchangeRateMatrix();
+        }
+        if (deltaRecords[BINARY_TABLE_SALES] > 0 && AppendSalesColumnarTable() < 0) {
+            printf("Error: Sales columnar copy failed\n");
+            errorOccurred = 1;
+        }
+        if (deltaRecords[BINARY_TABLE_SALES] > 0 && AppendSalesZoneMap() < 0) {
+            printf("Error: Sales zone map update failed\n");
+            errorOccurred = 1;
+        }
+        if ((deltaRecords[BINARY_TABLE_SALES] > 0 || deltaRecords[BINARY_TABLE_CUSTOMERS] > 0) &&
+            AppendCustomerNameIndex() < 0) {
+            printf("Error: Customer name index update failed\n");
+            errorOccurred = 1;
+        }
+        
+        // New products or customers can change how earlier sales aggregate
+        if (deltaRecords[BINARY_TABLE_PRODUCTS] > 0 || deltaRecords[BINARY_TABLE_CUSTOMERS] > 0) {
+            InvalidateSalesScanAggregates();
+        } else if (deltaRecords[BINARY_TABLE_SALES] > 0) {
+            ExtendSalesScanAggregates(existingRecords[BINARY_TABLE_SALES]);
+        }
     }
     
-    // Close all binary files
-    fclose(salesBinaryFile);
-    fclose(customersBinaryFile);
-    fclose(exchangeRatesBinaryFile);
-    fclose(productsBinaryFile);
-    fclose(storesBinaryFile);
+    for (tableId = 0; tableId < BINARY_TABLE_COUNT; tableId++) {
+        remove(stagingFileNames[tableId]);
+        if (errorOccurred == 1 && binaryTableSchemas[tableId].dictionaryFileName != NULL) {
+            InvalidateTableDictionary(tableId);    // Drop values of a rejected delta
+        }
+    }
+    if (errorOccurred == 1 && tablesAppended > 0) {
+        // Part of the delta is in the tables - nothing cached can be trusted
+        InvalidateProductDimension();
+        InvalidateExchangeRateMatrix();
+        InvalidateSalesScanAggregates();
+    }
     
-    // Close CSV files
-    fclose(storesFilePointer);
-    fclose(productsFilePointer);
-    fclose(exchangeRatesFilePointer);
-    fclose(customersFilePointer);
-    fclose(salesFilePointer);
+    if (errorOccurred == 0) {
+        printf("Append completed: %ld sales, %ld customers, %ld stores, %ld exchange rates, %ld products added\n",
+               deltaRecords[BINARY_TABLE_SALES], deltaRecords[BINARY_TABLE_CUSTOMERS], deltaRecords[BINARY_TABLE_STORES],
+               deltaRecords[BINARY_TABLE_EXCHANGE_RATES], deltaRecords[BINARY_TABLE_PRODUCTS]);
+        returnValue = 1;
+    }
     
-    printf("Database construction completed.\n");
-    return;
-} // end function definition ConstructDatabaseTables
+    return returnValue;                                // Single return point
+}//end function definition AppendDeltaCsvFiles
 
 /*
  * Function: ShowMainMenu
@@ -6231,15 +12026,25 @@ void ShowMainMenu(void) {
         "2. List of ¿What types of products does the company sell, and where are customers located?\n"
         "\t2.1 Utility bubbleSort\n"
         "\t2.2 Utility mergeSort\n"
+        "\t2.3 Utility radixSort\n"
         "3. List of ¿Are there any seasonal patterns or trends for order volume or revenue?\n"
         "\t3.1 Utility bubbleSort\n"
         "\t3.2 Utility mergeSort\n"
+        "\t3.3 Utility radixSort\n"
         "4. List of ¿How long is the average delivery time in days? Has that changed over time?\n"
         "\t4.1 Utility bubbleSort\n"
         "\t4.2 Utility mergeSort\n"
+        "\t4.3 Utility radixSort\n"
         "5. List of sales order by \"Costumer Name\"+\"Order Date\"+\"ProductKey\";\n"
         "\t5.1 Utility bubbleSort\n"
         "\t5.2 Utility mergeSort\n"
+        "\t5.3 Utility radixSort\n"
+        "6. Sort worker threads and memory\n"
+        "7. Report console output\n"
+        "8. Append new data from delta CSV files\n"
+        "9. Sales totals in an order date range\n"
+        "10. Order date window for Reports 3 and 4\n"
+        "11. Sales of one customer (name index)\n"
         "What is your option: "
     );
     return;
@@ -6261,7 +12066,7 @@ void ExecuteMainProgramLoop() {
         ClearOutput();
         ShowMainMenu();
 
-        if ((scanf("%lf", &selectedOption) != 1) || selectedOption < 0.0 || selectedOption > 5.2) {
+        if ((scanf("%lf", &selectedOption) != 1) || selectedOption < 0.0 || selectedOption > 11.0) {
             printf("Invalid option. Please try again.\n");
             while (getchar() != '\n');                 // Clean input buffer to prevent infinite loop
             system("pause");
@@ -6276,30 +12081,7 @@ void ExecuteMainProgramLoop() {
             }
         else if (mainOption == 1 && subOption == 0)  // Database construction from CSV files
         {
-            // Open source CSV files for reading with error checking
-            FILE *salesCsvFile = OpenFileWithErrorCheck("Sales.csv", "r");              // Sales transaction data
-            FILE *customersCsvFile = OpenFileWithErrorCheck("Customers.csv", "r");          // Customer information data
-            FILE *exchangeRatesCsvFile = OpenFileWithErrorCheck("Exchange_Rates.csv", "r");   // Currency exchange rates data
-            FILE *productsCsvFile = OpenFileWithErrorCheck("Products.csv", "r");           // Product catalog data
-            FILE *storesCsvFile = OpenFileWithErrorCheck("Stores.csv", "r");             // Store location data
-
-            // Check if all CSV files opened successfully
-            if (salesCsvFile != NULL && customersCsvFile != NULL && 
-                exchangeRatesCsvFile != NULL && productsCsvFile != NULL && 
-                storesCsvFile != NULL) {
-                
-                // All files opened successfully, proceed with conversion
-                ConstructDatabaseTables(salesCsvFile, customersCsvFile, exchangeRatesCsvFile, productsCsvFile, storesCsvFile);
-                
-            } else {
-                printf("Error: Could not open all required CSV files\n");
-                // Close any files that did open
-                if (salesCsvFile != NULL) fclose(salesCsvFile);
-                if (customersCsvFile != NULL) fclose(customersCsvFile);
-                if (exchangeRatesCsvFile != NULL) fclose(exchangeRatesCsvFile);
-                if (productsCsvFile != NULL) fclose(productsCsvFile);
-                if (storesCsvFile != NULL) fclose(storesCsvFile);
-            }
+            BuildDatabaseFromCsvFiles();
             system("pause");
         }
         else if (mainOption == 2)  // Report: Product types and customer locations
@@ -6310,6 +12092,9 @@ void ExecuteMainProgramLoop() {
             } else if (subOption == 2) {
                 // Option 2.2: Use Merge Sort
                 GenerateReport2ProductTypesAndLocations("Merge");
+            } else if (subOption == 3) {
+                // Option 2.3: Use Radix Sort
+                GenerateReport2ProductTypesAndLocations("Radix");
             } else if (subOption == 0) {
                 // Option 2: Ask user to choose sorting method
                 int sortChoice = -1;
@@ -6317,6 +12102,7 @@ void ExecuteMainProgramLoop() {
                 printf("0. Return to main menu\n");
                 printf("1. Bubble Sort\n");
                 printf("2. Merge Sort\n");
+                printf("3. Radix Sort\n");
                 printf("Your choice: ");
                 
                 if (scanf("%d", &sortChoice) == 1) {
@@ -6326,6 +12112,8 @@ void ExecuteMainProgramLoop() {
                         GenerateReport2ProductTypesAndLocations("Bubble");
                     } else if (sortChoice == 2) {
                         GenerateReport2ProductTypesAndLocations("Merge");
+                    } else if (sortChoice == 3) {
+                        GenerateReport2ProductTypesAndLocations("Radix");
                     } else {
                         printf("Invalid sorting choice.\n");
                     }
@@ -6334,7 +12122,7 @@ void ExecuteMainProgramLoop() {
                     while (getchar() != '\n'); // Clean input buffer
                 }
             } else {
-                printf("Invalid sub-option for Report 2. Use 2.1 or 2.2\n");
+                printf("Invalid sub-option for Report 2. Use 2.1, 2.2 or 2.3\n");
             }
             system("pause");
         }
@@ -6346,6 +12134,9 @@ void ExecuteMainProgramLoop() {
             } else if (subOption == 2) {
                 // Option 3.2: Use Merge Sort
                 GenerateReport3SeasonalPatterns("Merge");
+            } else if (subOption == 3) {
+                // Option 3.3: Use Radix Sort
+                GenerateReport3SeasonalPatterns("Radix");
             } else if (subOption == 0) {
                 // Option 3: Ask user to choose sorting method
                 int sortChoice = -1;
@@ -6353,6 +12144,7 @@ void ExecuteMainProgramLoop() {
                 printf("0. Return to main menu\n");
                 printf("1. Bubble Sort\n");
                 printf("2. Merge Sort\n");
+                printf("3. Radix Sort\n");
                 printf("Your choice: ");
                 
                 if (scanf("%d", &sortChoice) == 1) {
@@ -6362,6 +12154,8 @@ void ExecuteMainProgramLoop() {
                         GenerateReport3SeasonalPatterns("Bubble");
                     } else if (sortChoice == 2) {
                         GenerateReport3SeasonalPatterns("Merge");
+                    } else if (sortChoice == 3) {
+                        GenerateReport3SeasonalPatterns("Radix");
                     } else {
                         printf("Invalid sorting choice.\n");
                     }
@@ -6370,7 +12164,7 @@ void ExecuteMainProgramLoop() {
                     while (getchar() != '\n'); // Clean input buffer
                 }
             } else {
-                printf("Invalid sub-option for Report 3. Use 3.1 or 3.2\n");
+                printf("Invalid sub-option for Report 3. Use 3.1, 3.2 or 3.3\n");
             }
             system("pause");
         }
@@ -6382,6 +12176,9 @@ void ExecuteMainProgramLoop() {
             } else if (subOption == 2) {
                 // Option 4.2: Use Merge Sort
                 GenerateReport4DeliveryTimeAnalysis("Merge");
+            } else if (subOption == 3) {
+                // Option 4.3: Use Radix Sort
+                GenerateReport4DeliveryTimeAnalysis("Radix");
             } else if (subOption == 0) {
                 // Option 4: Ask user to choose sorting method
                 int sortChoice = -1;
@@ -6389,6 +12186,7 @@ void ExecuteMainProgramLoop() {
                 printf("0. Return to main menu\n");
                 printf("1. Bubble Sort\n");
                 printf("2. Merge Sort\n");
+                printf("3. Radix Sort\n");
                 printf("Your choice: ");
                 
                 if (scanf("%d", &sortChoice) == 1) {
@@ -6398,6 +12196,8 @@ void ExecuteMainProgramLoop() {
                         GenerateReport4DeliveryTimeAnalysis("Bubble");
                     } else if (sortChoice == 2) {
                         GenerateReport4DeliveryTimeAnalysis("Merge");
+                    } else if (sortChoice == 3) {
+                        GenerateReport4DeliveryTimeAnalysis("Radix");
                     } else {
                         printf("Invalid sort choice. Please choose 0, 1 or 2.\n");
                     }
@@ -6407,7 +12207,7 @@ void ExecuteMainProgramLoop() {
                     while (getchar() != '\n'); // Clean input buffer
                 }
             } else {
-                printf("Invalid sub-option for Report 4. Use 4.1 or 4.2\n");
+                printf("Invalid sub-option for Report 4. Use 4.1, 4.2 or 4.3\n");
             }
             system("pause");
         }
@@ -6419,6 +12219,9 @@ void ExecuteMainProgramLoop() {
             } else if (subOption == 2) {
                 // Option 5.2: Use Merge Sort
                 GenerateReport5CustomerSalesListing("Merge");
+            } else if (subOption == 3) {
+                // Option 5.3: Use Radix Sort
+                GenerateReport5CustomerSalesListing("Radix");
             } else if (subOption == 0) {
                 // Option 5: Ask user to choose sorting method
                 int sortChoice = -1;
@@ -6426,6 +12229,7 @@ void ExecuteMainProgramLoop() {
                 printf("0. Return to main menu\n");
                 printf("1. Bubble Sort\n");
                 printf("2. Merge Sort\n");
+                printf("3. Radix Sort\n");
                 printf("Your choice: ");
                 
                 if (scanf("%d", &sortChoice) == 1) {
@@ -6435,6 +12239,8 @@ void ExecuteMainProgramLoop() {
                         GenerateReport5CustomerSalesListing("Bubble");
                     } else if (sortChoice == 2) {
                         GenerateReport5CustomerSalesListing("Merge");
+                    } else if (sortChoice == 3) {
+                        GenerateReport5CustomerSalesListing("Radix");
                     } else {
                         printf("Invalid sorting choice.\n");
                     }
@@ -6443,10 +12249,72 @@ void ExecuteMainProgramLoop() {
                     while (getchar() != '\n'); // Clean input buffer
                 }
             } else {
-                printf("Invalid sub-option for Report 5. Use 5.1 or 5.2\n");
+                printf("Invalid sub-option for Report 5. Use 5.1, 5.2 or 5.3\n");
+            }
+            system("pause");
+        }
+        else if (mainOption == 6 && subOption == 0)  // Sort worker thread and memory configuration
+        {
+            int threadChoice = -1;
+            int memoryChoice = -1;
+            printf("\nSort worker threads currently in use: %d\n", GetSortThreadCount());
+            printf("Enter number of threads (0 = one per processor, max %d): ", SORT_MAX_THREADS);
+            
+            if (scanf("%d", &threadChoice) == 1 && threadChoice >= 0 && threadChoice <= SORT_MAX_THREADS) {
+                SetSortThreadCount(threadChoice);
+                printf("Sorts will use %d thread(s)\n", GetSortThreadCount());
+            } else {
+                printf("Invalid number of threads.\n");
+                while (getchar() != '\n'); // Clean input buffer
+            }
+            
+            printf("\nMerge sort memory currently: %lu KB\n", (unsigned long)(GetSortMemoryBudget() / 1024));
+            printf("Enter memory in KB (%lu-%d): ", SORT_MEMORY_BUDGET_MINIMUM / 1024, SORT_MEMORY_BUDGET_MAXIMUM_KB);
+            if (scanf("%d", &memoryChoice) == 1 && memoryChoice >= (int)(SORT_MEMORY_BUDGET_MINIMUM / 1024) &&
+                memoryChoice <= SORT_MEMORY_BUDGET_MAXIMUM_KB) {
+                SetSortMemoryBudget((size_t)memoryChoice * 1024);
+                printf("Merge sorts will use %lu KB\n", (unsigned long)(GetSortMemoryBudget() / 1024));
+            } else {
+                printf("Invalid sort memory.\n");
+                while (getchar() != '\n'); // Clean input buffer
+            }
+            system("pause");
+        }
+        else if (mainOption == 7 && subOption == 0)  // Report console echo configuration
+        {
+            int echoChoice = -1;
+            printf("\nReport console output currently: %d\n", GetReportEchoMode());
+            printf("Enter mode (0 = off, 1 = header, totals and footer only, 2 = every line): ");
+            
+            if (scanf("%d", &echoChoice) == 1 && echoChoice >= REPORT_ECHO_OFF && echoChoice <= REPORT_ECHO_FULL) {
+                SetReportEchoMode(echoChoice);
+                printf("Report console output set to %d\n", GetReportEchoMode());
+            } else {
+                printf("Invalid report output mode.\n");
+                while (getchar() != '\n'); // Clean input buffer
             }
             system("pause");
         }
+        else if (mainOption == 8 && subOption == 0)  // Incremental load of delta CSV files
+        {
+            AppendDeltaCsvFiles();
+            system("pause");
+        }
+        else if (mainOption == 9 && subOption == 0)  // Sales totals over an order date window
+        {
+            SummarizeSalesInDateRange();
+            system("pause");
+        }
+        else if (mainOption == 10 && subOption == 0)  // Order date window of Reports 3 and 4
+        {
+            SelectReportDateWindow();
+            system("pause");
+        }
+        else if (mainOption == 11 && subOption == 0)  // One customer's sales through the name index
+        {
+            LookUpCustomerSales();
+            system("pause");
+        }
         else {
             printf("Invalid option selected. Please try again.\n");
             system("pause");
@@ -6455,17 +12323,783 @@ void ExecuteMainProgramLoop() {
     }
 }//end function definition ExecuteMainProgramLoop
 
+// ====================== BENCHMARK ======================
+#define BENCHMARK_MAX_SCALES 16                       // Scale factors accepted by one benchmark run
+#define BENCHMARK_MAX_ORDER_LINES 64                  // Sales lines buffered per order while scaling
+
+static int benchmarkScales[BENCHMARK_MAX_SCALES] = {1, 4, 16};  // Scale factors to run
+static int benchmarkScaleCount = 3;                   // Number of scale factors in benchmarkScales
+
+/*
+ * Function: SetBenchmarkScales
+ * Purpose: Sets the scale factors run by the benchmark
+ * Parameters: scaleList - comma-separated positive integers (e.g. "1,10,100")
+ * Returns: int - 1 if the list is valid and was applied, 0 otherwise
+ * Note: Each factor multiplies the seed Sales and Customers rows; about 1600
+ *       turns the shipped 62884 sales into 100M rows
+ */
+int SetBenchmarkScales(const char* scaleList) {
+    int parsedScales[BENCHMARK_MAX_SCALES] = {0};      // Factors parsed so far
+    int parsedCount = 0;                               // Number of factors parsed
+    int scaleValue = 0;                                // Current factor
+    int characterCount = 0;                            // Characters consumed by sscanf
+    int listValid = 1;                                 // 0 once the list is rejected
+    const char* listPosition = scaleList;              // Parse position in scaleList
+    
+    while (listValid == 1 && *listPosition != '\0') {
+        if (parsedCount < BENCHMARK_MAX_SCALES &&
+            sscanf(listPosition, "%d%n", &scaleValue, &characterCount) == 1 && scaleValue > 0) {
+            parsedScales[parsedCount++] = scaleValue;
+            listPosition += characterCount;
+            if (*listPosition == ',') {
+                listPosition++;
+            } else if (*listPosition != '\0') {
+                listValid = 0;
+            }
+        } else {
+            listValid = 0;
+        }
+    }
+    
+    if (listValid == 1 && parsedCount > 0) {
+        memcpy(benchmarkScales, parsedScales, sizeof(parsedScales));
+        benchmarkScaleCount = parsedCount;
+    } else {
+        listValid = 0;
+    }
+    
+    return listValid;
+}//end function definition SetBenchmarkScales
+
+/*
+ * Function: ReadPeakMemoryBytes
+ * Purpose: Reads the peak working set (resident memory) of this process
+ * Parameters: None
+ * Returns: unsigned long long - peak working set in bytes, 0 if unavailable
+ */
+unsigned long long ReadPeakMemoryBytes(void) {
+    PROCESS_MEMORY_COUNTERS memoryCounters;            // Process memory statistics
+    unsigned long long peakBytes = 0;                  // Return value (single return pattern)
+    
+    InitializeStructureToZero(&memoryCounters, sizeof(PROCESS_MEMORY_COUNTERS));
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(PROCESS_MEMORY_COUNTERS))) {
+        peakBytes = (unsigned long long)memoryCounters.PeakWorkingSetSize;
+    }
+    
+    return peakBytes;
+}//end function definition ReadPeakMemoryBytes
+
+/*
+ * Function: CopyCsvFile
+ * Purpose: Copies a seed CSV file unchanged into a benchmark directory
+ * Parameters: sourceFileName - seed file in the working directory
+ *            targetFileName - file to create
+ * Returns: int - 1 on success, 0 on error
+ */
+int CopyCsvFile(const char* sourceFileName, const char* targetFileName) {
+    FILE* sourceFile = NULL;                           // Seed file
+    FILE* targetFile = NULL;                           // Copy
+    char copyBuffer[65536];                            // Copy buffer
+    size_t bytesCopied = 0;                            // Bytes in copyBuffer
+    int returnValue = 0;                               // Return value (single return pattern)
+    
+    sourceFile = OpenFileWithErrorCheck(sourceFileName, "rb");
+    targetFile = OpenFileWithErrorCheck(targetFileName, "wb");
+    if (sourceFile != NULL && targetFile != NULL) {
+        returnValue = 1;
+        while ((bytesCopied = fread(copyBuffer, 1, sizeof(copyBuffer), sourceFile)) > 0) {
+            if (fwrite(copyBuffer, 1, bytesCopied, targetFile) != bytesCopied) {
+                returnValue = 0;
+            }
+        }
+    }
+    if (sourceFile != NULL) fclose(sourceFile);
+    if (targetFile != NULL) fclose(targetFile);
+    
+    return returnValue;
+}//end function definition CopyCsvFile
+
+/*
+ * Function: FindCustomerKeySpan
+ * Purpose: Finds the key offset between copies of the seed customers
+ * Parameters: None
+ * Returns: unsigned int - largest CustomerKey in Customers.csv plus one, 0 on error
+ */
+unsigned int FindCustomerKeySpan(void) {
+    FILE* customersCsvFile = NULL;                     // Seed customers
+    char csvLineBuffer[1024] = {0};                    // Current CSV line
+    unsigned int customerKey = 0;                      // Key of the current line
+    unsigned int keySpan = 0;                          // Return value (single return pattern)
+    
+    customersCsvFile = OpenFileWithErrorCheck("Customers.csv", "r");
+    if (customersCsvFile != NULL) {
+        // Skip header line
+        if (fgets(csvLineBuffer, sizeof(csvLineBuffer), customersCsvFile) != NULL) {
+            while (fgets(csvLineBuffer, sizeof(csvLineBuffer), customersCsvFile) != NULL) {
+                if (sscanf(csvLineBuffer, "%u", &customerKey) == 1 && customerKey >= keySpan) {
+                    keySpan = customerKey + 1;
+                }
+            }
+        }
+        fclose(customersCsvFile);
+    }
+    
+    return keySpan;
+}//end function definition FindCustomerKeySpan
+
+/*
+ * Function: GenerateScaledCustomersCsv
+ * Purpose: Writes scaleFactor copies of the seed customers with disjoint keys
+ * Parameters: targetFileName - Customers.csv to create
+ *            scaleFactor - number of copies
+ *            keySpan - key offset between copies (see FindCustomerKeySpan)
+ * Returns: long - customer rows written, -1 on error
+ * Note: Copy c keeps every column of the seed row and adds c * keySpan to the
+ *       key, so keys stay ascending and every attribute keeps its distribution
+ */
+long GenerateScaledCustomersCsv(const char* targetFileName, int scaleFactor, unsigned int keySpan) {
+    FILE* seedFile = NULL;                             // Seed Customers.csv
+    FILE* targetFile = NULL;                           // Generated Customers.csv
+    char csvLineBuffer[1024] = {0};                    // Current CSV line
+    char* restOfLine = NULL;                           // Line after the key column
+    unsigned int customerKey = 0;                      // Seed key
+    long rowsWritten = 0;                              // Customer rows written
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    seedFile = OpenFileWithErrorCheck("Customers.csv", "r");
+    targetFile = OpenFileWithErrorCheck(targetFileName, "w");
+    if (seedFile != NULL && targetFile != NULL &&
+        fgets(csvLineBuffer, sizeof(csvLineBuffer), seedFile) != NULL) {
+        fputs(csvLineBuffer, targetFile);              // Header line
+        
+        for (int copyIndex = 0; copyIndex < scaleFactor; copyIndex++) {
+            fseek(seedFile, 0, SEEK_SET);
+            fgets(csvLineBuffer, sizeof(csvLineBuffer), seedFile);
+            while (fgets(csvLineBuffer, sizeof(csvLineBuffer), seedFile) != NULL) {
+                restOfLine = strchr(csvLineBuffer, ',');
+                if (restOfLine != NULL && sscanf(csvLineBuffer, "%u", &customerKey) == 1) {
+                    fprintf(targetFile, "%u%s", customerKey + (unsigned int)copyIndex * keySpan, restOfLine);
+                    rowsWritten++;
+                }
+            }
+        }
+        returnValue = (ferror(targetFile) == 0) ? rowsWritten : -1;
+    }
+    if (seedFile != NULL) fclose(seedFile);
+    if (targetFile != NULL) fclose(targetFile);
+    
+    return returnValue;
+}//end function definition GenerateScaledCustomersCsv
+
+/*
+ * Function: WriteScaledSalesOrder
+ * Purpose: Writes scaleFactor copies of one seed order
+ * Parameters: targetFile - generated Sales.csv
+ *            orderLines - seed CSV lines of the order
+ *            lineCount - number of lines in orderLines
+ *            firstOrderNumber - order number of the first copy
+ *            scaleFactor - number of copies
+ *            keySpan - customer key offset between copies
+ * Returns: long - sales rows written
+ * Note: Copy c gets order number firstOrderNumber + c and the customer of
+ *       customer copy c; all other columns are kept
+ */
+long WriteScaledSalesOrder(FILE* targetFile, char orderLines[][256], int lineCount,
+                           long firstOrderNumber, int scaleFactor, unsigned int keySpan) {
+    const char* afterOrderNumber = NULL;               // Line after the order number column
+    const char* customerColumn = NULL;                 // Start of the CustomerKey column
+    const char* afterCustomer = NULL;                  // Line after the CustomerKey column
+    unsigned int customerKey = 0;                      // Seed customer key
+    int commaCount = 0;                                // Commas passed while locating columns
+    long rowsWritten = 0;                              // Return value (single return pattern)
+    
+    for (int copyIndex = 0; copyIndex < scaleFactor; copyIndex++) {
+        for (int lineIndex = 0; lineIndex < lineCount; lineIndex++) {
+            // Columns 0 (Order Number) and 4 (CustomerKey) change; Sales.csv has no quoted fields
+            afterOrderNumber = strchr(orderLines[lineIndex], ',');
+            customerColumn = afterOrderNumber;
+            commaCount = 1;
+            while (customerColumn != NULL && commaCount < 4) {
+                customerColumn = strchr(customerColumn + 1, ',');
+                commaCount++;
+            }
+            if (customerColumn != NULL) {
+                customerColumn++;
+                afterCustomer = strchr(customerColumn, ',');
+                if (afterCustomer != NULL && sscanf(customerColumn, "%u", &customerKey) == 1) {
+                    fprintf(targetFile, "%ld%.*s%u%s", firstOrderNumber + copyIndex,
+                            (int)(customerColumn - afterOrderNumber), afterOrderNumber,
+                            customerKey + (unsigned int)copyIndex * keySpan, afterCustomer);
+                    rowsWritten++;
+                }
+            }
+        }
+    }
+    
+    return rowsWritten;
+}//end function definition WriteScaledSalesOrder
+
+/*
+ * Function: GenerateScaledSalesCsv
+ * Purpose: Writes a Sales.csv with scaleFactor copies of every seed order
+ * Parameters: targetFileName - Sales.csv to create
+ *            scaleFactor - number of copies
+ *            keySpan - customer key offset between customer copies
+ * Returns: long - sales rows written, -1 on error
+ * Note: Copies of an order are written next to each other, so the file keeps
+ *       the seed's order-date order and its date, delivery lag, store, product,
+ *       quantity and currency mix. Order numbers are renumbered densely from the
+ *       first seed order so they stay unique at large scales.
+ */
+long GenerateScaledSalesCsv(const char* targetFileName, int scaleFactor, unsigned int keySpan) {
+    FILE* seedFile = NULL;                             // Seed Sales.csv
+    FILE* targetFile = NULL;                           // Generated Sales.csv
+    char csvLineBuffer[256] = {0};                     // Current CSV line
+    char orderLines[BENCHMARK_MAX_ORDER_LINES][256];   // Lines of the current seed order
+    int lineCount = 0;                                 // Lines in orderLines
+    long orderNumber = 0;                              // Order number of the current line
+    long currentOrder = -1;                            // Order number held in orderLines
+    long nextOrderNumber = 0;                          // First order number of the next copies
+    long rowsWritten = 0;                              // Sales rows written
+    long returnValue = -1;                             // Return value (single return pattern)
+    
+    seedFile = OpenFileWithErrorCheck("Sales.csv", "r");
+    targetFile = OpenFileWithErrorCheck(targetFileName, "w");
+    if (seedFile != NULL && targetFile != NULL &&
+        fgets(csvLineBuffer, sizeof(csvLineBuffer), seedFile) != NULL) {
+        fputs(csvLineBuffer, targetFile);              // Header line
+        
+        while (fgets(csvLineBuffer, sizeof(csvLineBuffer), seedFile) != NULL) {
+            if (sscanf(csvLineBuffer, "%ld", &orderNumber) == 1) {
+                if (nextOrderNumber == 0) {
+                    nextOrderNumber = orderNumber;
+                }
+                if ((orderNumber != currentOrder || lineCount == BENCHMARK_MAX_ORDER_LINES) && lineCount > 0) {
+                    rowsWritten += WriteScaledSalesOrder(targetFile, orderLines, lineCount,
+                                                         nextOrderNumber, scaleFactor, keySpan);
+                    nextOrderNumber += scaleFactor;
+                    lineCount = 0;
+                }
+                currentOrder = orderNumber;
+                strcpy(orderLines[lineCount++], csvLineBuffer);
+            }
+        }
+        if (lineCount > 0) {
+            rowsWritten += WriteScaledSalesOrder(targetFile, orderLines, lineCount,
+                                                 nextOrderNumber, scaleFactor, keySpan);
+        }
+        returnValue = (ferror(targetFile) == 0) ? rowsWritten : -1;
+    }
+    if (seedFile != NULL) fclose(seedFile);
+    if (targetFile != NULL) fclose(targetFile);
+    
+    return returnValue;
+}//end function definition GenerateScaledSalesCsv
+
+/*
+ * Function: GenerateSyntheticDataset
+ * Purpose: Writes the five source CSV files for one benchmark scale
+ * Parameters: directoryName - directory to write them to (created if missing)
+ *            scaleFactor - multiplier for Sales and Customers rows
+ * Returns: long - sales rows generated, -1 on error
+ * Note: The CSV files in the working directory are the seed. Products, Stores
+ *       and Exchange_Rates are copied unchanged: their keys are bounded
+ *       (ProductKey is 16-bit) and real catalogues do not grow with order volume.
+ */
+long GenerateSyntheticDataset(const char* directoryName, int scaleFactor) {
+    char targetFileName[300] = {0};                    // File being generated
+    const char* copiedFiles[3] = {"Products.csv", "Stores.csv", "Exchange_Rates.csv"};
+    unsigned int keySpan = 0;                          // Customer key offset between copies
+    long salesRows = -1;                               // Return value (single return pattern)
+    int errorOccurred = 0;                             // Error flag
+    
+    if (CreateDirectoryA(directoryName, NULL) == 0 && GetLastError() != ERROR_ALREADY_EXISTS) {
+        printf("Error: Cannot create directory %s\n", directoryName);
+        errorOccurred = 1;
+    }
+    
+    if (errorOccurred == 0) {
+        keySpan = FindCustomerKeySpan();
+        if (keySpan == 0 || (unsigned long long)keySpan * (unsigned long long)scaleFactor > UINT_MAX) {
+            printf("Error: Scale factor %d does not fit 32-bit customer keys\n", scaleFactor);
+            errorOccurred = 1;
+        }
+    }
+    
+    for (int fileIndex = 0; fileIndex < 3 && errorOccurred == 0; fileIndex++) {
+        sprintf(targetFileName, "%s/%s", directoryName, copiedFiles[fileIndex]);
+        if (CopyCsvFile(copiedFiles[fileIndex], targetFileName) == 0) {
+            errorOccurred = 1;
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        sprintf(targetFileName, "%s/Customers.csv", directoryName);
+        if (GenerateScaledCustomersCsv(targetFileName, scaleFactor, keySpan) < 0) {
+            errorOccurred = 1;
+        }
+    }
+    
+    if (errorOccurred == 0) {
+        sprintf(targetFileName, "%s/Sales.csv", directoryName);
+        salesRows = GenerateScaledSalesCsv(targetFileName, scaleFactor, keySpan);
+    }
+    
+    return salesRows;
+}//end function definition GenerateSyntheticDataset
+
+/*
+ * Function: RunBenchmark
+ * Purpose: Generates each benchmark scale, then times the build and Reports 2-5 on it
+ * Parameters: sortType - sort algorithm used by the reports
+ * Returns: int - 1 if every scale completed, 0 otherwise
+ * Note: Scale N is generated into Benchmark_xN and run there. Throughput is sales
+ *       rows per second of each step. A step fails unless its row count matches
+ *       the generated sales: the build, Report 3 and Report 4 must see every
+ *       row, and the Report 2 and Report 5 joins must keep the same share of
+ *       rows as at the first scale. Peak memory is the process peak working
+ *       set after the scale, so scales should be listed smallest first. Results
+ *       are also written to Benchmark_Results_<time>.csv in the working directory.
+ */
+int RunBenchmark(const char* sortType) {
+    char directoryName[40] = {0};                      // Directory of the current scale
+    char resultsFileName[60] = {0};                    // CSV results file
+    FILE* resultsFile = NULL;                          // CSV results output
+    const char* stepNames[5] = {"build", "report2", "report3", "report4", "report5"};
+    double stepSeconds[5] = {0.0};                     // Time of each step
+    long long stepStart = 0;                           // Monotonic start of the current step
+    long salesRows = 0;                                // Sales rows of the current scale
+    long firstSalesRows = 0;                           // Sales rows of the first scale
+    long long firstStepRows[5] = {0};                  // Rows each step produced at the first scale
+    long long stepRows = 0;                            // Rows the current step produced
+    long long expectedRows = 0;                        // Rows the current step should have produced
+    unsigned long long peakBytes = 0;                  // Peak working set after the scale
+    int stepResult = 0;                                // 1 if the current step succeeded
+    int returnValue = 1;                               // Return value (single return pattern)
+    
+    sprintf(resultsFileName, "Benchmark_Results_%ld.csv", (long)time(NULL));
+    resultsFile = OpenFileWithErrorCheck(resultsFileName, "w");
+    if (resultsFile != NULL) {
+        fprintf(resultsFile, "scale,sales_rows,step,seconds,rows_per_second,peak_working_set_bytes\n");
+    }
+    
+    for (int scaleIndex = 0; scaleIndex < benchmarkScaleCount && returnValue == 1; scaleIndex++) {
+        sprintf(directoryName, "Benchmark_x%d", benchmarkScales[scaleIndex]);
+        printf("\nGenerating scale %d data in %s...\n", benchmarkScales[scaleIndex], directoryName);
+        salesRows = GenerateSyntheticDataset(directoryName, benchmarkScales[scaleIndex]);
+        if (salesRows <= 0 || SetCurrentDirectoryA(directoryName) == 0) {
+            printf("Error: Cannot prepare benchmark data for scale %d\n", benchmarkScales[scaleIndex]);
+            returnValue = 0;
+        }
+        
+        for (int stepIndex = 0; stepIndex < 5 && returnValue == 1; stepIndex++) {
+            stepStart = ReadMonotonicNanoseconds();
+            if (stepIndex == 0) {
+                stepResult = BuildDatabaseFromCsvFiles();
+            } else if (stepIndex == 1) {
+                stepResult = GenerateReport2ProductTypesAndLocations(sortType);
+            } else if (stepIndex == 2) {
+                stepResult = GenerateReport3SeasonalPatterns(sortType);
+            } else if (stepIndex == 3) {
+                stepResult = GenerateReport4DeliveryTimeAnalysis(sortType);
+            } else {
+                stepResult = GenerateReport5CustomerSalesListing(sortType);
+            }
+            stepSeconds[stepIndex] = (double)(ReadMonotonicNanoseconds() - stepStart) / 1e9;
+            if (stepResult != 1) {
+                printf("Error: Benchmark step %s failed at scale %d\n", stepNames[stepIndex], benchmarkScales[scaleIndex]);
+                returnValue = 0;
+            }
+            
+            // Check the row count so a corrupt table cannot pass as a throughput figure
+            if (returnValue == 1) {
+                stepRows = (stepIndex == 0) ? CountTableRecords("SalesTable.dat", sizeof(salesRecord)) : metrics.resultRows;
+                if (stepIndex == 1 || stepIndex == 4) {
+                    // Copies keep their product and customer, so the join keeps the same share
+                    expectedRows = (scaleIndex == 0) ? stepRows :
+                                   firstStepRows[stepIndex] * (long long)salesRows / (long long)firstSalesRows;
+                } else {
+                    expectedRows = salesRows;
+                }
+                if (scaleIndex == 0) {
+                    firstStepRows[stepIndex] = stepRows;
+                }
+                if (stepRows <= 0 || stepRows > salesRows || stepRows != expectedRows) {
+                    printf("Error: Benchmark step %s at scale %d produced %lld rows, expected %lld of %ld sales rows\n",
+                           stepNames[stepIndex], benchmarkScales[scaleIndex], stepRows, expectedRows, salesRows);
+                    returnValue = 0;
+                }
+            }
+        }
+        
+        if (scaleIndex == 0) {
+            firstSalesRows = salesRows;
+        }
+        
+        if (salesRows > 0) {
+            SetCurrentDirectoryA("..");
+        }
+        
+        if (returnValue == 1) {
+            peakBytes = ReadPeakMemoryBytes();
+            printf("\nBenchmark scale %d: %ld sales rows, peak working set %.1f MB\n",
+                   benchmarkScales[scaleIndex], salesRows, (double)peakBytes / (1024.0 * 1024.0));
+            printf("%-10s %12s %16s\n", "Step", "Seconds", "Rows/second");
+            for (int stepIndex = 0; stepIndex < 5; stepIndex++) {
+                printf("%-10s %12.3f %16.0f\n", stepNames[stepIndex], stepSeconds[stepIndex],
+                       (stepSeconds[stepIndex] > 0.0) ? (double)salesRows / stepSeconds[stepIndex] : 0.0);
+                if (resultsFile != NULL) {
+                    fprintf(resultsFile, "%d,%ld,%s,%.6f,%.0f,%llu\n", benchmarkScales[scaleIndex], salesRows,
+                            stepNames[stepIndex], stepSeconds[stepIndex],
+                            (stepSeconds[stepIndex] > 0.0) ? (double)salesRows / stepSeconds[stepIndex] : 0.0,
+                            peakBytes);
+                }
+            }
+        }
+    }
+    
+    if (resultsFile != NULL) {
+        fclose(resultsFile);
+        printf("\nBenchmark results written to %s\n", resultsFileName);
+    }
+    
+    return returnValue;
+}//end function definition RunBenchmark
+
+// ====================== COMMAND LINE ======================
+#define COMMAND_EXIT_SUCCESS 0                        // Pipeline ran to completion
+#define COMMAND_EXIT_FAILURE 1                        // Pipeline started but a step failed
+#define COMMAND_EXIT_USAGE 2                          // Command line could not be parsed
+
+/*
+ * Function: ShowCommandLineUsage
+ * Purpose: Prints the command-line syntax
+ * Parameters: programName - argv[0]
+ * Returns: void
+ */
+void ShowCommandLineUsage(const char* programName) {
+    printf("Usage:\n");
+    printf("  %s                      interactive menu\n", programName);
+    printf("  %s build [--threads N]  build the binary tables from the CSV files\n", programName);
+    printf("  %s report N [options]   write report N (2-5)\n", programName);
+    printf("  %s search N [options]   write report N (2 or 5) and search it\n", programName);
+    printf("  %s benchmark [options]  generate scaled data sets and time the build and reports 2-5\n", programName);
+    printf("  %s append [options]     append delta CSV files to the binary tables\n", programName);
+    printf("  %s range [options]      total the sales ordered in a date range\n", programName);
+    printf("  %s customer [options]   list one customer's sales through the name index\n", programName);
+    printf("Report options:\n");
+    printf("  --sort bubble|merge|radix   sort algorithm (default merge)\n");
+    printf("  --limit N                   records to display, 0 = all (default 0)\n");
+    printf("  --asc | --desc              display order (default --asc)\n");
+    printf("  --echo off|summary|full     report lines shown on the console (default summary)\n");
+    printf("  --threads N                 sort and build worker threads, 0 = one per processor\n");
+    printf("  --sort-memory KB            run generation memory of the merge sort, %lu-%d (default %lu)\n",
+           SORT_MEMORY_BUDGET_MINIMUM / 1024, SORT_MEMORY_BUDGET_MAXIMUM_KB, SORT_MEMORY_BUDGET_DEFAULT / 1024);
+    printf("  --metrics-json              also write the report metrics to Report_*.json\n");
+    printf("Benchmark options (report options also apply):\n");
+    printf("  --scales N[,N...]           Sales and Customers scale factors, smallest first (default 1,4,16)\n");
+    printf("Append options (default files shown; a missing file leaves its table unchanged):\n");
+    printf("  --sales FILE                new sales (Sales_delta.csv)\n");
+    printf("  --customers FILE            new customers (Customers_delta.csv)\n");
+    printf("  --stores FILE               new stores (Stores_delta.csv)\n");
+    printf("  --rates FILE                new exchange rates (Exchange_Rates_delta.csv)\n");
+    printf("  --products FILE             new products (Products_delta.csv)\n");
+    printf("Order date options (range, and reports 3 and 4; a report may give just one):\n");
+    printf("  --from M/D/YYYY             first order date\n");
+    printf("  --to M/D/YYYY               last order date\n");
+    printf("Search options for report 2:\n");
+    printf("  --product NAME [--continent NAME [--country NAME]]\n");
+    printf("Search options for report 5 and customer:\n");
+    printf("  --customer NAME [--date M/D/YYYY | --order NUMBER | --product-key KEY]\n");
+    printf("Exit status: %d success, %d failure, %d invalid command line\n",
+           COMMAND_EXIT_SUCCESS, COMMAND_EXIT_FAILURE, COMMAND_EXIT_USAGE);
+}//end function definition ShowCommandLineUsage
+
+/*
+ * Function: ParseCommandLineOption
+ * Purpose: Applies one report or search option to the batch options
+ * Parameters: optionName - option text (e.g. "--sort")
+ *            optionValue - following argument (NULL if there is none)
+ *            sortType - pointer to the selected sort type name
+ * Returns: int - number of arguments consumed (1 or 2), 0 if the option is invalid
+ */
+int ParseCommandLineOption(const char* optionName, const char* optionValue, const char** sortType) {
+    char lowerValue[40] = {0};                         // Lowercase copy of optionValue
+    int numberValue = 0;                               // Parsed numeric value
+    int month = 0, day = 0, year = 0;                  // Parsed date parts
+    int consumed = 0;                                  // Return value (single return pattern)
+    
+    if (optionValue != NULL) {
+        ToLowerCase(lowerValue, optionValue, sizeof(lowerValue));
+    }
+    
+    if (strcmp(optionName, "--asc") == 0) {
+        batchOptions.ascending = 1;
+        consumed = 1;
+    } else if (strcmp(optionName, "--desc") == 0) {
+        batchOptions.ascending = 0;
+        consumed = 1;
+    } else if (strcmp(optionName, "--metrics-json") == 0) {
+        SetMetricsSidecar(1);
+        consumed = 1;
+    } else if (optionValue == NULL) {
+        consumed = 0;                                  // Every other option takes a value
+    } else if (strcmp(optionName, "--sort") == 0) {
+        if (strcmp(lowerValue, "bubble") == 0) {
+            *sortType = "Bubble";
+            consumed = 2;
+        } else if (strcmp(lowerValue, "merge") == 0) {
+            *sortType = "Merge";
+            consumed = 2;
+        } else if (strcmp(lowerValue, "radix") == 0) {
+            *sortType = "Radix";
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--limit") == 0) {
+        if (sscanf(optionValue, "%d", &numberValue) == 1 && numberValue >= 0) {
+            batchOptions.maxRecords = numberValue;
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--echo") == 0) {
+        if (strcmp(lowerValue, "off") == 0) {
+            SetReportEchoMode(REPORT_ECHO_OFF);
+            consumed = 2;
+        } else if (strcmp(lowerValue, "summary") == 0) {
+            SetReportEchoMode(REPORT_ECHO_SUMMARY);
+            consumed = 2;
+        } else if (strcmp(lowerValue, "full") == 0) {
+            SetReportEchoMode(REPORT_ECHO_FULL);
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--threads") == 0) {
+        if (sscanf(optionValue, "%d", &numberValue) == 1 && numberValue >= 0 && numberValue <= SORT_MAX_THREADS) {
+            SetSortThreadCount(numberValue);
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--sort-memory") == 0) {
+        if (sscanf(optionValue, "%d", &numberValue) == 1 && numberValue >= (int)(SORT_MEMORY_BUDGET_MINIMUM / 1024) &&
+            numberValue <= SORT_MEMORY_BUDGET_MAXIMUM_KB) {
+            SetSortMemoryBudget((size_t)numberValue * 1024);
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--scales") == 0) {
+        if (SetBenchmarkScales(optionValue) == 1) {
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--sales") == 0) {
+        SetAppendDeltaFile(BINARY_TABLE_SALES, optionValue);
+        consumed = 2;
+    } else if (strcmp(optionName, "--customers") == 0) {
+        SetAppendDeltaFile(BINARY_TABLE_CUSTOMERS, optionValue);
+        consumed = 2;
+    } else if (strcmp(optionName, "--stores") == 0) {
+        SetAppendDeltaFile(BINARY_TABLE_STORES, optionValue);
+        consumed = 2;
+    } else if (strcmp(optionName, "--rates") == 0) {
+        SetAppendDeltaFile(BINARY_TABLE_EXCHANGE_RATES, optionValue);
+        consumed = 2;
+    } else if (strcmp(optionName, "--products") == 0) {
+        SetAppendDeltaFile(BINARY_TABLE_PRODUCTS, optionValue);
+        consumed = 2;
+    } else if (strcmp(optionName, "--product") == 0) {
+        strncpy(batchOptions.productName, optionValue, 30);
+        consumed = 2;
+    } else if (strcmp(optionName, "--continent") == 0) {
+        strncpy(batchOptions.continent, optionValue, 19);
+        consumed = 2;
+    } else if (strcmp(optionName, "--country") == 0) {
+        strncpy(batchOptions.country, optionValue, 19);
+        consumed = 2;
+    } else if (strcmp(optionName, "--customer") == 0) {
+        strncpy(batchOptions.customerName, optionValue, 39);
+        consumed = 2;
+    } else if (strcmp(optionName, "--date") == 0) {
+        if (sscanf(optionValue, "%d/%d/%d", &month, &day, &year) == 3 &&
+            StoreCalendarDate(month, day, year, &batchOptions.orderDate) == 1) {
+            batchOptions.searchOption = 2;
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--from") == 0) {
+        if (sscanf(optionValue, "%d/%d/%d", &month, &day, &year) == 3 &&
+            StoreCalendarDate(month, day, year, &batchOptions.rangeFirstDate) == 1) {
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--to") == 0) {
+        if (sscanf(optionValue, "%d/%d/%d", &month, &day, &year) == 3 &&
+            StoreCalendarDate(month, day, year, &batchOptions.rangeLastDate) == 1) {
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--order") == 0) {
+        if (sscanf(optionValue, "%ld", &batchOptions.orderNumber) == 1) {
+            batchOptions.searchOption = 3;
+            consumed = 2;
+        }
+    } else if (strcmp(optionName, "--product-key") == 0) {
+        if (sscanf(optionValue, "%hu", &batchOptions.productKey) == 1) {
+            batchOptions.searchOption = 4;
+            consumed = 2;
+        }
+    }
+    
+    if (consumed == 0) {
+        printf("Error: Invalid option %s\n", optionName);
+    }
+    
+    return consumed;                                   // Single return point
+}//end function definition ParseCommandLineOption
+
+/*
+ * Function: ExecuteCommandLine
+ * Purpose: Runs one pipeline from command-line arguments without any prompt
+ * Parameters: argumentCount - argc from main
+ *            arguments - argv from main
+ * Returns: int - COMMAND_EXIT_SUCCESS, COMMAND_EXIT_FAILURE or COMMAND_EXIT_USAGE
+ * Note: Report preferences and search criteria that the menus would ask for are
+ *       taken from batchOptions; "search" writes the report and then searches it,
+ *       "customer" lists one customer's sales through CustomersTable.names
+ */
+int ExecuteCommandLine(int argumentCount, char* arguments[]) {
+    const char* command = arguments[1];                // "build", "append", "range", "report", "search", "customer" or "benchmark"
+    const char* sortType = "Merge";                    // Sort algorithm name
+    int reportNumber = 0;                              // Report to generate
+    int isSearch = 0;                                  // 1 for the "search" command
+    int isBenchmark = 0;                               // 1 for the "benchmark" command
+    int isCustomer = 0;                                // 1 for the "customer" command
+    int argumentIndex = 3;                             // First option argument
+    int consumed = 0;                                  // Arguments used by the current option
+    int usageError = 0;                                // 1 if the command line is invalid
+    int pipelineResult = 0;                            // 1 if the pipeline succeeded
+    int returnValue = COMMAND_EXIT_USAGE;              // Return value (single return pattern)
+    
+    batchOptions.active = 1;
+    SetReportEchoMode(REPORT_ECHO_SUMMARY);
+    
+    isSearch = (strcmp(command, "search") == 0);
+    isBenchmark = (strcmp(command, "benchmark") == 0);
+    isCustomer = (strcmp(command, "customer") == 0);
+    if (strcmp(command, "build") == 0 || strcmp(command, "append") == 0 || strcmp(command, "range") == 0 ||
+        isCustomer == 1) {
+        argumentIndex = 2;                             // Options follow the command directly
+    } else if (strcmp(command, "report") == 0 || isSearch == 1) {
+        if (argumentCount < 3 || sscanf(arguments[2], "%d", &reportNumber) != 1 ||
+            reportNumber < 2 || reportNumber > 5 || (isSearch == 1 && reportNumber != 2 && reportNumber != 5)) {
+            usageError = 1;
+        }
+    } else if (isBenchmark == 1) {
+        argumentIndex = 2;
+    } else {
+        usageError = 1;
+    }
+    
+    // Options of every command
+    while (usageError == 0 && argumentIndex < argumentCount) {
+        consumed = ParseCommandLineOption(arguments[argumentIndex],
+                                          (argumentIndex + 1 < argumentCount) ? arguments[argumentIndex + 1] : NULL,
+                                          &sortType);
+        if (consumed == 0) {
+            usageError = 1;
+        }
+        argumentIndex += consumed;
+    }
+    
+    if (usageError == 0 && strcmp(command, "range") == 0 &&
+        (batchOptions.rangeFirstDate.yearValue == 0 || batchOptions.rangeLastDate.yearValue == 0)) {
+        printf("Error: Missing --from or --to date\n");
+        usageError = 1;
+    }
+    
+    // Only range and the Report 3 and 4 scans apply a date window
+    if (usageError == 0 && strcmp(command, "range") != 0 &&
+        (strcmp(command, "report") != 0 || (reportNumber != 3 && reportNumber != 4)) &&
+        (batchOptions.rangeFirstDate.yearValue != 0 || batchOptions.rangeLastDate.yearValue != 0)) {
+        printf("Error: --from and --to apply only to range and reports 3 and 4\n");
+        usageError = 1;
+    }
+    
+    if (usageError == 0 && isCustomer == 1) {
+        if (batchOptions.customerName[0] == '\0') {
+            printf("Error: Missing --customer name\n");
+            usageError = 1;
+        } else if (batchOptions.searchOption == 0) {
+            batchOptions.searchOption = 1;
+        }
+    }
+    
+    // A search needs its leading key; the option number grows with the criteria given
+    if (usageError == 0 && isSearch == 1) {
+        if (reportNumber == 2 && batchOptions.productName[0] != '\0') {
+            batchOptions.searchOption = 1;
+            if (batchOptions.continent[0] != '\0') {
+                batchOptions.searchOption = 2;
+            }
+            if (batchOptions.continent[0] != '\0' && batchOptions.country[0] != '\0') {
+                batchOptions.searchOption = 3;
+            }
+        } else if (reportNumber == 5 && batchOptions.customerName[0] != '\0') {
+            if (batchOptions.searchOption == 0) {
+                batchOptions.searchOption = 1;
+            }
+        } else {
+            printf("Error: Missing search key (--product for report 2, --customer for report 5)\n");
+            usageError = 1;
+        }
+    }
+    
+    if (usageError == 1) {
+        ShowCommandLineUsage(arguments[0]);
+    } else {
+        if (isSearch == 0 && isCustomer == 0) {
+            batchOptions.searchOption = 0;             // Search criteria are ignored by "report"
+        }
+        
+        if (strcmp(command, "build") == 0) {
+            pipelineResult = BuildDatabaseFromCsvFiles();
+        } else if (strcmp(command, "append") == 0) {
+            pipelineResult = AppendDeltaCsvFiles();
+        } else if (strcmp(command, "range") == 0) {
+            pipelineResult = SummarizeSalesInDateRange();
+        } else if (isCustomer == 1) {
+            pipelineResult = LookUpCustomerSales();
+        } else if (isBenchmark == 1) {
+            pipelineResult = RunBenchmark(sortType);
+        } else if (reportNumber == 2) {
+            pipelineResult = GenerateReport2ProductTypesAndLocations(sortType);
+        } else if (reportNumber == 3 || reportNumber == 4) {
+            if (batchOptions.rangeFirstDate.yearValue != 0 || batchOptions.rangeLastDate.yearValue != 0) {
+                SetReportDateWindow((batchOptions.rangeFirstDate.yearValue != 0) ? &batchOptions.rangeFirstDate : NULL,
+                                    (batchOptions.rangeLastDate.yearValue != 0) ? &batchOptions.rangeLastDate : NULL);
+            }
+            pipelineResult = (reportNumber == 3) ? GenerateReport3SeasonalPatterns(sortType) :
+                                                   GenerateReport4DeliveryTimeAnalysis(sortType);
+        } else {
+            pipelineResult = GenerateReport5CustomerSalesListing(sortType);
+        }
+        
+        returnValue = (pipelineResult == 1) ? COMMAND_EXIT_SUCCESS : COMMAND_EXIT_FAILURE;
+    }
+    
+    return returnValue;                                // Single return point
+}//end function definition ExecuteCommandLine
+
 /*
  * Function: main
  * Purpose: Main entry point of the program
- * Parameters: void
+ * Parameters: argc - number of command-line arguments
+ *            argv - command-line arguments
  * Returns: int - exit status (0 for successful execution)
- * Note: Sets up console encoding and starts the main program loop
+ * Note: Sets up console encoding, then runs either the command-line pipeline
+ *       given in argv or the interactive main program loop
  */
-int main(void) {
+int main(int argc, char* argv[]) {
+    int exitStatus = 0;                   // Process exit status
+    
     SetConsoleOutputCP(CP_UTF8);          // Enable UTF-8 support for console output
-    ExecuteMainProgramLoop();
-    printf("Thanks for using our app, see you next time!\n");
-    system("pause");
-    return 0;
+    if (argc > 1) {
+        exitStatus = ExecuteCommandLine(argc, argv);
+    } else {
+        ExecuteMainProgramLoop();
+        printf("Thanks for using our app, see you next time!\n");
+        system("pause");
+    }
+    return exitStatus;
 }//end function definition main
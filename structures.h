@@ -37,6 +37,7 @@
 // ====================== STANDARD LIBRARY INCLUDES ======================
 #include <stddef.h>        // For size_t type definition
 #include <limits.h>        // For ULONG_MAX and other limits
+#include <stdio.h>         // For FILE type used by index-backed join tables
 
 // ====================== DATE AND TIME STRUCTURES ======================
 
@@ -55,6 +56,66 @@ typedef struct {
     unsigned short yearValue;              // Four-digit year value
 } dateStructure;
 
+#define DAY_NUMBER_NONE INT_MIN            // Day number of a missing date (empty delivery date)
+
+// ====================== DICTIONARY ENCODING STRUCTURES ======================
+
+typedef unsigned short dictionaryCode;             // Position of a value in its column dictionary
+
+#define DICTIONARY_MAGIC 0x54434944u               // "DICT" in little-endian byte order
+#define DICTIONARY_VERSION 1u                      // On-disk format version
+#define DICTIONARY_VALUE_LENGTH 32                 // Bytes per stored value, NUL padded
+#define DICTIONARY_MAX_VALUES 65536                // Distinct values a dictionaryCode can number
+#define DICTIONARY_MAX_COLUMNS 5                   // Most encoded columns in one table
+
+#define CUSTOMER_DICTIONARY_GENDER 0               // Encoded columns of customerRecord
+#define CUSTOMER_DICTIONARY_STATE_CODE 1
+#define CUSTOMER_DICTIONARY_STATE 2
+#define CUSTOMER_DICTIONARY_COUNTRY 3
+#define CUSTOMER_DICTIONARY_CONTINENT 4
+#define CUSTOMER_DICTIONARY_COLUMNS 5
+
+#define PRODUCT_DICTIONARY_BRAND 0                 // Encoded columns of productRecord
+#define PRODUCT_DICTIONARY_SUBCATEGORY 1
+#define PRODUCT_DICTIONARY_CATEGORY 2
+#define PRODUCT_DICTIONARY_COLUMNS 3
+
+/*
+ * Structure: columnDictionary
+ * Purpose: Distinct values of one encoded column, in code order
+ * Fields: values - value of each code
+ *         valueCount - codes in use
+ *         capacity - values allocated
+ *         hashSlots - code + 1 of the value hashed to each slot (0 = empty)
+ *         slotCount - hash slots (power of two, at least twice valueCount)
+ * Note: Codes are handed out in order of first appearance and never change, so
+ *       records written earlier stay valid when an append adds values
+ */
+typedef struct {
+    char (*values)[DICTIONARY_VALUE_LENGTH];   // Value of each code
+    long valueCount;                       // Codes in use
+    long capacity;                         // Values allocated
+    unsigned int* hashSlots;               // Code + 1 per slot, 0 = empty
+    long slotCount;                        // Hash slots (power of two)
+} columnDictionary;
+
+/*
+ * Structure: dictionaryFileHeader
+ * Purpose: First bytes of a table dictionary file
+ * Fields: magic - DICTIONARY_MAGIC
+ *         version - DICTIONARY_VERSION
+ *         columnCount - column dictionaries that follow
+ *         valueLength - DICTIONARY_VALUE_LENGTH of the build that wrote the file
+ * Note: Each column follows as an unsigned int value count and that many
+ *       valueLength-byte values
+ */
+typedef struct {
+    unsigned int magic;                    // DICTIONARY_MAGIC
+    unsigned int version;                  // DICTIONARY_VERSION
+    unsigned int columnCount;              // Column dictionaries in the file
+    unsigned int valueLength;              // Bytes per value
+} dictionaryFileHeader;
+
 // ====================== DATABASE TABLE STRUCTURES ======================
 
 /*
@@ -62,8 +123,8 @@ typedef struct {
  * Purpose: Represents a sales transaction record with all order details
  * Fields: orderNumber - Unique ID for each order
  *         lineItem - Identifies individual products purchased as part of an order
- *         orderDate - Date the order was placed
- *         deliveryDate - Date the order was delivered
+ *         orderDay - Date the order was placed, as a day number
+ *         deliveryDay - Date the order was delivered, as a day number
  *         customerKey - Unique key identifying which customer placed the order
  *         storeKey - Unique key identifying which store processed the order
  *         productKey - Unique key identifying which product was purchased
@@ -75,8 +136,8 @@ typedef struct {
 typedef struct SalesTable {
     long orderNumber;                      // Unique ID for each order
     unsigned char lineItem;                // Identifies individual products purchased
-    dateStructure orderDate;               // Date the order was placed
-    dateStructure deliveryDate;            // Date the order was delivered
+    int orderDay;                          // Order date as a day number (DateToDayNumber)
+    int deliveryDay;                       // Delivery date as a day number (DAY_NUMBER_NONE = not delivered)
     unsigned int customerKey;              // Customer foreign key
     unsigned short storeKey;               // Store foreign key
     unsigned short productKey;             // Product foreign key
@@ -88,28 +149,29 @@ typedef struct SalesTable {
  * Structure: customerRecord
  * Purpose: Represents customer demographic and geographic information
  * Fields: customerKey - Primary key to identify customers
- *         gender - Customer gender
+ *         gender - Customer gender (CUSTOMER_DICTIONARY_GENDER code)
  *         name - Customer full name
  *         city - Customer city
- *         stateCode - Customer state (abbreviated)
- *         state - Customer state (full)
+ *         stateCode - Customer state, abbreviated (CUSTOMER_DICTIONARY_STATE_CODE code)
+ *         state - Customer state, full (CUSTOMER_DICTIONARY_STATE code)
  *         zipCode - Customer zip code
- *         country - Customer country
- *         continent - Customer continent
+ *         country - Customer country (CUSTOMER_DICTIONARY_COUNTRY code)
+ *         continent - Customer continent (CUSTOMER_DICTIONARY_CONTINENT code)
  *         birthday - Customer date of birth
- * Size: ~202 bytes
- * Note: Contains all customer demographic and location data for analysis
+ * Size: ~104 bytes
+ * Note: Contains all customer demographic and location data for analysis.
+ *       Low-cardinality columns hold codes into CustomersTable.dict.
  */
 typedef struct CustomersTable {
     unsigned int customerKey;              // Primary key to identify customers
-    char gender[8];                        // Customer gender
+    dictionaryCode gender;                 // Customer gender
     char name[40];                         // Customer full name
     char city[40];                         // Customer city
-    char stateCode[20];                    // Customer state (abbreviated)
-    char state[30];                        // Customer state (full)
+    dictionaryCode stateCode;              // Customer state (abbreviated)
+    dictionaryCode state;                  // Customer state (full)
     unsigned int zipCode;                  // Customer zip code
-    char country[20];                      // Customer country
-    char continent[20];                    // Customer continent
+    dictionaryCode country;                // Customer country
+    dictionaryCode continent;              // Customer continent
     dateStructure birthday;                // Customer date of birth
 } customerRecord;
 
@@ -118,28 +180,29 @@ typedef struct CustomersTable {
  * Purpose: Represents product catalog information with pricing and categorization
  * Fields: productKey - Primary key to identify products
  *         productName - Product name
- *         brand - Product brand
+ *         brand - Product brand (PRODUCT_DICTIONARY_BRAND code)
  *         color - Product color
  *         unitCostUSD - Cost to produce the product in USD
  *         unitPriceUSD - Product list price in USD
  *         subcategoryKey - Key to identify product subcategories
- *         subcategory - Product subcategory name
+ *         subcategory - Product subcategory name (PRODUCT_DICTIONARY_SUBCATEGORY code)
  *         categoryKey - Key to identify product categories
- *         category - Product category name
- * Size: ~114 bytes
- * Note: Contains complete product information for sales analysis
+ *         category - Product category name (PRODUCT_DICTIONARY_CATEGORY code)
+ * Size: ~88 bytes
+ * Note: Contains complete product information for sales analysis.
+ *       Low-cardinality columns hold codes into ProductsTable.dict.
  */
 typedef struct ProductsTable {
     unsigned short productKey;             // Primary key to identify products
     char productName[30];                  // Product name
-    char brand[30];                        // Product brand
+    dictionaryCode brand;                  // Product brand
     char color[15];                        // Product color
     double unitCostUSD;                    // Cost to produce the product in USD
     double unitPriceUSD;                   // Product list price in USD
     char subcategoryKey[4];                // Product subcategory key
-    char subcategory[10];                  // Product subcategory name
+    dictionaryCode subcategory;            // Product subcategory name
     char categoryKey[2];                   // Product category key
-    char category[20];                     // Product category name
+    dictionaryCode category;               // Product category name
 } productRecord;
 
 /*
@@ -164,14 +227,14 @@ typedef struct StoresTable {
 /*
  * Structure: exchangeRateRecord
  * Purpose: Represents currency exchange rates for conversion calculations
- * Fields: date - Date in DD/MM/YYYY format
+ * Fields: rateDay - Date as a day number, converted from the CSV text at load time
  *         currency - Currency code
  *         exchange - Exchange rate compared to USD
- * Size: ~22 bytes
+ * Size: 16 bytes
  * Note: Essential for converting sales in different currencies to USD
  */
 typedef struct ExchangeRatesTable {
-    char date[10];                         // Date (format: DD/MM/YYYY)
+    int rateDay;                           // Date as a day number (DAY_NUMBER_NONE if invalid)
     char currency[4];                      // Currency code (3 chars + null terminator)
     double exchange;                       // Exchange rate compared to USD
 } exchangeRateRecord;
@@ -265,12 +328,19 @@ typedef struct {
  * Purpose: Combined record for Report 2 - Products and customer locations
  * Fields: product - product information
  *         customer - customer information
- * Size: ~316 bytes (114 + 202)
- * Note: Used for joined data in Report 2 analysis
+ *         continent - customer continent, decoded
+ *         country - customer country, decoded
+ *         state - customer state, decoded
+ * Size: ~262 bytes (88 + 104 + 70)
+ * Note: Used for joined data in Report 2 analysis. The location is decoded once
+ *       at the join so the report can sort and search it by name.
  */
 typedef struct {
     productRecord product;                 // Product information
     customerRecord customer;               // Customer information
+    char continent[20];                    // Customer continent
+    char country[20];                      // Customer country
+    char state[30];                        // Customer state
 } productCustomerRecord;
 
 /*
@@ -278,7 +348,7 @@ typedef struct {
  * Purpose: Combined record for Report 5 - Sales listings by customer
  * Fields: sale - sales transaction information
  *         customer - customer information
- * Size: ~230 bytes (28 + 202)
+ * Size: ~144 bytes (40 + 104)
  * Note: Used for joined data in Report 5 analysis
  */
 typedef struct {
@@ -323,6 +393,473 @@ typedef struct LinkedListFileMetadata {
     size_t recordSize;                     // Size of data payload per node
 } LinkedListFileMetadata;
 
+// ====================== COLUMNAR SALES TABLE STRUCTURES ======================
+
+#define SALES_COLUMN_ORDER_NUMBER 0            // Column ids of the columnar sales table,
+#define SALES_COLUMN_LINE_ITEM 1               // in salesRecord field order
+#define SALES_COLUMN_ORDER_DATE 2
+#define SALES_COLUMN_DELIVERY_DATE 3
+#define SALES_COLUMN_CUSTOMER_KEY 4
+#define SALES_COLUMN_STORE_KEY 5
+#define SALES_COLUMN_PRODUCT_KEY 6
+#define SALES_COLUMN_QUANTITY 7
+#define SALES_COLUMN_CURRENCY_CODE 8
+#define SALES_COLUMN_COUNT 9
+#define SALES_COLUMN_BIT(column) (1u << (column))  // Column projection mask bit
+
+#define SALES_COLUMNAR_MAGIC 0x4C4F4358u       // "XCOL" in little-endian byte order
+#define SALES_COLUMNAR_VERSION 2u
+#define SALES_COLUMN_READ_BATCH 4096           // Rows read per column per batch
+
+/*
+ * Structure: salesColumnarManifest
+ * Purpose: Manifest of the columnar copy of SalesTable.dat (SalesTable.manifest)
+ * Fields: magic - SALES_COLUMNAR_MAGIC
+ *         version - SALES_COLUMNAR_VERSION
+ *         rowCount - rows stored in every column file
+ *         columnCount - SALES_COLUMN_COUNT
+ *         columnWidths - bytes per value of each column
+ *         columnFiles - file name of each column
+ * Note: Each column file holds the packed values of one salesRecord field, row after row.
+ *       The copy is only used while rowCount matches SalesTable.dat.
+ */
+typedef struct {
+    unsigned int magic;                    // File format identifier
+    unsigned int version;                  // File format version
+    long rowCount;                         // Rows in each column file
+    unsigned int columnCount;              // Number of columns
+    unsigned int columnWidths[SALES_COLUMN_COUNT]; // Value width of each column
+    char columnFiles[SALES_COLUMN_COUNT][40];      // Column file names
+} salesColumnarManifest;
+
+/*
+ * Structure: salesColumnReader
+ * Purpose: Projection reader over the columnar sales table
+ * Fields: columnFiles - open file of each projected column (NULL if not projected)
+ *         columnBuffers - current batch of each projected column
+ *         fieldOffsets - offset of each column's field in salesRecord
+ *         fieldWidths - width of each column's values
+ *         columnMask - projected columns (SALES_COLUMN_BIT)
+ *         rowCount - rows in the table
+ *         rowsDelivered - rows returned so far
+ *         batchRows - rows in the current batch
+ *         batchPosition - next row of the current batch
+ */
+typedef struct {
+    FILE* columnFiles[SALES_COLUMN_COUNT];
+    unsigned char* columnBuffers[SALES_COLUMN_COUNT];
+    size_t fieldOffsets[SALES_COLUMN_COUNT];
+    size_t fieldWidths[SALES_COLUMN_COUNT];
+    unsigned int columnMask;
+    long rowCount;
+    long rowsDelivered;
+    long batchRows;
+    long batchPosition;
+} salesColumnReader;
+
+// ====================== SALES ZONE MAP STRUCTURES ======================
+
+#define SALES_ZONE_MAP_MAGIC 0x4E4F5A58u       // "XZON" in little-endian byte order
+#define SALES_ZONE_MAP_VERSION 1u
+#define SALES_ZONE_BLOCK_ROWS 4096             // Rows per block (one column read batch)
+
+/*
+ * Structure: salesZoneEntry
+ * Purpose: Value ranges of one block of SalesTable.dat rows
+ * Fields: minOrderDay, maxOrderDay - order date range (DateToDayNumber)
+ *         minDeliveryDay, maxDeliveryDay - delivery date range (DateToDayNumber)
+ *         minCustomerKey, maxCustomerKey - customer key range
+ *         minProductKey, maxProductKey - product key range
+ * Size: 28 bytes
+ */
+typedef struct {
+    int minOrderDay;                       // Earliest order date
+    int maxOrderDay;                       // Latest order date
+    int minDeliveryDay;                    // Earliest delivery date
+    int maxDeliveryDay;                    // Latest delivery date
+    unsigned int minCustomerKey;           // Smallest customer key
+    unsigned int maxCustomerKey;           // Largest customer key
+    unsigned short minProductKey;          // Smallest product key
+    unsigned short maxProductKey;          // Largest product key
+} salesZoneEntry;
+
+/*
+ * Structure: salesZoneMapHeader
+ * Purpose: First bytes of the zone map of SalesTable.dat (SalesTable.zonemap)
+ * Fields: magic - SALES_ZONE_MAP_MAGIC
+ *         version - SALES_ZONE_MAP_VERSION
+ *         blockRows - rows per block; the last block may hold fewer
+ *         rowCount - SalesTable.dat rows described by the map
+ *         blockCount - salesZoneEntry records following the header
+ * Note: Block N covers rows N * blockRows onwards. The map is only used while rowCount
+ *       matches SalesTable.dat.
+ */
+typedef struct {
+    unsigned int magic;                    // File format identifier
+    unsigned int version;                  // File format version
+    long long blockRows;                   // Rows per block
+    long long rowCount;                    // Rows described
+    long long blockCount;                  // Entries in the file
+} salesZoneMapHeader;
+
+/*
+ * Structure: salesZoneMap
+ * Purpose: Zone map of SalesTable.dat loaded for one scan
+ * Fields: blockRows - rows per block
+ *         blockCount - entries in use
+ *         entries - value ranges of each block
+ */
+typedef struct {
+    long blockRows;                        // Rows per block
+    long blockCount;                       // Blocks in the map
+    salesZoneEntry* entries;               // Value ranges of each block
+} salesZoneMap;
+
+/*
+ * Structure: salesScanFilter
+ * Purpose: Inclusive value ranges a sale must fall in to reach the scan's aggregates
+ * Fields: firstOrderDay, lastOrderDay - order date range (DateToDayNumber)
+ *         firstDeliveryDay, lastDeliveryDay - delivery date range (DateToDayNumber)
+ *         firstCustomerKey, lastCustomerKey - customer key range
+ *         firstProductKey, lastProductKey - product key range
+ * Note: InitializeSalesScanFilter opens every range to the whole domain; callers then
+ *       narrow the ranges they filter on
+ */
+typedef struct {
+    int firstOrderDay;                     // Earliest order date
+    int lastOrderDay;                      // Latest order date
+    int firstDeliveryDay;                  // Earliest delivery date
+    int lastDeliveryDay;                   // Latest delivery date
+    unsigned int firstCustomerKey;         // Smallest customer key
+    unsigned int lastCustomerKey;          // Largest customer key
+    unsigned short firstProductKey;        // Smallest product key
+    unsigned short lastProductKey;         // Largest product key
+} salesScanFilter;
+
+// ====================== CUSTOMER NAME INDEX STRUCTURES ======================
+
+#define CUSTOMER_NAME_INDEX_MAGIC 0x4D414E58u  // "XNAM" in little-endian byte order
+#define CUSTOMER_NAME_INDEX_VERSION 2u
+#define CUSTOMER_NAME_NO_CHUNK (-1LL)          // lastChunk of a customer without sales
+
+/*
+ * Structure: customerNameIndexHeader
+ * Purpose: First bytes of the customer name index (CustomersTable.names)
+ * Fields: magic - CUSTOMER_NAME_INDEX_MAGIC
+ *         version - CUSTOMER_NAME_INDEX_VERSION
+ *         customerRows - CustomersTable.dat rows indexed
+ *         salesRows - SalesTable.dat rows indexed
+ *         sortedEntries - entry ids in the name order that follows the header
+ *         entryCount - customerNameIndexEntry records following the name order
+ *         postingCount - sales row ids in CustomersTable.postings
+ *         postingBytes - bytes of CustomersTable.postings in use
+ * Note: The index is only used while both row counts match the tables. Entries are in
+ *       CustomersTable.dat row order; those appended after the last build are not in
+ *       the name order and are searched one by one.
+ */
+typedef struct {
+    unsigned int magic;                    // File format identifier
+    unsigned int version;                  // File format version
+    long long customerRows;                // Customers indexed
+    long long salesRows;                   // Sales indexed
+    long long sortedEntries;               // Entries in the name order
+    long long entryCount;                  // Entries in the file
+    long long postingCount;                // Row ids in the posting file
+    long long postingBytes;                // End of the last posting chunk
+} customerNameIndexHeader;
+
+/*
+ * Structure: customerNameIndexEntry
+ * Purpose: One customer of the name index
+ * Fields: foldedName - name in lower case; the name order sorts by foldedName, then name
+ *         name - name as stored in CustomersTable.dat
+ *         customerKey - customer primary key
+ *         postingCount - sales of the customer
+ *         lastChunk - offset of the customer's newest posting chunk, CUSTOMER_NAME_NO_CHUNK if none
+ * Size: 96 bytes
+ */
+typedef struct {
+    char foldedName[40];                   // Lower-case name (sort key)
+    char name[40];                         // Exact name
+    unsigned int customerKey;              // Customer primary key
+    unsigned int postingCount;             // Sales row ids of the customer
+    long long lastChunk;                   // Newest chunk in CustomersTable.postings
+} customerNameIndexEntry;
+
+/*
+ * Structure: customerPostingChunk
+ * Purpose: Header of a run of one customer's sales row ids in CustomersTable.postings
+ * Fields: previousChunk - offset of the customer's previous chunk, CUSTOMER_NAME_NO_CHUNK if none
+ *         rowCount - unsigned int row ids following this header, ascending
+ * Note: The build writes one chunk per customer; every append adds one chunk per
+ *       customer with new sales, so older chunks hold lower row ids
+ */
+typedef struct {
+    long long previousChunk;               // Older chunk of the same customer
+    long long rowCount;                    // Row ids in this chunk
+} customerPostingChunk;
+
+// ====================== SORT KEY NORMALIZATION STRUCTURES ======================
+
+#define SORT_COLUMN_STRING 0               // Fixed-width char array, NUL padded
+#define SORT_COLUMN_DATE 1                 // dateStructure, encoded year/month/day big-endian
+#define SORT_COLUMN_UNSIGNED 2             // Unsigned integer of 1, 2, 4 or 8 bytes, big-endian
+#define SORT_COLUMN_DAY_NUMBER 3           // int day number, sign bit flipped, big-endian
+#define SORT_KEY_MAX_COLUMNS 8             // Maximum columns in one sort specification
+
+/*
+ * Structure: sortKeyColumn
+ * Purpose: One column of a multi-column sort specification
+ * Fields: columnType - SORT_COLUMN_STRING, SORT_COLUMN_DATE, SORT_COLUMN_UNSIGNED or SORT_COLUMN_DAY_NUMBER
+ *         fieldOffset - offset of the field inside the record (offsetof)
+ *         fieldWidth - size of the field inside the record (sizeof)
+ *         encodedWidth - bytes the column occupies in the normalized key
+ *         descending - 1 to invert the encoded bytes (descending order)
+ */
+typedef struct sortKeyColumn {
+    int columnType;                        // Column encoding
+    size_t fieldOffset;                    // Field offset in record
+    size_t fieldWidth;                     // Field size in record
+    size_t encodedWidth;                   // Field size in normalized key
+    int descending;                        // 1 = descending order
+} sortKeyColumn;
+
+/*
+ * Structure: sortKeySpec
+ * Purpose: Multi-column sort specification encoded into one byte-comparable key
+ * Fields: columnCount - columns in use
+ *         keySize - total bytes of the normalized key
+ *         columns - columns in significance order
+ * Note: Two records compare like their normalized keys under memcmp, so every
+ *       comparison is one memcmp and the keys can be radix sorted byte by byte
+ */
+typedef struct sortKeySpec {
+    int columnCount;                       // Columns in use
+    size_t keySize;                        // Normalized key length
+    sortKeyColumn columns[SORT_KEY_MAX_COLUMNS]; // Columns, most significant first
+} sortKeySpec;
+
+// ====================== EXTERNAL SORT STRUCTURES ======================
+
+/*
+ * Structure: sortRunDescriptor
+ * Purpose: Locates one sorted run inside the run file of the external merge sort
+ * Fields: firstRecord - index of the run's first record in the run file
+ *         recordCount - number of records in the run
+ * Size: 16 bytes (8 + 8)
+ * Note: Runs are written back to back, so one file holds all runs of a pass
+ */
+typedef struct sortRunDescriptor {
+    long firstRecord;                      // First record of run in run file
+    long recordCount;                      // Records in run
+} sortRunDescriptor;
+
+// ====================== B+TREE INDEX STRUCTURES ======================
+
+#define BPLUS_TREE_MAGIC 0x58444942u       // "BIDX" in little-endian byte order
+#define BPLUS_TREE_VERSION 1u              // On-disk format version
+#define BPLUS_TREE_ORDER 255               // Maximum keys per node
+#define BPLUS_TREE_MAX_HEIGHT 16           // Deepest tree InsertBPlusTreeKey will update
+
+/*
+ * Structure: bPlusTreeHeader
+ * Purpose: Header stored at position 0 of a B+tree index file (e.g. CustomersTable.idx)
+ * Fields: magic - BPLUS_TREE_MAGIC, identifies the file as an index
+ *         version - BPLUS_TREE_VERSION used when the file was written
+ *         order - BPLUS_TREE_ORDER used when the file was written
+ *         treeHeight - number of node levels (1 = root is a leaf)
+ *         rootPage - page number of the root node
+ *         pageCount - number of node pages following the header
+ *         keyCount - number of distinct keys stored in the leaves
+ * Note: Node page N starts at sizeof(bPlusTreeHeader) + N * sizeof(bPlusTreeNode)
+ */
+typedef struct bPlusTreeHeader {
+    unsigned int magic;                    // Index file identifier
+    unsigned int version;                  // On-disk format version
+    unsigned int order;                    // Maximum keys per node
+    int treeHeight;                        // Levels from root to leaves
+    long rootPage;                         // Page number of the root node
+    long pageCount;                        // Total node pages in file
+    long keyCount;                         // Distinct keys indexed
+} bPlusTreeHeader;
+
+/*
+ * Structure: bPlusTreeNode
+ * Purpose: One fixed-size page of a B+tree index file
+ * Fields: isLeaf - 1 for leaf pages, 0 for internal pages
+ *         keyCount - number of keys in use
+ *         nextLeaf - page number of the next leaf in key order (-1 = last leaf, leaves only)
+ *         keys - keys in ascending order
+ *         pointers - leaves: table record offset of keys[i];
+ *                    internal: child page numbers, pointers[i] holds keys < keys[i]
+ *                    and pointers[keyCount] holds keys >= keys[keyCount - 1]
+ * Note: A lookup reads exactly one page per tree level
+ */
+typedef struct bPlusTreeNode {
+    int isLeaf;                            // Leaf (1) or internal (0) page
+    int keyCount;                          // Keys in use
+    long nextLeaf;                         // Next leaf page (-1 = none)
+    unsigned int keys[BPLUS_TREE_ORDER];   // Sorted keys
+    long pointers[BPLUS_TREE_ORDER + 1];   // Record offsets (leaf) or child pages (internal)
+} bPlusTreeNode;
+
+/*
+ * Structure: bPlusTreeEntry
+ * Purpose: Key/offset pair used while bulk-loading a B+tree index
+ * Fields: key - indexed key (e.g. customerKey)
+ *         recordOffset - byte offset of the record after the table header
+ */
+typedef struct bPlusTreeEntry {
+    unsigned int key;                      // Indexed key
+    long recordOffset;                     // Byte offset of record after the table header
+} bPlusTreeEntry;
+
+// ====================== MAPPED TABLE STRUCTURES ======================
+
+#define TABLE_ACCESS_SEQUENTIAL 0              // Records are mostly read in file order
+#define TABLE_ACCESS_RANDOM 1                  // Records are read at scattered positions
+
+/*
+ * Structure: mappedTable
+ * Purpose: Read-only memory mapping of a fixed-size record file
+ * Fields: fileHandle - operating system handle of the open file
+ *         mappingHandle - operating system handle of the file mapping (NULL if empty)
+ *         view - first byte of the mapped file (NULL if the file is empty)
+ *         records - first record; the view itself, or the byte after a table header
+ *         recordSize - size of each record in bytes
+ *         recordCount - number of whole records in the file
+ *         fileSize - size of the file in bytes
+ * Note: Records are accessed in place through MappedRecordAt; no per-record read
+ *       or copy is needed. Handles are kept as void* so this header does not
+ *       depend on windows.h.
+ */
+typedef struct {
+    void* fileHandle;                      // Open file handle
+    void* mappingHandle;                   // File mapping handle
+    const unsigned char* view;             // Mapped view of the file
+    const unsigned char* records;          // First record inside the view
+    size_t recordSize;                     // Size of each record
+    long recordCount;                      // Whole records in the file
+    long long fileSize;                    // File size in bytes
+} mappedTable;
+
+// ====================== BINARY TABLE HEADER STRUCTURES ======================
+
+#define TABLE_HEADER_MAGIC 0x4C425458u         // "XTBL" in little-endian byte order
+#define TABLE_HEADER_VERSION 2u                // On-disk format version
+#define TABLE_MAX_STAT_COLUMNS 6               // Columns with statistics per table
+
+/*
+ * Structure: tableColumnStats
+ * Purpose: Layout and statistics of one key or date column of a binary table
+ * Fields: columnType - SORT_COLUMN_UNSIGNED, SORT_COLUMN_DATE or SORT_COLUMN_DAY_NUMBER
+ *         fieldOffset - offset of the field in the record
+ *         fieldWidth - size of the field in the record
+ *         isSorted - 1 if no row holds a smaller value than the row before it
+ *         minValue - smallest value (dates as DateToDayNumber)
+ *         maxValue - largest value
+ *         lastValue - value of the last row, so an append can continue the sort check
+ * Note: Statistics are only meaningful when the table has rows
+ */
+typedef struct {
+    int columnType;                        // Column encoding
+    unsigned int fieldOffset;              // Field offset in record
+    unsigned int fieldWidth;               // Field size in record
+    int isSorted;                          // Rows in ascending order of this column
+    long long minValue;                    // Smallest value
+    long long maxValue;                    // Largest value
+    long long lastValue;                   // Value of the last row
+} tableColumnStats;
+
+/*
+ * Structure: tableHeader
+ * Purpose: Header stored at position 0 of every binary table (SalesTable.dat, ...)
+ * Fields: magic - TABLE_HEADER_MAGIC, identifies the file as a table
+ *         version - TABLE_HEADER_VERSION used when the file was written
+ *         recordSize - size of each record; a mismatch means another record layout
+ *         columnCount - entries of columns in use
+ *         rowCount - records following the header
+ *         buildTimestamp - time() when the header was last written
+ *         columns - layout, sort order and min/max of the table's key and date columns
+ * Note: Record N starts at sizeof(tableHeader) + N * recordSize. Bytes after the
+ *       last counted record (an interrupted append) are ignored.
+ */
+typedef struct {
+    unsigned int magic;                    // Table file identifier
+    unsigned int version;                  // On-disk format version
+    unsigned int recordSize;               // Bytes per record
+    unsigned int columnCount;              // Column statistics in use
+    long long rowCount;                    // Records in the table
+    long long buildTimestamp;              // Last time the header was written
+    tableColumnStats columns[TABLE_MAX_STAT_COLUMNS]; // Key and date column statistics
+} tableHeader;
+
+// ====================== CSV INGESTION STRUCTURES ======================
+
+#define CSV_MAX_FIELDS 10                      // Most columns in any source CSV file
+
+/*
+ * Structure: csvField
+ * Purpose: One field of a CSV row, pointing into the mapped file
+ * Fields: start - first character of the field
+ *         length - number of characters (the field is not NUL-terminated)
+ */
+typedef struct {
+    const char* start;                     // First character
+    int length;                            // Characters in the field
+} csvField;
+
+/*
+ * Structure: csvReader
+ * Purpose: Row-by-row reader over a memory-mapped CSV file
+ * Fields: file - mapping of the CSV file (recordSize 1)
+ *         position - start of the next unread row
+ *         end - one past the last byte of the file
+ *         lineNumber - line number of the row last read (1 = header)
+ * Note: Rows are split in place; no line or field is copied
+ */
+typedef struct {
+    mappedTable file;                      // Mapped CSV file
+    const char* position;                  // Next unread row
+    const char* end;                       // End of the file
+    int lineNumber;                        // Line of the last row read
+} csvReader;
+
+// ====================== HASH JOIN STRUCTURES ======================
+
+/*
+ * Structure: HashJoinTable
+ * Purpose: In-memory hash table holding the build side of a hash join
+ * Fields: bucketHeads - first entry index of each bucket chain (-1 = empty bucket)
+ *         nextEntries - next entry index in the same bucket chain (-1 = end of chain)
+ *         entryKeys - join key of each entry
+ *         entryRecords - build-side records stored contiguously (entryCount * recordSize bytes)
+ *         recordSize - size of each build-side record in bytes
+ *         entryCount - number of entries stored in the table
+ *         bucketMask - bucketCount - 1 (bucket count is always a power of two)
+ *         indexFile - open B+tree index when the table is index-backed (NULL = in-memory)
+ *         tableMap - build-side table file mapped when the table is index-backed
+ *         indexHeader - header of indexFile
+ * Note: Built once from a dimension table (products, customers) so the fact table
+ *       (sales) can be streamed through it with O(1) lookups per row.
+ *       Chains are index-based so the whole table is four flat allocations.
+ *       When the build side is too large for memory the table can instead be
+ *       backed by a B+tree index; probes then cost O(log n) page reads and
+ *       return records straight from the mapped table file.
+ */
+typedef struct HashJoinTable {
+    long* bucketHeads;                     // First entry index per bucket (-1 = empty)
+    long* nextEntries;                     // Next entry index in chain (-1 = end)
+    unsigned int* entryKeys;               // Join key per entry
+    unsigned char* entryRecords;           // Build-side records stored contiguously
+    size_t recordSize;                     // Size of each build-side record
+    long entryCount;                       // Number of entries in the table
+    unsigned long bucketMask;              // Bucket count - 1
+    FILE* indexFile;                       // B+tree index (NULL = in-memory table)
+    mappedTable tableMap;                  // Mapped build-side table for index-backed probes
+    bPlusTreeHeader indexHeader;           // Header of indexFile
+} HashJoinTable;
+
 // ====================== UTILITY FUNCTIONS ======================
 
 /*